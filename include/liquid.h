@@ -214,6 +214,21 @@ int AGC(_execute_block)(AGC()        _q,                                    \
                         unsigned int _n,                                    \
                         TC *         _y);                                   \
                                                                             \
+/* Set number of samples per gain update in execute_block(). For block  */  \
+/* lengths greater than one, the energy of each block is estimated with */  \
+/* a vector sum of squares and drives a single update of the loop, with */  \
+/* the loop filter coefficient scaled so that the time constant in      */  \
+/* samples is unchanged; the gain is then interpolated linearly across  */  \
+/* the block. The squelch state is updated once per block. The default  */  \
+/* block length of one runs the per-sample loop.                        */  \
+/*  _q          : automatic gain control object                         */  \
+/*  _block_len  : samples per update, _block_len > 0                    */  \
+int AGC(_set_block_len)(AGC()        _q,                                    \
+                        unsigned int _block_len);                           \
+                                                                            \
+/* Get number of samples per gain update in execute_block()             */  \
+unsigned int AGC(_get_block_len)(AGC() _q);                                 \
+                                                                            \
 /* Lock agc object. When locked, the agc object still makes an estimate */  \
 /* of the signal level, but the gain setting is fixed and does not      */  \
 /* change.                                                              */  \
@@ -325,6 +340,94 @@ int AGC(_squelch_get_status)(AGC() _q);                                     \
 LIQUID_AGC_DEFINE_API(LIQUID_AGC_MANGLE_CRCF, float, liquid_float_complex)
 LIQUID_AGC_DEFINE_API(LIQUID_AGC_MANGLE_RRRF, float, float)
 
+// Bank of automatic gain control loops with squelch for many channels,
+// e.g. at the output of a channelizer. Each channel runs the same loop
+// as agc_crcf, but the state of all channels is held in arrays and one
+// time step across all channels is processed per call (four channels at
+// a time with SSE2). Loop parameters are shared by all channels.
+typedef struct agcbank_crcf_s * agcbank_crcf;
+
+// Create agc bank
+//  _num_channels   : number of channels, _num_channels > 0
+agcbank_crcf agcbank_crcf_create(unsigned int _num_channels);
+
+// Destroy agc bank, freeing all internal memory
+int agcbank_crcf_destroy(agcbank_crcf _q);
+
+// Print agc bank object internals
+int agcbank_crcf_print(agcbank_crcf _q);
+
+// Reset gain, signal level estimate, and squelch state of all channels
+int agcbank_crcf_reset(agcbank_crcf _q);
+
+// Get number of channels
+unsigned int agcbank_crcf_get_num_channels(agcbank_crcf _q);
+
+// Get/set loop bandwidth of all channels, 0 <= _bt <= 1
+float agcbank_crcf_get_bandwidth(agcbank_crcf _q);
+int   agcbank_crcf_set_bandwidth(agcbank_crcf _q, float _bt);
+
+// Get/set output scale of all channels, _scale > 0
+float agcbank_crcf_get_scale(agcbank_crcf _q);
+int   agcbank_crcf_set_scale(agcbank_crcf _q, float _scale);
+
+// Lock/unlock gain of all channels; see agc_crcf_lock()
+int agcbank_crcf_lock     (agcbank_crcf _q);
+int agcbank_crcf_unlock   (agcbank_crcf _q);
+int agcbank_crcf_is_locked(agcbank_crcf _q);
+
+// Get gain and estimated signal level [dB] of channel
+float agcbank_crcf_get_gain(agcbank_crcf _q, unsigned int _channel);
+float agcbank_crcf_get_rssi(agcbank_crcf _q, unsigned int _channel);
+
+// Set estimated signal level [dB] of all channels
+int agcbank_crcf_set_rssi(agcbank_crcf _q, float _rssi);
+
+// Enable/disable squelch on all channels; see agc_crcf_squelch_enable()
+int agcbank_crcf_squelch_enable    (agcbank_crcf _q);
+int agcbank_crcf_squelch_disable   (agcbank_crcf _q);
+int agcbank_crcf_squelch_is_enabled(agcbank_crcf _q);
+
+// Get/set squelch threshold [dB] of all channels
+float agcbank_crcf_squelch_get_threshold(agcbank_crcf _q);
+int   agcbank_crcf_squelch_set_threshold(agcbank_crcf _q, float _threshold);
+
+// Get/set squelch timeout [samples] of all channels
+unsigned int agcbank_crcf_squelch_get_timeout(agcbank_crcf _q);
+int          agcbank_crcf_squelch_set_timeout(agcbank_crcf _q, unsigned int _timeout);
+
+// Get squelch status of channel (e.g. LIQUID_AGC_SQUELCH_SIGNALHI)
+int agcbank_crcf_squelch_get_status(agcbank_crcf _q, unsigned int _channel);
+
+// Get bitmap of channels whose squelch status changed during the last
+// call to execute() or execute_block(). Channel i is bit (i%32) of word
+// (i/32); the array holds ceil(num_channels/32) words and is valid until
+// the next call.
+const uint32_t * agcbank_crcf_get_changed(agcbank_crcf _q);
+
+// Get number of channels whose squelch status changed during the last
+// call to execute() or execute_block()
+unsigned int agcbank_crcf_get_num_changed(agcbank_crcf _q);
+
+// Execute gain control on one time step of all channels
+//  _q      : agc bank object
+//  _x      : input sample of each channel,  [size: _num_channels x 1]
+//  _y      : output sample of each channel, [size: _num_channels x 1]
+int agcbank_crcf_execute(agcbank_crcf           _q,
+                         liquid_float_complex * _x,
+                         liquid_float_complex * _y);
+
+// Execute gain control on multiple time steps of all channels, with the
+// samples of all channels for each time step stored contiguously
+//  _q      : agc bank object
+//  _x      : input samples,  [size: _n*_num_channels x 1]
+//  _n      : number of time steps
+//  _y      : output samples, [size: _n*_num_channels x 1]
+int agcbank_crcf_execute_block(agcbank_crcf           _q,
+                               liquid_float_complex * _x,
+                               unsigned int           _n,
+                               liquid_float_complex * _y);
+
 
 
 //
@@ -460,6 +563,97 @@ int CBUFFER(_release)(CBUFFER()    _q,                                      \
 LIQUID_CBUFFER_DEFINE_API(LIQUID_CBUFFER_MANGLE_FLOAT,  float)
 LIQUID_CBUFFER_DEFINE_API(LIQUID_CBUFFER_MANGLE_CFLOAT, liquid_float_complex)
 
+// Lock-free ring buffer for streaming samples between threads
+#define LIQUID_RINGBUFFER_MANGLE_FLOAT(name)  LIQUID_CONCAT(ringbufferf,  name)
+#define LIQUID_RINGBUFFER_MANGLE_CFLOAT(name) LIQUID_CONCAT(ringbuffercf, name)
+
+// large macro
+//   RINGBUFFER : name-mangling macro
+//   T          : data type
+#define LIQUID_RINGBUFFER_DEFINE_API(RINGBUFFER,T)                          \
+                                                                            \
+/* Lock-free ring buffer connecting one consumer thread with either a   */  \
+/* single producer thread or multiple producer threads. Storage is      */  \
+/* mapped twice in virtual memory where supported, so any span of     */  \
+/* elements is contiguous and can be accessed in place.                 */  \
+typedef struct RINGBUFFER(_s) * RINGBUFFER();                               \
+                                                                            \
+/* Create ring buffer for a single producer and a single consumer       */  \
+/*  _n  : minimum capacity; rounded up to a power of two, _n > 0        */  \
+RINGBUFFER() RINGBUFFER(_create)(unsigned int _n);                          \
+                                                                            \
+/* Create ring buffer for multiple producers and a single consumer;     */  \
+/* producers must use the write() method.                               */  \
+/*  _n  : minimum capacity; rounded up to a power of two, _n > 0        */  \
+RINGBUFFER() RINGBUFFER(_create_mpsc)(unsigned int _n);                     \
+                                                                            \
+/* Destroy ring buffer object, freeing all internal memory              */  \
+int RINGBUFFER(_destroy)(RINGBUFFER() _q);                                  \
+                                                                            \
+/* Print ring buffer object properties to stdout                        */  \
+int RINGBUFFER(_print)(RINGBUFFER() _q);                                    \
+                                                                            \
+/* Clear contents; not safe while other threads access the object     */  \
+int RINGBUFFER(_reset)(RINGBUFFER() _q);                                    \
+                                                                            \
+/* Get capacity of buffer                                               */  \
+unsigned int RINGBUFFER(_get_capacity)(RINGBUFFER() _q);                    \
+                                                                            \
+/* Is storage mirrored in virtual memory?                               */  \
+int RINGBUFFER(_is_mirrored)(RINGBUFFER() _q);                              \
+                                                                            \
+/* Get number of elements available to read                             */  \
+unsigned int RINGBUFFER(_size)(RINGBUFFER() _q);                            \
+                                                                            \
+/* Get number of elements available to write                            */  \
+unsigned int RINGBUFFER(_space_available)(RINGBUFFER() _q);                 \
+                                                                            \
+/* Acquire contiguous space to write in place (single producer only)    */  \
+/*  _q              : ring buffer object                                */  \
+/*  _num_requested  : number of elements requested                      */  \
+/*  _v              : pointer to writable elements                      */  \
+/*  _num_available  : number of elements referenced by _v (may be less  */  \
+/*                    than requested when buffer is nearly full)        */  \
+int RINGBUFFER(_write_acquire)(RINGBUFFER()   _q,                           \
+                               unsigned int   _num_requested,               \
+                               T **           _v,                           \
+                               unsigned int * _num_available);              \
+                                                                            \
+/* Commit elements written after write_acquire() to the consumer        */  \
+/*  _q  : ring buffer object                                            */  \
+/*  _n  : number of elements to commit, at most the number acquired     */  \
+int RINGBUFFER(_write_commit)(RINGBUFFER() _q,                              \
+                              unsigned int _n);                             \
+                                                                            \
+/* Copy elements into buffer, writing as many as there is space for     */  \
+/*  _q          : ring buffer object                                    */  \
+/*  _v          : input array, [size: _n x 1]                           */  \
+/*  _n          : number of input elements                              */  \
+/*  _num_written: number of elements written (ignored if NULL)          */  \
+int RINGBUFFER(_write)(RINGBUFFER()   _q,                                   \
+                       T *            _v,                                   \
+                       unsigned int   _n,                                   \
+                       unsigned int * _num_written);                        \
+                                                                            \
+/* Acquire contiguous elements to read in place                         */  \
+/*  _q              : ring buffer object                                */  \
+/*  _num_requested  : number of elements requested                      */  \
+/*  _v              : pointer to readable elements                      */  \
+/*  _num_read       : number of elements referenced by _v               */  \
+int RINGBUFFER(_read_acquire)(RINGBUFFER()   _q,                            \
+                              unsigned int   _num_requested,                \
+                              T **           _v,                            \
+                              unsigned int * _num_read);                    \
+                                                                            \
+/* Release elements after read_acquire(), returning space to producers  */  \
+/*  _q  : ring buffer object                                            */  \
+/*  _n  : number of elements to release, at most the number acquired    */  \
+int RINGBUFFER(_read_release)(RINGBUFFER() _q,                              \
+                              unsigned int _n);                             \
+
+LIQUID_RINGBUFFER_DEFINE_API(LIQUID_RINGBUFFER_MANGLE_FLOAT,  float)
+LIQUID_RINGBUFFER_DEFINE_API(LIQUID_RINGBUFFER_MANGLE_CFLOAT, liquid_float_complex)
+
 
 
 // Windowing functions
@@ -630,6 +824,15 @@ int CHANNEL(_destroy)(CHANNEL() _q);                                        \
 /* Print channel object internals to standard output                    */  \
 int CHANNEL(_print)(CHANNEL() _q);                                          \
                                                                             \
+/* Set seed and stream of internal noise generator, resetting it to the */  \
+/* start of its stream; by default the generator is seeded from rand()  */  \
+/*  _q          : channel object                                        */  \
+/*  _seed       : generator seed                                        */  \
+/*  _stream     : generator stream identifier                           */  \
+int CHANNEL(_set_seed)(CHANNEL()     _q,                                    \
+                       unsigned long _seed,                                 \
+                       unsigned long _stream);                              \
+                                                                            \
 /* Include additive white Gausss noise impairment                       */  \
 /*  _q          : channel object                                        */  \
 /*  _N0dB       : noise floor power spectral density [dB]               */  \
@@ -670,7 +873,8 @@ int CHANNEL(_execute)(CHANNEL()      _q,                                    \
                       TI             _x,                                    \
                       TO *           _y);                                   \
                                                                             \
-/* Apply channel impairments on block of samples                        */  \
+/* Apply channel impairments on block of samples; output is identical   */  \
+/* to calling execute() on each sample in turn with the same seed       */  \
 /*  _q      : channel object                                            */  \
 /*  _x      : input array, [size: _n x 1]                               */  \
 /*  _n      : input array, length                                       */  \
@@ -722,6 +926,15 @@ int TVMPCH(_reset)(TVMPCH() _q);                                            \
 /* Print channel object internals to standard output                    */  \
 int TVMPCH(_print)(TVMPCH() _q);                                            \
                                                                             \
+/* Set seed and stream of internal noise generator, resetting it to the */  \
+/* start of its stream; by default the generator is seeded from rand()  */  \
+/*  _q          : channel object                                        */  \
+/*  _seed       : generator seed                                        */  \
+/*  _stream     : generator stream identifier                           */  \
+int TVMPCH(_set_seed)(TVMPCH()      _q,                                     \
+                      unsigned long _seed,                                  \
+                      unsigned long _stream);                               \
+                                                                            \
 /* Push sample into emulator                                            */  \
 /*  _q      : channel object                                            */  \
 /*  _x      : input sample                                              */  \
@@ -873,6 +1086,14 @@ float liquid_sumsqcf(liquid_float_complex * _v,
 //
 
 // least mean-squares (LMS)
+
+// coefficient update method
+typedef enum {
+    LIQUID_EQLMS_TIME=0,                // time-domain update, every sample
+    LIQUID_EQLMS_FDLMS,                 // frequency-domain block LMS (constrained)
+    LIQUID_EQLMS_FDLMS_UNCONSTRAINED,   // frequency-domain block LMS (unconstrained)
+} liquid_eqlms_method;
+
 #define LIQUID_EQLMS_MANGLE_RRRF(name) LIQUID_CONCAT(eqlms_rrrf,name)
 #define LIQUID_EQLMS_MANGLE_CCCF(name) LIQUID_CONCAT(eqlms_cccf,name)
 
@@ -942,6 +1163,24 @@ int EQLMS(_set_bw)(EQLMS() _q,                                              \
 /* Get length of equalizer object (number of internal coefficients)     */  \
 unsigned int EQLMS(_get_length)(EQLMS() _q);                                \
                                                                             \
+/* Set method used to update the coefficients. The frequency-domain     */  \
+/* block methods filter with overlap-save transforms of size 2*_n and   */  \
+/* accumulate the gradient over each block of _n samples, normalizing   */  \
+/* each frequency bin by its own power estimate; this reduces the cost  */  \
+/* from O(_n) to O(log _n) per sample for long equalizers. The          */  \
+/* unconstrained variant skips the gradient projection (two transforms  */  \
+/* per block) at the expense of circular wrap-around in the filter.     */  \
+/* Only step_block() and execute_block() use the block update; the      */  \
+/* per-sample methods continue to work in all modes. The equalizer is   */  \
+/* reset.                                                               */  \
+/*  _q      :   equalizer object                                        */  \
+/*  _method :   update method, e.g. LIQUID_EQLMS_FDLMS                  */  \
+int EQLMS(_set_method)(EQLMS() _q,                                          \
+                       int     _method);                                    \
+                                                                            \
+/* Get method used to update the coefficients                           */  \
+int EQLMS(_get_method)(EQLMS() _q);                                         \
+                                                                            \
 /* Get pointer to coefficients array                                    */  \
 const T * EQLMS(_get_coefficients)(EQLMS() _q);                             \
                                                                             \
@@ -1001,6 +1240,21 @@ int EQLMS(_execute_block)(EQLMS()      _q,                                  \
                           unsigned int _n,                                  \
                           T *          _y);                                 \
                                                                             \
+/* Push, filter, and train on a block of samples. In time-domain mode   */  \
+/* this is equivalent to invoking push(), execute(), and step() for     */  \
+/* each sample; in the frequency-domain modes the coefficients are      */  \
+/* updated once for every _n samples (equalizer length) pushed.         */  \
+/*  _q      :   equalizer object                                        */  \
+/*  _x      :   received samples, [size: _n x 1]                        */  \
+/*  _d      :   desired output,   [size: _n x 1]                        */  \
+/*  _n      :   number of samples                                       */  \
+/*  _y      :   filtered output,  [size: _n x 1]                        */  \
+int EQLMS(_step_block)(EQLMS()      _q,                                     \
+                       T *          _x,                                     \
+                       T *          _d,                                     \
+                       unsigned int _n,                                     \
+                       T *          _y);                                    \
+                                                                            \
 /* Step through one cycle of equalizer training                         */  \
 /*  _q      :   equalizer object                                        */  \
 /*  _d      :   desired output                                          */  \
@@ -1033,6 +1287,12 @@ LIQUID_EQLMS_DEFINE_API(LIQUID_EQLMS_MANGLE_CCCF, liquid_float_complex)
 
 
 // recursive least-squares (RLS)
+// recursive least-squares equalizer update methods
+typedef enum {
+    LIQUID_EQRLS_CONVENTIONAL=0,    // inverse correlation matrix, rank-one update
+    LIQUID_EQRLS_INVQRD,            // inverse QR decomposition (Givens rotations)
+} liquid_eqrls_method;
+
 #define LIQUID_EQRLS_MANGLE_RRRF(name) LIQUID_CONCAT(eqrls_rrrf,name)
 #define LIQUID_EQRLS_MANGLE_CCCF(name) LIQUID_CONCAT(eqrls_cccf,name)
 
@@ -1076,6 +1336,19 @@ float EQRLS(_get_bw)(EQRLS() _q);                                           \
 int EQRLS(_set_bw)(EQRLS() _q,                                              \
                    float   _mu);                                            \
                                                                             \
+/* Set method used to update the inverse correlation matrix. The        */  \
+/* inverse QR-decomposition method propagates a triangular square root  */  \
+/* of the matrix with Givens rotations, which cannot lose positive      */  \
+/* definiteness in single precision. Both are O(_n^2) per update. The   */  \
+/* equalizer is reset.                                                  */  \
+/*  _q      :   equalizer object                                        */  \
+/*  _method :   update method, e.g. LIQUID_EQRLS_INVQRD                 */  \
+int EQRLS(_set_method)(EQRLS() _q,                                          \
+                       int     _method);                                    \
+                                                                            \
+/* Get method used to update the inverse correlation matrix             */  \
+int EQRLS(_get_method)(EQRLS() _q);                                         \
+                                                                            \
 /* Push sample into equalizer internal buffer                           */  \
 /*  _q      :   equalizer object                                        */  \
 /*  _x      :   input sample                                            */  \
@@ -1092,6 +1365,19 @@ int EQRLS(_execute)(EQRLS() _q, T * _y);                                    \
 /*  _d_hat  :   actual output                                           */  \
 int EQRLS(_step)(EQRLS() _q, T _d, T _d_hat);                               \
                                                                             \
+/* Push, filter, and train on a block of samples; equivalent to         */  \
+/* invoking push(), execute(), and step() for each sample               */  \
+/*  _q      :   equalizer object                                        */  \
+/*  _x      :   received samples, [size: _n x 1]                        */  \
+/*  _d      :   desired output,   [size: _n x 1]                        */  \
+/*  _n      :   number of samples                                       */  \
+/*  _y      :   filtered output,  [size: _n x 1]                        */  \
+int EQRLS(_step_block)(EQRLS()      _q,                                     \
+                       T *          _x,                                     \
+                       T *          _d,                                     \
+                       unsigned int _n,                                     \
+                       T *          _y);                                    \
+                                                                            \
 /* Get equalizer's internal coefficients                                */  \
 /*  _q      :   equalizer object                                        */  \
 /*  _w      :   weights, [size: _p x 1]                                 */  \
@@ -1188,7 +1474,7 @@ unsigned int crc_sizeof_key(crc_scheme _scheme);
 
 
 // available FEC schemes
-#define LIQUID_FEC_NUM_SCHEMES  28
+#define LIQUID_FEC_NUM_SCHEMES  31
 typedef enum {
     LIQUID_FEC_UNKNOWN=0,       // unknown/unsupported scheme
     LIQUID_FEC_NONE,            // no error-correction
@@ -1225,7 +1511,12 @@ typedef enum {
     LIQUID_FEC_CONV_V29P78,     // r7/8, K=9, dfree=4
 
     // Reed-Solomon codes
-    LIQUID_FEC_RS_M8            // m=8, n=255, k=223
+    LIQUID_FEC_RS_M8,           // m=8, n=255, k=223
+
+    // low-density parity-check codes (quasi-cyclic)
+    LIQUID_FEC_LDPC_R12_N648,   // r1/2, n=648
+    LIQUID_FEC_LDPC_R12_N1296,  // r1/2, n=1296
+    LIQUID_FEC_LDPC_R12_N1944   // r1/2, n=1944
 } fec_scheme;
 
 // pretty names for fec schemes
@@ -1301,6 +1592,87 @@ int fec_decode_soft(fec _q,
                     unsigned char * _msg_enc,
                     unsigned char * _msg_dec);
 
+//
+// Low-density parity-check codes
+//
+
+// LDPC code object with layered min-sum decoder
+typedef struct ldpc_s * ldpc;
+
+// sparse binary matrix (smatrixb), defined with matrix objects below
+struct smatrixb_s;
+
+// create decoder for generic code from sparse binary parity-check
+// matrix; encoding is not supported (ldpc_get_k() returns 0)
+//  _H      :   parity-check matrix (smatrixb) [size: m x n], m < n
+ldpc ldpc_create(struct smatrixb_s * _H);
+
+// create quasi-cyclic code from base matrix of circulant shifts; the
+// code is encodable if the parity section of the base matrix has the
+// dual-diagonal structure
+//  _base   :   shift of each circulant, or -1 for zero [size: _mb x _nb]
+//  _mb     :   number of base matrix rows
+//  _nb     :   number of base matrix columns, _nb > _mb
+//  _z      :   circulant size
+ldpc ldpc_create_qc(int *        _base,
+                    unsigned int _mb,
+                    unsigned int _nb,
+                    unsigned int _z);
+
+// create rate-1/2 quasi-cyclic code from built-in base matrix [12 x 24]
+// with codeword length n=24*_z; _z=27,54,81 give the IEEE 802.11n codes
+// of length 648, 1296, 1944, other sizes scale the _z=27 matrix shifts
+//  _z      :   circulant size, _z >= 2
+ldpc ldpc_create_r12(unsigned int _z);
+
+// destroy object, freeing all internal memory
+int ldpc_destroy(ldpc _q);
+
+// print object properties to stdout
+int ldpc_print(ldpc _q);
+
+// get codeword length [bits]
+unsigned int ldpc_get_n(ldpc _q);
+
+// get message length [bits]; zero if encoding is not supported
+unsigned int ldpc_get_k(ldpc _q);
+
+// set maximum number of decoder iterations (default: 50)
+int ldpc_set_max_iterations(ldpc _q, unsigned int _n);
+
+// get number of iterations used by the last call to decode()
+unsigned int ldpc_get_num_iterations(ldpc _q);
+
+// set min-sum correction: check messages are scaled by _alpha and then
+// reduced in magnitude by _beta (defaults: 0.75, 0)
+//  _q      :   code object
+//  _alpha  :   normalization factor, 0.5 < _alpha <= 1
+//  _beta   :   offset, _beta >= 0
+int ldpc_set_min_sum(ldpc _q, float _alpha, float _beta);
+
+// encode message (systematic): codeword is message followed by parity
+//  _q      :   code object
+//  _msg    :   message, one bit per byte [size: k x 1]
+//  _c      :   codeword, one bit per byte [size: n x 1]
+int ldpc_encode(ldpc            _q,
+                unsigned char * _msg,
+                unsigned char * _c);
+
+// check parity of codeword; returns 1 if all checks pass, 0 otherwise
+//  _q      :   code object
+//  _c      :   codeword, one bit per byte [size: n x 1]
+int ldpc_check(ldpc            _q,
+               unsigned char * _c);
+
+// decode codeword from log-likelihood ratios (positive for bit 0);
+// returns 1 if all parity checks pass, 0 otherwise
+//  _q      :   code object
+//  _llr    :   log-likelihood ratios [size: n x 1]
+//  _c_hat  :   estimated codeword, one bit per byte [size: n x 1]
+int ldpc_decode(ldpc            _q,
+                float *         _llr,
+                unsigned char * _c_hat);
+
 //
 // Packetizer
 //
@@ -1396,6 +1768,45 @@ int packetizer_decode_soft(packetizer            _p,
                            const unsigned char * _pkt,
                            unsigned char *       _msg);
 
+// Execute the packetizer on a batch of independent input messages
+//
+//  _p      :   packetizer object
+//  _num    :   number of messages in batch
+//  _msg    :   input messages (uncoded bytes) [size: _num*dec_msg_len x 1]
+//  _pkt    :   encoded output messages [size: _num*enc_msg_len x 1]
+void packetizer_encode_batch(packetizer            _p,
+                             unsigned int          _num,
+                             const unsigned char * _msg,
+                             unsigned char *       _pkt);
+
+// Execute the packetizer to decode a batch of independent input
+// messages, returning the number of messages which pass the check
+//
+//  _p      :   packetizer object
+//  _num    :   number of messages in batch
+//  _pkt    :   input messages (coded bytes) [size: _num*enc_msg_len x 1]
+//  _msg    :   decoded output messages [size: _num*dec_msg_len x 1]
+//  _valid  :   validity check of each message (ignored if NULL) [size: _num x 1]
+unsigned int packetizer_decode_batch(packetizer            _p,
+                                     unsigned int          _num,
+                                     const unsigned char * _pkt,
+                                     unsigned char *       _msg,
+                                     int *                 _valid);
+
+// Execute the packetizer to decode a batch of independent input
+// messages, returning the number of messages which pass the check
+//
+//  _p      :   packetizer object
+//  _num    :   number of messages in batch
+//  _pkt    :   input messages (coded soft bits) [size: 8*_num*enc_msg_len x 1]
+//  _msg    :   decoded output messages [size: _num*dec_msg_len x 1]
+//  _valid  :   validity check of each message (ignored if NULL) [size: _num x 1]
+unsigned int packetizer_decode_soft_batch(packetizer            _p,
+                                          unsigned int          _num,
+                                          const unsigned char * _pkt,
+                                          unsigned char *       _msg,
+                                          int *                 _valid);
+
 
 //
 // interleaver
@@ -1693,6 +2104,20 @@ int SPGRAM(_write)(SPGRAM()     _q,                                         \
                    TI *         _x,                                         \
                    unsigned int _n);                                        \
                                                                             \
+/* Set number of worker threads used to transform blocks of samples    */  \
+/* passed to write(); frames are windowed straight from the input       */  \
+/* buffer and transformed in batches, split among the calling thread    */  \
+/* and the workers. The output is identical regardless of the number    */  \
+/* of threads. Without thread support the value is retained but all     */  \
+/* transforms run on the calling thread.                                */  \
+/*  _q           : spgram object                                        */  \
+/*  _num_threads : number of worker threads, 0 (default) to 64          */  \
+int SPGRAM(_set_num_threads)(SPGRAM()     _q,                               \
+                             unsigned int _num_threads);                    \
+                                                                            \
+/* Get number of worker threads used to transform blocks of samples     */  \
+unsigned int SPGRAM(_get_num_threads)(SPGRAM() _q);                         \
+                                                                            \
 /* Compute spectral periodogram output (fft-shifted values, linear)     */  \
 /* from current buffer contents                                         */  \
 /*  _q  : spgram object                                                 */  \
@@ -1825,6 +2250,42 @@ LIQUID_ASGRAM_DEFINE_API(LIQUID_ASGRAM_MANGLE_FLOAT,
 // spectral periodogram waterfall
 //
 
+// spectral periodogram waterfall stream row formats
+typedef enum {
+    LIQUID_SPWATERFALL_STREAM_FLOAT=0,  // rows of 32-bit float values [dB]
+    LIQUID_SPWATERFALL_STREAM_UINT8,    // rows of 8-bit values quantized in dB
+} liquid_spwaterfall_stream_format;
+
+// Header at the start of a memory-mapped spwaterfall stream file. The file
+// holds 'header_len' bytes of header followed by a ring of 'num_rows'
+// records, each 'row_stride' bytes long. Row n (counting from 1) lives in
+// record (n-1) % num_rows and consists of a liquid_spwaterfall_stream_row
+// structure followed by 'nfft' values in the stream format. The writer
+// clears the record's 'seq' field, writes the values, sets 'seq' to n and
+// finally sets 'num_written' to n. A reader copies a row and accepts it
+// only if 'seq' holds the expected value both before and after the copy.
+// Quantized values represent db_min + db_step*value.
+struct liquid_spwaterfall_stream_header_s {
+    char     magic[8];      // "LQSPWF1", written last when opening
+    uint32_t header_len;    // offset of first row record [bytes]
+    uint32_t nfft;          // number of values in each row
+    uint32_t num_rows;      // number of row records in ring
+    uint32_t row_stride;    // length of each row record [bytes]
+    uint32_t format;        // liquid_spwaterfall_stream_format
+    float    db_min;        // quantization offset [dB]
+    float    db_step;       // quantization step [dB]
+    uint32_t reserved;
+    uint64_t num_written;   // number of rows written to stream
+};
+
+// Row record header in a spwaterfall stream file
+struct liquid_spwaterfall_stream_row_s {
+    uint64_t seq;           // row sequence number (0 while being written)
+    uint64_t num_samples;   // total samples processed at end of row
+    uint32_t num_transforms;// number of transforms averaged in row
+    uint32_t reserved;
+};
+
 #define LIQUID_SPWATERFALL_MANGLE_CFLOAT(name) LIQUID_CONCAT(spwaterfallcf,name)
 #define LIQUID_SPWATERFALL_MANGLE_FLOAT(name)  LIQUID_CONCAT(spwaterfallf, name)
 
@@ -1936,6 +2397,45 @@ int SPWATERFALL(_write)(SPWATERFALL() _q,                                   \
                         TI *          _x,                                   \
                         unsigned int  _n);                                  \
                                                                             \
+/* Set number of worker threads used by the internal spectral           */  \
+/* periodogram to transform blocks of samples passed to write()         */  \
+/*  _q           : spwaterfall object                                   */  \
+/*  _num_threads : number of worker threads, 0 (default) to 64          */  \
+int SPWATERFALL(_set_num_threads)(SPWATERFALL() _q,                         \
+                                  unsigned int  _num_threads);              \
+                                                                            \
+/* Get number of worker threads used by internal spectral periodogram   */  \
+unsigned int SPWATERFALL(_get_num_threads)(SPWATERFALL() _q);               \
+                                                                            \
+/* Set dB range mapped onto values 0 to 255 for quantized stream output */  \
+/* formats. This must be set before the stream is opened.               */  \
+/*  _q      : spwaterfall object                                        */  \
+/*  _db_min : value at bottom of range [dB]                             */  \
+/*  _db_max : value at top of range [dB], _db_max > _db_min             */  \
+int SPWATERFALL(_set_stream_range)(SPWATERFALL() _q,                        \
+                                   float         _db_min,                   \
+                                   float         _db_max);                  \
+                                                                            \
+/* Open memory-mapped ring buffer stream output. Each row extracted     */  \
+/* from the internal periodogram is appended to the file so that any    */  \
+/* number of other processes can map it and read rows without locks;    */  \
+/* see liquid_spwaterfall_stream_header_s for the layout. Any stream    */  \
+/* already open is closed first.                                        */  \
+/*  _q        : spwaterfall object                                      */  \
+/*  _filename : stream file name, created or truncated                  */  \
+/*  _num_rows : number of row records in ring, _num_rows > 0            */  \
+/*  _format   : row format, e.g. LIQUID_SPWATERFALL_STREAM_FLOAT        */  \
+int SPWATERFALL(_stream_open)(SPWATERFALL() _q,                             \
+                              const char *  _filename,                      \
+                              unsigned int  _num_rows,                      \
+                              int           _format);                       \
+                                                                            \
+/* Close stream output, unmapping file; the file itself is retained     */  \
+int SPWATERFALL(_stream_close)(SPWATERFALL() _q);                           \
+                                                                            \
+/* Get number of rows written to stream since it was opened             */  \
+uint64_t SPWATERFALL(_get_stream_num_rows)(SPWATERFALL() _q);               \
+                                                                            \
 /* Export set of files for plotting                                     */  \
 /*  _q    : spwaterfall object                                          */  \
 /*  _base : base filename (will export .gnu, .bin, and .png files)      */  \
@@ -1953,6 +2453,103 @@ LIQUID_SPWATERFALL_DEFINE_API(LIQUID_SPWATERFALL_MANGLE_FLOAT,
                               liquid_float_complex,
                               float)
 
+//
+// zoom spectrum analyzer
+//
+
+// Zoom spectrum analyzer: a coarse polyphase channelizer (firpfbch2)
+// splits the input into M overlapping channels at twice the channel
+// rate; each region of interest takes its nearest channel, mixes the
+// region center to baseband, and feeds its own spectral periodogram.
+// All regions are fed from a single pass over the input, and the cost of
+// each region depends only on the channel rate, 2/M of the input rate.
+typedef struct spzoomcf_s * spzoomcf;
+
+// Create zoom spectrum analyzer
+//  _M      : number of coarse channels, even, _M >= 2
+//  _m      : channelizer prototype filter semi-length, _m > 0
+//  _As     : channelizer prototype filter stop-band attenuation [dB]
+spzoomcf spzoomcf_create(unsigned int _M,
+                         unsigned int _m,
+                         float        _As);
+
+// Create zoom spectrum analyzer with default filter (m=8, As=80 dB)
+//  _M      : number of coarse channels, even, _M >= 2
+spzoomcf spzoomcf_create_default(unsigned int _M);
+
+// Destroy zoom spectrum analyzer, freeing all internal memory
+int spzoomcf_destroy(spzoomcf _q);
+
+// Print zoom spectrum analyzer object internals
+int spzoomcf_print(spzoomcf _q);
+
+// Clear the spectral estimates of all regions but retain filter state
+int spzoomcf_clear(spzoomcf _q);
+
+// Reset the object and all regions to their initial states
+int spzoomcf_reset(spzoomcf _q);
+
+// Get number of coarse channels
+unsigned int spzoomcf_get_num_channels(spzoomcf _q);
+
+// Get number of regions of interest
+unsigned int spzoomcf_get_num_regions(spzoomcf _q);
+
+// Get total number of input samples written to the object
+uint64_t spzoomcf_get_num_samples_total(spzoomcf _q);
+
+// Add region of interest. The region spectrum spans 2/M of the input
+// rate centered at _fc, of which the inner 1/M lies in the passband of
+// the coarse channel. Each region estimate uses a Blackman-Harris window
+// of length _nfft with 75% overlap. Regions are indexed in the order they
+// are added.
+//  _q      : zoom spectrum analyzer
+//  _fc     : region center frequency, -0.5 <= _fc < 0.5
+//  _nfft   : region transform size, _nfft >= 2
+int spzoomcf_add_region(spzoomcf     _q,
+                        float        _fc,
+                        unsigned int _nfft);
+
+// Get region center frequency, relative to input rate
+float spzoomcf_get_region_freq(spzoomcf     _q,
+                               unsigned int _id);
+
+// Get region transform size
+unsigned int spzoomcf_get_region_nfft(spzoomcf     _q,
+                                      unsigned int _id);
+
+// Get region resolution bandwidth (bin spacing), relative to input rate
+float spzoomcf_get_region_rbw(spzoomcf     _q,
+                              unsigned int _id);
+
+// Get number of transforms accumulated in region spectral estimate
+unsigned long long int spzoomcf_get_region_num_transforms(spzoomcf     _q,
+                                                          unsigned int _id);
+
+// Set forgetting factor for region spectral estimate; see spgramcf
+//  _q      : zoom spectrum analyzer
+//  _id     : region index
+//  _alpha  : forgetting factor, 0 < _alpha <= 1, or -1 to accumulate
+int spzoomcf_set_region_alpha(spzoomcf     _q,
+                              unsigned int _id,
+                              float        _alpha);
+
+// Get region power spectral density (fft-shifted, dB)
+//  _q      : zoom spectrum analyzer
+//  _id     : region index
+//  _psd    : output spectrum [size: nfft x 1]
+int spzoomcf_get_psd(spzoomcf     _q,
+                     unsigned int _id,
+                     float *      _psd);
+
+// Write block of samples to zoom spectrum analyzer
+//  _q      : zoom spectrum analyzer
+//  _x      : input buffer [size: _n x 1]
+//  _n      : input buffer length
+int spzoomcf_write(spzoomcf               _q,
+                   liquid_float_complex * _x,
+                   unsigned int           _n);
+
 
 //
 // MODULE : filter
@@ -5096,6 +5693,20 @@ int framesync64_print(framesync64 _q);
 // reset frame synchronizer internal state
 int framesync64_reset(framesync64 _q);
 
+// get number of frames currently being demodulated
+unsigned int framesync64_get_num_frames_open(framesync64 _q);
+
+// set number of demodulators available for receiving overlapping or
+// back-to-back frames concurrently (see flexframesync_set_num_demods).
+// Default is 1 (frames received serially). Resets the synchronizer.
+//  _q      :   frame synchronizer object
+//  _n      :   number of demodulators, 0 < _n <= 64
+int framesync64_set_num_demods(framesync64  _q,
+                               unsigned int _n);
+
+// get number of demodulators in pool
+unsigned int framesync64_get_num_demods(framesync64 _q);
+
 // push samples through frame synchronizer
 //  _q      :   frame synchronizer object
 //  _x      :   input samples [size: _n x 1]
@@ -5216,6 +5827,39 @@ int flexframesync_reset(flexframesync _q);
 // has frame been detected?
 int flexframesync_is_frame_open(flexframesync _q);
 
+// get number of frames currently being demodulated
+unsigned int flexframesync_get_num_frames_open(flexframesync _q);
+
+// set number of demodulators available for receiving overlapping or
+// back-to-back frames concurrently. Each frame detected is assigned its
+// own demodulator from a pool of this size while detection continues on
+// the same samples; the detector stalls only when all are busy. Memory
+// is bounded by the pool size. Default is 1 (frames received serially).
+// Resets the synchronizer.
+//  _q      :   frame synchronizer object
+//  _n      :   number of demodulators, 0 < _n <= 64
+int flexframesync_set_num_demods(flexframesync _q,
+                                 unsigned int  _n);
+
+// get number of demodulators in pool
+unsigned int flexframesync_get_num_demods(flexframesync _q);
+
+// enable asynchronous payload decoding. Rather than decoding the payload
+// inline when its last symbol arrives, demodulated bits are handed to a
+// pool of decoder threads and frames are delivered through the callback,
+// in order, during subsequent calls to flexframesync_execute() or
+// flexframesync_async_flush(). Without thread support payloads are
+// decoded synchronously.
+//  _q              :   frame synchronizer object
+//  _queue_len      :   maximum payloads in flight (0 disables)
+//  _num_workers    :   number of decoder threads
+int flexframesync_set_async_decode(flexframesync _q,
+                                   unsigned int  _queue_len,
+                                   unsigned int  _num_workers);
+
+// wait for all payloads being decoded asynchronously and deliver them
+int flexframesync_async_flush(flexframesync _q);
+
 // change length of user-defined region in header
 int flexframesync_set_header_len(flexframesync _q,
                                  unsigned int  _len);
@@ -5619,6 +6263,13 @@ int ofdmflexframegen_write(ofdmflexframegen       _q,
 // OFDM flex frame synchronizer
 //
 
+// per-subcarrier channel tracking methods (see ofdmchtrack)
+typedef enum {
+    LIQUID_OFDMCHTRACK_NONE=0,  // preamble estimate only
+    LIQUID_OFDMCHTRACK_PILOT,   // pilot-aided, interpolated across frequency
+    LIQUID_OFDMCHTRACK_DD,      // pilot-aided plus decision-directed on data
+} liquid_ofdmchtrack_method;
+
 typedef struct ofdmflexframesync_s * ofdmflexframesync;
 
 // create OFDM flexible framing synchronizer object
@@ -5647,6 +6298,19 @@ int ofdmflexframesync_decode_header_soft(ofdmflexframesync _q,
 int ofdmflexframesync_decode_payload_soft(ofdmflexframesync _q,
                                           int _soft);
 
+// enable asynchronous payload decoding on a pool of decoder threads;
+// frames are delivered through the callback, in order, during subsequent
+// calls to ofdmflexframesync_execute() or ofdmflexframesync_async_flush()
+//  _q              :   frame synchronizer object
+//  _queue_len      :   maximum payloads in flight (0 disables)
+//  _num_workers    :   number of decoder threads
+int ofdmflexframesync_set_async_decode(ofdmflexframesync _q,
+                                       unsigned int      _queue_len,
+                                       unsigned int      _num_workers);
+
+// wait for all payloads being decoded asynchronously and deliver them
+int ofdmflexframesync_async_flush(ofdmflexframesync _q);
+
 int ofdmflexframesync_set_header_props(ofdmflexframesync _q,
                                        ofdmflexframegenprops_s * _props);
 
@@ -5669,6 +6333,13 @@ framedatastats_s ofdmflexframesync_get_framedatastats  (ofdmflexframesync _q);
 // set the received carrier offset estimate
 int ofdmflexframesync_set_cfo(ofdmflexframesync _q, float _cfo);
 
+// set per-subcarrier channel tracking method and loop bandwidth;
+// decision-directed tracking follows the header and payload modulation
+// schemes
+int ofdmflexframesync_set_chtrack_method(ofdmflexframesync         _q,
+                                         liquid_ofdmchtrack_method _method);
+int ofdmflexframesync_set_chtrack_bandwidth(ofdmflexframesync _q, float _bw);
+
 // enable/disable debugging
 int ofdmflexframesync_debug_enable(ofdmflexframesync _q);
 int ofdmflexframesync_debug_disable(ofdmflexframesync _q);
@@ -7264,6 +7935,17 @@ T SMATRIX(_get)(SMATRIX()    _q,                                            \
                 unsigned int _m,                                            \
                 unsigned int _n);                                           \
                                                                             \
+/* Get column indices of the non-zero values in a row, in ascending     */  \
+/* order                                                                */  \
+/*  _q      : sparse matrix object                                      */  \
+/*  _m      : row index                                                 */  \
+/*  _idx    : output column indices [size: at most num cols x 1]        */  \
+/*  _num    : number of non-zero values in row                          */  \
+int SMATRIX(_get_row)(SMATRIX()      _q,                                    \
+                      unsigned int   _m,                                    \
+                      unsigned int * _idx,                                  \
+                      unsigned int * _num);                                 \
+                                                                            \
 /* Initialize to identity matrix; set all diagonal elements to 1, all   */  \
 /* others to 0. This is done with both square and non-square matrices.  */  \
 int SMATRIX(_eye)(SMATRIX() _q);                                            \
@@ -7283,6 +7965,26 @@ int SMATRIX(_mul)(SMATRIX() _x,                                             \
 int SMATRIX(_vmul)(SMATRIX() _q,                                            \
                    T *       _x,                                            \
                    T *       _y);                                           \
+                                                                            \
+/* Multiply sparse matrix by a block of vectors, stored as the columns  */  \
+/* of a dense row-major matrix                                          */  \
+/*  _q      : sparse matrix                                             */  \
+/*  _x      : input vectors, [size: _n x _num]                          */  \
+/*  _y      : output vectors, [size: _m x _num]                         */  \
+/*  _num    : number of vectors                                         */  \
+int SMATRIX(_vmul_block)(SMATRIX()    _q,                                   \
+                         T *          _x,                                   \
+                         T *          _y,                                   \
+                         unsigned int _num);                                \
+                                                                            \
+/* Compress sparse matrix into contiguous compressed-row and            */  \
+/* compressed-column storage for faster products. Zero-valued entries   */  \
+/* are dropped and the matrix cannot be modified afterwards; methods    */  \
+/* which change values (e.g. set, insert, delete) return an error.      */  \
+int SMATRIX(_compress)(SMATRIX() _q);                                       \
+                                                                            \
+/* Determine if sparse matrix has been compressed                       */  \
+int SMATRIX(_is_compressed)(SMATRIX() _q);                                  \
 
 LIQUID_SMATRIX_DEFINE_API(LIQUID_SMATRIX_MANGLE_BOOL,  unsigned char)
 LIQUID_SMATRIX_DEFINE_API(LIQUID_SMATRIX_MANGLE_FLOAT, float)
@@ -7312,6 +8014,14 @@ int smatrixb_vmulf(smatrixb _q,
                    float *  _x,
                    float *  _y);
 
+// multiply sparse binary matrix by bit-packed vector in GF(2)
+//  _q  :   sparse matrix
+//  _x  :   input vector, packed msb first [size: ceil(_N/8) x 1]
+//  _y  :   output vector, packed msb first [size: ceil(_M/8) x 1]
+int smatrixb_vmul_packed(smatrixb        _q,
+                         unsigned char * _x,
+                         unsigned char * _y);
+
 
 //
 // MODULE : modem (modulator/demodulator)
@@ -7536,6 +8246,18 @@ int MODEM(_demodulate_soft)(MODEM()         _q,                             \
                             unsigned int  * _s,                             \
                             unsigned char * _soft_bits);                    \
                                                                             \
+/* Demodulate block of input samples, providing soft bits for each     */  \
+/* sample in turn; internal demodulator state (e.g. the estimated       */  \
+/* transmit sample) reflects the last sample in the block.              */  \
+/*  _q          : modem object                                          */  \
+/*  _x          : input samples, [size: _n x 1]                         */  \
+/*  _n          : number of input samples                               */  \
+/*  _soft_bits  : output soft bits, [size: _n log2(M) x 1]              */  \
+int MODEM(_demodulate_soft_block)(MODEM()         _q,                       \
+                                  TC *            _x,                       \
+                                  unsigned int    _n,                       \
+                                  unsigned char * _soft_bits);              \
+                                                                            \
 /* Get demodulator's estimated transmit sample                          */  \
 int MODEM(_get_demodulator_sample)(MODEM() _q,                              \
                                    TC *    _x_hat);                         \
@@ -8191,6 +8913,49 @@ int ofdmframe_print_sctype(unsigned char * _p,
                            unsigned int    _M);
 
 
+//
+// OFDM per-subcarrier channel tracker (liquid_ofdmchtrack_method is
+// defined with the OFDM flex frame synchronizer)
+//
+
+typedef struct ofdmchtrack_s * ofdmchtrack;
+
+// create OFDM channel tracker; tracking is disabled until a method
+// other than LIQUID_OFDMCHTRACK_NONE is set
+//  _M          :   number of subcarriers
+//  _p          :   subcarrier allocation (null, pilot, data), [size: _M x 1]
+ofdmchtrack ofdmchtrack_create(unsigned int    _M,
+                               unsigned char * _p);
+int ofdmchtrack_destroy(ofdmchtrack _q);
+int ofdmchtrack_print(ofdmchtrack _q);
+
+// reset tracking state at the start of a frame; the equalizer passed to
+// the next call to ofdmchtrack_execute() is taken as the reference
+int ofdmchtrack_reset(ofdmchtrack _q);
+
+// set tracking method
+int ofdmchtrack_set_method(ofdmchtrack _q, liquid_ofdmchtrack_method _method);
+
+// set tracking loop bandwidth, _bw in (0,1], default 0.2
+int ofdmchtrack_set_bandwidth(ofdmchtrack _q, float _bw);
+
+// set modulation scheme of data subcarriers for decision-directed
+// tracking; LIQUID_MODEM_UNKNOWN disables decisions
+int ofdmchtrack_set_scheme(ofdmchtrack _q, modulation_scheme _ms);
+
+// track channel over one received symbol
+//  _q      :   channel tracker
+//  _Y      :   equalized subcarrier values, corrected in place, [size: _M x 1]
+//  _S      :   known pilot values in order of increasing frequency, [size: M_pilot x 1]
+//  _Wr     :   real part of equalizer gain that produced _Y, each value
+//              repeated twice (ofdmframesync layout), updated in place, [size: 2 _M x 1]
+//  _Wi     :   imaginary part of equalizer gain, as _Wr, [size: 2 _M x 1]
+int ofdmchtrack_execute(ofdmchtrack            _q,
+                        liquid_float_complex * _Y,
+                        liquid_float_complex * _S,
+                        float *                _Wr,
+                        float *                _Wi);
+
 //
 // OFDM frame (symbol) generator
 //
@@ -8229,6 +8994,17 @@ int ofdmframegen_writesymbol(ofdmframegen _q,
                              liquid_float_complex * _x,
                              liquid_float_complex *_y);
 
+// write block of data symbols, equivalent to _num_symbols consecutive
+// calls to ofdmframegen_writesymbol()
+//  _q              :   framing generator object
+//  _x              :   input subcarrier values, [size: _num_symbols*M x 1]
+//  _num_symbols    :   number of OFDM symbols
+//  _y              :   output samples, [size: _num_symbols*(M+cp_len) x 1]
+int ofdmframegen_write_block(ofdmframegen           _q,
+                             liquid_float_complex * _x,
+                             unsigned int           _num_symbols,
+                             liquid_float_complex * _y);
+
 // write tail
 int ofdmframegen_writetail(ofdmframegen _q,
                            liquid_float_complex * _x);
@@ -8270,6 +9046,13 @@ float ofdmframesync_get_cfo(ofdmframesync _q);  // carrier offset estimate
 // set methods
 int ofdmframesync_set_cfo(ofdmframesync _q, float _cfo);  // set carrier offset estimate
 
+// set per-subcarrier channel tracking method, loop bandwidth, and the
+// modulation scheme used for decision-directed tracking on data
+// subcarriers (see ofdmchtrack)
+int ofdmframesync_set_chtrack_method(ofdmframesync _q, liquid_ofdmchtrack_method _method);
+int ofdmframesync_set_chtrack_bandwidth(ofdmframesync _q, float _bw);
+int ofdmframesync_set_chtrack_scheme(ofdmframesync _q, modulation_scheme _ms);
+
 // debugging
 int ofdmframesync_debug_enable(ofdmframesync _q);
 int ofdmframesync_debug_disable(ofdmframesync _q);
@@ -8288,6 +9071,18 @@ typedef enum {
     LIQUID_VCO
 } liquid_ncotype;
 
+// method for computing sine and cosine of oscillator phase
+//  LIQUID_NCO_MIX_TABLE    :   1024-point sine look-up table (default)
+//  LIQUID_NCO_MIX_POLY     :   polynomial, block mixing evaluates several
+//                              phases at a time
+//  LIQUID_NCO_MIX_ROTATE   :   block mixing rotates a complex phasor,
+//                              periodically re-computed from the phase
+typedef enum {
+    LIQUID_NCO_MIX_TABLE=0,
+    LIQUID_NCO_MIX_POLY,
+    LIQUID_NCO_MIX_ROTATE
+} liquid_ncomix;
+
 #define LIQUID_NCO_MANGLE_FLOAT(name) LIQUID_CONCAT(nco_crcf, name)
 
 // large macro
@@ -8296,7 +9091,8 @@ typedef enum {
 //   TC     : input/output data type
 #define LIQUID_NCO_DEFINE_API(NCO,T,TC)                                     \
                                                                             \
-/* Numerically-controlled oscillator object                             */  \
+/* Numerically-controlled oscillator object with 64-bit fixed-point     */  \
+/* phase accumulator                                                    */  \
 typedef struct NCO(_s) * NCO();                                             \
                                                                             \
 /* Create nco object with either fixed-point or floating-point phase    */  \
@@ -8343,6 +9139,17 @@ int NCO(_set_phase)(NCO() _q,                                               \
 int NCO(_adjust_phase)(NCO() _q,                                            \
                        T     _dphi);                                        \
                                                                             \
+/* Set method used for computing sine and cosine of the internal phase, */  \
+/* including in block mixing. The polynomial and rotation methods have  */  \
+/* a far lower spurious level than the default look-up table.           */  \
+/*  _q      : nco object                                                */  \
+/*  _method : sin/cos method, e.g. LIQUID_NCO_MIX_POLY                  */  \
+int NCO(_set_mix_method)(NCO()         _q,                                  \
+                         liquid_ncomix _method);                            \
+                                                                            \
+/* Get method used for computing sine and cosine of the internal phase  */  \
+liquid_ncomix NCO(_get_mix_method)(NCO() _q);                               \
+                                                                            \
 /* Increment phase by internal phase step (frequency)                   */  \
 int NCO(_step)(NCO() _q);                                                   \
                                                                             \
@@ -8907,6 +9714,42 @@ float randricekf(float _K, float _omega);
 float randricekf_cdf(float _x, float _K, float _omega);
 float randricekf_pdf(float _x, float _K, float _omega);
 
+// Counter-based random number generator (Philox-4x32-10) with explicit
+// per-stream state; each (seed, stream) pair yields an independent and
+// reproducible sequence, and separate objects may be run concurrently
+typedef struct randgen_s * randgen;
+
+// create counter-based random number generator
+//  _seed   :   generator seed (key)
+//  _stream :   stream identifier
+randgen randgen_create(unsigned long _seed, unsigned long _stream);
+int randgen_destroy(randgen _q);
+int randgen_print(randgen _q);
+
+// reset generator to start of its stream
+int randgen_reset(randgen _q);
+
+// set generator seed and stream, and reset to start of stream
+int randgen_set_seed(randgen _q, unsigned long _seed, unsigned long _stream);
+
+// generate block of uniform random numbers in [0,1)
+int randgen_uniform(randgen _q, float * _x, unsigned int _n);
+
+// generate block of Gauss random numbers, N(0,1)
+int randgen_normal(randgen _q, float * _x, unsigned int _n);
+
+// generate block of Weibull random numbers (see randweibf)
+int randgen_weib(randgen _q, float _alpha, float _beta, float _gamma,
+                 float * _x, unsigned int _n);
+
+// generate block of Nakagami-m random numbers (see randnakmf)
+int randgen_nakm(randgen _q, float _m, float _omega,
+                 float * _x, unsigned int _n);
+
+// generate block of Rice-K random numbers (see randricekf)
+int randgen_ricek(randgen _q, float _K, float _omega,
+                  float * _x, unsigned int _n);
+
 
 // Data scrambler : whiten data sequence
 void scramble_data(unsigned char * _x, unsigned int _len);
@@ -9015,6 +9858,14 @@ int msequence_print(msequence _m);
 // advance msequence on shift register, returning output bit
 unsigned int msequence_advance(msequence _ms);
 
+// advance msequence _n steps without computing intermediate outputs
+// (jump ahead), allowing independent generators to produce the same
+// sequence starting from different offsets
+//  _ms     :   m-sequence object
+//  _n      :   number of steps to advance
+int msequence_advance_n(msequence     _ms,
+                        unsigned long _n);
+
 // generate pseudo-random symbol from shift register by
 // advancing _bps bits and returning compacted symbol
 //  _ms     :   m-sequence object
@@ -9207,6 +10058,51 @@ int liquid_get_scale(float   _val,
                      char *  _unit,
                      float * _scale);
 
+// Arena allocator: dotprod, window, firfilt, firpfb and ldpc objects
+// created on a thread between liquid_arena_begin() and liquid_arena_end()
+// draw their internal memory from the arena with 64-byte alignment,
+// packed contiguously, and are all freed at once by liquid_arena_destroy().
+// Destroying such objects individually is allowed but does not release
+// arena memory. Other objects are allocated from the heap as usual and
+// must still be destroyed individually.
+typedef struct liquid_arena_s * liquid_arena;
+
+// create arena
+//  _num_bytes  :   initial capacity and size of additional chunks
+//                  [bytes]; 0 selects a default
+liquid_arena liquid_arena_create(unsigned int _num_bytes);
+
+// destroy arena, freeing all memory allocated from it
+int liquid_arena_destroy(liquid_arena _q);
+
+// print arena usage to stdout
+int liquid_arena_print(liquid_arena _q);
+
+// release all allocations; objects created from the arena must no
+// longer be used
+int liquid_arena_reset(liquid_arena _q);
+
+// allocate block of memory from arena, aligned to 64 bytes
+//  _q          :   arena object
+//  _num_bytes  :   size of block [bytes]
+void * liquid_arena_alloc(liquid_arena _q,
+                          unsigned int _num_bytes);
+
+// get number of bytes allocated, including alignment padding
+unsigned int liquid_arena_get_num_bytes(liquid_arena _q);
+
+// get total number of bytes reserved by the arena
+unsigned int liquid_arena_get_capacity(liquid_arena _q);
+
+// get number of blocks allocated
+unsigned int liquid_arena_get_num_allocations(liquid_arena _q);
+
+// start allocating objects created on the calling thread from arena
+int liquid_arena_begin(liquid_arena _q);
+
+// stop allocating objects from arena
+int liquid_arena_end(liquid_arena _q);
+
 //
 // MODULE : vector
 //
@@ -36,6 +36,7 @@
 #include "config.h"
 
 #include <stdarg.h>
+#include <stddef.h>
 #include <complex.h>
 #include "liquid.h"
 
@@ -43,6 +44,10 @@
 #  define LIBFEC_ENABLED 1
 #endif
 
+#if defined HAVE_PTHREAD_H && defined HAVE_LIBPTHREAD && defined HAVE_STDATOMIC_H
+#  define LIQUID_THREADS_ENABLED 1
+#endif
+
 // report error
 int liquid_error_fl(int _code, const char * _file, int _line, const char * _format, ...);
 
@@ -82,6 +87,17 @@ void * liquid_error_config_fl(const char * _file, int _line, const char * _forma
 // MODULE : buffer
 //
 
+// get granularity of mirrored memory regions [bytes]
+size_t liquid_mirror_pagesize(void);
+
+// allocate region of _len bytes (a multiple of liquid_mirror_pagesize())
+// whose pages are mapped twice at consecutive addresses, so that byte i
+// and byte i+_len alias one another; returns NULL if not supported
+void * liquid_mirror_alloc(size_t _len);
+
+// free region allocated with liquid_mirror_alloc()
+int liquid_mirror_free(void * _p, size_t _len);
+
 
 //
 // MODULE : dotprod
@@ -158,6 +174,12 @@ struct fec_s {
     int * derrlocs;             // decoded error locations [size: 1 x n]
     int erasures;               // number of erasures
 
+    // low-density parity-check
+    ldpc ldpc;                  // code object
+    unsigned char * ldpc_msg;   // message bits [size: k x 1]
+    unsigned char * ldpc_cw;    // codeword bits [size: n x 1]
+    float * ldpc_llr;           // log-likelihood ratios [size: n x 1]
+
     // encode function pointer
     int (*encode_func)(fec _q,
                        unsigned int _dec_msg_len,
@@ -278,6 +300,7 @@ unsigned char fecsoft_hamming84_decode(unsigned char * _soft_bits);
 unsigned int fec_hamming128_encode_symbol(unsigned int _sym_dec);
 unsigned int fec_hamming128_decode_symbol(unsigned int _sym_enc);
 extern unsigned short int hamming128_enc_gentab[256];   // encoding table
+extern unsigned char hamming128_dec_gentab[4096];       // decoding table
 
 fec fec_hamming128_create(void *_opts);
 int fec_hamming128_destroy(fec _q);
@@ -316,6 +339,8 @@ unsigned int fec_golay2412_decode_symbol(unsigned int _sym_enc);
 extern unsigned int golay2412_P[12];
 extern unsigned int golay2412_Gt[24];
 extern unsigned int golay2412_H[12];
+extern unsigned short int golay2412_enc_gentab[2][64];  // parity tables
+extern unsigned short int golay2412_dec_gentab[4096];   // syndrome table
 
 // multiply input vector with matrix
 unsigned int golay2412_matrix_mul(unsigned int   _v,
@@ -336,6 +361,12 @@ int fec_golay2412_decode(fec _q,
                          unsigned int _dec_msg_len,
                          unsigned char * _msg_enc,
                          unsigned char * _msg_dec);
+int fec_golay2412_decode_soft(fec _q,
+                              unsigned int _dec_msg_len,
+                              unsigned char * _msg_enc,
+                              unsigned char * _msg_dec);
+// soft decoding of one symbol (Chase-2 search)
+unsigned int fecsoft_golay2412_decode(unsigned char * _soft_bits);
 
 // SEC-DED (22,16)
 
@@ -369,6 +400,13 @@ extern unsigned char secded2216_P[12];
 // syndrome vectors of errors with weight exactly equal to 1
 extern unsigned char secded2216_syndrome_w1[22];
 
+// parity contribution of each data byte [2 x 256]
+extern unsigned char secded2216_enc_gentab[2][256];
+
+// syndrome decoding table: 0 (no error), one-based index of single
+// bit error, or 0xff (multiple errors)
+extern unsigned char secded2216_syn_gentab[64];
+
 fec fec_secded2216_create(void *_opts);
 int fec_secded2216_destroy(fec _q);
 int fec_secded2216_print(fec _q);
@@ -413,6 +451,13 @@ extern unsigned char secded3932_P[28];
 // syndrome vectors of errors with weight exactly equal to 1
 extern unsigned char secded3932_syndrome_w1[39];
 
+// parity contribution of each data byte [4 x 256]
+extern unsigned char secded3932_enc_gentab[4][256];
+
+// syndrome decoding table: 0 (no error), one-based index of single
+// bit error, or 0xff (multiple errors)
+extern unsigned char secded3932_syn_gentab[128];
+
 fec fec_secded3932_create(void *_opts);
 int fec_secded3932_destroy(fec _q);
 int fec_secded3932_print(fec _q);
@@ -454,6 +499,13 @@ int fec_secded7264_decode_symbol(unsigned char * _sym_enc,
 extern unsigned char secded7264_P[64];
 extern unsigned char secded7264_syndrome_w1[72];
 
+// parity contribution of each data byte [8 x 256]
+extern unsigned char secded7264_enc_gentab[8][256];
+
+// syndrome decoding table: 0 (no error), one-based index of single
+// bit error, or 0xff (multiple errors)
+extern unsigned char secded7264_syn_gentab[256];
+
 fec fec_secded7264_create(void *_opts);
 int fec_secded7264_destroy(fec _q);
 int fec_secded7264_print(fec _q);
@@ -594,8 +646,30 @@ int fec_rs_decode(fec _q,
                   unsigned char * _msg_enc,
                   unsigned char * _msg_dec);
 
-// phi(x) = -logf( tanhf( x/2 ) )
-float sumproduct_phi(float _x);
+// low-density parity-check codes
+
+// compute encoded message length for LDPC codes
+//  _dec_msg_len    :   decoded message length (bytes)
+//  _n              :   codeword length (bits)
+//  _k              :   message length per codeword (bits)
+unsigned int fec_ldpc_get_enc_msg_len(unsigned int _dec_msg_len,
+                                      unsigned int _n,
+                                      unsigned int _k);
+
+fec fec_ldpc_create(fec_scheme _fs);
+int fec_ldpc_destroy(fec _q);
+int fec_ldpc_encode(fec _q,
+                    unsigned int _dec_msg_len,
+                    unsigned char * _msg_dec,
+                    unsigned char * _msg_enc);
+int fec_ldpc_decode_hard(fec _q,
+                         unsigned int _dec_msg_len,
+                         unsigned char * _msg_enc,
+                         unsigned char * _msg_dec);
+int fec_ldpc_decode_soft(fec _q,
+                         unsigned int _dec_msg_len,
+                         unsigned char * _msg_enc,
+                         unsigned char * _msg_dec);
 
 // iterate over the sum-product algorithm:
 // returns 1 if parity checks, 0 otherwise
@@ -612,28 +686,6 @@ int fec_sumproduct(unsigned int    _m,
                    unsigned char * _c_hat,
                    unsigned int    _max_steps);
 
-// sum-product algorithm, returns 1 if parity checks, 0 otherwise
-//  _m      :   rows
-//  _n      :   cols
-//  _H      :   sparse binary parity check matrix [size: _m x _n]
-//  _c_hat  :   estimated transmitted signal [size: _n x 1]
-//
-// internal state arrays
-//  _Lq     :   [size: _m x _n]
-//  _Lr     :   [size: _m x _n]
-//  _Lc     :   [size: _n x 1]
-//  _LQ     :   [size: _n x 1]
-//  _parity :   _H * _c_hat [size: _m x 1]
-int fec_sumproduct_step(unsigned int    _m,
-                        unsigned int    _n,
-                        smatrixb        _H,
-                        unsigned char * _c_hat,
-                        float *         _Lq,
-                        float *         _Lr,
-                        float *         _Lc,
-                        float *         _LQ,
-                        unsigned char * _parity);
-
 //
 // packetizer
 //
@@ -664,8 +716,16 @@ struct packetizer_s {
     struct fecintlv_plan * plan;
     unsigned int plan_len;
 
-    // buffers (ping-pong)
+    // compiled execution plan: indices of stages in 'plan' which
+    // modify the data, in encoding order (pass-through stages using
+    // LIQUID_FEC_NONE are elided when the object is created)
+    unsigned int * exec;
+    unsigned int exec_len;
+
+    // buffers (ping-pong), both carved from a single arena; buffer_1
+    // is scaled by 8 to hold soft bits
     unsigned int buffer_len;
+    unsigned char * arena;
     unsigned char * buffer_0;
     unsigned char * buffer_1;
 };
@@ -1043,6 +1103,77 @@ void bpacketgen_assemble_header(bpacketgen _q);
 #define DSSSFRAME_H_FEC0         (LIQUID_FEC_GOLAY2412)
 #define DSSSFRAME_H_FEC1         (LIQUID_FEC_NONE)
 
+//
+// qdetector
+//
+
+// get correlation of the most recently detected sequence normalized by the
+// level of the aligned samples alone. The detection metric is normalized by
+// the mean level of the whole search buffer and can be inflated when only
+// part of that buffer holds signal, e.g. at the trailing edge of a frame.
+float qdetector_cccf_get_rxy_aligned(qdetector_cccf _q);
+
+//
+// framedecq : payload decoder queue
+//
+// Decodes frame payloads off the sample-processing path on a pool of
+// worker threads; frames are delivered through the framesync callback in
+// the order they were pushed, from the thread calling _deliver/_flush.
+// Without thread support (or with zero workers) payloads are decoded
+// synchronously as they are pushed.
+typedef struct framedecq_s * framedecq;
+
+// create payload decoder queue
+//  _queue_len      :   maximum number of outstanding payloads, _queue_len > 0
+//  _num_workers    :   number of decoder threads (0 to decode synchronously)
+//  _callback       :   user-defined callback invoked for each decoded frame
+//  _userdata       :   user-defined data passed to callback
+//  _stats          :   frame data statistics updated on delivery (can be NULL)
+framedecq framedecq_create(unsigned int       _queue_len,
+                           unsigned int       _num_workers,
+                           framesync_callback _callback,
+                           void *             _userdata,
+                           framedatastats_s * _stats);
+
+// destroy queue, discarding any payloads that have not been delivered
+int framedecq_destroy(framedecq _q);
+
+// get number of payloads pushed but not yet delivered
+unsigned int framedecq_get_num_pending(framedecq _q);
+
+// push encoded payload onto queue, blocking until the oldest payload has
+// been decoded and delivered if the queue is full; header, payload and
+// frame symbols (_stats.framesyms) are copied
+//  _q              :   payload decoder queue
+//  _header         :   decoded header [size: _header_len x 1]
+//  _header_len     :   decoded header length
+//  _header_valid   :   header valid flag
+//  _payload_enc    :   encoded payload (packed bytes or soft bits)
+//  _soft           :   flag indicating _payload_enc holds soft bits
+//  _payload_len    :   decoded payload length
+//  _check          :   payload validity check
+//  _fec0           :   payload inner FEC scheme
+//  _fec1           :   payload outer FEC scheme
+//  _stats          :   frame synchronizer statistics
+int framedecq_push(framedecq        _q,
+                   unsigned char *  _header,
+                   unsigned int     _header_len,
+                   int              _header_valid,
+                   unsigned char *  _payload_enc,
+                   int              _soft,
+                   unsigned int     _payload_len,
+                   crc_scheme       _check,
+                   fec_scheme       _fec0,
+                   fec_scheme       _fec1,
+                   framesyncstats_s _stats);
+
+// invoke callback for decoded payloads at the head of the queue without
+// blocking, returning the number of frames delivered
+unsigned int framedecq_deliver(framedecq _q);
+
+// wait for all outstanding payloads to be decoded and delivered
+int framedecq_flush(framedecq _q);
+
 //
 // multi-signal source for testing (no meaningful data, just signals)
 //
@@ -1381,6 +1512,10 @@ int MODEM(_demodulate_soft_qpsk)(MODEM()         _q,            \
                                  TC              _x,            \
                                  unsigned int *  _sym_out,      \
                                  unsigned char * _soft_bits);   \
+int MODEM(_demodulate_soft_block_qpsk)(MODEM()         _q,      \
+                                       TC *            _x,      \
+                                       unsigned int    _n,      \
+                                       unsigned char * _soft_bits);\
 int MODEM(_demodulate_soft_pi4dqpsk)(MODEM()         _q,        \
                                      TC              _x,        \
                                      unsigned int *  _sym_out,  \
@@ -1471,6 +1606,11 @@ extern const float complex modem_arb64opt[64];
 extern const float complex modem_arb128opt[128];
 extern const float complex modem_arb256opt[256];
 
+// enable/disable fskdem tone bank which computes only the required bins
+// rather than the full FFT; chosen automatically when object is created
+int fskdem_set_tone_bank(fskdem _q,
+                         int    _enable);
+
 
 //
 // MODULE : multichannel
@@ -1516,6 +1656,12 @@ int ofdmframesync_execute_S0b(ofdmframesync _q);
 int ofdmframesync_execute_S1( ofdmframesync _q);
 int ofdmframesync_execute_rxsymbols(ofdmframesync _q);
 
+// receive payload samples in a block up to the next symbol boundary,
+// returning the number of input samples consumed
+unsigned int ofdmframesync_execute_rxblock(ofdmframesync   _q,
+                                           float complex * _x,
+                                           unsigned int    _n);
+
 int ofdmframesync_S0_metrics(ofdmframesync   _q,
                              float complex * _G,
                              float complex * _s_hat);
@@ -1551,6 +1697,44 @@ int ofdmframesync_estimate_eqgain_poly(ofdmframesync _q,
 // recover symbol, correcting for gain, pilot phase, etc.
 int ofdmframesync_rxsymbol(ofdmframesync _q);
 
+// apply equalizer gain and pilot phase ramp to _n subcarriers in place,
+//  _X[i] <- _X[i] R[i] exp(-j(_theta + i _dtheta))
+//  _X      :   subcarrier values [size: _n x 1]
+//  _Rr     :   equalizer gain, real part (each repeated twice) [size: 2 _n x 1]
+//  _Ri     :   equalizer gain, imag part (each repeated twice) [size: 2 _n x 1]
+//  _n      :   number of subcarriers
+//  _theta  :   phase of first subcarrier
+//  _dtheta :   phase step between subcarriers
+int ofdmframesync_equalize(float complex * _X,
+                           const float *   _Rr,
+                           const float *   _Ri,
+                           unsigned int    _n,
+                           float           _theta,
+                           float           _dtheta);
+
+// relative error of received value _y against reference _d, (_d-_y)/_d,
+// limited in magnitude to suppress wrong decisions and deep fades
+float complex ofdmchtrack_error(float complex _y,
+                                float complex _d);
+
+// set equalizer to inverse of channel estimate and, if _Y is not NULL,
+// move current symbol from previous to new equalizer; for each subcarrier
+//  W <- 1/_H,  _Y <- _Y W _H_prev
+// where zero channel estimates (null subcarriers) give zero gain; the
+// gain is written in the ofdmframesync equalizer layout
+//  _H      :   channel estimate [size: _n x 1]
+//  _H_prev :   channel estimate that produced _Y [size: _n x 1]
+//  _Wr     :   output gain, real part (each repeated twice) [size: 2 _n x 1]
+//  _Wi     :   output gain, imag part (each repeated twice) [size: 2 _n x 1]
+//  _Y      :   current symbol (ignored if NULL) [size: _n x 1]
+//  _n      :   number of subcarriers
+int ofdmchtrack_invert(float complex * _H,
+                       float complex * _H_prev,
+                       float *         _Wr,
+                       float *         _Wi,
+                       float complex * _Y,
+                       unsigned int    _n);
+
 // 
 // MODULE : nco (numerically-controlled oscillator)
 //
@@ -1704,6 +1888,20 @@ float complex icrandnf();
 // generate x ~ Gamma(delta,1)
 float randgammaf_delta(float _delta);
 
+// compute single Philox-4x32-10 block
+//  _ctr    :   counter [size: 4 x 1]
+//  _key    :   key [size: 2 x 1]
+//  _y      :   output words [size: 4 x 1]
+void randgen_philox4x32(const uint32_t * _ctr,
+                        const uint32_t * _key,
+                        uint32_t *       _y);
+
+// map 32-bit generator word to uniform value in [0,1) using 24 bits, and
+// to (0,1) using 23 bits so that the half-step offset stays exact in
+// single precision
+#define randgen_u32_to_uni(u)       ((float)((u) >> 8) * (1.0f / 16777216.0f))
+#define randgen_u32_to_uni_open(u)  (((float)((u) >> 9) + 0.5f) * (1.0f / 8388608.0f))
+
 // data scrambler masks
 #define LIQUID_SCRAMBLE_MASK0   (0xb4)
 #define LIQUID_SCRAMBLE_MASK1   (0x6a)
@@ -1723,6 +1921,13 @@ struct msequence_s {
     unsigned int n;     // length of sequence, n = (2^m)-1
     unsigned int v;     // shift register
     unsigned int b;     // return bit
+
+    // word-parallel generator: the next 32 output bits of the register
+    // are linear in its state and are looked up one state byte at a
+    // time, i.e. w(v) = tab[0][v & 0xff] ^ tab[1][(v>>8) & 0xff]
+    uint32_t * tab;     // lookup tables [size: 2*256 x 1]
+    uint32_t   w;       // buffered output bits, most-significant first
+    unsigned int nw;    // number of valid bits in buffer
 };
 
 // Default msequence generator objects
@@ -1733,6 +1938,17 @@ extern struct msequence_s msequence_default[16];
 // MODULE : utility
 //
 
+// allocate block of memory aligned to 64 bytes, drawn from the active
+// arena if one has been set with liquid_arena_begin(); such blocks must
+// be released with liquid_free() rather than free()
+void * liquid_malloc(size_t _n);
+void * liquid_calloc(size_t _num, size_t _size);
+void * liquid_realloc(void * _p, size_t _n);
+void   liquid_free(void * _p);
+
+// non-zero if liquid_malloc() currently draws from an arena on this thread
+int liquid_arena_is_active(void);
+
 // number of ones in a byte
 //  0   0000 0000   :   0
 //  1   0000 0001   :   1
@@ -1795,10 +2011,19 @@ extern const unsigned char liquid_c_ones_mod2[256];
     liquid_c_ones_mod2[ ((x)>>16)  & 0xff ] +       \
     liquid_c_ones_mod2[ ((x)>>24)  & 0xff ]) % 2)
 
+#if defined(__GNUC__)
+#  define liquid_count_ones_mod2_uint64(x) ((unsigned int)__builtin_parityll(x))
+#else
+#  define liquid_count_ones_mod2_uint64(x) ((       \
+    liquid_count_ones_mod2_uint32((x)      ) +      \
+    liquid_count_ones_mod2_uint32((x) >> 32)) % 2)
+#endif
+
 // compute binary dot-products (inline pre-processor macros)
 #define liquid_bdotprod_uint8(x,y)  liquid_c_ones_mod2[(x)&(y)]
 #define liquid_bdotprod_uint16(x,y) liquid_count_ones_mod2_uint16((x)&(y))
 #define liquid_bdotprod_uint32(x,y) liquid_count_ones_mod2_uint32((x)&(y))
+#define liquid_bdotprod_uint64(x,y) liquid_count_ones_mod2_uint64((x)&(y))
 
 // number of leading zeros in byte
 extern unsigned int liquid_c_leading_zeros[256];
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2007 - 2022 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Golay(24,12) code look-up table generator
+//
+// Prints the parity tables (the 12 parity bits of a symbol are the
+// XOR of the entries for its upper and lower six bits) and the
+// syndrome table holding the lower 12 bits of the error vector the
+// algebraic decoder estimates for each syndrome.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "liquid.internal.h"
+
+int main()
+{
+    unsigned int i, j;
+
+    // parity tables: upper/lower six bits of 12-bit symbol
+    printf("// parity of upper/lower six bits of 12-bit input symbol\n");
+    printf("unsigned short int golay2412_enc_gentab[2][64] = {\n");
+    for (i=0; i<2; i++) {
+        printf("  {");
+        for (j=0; j<64; j++) {
+            unsigned int m = i==0 ? j << 6 : j;
+            unsigned int p = fec_golay2412_encode_symbol(m) >> 12;
+            printf("%s0x%.3x%s", (j%8)==0 ? "\n    " : " ",
+                   p, j==63 ? "" : ",");
+        }
+        printf("}%s\n", i==1 ? "};" : ",");
+    }
+    printf("\n");
+
+    // syndrome table: for received vector r with syndrome s, the
+    // decoded message is (r ^ tab[s]) & 0xfff. A received vector
+    // [s, 0(12)] has syndrome s, so decoding it yields tab[s] directly.
+    printf("// lower 12 bits of estimated error vector for each syndrome\n");
+    printf("unsigned short int golay2412_dec_gentab[4096] = {");
+    for (i=0; i<4096; i++) {
+        unsigned int e = fec_golay2412_decode_symbol(i << 12);
+        printf("%s0x%.3x%s", (i%8)==0 ? "\n    " : " ",
+               e, i==4095 ? "};\n" : ",");
+    }
+
+    return 0;
+}
+
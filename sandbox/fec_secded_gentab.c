@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2007 - 2022 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// SEC-DED (22,16), (39,32), (72,64) look-up table generator
+//
+// Prints the byte-wise parity tables (one 256-entry table per input
+// byte, XOR-ed together to form the parity bits of a full symbol) and
+// the syndrome table mapping each syndrome to the (one-based) index of
+// the single bit error it implies, 0 for no error, and 0xff for an
+// uncorrectable error pattern.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "liquid.internal.h"
+
+// print tables for a SEC-DED code
+//  _name   :   code name, e.g. "secded2216"
+//  _P      :   parity matrix [_np x _k bytes]
+//  _k      :   number of data bytes per symbol
+//  _np     :   number of parity bits per symbol
+//  _w1     :   syndromes of weight-one error vectors [size: _n x 1]
+//  _n      :   number of encoded bits per symbol
+void secded_gentab(const char *    _name,
+                   unsigned char * _P,
+                   unsigned int    _k,
+                   unsigned int    _np,
+                   unsigned char * _w1,
+                   unsigned int    _n)
+{
+    unsigned int b, v, i, n;
+
+    // parity contribution of each data byte
+    printf("// parity contribution of each data byte\n");
+    printf("unsigned char %s_enc_gentab[%u][256] = {\n", _name, _k);
+    for (b=0; b<_k; b++) {
+        printf("  {");
+        for (v=0; v<256; v++) {
+            unsigned char parity = 0;
+            for (i=0; i<_np; i++)
+                parity = (parity << 1) | (liquid_c_ones[ _P[_k*i+b] & v ] & 1);
+
+            printf("%s0x%.2x%s", (v%16)==0 ? "\n    " : " ",
+                   parity, v==255 ? "" : ",");
+        }
+        printf("}%s\n", b==_k-1 ? "};" : ",");
+    }
+    printf("\n");
+
+    // syndrome decoding table
+    unsigned int ns = 1 << _np;
+    printf("// syndrome decoding table\n");
+    printf("unsigned char %s_syn_gentab[%u] = {", _name, ns);
+    for (v=0; v<ns; v++) {
+        unsigned char t = v == 0 ? 0x00 : 0xff;
+        for (n=0; n<_n && v != 0; n++) {
+            if (_w1[n] == v) {
+                t = n + 1;
+                break;
+            }
+        }
+        printf("%s0x%.2x%s", (v%16)==0 ? "\n    " : " ",
+               t, v==ns-1 ? "};\n" : ",");
+    }
+    printf("\n");
+}
+
+int main()
+{
+    secded_gentab("secded2216", secded2216_P, 2, 6, secded2216_syndrome_w1, 22);
+    secded_gentab("secded3932", secded3932_P, 4, 7, secded3932_syndrome_w1, 39);
+    secded_gentab("secded7264", secded7264_P, 8, 8, secded7264_syndrome_w1, 72);
+    return 0;
+}
+
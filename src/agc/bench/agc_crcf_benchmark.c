@@ -57,3 +57,45 @@ void benchmark_agc_crcf(struct rusage *     _start,
     agc_crcf_destroy(q);
 }
 
+
+#define AGC_CRCF_BLOCK_BENCH_API(L)     \
+(   struct rusage *_start,              \
+    struct rusage *_finish,             \
+    unsigned long int *_num_iterations) \
+{ agc_crcf_block_bench(_start, _finish, _num_iterations, L); }
+
+// helper function to keep code base small
+void agc_crcf_block_bench(struct rusage *     _start,
+                          struct rusage *     _finish,
+                          unsigned long int * _num_iterations,
+                          unsigned int        _block_len)
+{
+    unsigned long int i;
+
+    // initialize AGC object; block length of 1 runs per-sample loop
+    agc_crcf q = agc_crcf_create();
+    agc_crcf_set_bandwidth(q,0.05f);
+    agc_crcf_set_block_len(q,_block_len);
+
+    // input/output buffers
+    unsigned int  buf_len = 1024;
+    float complex x[buf_len];
+    float complex y[buf_len];
+    for (i=0; i<buf_len; i++)
+        x[i] = 1e-3f*(randnf() + _Complex_I*randnf());
+
+    *_num_iterations *= 8;
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i+=buf_len)
+        agc_crcf_execute_block(q, x, buf_len, y);
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations = ((*_num_iterations + buf_len - 1) / buf_len) * buf_len;
+
+    // destroy object
+    agc_crcf_destroy(q);
+}
+
+void benchmark_agc_crcf_block_L1   AGC_CRCF_BLOCK_BENCH_API(1)
+void benchmark_agc_crcf_block_L16  AGC_CRCF_BLOCK_BENCH_API(16)
+void benchmark_agc_crcf_block_L64  AGC_CRCF_BLOCK_BENCH_API(64)
+void benchmark_agc_crcf_block_L256 AGC_CRCF_BLOCK_BENCH_API(256)
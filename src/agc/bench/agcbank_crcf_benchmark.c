@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <sys/resource.h>
+#include "liquid.h"
+
+#define AGCBANK_CRCF_BENCH_API(C,BANK)  \
+(   struct rusage *_start,              \
+    struct rusage *_finish,             \
+    unsigned long int *_num_iterations) \
+{ agcbank_crcf_bench(_start, _finish, _num_iterations, C, BANK); }
+
+// helper function to keep code base small
+//  _num_channels   : number of channels
+//  _bank           : use agc bank (1) or one agc_crcf object per channel (0)
+void agcbank_crcf_bench(struct rusage *     _start,
+                        struct rusage *     _finish,
+                        unsigned long int * _num_iterations,
+                        unsigned int        _num_channels,
+                        int                 _bank)
+{
+    unsigned long int i;
+    unsigned int j;
+
+    // one trial is one sample in one channel
+    *_num_iterations *= 8;
+    unsigned long int num_steps = *_num_iterations / _num_channels + 1;
+    *_num_iterations = num_steps * _num_channels;
+
+    agcbank_crcf q = agcbank_crcf_create(_num_channels);
+    agcbank_crcf_squelch_enable(q);
+    agcbank_crcf_squelch_set_threshold(q, -50);
+    agc_crcf agc[_num_channels];
+    for (j=0; j<_num_channels; j++) {
+        agc[j] = agc_crcf_create();
+        agc_crcf_squelch_enable(agc[j]);
+        agc_crcf_squelch_set_threshold(agc[j], -50);
+    }
+
+    // channelizer output vector
+    float complex x[_num_channels];
+    float complex y[_num_channels];
+    for (j=0; j<_num_channels; j++)
+        x[j] = 1e-3f*(randnf() + _Complex_I*randnf());
+
+    getrusage(RUSAGE_SELF, _start);
+    if (_bank) {
+        for (i=0; i<num_steps; i++)
+            agcbank_crcf_execute(q, x, y);
+    } else {
+        for (i=0; i<num_steps; i++) {
+            for (j=0; j<_num_channels; j++)
+                agc_crcf_execute(agc[j], x[j], &y[j]);
+        }
+    }
+    getrusage(RUSAGE_SELF, _finish);
+
+    agcbank_crcf_destroy(q);
+    for (j=0; j<_num_channels; j++)
+        agc_crcf_destroy(agc[j]);
+}
+
+void benchmark_agcbank_crcf_single_c64  AGCBANK_CRCF_BENCH_API(64,  0)
+void benchmark_agcbank_crcf_bank_c64    AGCBANK_CRCF_BENCH_API(64,  1)
+void benchmark_agcbank_crcf_single_c256 AGCBANK_CRCF_BENCH_API(256, 0)
+void benchmark_agcbank_crcf_bank_c256   AGCBANK_CRCF_BENCH_API(256, 1)
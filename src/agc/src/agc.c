@@ -34,7 +34,17 @@
 #define AGC_DEFAULT_BW   (1e-2f)
 
 // internal method definition
-void AGC(_squelch_update_mode)(AGC() _q);
+//  _q      :   agc object
+//  _n      :   number of samples elapsed since last update
+void AGC(_squelch_update_mode)(AGC()        _q,
+                               unsigned int _n);
+
+// execute gain control loop once on block of samples
+int AGC(_execute_block_once)(AGC()        _q,
+                             TC *         _x,
+                             unsigned int _n,
+                             T            _alpha,
+                             TC *         _y);
 
 // agc structure object
 struct AGC(_s) {
@@ -46,6 +56,10 @@ struct AGC(_s) {
     float bandwidth;// bandwidth-time constant
     T alpha;        // feed-back gain
 
+    // block processing
+    unsigned int block_len; // samples per loop update in execute_block()
+    T alpha_block;          // feed-back gain for full block
+
     // signal level estimate
     T y2_prime;     // filtered output signal energy estimate
 
@@ -69,7 +83,8 @@ AGC() AGC(_create)(void)
     // create object and initialize to default parameters
     AGC() _q = (AGC()) malloc(sizeof(struct AGC(_s)));
 
-    // initialize bandwidth
+    // initialize bandwidth (per-sample loop)
+    _q->block_len = 1;
     AGC(_set_bandwidth)(_q, AGC_DEFAULT_BW);
 
     // reset object
@@ -156,7 +171,7 @@ int AGC(_execute)(AGC() _q,
     _q->g = (_q->g > 1e6f) ? 1e6f : _q->g;
 
     // udpate squelch mode appropriately
-    AGC(_squelch_update_mode)(_q);
+    AGC(_squelch_update_mode)(_q, 1);
 
     // apply output scale
     *_y *= _q->scale;
@@ -176,13 +191,45 @@ int AGC(_execute_block)(AGC()        _q,
 {
     unsigned int i;
     int rc = LIQUID_OK;
-    for (i=0; i<_n; i++) {
-        rc |= AGC(_execute)(_q, _x[i], &_y[i]);
+    if (_q->block_len == 1) {
+        for (i=0; i<_n; i++)
+            rc |= AGC(_execute)(_q, _x[i], &_y[i]);
+        return rc;
     }
 
+    // run loop once for each full block
+    unsigned int L = _q->block_len;
+    for (i=0; i+L<=_n; i+=L)
+        rc |= AGC(_execute_block_once)(_q, _x+i, L, _q->alpha_block, _y+i);
+
+    // remaining samples as shorter block
+    if (i < _n) {
+        T alpha = 1.0f - powf(1.0f - _q->alpha, (float)(_n-i));
+        rc |= AGC(_execute_block_once)(_q, _x+i, _n-i, alpha, _y+i);
+    }
     return rc;
 }
 
+// set block length for execute_block()
+int AGC(_set_block_len)(AGC()        _q,
+                        unsigned int _block_len)
+{
+    if (_block_len == 0)
+        return liquid_error(LIQUID_EICONFIG,"agc_%s_set_block_len(), block length must be greater than zero", EXTENSION_FULL);
+
+    _q->block_len = _block_len;
+
+    // loop filter coefficient equivalent to _block_len per-sample updates
+    _q->alpha_block = 1.0f - powf(1.0f - _q->alpha, (float)_block_len);
+    return LIQUID_OK;
+}
+
+// get block length for execute_block()
+unsigned int AGC(_get_block_len)(AGC() _q)
+{
+    return _q->block_len;
+}
+
 // lock agc
 int AGC(_lock)(AGC() _q)
 {
@@ -227,8 +274,9 @@ int AGC(_set_bandwidth)(AGC() _q,
 
     // compute filter coefficient based on bandwidth
     _q->alpha = _q->bandwidth;
-    
-    return LIQUID_OK;
+
+    // update block coefficient
+    return AGC(_set_block_len)(_q, _q->block_len);
 }
 
 // get estimated signal level (linear)
@@ -405,7 +453,10 @@ int AGC(_squelch_get_status)(AGC() _q)
 //
 
 // update squelch mode appropriately
-void AGC(_squelch_update_mode)(AGC() _q)
+//  _q      :   agc object
+//  _n      :   number of samples elapsed since last update
+void AGC(_squelch_update_mode)(AGC()        _q,
+                               unsigned int _n)
 {
     //
     int threshold_exceeded = (AGC(_get_rssi)(_q) > _q->squelch_threshold);
@@ -426,7 +477,7 @@ void AGC(_squelch_update_mode)(AGC() _q)
         _q->squelch_timer = _q->squelch_timeout;
         break;
     case LIQUID_AGC_SQUELCH_SIGNALLO:
-        _q->squelch_timer--;
+        _q->squelch_timer = _q->squelch_timer > _n ? _q->squelch_timer - _n : 0;
         if (_q->squelch_timer == 0)
             _q->squelch_mode = LIQUID_AGC_SQUELCH_TIMEOUT;
         else if (threshold_exceeded)
@@ -444,3 +495,52 @@ void AGC(_squelch_update_mode)(AGC() _q)
     }
 }
 
+// execute gain control loop once on block of samples: the energy of
+// the block at the current gain drives a single loop update, and the
+// gain is ramped linearly from its current to its updated value
+//  _q      :   agc object
+//  _x      :   input data array, [size: _n x 1]
+//  _n      :   number of input, output samples
+//  _alpha  :   feed-back gain for block of _n samples
+//  _y      :   output data array, [size: _n x 1]
+int AGC(_execute_block_once)(AGC()        _q,
+                             TC *         _x,
+                             unsigned int _n,
+                             T            _alpha,
+                             TC *         _y)
+{
+    T g0 = _q->g;
+
+    // smooth energy estimate of output at current gain
+    T y2 = g0 * g0 * SUMSQ(_x, _n) / (float)_n;
+    _q->y2_prime = (1.0-_alpha)*_q->y2_prime + _alpha*y2;
+
+    // apply constant gain if locked (output scale not applied, as in
+    // per-sample execution)
+    if (_q->is_locked) {
+        VECTOR(_mulscalar)(_x, _n, g0, _y);
+        return LIQUID_OK;
+    }
+
+    // update gain according to output energy, clamp to 120 dB
+    if (_q->y2_prime > 1e-6f)
+        _q->g *= expf( -0.5f*_alpha*logf(_q->y2_prime) );
+    _q->g = (_q->g > 1e6f) ? 1e6f : _q->g;
+
+    AGC(_squelch_update_mode)(_q, _n);
+
+    // apply gain trajectory and output scale
+    T g  = g0 * _q->scale;
+    T dg = (_q->g - g0) * _q->scale / (float)_n;
+    unsigned int t = (_n>>2)<<2;
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        _y[i  ] = _x[i  ] * (g + (i+1)*dg);
+        _y[i+1] = _x[i+1] * (g + (i+2)*dg);
+        _y[i+2] = _x[i+2] * (g + (i+3)*dg);
+        _y[i+3] = _x[i+3] * (g + (i+4)*dg);
+    }
+    for ( ; i<_n; i++)
+        _y[i] = _x[i] * (g + (i+1)*dg);
+    return LIQUID_OK;
+}
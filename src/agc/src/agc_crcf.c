@@ -32,6 +32,8 @@
 
 // macros
 #define AGC(name)           LIQUID_CONCAT(agc_crcf,name)
+#define SUMSQ(x,n)          liquid_sumsqcf(x,n)
+#define VECTOR(name)        LIQUID_CONCAT(liquid_vectorcf,name)
 
 #define T                   float           // general
 #define TC                  float complex   // input/output
@@ -32,6 +32,8 @@
 
 // macros
 #define AGC(name)           LIQUID_CONCAT(agc_rrrf,name)
+#define SUMSQ(x,n)          liquid_sumsqf(x,n)
+#define VECTOR(name)        LIQUID_CONCAT(liquid_vectorf,name)
 
 #define T                   float           // general
 #define TC                  float           // input/output
@@ -0,0 +1,536 @@
+/*
+ * Copyright (c) 2007 - 2022 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Multi-channel automatic gain control and squelch
+//
+// The gain loop of each channel is identical to that of agc_crcf, but the
+// state of all channels is held in arrays so that one time step across all
+// channels (e.g. one channelizer output vector) is processed per call. On
+// x86 platforms with SSE2 the loop runs on four channels at a time.
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "liquid.internal.h"
+
+#if HAVE_SSE2 && HAVE_EMMINTRIN_H
+#include <emmintrin.h>  // SSE2
+#define AGCBANK_USE_SSE2 1
+#else
+#define AGCBANK_USE_SSE2 0
+#endif
+
+// default AGC loop bandwidth (same as agc_crcf)
+#define AGCBANK_DEFAULT_BW   (1e-2f)
+
+struct agcbank_crcf_s {
+    unsigned int num_channels;  // number of channels
+    unsigned int num_words;     // length of change bitmap
+
+    // per-channel state
+    float *         g;              // gain
+    float *         y2_prime;       // filtered output signal energy estimate
+    unsigned char * squelch_mode;   // squelch mode
+    unsigned int *  squelch_timer;  // squelch timer
+
+    // channels with squelch mode change in last call
+    uint32_t *      changed;
+    unsigned int    num_changed;
+
+    // loop parameters shared by all channels
+    float           bandwidth;  // bandwidth-time constant
+    float           alpha;      // feed-back gain
+    float           scale;      // output scale
+    int             is_locked;  // gain locked for all channels
+
+    // squelch parameters shared by all channels
+    int             squelch_enabled;
+    float           squelch_threshold;  // threshold [dB]
+    float           g_threshold;        // gain below which threshold is exceeded
+    unsigned int    squelch_timeout;    // timeout [samples]
+};
+
+// run gain loop on one time step of all channels
+int agcbank_crcf_update_gain(agcbank_crcf    _q,
+                             float complex * _x,
+                             float complex * _y);
+
+// run squelch state machine on one time step of all channels
+int agcbank_crcf_update_squelch(agcbank_crcf _q);
+
+// create agc bank
+//  _num_channels   : number of channels, _num_channels > 0
+agcbank_crcf agcbank_crcf_create(unsigned int _num_channels)
+{
+    if (_num_channels == 0)
+        return liquid_error_config("agcbank_crcf_create(), number of channels must be greater than zero");
+
+    agcbank_crcf q = (agcbank_crcf) malloc(sizeof(struct agcbank_crcf_s));
+    q->num_channels = _num_channels;
+    q->num_words    = (_num_channels + 31) / 32;
+
+    q->g             = (float*)         malloc(q->num_channels*sizeof(float));
+    q->y2_prime      = (float*)         malloc(q->num_channels*sizeof(float));
+    q->squelch_mode  = (unsigned char*) malloc(q->num_channels*sizeof(unsigned char));
+    q->squelch_timer = (unsigned int*)  malloc(q->num_channels*sizeof(unsigned int));
+    q->changed       = (uint32_t*)      malloc(q->num_words*sizeof(uint32_t));
+
+    // set default parameters
+    agcbank_crcf_set_bandwidth(q, AGCBANK_DEFAULT_BW);
+    q->scale = 1.0f;
+    q->squelch_enabled = 0;
+    agcbank_crcf_squelch_set_threshold(q, 0.0f);
+    agcbank_crcf_squelch_set_timeout  (q, 100);
+
+    // reset object
+    agcbank_crcf_reset(q);
+    return q;
+}
+
+// destroy agc bank, freeing all internal memory
+int agcbank_crcf_destroy(agcbank_crcf _q)
+{
+    free(_q->g);
+    free(_q->y2_prime);
+    free(_q->squelch_mode);
+    free(_q->squelch_timer);
+    free(_q->changed);
+    free(_q);
+    return LIQUID_OK;
+}
+
+// print agc bank object internals
+int agcbank_crcf_print(agcbank_crcf _q)
+{
+    printf("<agcbank_crcf, channels=%u, bw=%g, scale=%g, locked=%s, squelch=%s, simd=%s>\n",
+            _q->num_channels,
+            _q->bandwidth,
+            _q->scale,
+            _q->is_locked ? "yes" : "no",
+            _q->squelch_enabled ? "enabled" : "disabled",
+            AGCBANK_USE_SSE2 ? "sse2" : "none");
+    return LIQUID_OK;
+}
+
+// reset gain, energy estimates, and squelch state of all channels
+int agcbank_crcf_reset(agcbank_crcf _q)
+{
+    unsigned int i;
+    for (i=0; i<_q->num_channels; i++) {
+        _q->g[i]             = 1.0f;
+        _q->y2_prime[i]      = 1.0f;
+        _q->squelch_mode[i]  = _q->squelch_enabled ? LIQUID_AGC_SQUELCH_ENABLED :
+                                                     LIQUID_AGC_SQUELCH_DISABLED;
+        _q->squelch_timer[i] = 0;
+    }
+    memset(_q->changed, 0x00, _q->num_words*sizeof(uint32_t));
+    _q->num_changed = 0;
+    _q->is_locked   = 0;
+    return LIQUID_OK;
+}
+
+// get number of channels
+unsigned int agcbank_crcf_get_num_channels(agcbank_crcf _q)
+{
+    return _q->num_channels;
+}
+
+// get loop bandwidth
+float agcbank_crcf_get_bandwidth(agcbank_crcf _q)
+{
+    return _q->bandwidth;
+}
+
+// set loop bandwidth for all channels
+int agcbank_crcf_set_bandwidth(agcbank_crcf _q,
+                               float        _bt)
+{
+    if ( _bt < 0 )
+        return liquid_error(LIQUID_EICONFIG,"agcbank_crcf_set_bandwidth(), bandwidth must be positive");
+    if ( _bt > 1.0f )
+        return liquid_error(LIQUID_EICONFIG,"agcbank_crcf_set_bandwidth(), bandwidth must less than 1.0");
+
+    _q->bandwidth = _bt;
+    _q->alpha     = _bt;
+    return LIQUID_OK;
+}
+
+// get output scale
+float agcbank_crcf_get_scale(agcbank_crcf _q)
+{
+    return _q->scale;
+}
+
+// set output scale for all channels
+int agcbank_crcf_set_scale(agcbank_crcf _q,
+                           float        _scale)
+{
+    if ( _scale <= 0 )
+        return liquid_error(LIQUID_EICONFIG,"agcbank_crcf_set_scale(), scale must be greater than zero");
+
+    _q->scale = _scale;
+    return LIQUID_OK;
+}
+
+// lock gain of all channels
+int agcbank_crcf_lock(agcbank_crcf _q)
+{
+    _q->is_locked = 1;
+    return LIQUID_OK;
+}
+
+// unlock gain of all channels
+int agcbank_crcf_unlock(agcbank_crcf _q)
+{
+    _q->is_locked = 0;
+    return LIQUID_OK;
+}
+
+// get lock state
+int agcbank_crcf_is_locked(agcbank_crcf _q)
+{
+    return _q->is_locked;
+}
+
+// get gain of channel
+float agcbank_crcf_get_gain(agcbank_crcf _q,
+                            unsigned int _channel)
+{
+    if (_channel >= _q->num_channels) {
+        liquid_error(LIQUID_EIRANGE,"agcbank_crcf_get_gain(), channel (%u) out of range", _channel);
+        return 0.0f;
+    }
+    return _q->g[_channel];
+}
+
+// get estimated signal level of channel [dB]
+float agcbank_crcf_get_rssi(agcbank_crcf _q,
+                            unsigned int _channel)
+{
+    if (_channel >= _q->num_channels) {
+        liquid_error(LIQUID_EIRANGE,"agcbank_crcf_get_rssi(), channel (%u) out of range", _channel);
+        return 0.0f;
+    }
+    return -20*log10f(_q->g[_channel]);
+}
+
+// set estimated signal level of all channels [dB]
+int agcbank_crcf_set_rssi(agcbank_crcf _q,
+                          float        _rssi)
+{
+    // set internal gain appropriately, ensuring it is not arbitrarily low
+    float g = powf(10.0f, -_rssi/20.0f);
+    g = (g < 1e-16f) ? 1e-16f : g;
+
+    unsigned int i;
+    for (i=0; i<_q->num_channels; i++) {
+        _q->g[i]        = g;
+        _q->y2_prime[i] = 1.0f;
+    }
+    return LIQUID_OK;
+}
+
+// enable squelch on all channels
+int agcbank_crcf_squelch_enable(agcbank_crcf _q)
+{
+    _q->squelch_enabled = 1;
+    unsigned int i;
+    for (i=0; i<_q->num_channels; i++)
+        _q->squelch_mode[i] = LIQUID_AGC_SQUELCH_ENABLED;
+    return LIQUID_OK;
+}
+
+// disable squelch on all channels
+int agcbank_crcf_squelch_disable(agcbank_crcf _q)
+{
+    _q->squelch_enabled = 0;
+    unsigned int i;
+    for (i=0; i<_q->num_channels; i++)
+        _q->squelch_mode[i] = LIQUID_AGC_SQUELCH_DISABLED;
+    return LIQUID_OK;
+}
+
+// is squelch enabled?
+int agcbank_crcf_squelch_is_enabled(agcbank_crcf _q)
+{
+    return _q->squelch_enabled;
+}
+
+// set squelch threshold [dB]
+int agcbank_crcf_squelch_set_threshold(agcbank_crcf _q,
+                                       float        _threshold)
+{
+    _q->squelch_threshold = _threshold;
+
+    // rssi = -20 log10(g) > threshold  <=>  g < 10^(-threshold/20)
+    _q->g_threshold = powf(10.0f, -_threshold/20.0f);
+    return LIQUID_OK;
+}
+
+// get squelch threshold [dB]
+float agcbank_crcf_squelch_get_threshold(agcbank_crcf _q)
+{
+    return _q->squelch_threshold;
+}
+
+// set squelch timeout [samples]
+int agcbank_crcf_squelch_set_timeout(agcbank_crcf _q,
+                                     unsigned int _timeout)
+{
+    _q->squelch_timeout = _timeout;
+    return LIQUID_OK;
+}
+
+// get squelch timeout [samples]
+unsigned int agcbank_crcf_squelch_get_timeout(agcbank_crcf _q)
+{
+    return _q->squelch_timeout;
+}
+
+// get squelch mode of channel
+int agcbank_crcf_squelch_get_status(agcbank_crcf _q,
+                                    unsigned int _channel)
+{
+    if (_channel >= _q->num_channels)
+        return liquid_error(LIQUID_EIRANGE,"agcbank_crcf_squelch_get_status(), channel (%u) out of range", _channel);
+    return _q->squelch_mode[_channel];
+}
+
+// get bitmap of channels whose squelch mode changed during the last call
+// to execute() or execute_block(); channel i is bit (i%32) of word i/32
+const uint32_t * agcbank_crcf_get_changed(agcbank_crcf _q)
+{
+    return (const uint32_t *) _q->changed;
+}
+
+// get number of channels whose squelch mode changed during the last call
+unsigned int agcbank_crcf_get_num_changed(agcbank_crcf _q)
+{
+    return _q->num_changed;
+}
+
+// execute gain control on one time step of all channels
+//  _q      : agc bank object
+//  _x      : input sample for each channel [size: _num_channels x 1]
+//  _y      : output sample for each channel [size: _num_channels x 1]
+int agcbank_crcf_execute(agcbank_crcf    _q,
+                         float complex * _x,
+                         float complex * _y)
+{
+    return agcbank_crcf_execute_block(_q, _x, 1, _y);
+}
+
+// execute gain control on multiple time steps of all channels; the change
+// bitmap covers all time steps
+//  _q      : agc bank object
+//  _x      : input samples, channels for each time step contiguous [size: _n*_num_channels x 1]
+//  _n      : number of time steps
+//  _y      : output samples [size: _n*_num_channels x 1]
+int agcbank_crcf_execute_block(agcbank_crcf    _q,
+                               float complex * _x,
+                               unsigned int    _n,
+                               float complex * _y)
+{
+    memset(_q->changed, 0x00, _q->num_words*sizeof(uint32_t));
+    _q->num_changed = 0;
+
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        agcbank_crcf_update_gain(_q, _x + i*_q->num_channels, _y + i*_q->num_channels);
+        if (_q->squelch_enabled && !_q->is_locked)
+            agcbank_crcf_update_squelch(_q);
+    }
+    return LIQUID_OK;
+}
+
+//
+// internal methods
+//
+
+#if AGCBANK_USE_SSE2
+// approximate log2(x) for x > 0 (absolute error below 1e-6)
+static inline __m128 agcbank_log2_ps(__m128 _x)
+{
+    // split into exponent and mantissa in [1,2)
+    __m128i xi = _mm_castps_si128(_x);
+    __m128  e  = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(xi, 23), _mm_set1_epi32(127)));
+    __m128  m  = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(xi, _mm_set1_epi32(0x007fffff)),
+                                               _mm_set1_epi32(0x3f800000)));
+
+    // log2(m) = (2/ln 2) atanh(t), t = (m-1)/(m+1) in [0,1/3)
+    __m128 one = _mm_set1_ps(1.0f);
+    __m128 t   = _mm_div_ps(_mm_sub_ps(m, one), _mm_add_ps(m, one));
+    __m128 t2  = _mm_mul_ps(t, t);
+    __m128 p   = _mm_set1_ps(1.0f/9.0f);
+    p = _mm_add_ps(_mm_mul_ps(p, t2), _mm_set1_ps(1.0f/7.0f));
+    p = _mm_add_ps(_mm_mul_ps(p, t2), _mm_set1_ps(1.0f/5.0f));
+    p = _mm_add_ps(_mm_mul_ps(p, t2), _mm_set1_ps(1.0f/3.0f));
+    p = _mm_add_ps(_mm_mul_ps(p, t2), one);
+    p = _mm_mul_ps(_mm_mul_ps(p, t), _mm_set1_ps(2.0f/(float)M_LN2));
+    return _mm_add_ps(e, p);
+}
+
+// approximate 2^x for |x| < 126 (relative error below 2e-6)
+static inline __m128 agcbank_exp2_ps(__m128 _x)
+{
+    // split into integer n = floor(x) and fraction f in [0,1)
+    __m128i n = _mm_cvttps_epi32(_x);
+    __m128  nf = _mm_cvtepi32_ps(n);
+    __m128  neg = _mm_cmplt_ps(_x, nf);     // truncation rounded up
+    n  = _mm_add_epi32(n, _mm_castps_si128(neg));   // subtract 1 where set
+    nf = _mm_sub_ps(nf, _mm_and_ps(neg, _mm_set1_ps(1.0f)));
+    __m128 u = _mm_mul_ps(_mm_sub_ps(_x, nf), _mm_set1_ps((float)M_LN2));
+
+    // exp(u) for u in [0,ln 2), Taylor series to seventh order
+    __m128 p = _mm_set1_ps(1.0f/5040.0f);
+    p = _mm_add_ps(_mm_mul_ps(p, u), _mm_set1_ps(1.0f/720.0f));
+    p = _mm_add_ps(_mm_mul_ps(p, u), _mm_set1_ps(1.0f/120.0f));
+    p = _mm_add_ps(_mm_mul_ps(p, u), _mm_set1_ps(1.0f/24.0f));
+    p = _mm_add_ps(_mm_mul_ps(p, u), _mm_set1_ps(1.0f/6.0f));
+    p = _mm_add_ps(_mm_mul_ps(p, u), _mm_set1_ps(0.5f));
+    p = _mm_add_ps(_mm_mul_ps(p, u), _mm_set1_ps(1.0f));
+    p = _mm_add_ps(_mm_mul_ps(p, u), _mm_set1_ps(1.0f));
+
+    // scale by 2^n
+    __m128i s = _mm_slli_epi32(_mm_add_epi32(n, _mm_set1_epi32(127)), 23);
+    return _mm_mul_ps(p, _mm_castsi128_ps(s));
+}
+#endif
+
+// run gain loop on one time step of all channels
+int agcbank_crcf_update_gain(agcbank_crcf    _q,
+                             float complex * _x,
+                             float complex * _y)
+{
+    unsigned int i = 0;
+    float alpha = _q->alpha;
+    float scale = _q->is_locked ? 1.0f : _q->scale;
+
+#if AGCBANK_USE_SSE2
+    // process four channels at a time
+    unsigned int t = (_q->num_channels >> 2) << 2;
+    float * x = (float*) _x;
+    float * y = (float*) _y;
+    __m128 va  = _mm_set1_ps(alpha);
+    __m128 vb  = _mm_set1_ps(1.0f - alpha);
+    __m128 vs  = _mm_set1_ps(scale);
+    __m128 vk  = _mm_set1_ps(-0.5f*alpha);
+    __m128 one = _mm_set1_ps(1.0f);
+    for (i=0; i<t; i+=4) {
+        __m128 g  = _mm_loadu_ps(&_q->g[i]);
+        __m128 x0 = _mm_loadu_ps(&x[2*i  ]);    // channels i,   i+1
+        __m128 x1 = _mm_loadu_ps(&x[2*i+4]);    // channels i+2, i+3
+
+        // apply current gain, duplicated for real and imaginary parts
+        __m128 y0 = _mm_mul_ps(x0, _mm_unpacklo_ps(g, g));
+        __m128 y1 = _mm_mul_ps(x1, _mm_unpackhi_ps(g, g));
+
+        // output energy, smoothed
+        __m128 s0 = _mm_mul_ps(y0, y0);
+        __m128 s1 = _mm_mul_ps(y1, y1);
+        __m128 y2 = _mm_add_ps(_mm_shuffle_ps(s0, s1, _MM_SHUFFLE(2,0,2,0)),
+                               _mm_shuffle_ps(s0, s1, _MM_SHUFFLE(3,1,3,1)));
+        __m128 yp = _mm_add_ps(_mm_mul_ps(vb, _mm_loadu_ps(&_q->y2_prime[i])),
+                               _mm_mul_ps(va, y2));
+        _mm_storeu_ps(&_q->y2_prime[i], yp);
+
+        if (!_q->is_locked) {
+            // g *= y2'^(-alpha/2) where y2' > 1e-6, clamped to 120 dB
+            __m128 mask = _mm_cmpgt_ps(yp, _mm_set1_ps(1e-6f));
+            __m128 f = agcbank_exp2_ps(_mm_mul_ps(vk, agcbank_log2_ps(_mm_max_ps(yp, _mm_set1_ps(1e-6f)))));
+            f = _mm_or_ps(_mm_and_ps(mask, f), _mm_andnot_ps(mask, one));
+            g = _mm_min_ps(_mm_mul_ps(g, f), _mm_set1_ps(1e6f));
+            _mm_storeu_ps(&_q->g[i], g);
+        }
+
+        // apply output scale
+        _mm_storeu_ps(&y[2*i  ], _mm_mul_ps(y0, vs));
+        _mm_storeu_ps(&y[2*i+4], _mm_mul_ps(y1, vs));
+    }
+#endif
+
+    // remaining channels (all channels for portable version)
+    for ( ; i<_q->num_channels; i++) {
+        float complex v = _x[i] * _q->g[i];
+        float y2 = crealf(v)*crealf(v) + cimagf(v)*cimagf(v);
+        _q->y2_prime[i] = (1.0f-alpha)*_q->y2_prime[i] + alpha*y2;
+
+        if (!_q->is_locked) {
+            if (_q->y2_prime[i] > 1e-6f)
+                _q->g[i] *= expf( -0.5f*alpha*logf(_q->y2_prime[i]) );
+            _q->g[i] = (_q->g[i] > 1e6f) ? 1e6f : _q->g[i];
+        }
+        _y[i] = v * scale;
+    }
+    return LIQUID_OK;
+}
+
+// run squelch state machine on one time step of all channels, recording
+// channels whose mode changes
+int agcbank_crcf_update_squelch(agcbank_crcf _q)
+{
+    unsigned int i;
+    for (i=0; i<_q->num_channels; i++) {
+        int mode = _q->squelch_mode[i];
+        int threshold_exceeded = _q->g[i] < _q->g_threshold;
+
+        // same state machine as agc_crcf
+        int next = mode;
+        switch (mode) {
+        case LIQUID_AGC_SQUELCH_ENABLED:
+            next = threshold_exceeded ? LIQUID_AGC_SQUELCH_RISE : LIQUID_AGC_SQUELCH_ENABLED;
+            break;
+        case LIQUID_AGC_SQUELCH_RISE:
+        case LIQUID_AGC_SQUELCH_SIGNALHI:
+            next = threshold_exceeded ? LIQUID_AGC_SQUELCH_SIGNALHI : LIQUID_AGC_SQUELCH_FALL;
+            break;
+        case LIQUID_AGC_SQUELCH_FALL:
+            next = threshold_exceeded ? LIQUID_AGC_SQUELCH_SIGNALHI : LIQUID_AGC_SQUELCH_SIGNALLO;
+            _q->squelch_timer[i] = _q->squelch_timeout;
+            break;
+        case LIQUID_AGC_SQUELCH_SIGNALLO:
+            _q->squelch_timer[i]--;
+            if (_q->squelch_timer[i] == 0)
+                next = LIQUID_AGC_SQUELCH_TIMEOUT;
+            else if (threshold_exceeded)
+                next = LIQUID_AGC_SQUELCH_SIGNALHI;
+            break;
+        case LIQUID_AGC_SQUELCH_TIMEOUT:
+            next = LIQUID_AGC_SQUELCH_ENABLED;
+            break;
+        default:;
+        }
+
+        if (next != mode) {
+            _q->squelch_mode[i] = next;
+            if ( !(_q->changed[i>>5] & (1u << (i&31))) ) {
+                _q->changed[i>>5] |= 1u << (i&31);
+                _q->num_changed++;
+            }
+        }
+    }
+    return LIQUID_OK;
+}
@@ -284,6 +284,57 @@ void autotest_agc_crcf_lock()
     agc_crcf_destroy(q);
 }
 
+// compare block gain loop to per-sample loop across signal level steps:
+// settling time after each step and final gain should agree
+void testbench_agc_crcf_block(unsigned int _block_len, float _bt)
+{
+    unsigned int num_blocks = 9000 / _block_len;
+    float gamma[3] = {1e-2f, 1.0f, 1e-3f};  // signal level for each step
+
+    agc_crcf q0 = agc_crcf_create();
+    agc_crcf q1 = agc_crcf_create();
+    agc_crcf_set_bandwidth(q0, _bt);
+    agc_crcf_set_bandwidth(q1, _bt);
+    agc_crcf_set_block_len(q1, _block_len);
+    CONTEND_EQUALITY(agc_crcf_get_block_len(q1), _block_len);
+
+    unsigned int i, j;
+    float complex x[_block_len], y0[_block_len], y1[_block_len];
+    unsigned int settle0[3] = {0,0,0}, settle1[3] = {0,0,0};
+    for (i=0; i<num_blocks; i++) {
+        unsigned int step = 3*i / num_blocks;
+        for (j=0; j<_block_len; j++)
+            x[j] = gamma[step] * cexpf(_Complex_I*0.1f*(float)(i*_block_len+j));
+
+        agc_crcf_execute_block(q0, x, _block_len, y0);
+        agc_crcf_execute_block(q1, x, _block_len, y1);
+
+        // record last sample at which gain was outside 1 dB of target
+        float rssi = 20*log10f(gamma[step]);
+        unsigned int t = i*_block_len - step*num_blocks*_block_len/3;
+        if (fabsf(agc_crcf_get_rssi(q0) - rssi) > 1.0f) settle0[step] = t;
+        if (fabsf(agc_crcf_get_rssi(q1) - rssi) > 1.0f) settle1[step] = t;
+    }
+
+    for (i=0; i<3; i++) {
+        if (liquid_autotest_verbose)
+            printf("agc block, L=%u, bt=%g, step %u : settled after %5u (per-sample) / %5u (block)\n",
+                    _block_len, _bt, i, settle0[i], settle1[i]);
+        float tol = 2*_block_len + 0.2f*settle0[i];
+        CONTEND_DELTA((float)settle1[i], (float)settle0[i], tol);
+    }
+
+    // both settle to unit output level
+    CONTEND_DELTA(agc_crcf_get_rssi(q1), agc_crcf_get_rssi(q0), 0.1f);
+    CONTEND_DELTA(cabsf(y1[_block_len-1]), 1.0f, 0.01f);
+
+    agc_crcf_destroy(q0);
+    agc_crcf_destroy(q1);
+}
+void autotest_agc_crcf_block_L16()  { testbench_agc_crcf_block( 16, 0.01f ); }
+void autotest_agc_crcf_block_L64()  { testbench_agc_crcf_block( 64, 0.01f ); }
+void autotest_agc_crcf_block_L256() { testbench_agc_crcf_block(256, 0.005f); }
+
 // configuration
 void autotest_agc_crcf_invalid_config()
 {
@@ -316,6 +367,9 @@ void autotest_agc_crcf_invalid_config()
     // initialize gain on input array, but array has length 0
     CONTEND_INEQUALITY(LIQUID_OK, agc_crcf_init(q, NULL, 0))
 
+    // invalid block length
+    CONTEND_INEQUALITY(LIQUID_OK, agc_crcf_set_block_len(q, 0))
+
     // destroy object
     agc_crcf_destroy(q);
 }
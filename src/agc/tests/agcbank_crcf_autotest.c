@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2007 - 2021 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <string.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// compare agc bank against individual agc objects
+void testbench_agcbank_crcf(unsigned int _num_channels)
+{
+    unsigned int i, j;
+    unsigned int num_samples = 1200;
+    float tol = 1e-3f;
+
+    agcbank_crcf q = agcbank_crcf_create(_num_channels);
+    agcbank_crcf_set_bandwidth(q, 0.02f);
+    agcbank_crcf_set_scale    (q, 2.0f);
+    CONTEND_EQUALITY(agcbank_crcf_get_num_channels(q), _num_channels);
+
+    agc_crcf agc[_num_channels];
+    for (j=0; j<_num_channels; j++) {
+        agc[j] = agc_crcf_create();
+        agc_crcf_set_bandwidth(agc[j], 0.02f);
+        agc_crcf_set_scale    (agc[j], 2.0f);
+    }
+
+    float complex x[_num_channels], y[_num_channels], y_agc;
+    float max_error = 0.0f;
+    for (i=0; i<num_samples; i++) {
+        // different level and frequency in each channel
+        for (j=0; j<_num_channels; j++) {
+            float gamma = powf(10.0f, -3.0f + 4.0f*(float)j/(float)_num_channels);
+            x[j] = gamma * cexpf(_Complex_I*(0.1f + 0.03f*j)*i);
+        }
+
+        // lock for part of the run
+        if (i == 800) {
+            agcbank_crcf_lock(q);
+            for (j=0; j<_num_channels; j++) agc_crcf_lock(agc[j]);
+        }
+        agcbank_crcf_execute(q, x, y);
+
+        for (j=0; j<_num_channels; j++) {
+            agc_crcf_execute(agc[j], x[j], &y_agc);
+            float error = cabsf(y[j] - y_agc) / cabsf(y_agc);
+            max_error = error > max_error ? error : max_error;
+        }
+    }
+    if (liquid_autotest_verbose)
+        printf("agcbank, %u channels : max relative error = %.3e\n", _num_channels, max_error);
+    CONTEND_LESS_THAN(max_error, tol);
+
+    for (j=0; j<_num_channels; j++) {
+        CONTEND_DELTA(agcbank_crcf_get_rssi(q,j), agc_crcf_get_rssi(agc[j]), 0.01f);
+        agc_crcf_destroy(agc[j]);
+    }
+    agcbank_crcf_destroy(q);
+}
+void autotest_agcbank_crcf_01() { testbench_agcbank_crcf( 1); }
+void autotest_agcbank_crcf_13() { testbench_agcbank_crcf(13); }
+void autotest_agcbank_crcf_64() { testbench_agcbank_crcf(64); }
+
+// squelch on a few channels with bursts; check status and change bitmap
+void autotest_agcbank_crcf_squelch()
+{
+    unsigned int num_channels = 40;
+    unsigned int active[2] = {5, 38};   // channels with signal bursts
+    unsigned int i, j;
+
+    agcbank_crcf q = agcbank_crcf_create(num_channels);
+    agcbank_crcf_set_bandwidth(q, 0.25f);
+    agcbank_crcf_set_rssi(q, -60.0f);
+    CONTEND_FALSE(agcbank_crcf_squelch_is_enabled(q));
+    agcbank_crcf_squelch_enable(q);
+    agcbank_crcf_squelch_set_threshold(q, -50);
+    agcbank_crcf_squelch_set_timeout  (q, 100);
+    CONTEND_TRUE(agcbank_crcf_squelch_is_enabled(q));
+    CONTEND_EQUALITY(agcbank_crcf_squelch_get_threshold(q), -50);
+    CONTEND_EQUALITY(agcbank_crcf_squelch_get_timeout  (q), 100);
+
+    float complex x[num_channels];
+    int mode[num_channels];
+    for (j=0; j<num_channels; j++)
+        mode[j] = agcbank_crcf_squelch_get_status(q, j);
+
+    unsigned int num_changes[num_channels];
+    memset(num_changes, 0x00, sizeof(num_changes));
+    int bitmap_ok = 1;
+    for (i=0; i<2000; i++) {
+        // burst profile as in agc_crcf squelch test
+        float gamma = 1e-3f;
+        if      (i <  500) gamma = 1e-3f;
+        else if (i <  550) gamma = 1e-3f + (1e-2f - 1e-3f)*(0.5f - 0.5f*cosf(M_PI*(float)(i- 500)/50.0f));
+        else if (i < 1450) gamma = 1e-2f;
+        else if (i < 1500) gamma = 1e-3f + (1e-2f - 1e-3f)*(0.5f + 0.5f*cosf(M_PI*(float)(i-1450)/50.0f));
+        for (j=0; j<num_channels; j++) {
+            int is_active = (j == active[0] || j == active[1]);
+            x[j] = (is_active ? gamma : 1e-3f) * cexpf(_Complex_I*2*M_PI*0.0193f*i);
+        }
+        agcbank_crcf_execute(q, x, x);
+
+        // bitmap must match channels whose status changed
+        const uint32_t * changed = agcbank_crcf_get_changed(q);
+        unsigned int n = 0;
+        for (j=0; j<num_channels; j++) {
+            int m = agcbank_crcf_squelch_get_status(q, j);
+            int bit = (changed[j/32] >> (j%32)) & 1;
+            if (bit != (m != mode[j]))
+                bitmap_ok = 0;
+            num_changes[j] += bit;
+            n += bit;
+            mode[j] = m;
+        }
+        if (n != agcbank_crcf_get_num_changed(q))
+            bitmap_ok = 0;
+
+        // check status of active channel at same points as agc_crcf test
+        int status = agcbank_crcf_squelch_get_status(q, active[0]);
+        switch (i) {
+        case    0: CONTEND_EQUALITY(status, LIQUID_AGC_SQUELCH_ENABLED);  break;
+        case  500: CONTEND_EQUALITY(status, LIQUID_AGC_SQUELCH_ENABLED);  break;
+        case  600: CONTEND_EQUALITY(status, LIQUID_AGC_SQUELCH_SIGNALHI); break;
+        case 1400: CONTEND_EQUALITY(status, LIQUID_AGC_SQUELCH_SIGNALHI); break;
+        case 1500: CONTEND_EQUALITY(status, LIQUID_AGC_SQUELCH_SIGNALLO); break;
+        case 1600: CONTEND_EQUALITY(status, LIQUID_AGC_SQUELCH_ENABLED);  break;
+        case 1900: CONTEND_EQUALITY(status, LIQUID_AGC_SQUELCH_ENABLED);  break;
+        default:;
+        }
+    }
+    CONTEND_TRUE(bitmap_ok);
+
+    // only active channels changed state: enabled, rise, high, fall, low,
+    // timeout, enabled
+    for (j=0; j<num_channels; j++) {
+        int is_active = (j == active[0] || j == active[1]);
+        CONTEND_EQUALITY(num_changes[j], is_active ? 6 : 0);
+    }
+    agcbank_crcf_destroy(q);
+}
+
+// configuration
+void autotest_agcbank_crcf_config()
+{
+#if LIQUID_STRICT_EXIT
+    AUTOTEST_WARN("skipping agcbank config test with strict exit enabled\n");
+    return;
+#endif
+#if !LIQUID_SUPPRESS_ERROR_OUTPUT
+    fprintf(stderr,"warning: ignore potential errors here; checking for invalid configurations\n");
+#endif
+    CONTEND_ISNULL(agcbank_crcf_create(0));
+
+    agcbank_crcf q = agcbank_crcf_create(7);
+    CONTEND_EQUALITY(LIQUID_OK, agcbank_crcf_print(q));
+
+    CONTEND_INEQUALITY(LIQUID_OK, agcbank_crcf_set_bandwidth(q, -1));
+    CONTEND_INEQUALITY(LIQUID_OK, agcbank_crcf_set_bandwidth(q,  2));
+    CONTEND_EQUALITY  (LIQUID_OK, agcbank_crcf_set_bandwidth(q,  0.1f));
+    CONTEND_EQUALITY  (agcbank_crcf_get_bandwidth(q), 0.1f);
+    CONTEND_INEQUALITY(LIQUID_OK, agcbank_crcf_set_scale(q, 0));
+    CONTEND_EQUALITY  (LIQUID_OK, agcbank_crcf_set_scale(q, 0.5f));
+    CONTEND_EQUALITY  (agcbank_crcf_get_scale(q), 0.5f);
+    CONTEND_INEQUALITY(LIQUID_OK, agcbank_crcf_squelch_get_status(q, 7));
+    CONTEND_EQUALITY  (agcbank_crcf_get_gain(q, 7), 0.0f);
+
+    CONTEND_FALSE(agcbank_crcf_is_locked(q));
+    agcbank_crcf_lock(q);
+    CONTEND_TRUE (agcbank_crcf_is_locked(q));
+    agcbank_crcf_unlock(q);
+    CONTEND_FALSE(agcbank_crcf_is_locked(q));
+
+    agcbank_crcf_destroy(q);
+}
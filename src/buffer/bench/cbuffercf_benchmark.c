@@ -104,3 +104,138 @@ void benchmark_cbuffercf_n256    CBUFFERCF_BENCH_API( 256, 192, 191);
 void benchmark_cbuffercf_n512    CBUFFERCF_BENCH_API( 512, 384, 383);
 void benchmark_cbuffercf_n1024   CBUFFERCF_BENCH_API(1024, 768, 767);
 
+
+#if LIQUID_THREADS_ENABLED
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+
+// cross-thread streaming: producer thread(s) write blocks which the
+// calling thread consumes; rusage reports the time of all threads
+struct cbuffercf_xthread_s {
+    cbuffercf           cb;         // circular buffer (mutex-protected)
+    pthread_mutex_t *   mutex;      //
+    ringbuffercf        rb;         // lock-free ring buffer
+    int                 mpsc;       // multiple producers?
+    unsigned int        block;      // block size [elements]
+    unsigned long int   num;        // number of elements to produce
+};
+
+// back off when no progress is possible; sleeping rather than spinning
+// keeps the benchmark meaningful when threads share a single core
+static void cbuffercf_xthread_wait(void)
+{
+    struct timespec t = {0, 1000};
+    nanosleep(&t, NULL);
+}
+
+// producer thread
+static void * cbuffercf_xthread_producer(void * _arg)
+{
+    struct cbuffercf_xthread_s * p = (struct cbuffercf_xthread_s*) _arg;
+    float complex v[p->block];
+    memset(v, 0, sizeof(v));
+    unsigned long int num_written = 0;
+    unsigned int n;
+    while (num_written < p->num) {
+        if (p->cb != NULL) {
+            pthread_mutex_lock(p->mutex);
+            n = cbuffercf_space_available(p->cb) >= p->block ? p->block : 0;
+            if (n > 0)
+                cbuffercf_write(p->cb, v, n);
+            pthread_mutex_unlock(p->mutex);
+        } else if (p->mpsc) {
+            ringbuffercf_write(p->rb, v, p->block, &n);
+        } else {
+            float complex * w;
+            ringbuffercf_write_acquire(p->rb, p->block, &w, &n);
+            memset(w, 0, n*sizeof(float complex));
+            ringbuffercf_write_commit(p->rb, n);
+        }
+        num_written += n;
+        if (n == 0)
+            cbuffercf_xthread_wait();
+    }
+    return NULL;
+}
+
+// Helper function to keep code base small
+//  _type   :   0: cbuffercf with mutex, 1: ringbuffercf, 2: ringbuffercf (mpsc)
+//  _block  :   block size for writing and reading [elements]
+int cbuffercf_xthread_bench(struct rusage *     _start,
+                            struct rusage *     _finish,
+                            unsigned long int * _num_iterations,
+                            int                 _type,
+                            unsigned int        _block)
+{
+    unsigned int n = 8*_block;  // buffer size
+    unsigned int num_producers = _type == 2 ? 2 : 1;
+    *_num_iterations = (*_num_iterations * _block / num_producers) * num_producers;
+
+    pthread_mutex_t mutex;
+    pthread_mutex_init(&mutex, NULL);
+    struct cbuffercf_xthread_s p;
+    p.cb    = _type == 0 ? cbuffercf_create(n) : NULL;
+    p.mutex = &mutex;
+    p.rb    = _type == 0 ? NULL : (_type == 1 ? ringbuffercf_create(n) : ringbuffercf_create_mpsc(n));
+    p.mpsc  = _type == 2;
+    p.block = _block;
+    p.num   = *_num_iterations / num_producers;
+
+    float complex   v[_block];  // consumer output
+    float complex * r;          // read pointer
+    unsigned int    num_read;   // number of elements read
+    unsigned long int num_total_elements = 0;
+    pthread_t threads[2];
+    unsigned int i;
+
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<num_producers; i++)
+        pthread_create(&threads[i], NULL, cbuffercf_xthread_producer, &p);
+    while (num_total_elements < *_num_iterations) {
+        if (p.cb != NULL) {
+            pthread_mutex_lock(&mutex);
+            cbuffercf_read(p.cb, _block, &r, &num_read);
+            memmove(v, r, num_read*sizeof(float complex));
+            cbuffercf_release(p.cb, num_read);
+            pthread_mutex_unlock(&mutex);
+        } else {
+            ringbuffercf_read_acquire(p.rb, _block, &r, &num_read);
+            memmove(v, r, num_read*sizeof(float complex));
+            ringbuffercf_read_release(p.rb, num_read);
+        }
+        num_total_elements += num_read;
+        if (num_read == 0)
+            cbuffercf_xthread_wait();
+    }
+    for (i=0; i<num_producers; i++)
+        pthread_join(threads[i], NULL);
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations = num_total_elements;
+
+    // clean up allocated memory
+    if (p.cb != NULL) cbuffercf_destroy(p.cb);
+    if (p.rb != NULL) ringbuffercf_destroy(p.rb);
+    pthread_mutex_destroy(&mutex);
+    return LIQUID_OK;
+}
+#define CBUFFERCF_XTHREAD_BENCH_API(TYPE, BLOCK) \
+(   struct rusage *     _start,             \
+    struct rusage *     _finish,            \
+    unsigned long int * _num_iterations)    \
+{ cbuffercf_xthread_bench(_start, _finish, _num_iterations, TYPE, BLOCK); }
+#else
+#define CBUFFERCF_XTHREAD_BENCH_API(TYPE, BLOCK) \
+(   struct rusage *     _start,             \
+    struct rusage *     _finish,            \
+    unsigned long int * _num_iterations)    \
+{ getrusage(RUSAGE_SELF, _start); getrusage(RUSAGE_SELF, _finish); }
+#endif
+
+// cross-thread throughput
+void benchmark_cbuffercf_xthread_mutex_b64      CBUFFERCF_XTHREAD_BENCH_API(0,  64);
+void benchmark_cbuffercf_xthread_mutex_b1024    CBUFFERCF_XTHREAD_BENCH_API(0,1024);
+void benchmark_ringbuffercf_xthread_spsc_b64    CBUFFERCF_XTHREAD_BENCH_API(1,  64);
+void benchmark_ringbuffercf_xthread_spsc_b1024  CBUFFERCF_XTHREAD_BENCH_API(1,1024);
+void benchmark_ringbuffercf_xthread_mpsc_b64    CBUFFERCF_XTHREAD_BENCH_API(2,  64);
+void benchmark_ringbuffercf_xthread_mpsc_b1024  CBUFFERCF_XTHREAD_BENCH_API(2,1024);
@@ -65,4 +65,48 @@ void benchmark_windowcf_push_n32     WINDOW_PUSH_BENCH_API(32)
 void benchmark_windowcf_push_n64     WINDOW_PUSH_BENCH_API(64)
 void benchmark_windowcf_push_n128    WINDOW_PUSH_BENCH_API(128)
 void benchmark_windowcf_push_n256    WINDOW_PUSH_BENCH_API(256)
+void benchmark_windowcf_push_n512    WINDOW_PUSH_BENCH_API(512)
+void benchmark_windowcf_push_n1024   WINDOW_PUSH_BENCH_API(1024)
+void benchmark_windowcf_push_n4096   WINDOW_PUSH_BENCH_API(4096)
+void benchmark_windowcf_push_n16384  WINDOW_PUSH_BENCH_API(16384)
 
+#define WINDOW_WRITE_BENCH_API(N)       \
+(   struct rusage *_start,              \
+    struct rusage *_finish,             \
+    unsigned long int *_num_iterations) \
+{ window_write_bench(_start, _finish, _num_iterations, N); }
+
+// Helper function to keep code base small
+void window_write_bench(struct rusage *_start,
+                        struct rusage *_finish,
+                        unsigned long int *_num_iterations,
+                        unsigned int _n)
+{
+    // normalize number of iterations
+    *_num_iterations /= 2;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // initialize port
+    windowcf w = windowcf_create(_n);
+
+    // block of input samples
+    float complex v[64];
+    unsigned long int i;
+    for (i=0; i<64; i++)
+        v[i] = 1.0f;
+
+    // start trials:
+    //   write blocks to window
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++)
+        windowcf_write(w, v, 64);
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= 64;
+
+    windowcf_destroy(w);
+}
+
+// 
+void benchmark_windowcf_write_n256   WINDOW_WRITE_BENCH_API(256)
+void benchmark_windowcf_write_n1024  WINDOW_WRITE_BENCH_API(1024)
+void benchmark_windowcf_write_n16384 WINDOW_WRITE_BENCH_API(16384)
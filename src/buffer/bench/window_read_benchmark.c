@@ -66,4 +66,7 @@ void benchmark_windowcf_read_n32    WINDOW_READ_BENCH_API(32)
 void benchmark_windowcf_read_n64    WINDOW_READ_BENCH_API(64)
 void benchmark_windowcf_read_n128   WINDOW_READ_BENCH_API(128)
 void benchmark_windowcf_read_n256   WINDOW_READ_BENCH_API(256)
-
+void benchmark_windowcf_read_n512   WINDOW_READ_BENCH_API(512)
+void benchmark_windowcf_read_n1024  WINDOW_READ_BENCH_API(1024)
+void benchmark_windowcf_read_n4096  WINDOW_READ_BENCH_API(4096)
+void benchmark_windowcf_read_n16384 WINDOW_READ_BENCH_API(16384)
@@ -32,6 +32,7 @@
 #define BUFFER_TYPE_CFLOAT
 
 #define CBUFFER(name)   LIQUID_CONCAT(cbuffercf, name)
+#define RINGBUFFER(name) LIQUID_CONCAT(ringbuffercf, name)
 //#define SBUFFER(name)   LIQUID_CONCAT(sbuffercf, name)
 #define WDELAY(name)    LIQUID_CONCAT(wdelaycf,  name)
 #define WINDOW(name)    LIQUID_CONCAT(windowcf,  name)
@@ -43,6 +44,7 @@
     printf("  : %12.4e + %12.4e", crealf(V), cimagf(V));
 
 #include "cbuffer.c"
+#include "ringbuffer.c"
 //#include "sbuffer.c"
 #include "window.c"
 #include "wdelay.c"
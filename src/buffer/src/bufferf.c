@@ -32,6 +32,7 @@
 #define BUFFER_TYPE_FLOAT
 
 #define CBUFFER(name)   LIQUID_CONCAT(cbufferf, name)
+#define RINGBUFFER(name) LIQUID_CONCAT(ringbufferf, name)
 //#define SBUFFER(name)   LIQUID_CONCAT(sbufferf, name)
 #define WDELAY(name)    LIQUID_CONCAT(wdelayf,  name)
 #define WINDOW(name)    LIQUID_CONCAT(windowf,  name)
@@ -43,6 +44,7 @@
     printf("  : %12.4e", V);
 
 #include "cbuffer.c"
+#include "ringbuffer.c"
 //#include "sbuffer.c"
 #include "wdelay.c"
 #include "window.c"
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2007 - 2022 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// mirrored memory: one set of physical pages mapped at two consecutive
+// virtual address ranges, so that any span of up to the region length
+// starting in the first range is contiguous
+//
+
+// memfd_create() is a GNU extension
+#ifndef _GNU_SOURCE
+#  define _GNU_SOURCE
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "liquid.internal.h"
+
+#if defined HAVE_SYS_MMAN_H && defined HAVE_FCNTL_H && defined HAVE_UNISTD_H
+#  include <sys/mman.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#  define LIQUID_MIRROR_ENABLED 1
+#  if !defined MAP_ANONYMOUS && defined MAP_ANON
+#    define MAP_ANONYMOUS MAP_ANON
+#  endif
+#endif
+
+// get granularity of mirrored memory regions [bytes]
+size_t liquid_mirror_pagesize(void)
+{
+#if LIQUID_MIRROR_ENABLED
+    long n = sysconf(_SC_PAGESIZE);
+    return n > 0 ? (size_t)n : 4096;
+#else
+    return 4096;
+#endif
+}
+
+// allocate mirrored memory region; returns NULL if not supported
+//  _len    :   region length [bytes], multiple of liquid_mirror_pagesize()
+void * liquid_mirror_alloc(size_t _len)
+{
+#if LIQUID_MIRROR_ENABLED
+    if (_len == 0 || (_len % liquid_mirror_pagesize()) != 0)
+        return NULL;
+
+    // anonymous file backing the physical pages
+    int fd = -1;
+#  if defined HAVE_MEMFD_CREATE
+    fd = memfd_create("liquid-mirror", 0);
+#  endif
+    if (fd < 0) {
+        char path[] = "/tmp/liquid-mirror-XXXXXX";
+        fd = mkstemp(path);
+        if (fd < 0)
+            return NULL;
+        unlink(path);
+    }
+    if (ftruncate(fd, (off_t)_len) != 0) {
+        close(fd);
+        return NULL;
+    }
+
+    // reserve address range for both copies, then map file over each half
+    unsigned char * p = (unsigned char*) mmap(NULL, 2*_len, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) {
+        close(fd);
+        return NULL;
+    }
+    void * p0 = mmap(p,      _len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+    void * p1 = mmap(p+_len, _len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+    close(fd);
+    if (p0 != (void*)p || p1 != (void*)(p+_len)) {
+        munmap(p, 2*_len);
+        return NULL;
+    }
+    return (void*)p;
+#else
+    return NULL;
+#endif
+}
+
+// free mirrored memory region
+//  _p      :   region returned by liquid_mirror_alloc()
+//  _len    :   region length [bytes]
+int liquid_mirror_free(void * _p,
+                       size_t _len)
+{
+#if LIQUID_MIRROR_ENABLED
+    if (munmap(_p, 2*_len) != 0)
+        return liquid_error(LIQUID_EIMEM,"liquid_mirror_free(), could not unmap region");
+    return LIQUID_OK;
+#else
+    return liquid_error(LIQUID_EUMODE,"liquid_mirror_free(), mirrored memory not supported");
+#endif
+}
@@ -0,0 +1,338 @@
+/*
+ * Copyright (c) 2007 - 2022 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// lock-free ring buffer for streaming between threads
+//
+// One consumer and either one (SPSC) or many (MPSC) producers exchange
+// samples through free-running element counters, each in its own cache
+// line. The storage is mapped twice at consecutive addresses so that any
+// span of up to the capacity is contiguous in memory; where this is not
+// supported, committed spans are copied into the second half instead.
+//
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "liquid.internal.h"
+
+#ifndef LIQUID_RINGBUFFER_COUNTER_DEFINED
+#define LIQUID_RINGBUFFER_COUNTER_DEFINED
+#  if defined HAVE_STDATOMIC_H
+#    include <stdatomic.h>
+typedef atomic_uint ringbuffer_counter;
+#    define RINGBUFFER_LOAD(x)      atomic_load_explicit(&(x), memory_order_acquire)
+#    define RINGBUFFER_STORE(x,v)   atomic_store_explicit(&(x), (v), memory_order_release)
+#    define RINGBUFFER_CAS(x,e,v)   atomic_compare_exchange_weak_explicit(&(x), &(e), (v), \
+                                        memory_order_relaxed, memory_order_relaxed)
+#  else
+typedef volatile unsigned int ringbuffer_counter;
+static inline unsigned int ringbuffer_load(ringbuffer_counter * _x)
+    { unsigned int v = *_x; __sync_synchronize(); return v; }
+static inline void ringbuffer_store(ringbuffer_counter * _x, unsigned int _v)
+    { __sync_synchronize(); *_x = _v; }
+static inline int ringbuffer_cas(ringbuffer_counter * _x, unsigned int * _e, unsigned int _v)
+    { unsigned int p = __sync_val_compare_and_swap(_x, *_e, _v);
+      if (p == *_e) return 1; *_e = p; return 0; }
+#    define RINGBUFFER_LOAD(x)      ringbuffer_load(&(x))
+#    define RINGBUFFER_STORE(x,v)   ringbuffer_store(&(x), (v))
+#    define RINGBUFFER_CAS(x,e,v)   ringbuffer_cas(&(x), &(e), (v))
+#  endif
+
+// separation of indices written by different threads [bytes]
+#  define RINGBUFFER_CACHELINE      (64)
+#endif
+
+// create ring buffer (common)
+RINGBUFFER() RINGBUFFER(_create_internal)(unsigned int _n,
+                                          int          _mpsc);
+
+// copy committed span into other half of buffer (not mirrored)
+int RINGBUFFER(_mirror_copy)(RINGBUFFER() _q,
+                             unsigned int _index,
+                             unsigned int _n);
+
+struct RINGBUFFER(_s) {
+    T *             v;          // storage, two consecutive copies [2*capacity]
+    unsigned int    capacity;   // number of elements (power of two)
+    unsigned int    mask;       // capacity-1
+    size_t          num_bytes;  // length of one copy [bytes]
+    int             mirrored;   // storage mirrored by virtual memory?
+    int             mpsc;       // multiple producers?
+    unsigned char   pad0[RINGBUFFER_CACHELINE];
+
+    // consumer
+    ringbuffer_counter  head;           // elements released
+    unsigned int        read_acquired;  // elements acquired, not released
+    unsigned char       pad1[RINGBUFFER_CACHELINE];
+
+    // producer(s)
+    ringbuffer_counter  tail;           // elements committed
+    ringbuffer_counter  claim;          // elements reserved (multiple producers)
+    unsigned int        write_acquired; // elements acquired, not committed
+    unsigned char       pad2[RINGBUFFER_CACHELINE];
+};
+
+// create ring buffer for a single producer and single consumer
+//  _n      :   minimum capacity [elements], _n > 0
+RINGBUFFER() RINGBUFFER(_create)(unsigned int _n)
+{
+    return RINGBUFFER(_create_internal)(_n, 0);
+}
+
+// create ring buffer for multiple producers and a single consumer
+//  _n      :   minimum capacity [elements], _n > 0
+RINGBUFFER() RINGBUFFER(_create_mpsc)(unsigned int _n)
+{
+    return RINGBUFFER(_create_internal)(_n, 1);
+}
+
+// destroy ring buffer object, freeing all internal memory
+int RINGBUFFER(_destroy)(RINGBUFFER() _q)
+{
+    if (_q->mirrored)
+        liquid_mirror_free(_q->v, _q->num_bytes);
+    else
+        free(_q->v);
+    free(_q);
+    return LIQUID_OK;
+}
+
+// print ring buffer object properties
+int RINGBUFFER(_print)(RINGBUFFER() _q)
+{
+    printf("<ringbuffer%s, capacity=%u, size=%u, mirrored=%s, producers=%s>\n",
+            EXTENSION,
+            _q->capacity,
+            RINGBUFFER(_size)(_q),
+            _q->mirrored ? "yes" : "no",
+            _q->mpsc ? "multiple" : "single");
+    return LIQUID_OK;
+}
+
+// clear contents; not safe while other threads access the object
+int RINGBUFFER(_reset)(RINGBUFFER() _q)
+{
+    RINGBUFFER_STORE(_q->head,  0);
+    RINGBUFFER_STORE(_q->tail,  0);
+    RINGBUFFER_STORE(_q->claim, 0);
+    _q->read_acquired  = 0;
+    _q->write_acquired = 0;
+    return LIQUID_OK;
+}
+
+// get capacity [elements]
+unsigned int RINGBUFFER(_get_capacity)(RINGBUFFER() _q)
+{
+    return _q->capacity;
+}
+
+// is storage mirrored in virtual memory?
+int RINGBUFFER(_is_mirrored)(RINGBUFFER() _q)
+{
+    return _q->mirrored;
+}
+
+// get number of elements available to read
+unsigned int RINGBUFFER(_size)(RINGBUFFER() _q)
+{
+    return RINGBUFFER_LOAD(_q->tail) - RINGBUFFER_LOAD(_q->head);
+}
+
+// get number of elements available to write
+unsigned int RINGBUFFER(_space_available)(RINGBUFFER() _q)
+{
+    unsigned int w = _q->mpsc ? RINGBUFFER_LOAD(_q->claim) : RINGBUFFER_LOAD(_q->tail);
+    return _q->capacity - (w - RINGBUFFER_LOAD(_q->head));
+}
+
+// acquire contiguous space to write (single producer only)
+//  _q              :   ring buffer object
+//  _num_requested  :   number of elements requested
+//  _v              :   pointer to writable elements
+//  _num_available  :   number of elements referenced by _v
+int RINGBUFFER(_write_acquire)(RINGBUFFER()   _q,
+                               unsigned int   _num_requested,
+                               T **           _v,
+                               unsigned int * _num_available)
+{
+    if (_q->mpsc)
+        return liquid_error(LIQUID_EUMODE,"ringbuffer%s_write_acquire(), not supported with multiple producers; use write()", EXTENSION);
+
+    unsigned int tail  = RINGBUFFER_LOAD(_q->tail);
+    unsigned int space = _q->capacity - (tail - RINGBUFFER_LOAD(_q->head));
+    unsigned int n     = _num_requested < space ? _num_requested : space;
+
+    *_v             = _q->v + (tail & _q->mask);
+    *_num_available = n;
+    _q->write_acquired = n;
+    return LIQUID_OK;
+}
+
+// commit elements written after write_acquire(), making them available
+// to the consumer
+//  _q      :   ring buffer object
+//  _n      :   number of elements to commit, at most number acquired
+int RINGBUFFER(_write_commit)(RINGBUFFER() _q,
+                              unsigned int _n)
+{
+    if (_q->mpsc)
+        return liquid_error(LIQUID_EUMODE,"ringbuffer%s_write_commit(), not supported with multiple producers; use write()", EXTENSION);
+    if (_n > _q->write_acquired)
+        return liquid_error(LIQUID_EIRANGE,"ringbuffer%s_write_commit(), cannot commit more elements (%u) than were acquired (%u)", EXTENSION, _n, _q->write_acquired);
+
+    unsigned int tail = RINGBUFFER_LOAD(_q->tail);
+    if (!_q->mirrored)
+        RINGBUFFER(_mirror_copy)(_q, tail & _q->mask, _n);
+    RINGBUFFER_STORE(_q->tail, tail + _n);
+    _q->write_acquired -= _n;
+    return LIQUID_OK;
+}
+
+// copy elements into buffer, writing as many as there is space for
+//  _q          :   ring buffer object
+//  _v          :   input elements [size: _n x 1]
+//  _n          :   number of input elements
+//  _num_written:   number of elements written
+int RINGBUFFER(_write)(RINGBUFFER()   _q,
+                       T *            _v,
+                       unsigned int   _n,
+                       unsigned int * _num_written)
+{
+    unsigned int n;
+    if (!_q->mpsc) {
+        T * w;
+        RINGBUFFER(_write_acquire)(_q, _n, &w, &n);
+        memmove(w, _v, n*sizeof(T));
+        RINGBUFFER(_write_commit)(_q, n);
+        if (_num_written != NULL)
+            *_num_written = n;
+        return LIQUID_OK;
+    }
+
+    // reserve span among producers
+    unsigned int start = RINGBUFFER_LOAD(_q->claim);
+    do {
+        unsigned int space = _q->capacity - (start - RINGBUFFER_LOAD(_q->head));
+        n = _n < space ? _n : space;
+    } while (n > 0 && !RINGBUFFER_CAS(_q->claim, start, start + n));
+
+    if (n > 0) {
+        memmove(_q->v + (start & _q->mask), _v, n*sizeof(T));
+        if (!_q->mirrored)
+            RINGBUFFER(_mirror_copy)(_q, start & _q->mask, n);
+
+        // publish in order of reservation
+        while (RINGBUFFER_LOAD(_q->tail) != start)
+            ;
+        RINGBUFFER_STORE(_q->tail, start + n);
+    }
+    if (_num_written != NULL)
+        *_num_written = n;
+    return LIQUID_OK;
+}
+
+// acquire contiguous elements to read
+//  _q              :   ring buffer object
+//  _num_requested  :   number of elements requested
+//  _v              :   pointer to readable elements
+//  _num_read       :   number of elements referenced by _v
+int RINGBUFFER(_read_acquire)(RINGBUFFER()   _q,
+                              unsigned int   _num_requested,
+                              T **           _v,
+                              unsigned int * _num_read)
+{
+    unsigned int head = RINGBUFFER_LOAD(_q->head);
+    unsigned int size = RINGBUFFER_LOAD(_q->tail) - head;
+    unsigned int n    = _num_requested < size ? _num_requested : size;
+
+    *_v        = _q->v + (head & _q->mask);
+    *_num_read = n;
+    _q->read_acquired = n;
+    return LIQUID_OK;
+}
+
+// release elements after read_acquire(), returning the space to the
+// producers
+//  _q      :   ring buffer object
+//  _n      :   number of elements to release, at most number acquired
+int RINGBUFFER(_read_release)(RINGBUFFER() _q,
+                              unsigned int _n)
+{
+    if (_n > _q->read_acquired)
+        return liquid_error(LIQUID_EIRANGE,"ringbuffer%s_read_release(), cannot release more elements (%u) than were acquired (%u)", EXTENSION, _n, _q->read_acquired);
+
+    RINGBUFFER_STORE(_q->head, RINGBUFFER_LOAD(_q->head) + _n);
+    _q->read_acquired -= _n;
+    return LIQUID_OK;
+}
+
+//
+// internal methods
+//
+
+// create ring buffer (common)
+RINGBUFFER() RINGBUFFER(_create_internal)(unsigned int _n,
+                                          int          _mpsc)
+{
+    if (_n == 0)
+        return liquid_error_config("ringbuffer%s_create(), capacity must be greater than zero", EXTENSION);
+    if (_n > (1u<<30))
+        return liquid_error_config("ringbuffer%s_create(), capacity too large", EXTENSION);
+
+    RINGBUFFER() q = (RINGBUFFER()) malloc(sizeof(struct RINGBUFFER(_s)));
+    q->mpsc = _mpsc;
+
+    // round capacity to power of two spanning at least one page
+    unsigned int min_len = liquid_mirror_pagesize() / sizeof(T);
+    q->capacity = 1;
+    while (q->capacity < _n || q->capacity < min_len)
+        q->capacity <<= 1;
+    q->mask      = q->capacity - 1;
+    q->num_bytes = q->capacity * sizeof(T);
+
+    // map storage twice if possible
+    q->v = (T*) liquid_mirror_alloc(q->num_bytes);
+    q->mirrored = q->v != NULL;
+    if (!q->mirrored)
+        q->v = (T*) malloc(2*q->num_bytes);
+
+    RINGBUFFER(_reset)(q);
+    return q;
+}
+
+// copy committed span into other half of buffer (not mirrored)
+//  _q      :   ring buffer object
+//  _index  :   starting index of span in [0,capacity)
+//  _n      :   number of elements
+int RINGBUFFER(_mirror_copy)(RINGBUFFER() _q,
+                             unsigned int _index,
+                             unsigned int _n)
+{
+    unsigned int c  = _q->capacity;
+    unsigned int n0 = _index + _n <= c ? _n : c - _index;  // part in first half
+    memmove(_q->v + c + _index, _q->v + _index, n0*sizeof(T));
+    if (n0 < _n)
+        memmove(_q->v, _q->v + c, (_n - n0)*sizeof(T));
+    return LIQUID_OK;
+}
@@ -139,8 +139,9 @@ int WDELAY(_push)(WDELAY() _q,
     // increment index
     _q->read_index++;
 
-    // wrap around pointer
-    _q->read_index %= (_q->delay+1);
+    // wrap around pointer (compare rather than modulo; index advances by one)
+    if (_q->read_index > _q->delay)
+        _q->read_index = 0;
     return LIQUID_OK;
 }
 
@@ -23,6 +23,13 @@
 //
 // Windows, defined by macro
 //
+// Windows spanning at least one page of memory are kept in a circular
+// buffer whose pages are mapped twice at consecutive addresses (see
+// mirror.c), so the window is always contiguous and pushing never
+// copies. Smaller windows (or systems without support for mirrored
+// memory) use a linear buffer with excess memory which is periodically
+// shifted back to the start.
+//
 
 #include "liquid.internal.h"
 
@@ -39,6 +46,7 @@ struct WINDOW(_s) {
     unsigned int num_allocated; // number of elements allocated
                                 // in memory
     unsigned int read_index;
+    int          mirrored;      // memory mirrored (circular buffer)?
 };
 
 // create window buffer object of length _n
@@ -49,7 +57,7 @@ WINDOW() WINDOW(_create)(unsigned int _n)
         return liquid_error_config("error: window%s_create(), window size must be greater than zero", EXTENSION);
 
     // create initial object
-    WINDOW() q = (WINDOW()) malloc(sizeof(struct WINDOW(_s)));
+    WINDOW() q = (WINDOW()) liquid_malloc(sizeof(struct WINDOW(_s)));
 
     // set internal parameters
     q->len  = _n;                   // nominal window size
@@ -57,11 +65,28 @@ WINDOW() WINDOW(_create)(unsigned int _n)
     q->n    = 1<<(q->m);            // 2^m
     q->mask = q->n - 1;             // bit mask
 
-    // number of elements to allocate to memory
-    q->num_allocated = q->n + q->len - 1;
+    // try mirrored circular buffer of 2^m >= len elements, at least one page;
+    // the mapping cannot be drawn from an arena, so skip it while one is active
+    q->v = NULL;
+    if (!liquid_arena_is_active() && q->len*sizeof(T) >= liquid_mirror_pagesize()) {
+        while (q->n*sizeof(T) < liquid_mirror_pagesize())
+            q->n <<= 1;
+        if ((q->n>>1) >= q->len)
+            q->n >>= 1;
+        q->v = (T*) liquid_mirror_alloc(q->n*sizeof(T));
+    }
+    q->mirrored = q->v != NULL;
+    if (q->mirrored) {
+        q->mask          = q->n - 1;
+        q->num_allocated = q->n;
+    } else {
+        // number of elements to allocate to memory
+        q->n             = 1<<(q->m);
+        q->num_allocated = q->n + q->len - 1;
 
-    // allocte memory
-    q->v = (T*) malloc((q->num_allocated)*sizeof(T));
+        // allocte memory
+        q->v = (T*) liquid_malloc((q->num_allocated)*sizeof(T));
+    }
     q->read_index = 0;
 
     // reset window
@@ -111,10 +136,13 @@ WINDOW() WINDOW(_recreate)(WINDOW() _q, unsigned int _n)
 int WINDOW(_destroy)(WINDOW() _q)
 {
     // free internal memory array
-    free(_q->v);
+    if (_q->mirrored)
+        liquid_mirror_free(_q->v, _q->n*sizeof(T));
+    else
+        liquid_free(_q->v);
 
     // free main object memory
-    free(_q);
+    liquid_free(_q);
     return LIQUID_OK;
 }
 
@@ -206,6 +234,12 @@ int WINDOW(_push)(WINDOW() _q, T _v)
     // wrap around pointer
     _q->read_index &= _q->mask;
 
+    if (_q->mirrored) {
+        // append value to end of buffer; second copy is updated implicitly
+        _q->v[(_q->read_index + _q->len - 1) & _q->mask] = _v;
+        return LIQUID_OK;
+    }
+
     // if pointer wraps around, copy excess memory
     if (_q->read_index == 0)
         memmove(_q->v, _q->v + _q->n, (_q->len-1)*sizeof(T));
@@ -223,10 +257,22 @@ int WINDOW(_write)(WINDOW()     _q,
                    T *          _v,
                    unsigned int _n)
 {
-    // TODO make this more efficient
     unsigned int i;
-    for (i=0; i<_n; i++)
-        WINDOW(_push)(_q, _v[i]);
+    if (!_q->mirrored) {
+        // TODO make this more efficient
+        for (i=0; i<_n; i++)
+            WINDOW(_push)(_q, _v[i]);
+        return LIQUID_OK;
+    }
+
+    // copy contiguous blocks of up to 2^m elements behind end of window
+    while (_n > 0) {
+        unsigned int k = _n < _q->n ? _n : _q->n;
+        memmove(_q->v + ((_q->read_index + _q->len) & _q->mask), _v, k*sizeof(T));
+        _q->read_index = (_q->read_index + k) & _q->mask;
+        _v += k;
+        _n -= k;
+    }
     return LIQUID_OK;
 }
 
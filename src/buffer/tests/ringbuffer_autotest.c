@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2007 - 2021 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// lock-free ring buffer autotest
+//
+
+#include <stdlib.h>
+#include "autotest/autotest.h"
+#include "liquid.internal.h"
+
+#if LIQUID_THREADS_ENABLED
+#  include <pthread.h>
+#endif
+
+// write and read across the end of the buffer, checking that each span
+// is contiguous in memory
+void autotest_ringbufferf_wrap()
+{
+    ringbufferf q = ringbufferf_create(100);
+    unsigned int c = ringbufferf_get_capacity(q);
+    CONTEND_GREATER_THAN(c, 99);
+    CONTEND_EQUALITY(c & (c-1), 0);
+    CONTEND_EQUALITY(ringbufferf_size(q), 0);
+    CONTEND_EQUALITY(ringbufferf_space_available(q), c);
+
+    float * w, * r;
+    unsigned int n, i, k, j;
+    unsigned int num_write = 0;    // running count of values written
+    unsigned int num_read  = 0;    // running count of values read
+    for (k=0; k<8; k++) {
+        // fill to within a few elements of capacity through write_acquire()
+        ringbufferf_write_acquire(q, c - 3 - ringbufferf_size(q), &w, &n);
+        for (i=0; i<n; i++)
+            w[i] = (float)(num_write++);
+        ringbufferf_write_commit(q, n);
+
+        // request more than available
+        ringbufferf_write_acquire(q, c, &w, &n);
+        CONTEND_EQUALITY(n, 3);
+        ringbufferf_write_commit(q, 0);
+
+        // read a span that is not aligned to the capacity
+        j = (c/2) + 17*k;
+        ringbufferf_read_acquire(q, j, &r, &n);
+        CONTEND_EQUALITY(n, j);
+        for (i=0; i<n; i++)
+            CONTEND_EQUALITY(r[i], (float)(num_read + i));
+        ringbufferf_read_release(q, n);
+        num_read += n;
+        CONTEND_EQUALITY(ringbufferf_size(q), num_write - num_read);
+    }
+
+    // copy-in write is limited by space available
+    float v[4] = {-1,-2,-3,-4};
+    ringbufferf_write_acquire(q, c, &w, &n);
+    ringbufferf_write_commit(q, n - 2);
+    ringbufferf_write(q, v, 4, &n);
+    CONTEND_EQUALITY(n, 2);
+    CONTEND_EQUALITY(ringbufferf_space_available(q), 0);
+    ringbufferf_read_acquire(q, c, &r, &n);
+    CONTEND_EQUALITY(n, c);
+    CONTEND_EQUALITY(r[c-2], -1.0f);
+    CONTEND_EQUALITY(r[c-1], -2.0f);
+    ringbufferf_read_release(q, c);
+
+    // reset
+    ringbufferf_reset(q);
+    CONTEND_EQUALITY(ringbufferf_size(q), 0);
+    ringbufferf_destroy(q);
+}
+
+#if LIQUID_THREADS_ENABLED
+// number of values streamed by each producer
+#define RINGBUFFER_AUTOTEST_NUM_VALUES (200000)
+
+struct ringbuffer_autotest_producer {
+    ringbuffercf q;
+    unsigned int id;
+};
+
+// producer thread: stream counter values through write_acquire()
+static void * ringbuffer_autotest_spsc_producer(void * _arg)
+{
+    ringbuffercf q = ((struct ringbuffer_autotest_producer*)_arg)->q;
+    unsigned int num_written = 0;
+    while (num_written < RINGBUFFER_AUTOTEST_NUM_VALUES) {
+        float complex * w;
+        unsigned int i, n;
+        ringbuffercf_write_acquire(q, 1 + (num_written % 97), &w, &n);
+        for (i=0; i<n && num_written < RINGBUFFER_AUTOTEST_NUM_VALUES; i++)
+            w[i] = (float)num_written++;
+        ringbuffercf_write_commit(q, i);
+    }
+    return NULL;
+}
+
+// producer thread: stream tagged values through write()
+static void * ringbuffer_autotest_mpsc_producer(void * _arg)
+{
+    struct ringbuffer_autotest_producer * p = (struct ringbuffer_autotest_producer*)_arg;
+    float complex buf[31];
+    unsigned int num_written = 0;
+    while (num_written < RINGBUFFER_AUTOTEST_NUM_VALUES) {
+        unsigned int i, n = 1 + (num_written % 31);
+        for (i=0; i<n; i++)
+            buf[i] = p->id + _Complex_I*(float)(num_written + i);
+        if (num_written + n > RINGBUFFER_AUTOTEST_NUM_VALUES)
+            n = RINGBUFFER_AUTOTEST_NUM_VALUES - num_written;
+        ringbuffercf_write(p->q, buf, n, &n);
+        num_written += n;
+    }
+    return NULL;
+}
+
+// stream values from producer thread(s) to consumer, checking order
+void testbench_ringbuffercf_threaded(unsigned int _num_producers)
+{
+    ringbuffercf q = _num_producers == 1 ? ringbuffercf_create(1024) :
+                                           ringbuffercf_create_mpsc(1024);
+    struct ringbuffer_autotest_producer p[4];
+    pthread_t threads[4];
+    unsigned int next[4] = {0,0,0,0};   // next expected value per producer
+    unsigned int i;
+    for (i=0; i<_num_producers; i++) {
+        p[i].q  = q;
+        p[i].id = i;
+        pthread_create(&threads[i], NULL, _num_producers == 1 ?
+            ringbuffer_autotest_spsc_producer : ringbuffer_autotest_mpsc_producer, &p[i]);
+    }
+
+    // consume
+    unsigned int num_errors = 0;
+    unsigned int num_total  = _num_producers * RINGBUFFER_AUTOTEST_NUM_VALUES;
+    unsigned int num_read   = 0;
+    while (num_read < num_total) {
+        float complex * r;
+        unsigned int n;
+        ringbuffercf_read_acquire(q, 1 + (num_read % 113), &r, &n);
+        for (i=0; i<n; i++) {
+            unsigned int id  = _num_producers == 1 ? 0 : (unsigned int)crealf(r[i]);
+            unsigned int val = (unsigned int)(_num_producers == 1 ? crealf(r[i]) : cimagf(r[i]));
+            if (id >= _num_producers || val != next[id])
+                num_errors++;
+            else
+                next[id]++;
+        }
+        ringbuffercf_read_release(q, n);
+        num_read += n;
+    }
+    for (i=0; i<_num_producers; i++)
+        pthread_join(threads[i], NULL);
+
+    CONTEND_EQUALITY(num_errors, 0);
+    for (i=0; i<_num_producers; i++)
+        CONTEND_EQUALITY(next[i], RINGBUFFER_AUTOTEST_NUM_VALUES);
+    CONTEND_EQUALITY(ringbuffercf_size(q), 0);
+    ringbuffercf_destroy(q);
+}
+
+#endif
+
+void autotest_ringbuffercf_spsc()
+{
+#if LIQUID_THREADS_ENABLED
+    testbench_ringbuffercf_threaded(1);
+#else
+    AUTOTEST_WARN("skipping threaded ringbuffer test; threads not enabled\n");
+#endif
+}
+
+void autotest_ringbuffercf_mpsc()
+{
+#if LIQUID_THREADS_ENABLED
+    testbench_ringbuffercf_threaded(3);
+#else
+    AUTOTEST_WARN("skipping threaded ringbuffer test; threads not enabled\n");
+#endif
+}
+
+void autotest_ringbuffer_config()
+{
+#if LIQUID_STRICT_EXIT
+    AUTOTEST_WARN("skipping ringbuffer config test with strict exit enabled\n");
+    return;
+#endif
+#if !LIQUID_SUPPRESS_ERROR_OUTPUT
+    fprintf(stderr,"warning: ignore potential errors here; checking for invalid configurations\n");
+#endif
+    // check invalid configurations
+    CONTEND_ISNULL(ringbufferf_create(0));
+    CONTEND_ISNULL(ringbuffercf_create_mpsc(0));
+
+    // check that acquire/commit is rejected with multiple producers
+    ringbufferf q = ringbufferf_create_mpsc(16);
+    float * w;
+    unsigned int n;
+    CONTEND_INEQUALITY(LIQUID_OK, ringbufferf_write_acquire(q, 4, &w, &n));
+    CONTEND_INEQUALITY(LIQUID_OK, ringbufferf_write_commit(q, 4));
+    ringbufferf_destroy(q);
+
+    // check counts beyond those acquired
+    q = ringbufferf_create(16);
+    CONTEND_EQUALITY(LIQUID_OK, ringbufferf_print(q));
+    ringbufferf_write_acquire(q, 4, &w, &n);
+    CONTEND_INEQUALITY(LIQUID_OK, ringbufferf_write_commit(q, 5));
+    CONTEND_EQUALITY  (LIQUID_OK, ringbufferf_write_commit(q, 4));
+    ringbufferf_read_acquire(q, 2, &w, &n);
+    CONTEND_INEQUALITY(LIQUID_OK, ringbufferf_read_release(q, 3));
+    CONTEND_EQUALITY  (LIQUID_OK, ringbufferf_read_release(q, 2));
+    CONTEND_EQUALITY(ringbufferf_size(q), 2);
+    ringbufferf_destroy(q);
+}
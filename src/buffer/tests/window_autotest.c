@@ -152,3 +152,55 @@ void autotest_windowf()
     printf("done.\n");
 }
 
+
+// compare windows of various lengths against direct indexing of the
+// input sequence, covering both the linear and mirrored buffers
+void testbench_windowf_sequence(unsigned int _n)
+{
+    windowf w = windowf_create(_n);
+    float * r;
+    unsigned int i, j, num_pushed = 0;
+    unsigned int num_errors = 0;
+    float v[257];
+    for (i=0; i<12; i++) {
+        // alternate between single pushes and block writes of varying size
+        unsigned int k = (i*89 + 37) % 257;
+        for (j=0; j<k; j++)
+            v[j] = (float)(num_pushed + j + 1);
+        if (i % 2) {
+            windowf_write(w, v, k);
+        } else {
+            for (j=0; j<k; j++)
+                windowf_push(w, v[j]);
+        }
+        num_pushed += k;
+
+        // window holds most recent _n values, zero-padded at start
+        windowf_read(w, &r);
+        for (j=0; j<_n; j++) {
+            float expected = num_pushed + j + 1 >= _n ? (float)(num_pushed + j + 1 - _n) : 0.0f;
+            if (r[j] != expected)
+                num_errors++;
+        }
+    }
+    CONTEND_EQUALITY(num_errors, 0);
+
+    // push several windows worth of values
+    for (i=0; i<4*_n+3; i++)
+        windowf_push(w, (float)i);
+    windowf_read(w, &r);
+    CONTEND_EQUALITY(r[_n-1], (float)(4*_n+2));
+    CONTEND_EQUALITY(r[0],    (float)(3*_n+3));
+
+    windowf_reset(w);
+    windowf_read(w, &r);
+    CONTEND_EQUALITY(r[0],    0.0f);
+    CONTEND_EQUALITY(r[_n-1], 0.0f);
+    windowf_destroy(w);
+}
+
+void autotest_windowf_sequence_n7()    { testbench_windowf_sequence(   7); }
+void autotest_windowf_sequence_n64()   { testbench_windowf_sequence(  64); }
+void autotest_windowf_sequence_n1024() { testbench_windowf_sequence(1024); }
+void autotest_windowf_sequence_n1500() { testbench_windowf_sequence(1500); }
+void autotest_windowf_sequence_n4096() { testbench_windowf_sequence(4096); }
@@ -29,6 +29,9 @@
 #include <stdio.h>
 #include <math.h>
 
+// number of samples processed at a time in execute_block()
+#define CHANNEL_BLOCK_LEN   (64)
+
 // portable structured channel object
 struct CHANNEL(_s) {
     // additive white Gauss noise
@@ -55,6 +58,9 @@ struct CHANNEL(_s) {
     IIRFILT()       shadowing_filter;   // shadowing filter object
     float           shadowing_std;      // shadowing standard deviation
     float           shadowing_fd;       // shadowing Doppler frequency
+
+    // noise source
+    randgen         rng;                // counter-based random number generator
 };
 
 // create structured channel object with default parameters
@@ -76,6 +82,9 @@ CHANNEL() CHANNEL(_create)(void)
     q->channel_filter   = FIRFILT(_create)(q->h, q->h_len);
     q->shadowing_filter = NULL;
 
+    // seed noise generator from rand() so that srand() still controls it
+    q->rng = randgen_create(((unsigned long)rand() << 16) ^ (unsigned long)rand(), 0);
+
     // return object
     return q;
 }
@@ -88,6 +97,7 @@ int CHANNEL(_destroy)(CHANNEL() _q)
     FIRFILT(_destroy)(_q->channel_filter);
     if (_q->shadowing_filter != NULL)
         IIRFILT(_destroy)(_q->shadowing_filter);
+    randgen_destroy(_q->rng);
     free(_q->h);
 
     // free main object memory
@@ -106,6 +116,18 @@ int CHANNEL(_print)(CHANNEL() _q)
     return LIQUID_OK;
 }
 
+// set seed and stream of internal noise generator, resetting it to the
+// start of its stream
+//  _q      : channel object
+//  _seed   : generator seed
+//  _stream : generator stream identifier
+int CHANNEL(_set_seed)(CHANNEL()     _q,
+                       unsigned long _seed,
+                       unsigned long _stream)
+{
+    return randgen_set_seed(_q->rng, _seed, _stream);
+}
+
 // apply additive white Gausss noise impairment
 //  _q              : channel object
 //  _noise_floor_dB : noise floor power spectral density
@@ -247,8 +269,9 @@ int CHANNEL(_execute)(CHANNEL() _q,
     // apply shadowing if enabled
     if (_q->enabled_shadowing) {
         // TODO: use type-specific value other than float
-        float g = 0;
-        IIRFILT(_execute)(_q->shadowing_filter, randnf()*_q->shadowing_std, &g);
+        float v, g = 0;
+        randgen_normal(_q->rng, &v, 1);
+        IIRFILT(_execute)(_q->shadowing_filter, v*_q->shadowing_std, &g);
         g /= _q->shadowing_fd * 6.9f;
         g = powf(10.0f, g/20.0f);
         r *= g;
@@ -262,8 +285,10 @@ int CHANNEL(_execute)(CHANNEL() _q,
 
     // apply AWGN if enabled
     if (_q->enabled_awgn) {
-        r *= _q->gamma;
-        r += _q->nstd * ( randnf() + _Complex_I*randnf() ) * M_SQRT1_2;
+        float v[2];
+        randgen_normal(_q->rng, v, 2);
+        T nstd = _q->nstd * M_SQRT1_2;
+        r = r*_q->gamma + nstd*(v[0] + _Complex_I*v[1]);
     }
 
     // set output value
@@ -281,11 +306,51 @@ int CHANNEL(_execute_block)(CHANNEL()    _q,
                             unsigned int _n,
                             TO *         _y)
 {
-    // apply channel effects on each input sample
-    // TODO: apply in blocks
-    unsigned int i;
-    for (i=0; i<_n; i++)
-        CHANNEL(_execute)(_q, _x[i], &_y[i]);
+    // apply each channel effect to a block of samples at a time,
+    // generating all noise for the block at once; random values are
+    // drawn in the same order as CHANNEL(_execute) consumes them (one
+    // for shadowing then two for AWGN per sample) so that both methods
+    // produce identical output
+    float v[3*CHANNEL_BLOCK_LEN];
+    unsigned int d = (_q->enabled_shadowing ? 1 : 0) + (_q->enabled_awgn ? 2 : 0);
+    unsigned int i, j;
+    for (i=0; i<_n; i+=CHANNEL_BLOCK_LEN) {
+        unsigned int n = (_n - i) < CHANNEL_BLOCK_LEN ? (_n - i) : CHANNEL_BLOCK_LEN;
+        TO * r = _y + i;
+
+        // apply filter
+        if (_q->enabled_multipath)
+            FIRFILT(_execute_block)(_q->channel_filter, _x + i, n, r);
+        else if (r != _x + i)
+            memmove(r, _x + i, n*sizeof(TO));
+
+        // generate noise for block
+        if (d > 0)
+            randgen_normal(_q->rng, v, d*n);
+
+        // apply shadowing if enabled
+        if (_q->enabled_shadowing) {
+            for (j=0; j<n; j++) {
+                float g = 0;
+                IIRFILT(_execute)(_q->shadowing_filter, v[d*j]*_q->shadowing_std, &g);
+                g /= _q->shadowing_fd * 6.9f;
+                g = powf(10.0f, g/20.0f);
+                r[j] *= g;
+            }
+        }
+
+        // apply carrier if enabled
+        if (_q->enabled_carrier)
+            NCO(_mix_block_up)(_q->nco, r, r, n);
+
+        // apply AWGN if enabled
+        if (_q->enabled_awgn) {
+            float * w = v + d - 2;
+            T nstd = _q->nstd * M_SQRT1_2;
+            for (j=0; j<n; j++)
+                r[j] = r[j]*_q->gamma + nstd*(w[d*j] + _Complex_I*w[d*j+1]);
+        }
+    }
     return LIQUID_OK;
 }
 
@@ -40,6 +40,9 @@ struct TVMPCH(_s) {
     float std;
     float alpha;
     float beta;
+
+    // noise source for coefficient updates
+    randgen rng;
 };
 
 // create time-varying multi-path channel emulator object
@@ -75,6 +78,9 @@ TVMPCH() TVMPCH(_create)(unsigned int _n,
     // create window (internal buffer)
     q->w = WINDOW(_create)(q->h_len);
 
+    // seed noise generator from rand() so that srand() still controls it
+    q->rng = randgen_create(((unsigned long)rand() << 16) ^ (unsigned long)rand(), 0);
+
     // reset filter state (clear buffer)
     TVMPCH(_reset)(q);
 
@@ -86,6 +92,7 @@ TVMPCH() TVMPCH(_create)(unsigned int _n,
 int TVMPCH(_destroy)(TVMPCH() _q)
 {
     WINDOW(_destroy)(_q->w);
+    randgen_destroy(_q->rng);
     free(_q->h);
     free(_q);
     return LIQUID_OK;
@@ -98,6 +105,18 @@ int TVMPCH(_reset)(TVMPCH() _q)
     return LIQUID_OK;
 }
 
+// set seed and stream of internal noise generator, resetting it to the
+// start of its stream
+//  _q      : filter object
+//  _seed   : generator seed
+//  _stream : generator stream identifier
+int TVMPCH(_set_seed)(TVMPCH()      _q,
+                      unsigned long _seed,
+                      unsigned long _stream)
+{
+    return randgen_set_seed(_q->rng, _seed, _stream);
+}
+
 // print filter object internals (taps, buffer)
 int TVMPCH(_print)(TVMPCH() _q)
 {
@@ -118,10 +137,13 @@ int TVMPCH(_print)(TVMPCH() _q)
 int TVMPCH(_push)(TVMPCH() _q,
                   TI       _x)
 {
-    // update coefficients
+    // update coefficients, generating all noise at once
     unsigned int i;
+    float v[2*_q->h_len];
+    randgen_normal(_q->rng, v, 2*(_q->h_len-1));
+    float g = _q->beta * _q->std * M_SQRT1_2;
     for (i=0; i<_q->h_len-1; i++)
-        _q->h[i] = _q->alpha*_q->h[i] + _q->beta*(randnf() + _Complex_I*randnf()) * _q->std * M_SQRT1_2;
+        _q->h[i] = _q->alpha*_q->h[i] + g*(v[2*i] + _Complex_I*v[2*i+1]);
 
     // push sample into window buffer
     WINDOW(_push)(_q->w, _x);
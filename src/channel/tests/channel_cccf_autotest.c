@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2007 - 2022 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <complex.h>
+#include <math.h>
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// Helper function: run two identically configured channels on the same
+// random input, the first in block mode (in place) and the second one
+// sample at a time, and check that the outputs are identical
+void testbench_channel_cccf_block(int _awgn,
+                                  int _carrier,
+                                  int _multipath,
+                                  int _shadowing)
+{
+    unsigned int n = 1000;  // not a multiple of the internal block length
+    float complex * x  = (float complex*) malloc(n*sizeof(float complex));
+    float complex * y0 = (float complex*) malloc(n*sizeof(float complex));
+    float complex * y1 = (float complex*) malloc(n*sizeof(float complex));
+    unsigned int i, k;
+    for (i=0; i<n; i++)
+        x[i] = y0[i] = randnf() + _Complex_I*randnf();
+
+    channel_cccf q[2];
+    for (k=0; k<2; k++) {
+        q[k] = channel_cccf_create();
+        if (_awgn)      channel_cccf_add_awgn          (q[k], -20.0f, 10.0f);
+        if (_carrier)   channel_cccf_add_carrier_offset(q[k], 0.1f, 0.7f);
+        if (_multipath) channel_cccf_add_multipath     (q[k], NULL, 11);
+        if (_shadowing) channel_cccf_add_shadowing     (q[k], 1.0f, 0.1f);
+        channel_cccf_set_seed(q[k], 99, 2);
+    }
+
+    channel_cccf_execute_block(q[0], y0, n, y0);
+    for (i=0; i<n; i++)
+        channel_cccf_execute(q[1], x[i], &y1[i]);
+    CONTEND_SAME_DATA(y0, y1, n*sizeof(float complex));
+
+    channel_cccf_destroy(q[0]);
+    channel_cccf_destroy(q[1]);
+    free(x);
+    free(y0);
+    free(y1);
+}
+
+void autotest_channel_cccf_block_awgn()      { testbench_channel_cccf_block(1,0,0,0); }
+void autotest_channel_cccf_block_carrier()   { testbench_channel_cccf_block(0,1,0,0); }
+void autotest_channel_cccf_block_multipath() { testbench_channel_cccf_block(0,0,1,0); }
+void autotest_channel_cccf_block_shadowing() { testbench_channel_cccf_block(0,0,0,1); }
+void autotest_channel_cccf_block_all()       { testbench_channel_cccf_block(1,1,1,1); }
+
+// noise is reproducible with explicit seed and has expected power
+void autotest_channel_cccf_awgn()
+{
+    unsigned int n = 20000;
+    float complex * y0 = (float complex*) malloc(n*sizeof(float complex));
+    float complex * y1 = (float complex*) malloc(n*sizeof(float complex));
+    unsigned int i;
+    for (i=0; i<n; i++)
+        y0[i] = y1[i] = 0.0f;
+
+    channel_cccf q0 = channel_cccf_create();
+    channel_cccf q1 = channel_cccf_create();
+    channel_cccf_add_awgn(q0, -20.0f, 10.0f);
+    channel_cccf_add_awgn(q1, -20.0f, 10.0f);
+    channel_cccf_set_seed(q0, 99, 2);
+    channel_cccf_set_seed(q1, 99, 2);
+    channel_cccf_execute_block(q0, y0, n, y0);
+    channel_cccf_execute_block(q1, y1, n, y1);
+
+    // noise power is -20 dB
+    float e = 0.0f;
+    for (i=0; i<n; i++)
+        e += crealf(y0[i]*conjf(y0[i]));
+    CONTEND_DELTA(10*log10f(e/(float)n), -20.0f, 0.2f);
+    CONTEND_SAME_DATA(y0, y1, n*sizeof(float complex));
+
+    // different stream gives different noise
+    channel_cccf_set_seed(q1, 99, 3);
+    channel_cccf_execute_block(q1, y1, n, y1);
+    CONTEND_INEQUALITY(y0[0], y1[0]);
+
+    channel_cccf_destroy(q0);
+    channel_cccf_destroy(q1);
+    free(y0);
+    free(y1);
+}
+
+// carrier offset rotates input by expected frequency and phase
+void autotest_channel_cccf_carrier()
+{
+    unsigned int n = 200;
+    float dphi = 0.1f;
+    float phi  = 0.7f;
+    channel_cccf q = channel_cccf_create();
+    channel_cccf_add_carrier_offset(q, dphi, phi);
+
+    unsigned int i;
+    float complex y;
+    for (i=0; i<n; i++) {
+        channel_cccf_execute(q, 1.0f, &y);
+        float complex v = cexpf(_Complex_I*(phi + dphi*i));
+        CONTEND_DELTA(crealf(y), crealf(v), 1e-2f);
+        CONTEND_DELTA(cimagf(y), cimagf(v), 1e-2f);
+    }
+    channel_cccf_destroy(q);
+}
+
+// multipath channel impulse response matches filter coefficients
+void autotest_channel_cccf_multipath()
+{
+    unsigned int h_len = 7;
+    float complex h[h_len];
+    unsigned int i;
+    for (i=0; i<h_len; i++)
+        h[i] = cexpf(_Complex_I*0.3f*i) * (i==0 ? 1.0f : 0.1f*i);
+
+    channel_cccf q = channel_cccf_create();
+    channel_cccf_add_multipath(q, h, h_len);
+
+    // filter output is reversed relative to push order
+    float complex y;
+    for (i=0; i<2*h_len; i++) {
+        channel_cccf_execute(q, i==0 ? 1.0f : 0.0f, &y);
+        float complex v = i < h_len ? h[i] : 0.0f;
+        CONTEND_DELTA(crealf(y), crealf(v), 1e-6f);
+        CONTEND_DELTA(cimagf(y), cimagf(v), 1e-6f);
+    }
+    channel_cccf_destroy(q);
+}
+
+// shadowing applies a slowly-varying log-normal gain
+void autotest_channel_cccf_shadowing()
+{
+    unsigned int n = 20000;
+    float sigma = 1.0f;     // standard deviation of gain [dB]
+    float complex * y = (float complex*) malloc(n*sizeof(float complex));
+    unsigned int i;
+    for (i=0; i<n; i++)
+        y[i] = 1.0f;
+
+    channel_cccf q = channel_cccf_create();
+    channel_cccf_add_shadowing(q, sigma, 0.01f);
+    channel_cccf_set_seed(q, 99, 2);
+    channel_cccf_execute_block(q, y, n, y);
+
+    // gain only, no phase change; compute statistics of log gain and
+    // correlation between adjacent samples
+    float m = 0.0f, m2 = 0.0f, c = 0.0f, g_prev = 0.0f;
+    unsigned int num_errors = 0;
+    for (i=0; i<n; i++) {
+        num_errors += cimagf(y[i]) != 0.0f;
+        float g = 20*log10f(crealf(y[i]));
+        m  += g;
+        m2 += g*g;
+        c  += i > 0 ? g*g_prev : 0.0f;
+        g_prev = g;
+    }
+    m  /= (float)n;
+    m2  = m2/(float)n - m*m;
+    c   = (c/(float)(n-1) - m*m) / m2;
+    if (liquid_autotest_verbose)
+        printf("shadowing mean %.3f dB, std %.3f dB, correlation %.4f\n", m, sqrtf(m2), c);
+    CONTEND_EQUALITY    (num_errors, 0);
+    CONTEND_DELTA       (m, 0.0f, 0.5f*sigma);
+    CONTEND_DELTA       (sqrtf(m2), sigma, 0.5f*sigma);
+    CONTEND_GREATER_THAN(c, 0.95f);
+
+    channel_cccf_destroy(q);
+    free(y);
+}
@@ -100,11 +100,11 @@ int DOTPROD(_run4)(TC *         _h,
 DOTPROD() DOTPROD(_create)(TC *         _h,
                            unsigned int _n)
 {
-    DOTPROD() q = (DOTPROD()) malloc(sizeof(struct DOTPROD(_s)));
+    DOTPROD() q = (DOTPROD()) liquid_malloc(sizeof(struct DOTPROD(_s)));
     q->n = _n;
 
     // allocate memory for coefficients
-    q->h = (TC*) malloc((q->n)*sizeof(TC));
+    q->h = (TC*) liquid_malloc((q->n)*sizeof(TC));
 
     // move coefficients
     memmove(q->h, _h, (q->n)*sizeof(TC));
@@ -119,11 +119,11 @@ DOTPROD() DOTPROD(_create)(TC *         _h,
 DOTPROD() DOTPROD(_create_rev)(TC *         _h,
                                unsigned int _n)
 {
-    DOTPROD() q = (DOTPROD()) malloc(sizeof(struct DOTPROD(_s)));
+    DOTPROD() q = (DOTPROD()) liquid_malloc(sizeof(struct DOTPROD(_s)));
     q->n = _n;
 
     // allocate memory for coefficients
-    q->h = (TC*) malloc((q->n)*sizeof(TC));
+    q->h = (TC*) liquid_malloc((q->n)*sizeof(TC));
 
     // copy coefficients in time-reversed order
     unsigned int i;
@@ -148,7 +148,7 @@ DOTPROD() DOTPROD(_recreate)(DOTPROD()    _q,
         _q->n = _n;
 
         // re-allocate memory
-        _q->h = (TC*) realloc(_q->h, (_q->n)*sizeof(TC));
+        _q->h = (TC*) liquid_realloc(_q->h, (_q->n)*sizeof(TC));
     }
 
     // move new coefficients
@@ -172,7 +172,7 @@ DOTPROD() DOTPROD(_recreate_rev)(DOTPROD()    _q,
         _q->n = _n;
 
         // re-allocate memory
-        _q->h = (TC*) realloc(_q->h, (_q->n)*sizeof(TC));
+        _q->h = (TC*) liquid_realloc(_q->h, (_q->n)*sizeof(TC));
     }
 
     // copy coefficients in time-reversed order
@@ -187,8 +187,8 @@ DOTPROD() DOTPROD(_recreate_rev)(DOTPROD()    _q,
 // destroy dot product object
 int DOTPROD(_destroy)(DOTPROD() _q)
 {
-    free(_q->h);    // free coefficients memory
-    free(_q);       // free main object memory
+    liquid_free(_q->h);    // free coefficients memory
+    liquid_free(_q);       // free main object memory
     return LIQUID_OK;
 }
 
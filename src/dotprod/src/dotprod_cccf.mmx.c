@@ -117,12 +117,12 @@ dotprod_cccf dotprod_cccf_create_opt(float complex * _h,
                                      unsigned int    _n,
                                      int             _rev)
 {
-    dotprod_cccf q = (dotprod_cccf)malloc(sizeof(struct dotprod_cccf_s));
+    dotprod_cccf q = (dotprod_cccf)liquid_malloc(sizeof(struct dotprod_cccf_s));
     q->n = _n;
 
-    // allocate memory for coefficients, 16-byte aligned
-    q->hi = (float*) _mm_malloc( 2*q->n*sizeof(float), 16 );
-    q->hq = (float*) _mm_malloc( 2*q->n*sizeof(float), 16 );
+    // allocate memory for coefficients, 64-byte aligned
+    q->hi = (float*) liquid_malloc( 2*q->n*sizeof(float) );
+    q->hq = (float*) liquid_malloc( 2*q->n*sizeof(float) );
 
     // set coefficients, repeated
     //  hi = { crealf(_h[0]), crealf(_h[0]), ... crealf(_h[n-1]), crealf(_h[n-1])}
@@ -175,9 +175,9 @@ dotprod_cccf dotprod_cccf_recreate_rev(dotprod_cccf    _q,
 
 int dotprod_cccf_destroy(dotprod_cccf _q)
 {
-    _mm_free(_q->hi);
-    _mm_free(_q->hq);
-    free(_q);
+    liquid_free(_q->hi);
+    liquid_free(_q->hq);
+    liquid_free(_q);
     return LIQUID_OK;
 }
 
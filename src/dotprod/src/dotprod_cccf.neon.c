@@ -101,12 +101,12 @@ dotprod_cccf dotprod_cccf_create_opt(float complex * _h,
                                      unsigned int    _n,
                                      int             _rev)
 {
-    dotprod_cccf q = (dotprod_cccf)malloc(sizeof(struct dotprod_cccf_s));
+    dotprod_cccf q = (dotprod_cccf)liquid_malloc(sizeof(struct dotprod_cccf_s));
     q->n = _n;
 
     // allocate memory for coefficients
-    q->hi = (float*) malloc( 2*q->n*sizeof(float) );
-    q->hq = (float*) malloc( 2*q->n*sizeof(float) );
+    q->hi = (float*) liquid_malloc( 2*q->n*sizeof(float) );
+    q->hq = (float*) liquid_malloc( 2*q->n*sizeof(float) );
 
     // set coefficients, repeated
     //  hi = { crealf(_h[0]), crealf(_h[0]), ... crealf(_h[n-1]), crealf(_h[n-1])}
@@ -160,11 +160,11 @@ dotprod_cccf dotprod_cccf_recreate_rev(dotprod_cccf    _q,
 int dotprod_cccf_destroy(dotprod_cccf _q)
 {
     // free coefficients arrays
-    free(_q->hi);
-    free(_q->hq);
+    liquid_free(_q->hi);
+    liquid_free(_q->hq);
 
     // free main memory
-    free(_q);
+    liquid_free(_q);
     return LIQUID_OK;
 }
 
@@ -104,7 +104,7 @@ dotprod_crcf dotprod_crcf_create_opt(float *      _h,
                                      unsigned int _n,
                                      int          _rev)
 {
-    dotprod_crcf q = (dotprod_crcf)malloc(sizeof(struct dotprod_crcf_s));
+    dotprod_crcf q = (dotprod_crcf)liquid_malloc(sizeof(struct dotprod_crcf_s));
     q->n = _n;
 
     // create 4 copies of the input coefficients (one for each
@@ -118,7 +118,7 @@ dotprod_crcf dotprod_crcf_create_opt(float *      _h,
     //       of input.
     unsigned int i,j;
     for (i=0; i<4; i++) {
-        q->h[i] = calloc(1+(2*q->n+i-1)/4,2*sizeof(vector float));
+        q->h[i] = liquid_calloc(1+(2*q->n+i-1)/4,2*sizeof(vector float));
         for (j=0; j<q->n; j++) {
             q->h[i][2*j+0+i] = _h[_rev ? q->n-j-1 : j];
             q->h[i][2*j+1+i] = _h[_rev ? q->n-j-1 : j];
@@ -166,10 +166,10 @@ int dotprod_crcf_destroy(dotprod_crcf _q)
     // clean up coefficients arrays
     unsigned int i;
     for (i=0; i<4; i++)
-        free(_q->h[i]);
+        liquid_free(_q->h[i]);
 
     // free allocated object memory
-    free(_q);
+    liquid_free(_q);
     return LIQUID_OK;
 }
 
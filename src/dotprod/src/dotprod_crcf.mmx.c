@@ -98,11 +98,11 @@ dotprod_crcf dotprod_crcf_create_opt(float *      _h,
                                      unsigned int _n,
                                      int          _rev)
 {
-    dotprod_crcf q = (dotprod_crcf)malloc(sizeof(struct dotprod_crcf_s));
+    dotprod_crcf q = (dotprod_crcf)liquid_malloc(sizeof(struct dotprod_crcf_s));
     q->n = _n;
 
-    // allocate memory for coefficients, 16-byte aligned
-    q->h = (float*) _mm_malloc( 2*q->n*sizeof(float), 16 );
+    // allocate memory for coefficients, 64-byte aligned
+    q->h = (float*) liquid_malloc( 2*q->n*sizeof(float) );
 
     // set coefficients, repeated
     //  h = { _h[0], _h[0], _h[1], _h[1], ... _h[n-1], _h[n-1]}
@@ -152,8 +152,8 @@ dotprod_crcf dotprod_crcf_recreate_rev(dotprod_crcf _q,
 
 int dotprod_crcf_destroy(dotprod_crcf _q)
 {
-    _mm_free(_q->h);
-    free(_q);
+    liquid_free(_q->h);
+    liquid_free(_q);
     return LIQUID_OK;
 }
 
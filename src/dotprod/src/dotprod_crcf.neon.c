@@ -105,11 +105,11 @@ dotprod_crcf dotprod_crcf_create_opt(float *      _h,
                                      unsigned int _n,
                                      int          _rev)
 {
-    dotprod_crcf q = (dotprod_crcf)malloc(sizeof(struct dotprod_crcf_s));
+    dotprod_crcf q = (dotprod_crcf)liquid_malloc(sizeof(struct dotprod_crcf_s));
     q->n = _n;
 
     // allocate memory for coefficients (double size)
-    q->h = (float*) malloc( 2*q->n*sizeof(float) );
+    q->h = (float*) liquid_malloc( 2*q->n*sizeof(float) );
 
     // set coefficients, repeated
     //  h = { _h[0], _h[0], _h[1], _h[1], ... _h[n-1], _h[n-1]}
@@ -159,8 +159,8 @@ dotprod_crcf dotprod_crcf_recreate_rev(dotprod_crcf _q,
 
 int dotprod_crcf_destroy(dotprod_crcf _q)
 {
-    free(_q->h);
-    free(_q);
+    liquid_free(_q->h);
+    liquid_free(_q);
     return LIQUID_OK;
 }
 
@@ -104,7 +104,7 @@ dotprod_rrrf dotprod_rrrf_create_opt(float *      _h,
                                      unsigned int _n,
                                      int          _rev)
 {
-    dotprod_rrrf q = (dotprod_rrrf)malloc(sizeof(struct dotprod_rrrf_s));
+    dotprod_rrrf q = (dotprod_rrrf)liquid_malloc(sizeof(struct dotprod_rrrf_s));
     q->n = _n;
 
     // create 4 copies of the input coefficients (one for each
@@ -115,7 +115,7 @@ dotprod_rrrf dotprod_rrrf_create_opt(float *      _h,
     //  q->h[3] = {. . . 1,2,3,4,5,6}
     unsigned int i,j;
     for (i=0; i<4; i++) {
-        q->h[i] = calloc(1+(q->n+i-1)/4,sizeof(vector float));
+        q->h[i] = liquid_calloc(1+(q->n+i-1)/4,sizeof(vector float));
         for (j=0; j<q->n; j++)
             e->h[i][j+i] = _h[_rev ? q->n-j-1 : j];
     }
@@ -161,10 +161,10 @@ int dotprod_rrrf_destroy(dotprod_rrrf _q)
     // clean up coefficients arrays
     unsigned int i;
     for (i=0; i<4; i++)
-        free(_q->h[i]);
+        liquid_free(_q->h[i]);
 
     // free allocated object memory
-    free(_q);
+    liquid_free(_q);
     return LIQUID_OK;
 }
 
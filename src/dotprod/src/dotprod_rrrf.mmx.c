@@ -116,11 +116,11 @@ dotprod_rrrf dotprod_rrrf_create_opt(float *      _h,
                                      unsigned int _n,
                                      int          _rev)
 {
-    dotprod_rrrf q = (dotprod_rrrf)malloc(sizeof(struct dotprod_rrrf_s));
+    dotprod_rrrf q = (dotprod_rrrf)liquid_malloc(sizeof(struct dotprod_rrrf_s));
     q->n = _n;
 
-    // allocate memory for coefficients, 16-byte aligned
-    q->h = (float*) _mm_malloc( q->n*sizeof(float), 16);
+    // allocate memory for coefficients, 64-byte aligned
+    q->h = (float*) liquid_malloc( q->n*sizeof(float) );
 
     // set coefficients
     unsigned int i;
@@ -166,8 +166,8 @@ dotprod_rrrf dotprod_rrrf_recreate_rev(dotprod_rrrf _q,
 
 int dotprod_rrrf_destroy(dotprod_rrrf _q)
 {
-    _mm_free(_q->h);
-    free(_q);
+    liquid_free(_q->h);
+    liquid_free(_q);
     return LIQUID_OK;
 }
 
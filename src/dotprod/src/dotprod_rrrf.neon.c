@@ -168,11 +168,11 @@ dotprod_rrrf dotprod_rrrf_create_opt(float *      _h,
                                      unsigned int _n,
                                      int          _rev)
 {
-    dotprod_rrrf q = (dotprod_rrrf)malloc(sizeof(struct dotprod_rrrf_s));
+    dotprod_rrrf q = (dotprod_rrrf)liquid_malloc(sizeof(struct dotprod_rrrf_s));
     q->n = _n;
 
     // allocate memory for coefficients
-    q->h = (float*) malloc( q->n*sizeof(float) );
+    q->h = (float*) liquid_malloc( q->n*sizeof(float) );
 
     // copy coefficients
     unsigned int i;
@@ -218,8 +218,8 @@ dotprod_rrrf dotprod_rrrf_recreate_rev(dotprod_rrrf _q,
 // destroy dotprod object, freeing internal memory
 int dotprod_rrrf_destroy(dotprod_rrrf _q)
 {
-    free(_q->h);
-    free(_q);
+    liquid_free(_q->h);
+    liquid_free(_q);
     return LIQUID_OK;
 }
 
@@ -107,11 +107,11 @@ struct dotprod_rrrf_s {
 dotprod_rrrf dotprod_rrrf_create(float *      _h,
                                  unsigned int _n)
 {
-    dotprod_rrrf q = (dotprod_rrrf)malloc(sizeof(struct dotprod_rrrf_s));
+    dotprod_rrrf q = (dotprod_rrrf)liquid_malloc(sizeof(struct dotprod_rrrf_s));
     q->n = _n;
 
-    // allocate memory for coefficients, 16-byte aligned
-    q->h = (float*) _mm_malloc( q->n*sizeof(float), 16);
+    // allocate memory for coefficients, 64-byte aligned
+    q->h = (float*) liquid_malloc( q->n*sizeof(float) );
 
     // set coefficients
     memmove(q->h, _h, _n*sizeof(float));
@@ -133,8 +133,8 @@ dotprod_rrrf dotprod_rrrf_recreate(dotprod_rrrf _q,
 
 int dotprod_rrrf_destroy(dotprod_rrrf _q)
 {
-    _mm_free(_q->h);
-    free(_q);
+    liquid_free(_q->h);
+    liquid_free(_q);
     return LIQUID_OK;
 }
 
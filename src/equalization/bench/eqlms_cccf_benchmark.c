@@ -84,3 +84,54 @@ void benchmark_eqlms_cccf_n16   EQLMS_CCCF_TRAIN_BENCH_API(16)
 void benchmark_eqlms_cccf_n32   EQLMS_CCCF_TRAIN_BENCH_API(32)
 void benchmark_eqlms_cccf_n64   EQLMS_CCCF_TRAIN_BENCH_API(64)
 
+#define EQLMS_CCCF_BLOCK_BENCH_API(N,METHOD)    \
+(   struct rusage *_start,                      \
+    struct rusage *_finish,                     \
+    unsigned long int *_num_iterations)         \
+{ eqlms_cccf_block_bench(_start, _finish, _num_iterations, N, METHOD); }
+
+// Helper function to keep code base small
+void eqlms_cccf_block_bench(struct rusage *    _start,
+                            struct rusage *    _finish,
+                            unsigned long int *_num_iterations,
+                            unsigned int       _h_len,
+                            int                _method)
+{
+    // scale number of iterations appropriately
+    *_num_iterations *= 3200;
+    if (_method == LIQUID_EQLMS_TIME)
+        *_num_iterations /= (unsigned int) expf(5.63f + 0.767f*logf(_h_len));
+    else
+        *_num_iterations /= 200;
+    *_num_iterations = (*_num_iterations < 4) ? 4 : *_num_iterations;
+
+    eqlms_cccf eq = eqlms_cccf_create(NULL,_h_len);
+    eqlms_cccf_set_method(eq, _method);
+
+    // input/output buffers; channel is long enough to excite all taps
+    unsigned long int i;
+    unsigned int buf_len = 1024;
+    float complex x[buf_len], d[buf_len], y[buf_len];
+    for (i=0; i<buf_len; i++) {
+        x[i] = randnf() + _Complex_I*randnf();
+        d[i] = randnf() + _Complex_I*randnf();
+    }
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i+=buf_len)
+        eqlms_cccf_step_block(eq, x, d, buf_len, y);
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations = ((*_num_iterations + buf_len - 1) / buf_len) * buf_len;
+
+    eqlms_cccf_destroy(eq);
+}
+
+// time-domain vs. frequency-domain block training
+void benchmark_eqlms_cccf_block_time_n32     EQLMS_CCCF_BLOCK_BENCH_API(32,  LIQUID_EQLMS_TIME)
+void benchmark_eqlms_cccf_block_time_n128    EQLMS_CCCF_BLOCK_BENCH_API(128, LIQUID_EQLMS_TIME)
+void benchmark_eqlms_cccf_block_time_n512    EQLMS_CCCF_BLOCK_BENCH_API(512, LIQUID_EQLMS_TIME)
+void benchmark_eqlms_cccf_block_fdlms_n32    EQLMS_CCCF_BLOCK_BENCH_API(32,  LIQUID_EQLMS_FDLMS)
+void benchmark_eqlms_cccf_block_fdlms_n128   EQLMS_CCCF_BLOCK_BENCH_API(128, LIQUID_EQLMS_FDLMS)
+void benchmark_eqlms_cccf_block_fdlms_n512   EQLMS_CCCF_BLOCK_BENCH_API(512, LIQUID_EQLMS_FDLMS)
+void benchmark_eqlms_cccf_block_fdlmsu_n512  EQLMS_CCCF_BLOCK_BENCH_API(512, LIQUID_EQLMS_FDLMS_UNCONSTRAINED)
@@ -25,35 +25,38 @@
 #include <math.h>
 #include "liquid.h"
 
-#define EQRLS_CCCF_TRAIN_BENCH_API(N)   \
+#define EQRLS_CCCF_TRAIN_BENCH_API(N,METHOD) \
 (   struct rusage *_start,              \
     struct rusage *_finish,             \
     unsigned long int *_num_iterations) \
-{ eqrls_cccf_train_bench(_start, _finish, _num_iterations, N); }
+{ eqrls_cccf_train_bench(_start, _finish, _num_iterations, N, METHOD); }
 
 // Helper function to keep code base small
 void eqrls_cccf_train_bench(struct rusage *_start,
                             struct rusage *_finish,
                             unsigned long int *_num_iterations,
-                            unsigned int _h_len)
+                            unsigned int _h_len,
+                            int _method)
 {
     // scale number of iterations appropriately
-    // log(cycles/trial) ~ 5.57 + 2.74*log(_h_len)
+    // log(cycles/trial) ~ 4.0 + 2.0*log(_h_len)
     *_num_iterations *= 2400;
-    *_num_iterations /= (unsigned int) expf(5.57f + 2.64f*logf(_h_len));
+    *_num_iterations /= (unsigned int) expf(4.0f + 2.0f*logf(_h_len));
     *_num_iterations = (*_num_iterations < 4) ? 4 : *_num_iterations;
 
     eqrls_cccf eq = eqrls_cccf_create(NULL,_h_len);
+    eqrls_cccf_set_method(eq, _method);
     
     unsigned long int i;
 
-    // set up initial arrays to 'randomize' inputs/outputs
-    float complex y[11];
-    for (i=0; i<11; i++)
+    // set up initial arrays to 'randomize' inputs/outputs; input period
+    // must exceed filter length to keep correlation matrix full rank
+    float complex y[257];
+    for (i=0; i<257; i++)
         y[i] = randnf() + _Complex_I*randnf();
 
-    float complex d[13];
-    for (i=0; i<13; i++)
+    float complex d[263];
+    for (i=0; i<263; i++)
         d[i] = randnf() + _Complex_I*randnf();
 
     unsigned int iy=0;
@@ -69,18 +72,24 @@ void eqrls_cccf_train_bench(struct rusage *_start,
         eqrls_cccf_step(eq, d[id], z);  // step equalizer internals
 
         // update counters
-        iy = (iy+1)%11;
-        id = (id+1)%13;
+        iy = (iy+1)%257;
+        id = (id+1)%263;
     }
     getrusage(RUSAGE_SELF, _finish);
 
     eqrls_cccf_destroy(eq);
 }
 
-// 
-void benchmark_eqrls_cccf_n4    EQRLS_CCCF_TRAIN_BENCH_API(4)
-void benchmark_eqrls_cccf_n8    EQRLS_CCCF_TRAIN_BENCH_API(8)
-void benchmark_eqrls_cccf_n16   EQRLS_CCCF_TRAIN_BENCH_API(16)
-void benchmark_eqrls_cccf_n32   EQRLS_CCCF_TRAIN_BENCH_API(32)
-void benchmark_eqrls_cccf_n64   EQRLS_CCCF_TRAIN_BENCH_API(64)
+// conventional update
+void benchmark_eqrls_cccf_n4    EQRLS_CCCF_TRAIN_BENCH_API(4,  LIQUID_EQRLS_CONVENTIONAL)
+void benchmark_eqrls_cccf_n8    EQRLS_CCCF_TRAIN_BENCH_API(8,  LIQUID_EQRLS_CONVENTIONAL)
+void benchmark_eqrls_cccf_n16   EQRLS_CCCF_TRAIN_BENCH_API(16, LIQUID_EQRLS_CONVENTIONAL)
+void benchmark_eqrls_cccf_n32   EQRLS_CCCF_TRAIN_BENCH_API(32, LIQUID_EQRLS_CONVENTIONAL)
+void benchmark_eqrls_cccf_n64   EQRLS_CCCF_TRAIN_BENCH_API(64, LIQUID_EQRLS_CONVENTIONAL)
 
+// inverse QR-decomposition update
+void benchmark_eqrls_cccf_invqrd_n4     EQRLS_CCCF_TRAIN_BENCH_API(4,  LIQUID_EQRLS_INVQRD)
+void benchmark_eqrls_cccf_invqrd_n8     EQRLS_CCCF_TRAIN_BENCH_API(8,  LIQUID_EQRLS_INVQRD)
+void benchmark_eqrls_cccf_invqrd_n16    EQRLS_CCCF_TRAIN_BENCH_API(16, LIQUID_EQRLS_INVQRD)
+void benchmark_eqrls_cccf_invqrd_n32    EQRLS_CCCF_TRAIN_BENCH_API(32, LIQUID_EQRLS_INVQRD)
+void benchmark_eqrls_cccf_invqrd_n64    EQRLS_CCCF_TRAIN_BENCH_API(64, LIQUID_EQRLS_INVQRD)
@@ -45,11 +45,56 @@ struct EQLMS(_s) {
     WINDOW()     buffer;    // input buffer
     wdelayf      x2;        // buffer of |x|^2 values
     float        x2_sum;    // sum{ |x|^2 }
+
+    // frequency-domain block update (overlap-save, block size h_len)
+    int             method;     // coefficient update method
+    unsigned int    nfft;       // transform size, 2*h_len
+    float complex * fd_u;       // previous and current input block [nfft]
+    float complex * fd_U;       // transform of input blocks [nfft]
+    float complex * fd_W;       // transform of zero-padded coefficients [nfft]
+    float *         fd_P;       // smoothed input power in each bin [nfft]
+    float complex * fd_t;       // transform buffer (time) [nfft]
+    float complex * fd_f;       // transform buffer (frequency) [nfft]
+    fftplan         fft;        // forward transform, fd_t -> fd_f
+    fftplan         ifft;       // inverse transform, fd_f -> fd_t
+    T *             fd_y;       // filtered output for current block [h_len]
+    T *             fd_d;       // desired output for current block [h_len]
+    unsigned char * fd_m;       // error type for current block [h_len]
+    unsigned int    fd_len;     // number of samples in current block
+    unsigned int    fd_num;     // number of outputs computed for current block
+    unsigned int    fd_count;   // input count at end of last block call
+    int             fd_P_init;  // power estimate initialized?
+    int             W_stale;    // fd_W out of date (w0 modified)
+    int             w_stale;    // w0 out of date (fd_W modified)
 };
 
 // update sum{|x|^2}
 int EQLMS(_update_sumsq)(EQLMS() _q, T _x);
 
+// allocate memory for frequency-domain block update
+int EQLMS(_fd_alloc)(EQLMS() _q);
+
+// recompute coefficient transform from w0 if out of date
+int EQLMS(_fd_sync_W)(EQLMS() _q);
+
+// recompute w0 from coefficient transform if out of date
+int EQLMS(_fd_sync_w)(EQLMS() _q);
+
+// compute outputs [fd_num,fd_len) of the current block
+int EQLMS(_fd_filter)(EQLMS() _q, T * _y);
+
+// update coefficients from errors on completed block
+int EQLMS(_fd_update)(EQLMS() _q);
+
+// push, filter, and update on block of samples; blind (constant
+// modulus) with decimation _k when _d is NULL
+int EQLMS(_fd_run)(EQLMS()      _q,
+                   T *          _x,
+                   T *          _d,
+                   unsigned int _k,
+                   unsigned int _n,
+                   T *          _y);
+
 // create least mean-squares (LMS) equalizer object
 //  _h      :   initial coefficients [size: _h_len x 1], default if NULL
 //  _p      :   equalizer length (number of taps)
@@ -68,6 +113,11 @@ EQLMS() EQLMS(_create)(T *          _h,
     q->buffer = WINDOW(_create)(q->h_len);
     q->x2     = wdelayf_create(q->h_len);
 
+    // frequency-domain update buffers are allocated on demand
+    q->method = LIQUID_EQLMS_TIME;
+    q->nfft   = 2*q->h_len;
+    q->fd_u   = NULL;
+
     // copy coefficients (if not NULL)
     unsigned int i;
     if (_h == NULL) {
@@ -161,8 +211,12 @@ EQLMS() EQLMS(_recreate)(EQLMS()      _q,
 {
     // only destroy when length differs
     if (_q->h_len != _h_len) {
+        int method = _q->method;
         EQLMS(_destroy)(_q);
-        return EQLMS(_create)(_h,_h_len);
+        EQLMS() q = EQLMS(_create)(_h,_h_len);
+        if (method != LIQUID_EQLMS_TIME)
+            EQLMS(_set_method)(q, method);
+        return q;
     }
 
     // filter is same length; copy user-defined initial coefficients
@@ -184,6 +238,20 @@ int EQLMS(_destroy)(EQLMS() _q)
 
     WINDOW(_destroy)(_q->buffer);
     wdelayf_destroy(_q->x2);
+
+    if (_q->fd_u != NULL) {
+        free(_q->fd_u);
+        free(_q->fd_U);
+        free(_q->fd_W);
+        free(_q->fd_P);
+        free(_q->fd_t);
+        free(_q->fd_f);
+        free(_q->fd_y);
+        free(_q->fd_d);
+        free(_q->fd_m);
+        fft_destroy_plan(_q->fft);
+        fft_destroy_plan(_q->ifft);
+    }
     free(_q);
     return LIQUID_OK;
 }
@@ -203,13 +271,30 @@ int EQLMS(_reset)(EQLMS() _q)
 
     // reset squared magnitude sum
     _q->x2_sum = 0;
+
+    // reset block state
+    _q->W_stale = 1;
+    _q->w_stale = 0;
+    if (_q->fd_u != NULL) {
+        _q->fd_len    = 0;
+        _q->fd_num    = 0;
+        _q->fd_count  = 0;
+        _q->fd_P_init = 0;
+    }
     return LIQUID_OK;
 }
 
 // print eqlms object internals
 int EQLMS(_print)(EQLMS() _q)
 {
-    printf("<eqlms_%s, n=%u, mu=%.3f>\n", EXTENSION_FULL, _q->h_len, _q->mu);
+    EQLMS(_fd_sync_w)(_q);
+    const char * method = "time";
+    switch (_q->method) {
+    case LIQUID_EQLMS_FDLMS:               method = "fdlms";               break;
+    case LIQUID_EQLMS_FDLMS_UNCONSTRAINED: method = "fdlms-unconstrained"; break;
+    default:;
+    }
+    printf("<eqlms_%s, n=%u, mu=%.3f, method=\"%s\">\n", EXTENSION_FULL, _q->h_len, _q->mu, method);
     unsigned int i, j;
     for (i=0; i<_q->h_len; i++) {
         j = _q->h_len - i - 1;
@@ -243,9 +328,34 @@ unsigned int EQLMS(_get_length)(EQLMS() _q)
     return _q->h_len;
 }
 
+// set coefficient update method
+int EQLMS(_set_method)(EQLMS() _q,
+                       int     _method)
+{
+    if (_method != LIQUID_EQLMS_TIME &&
+        _method != LIQUID_EQLMS_FDLMS &&
+        _method != LIQUID_EQLMS_FDLMS_UNCONSTRAINED)
+    {
+        return liquid_error(LIQUID_EICONFIG,"eqlms_%s_set_method(), invalid method %d", EXTENSION_FULL, _method);
+    }
+
+    if (_method != LIQUID_EQLMS_TIME && _q->fd_u == NULL)
+        EQLMS(_fd_alloc)(_q);
+
+    _q->method = _method;
+    return EQLMS(_reset)(_q);
+}
+
+// get coefficient update method
+int EQLMS(_get_method)(EQLMS() _q)
+{
+    return _q->method;
+}
+
 // Get pointer to coefficients array
 const T * EQLMS(_get_coefficients)(EQLMS() _q)
 {
+    EQLMS(_fd_sync_w)(_q);
     return (const T*)(_q->w0);
 }
 
@@ -253,6 +363,7 @@ const T * EQLMS(_get_coefficients)(EQLMS() _q)
 void EQLMS(_get_weights)(EQLMS() _q, T * _w)
 {
     fprintf(stderr,"deprecation warning: eqlms_%s_get_weights() is old and will be removed in a future version\n", EXTENSION_FULL);
+    EQLMS(_fd_sync_w)(_q);
     // copy output weight vector
     unsigned int i;
     for (i=0; i<_q->h_len; i++)
@@ -262,6 +373,7 @@ void EQLMS(_get_weights)(EQLMS() _q, T * _w)
 // Copy internal coefficients to external buffer
 int EQLMS(_copy_coefficients)(EQLMS() _q, T * _w)
 {
+    EQLMS(_fd_sync_w)(_q);
     // copy output weight vector
     unsigned int i;
     for (i=0; i<_q->h_len; i++)
@@ -310,6 +422,10 @@ int EQLMS(_execute)(EQLMS() _q,
     T * r;      // read buffer
     WINDOW(_read)(_q->buffer, &r);
 
+    // coefficients may be held only in frequency domain
+    if (_q->w_stale)
+        EQLMS(_fd_sync_w)(_q);
+
     // compute conjugate vector dot product
     //DOTPROD(_run)(_q->w0, r, _q->h_len, &y);
     unsigned int i;
@@ -361,6 +477,9 @@ int EQLMS(_execute_block)(EQLMS()      _q,
     if (_k == 0)
         return liquid_error(LIQUID_EICONFIG,"eqlms_%s_execute_block(), down-sampling rate 'k' must be greater than 0", EXTENSION_FULL);
 
+    if (_q->method != LIQUID_EQLMS_TIME)
+        return EQLMS(_fd_run)(_q, _x, NULL, _k, _n, _y);
+
     unsigned int i;
     T d_hat;
     for (i=0; i<_n; i++) {
@@ -383,6 +502,30 @@ int EQLMS(_execute_block)(EQLMS()      _q,
     return LIQUID_OK;
 }
 
+// push, filter, and train on a block of samples
+//  _q      :   equalizer object
+//  _x      :   received samples [size: _n x 1]
+//  _d      :   desired output   [size: _n x 1]
+//  _n      :   number of samples
+//  _y      :   filtered output  [size: _n x 1]
+int EQLMS(_step_block)(EQLMS()      _q,
+                       T *          _x,
+                       T *          _d,
+                       unsigned int _n,
+                       T *          _y)
+{
+    if (_q->method != LIQUID_EQLMS_TIME)
+        return EQLMS(_fd_run)(_q, _x, _d, 1, _n, _y);
+
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        EQLMS(_push)(_q, _x[i]);
+        EQLMS(_execute)(_q, &_y[i]);
+        EQLMS(_step)(_q, _d[i], _y[i]);
+    }
+    return LIQUID_OK;
+}
+
 // step through one cycle of equalizer training
 //  _q      :   equalizer object
 //  _d      :   desired output
@@ -400,6 +543,7 @@ int EQLMS(_step)(EQLMS() _q,
     }
 
     unsigned int i;
+    EQLMS(_fd_sync_w)(_q);
 
     // compute error (a priori)
     T alpha = _d - _d_hat;
@@ -428,6 +572,7 @@ int EQLMS(_step)(EQLMS() _q,
 
     // copy old values
     memmove(_q->w0, _q->w1, _q->h_len*sizeof(T));
+    _q->W_stale = 1;
     return LIQUID_OK;
 }
 
@@ -472,6 +617,7 @@ int EQLMS(_train)(EQLMS()      _q,
     // copy initial weights into buffer
     for (i=0; i<p; i++)
         _q->w0[i] = _w[p - i - 1];
+    _q->W_stale = 1;
 
     T d_hat;
     for (i=0; i<_n; i++) {
@@ -515,3 +661,212 @@ int EQLMS(_update_sumsq)(EQLMS() _q, T _x)
     return LIQUID_OK;
 }
 
+// allocate memory for frequency-domain block update
+int EQLMS(_fd_alloc)(EQLMS() _q)
+{
+    unsigned int n = _q->nfft;
+    _q->fd_u = (float complex*) calloc(n, sizeof(float complex));
+    _q->fd_U = (float complex*) calloc(n, sizeof(float complex));
+    _q->fd_W = (float complex*) calloc(n, sizeof(float complex));
+    _q->fd_P = (float*)         calloc(n, sizeof(float));
+    _q->fd_t = (float complex*) calloc(n, sizeof(float complex));
+    _q->fd_f = (float complex*) calloc(n, sizeof(float complex));
+    _q->fd_y = (T*)             calloc(_q->h_len, sizeof(T));
+    _q->fd_d = (T*)             calloc(_q->h_len, sizeof(T));
+    _q->fd_m = (unsigned char*) calloc(_q->h_len, sizeof(unsigned char));
+    _q->fft  = fft_create_plan(n, _q->fd_t, _q->fd_f, LIQUID_FFT_FORWARD,  0);
+    _q->ifft = fft_create_plan(n, _q->fd_f, _q->fd_t, LIQUID_FFT_BACKWARD, 0);
+    return LIQUID_OK;
+}
+
+// recompute coefficient transform from w0 if out of date
+int EQLMS(_fd_sync_W)(EQLMS() _q)
+{
+    if (!_q->W_stale || _q->fd_u == NULL)
+        return LIQUID_OK;
+
+    // W = fft([h; 0]), h[k] = conj(w0[h_len-k-1])
+    unsigned int i;
+    for (i=0; i<_q->h_len; i++) {
+        _q->fd_t[i]           = conjf(_q->w0[_q->h_len-i-1]);
+        _q->fd_t[_q->h_len+i] = 0.0f;
+    }
+    fft_execute(_q->fft);
+    memmove(_q->fd_W, _q->fd_f, _q->nfft*sizeof(float complex));
+    _q->W_stale = 0;
+    return LIQUID_OK;
+}
+
+// recompute w0 from coefficient transform if out of date
+int EQLMS(_fd_sync_w)(EQLMS() _q)
+{
+    if (!_q->w_stale)
+        return LIQUID_OK;
+
+    // truncate circular response of unconstrained filter to h_len taps
+    memmove(_q->fd_f, _q->fd_W, _q->nfft*sizeof(float complex));
+    fft_execute(_q->ifft);
+    unsigned int i;
+    float g = 1.0f / (float)(_q->nfft);
+    for (i=0; i<_q->h_len; i++)
+        _q->w0[_q->h_len-i-1] = conjf(_q->fd_t[i]) * g;
+    _q->w_stale = 0;
+    return LIQUID_OK;
+}
+
+// compute outputs [fd_num,fd_len) of the current block, storing the
+// input transform when the block is complete
+//  _q      :   equalizer object
+//  _y      :   output array, starting at block position fd_num
+int EQLMS(_fd_filter)(EQLMS() _q,
+                      T *     _y)
+{
+    EQLMS(_fd_sync_W)(_q);
+
+    // overlap-save: samples of current block not yet received are zero
+    memmove(_q->fd_t, _q->fd_u, _q->nfft*sizeof(float complex));
+    fft_execute(_q->fft);
+    if (_q->fd_len == _q->h_len)
+        memmove(_q->fd_U, _q->fd_f, _q->nfft*sizeof(float complex));
+
+    unsigned int i;
+    for (i=0; i<_q->nfft; i++)
+        _q->fd_f[i] *= _q->fd_W[i];
+    fft_execute(_q->ifft);
+
+    // last h_len samples of circular convolution are linear
+    float g = 1.0f / (float)(_q->nfft);
+    for (i=_q->fd_num; i<_q->fd_len; i++) {
+        _q->fd_y[i] = _q->fd_t[_q->h_len+i] * g;
+        _y[i - _q->fd_num] = _q->fd_y[i];
+    }
+    _q->fd_num = _q->fd_len;
+    return LIQUID_OK;
+}
+
+// update coefficients from errors on completed block
+int EQLMS(_fd_update)(EQLMS() _q)
+{
+    unsigned int n = _q->h_len;
+    unsigned int i;
+
+    // error (a priori), zero-padded at front: e = [0; d - y]
+    unsigned int num_errors = 0;
+    for (i=0; i<n; i++) {
+        T e = 0;
+        T y = _q->fd_y[i];
+        if (_q->fd_m[i] == 1) {
+            e = _q->fd_d[i] - y;
+        } else if (_q->fd_m[i] == 2) {
+            // constant modulus, as in EQLMS(_step_blind)
+#if T_COMPLEX
+            e = y / cabsf(y) - y;
+#else
+            e = (y > 0 ? 1 : -1) - y;
+#endif
+        }
+        num_errors += _q->fd_m[i] ? 1 : 0;
+        _q->fd_t[i]   = 0.0f;
+        _q->fd_t[n+i] = e;
+    }
+    if (num_errors == 0)
+        return LIQUID_OK;
+
+    // smoothed power estimate in each bin
+    float beta = _q->fd_P_init ? 0.8f : 0.0f;
+    float P_mean = 0.0f;
+    for (i=0; i<_q->nfft; i++) {
+        float u2 = crealf(_q->fd_U[i])*crealf(_q->fd_U[i]) +
+                   cimagf(_q->fd_U[i])*cimagf(_q->fd_U[i]);
+        _q->fd_P[i] = beta*_q->fd_P[i] + (1.0f-beta)*u2;
+        P_mean += _q->fd_P[i];
+    }
+    _q->fd_P_init = 1;
+    P_mean /= (float)(_q->nfft);
+    if (P_mean <= 0.0f)
+        return LIQUID_OK;
+
+    // normalized gradient: G = conj(U) E / (P + delta); regularization
+    // bounds the gain in bins with little power, without which the
+    // constrained update can diverge for (nearly) periodic inputs
+    fft_execute(_q->fft);
+    float delta = 0.2f * P_mean;
+    for (i=0; i<_q->nfft; i++)
+        _q->fd_f[i] = conjf(_q->fd_U[i]) * _q->fd_f[i] / (_q->fd_P[i] + delta);
+
+    if (_q->method == LIQUID_EQLMS_FDLMS_UNCONSTRAINED) {
+        // W += 2 mu G; w0 recovered only when requested
+        EQLMS(_fd_sync_W)(_q);
+        for (i=0; i<_q->nfft; i++)
+            _q->fd_W[i] += 2.0f * _q->mu * _q->fd_f[i];
+        _q->w_stale = 1;
+        return LIQUID_OK;
+    }
+
+    // constrained: keep first h_len taps of gradient (correlation at
+    // non-negative lags), h += 2 mu ifft(G)
+    fft_execute(_q->ifft);
+    float g = 2.0f * _q->mu / (float)(_q->nfft);
+    for (i=0; i<n; i++)
+        _q->w0[n-i-1] += conjf(_q->fd_t[i]) * g;
+    _q->W_stale = 1;
+    return LIQUID_OK;
+}
+
+// push, filter, and update on block of samples
+//  _q      :   equalizer object
+//  _x      :   received samples [size: _n x 1]
+//  _d      :   desired output [size: _n x 1], NULL for blind update
+//  _k      :   blind update decimation rate
+//  _n      :   number of samples
+//  _y      :   filtered output  [size: _n x 1]
+int EQLMS(_fd_run)(EQLMS()      _q,
+                   T *          _x,
+                   T *          _d,
+                   unsigned int _k,
+                   unsigned int _n,
+                   T *          _y)
+{
+    unsigned int n = _q->h_len;
+
+    // per-sample methods invoked since last call invalidate partial block
+    if (_q->fd_len > 0 && _q->count != _q->fd_count)
+        _q->fd_len = 0;
+
+    unsigned int i, j;
+    for (i=0; i<_n; i++) {
+        if (_q->fd_len == 0) {
+            // new block: previous inputs come from buffer
+            T * r;
+            WINDOW(_read)(_q->buffer, &r);
+            for (j=0; j<n; j++) {
+                _q->fd_u[j]   = r[j];
+                _q->fd_u[n+j] = 0.0f;
+            }
+            _q->fd_num = 0;
+        }
+
+        EQLMS(_push)(_q, _x[i]);
+        j = _q->fd_len++;
+        _q->fd_u[n+j] = _x[i];
+        if (_d != NULL) {
+            _q->fd_d[j] = _d[i];
+            _q->fd_m[j] = _q->count >= n ? 1 : 0;
+        } else {
+            _q->fd_m[j] = (_q->count >= n && ((_q->count+_k-1) % _k) == 0) ? 2 : 0;
+        }
+
+        if (_q->fd_len == n) {
+            EQLMS(_fd_filter)(_q, _y + i + 1 - n + _q->fd_num);
+            EQLMS(_fd_update)(_q);
+            _q->fd_len = 0;
+        }
+    }
+
+    // compute outputs for partial block; re-computed on completion
+    if (_q->fd_len > _q->fd_num)
+        EQLMS(_fd_filter)(_q, _y + _n - _q->fd_len + _q->fd_num);
+
+    _q->fd_count = _q->count;
+    return LIQUID_OK;
+}
@@ -27,6 +27,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <math.h>
 
 //#define DEBUG
 
@@ -34,24 +35,28 @@ struct EQRLS(_s) {
     unsigned int p;     // filter order
     float lambda;       // RLS forgetting factor
     float delta;        // RLS initialization factor
+    int method;         // update method (e.g. LIQUID_EQRLS_INVQRD)
 
     // internal matrices
     T * h0;             // initial coefficients
     T * w0, * w1;       // weights [px1]
-    T * P0, * P1;       // recursion matrix [pxp]
+    T * P0;             // recursion matrix [pxp]; for the inverse QR-
+                        // decomposition method its lower-triangular
+                        // square root
     T * g;              // gain vector [px1]
 
     // temporary matrices
-    T * xP0;            // [1xp]
+    T * xP0;            // [1xp], or rotated vector [px1] (inverse QRD)
     T zeta;             // constant
 
-    T * gxl;            // [pxp]
-    T * gxlP0;          // [pxp]
-
     unsigned int n;     // input counter
     WINDOW() buffer;    // input buffer
 };
 
+// update recursion matrix and gain vector for input vector _x
+int EQRLS(_update_conventional)(EQRLS() _q, T * _x);
+int EQRLS(_update_invqrd)      (EQRLS() _q, T * _x);
+
 
 // create recursive least-squares (RLS) equalizer object
 //  _h      :   initial coefficients [size: _p x 1], default if NULL
@@ -68,18 +73,16 @@ EQRLS() EQRLS(_create)(T *          _h,
     q->p      = _p;     // filter order
     q->lambda = 0.99f;  // learning rate
     q->delta  = 0.1f;   // initialization factor
+    q->method = LIQUID_EQRLS_CONVENTIONAL;
 
     // allocate memory for matrices
     q->h0 = (T*) malloc((q->p)*sizeof(T));
     q->w0 = (T*) malloc((q->p)*sizeof(T));
     q->w1 = (T*) malloc((q->p)*sizeof(T));
     q->P0 = (T*) malloc((q->p)*(q->p)*sizeof(T));
-    q->P1 = (T*) malloc((q->p)*(q->p)*sizeof(T));
     q->g  = (T*) malloc((q->p)*sizeof(T));
 
     q->xP0 =   (T*) malloc((q->p)*sizeof(T));
-    q->gxl =   (T*) malloc((q->p)*(q->p)*sizeof(T));
-    q->gxlP0 = (T*) malloc((q->p)*(q->p)*sizeof(T));
 
     q->buffer = WINDOW(_create)(q->p);
 
@@ -134,12 +137,9 @@ int EQRLS(_destroy)(EQRLS() _q)
     free(_q->w0);
     free(_q->w1);
     free(_q->P0);
-    free(_q->P1);
     free(_q->g);
 
     free(_q->xP0);
-    free(_q->gxl);
-    free(_q->gxlP0);
 
     // destroy window buffer
     WINDOW(_destroy)(_q->buffer);
@@ -154,6 +154,7 @@ int EQRLS(_print)(EQRLS() _q)
 {
     printf("equalizer (RLS):\n");
     printf("    order:      %u\n", _q->p);
+    printf("    method:     %s\n", _q->method == LIQUID_EQRLS_INVQRD ? "inverse QRD" : "conventional");
 
 #ifdef DEBUG
     unsigned int r,c,p=_q->p;
@@ -165,21 +166,6 @@ int EQRLS(_print)(EQRLS() _q)
         printf("\n");
     }
 
-    printf("P1:\n");
-    for (r=0; r<p; r++) {
-        for (c=0; c<p; c++) {
-            PRINTVAL(matrix_access(_q->P1,p,p,r,c));
-        }
-        printf("\n");
-    }
-
-    printf("gxl:\n");
-    for (r=0; r<p; r++) {
-        for (c=0; c<p; c++) {
-            PRINTVAL(matrix_access(_q->gxl,p,p,r,c));
-        }
-        printf("\n");
-    }
 #endif
     return LIQUID_OK;
 }
@@ -190,11 +176,12 @@ int EQRLS(_reset)(EQRLS() _q)
     // reset input counter
     _q->n = 0;
 
+    // initialize recursion matrix, P = I/delta, or its square root
     unsigned int i, j;
-    // initialize...
+    float v = _q->method == LIQUID_EQRLS_INVQRD ? 1.0f / sqrtf(_q->delta) : 1.0f / _q->delta;
     for (i=0; i<_q->p; i++) {
         for (j=0; j<_q->p; j++) {
-            if (i==j)   _q->P0[(_q->p)*i + j] = 1 / (_q->delta);
+            if (i==j)   _q->P0[(_q->p)*i + j] = v;
             else        _q->P0[(_q->p)*i + j] = 0;
         }
     }
@@ -227,6 +214,25 @@ int EQRLS(_set_bw)(EQRLS() _q,
     return LIQUID_OK;
 }
 
+// set update method, resetting equalizer
+//  _q      :   equalizer object
+//  _method :   update method, e.g. LIQUID_EQRLS_INVQRD
+int EQRLS(_set_method)(EQRLS() _q,
+                       int     _method)
+{
+    if (_method != LIQUID_EQRLS_CONVENTIONAL && _method != LIQUID_EQRLS_INVQRD)
+        return liquid_error(LIQUID_EICONFIG,"eqrls_%s_set_method(), invalid method %d", EXTENSION_FULL, _method);
+
+    _q->method = _method;
+    return EQRLS(_reset)(_q);
+}
+
+// get update method
+int EQRLS(_get_method)(EQRLS() _q)
+{
+    return _q->method;
+}
+
 // push sample into equalizer internal buffer
 //  _q  :   equalizer object
 //  _x  :   received sample
@@ -260,7 +266,7 @@ int EQRLS(_step)(EQRLS() _q,
                  T       _d,
                  T       _d_hat)
 {
-    unsigned int i,r,c;
+    unsigned int i;
     unsigned int p=_q->p;
 
     // compute error (a priori)
@@ -270,14 +276,6 @@ int EQRLS(_step)(EQRLS() _q,
     T * x;
     WINDOW(_read)(_q->buffer, &x);
 
-    // compute gain vector
-    for (c=0; c<p; c++) {
-        _q->xP0[c] = 0;
-        for (r=0; r<p; r++) {
-            _q->xP0[c] += x[r] * matrix_access(_q->P0,p,p,r,c);
-        }
-    }
-
 #ifdef DEBUG
     printf("x: ");
     for (i=0; i<p; i++)
@@ -287,55 +285,21 @@ int EQRLS(_step)(EQRLS() _q,
     DEBUG_PRINTF_CFLOAT(stdout,"    d",0,_d);
     DEBUG_PRINTF_CFLOAT(stdout,"_d_hat",0,_d_hat);
     DEBUG_PRINTF_CFLOAT(stdout,"error",0,alpha);
-
-    printf("xP0: ");
-    for (c=0; c<p; c++)
-        PRINTVAL(_q->xP0[c]);
-    printf("\n");
 #endif
-    // zeta = lambda + [x.']*[P0]*[conj(x)]
-    _q->zeta = 0;
-    for (c=0; c<p; c++) {
-        T sum = _q->xP0[c] * conj(x[c]);
-        _q->zeta += sum;
-    }
-    _q->zeta += _q->lambda;
-#ifdef DEBUG
-    printf("zeta : ");
-    PRINTVAL(_q->zeta);
-    printf("\n");
-#endif
-    for (r=0; r<p; r++) {
-        _q->g[r] = 0;
-        for (c=0; c<p; c++) {
-            T sum = matrix_access(_q->P0,p,p,r,c) * conj(x[c]);
-            _q->g[r] += sum;
-        }
-        _q->g[r] /= _q->zeta;
-    }
+
+    // update recursion matrix and compute gain vector
+    if (_q->method == LIQUID_EQRLS_INVQRD)
+        EQRLS(_update_invqrd)(_q, x);
+    else
+        EQRLS(_update_conventional)(_q, x);
+
 #ifdef DEBUG
     printf("g: ");
     for (i=0; i<p; i++)
         PRINTVAL(_q->g[i]);
-        //printf("%6.3f ", _q->g[i]);
     printf("\n");
 #endif
 
-    // update recursion matrix
-    for (r=0; r<p; r++) {
-        for (c=0; c<p; c++) {
-            // gxl = [g] * [x.'] / lambda
-            matrix_access(_q->gxl,p,p,r,c) = _q->g[r] * x[c] / _q->lambda;
-        }
-    }
-    // multiply two [pxp] matrices: gxlP0 = gxl * P0
-    MATRIX(_mul)(_q->gxl,  p,p,
-                 _q->P0,   p,p,
-                 _q->gxlP0,p,p);
-
-    for (i=0; i<p*p; i++)
-        _q->P1[i] = _q->P0[i] / _q->lambda - _q->gxlP0[i];
-
     // update weighting vector
     for (i=0; i<p; i++)
         _q->w1[i] = _q->w0[i] + alpha*(_q->g[i]);
@@ -350,13 +314,131 @@ int EQRLS(_step)(EQRLS() _q,
     for (i=0; i<p; i++) {
         PRINTVAL(_q->w1[i]);
         printf("\n");
-    EQRLS(_print)(_q);
     }
+    EQRLS(_print)(_q);
 #endif
 
     // copy old values
-    memmove(_q->w0, _q->w1,   p*sizeof(T));
-    memmove(_q->P0, _q->P1, p*p*sizeof(T));
+    memmove(_q->w0, _q->w1, p*sizeof(T));
+    return LIQUID_OK;
+}
+
+// execute and train on a block of samples; equivalent to invoking push(),
+// execute(), and step() for each sample
+//  _q      :   equalizer object
+//  _x      :   received samples, [size: _n x 1]
+//  _d      :   desired output,   [size: _n x 1]
+//  _n      :   number of samples
+//  _y      :   filtered output,  [size: _n x 1]
+int EQRLS(_step_block)(EQRLS()      _q,
+                       T *          _x,
+                       T *          _d,
+                       unsigned int _n,
+                       T *          _y)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        WINDOW(_push)(_q->buffer, _x[i]);
+        EQRLS(_execute)(_q, &_y[i]);
+        EQRLS(_step)(_q, _d[i], _y[i]);
+    }
+    return LIQUID_OK;
+}
+
+// conventional update of inverse correlation matrix, O(p^2)
+//   zeta = lambda + x.' P conjf(x)
+//   g    = P conjf(x) / zeta
+//   P    = (P - g (x.' P)) / lambda
+int EQRLS(_update_conventional)(EQRLS() _q,
+                                T *     _x)
+{
+    unsigned int r,c;
+    unsigned int p=_q->p;
+    T * P = _q->P0;
+
+    // compute x.' P, accumulating rows for contiguous access
+    for (c=0; c<p; c++)
+        _q->xP0[c] = 0;
+    for (r=0; r<p; r++) {
+        T xr = _x[r];
+        for (c=0; c<p; c++)
+            _q->xP0[c] += xr * P[r*p+c];
+    }
+
+    // zeta = lambda + [x.']*[P0]*[conjf(x)]
+    _q->zeta = 0;
+    for (c=0; c<p; c++)
+        _q->zeta += _q->xP0[c] * conjf(_x[c]);
+    _q->zeta += _q->lambda;
+
+    // compute gain vector
+    T zeta_inv = 1.0f / _q->zeta;
+    for (r=0; r<p; r++) {
+        T sum = 0;
+        for (c=0; c<p; c++)
+            sum += P[r*p+c] * conjf(_x[c]);
+        _q->g[r] = sum * zeta_inv;
+    }
+
+    // update recursion matrix in place with rank-one correction
+    float lambda_inv = 1.0f / _q->lambda;
+    for (r=0; r<p; r++) {
+        T gr = _q->g[r];
+        for (c=0; c<p; c++)
+            P[r*p+c] = (P[r*p+c] - gr*_q->xP0[c]) * lambda_inv;
+    }
+    return LIQUID_OK;
+}
+
+// inverse QR-decomposition update, O(p^2): the lower-triangular square
+// root L of the inverse correlation matrix (P = L L^H) is propagated
+// directly, annihilating the pre-array
+//   [ 1   a^H           ]        a = lambda^{-1/2} L^H conjf(x)
+//   [ 0   lambda^{-1/2} L ]
+// with Givens rotations into the first column; the result holds the
+// conversion factor gamma^{-1/2} on top and g*gamma^{-1/2} below. The
+// columns are processed from last to first so L stays lower triangular.
+int EQRLS(_update_invqrd)(EQRLS() _q,
+                          T *     _x)
+{
+    int j;
+    unsigned int i;
+    unsigned int p=_q->p;
+    T * L = _q->P0;
+    T * a = _q->xP0;
+    float s = 1.0f / sqrtf(_q->lambda);
+
+    // a = lambda^{-1/2} L^H conjf(x)
+    for (j=0; j<(int)p; j++) {
+        T sum = 0;
+        for (i=j; i<p; i++)
+            sum += conjf(L[i*p+j] * _x[i]);
+        a[j] = sum * s;
+    }
+
+    // rotate each column of the scaled square root into the first column
+    float t0 = 1.0f;
+    for (i=0; i<p; i++)
+        _q->g[i] = 0;
+    for (j=(int)p-1; j>=0; j--) {
+        T     aj = a[j];
+        float r  = sqrtf(t0*t0 + crealf(aj*conjf(aj)));
+        float c  = t0 / r;
+        T     sn = aj / r;
+        for (i=j; i<p; i++) {
+            T b  = L[i*p+j] * s;
+            T gi = _q->g[i];
+            _q->g[i]   = c*gi + sn*b;
+            L[i*p+j]   = c*b  - conjf(sn)*gi;
+        }
+        t0 = r;
+    }
+
+    // normalize gain vector by conversion factor
+    float t0_inv = 1.0f / t0;
+    for (i=0; i<p; i++)
+        _q->g[i] *= t0_inv;
+    _q->zeta = t0*t0;
     return LIQUID_OK;
 }
 
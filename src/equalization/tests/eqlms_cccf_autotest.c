@@ -144,6 +144,108 @@ void autotest_eqlms_10() { testbench_eqlms(2,7, 0.3,   0,7,0.7,800,     0,LIQUID
 void autotest_eqlms_11() { testbench_eqlms(2,7, 0.3,   0,7,0.1,800,     0,LIQUID_MODEM_QPSK); }
 //void xautotest_eqlms_12() { testbench_eqlms(4,7, 0.3,   0,7,0.7,800,     0,LIQUID_MODEM_QPSK); }
 
+// identify unknown channel by training on block of samples with
+// irregular call sizes
+void testbench_eqlms_step_block(int _method, unsigned int _h_len)
+{
+    unsigned int i, j;
+    unsigned int num_samples = 200*_h_len;
+
+    // random channel with decaying response
+    float complex h[_h_len];
+    for (i=0; i<_h_len; i++)
+        h[i] = (randnf() + _Complex_I*randnf()) * expf(-4.0f*(float)i/(float)_h_len);
+    firfilt_cccf channel = firfilt_cccf_create(h, _h_len);
+
+    eqlms_cccf q = eqlms_cccf_create(NULL, _h_len);
+    CONTEND_EQUALITY(eqlms_cccf_set_method(q, _method), LIQUID_OK);
+    CONTEND_EQUALITY(eqlms_cccf_get_method(q), _method);
+
+    float complex x[num_samples], d[num_samples], y[num_samples];
+    for (i=0; i<num_samples; i++) {
+        x[i] = randnf() + _Complex_I*randnf();
+        firfilt_cccf_push   (channel, x[i]);
+        firfilt_cccf_execute(channel, &d[i]);
+    }
+
+    // run in chunks of irregular size
+    unsigned int n = 0, sizes[] = {1, 7, _h_len, 3*_h_len+5, 2*_h_len-1};
+    for (i=0; n<num_samples; i++) {
+        unsigned int num = sizes[i%5] < num_samples-n ? sizes[i%5] : num_samples-n;
+        eqlms_cccf_step_block(q, x+n, d+n, num, y+n);
+        n += num;
+    }
+
+    // compare coefficients to channel
+    float complex w[_h_len];
+    eqlms_cccf_copy_coefficients(q, w);
+    float e2 = 0.0f, h2 = 0.0f;
+    for (j=0; j<_h_len; j++) {
+        e2 += crealf((w[j]-h[j])*conjf(w[j]-h[j]));
+        h2 += crealf(h[j]*conjf(h[j]));
+    }
+    float error = 10*log10f(e2/h2);
+    if (liquid_autotest_verbose)
+        printf("eqlms step_block, method=%d, n=%u : coefficient error = %.2f dB\n", _method, _h_len, error);
+    CONTEND_LESS_THAN(error, -40.0f);
+
+    // output error over last block should be small
+    float rmse = 0.0f;
+    for (i=num_samples-_h_len; i<num_samples; i++)
+        rmse += crealf((y[i]-d[i])*conjf(y[i]-d[i]));
+    CONTEND_LESS_THAN(10*log10f(rmse/(float)_h_len), -30.0f);
+
+    firfilt_cccf_destroy(channel);
+    eqlms_cccf_destroy(q);
+}
+void autotest_eqlms_step_block_time()      { testbench_eqlms_step_block(LIQUID_EQLMS_TIME,                 32); }
+void autotest_eqlms_step_block_fdlms()     { testbench_eqlms_step_block(LIQUID_EQLMS_FDLMS,                32); }
+void autotest_eqlms_step_block_fdlms_long(){ testbench_eqlms_step_block(LIQUID_EQLMS_FDLMS,               128); }
+void autotest_eqlms_step_block_fdlms_unc() { testbench_eqlms_step_block(LIQUID_EQLMS_FDLMS_UNCONSTRAINED,  32); }
+
+// with learning rate of zero, block filtering must match time domain
+void testbench_eqlms_fdlms_filter(int _blind)
+{
+    unsigned int i, h_len = 21, num_samples = 400;
+    float complex h[h_len];
+    for (i=0; i<h_len; i++)
+        h[i] = randnf() + _Complex_I*randnf();
+
+    eqlms_cccf q0 = eqlms_cccf_create(h, h_len);
+    eqlms_cccf q1 = eqlms_cccf_create(h, h_len);
+    eqlms_cccf_set_bw(q0, 0.0f);
+    eqlms_cccf_set_bw(q1, 0.0f);
+    eqlms_cccf_set_method(q1, LIQUID_EQLMS_FDLMS);
+
+    float complex x[num_samples], d[num_samples], y0[num_samples], y1[num_samples];
+    for (i=0; i<num_samples; i++) {
+        x[i] = randnf() + _Complex_I*randnf();
+        d[i] = randnf() + _Complex_I*randnf();
+    }
+
+    unsigned int n = 0, sizes[] = {3, 1, 40, 21, 17, 0, 64};
+    for (i=0; n<num_samples; i++) {
+        unsigned int num = sizes[i%7] < num_samples-n ? sizes[i%7] : num_samples-n;
+        if (_blind) {
+            eqlms_cccf_execute_block(q0, 2, x+n, num, y0+n);
+            eqlms_cccf_execute_block(q1, 2, x+n, num, y1+n);
+        } else {
+            eqlms_cccf_step_block(q0, x+n, d+n, num, y0+n);
+            eqlms_cccf_step_block(q1, x+n, d+n, num, y1+n);
+        }
+        n += num;
+    }
+    for (i=0; i<num_samples; i++) {
+        CONTEND_DELTA(crealf(y1[i]), crealf(y0[i]), 1e-4f);
+        CONTEND_DELTA(cimagf(y1[i]), cimagf(y0[i]), 1e-4f);
+    }
+
+    eqlms_cccf_destroy(q0);
+    eqlms_cccf_destroy(q1);
+}
+void autotest_eqlms_fdlms_filter()       { testbench_eqlms_fdlms_filter(0); }
+void autotest_eqlms_fdlms_filter_blind() { testbench_eqlms_fdlms_filter(1); }
+
 void autotest_eqlms_config()
 {
 #if LIQUID_STRICT_EXIT
@@ -176,6 +278,10 @@ void autotest_eqlms_config()
 
     // other configurations
     CONTEND_INEQUALITY(LIQUID_OK, eqlms_cccf_decim_execute(q, NULL, NULL, 0));
+    CONTEND_INEQUALITY(LIQUID_OK, eqlms_cccf_set_method(q, -1));
+    CONTEND_EQUALITY(eqlms_cccf_get_method(q), LIQUID_EQLMS_TIME);
+    CONTEND_EQUALITY(LIQUID_OK, eqlms_cccf_set_method(q, LIQUID_EQLMS_FDLMS_UNCONSTRAINED));
+    CONTEND_EQUALITY(LIQUID_OK, eqlms_cccf_print(q));
 
     // test getting weights
     float complex h[h_len];
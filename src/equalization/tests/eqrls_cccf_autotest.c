@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2007 - 2021 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// train equalizer on QPSK symbols through a minimum-phase channel and
+// return weights and mean-squared a priori error over final symbols
+void eqrls_cccf_test_channel(int             _method,
+                             unsigned int    _p,
+                             unsigned int    _n,
+                             float complex * _w,
+                             float *         _mse)
+{
+    // channel
+    float complex h[3] = {1.0f, 0.3f + 0.2f*_Complex_I, -0.1f*_Complex_I};
+    firfilt_cccf f = firfilt_cccf_create(h, 3);
+
+    // create equalizer
+    eqrls_cccf q = eqrls_cccf_create(NULL, _p);
+    CONTEND_EQUALITY(eqrls_cccf_set_method(q, _method), LIQUID_OK);
+    CONTEND_EQUALITY(eqrls_cccf_get_method(q), _method);
+
+    unsigned int i;
+    float mse = 0.0f;
+    for (i=0; i<_n; i++) {
+        // generate symbol, filter through channel, add noise
+        float complex d = ((rand() & 1) ? 1 : -1)*M_SQRT1_2 + ((rand() & 1) ? 1 : -1)*M_SQRT1_2*_Complex_I;
+        float complex x;
+        firfilt_cccf_push(f, d);
+        firfilt_cccf_execute(f, &x);
+        x += 0.01f*(randnf() + _Complex_I*randnf())*M_SQRT1_2;
+
+        // run equalizer
+        float complex y;
+        eqrls_cccf_push(q, x);
+        eqrls_cccf_execute(q, &y);
+        eqrls_cccf_step(q, d, y);
+        if (i >= _n - 100)
+            mse += crealf((d-y)*conjf(d-y)) / 100.0f;
+    }
+    eqrls_cccf_get_weights(q, _w);
+    *_mse = mse;
+
+    firfilt_cccf_destroy(f);
+    eqrls_cccf_destroy(q);
+}
+
+// both update methods must converge to the same solution
+void autotest_eqrls_cccf_methods()
+{
+    unsigned int p = 8, n = 600;
+    float complex w0[p], w1[p];
+    float mse0, mse1;
+    unsigned int seed = rand();
+    srand(seed);
+    eqrls_cccf_test_channel(LIQUID_EQRLS_CONVENTIONAL, p, n, w0, &mse0);
+    srand(seed);
+    eqrls_cccf_test_channel(LIQUID_EQRLS_INVQRD,       p, n, w1, &mse1);
+    if (liquid_autotest_verbose)
+        printf("  mse: conventional %.2f dB, inverse QRD %.2f dB\n", 10*log10f(mse0), 10*log10f(mse1));
+
+    CONTEND_LESS_THAN(10*log10f(mse0), -30.0f);
+    CONTEND_LESS_THAN(10*log10f(mse1), -30.0f);
+    unsigned int i;
+    for (i=0; i<p; i++) {
+        CONTEND_DELTA(crealf(w0[i]), crealf(w1[i]), 1e-3f);
+        CONTEND_DELTA(cimagf(w0[i]), cimagf(w1[i]), 1e-3f);
+    }
+}
+
+// block training must match sample-by-sample operation
+void testbench_eqrls_cccf_block(int _method)
+{
+    unsigned int p = 12, n = 300;
+    float complex x[n], d[n], y0[n], y1[n];
+    unsigned int i;
+    for (i=0; i<n; i++) {
+        x[i] = randnf() + _Complex_I*randnf();
+        d[i] = randnf() + _Complex_I*randnf();
+    }
+    eqrls_cccf q0 = eqrls_cccf_create(NULL, p);
+    eqrls_cccf q1 = eqrls_cccf_create(NULL, p);
+    eqrls_cccf_set_method(q0, _method);
+    eqrls_cccf_set_method(q1, _method);
+    for (i=0; i<n; i++) {
+        eqrls_cccf_push(q0, x[i]);
+        eqrls_cccf_execute(q0, &y0[i]);
+        eqrls_cccf_step(q0, d[i], y0[i]);
+    }
+    CONTEND_EQUALITY(eqrls_cccf_step_block(q1, x,     d,     100, y1    ), LIQUID_OK);
+    CONTEND_EQUALITY(eqrls_cccf_step_block(q1, x+100, d+100, 200, y1+100), LIQUID_OK);
+    CONTEND_SAME_DATA(y0, y1, sizeof(y0));
+
+    float complex w0[p], w1[p];
+    eqrls_cccf_get_weights(q0, w0);
+    eqrls_cccf_get_weights(q1, w1);
+    CONTEND_SAME_DATA(w0, w1, sizeof(w0));
+    eqrls_cccf_destroy(q0);
+    eqrls_cccf_destroy(q1);
+}
+void autotest_eqrls_cccf_block_conventional() { testbench_eqrls_cccf_block(LIQUID_EQRLS_CONVENTIONAL); }
+void autotest_eqrls_cccf_block_invqrd()       { testbench_eqrls_cccf_block(LIQUID_EQRLS_INVQRD);       }
+
+void autotest_eqrls_cccf_config()
+{
+#if LIQUID_STRICT_EXIT
+    AUTOTEST_WARN("skipping eqrls_cccf config test with strict exit enabled\n");
+    return;
+#endif
+#if !LIQUID_SUPPRESS_ERROR_OUTPUT
+    fprintf(stderr,"warning: ignore potential errors here; checking for invalid configurations\n");
+#endif
+    eqrls_cccf q = eqrls_cccf_create(NULL, 4);
+    CONTEND_INEQUALITY(eqrls_cccf_set_method(q, -1), LIQUID_OK);
+    CONTEND_INEQUALITY(eqrls_cccf_set_method(q,  2), LIQUID_OK);
+    CONTEND_EQUALITY  (eqrls_cccf_get_method(q), LIQUID_EQRLS_CONVENTIONAL);
+    CONTEND_EQUALITY  (eqrls_cccf_print(q), LIQUID_OK);
+    eqrls_cccf_destroy(q);
+}
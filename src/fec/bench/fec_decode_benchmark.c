@@ -149,15 +149,22 @@ void benchmark_fec_dec_none_n64         FEC_DECODE_BENCH_API(LIQUID_FEC_NONE,
 void benchmark_fec_dec_rep3_n64         FEC_DECODE_BENCH_API(LIQUID_FEC_REP3,      64,  NULL)
 void benchmark_fec_dec_rep5_n64         FEC_DECODE_BENCH_API(LIQUID_FEC_REP5,      64,  NULL)
 void benchmark_fec_dec_hamming74_n64    FEC_DECODE_BENCH_API(LIQUID_FEC_HAMMING74, 64,  NULL)
+void benchmark_fec_dec_hamming74_n1024  FEC_DECODE_BENCH_API(LIQUID_FEC_HAMMING74, 1024, NULL)
 void benchmark_fec_dec_hamming84_n64    FEC_DECODE_BENCH_API(LIQUID_FEC_HAMMING84, 64,  NULL)
+void benchmark_fec_dec_hamming84_n1024  FEC_DECODE_BENCH_API(LIQUID_FEC_HAMMING84, 1024, NULL)
 void benchmark_fec_dec_hamming128_n64   FEC_DECODE_BENCH_API(LIQUID_FEC_HAMMING128,64,  NULL)
+void benchmark_fec_dec_hamming128_n1024 FEC_DECODE_BENCH_API(LIQUID_FEC_HAMMING128, 1024, NULL)
 
 // SEC-DED block codes
 void benchmark_fec_dec_secded2216_n64   FEC_DECODE_BENCH_API(LIQUID_FEC_SECDED2216,64,  NULL)
+void benchmark_fec_dec_secded2216_n1024 FEC_DECODE_BENCH_API(LIQUID_FEC_SECDED2216, 1024, NULL)
 void benchmark_fec_dec_secded3932_n64   FEC_DECODE_BENCH_API(LIQUID_FEC_SECDED3932,64,  NULL)
+void benchmark_fec_dec_secded3932_n1024 FEC_DECODE_BENCH_API(LIQUID_FEC_SECDED3932, 1024, NULL)
 void benchmark_fec_dec_secded7264_n64   FEC_DECODE_BENCH_API(LIQUID_FEC_SECDED7264,64,  NULL)
+void benchmark_fec_dec_secded7264_n1024 FEC_DECODE_BENCH_API(LIQUID_FEC_SECDED7264, 1024, NULL)
 
 void benchmark_fec_dec_golay2412_n64    FEC_DECODE_BENCH_API(LIQUID_FEC_GOLAY2412, 64,  NULL)
+void benchmark_fec_dec_golay2412_n1024  FEC_DECODE_BENCH_API(LIQUID_FEC_GOLAY2412, 1024, NULL)
 
 void benchmark_fec_dec_conv27_n64       FEC_DECODE_BENCH_API(LIQUID_FEC_CONV_V27,  64,  NULL)
 void benchmark_fec_dec_conv29_n64       FEC_DECODE_BENCH_API(LIQUID_FEC_CONV_V29,  64,  NULL)
@@ -180,3 +187,11 @@ void benchmark_fec_dec_conv29p78_n64    FEC_DECODE_BENCH_API(LIQUID_FEC_CONV_V29
 
 void benchmark_fec_dec_rs8_n64          FEC_DECODE_BENCH_API(LIQUID_FEC_RS_M8,      64,  NULL)
 
+// low-density parity-check codes
+void benchmark_fec_dec_ldpc648_n64      FEC_DECODE_BENCH_API(LIQUID_FEC_LDPC_R12_N648,   64, NULL)
+void benchmark_fec_dec_ldpc648_n1024    FEC_DECODE_BENCH_API(LIQUID_FEC_LDPC_R12_N648, 1024, NULL)
+void benchmark_fec_dec_ldpc1296_n64     FEC_DECODE_BENCH_API(LIQUID_FEC_LDPC_R12_N1296,   64, NULL)
+void benchmark_fec_dec_ldpc1296_n1024   FEC_DECODE_BENCH_API(LIQUID_FEC_LDPC_R12_N1296, 1024, NULL)
+void benchmark_fec_dec_ldpc1944_n64     FEC_DECODE_BENCH_API(LIQUID_FEC_LDPC_R12_N1944,   64, NULL)
+void benchmark_fec_dec_ldpc1944_n1024   FEC_DECODE_BENCH_API(LIQUID_FEC_LDPC_R12_N1944, 1024, NULL)
+
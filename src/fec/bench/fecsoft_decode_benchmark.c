@@ -84,6 +84,7 @@ void fecsoft_decode_bench(
     case LIQUID_FEC_HAMMING74:     *_num_iterations *= 1;   break;
     case LIQUID_FEC_HAMMING84:     *_num_iterations *= 1;   break;
     case LIQUID_FEC_HAMMING128:    *_num_iterations *= 1;   break;
+    case LIQUID_FEC_GOLAY2412:     *_num_iterations /= 2;   break;
     case LIQUID_FEC_CONV_V27:      *_num_iterations /= 5;   break;
     case LIQUID_FEC_CONV_V29:      *_num_iterations /= 50;  break;
     case LIQUID_FEC_CONV_V39:      *_num_iterations /= 50;  break;
@@ -166,6 +167,7 @@ void benchmark_fecsoft_dec_rep5_n64       FECSOFT_DECODE_BENCH_API(LIQUID_FEC_RE
 void benchmark_fecsoft_dec_hamming74_n64  FECSOFT_DECODE_BENCH_API(LIQUID_FEC_HAMMING74, 64,  NULL)
 void benchmark_fecsoft_dec_hamming84_n64  FECSOFT_DECODE_BENCH_API(LIQUID_FEC_HAMMING84, 64,  NULL)
 void benchmark_fecsoft_dec_hamming128_n64 FECSOFT_DECODE_BENCH_API(LIQUID_FEC_HAMMING128,64,  NULL)
+void benchmark_fecsoft_dec_golay2412_n64  FECSOFT_DECODE_BENCH_API(LIQUID_FEC_GOLAY2412, 64,  NULL)
 
 void benchmark_fecsoft_dec_conv27_n64     FECSOFT_DECODE_BENCH_API(LIQUID_FEC_CONV_V27,  64,  NULL)
 void benchmark_fecsoft_dec_conv29_n64     FECSOFT_DECODE_BENCH_API(LIQUID_FEC_CONV_V29,  64,  NULL)
@@ -188,3 +190,11 @@ void benchmark_fecsoft_dec_conv29p78_n64  FECSOFT_DECODE_BENCH_API(LIQUID_FEC_CO
 
 void benchmark_fecsoft_dec_rs8_n64        FECSOFT_DECODE_BENCH_API(LIQUID_FEC_RS_M8,      64, NULL)
 
+// low-density parity-check codes
+void benchmark_fecsoft_dec_ldpc648_n64    FECSOFT_DECODE_BENCH_API(LIQUID_FEC_LDPC_R12_N648,   64, NULL)
+void benchmark_fecsoft_dec_ldpc648_n1024  FECSOFT_DECODE_BENCH_API(LIQUID_FEC_LDPC_R12_N648, 1024, NULL)
+void benchmark_fecsoft_dec_ldpc1296_n64   FECSOFT_DECODE_BENCH_API(LIQUID_FEC_LDPC_R12_N1296,   64, NULL)
+void benchmark_fecsoft_dec_ldpc1296_n1024 FECSOFT_DECODE_BENCH_API(LIQUID_FEC_LDPC_R12_N1296, 1024, NULL)
+void benchmark_fecsoft_dec_ldpc1944_n64   FECSOFT_DECODE_BENCH_API(LIQUID_FEC_LDPC_R12_N1944,   64, NULL)
+void benchmark_fecsoft_dec_ldpc1944_n1024 FECSOFT_DECODE_BENCH_API(LIQUID_FEC_LDPC_R12_N1944, 1024, NULL)
+
@@ -25,40 +25,54 @@
 #include <sys/resource.h>
 #include "liquid.h"
 
-#define INTERLEAVER_BENCH_API(N)        \
+#define INTERLEAVER_BENCH_API(N,D,S)   \
 (   struct rusage *_start,              \
     struct rusage *_finish,             \
     unsigned long int *_num_iterations) \
-{ interleaver_bench(_start, _finish, _num_iterations, N); }
+{ interleaver_bench(_start, _finish, _num_iterations, N, D, S); }
 
 // Helper function to keep code base small
+//  _n      :   block size (bytes)
+//  _depth  :   interleaver depth
+//  _soft   :   operate on soft bits?
 void interleaver_bench(struct rusage *_start,
                        struct rusage *_finish,
                        unsigned long int *_num_iterations,
-                       unsigned int _n)
+                       unsigned int _n,
+                       unsigned int _depth,
+                       int          _soft)
 {
     // scale number of iterations by block size
-    // iterations = 4: cycles/trial ~ exp( -0.883 + 0.708*log(_n) )
-    *_num_iterations /= 0.7f*expf( -0.883 + 0.708*logf(_n) );
+    *_num_iterations = *_num_iterations * 8 / (_soft ? 8*_n : _n);
+    if (*_num_iterations < 1) *_num_iterations = 1;
 
     // initialize interleaver
     interleaver q = interleaver_create(_n);
-    interleaver_set_depth(q, 4);
+    interleaver_set_depth(q, _depth);
 
-    unsigned char x[_n];
-    unsigned char y[_n];
+    unsigned char x[8*_n];
+    unsigned char y[8*_n];
     
     unsigned long int i;
-    for (i=0; i<_n; i++)
+    for (i=0; i<8*_n; i++)
         x[i] = rand() & 0xff;
 
     // start trials
     getrusage(RUSAGE_SELF, _start);
-    for (i=0; i<(*_num_iterations); i++) {
-        interleaver_encode(q, x, y);
-        interleaver_encode(q, x, y);
-        interleaver_encode(q, x, y);
-        interleaver_encode(q, x, y);
+    if (_soft) {
+        for (i=0; i<(*_num_iterations); i++) {
+            interleaver_encode_soft(q, x, y);
+            interleaver_encode_soft(q, x, y);
+            interleaver_encode_soft(q, x, y);
+            interleaver_encode_soft(q, x, y);
+        }
+    } else {
+        for (i=0; i<(*_num_iterations); i++) {
+            interleaver_encode(q, x, y);
+            interleaver_encode(q, x, y);
+            interleaver_encode(q, x, y);
+            interleaver_encode(q, x, y);
+        }
     }
     getrusage(RUSAGE_SELF, _finish);
     *_num_iterations *= 4;
@@ -67,12 +81,22 @@ void interleaver_bench(struct rusage *_start,
     interleaver_destroy(q);
 }
 
-void benchmark_interleaver_8    INTERLEAVER_BENCH_API(8     )
-void benchmark_interleaver_16   INTERLEAVER_BENCH_API(16    )
-void benchmark_interleaver_32   INTERLEAVER_BENCH_API(32    )
-void benchmark_interleaver_64   INTERLEAVER_BENCH_API(64    )
-void benchmark_interleaver_128  INTERLEAVER_BENCH_API(128   )
-void benchmark_interleaver_256  INTERLEAVER_BENCH_API(256   )
-void benchmark_interleaver_512  INTERLEAVER_BENCH_API(512   )
-void benchmark_interleaver_1024 INTERLEAVER_BENCH_API(1024  )
+void benchmark_interleaver_8            INTERLEAVER_BENCH_API(8,    4, 0)
+void benchmark_interleaver_16           INTERLEAVER_BENCH_API(16,   4, 0)
+void benchmark_interleaver_32           INTERLEAVER_BENCH_API(32,   4, 0)
+void benchmark_interleaver_64           INTERLEAVER_BENCH_API(64,   4, 0)
+void benchmark_interleaver_128          INTERLEAVER_BENCH_API(128,  4, 0)
+void benchmark_interleaver_256          INTERLEAVER_BENCH_API(256,  4, 0)
+void benchmark_interleaver_512          INTERLEAVER_BENCH_API(512,  4, 0)
+void benchmark_interleaver_1024         INTERLEAVER_BENCH_API(1024, 4, 0)
+
+// cost by depth
+void benchmark_interleaver_d1_1024      INTERLEAVER_BENCH_API(1024, 1, 0)
+void benchmark_interleaver_d2_1024      INTERLEAVER_BENCH_API(1024, 2, 0)
+void benchmark_interleaver_d3_1024      INTERLEAVER_BENCH_API(1024, 3, 0)
+
+// soft bits
+void benchmark_interleaver_soft_64      INTERLEAVER_BENCH_API(64,   4, 1)
+void benchmark_interleaver_soft_1024    INTERLEAVER_BENCH_API(1024, 4, 1)
+void benchmark_interleaver_soft_d1_1024 INTERLEAVER_BENCH_API(1024, 1, 1)
 
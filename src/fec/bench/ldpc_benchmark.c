@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2007 - 2022 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// benchmark layered min-sum LDPC decoder at practical codeword lengths
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <math.h>
+
+#include "liquid.h"
+
+#define LDPC_DECODE_BENCH_API(Z,SIGMA)  \
+(   struct rusage *_start,              \
+    struct rusage *_finish,             \
+    unsigned long int *_num_iterations) \
+{ ldpc_decode_bench(_start, _finish, _num_iterations, Z, SIGMA); }
+
+// Helper function to keep code base small
+//  _z      :   circulant size (n = 24*_z)
+//  _sigma  :   channel noise standard deviation (unit-energy BPSK)
+void ldpc_decode_bench(struct rusage *     _start,
+                       struct rusage *     _finish,
+                       unsigned long int * _num_iterations,
+                       unsigned int        _z,
+                       float               _sigma)
+{
+    // normalize number of iterations
+    *_num_iterations = *_num_iterations * 2 / _z;
+    if (*_num_iterations < 1)
+        *_num_iterations = 1;
+
+    ldpc q = ldpc_create_r12(_z);
+    unsigned int n = ldpc_get_n(q);
+    unsigned int k = ldpc_get_k(q);
+
+    unsigned long int i;
+    unsigned char msg[k];
+    unsigned char c[n];
+    unsigned char c_hat[n];
+    float llr[n];
+    for (i=0; i<k; i++)
+        msg[i] = rand() & 1;
+    ldpc_encode(q, msg, c);
+    for (i=0; i<n; i++)
+        llr[i] = 2.0f*((c[i] ? -1.0f : 1.0f) + _sigma*randnf()) / (_sigma*_sigma);
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        ldpc_decode(q, llr, c_hat);
+        ldpc_decode(q, llr, c_hat);
+        ldpc_decode(q, llr, c_hat);
+        ldpc_decode(q, llr, c_hat);
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= 4;
+
+    ldpc_destroy(q);
+}
+
+//
+// BENCHMARKS
+//
+void benchmark_ldpc_decode_n648     LDPC_DECODE_BENCH_API(27, 0.70f)
+void benchmark_ldpc_decode_n1296    LDPC_DECODE_BENCH_API(54, 0.70f)
+void benchmark_ldpc_decode_n1944    LDPC_DECODE_BENCH_API(81, 0.70f)
+
+// near threshold (more iterations)
+void benchmark_ldpc_decode_n1944_lo LDPC_DECODE_BENCH_API(81, 0.80f)
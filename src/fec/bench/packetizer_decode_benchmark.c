@@ -93,3 +93,7 @@ void benchmark_packetizer_n256  PACKETIZER_DECODE_BENCH_API(256,  LIQUID_CRC_NON
 void benchmark_packetizer_n512  PACKETIZER_DECODE_BENCH_API(512,  LIQUID_CRC_NONE, LIQUID_FEC_NONE, LIQUID_FEC_NONE)
 void benchmark_packetizer_n1024 PACKETIZER_DECODE_BENCH_API(1024, LIQUID_CRC_NONE, LIQUID_FEC_NONE, LIQUID_FEC_NONE)
 
+
+// small packets with error correction
+void benchmark_packetizer_h74_n16   PACKETIZER_DECODE_BENCH_API(16,   LIQUID_CRC_32,   LIQUID_FEC_HAMMING74,  LIQUID_FEC_NONE)
+void benchmark_packetizer_h128_g_n16 PACKETIZER_DECODE_BENCH_API(16,  LIQUID_CRC_32,   LIQUID_FEC_HAMMING128, LIQUID_FEC_GOLAY2412)
@@ -49,10 +49,8 @@ void sumproduct_bench(struct rusage *     _start,
                       unsigned long int * _num_iterations,
                       unsigned int        _m)
 {
-    // normalize number of iterations
-    // seconds/trial ~ exp{ -16.90 + 2.8815*log(_m) }
-    float scale = expf(-17.42f + 2.9971*logf(_m));
-    *_num_iterations *= 1e-7 / scale;
+    // normalize number of iterations (sparse decoder scales with _m)
+    *_num_iterations = *_num_iterations * 16 / _m;
     if (*_num_iterations < 1)
         *_num_iterations = 1;
 
@@ -114,6 +112,7 @@ void benchmark_sumproduct_m16   SUMPRODUCT_BENCH_API(16)
 void benchmark_sumproduct_m32   SUMPRODUCT_BENCH_API(32)
 void benchmark_sumproduct_m64   SUMPRODUCT_BENCH_API(64)
 void benchmark_sumproduct_m128  SUMPRODUCT_BENCH_API(128)
+void benchmark_sumproduct_m256  SUMPRODUCT_BENCH_API(256)
 
 // generate half-rate LDPC generator and parity-check matrices
 void sumproduct_generate(unsigned int    _m,
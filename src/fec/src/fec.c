@@ -61,7 +61,10 @@ const char * fec_scheme_str[LIQUID_FEC_NUM_SCHEMES][2] = {
     {"v29p56",      "convolutional r5/6 K=9 (punctured)"},
     {"v29p67",      "convolutional r6/7 K=9 (punctured)"},
     {"v29p78",      "convolutional r7/8 K=9 (punctured)"},
-    {"rs8",         "Reed-Solomon, 223/255"}
+    {"rs8",         "Reed-Solomon, 223/255"},
+    {"ldpc648",     "LDPC r1/2 n=648"},
+    {"ldpc1296",    "LDPC r1/2 n=1296"},
+    {"ldpc1944",    "LDPC r1/2 n=1944"}
 };
 
 // Print compact list of existing and available fec schemes
@@ -220,6 +223,11 @@ unsigned int fec_get_enc_msg_length(fec_scheme   _scheme,
     case LIQUID_FEC_SECDED3932:     return _msg_len + _msg_len/4 + ((_msg_len%4) ? 1 : 0);
     case LIQUID_FEC_SECDED7264:     return _msg_len + _msg_len/8 + ((_msg_len%8) ? 1 : 0);
 
+    // low-density parity-check codes
+    case LIQUID_FEC_LDPC_R12_N648:  return fec_ldpc_get_enc_msg_len(_msg_len, 648, 324);
+    case LIQUID_FEC_LDPC_R12_N1296: return fec_ldpc_get_enc_msg_len(_msg_len,1296, 648);
+    case LIQUID_FEC_LDPC_R12_N1944: return fec_ldpc_get_enc_msg_len(_msg_len,1944, 972);
+
 #if LIBFEC_ENABLED
     // convolutional codes
     case LIQUID_FEC_CONV_V27:       return 2*_msg_len + 2;  // (K-1)/r=12, round up to 2 bytes
@@ -408,6 +416,9 @@ float fec_get_rate(fec_scheme _scheme)
     case LIQUID_FEC_SECDED2216:     return 2./3.;   // ultimately 16/22 ~ 0.72727
     case LIQUID_FEC_SECDED3932:     return 4./5.;   // ultimately 32/39 ~ 0.82051
     case LIQUID_FEC_SECDED7264:     return 8./9.;
+    case LIQUID_FEC_LDPC_R12_N648:
+    case LIQUID_FEC_LDPC_R12_N1296:
+    case LIQUID_FEC_LDPC_R12_N1944: return 1./2.;
 
     // convolutional codes
 #if LIBFEC_ENABLED
@@ -485,6 +496,12 @@ fec fec_create(fec_scheme _scheme, void *_opts)
     case LIQUID_FEC_SECDED3932: return fec_secded3932_create(_opts);
     case LIQUID_FEC_SECDED7264: return fec_secded7264_create(_opts);
 
+    // low-density parity-check codes
+    case LIQUID_FEC_LDPC_R12_N648:
+    case LIQUID_FEC_LDPC_R12_N1296:
+    case LIQUID_FEC_LDPC_R12_N1944:
+        return fec_ldpc_create(_scheme);
+
     // convolutional codes
 #if LIBFEC_ENABLED
     case LIQUID_FEC_CONV_V27:
@@ -584,6 +601,12 @@ int fec_destroy(fec _q)
     case LIQUID_FEC_SECDED3932: return fec_secded3932_destroy(_q);
     case LIQUID_FEC_SECDED7264: return fec_secded7264_destroy(_q);
 
+    // low-density parity-check codes
+    case LIQUID_FEC_LDPC_R12_N648:
+    case LIQUID_FEC_LDPC_R12_N1296:
+    case LIQUID_FEC_LDPC_R12_N1944:
+        return fec_ldpc_destroy(_q);
+
     // convolutional codes
 #if LIBFEC_ENABLED
     case LIQUID_FEC_CONV_V27:
@@ -34,8 +34,30 @@
 
 #include "liquid.internal.h"
 
+#if HAVE_SSE41 && HAVE_SMMINTRIN_H
+#include <smmintrin.h>
+#define FEC_GOLAY2412_USE_SSE41 1
+#else
+#define FEC_GOLAY2412_USE_SSE41 0
+#endif
+
 #define DEBUG_FEC_GOLAY2412 0
 
+// Block encoding and decoding use look-up tables rather than the
+// matrix operations below (see fec_golay2412_gentab.c):
+//  - parity of 12-bit message m is the XOR of the entries for its
+//    upper and lower six bits in golay2412_enc_gentab
+//  - since H = [I(12) P], the syndrome of received vector r is the
+//    upper 12 bits of r plus the parity of its lower 12 bits
+//  - the error vector estimated by fec_golay2412_decode_symbol()
+//    depends only upon the syndrome; its lower 12 bits are stored in
+//    golay2412_dec_gentab
+#define GOLAY2412_PARITY(M)   (golay2412_enc_gentab[0][((M)>>6)&0x3f] ^ \
+                               golay2412_enc_gentab[1][ (M)    &0x3f])
+#define GOLAY2412_ENCODE(M)   ((GOLAY2412_PARITY(M) << 12) | (M))
+#define GOLAY2412_DECODE(R)   (((R) ^ golay2412_dec_gentab[((R)>>12) ^ \
+                                GOLAY2412_PARITY(R)]) & 0x0fff)
+
 // P matrix [12 x 12]
 unsigned int golay2412_P[12] = {
     0x08ed, 0x01db, 0x03b5, 0x0769,
@@ -246,7 +268,7 @@ fec fec_golay2412_create(void * _opts)
     // set internal function pointers
     q->encode_func      = &fec_golay2412_encode;
     q->decode_func      = &fec_golay2412_decode;
-    q->decode_soft_func = NULL;
+    q->decode_soft_func = &fec_golay2412_decode_soft;
 
     return q;
 }
@@ -289,8 +311,8 @@ int fec_golay2412_encode(fec             _q,
         m1 = ((s1 << 8) & 0x0f00) | ((s2     ) & 0x00ff);
 
         // encode each 12-bit symbol into a 24-bit symbol
-        v0 = fec_golay2412_encode_symbol(m0);
-        v1 = fec_golay2412_encode_symbol(m1);
+        v0 = GOLAY2412_ENCODE(m0);
+        v1 = GOLAY2412_ENCODE(m1);
 
         // unpack two 24-bit symbols into six 8-bit bytes
         // retaining order of bits in output
@@ -313,7 +335,7 @@ int fec_golay2412_encode(fec             _q,
         m0 = s0;
 
         // encode into 24-bit symbol
-        v0 = fec_golay2412_encode_symbol(m0);
+        v0 = GOLAY2412_ENCODE(m0);
 
         // unpack one 24-bit symbol into three 8-bit bytes, and
         // append to output array
@@ -365,8 +387,8 @@ int fec_golay2412_decode(fec             _q,
         v1 = ((r3 << 16) & 0xff0000) | ((r4 <<  8) & 0x00ff00) | ((r5 << 0) & 0x0000ff);
 
         // decode each symbol into a 12-bit symbol
-        m0_hat = fec_golay2412_decode_symbol(v0);
-        m1_hat = fec_golay2412_decode_symbol(v1);
+        m0_hat = GOLAY2412_DECODE(v0);
+        m1_hat = GOLAY2412_DECODE(v1);
 
         // unpack two 12-bit symbols into three 8-bit bytes
         _msg_dec[i+0] = ((m0_hat >> 4) & 0xff);
@@ -387,7 +409,7 @@ int fec_golay2412_decode(fec             _q,
         v0 = ((r0 << 16) & 0xff0000) | ((r1 <<  8) & 0x00ff00) | ((r2     ) & 0x0000ff);
 
         // decode into a 12-bit symbol
-        m0_hat = fec_golay2412_decode_symbol(v0);
+        m0_hat = GOLAY2412_DECODE(v0);
 
         // retain last 8 bits of 12-bit symbol
         _msg_dec[i] = m0_hat & 0xff;
@@ -400,3 +422,140 @@ int fec_golay2412_decode(fec             _q,
     return LIQUID_OK;
 }
 
+// decode block of data using Golay(24,12) soft decoder
+//
+//  _q              :   encoder/decoder object
+//  _dec_msg_len    :   decoded message length (number of bytes)
+//  _msg_enc        :   encoded message [size: 8*_enc_msg_len x 1]
+//  _msg_dec        :   decoded message [size: _dec_msg_len x 1]
+int fec_golay2412_decode_soft(fec             _q,
+                              unsigned int    _dec_msg_len,
+                              unsigned char * _msg_enc,
+                              unsigned char * _msg_dec)
+{
+    unsigned int i=0;               // decoded byte counter
+    unsigned int k=0;               // soft bit counter
+    unsigned int m0_hat, m1_hat;    // two 12-bit decoded symbols
+
+    // determine remainder of input length / 3
+    unsigned int r = _dec_msg_len % 3;
+
+    for (i=0; i<_dec_msg_len-r; i+=3) {
+        // decode two 24-bit symbols
+        m0_hat = fecsoft_golay2412_decode(&_msg_enc[k   ]);
+        m1_hat = fecsoft_golay2412_decode(&_msg_enc[k+24]);
+
+        // unpack two 12-bit symbols into three 8-bit bytes
+        _msg_dec[i+0] = ((m0_hat >> 4) & 0xff);
+        _msg_dec[i+1] = ((m0_hat << 4) & 0xf0) | ((m1_hat >> 8) & 0x0f);
+        _msg_dec[i+2] = ((m1_hat     ) & 0xff);
+
+        k += 48;
+    }
+
+    // if input length isn't divisible by 3, decode last 1 or two bytes
+    for (i=_dec_msg_len-r; i<_dec_msg_len; i++) {
+        // decode symbol, retaining last 8 bits of 12-bit symbol
+        m0_hat = fecsoft_golay2412_decode(&_msg_enc[k]);
+        _msg_dec[i] = m0_hat & 0xff;
+
+        k += 24;
+    }
+
+    assert( k == 8*fec_get_enc_msg_length(LIQUID_FEC_GOLAY2412,_dec_msg_len) );
+    return LIQUID_OK;
+}
+
+//
+// internal methods
+//
+
+// distance between soft bits and encoded symbol
+static unsigned int golay2412_soft_distance(unsigned char * _soft_bits,
+                                            unsigned int    _v)
+{
+#if FEC_GOLAY2412_USE_SSE41
+    // expand the three bytes of the symbol (most significant first)
+    // so that each soft bit is paired with its own bit of the symbol
+    __m128i v    = _mm_cvtsi32_si128(_v);
+    __m128i sel  = _mm_set_epi8(1,1,1,1,1,1,1,1, 2,2,2,2,2,2,2,2);
+    __m128i sel2 = _mm_set_epi8(-1,-1,-1,-1,-1,-1,-1,-1, 0,0,0,0,0,0,0,0);
+    __m128i bits = _mm_set_epi8(0x01,0x02,0x04,0x08,0x10,0x20,0x40,(char)0x80,
+                                0x01,0x02,0x04,0x08,0x10,0x20,0x40,(char)0x80);
+    __m128i m0 = _mm_shuffle_epi8(v, sel);
+    __m128i m1 = _mm_shuffle_epi8(v, sel2);
+    m0 = _mm_cmpeq_epi8(_mm_and_si128(m0, bits), bits);
+    m1 = _mm_cmpeq_epi8(_mm_and_si128(m1, bits), bits);
+
+    // soft bit b contributes b where symbol bit is 0 and 255-b
+    // where it is 1; compute as b ^ mask and accumulate
+    __m128i s0 = _mm_loadu_si128((__m128i*)&_soft_bits[ 0]);
+    __m128i s1 = _mm_loadl_epi64((__m128i*)&_soft_bits[16]);
+    __m128i zero = _mm_setzero_si128();
+    __m128i d = _mm_add_epi64(_mm_sad_epu8(_mm_xor_si128(s0, m0), zero),
+                              _mm_sad_epu8(_mm_xor_si128(s1, m1), zero));
+    d = _mm_add_epi64(d, _mm_unpackhi_epi64(d, d));
+    return (unsigned int)_mm_cvtsi128_si32(d);
+#else
+    unsigned int i;
+    unsigned int d = 0;
+    for (i=0; i<24; i++)
+        d += ((_v >> (23-i)) & 1) ? 255 - _soft_bits[i] : _soft_bits[i];
+    return d;
+#endif
+}
+
+// soft decoding of one symbol using the Chase-2 algorithm: flip
+// each combination of the four least reliable bits of the hard
+// decision, decode algebraically, and keep the candidate closest to
+// the received soft bits
+unsigned int fecsoft_golay2412_decode(unsigned char * _soft_bits)
+{
+    unsigned int i, j;
+
+    // compute hard decision and find four least reliable bits
+    unsigned int r = 0;
+    unsigned int w[4] = {256, 256, 256, 256};   // reliability
+    unsigned int f[4] = {0, 0, 0, 0};           // bit masks
+    for (i=0; i<24; i++) {
+        unsigned int b  = _soft_bits[i];
+        unsigned int wi = b > 127 ? b - 128 : 127 - b;
+        r = (r << 1) | (b > 127);
+
+        // insert into sorted list
+        for (j=4; j>0 && wi < w[j-1]; j--) {
+            if (j < 4) {
+                w[j] = w[j-1];
+                f[j] = f[j-1];
+            }
+        }
+        if (j < 4) {
+            w[j] = wi;
+            f[j] = 1 << (23-i);
+        }
+    }
+
+    // search over test patterns; hard decision (pattern 0) first so
+    // that it wins ties
+    unsigned int dmin  = 0;
+    unsigned int m_hat = 0;
+    unsigned int p;
+    for (p=0; p<16; p++) {
+        unsigned int e = ((p & 1) ? f[0] : 0) |
+                         ((p & 2) ? f[1] : 0) |
+                         ((p & 4) ? f[2] : 0) |
+                         ((p & 8) ? f[3] : 0);
+        unsigned int rp = r ^ e;
+
+        // decode and re-encode candidate
+        unsigned int m = GOLAY2412_DECODE(rp);
+        unsigned int v = GOLAY2412_ENCODE(m);
+
+        unsigned int d = golay2412_soft_distance(_soft_bits, v);
+        if (d < dmin || p==0) {
+            dmin  = d;
+            m_hat = m;
+        }
+    }
+    return m_hat;
+}
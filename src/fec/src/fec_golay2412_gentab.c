@@ -0,0 +1,561 @@
+/*
+ * Copyright (c) 2007 - 2022 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Golay(24,12) code generated tables
+//
+
+// parity of upper/lower six bits of 12-bit input symbol
+unsigned short int golay2412_enc_gentab[2][64] = {
+  {
+    0x000, 0xda3, 0xed1, 0x372, 0x769, 0xaca, 0x9b8, 0x41b,
+    0x3b5, 0xe16, 0xd64, 0x0c7, 0x4dc, 0x97f, 0xa0d, 0x7ae,
+    0x1db, 0xc78, 0xf0a, 0x2a9, 0x6b2, 0xb11, 0x863, 0x5c0,
+    0x26e, 0xfcd, 0xcbf, 0x11c, 0x507, 0x8a4, 0xbd6, 0x675,
+    0x8ed, 0x54e, 0x63c, 0xb9f, 0xf84, 0x227, 0x155, 0xcf6,
+    0xb58, 0x6fb, 0x589, 0x82a, 0xc31, 0x192, 0x2e0, 0xf43,
+    0x936, 0x495, 0x7e7, 0xa44, 0xe5f, 0x3fc, 0x08e, 0xd2d,
+    0xa83, 0x720, 0x452, 0x9f1, 0xdea, 0x049, 0x33b, 0xe98},
+  {
+    0x000, 0xffe, 0x477, 0xb89, 0xa3b, 0x5c5, 0xe4c, 0x1b2,
+    0xd1d, 0x2e3, 0x96a, 0x694, 0x726, 0x8d8, 0x351, 0xcaf,
+    0x68f, 0x971, 0x2f8, 0xd06, 0xcb4, 0x34a, 0x8c3, 0x73d,
+    0xb92, 0x46c, 0xfe5, 0x01b, 0x1a9, 0xe57, 0x5de, 0xa20,
+    0xb47, 0x4b9, 0xf30, 0x0ce, 0x17c, 0xe82, 0x50b, 0xaf5,
+    0x65a, 0x9a4, 0x22d, 0xdd3, 0xc61, 0x39f, 0x816, 0x7e8,
+    0xdc8, 0x236, 0x9bf, 0x641, 0x7f3, 0x80d, 0x384, 0xc7a,
+    0x0d5, 0xf2b, 0x4a2, 0xb5c, 0xaee, 0x510, 0xe99, 0x167}};
+
+// lower 12 bits of estimated error vector for each syndrome
+unsigned short int golay2412_dec_gentab[4096] = {
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0xa20,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x081,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x002,
+    0x000, 0x000, 0x000, 0x004, 0x000, 0x510, 0x048, 0x000,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x10c,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x002,
+    0x000, 0x000, 0x000, 0x400, 0x000, 0x041, 0x090, 0x000,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x002,
+    0x000, 0x000, 0x000, 0x070, 0x000, 0x800, 0x600, 0x000,
+    0x000, 0x000, 0x000, 0x002, 0x000, 0x002, 0x002, 0x002,
+    0x000, 0x288, 0x901, 0x000, 0x024, 0x000, 0x000, 0x002,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x010,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x101,
+    0x000, 0x000, 0x000, 0x400, 0x000, 0x086, 0x048, 0x000,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x424,
+    0x000, 0x000, 0x000, 0x302, 0x000, 0x800, 0x048, 0x000,
+    0x000, 0x000, 0x000, 0x890, 0x000, 0x200, 0x048, 0x000,
+    0x000, 0x021, 0x048, 0x000, 0x048, 0x000, 0x048, 0x048,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x2c0,
+    0x000, 0x000, 0x000, 0x400, 0x000, 0x800, 0x023, 0x000,
+    0x000, 0x000, 0x000, 0x400, 0x000, 0x038, 0x804, 0x000,
+    0x000, 0x400, 0x400, 0x400, 0x300, 0x000, 0x000, 0x400,
+    0x000, 0x000, 0x000, 0x009, 0x000, 0x800, 0x110, 0x000,
+    0x000, 0x800, 0x084, 0x000, 0x800, 0x800, 0x000, 0x800,
+    0x000, 0x144, 0x220, 0x000, 0x481, 0x000, 0x000, 0x002,
+    0x012, 0x000, 0x000, 0x400, 0x000, 0x800, 0x048, 0x000,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x081,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x054,
+    0x000, 0x000, 0x000, 0x400, 0x000, 0x008, 0x102, 0x000,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x081,
+    0x000, 0x000, 0x000, 0x081, 0x000, 0x081, 0x081, 0x081,
+    0x000, 0x000, 0x000, 0x128, 0x000, 0x200, 0xc00, 0x000,
+    0x000, 0x842, 0x210, 0x000, 0x024, 0x000, 0x000, 0x081,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x020,
+    0x000, 0x000, 0x000, 0x400, 0x000, 0x212, 0x840, 0x000,
+    0x000, 0x000, 0x000, 0x400, 0x000, 0x980, 0x209, 0x000,
+    0x000, 0x400, 0x400, 0x400, 0x024, 0x000, 0x000, 0x400,
+    0x000, 0x000, 0x000, 0xa04, 0x000, 0x448, 0x110, 0x000,
+    0x000, 0x100, 0x00a, 0x000, 0x024, 0x000, 0x000, 0x081,
+    0x000, 0x011, 0x0c0, 0x000, 0x024, 0x000, 0x000, 0x002,
+    0x024, 0x000, 0x000, 0x400, 0x024, 0x024, 0x024, 0x000,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x80a,
+    0x000, 0x000, 0x000, 0x400, 0x000, 0x160, 0x204, 0x000,
+    0x000, 0x000, 0x000, 0x400, 0x000, 0x200, 0x0a0, 0x000,
+    0x000, 0x400, 0x400, 0x400, 0x811, 0x000, 0x000, 0x400,
+    0x000, 0x000, 0x000, 0x040, 0x000, 0x200, 0x110, 0x000,
+    0x000, 0x01c, 0x820, 0x000, 0x402, 0x000, 0x000, 0x081,
+    0x000, 0x200, 0x007, 0x000, 0x200, 0x200, 0x000, 0x200,
+    0x180, 0x000, 0x000, 0x400, 0x000, 0x200, 0x048, 0x000,
+    0x000, 0x000, 0x000, 0x400, 0x000, 0x005, 0x110, 0x000,
+    0x000, 0x400, 0x400, 0x400, 0x088, 0x000, 0x000, 0x400,
+    0x000, 0x400, 0x400, 0x400, 0x042, 0x000, 0x000, 0x400,
+    0x400, 0x400, 0x400, 0x400, 0x000, 0x400, 0x400, 0x400,
+    0x000, 0x0a2, 0x110, 0x000, 0x110, 0x000, 0x110, 0x110,
+    0x241, 0x000, 0x000, 0x400, 0x000, 0x800, 0x110, 0x000,
+    0x808, 0x000, 0x000, 0x400, 0x000, 0x200, 0x110, 0x000,
+    0x000, 0x400, 0x400, 0x400, 0x024, 0x000, 0x000, 0x400,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x010,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x488,
+    0x000, 0x000, 0x000, 0x004, 0x000, 0x041, 0x102, 0x000,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x940,
+    0x000, 0x000, 0x000, 0x004, 0x000, 0x02a, 0x600, 0x000,
+    0x000, 0x000, 0x000, 0x004, 0x000, 0x200, 0x031, 0x000,
+    0x000, 0x004, 0x004, 0x004, 0x880, 0x000, 0x000, 0x004,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x020,
+    0x000, 0x000, 0x000, 0x882, 0x000, 0x041, 0x600, 0x000,
+    0x000, 0x000, 0x000, 0x310, 0x000, 0x041, 0x804, 0x000,
+    0x000, 0x041, 0x028, 0x000, 0x041, 0x041, 0x000, 0x041,
+    0x000, 0x000, 0x000, 0x009, 0x000, 0x094, 0x600, 0x000,
+    0x000, 0x100, 0x600, 0x000, 0x600, 0x000, 0x600, 0x600,
+    0x000, 0xc20, 0x0c0, 0x000, 0x108, 0x000, 0x000, 0x002,
+    0x012, 0x000, 0x000, 0x004, 0x000, 0x041, 0x600, 0x000,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x010,
+    0x000, 0x000, 0x000, 0x010, 0x000, 0x010, 0x010, 0x010,
+    0x000, 0x000, 0x000, 0x062, 0x000, 0x200, 0x804, 0x000,
+    0x000, 0x908, 0x281, 0x000, 0x420, 0x000, 0x000, 0x010,
+    0x000, 0x000, 0x000, 0x009, 0x000, 0x200, 0x082, 0x000,
+    0x000, 0x4c0, 0x820, 0x000, 0x105, 0x000, 0x000, 0x010,
+    0x000, 0x200, 0x500, 0x000, 0x200, 0x200, 0x000, 0x200,
+    0x012, 0x000, 0x000, 0x004, 0x000, 0x200, 0x048, 0x000,
+    0x000, 0x000, 0x000, 0x009, 0x000, 0x502, 0x804, 0x000,
+    0x000, 0x224, 0x140, 0x000, 0x088, 0x000, 0x000, 0x010,
+    0x000, 0x080, 0x804, 0x000, 0x804, 0x000, 0x804, 0x804,
+    0x012, 0x000, 0x000, 0x400, 0x000, 0x041, 0x804, 0x000,
+    0x000, 0x009, 0x009, 0x009, 0x060, 0x000, 0x000, 0x009,
+    0x012, 0x000, 0x000, 0x009, 0x000, 0x800, 0x600, 0x000,
+    0x012, 0x000, 0x000, 0x009, 0x000, 0x200, 0x804, 0x000,
+    0x012, 0x012, 0x012, 0x000, 0x012, 0x000, 0x000, 0x1a0,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x020,
+    0x000, 0x000, 0x000, 0x248, 0x000, 0xc04, 0x102, 0x000,
+    0x000, 0x000, 0x000, 0x801, 0x000, 0x200, 0x102, 0x000,
+    0x000, 0x0b0, 0x102, 0x000, 0x102, 0x000, 0x102, 0x102,
+    0x000, 0x000, 0x000, 0x412, 0x000, 0x200, 0x00c, 0x000,
+    0x000, 0x100, 0x820, 0x000, 0x050, 0x000, 0x000, 0x081,
+    0x000, 0x200, 0x0c0, 0x000, 0x200, 0x200, 0x000, 0x200,
+    0x409, 0x000, 0x000, 0x004, 0x000, 0x200, 0x102, 0x000,
+    0x000, 0x000, 0x000, 0x020, 0x000, 0x020, 0x020, 0x020,
+    0x000, 0x100, 0x015, 0x000, 0x088, 0x000, 0x000, 0x020,
+    0x000, 0x00e, 0x0c0, 0x000, 0x410, 0x000, 0x000, 0x020,
+    0xa00, 0x000, 0x000, 0x400, 0x000, 0x041, 0x102, 0x000,
+    0x000, 0x100, 0x0c0, 0x000, 0x803, 0x000, 0x000, 0x020,
+    0x100, 0x100, 0x000, 0x100, 0x000, 0x100, 0x600, 0x000,
+    0x0c0, 0x000, 0x0c0, 0x0c0, 0x000, 0x200, 0x0c0, 0x000,
+    0x000, 0x100, 0x0c0, 0x000, 0x024, 0x000, 0x000, 0x818,
+    0x000, 0x000, 0x000, 0x184, 0x000, 0x200, 0x441, 0x000,
+    0x000, 0x003, 0x820, 0x000, 0x088, 0x000, 0x000, 0x010,
+    0x000, 0x200, 0x018, 0x000, 0x200, 0x200, 0x000, 0x200,
+    0x044, 0x000, 0x000, 0x400, 0x000, 0x200, 0x102, 0x000,
+    0x000, 0x200, 0x820, 0x000, 0x200, 0x200, 0x000, 0x200,
+    0x820, 0x000, 0x820, 0x820, 0x000, 0x200, 0x820, 0x000,
+    0x200, 0x200, 0x000, 0x200, 0x200, 0x200, 0x200, 0x200,
+    0x000, 0x200, 0x820, 0x000, 0x200, 0x200, 0x000, 0x200,
+    0x000, 0x850, 0x202, 0x000, 0x088, 0x000, 0x000, 0x020,
+    0x088, 0x000, 0x000, 0x400, 0x088, 0x088, 0x088, 0x000,
+    0x121, 0x000, 0x000, 0x400, 0x000, 0x200, 0x804, 0x000,
+    0x000, 0x400, 0x400, 0x400, 0x088, 0x000, 0x000, 0x400,
+    0x404, 0x000, 0x000, 0x009, 0x000, 0x200, 0x110, 0x000,
+    0x000, 0x100, 0x820, 0x000, 0x088, 0x000, 0x000, 0x046,
+    0x000, 0x200, 0x0c0, 0x000, 0x200, 0x200, 0x000, 0x200,
+    0x012, 0x000, 0x000, 0x400, 0x000, 0x200, 0x001, 0x000,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x010,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x002,
+    0x000, 0x000, 0x000, 0x1c0, 0x000, 0x008, 0x405, 0x000,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x002,
+    0x000, 0x000, 0x000, 0xc08, 0x000, 0x244, 0x120, 0x000,
+    0x000, 0x000, 0x000, 0x002, 0x000, 0x002, 0x002, 0x002,
+    0x000, 0x021, 0x210, 0x000, 0x880, 0x000, 0x000, 0x002,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x002,
+    0x000, 0x000, 0x000, 0x201, 0x000, 0x4a0, 0x840, 0x000,
+    0x000, 0x000, 0x000, 0x002, 0x000, 0x002, 0x002, 0x002,
+    0x000, 0x814, 0x028, 0x000, 0x300, 0x000, 0x000, 0x002,
+    0x000, 0x000, 0x000, 0x002, 0x000, 0x002, 0x002, 0x002,
+    0x000, 0x100, 0x084, 0x000, 0x019, 0x000, 0x000, 0x002,
+    0x000, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002, 0x002,
+    0x440, 0x000, 0x000, 0x002, 0x000, 0x002, 0x002, 0x002,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x010,
+    0x000, 0x000, 0x000, 0x010, 0x000, 0x010, 0x010, 0x010,
+    0x000, 0x000, 0x000, 0x20c, 0x000, 0xc40, 0x0a0, 0x000,
+    0x000, 0x021, 0x802, 0x000, 0x300, 0x000, 0x000, 0x010,
+    0x000, 0x000, 0x000, 0x040, 0x000, 0x188, 0xa01, 0x000,
+    0x000, 0x021, 0x084, 0x000, 0x402, 0x000, 0x000, 0x010,
+    0x000, 0x021, 0x500, 0x000, 0x014, 0x000, 0x000, 0x002,
+    0x021, 0x021, 0x000, 0x021, 0x000, 0x021, 0x048, 0x000,
+    0x000, 0x000, 0x000, 0x920, 0x000, 0x005, 0x408, 0x000,
+    0x000, 0x04a, 0x084, 0x000, 0x300, 0x000, 0x000, 0x010,
+    0x000, 0x080, 0x051, 0x000, 0x300, 0x000, 0x000, 0x002,
+    0x300, 0x000, 0x000, 0x400, 0x300, 0x300, 0x300, 0x000,
+    0x000, 0x610, 0x084, 0x000, 0x060, 0x000, 0x000, 0x002,
+    0x084, 0x000, 0x084, 0x084, 0x000, 0x800, 0x084, 0x000,
+    0x808, 0x000, 0x000, 0x002, 0x000, 0x002, 0x002, 0x002,
+    0x000, 0x021, 0x084, 0x000, 0x300, 0x000, 0x000, 0x002,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x700,
+    0x000, 0x000, 0x000, 0x026, 0x000, 0x008, 0x840, 0x000,
+    0x000, 0x000, 0x000, 0x801, 0x000, 0x008, 0x0a0, 0x000,
+    0x000, 0x008, 0x210, 0x000, 0x008, 0x008, 0x000, 0x008,
+    0x000, 0x000, 0x000, 0x040, 0x000, 0x830, 0x00c, 0x000,
+    0x000, 0x100, 0x210, 0x000, 0x402, 0x000, 0x000, 0x081,
+    0x000, 0x484, 0x210, 0x000, 0x141, 0x000, 0x000, 0x002,
+    0x210, 0x000, 0x210, 0x210, 0x000, 0x008, 0x210, 0x000,
+    0x000, 0x000, 0x000, 0x098, 0x000, 0x005, 0x840, 0x000,
+    0x000, 0x100, 0x840, 0x000, 0x840, 0x000, 0x840, 0x840,
+    0x000, 0x260, 0x104, 0x000, 0x410, 0x000, 0x000, 0x002,
+    0x083, 0x000, 0x000, 0x400, 0x000, 0x008, 0x840, 0x000,
+    0x000, 0x100, 0x421, 0x000, 0x280, 0x000, 0x000, 0x002,
+    0x100, 0x100, 0x000, 0x100, 0x000, 0x100, 0x840, 0x000,
+    0x808, 0x000, 0x000, 0x002, 0x000, 0x002, 0x002, 0x002,
+    0x000, 0x100, 0x210, 0x000, 0x024, 0x000, 0x000, 0x002,
+    0x000, 0x000, 0x000, 0x040, 0x000, 0x005, 0x0a0, 0x000,
+    0x000, 0xa80, 0x109, 0x000, 0x402, 0x000, 0x000, 0x010,
+    0x000, 0x112, 0x0a0, 0x000, 0x0a0, 0x000, 0x0a0, 0x0a0,
+    0x044, 0x000, 0x000, 0x400, 0x000, 0x008, 0x0a0, 0x000,
+    0x000, 0x040, 0x040, 0x040, 0x402, 0x000, 0x000, 0x040,
+    0x402, 0x000, 0x000, 0x040, 0x402, 0x402, 0x402, 0x000,
+    0x808, 0x000, 0x000, 0x040, 0x000, 0x200, 0x0a0, 0x000,
+    0x000, 0x021, 0x210, 0x000, 0x402, 0x000, 0x000, 0x904,
+    0x000, 0x005, 0x202, 0x000, 0x005, 0x005, 0x000, 0x005,
+    0x030, 0x000, 0x000, 0x400, 0x000, 0x005, 0x840, 0x000,
+    0x808, 0x000, 0x000, 0x400, 0x000, 0x005, 0x0a0, 0x000,
+    0x000, 0x400, 0x400, 0x400, 0x300, 0x000, 0x000, 0x400,
+    0x808, 0x000, 0x000, 0x040, 0x000, 0x005, 0x110, 0x000,
+    0x000, 0x100, 0x084, 0x000, 0x402, 0x000, 0x000, 0x228,
+    0x808, 0x808, 0x808, 0x000, 0x808, 0x000, 0x000, 0x002,
+    0x808, 0x000, 0x000, 0x400, 0x000, 0x0d0, 0x001, 0x000,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x010,
+    0x000, 0x000, 0x000, 0x010, 0x000, 0x010, 0x010, 0x010,
+    0x000, 0x000, 0x000, 0x801, 0x000, 0x124, 0x240, 0x000,
+    0x000, 0x602, 0x028, 0x000, 0x880, 0x000, 0x000, 0x010,
+    0x000, 0x000, 0x000, 0x2a0, 0x000, 0x401, 0x00c, 0x000,
+    0x000, 0x100, 0x043, 0x000, 0x880, 0x000, 0x000, 0x010,
+    0x000, 0x058, 0x500, 0x000, 0x880, 0x000, 0x000, 0x002,
+    0x880, 0x000, 0x000, 0x004, 0x880, 0x880, 0x880, 0x000,
+    0x000, 0x000, 0x000, 0x444, 0x000, 0xa08, 0x181, 0x000,
+    0x000, 0x100, 0x028, 0x000, 0x006, 0x000, 0x000, 0x010,
+    0x000, 0x080, 0x028, 0x000, 0x410, 0x000, 0x000, 0x002,
+    0x028, 0x000, 0x028, 0x028, 0x000, 0x041, 0x028, 0x000,
+    0x000, 0x100, 0x810, 0x000, 0x060, 0x000, 0x000, 0x002,
+    0x100, 0x100, 0x000, 0x100, 0x000, 0x100, 0x600, 0x000,
+    0x205, 0x000, 0x000, 0x002, 0x000, 0x002, 0x002, 0x002,
+    0x000, 0x100, 0x028, 0x000, 0x880, 0x000, 0x000, 0x002,
+    0x000, 0x000, 0x000, 0x010, 0x000, 0x010, 0x010, 0x010,
+    0x000, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010, 0x010,
+    0x000, 0x080, 0x500, 0x000, 0x00b, 0x000, 0x000, 0x010,
+    0x044, 0x000, 0x000, 0x010, 0x000, 0x010, 0x010, 0x010,
+    0x000, 0x806, 0x500, 0x000, 0x060, 0x000, 0x000, 0x010,
+    0x208, 0x000, 0x000, 0x010, 0x000, 0x010, 0x010, 0x010,
+    0x500, 0x000, 0x500, 0x500, 0x000, 0x200, 0x500, 0x000,
+    0x000, 0x021, 0x500, 0x000, 0x880, 0x000, 0x000, 0x010,
+    0x000, 0x080, 0x202, 0x000, 0x060, 0x000, 0x000, 0x010,
+    0xc01, 0x000, 0x000, 0x010, 0x000, 0x010, 0x010, 0x010,
+    0x080, 0x080, 0x000, 0x080, 0x000, 0x080, 0x804, 0x000,
+    0x000, 0x080, 0x028, 0x000, 0x300, 0x000, 0x000, 0x010,
+    0x060, 0x000, 0x000, 0x009, 0x060, 0x060, 0x060, 0x000,
+    0x000, 0x100, 0x084, 0x000, 0x060, 0x000, 0x000, 0x010,
+    0x000, 0x080, 0x500, 0x000, 0x060, 0x000, 0x000, 0x002,
+    0x012, 0x000, 0x000, 0xa40, 0x000, 0x40c, 0x001, 0x000,
+    0x000, 0x000, 0x000, 0x801, 0x000, 0x0c2, 0x00c, 0x000,
+    0x000, 0x100, 0x480, 0x000, 0x221, 0x000, 0x000, 0x010,
+    0x000, 0x801, 0x801, 0x801, 0x410, 0x000, 0x000, 0x801,
+    0x044, 0x000, 0x000, 0x801, 0x000, 0x008, 0x102, 0x000,
+    0x000, 0x100, 0x00c, 0x000, 0x00c, 0x000, 0x00c, 0x00c,
+    0x100, 0x100, 0x000, 0x100, 0x000, 0x100, 0x00c, 0x000,
+    0x022, 0x000, 0x000, 0x801, 0x000, 0x200, 0x00c, 0x000,
+    0x000, 0x100, 0x210, 0x000, 0x880, 0x000, 0x000, 0x460,
+    0x000, 0x100, 0x202, 0x000, 0x410, 0x000, 0x000, 0x020,
+    0x100, 0x100, 0x000, 0x100, 0x000, 0x100, 0x840, 0x000,
+    0x410, 0x000, 0x000, 0x801, 0x410, 0x410, 0x410, 0x000,
+    0x000, 0x100, 0x028, 0x000, 0x410, 0x000, 0x000, 0x284,
+    0x100, 0x100, 0x000, 0x100, 0x000, 0x100, 0x00c, 0x000,
+    0x100, 0x100, 0x100, 0x100, 0x100, 0x100, 0x000, 0x100,
+    0x000, 0x100, 0x0c0, 0x000, 0x410, 0x000, 0x000, 0x002,
+    0x100, 0x100, 0x000, 0x100, 0x000, 0x100, 0x001, 0x000,
+    0x000, 0x428, 0x202, 0x000, 0x900, 0x000, 0x000, 0x010,
+    0x044, 0x000, 0x000, 0x010, 0x000, 0x010, 0x010, 0x010,
+    0x044, 0x000, 0x000, 0x801, 0x000, 0x200, 0x0a0, 0x000,
+    0x044, 0x044, 0x044, 0x000, 0x044, 0x000, 0x000, 0x010,
+    0x091, 0x000, 0x000, 0x040, 0x000, 0x200, 0x00c, 0x000,
+    0x000, 0x100, 0x820, 0x000, 0x402, 0x000, 0x000, 0x010,
+    0x000, 0x200, 0x500, 0x000, 0x200, 0x200, 0x000, 0x200,
+    0x044, 0x000, 0x000, 0x08a, 0x000, 0x200, 0x001, 0x000,
+    0x202, 0x000, 0x202, 0x202, 0x000, 0x005, 0x202, 0x000,
+    0x000, 0x100, 0x202, 0x000, 0x088, 0x000, 0x000, 0x010,
+    0x000, 0x080, 0x202, 0x000, 0x410, 0x000, 0x000, 0x148,
+    0x044, 0x000, 0x000, 0x400, 0x000, 0x822, 0x001, 0x000,
+    0x000, 0x100, 0x202, 0x000, 0x060, 0x000, 0x000, 0xc80,
+    0x100, 0x100, 0x000, 0x100, 0x000, 0x100, 0x001, 0x000,
+    0x808, 0x000, 0x000, 0x034, 0x000, 0x200, 0x001, 0x000,
+    0x000, 0x100, 0x001, 0x000, 0x001, 0x000, 0x001, 0x001,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x442,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x101,
+    0x000, 0x000, 0x000, 0x004, 0x000, 0x008, 0x090, 0x000,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x218,
+    0x000, 0x000, 0x000, 0x004, 0x000, 0x800, 0x120, 0x000,
+    0x000, 0x000, 0x000, 0x004, 0x000, 0x0e0, 0xc00, 0x000,
+    0x000, 0x004, 0x004, 0x004, 0x203, 0x000, 0x000, 0x004,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x020,
+    0x000, 0x000, 0x000, 0x201, 0x000, 0x800, 0x090, 0x000,
+    0x000, 0x000, 0x000, 0x848, 0x000, 0x604, 0x090, 0x000,
+    0x000, 0x122, 0x090, 0x000, 0x090, 0x000, 0x090, 0x090,
+    0x000, 0x000, 0x000, 0x580, 0x000, 0x800, 0x045, 0x000,
+    0x000, 0x800, 0x00a, 0x000, 0x800, 0x800, 0x000, 0x800,
+    0x000, 0x011, 0x220, 0x000, 0x108, 0x000, 0x000, 0x002,
+    0x440, 0x000, 0x000, 0x004, 0x000, 0x800, 0x090, 0x000,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x101,
+    0x000, 0x000, 0x000, 0x0a8, 0x000, 0x800, 0x204, 0x000,
+    0x000, 0x000, 0x000, 0x101, 0x000, 0x101, 0x101, 0x101,
+    0x000, 0x250, 0x802, 0x000, 0x420, 0x000, 0x000, 0x101,
+    0x000, 0x000, 0x000, 0x040, 0x000, 0x800, 0x082, 0x000,
+    0x000, 0x800, 0x411, 0x000, 0x800, 0x800, 0x000, 0x800,
+    0x000, 0x40a, 0x220, 0x000, 0x014, 0x000, 0x000, 0x101,
+    0x180, 0x000, 0x000, 0x004, 0x000, 0x800, 0x048, 0x000,
+    0x000, 0x000, 0x000, 0x016, 0x000, 0x800, 0x408, 0x000,
+    0x000, 0x800, 0x140, 0x000, 0x800, 0x800, 0x000, 0x800,
+    0x000, 0x080, 0x220, 0x000, 0x042, 0x000, 0x000, 0x101,
+    0x00d, 0x000, 0x000, 0x400, 0x000, 0x800, 0x090, 0x000,
+    0x000, 0x800, 0x220, 0x000, 0x800, 0x800, 0x000, 0x800,
+    0x800, 0x800, 0x000, 0x800, 0x800, 0x800, 0x800, 0x800,
+    0x220, 0x000, 0x220, 0x220, 0x000, 0x800, 0x220, 0x000,
+    0x000, 0x800, 0x220, 0x000, 0x800, 0x800, 0x000, 0x800,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x020,
+    0x000, 0x000, 0x000, 0x910, 0x000, 0x008, 0x204, 0x000,
+    0x000, 0x000, 0x000, 0x282, 0x000, 0x008, 0xc00, 0x000,
+    0x000, 0x008, 0x061, 0x000, 0x008, 0x008, 0x000, 0x008,
+    0x000, 0x000, 0x000, 0x040, 0x000, 0x106, 0xc00, 0x000,
+    0x000, 0x620, 0x00a, 0x000, 0x050, 0x000, 0x000, 0x081,
+    0x000, 0x011, 0xc00, 0x000, 0xc00, 0x000, 0xc00, 0xc00,
+    0x180, 0x000, 0x000, 0x004, 0x000, 0x008, 0xc00, 0x000,
+    0x000, 0x000, 0x000, 0x020, 0x000, 0x020, 0x020, 0x020,
+    0x000, 0x0c4, 0x00a, 0x000, 0x501, 0x000, 0x000, 0x020,
+    0x000, 0x011, 0x104, 0x000, 0x042, 0x000, 0x000, 0x020,
+    0xa00, 0x000, 0x000, 0x400, 0x000, 0x008, 0x090, 0x000,
+    0x000, 0x011, 0x00a, 0x000, 0x280, 0x000, 0x000, 0x020,
+    0x00a, 0x000, 0x00a, 0x00a, 0x000, 0x800, 0x00a, 0x000,
+    0x011, 0x011, 0x000, 0x011, 0x000, 0x011, 0xc00, 0x000,
+    0x000, 0x011, 0x00a, 0x000, 0x024, 0x000, 0x000, 0x340,
+    0x000, 0x000, 0x000, 0x040, 0x000, 0x490, 0x204, 0x000,
+    0x000, 0x003, 0x204, 0x000, 0x204, 0x000, 0x204, 0x204,
+    0x000, 0x824, 0x018, 0x000, 0x042, 0x000, 0x000, 0x101,
+    0x180, 0x000, 0x000, 0x400, 0x000, 0x008, 0x204, 0x000,
+    0x000, 0x040, 0x040, 0x040, 0x029, 0x000, 0x000, 0x040,
+    0x180, 0x000, 0x000, 0x040, 0x000, 0x800, 0x204, 0x000,
+    0x180, 0x000, 0x000, 0x040, 0x000, 0x200, 0xc00, 0x000,
+    0x180, 0x180, 0x180, 0x000, 0x180, 0x000, 0x000, 0x032,
+    0x000, 0x308, 0x881, 0x000, 0x042, 0x000, 0x000, 0x020,
+    0x030, 0x000, 0x000, 0x400, 0x000, 0x800, 0x204, 0x000,
+    0x042, 0x000, 0x000, 0x400, 0x042, 0x042, 0x042, 0x000,
+    0x000, 0x400, 0x400, 0x400, 0x042, 0x000, 0x000, 0x400,
+    0x404, 0x000, 0x000, 0x040, 0x000, 0x800, 0x110, 0x000,
+    0x000, 0x800, 0x00a, 0x000, 0x800, 0x800, 0x000, 0x800,
+    0x000, 0x011, 0x220, 0x000, 0x042, 0x000, 0x000, 0x08c,
+    0x180, 0x000, 0x000, 0x400, 0x000, 0x800, 0x001, 0x000,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x020,
+    0x000, 0x000, 0x000, 0x004, 0x000, 0x380, 0x809, 0x000,
+    0x000, 0x000, 0x000, 0x004, 0x000, 0x812, 0x240, 0x000,
+    0x000, 0x004, 0x004, 0x004, 0x420, 0x000, 0x000, 0x004,
+    0x000, 0x000, 0x000, 0x004, 0x000, 0x401, 0x082, 0x000,
+    0x000, 0x004, 0x004, 0x004, 0x050, 0x000, 0x000, 0x004,
+    0x000, 0x004, 0x004, 0x004, 0x108, 0x000, 0x000, 0x004,
+    0x004, 0x004, 0x004, 0x004, 0x000, 0x004, 0x004, 0x004,
+    0x000, 0x000, 0x000, 0x020, 0x000, 0x020, 0x020, 0x020,
+    0x000, 0x418, 0x140, 0x000, 0x006, 0x000, 0x000, 0x020,
+    0x000, 0x080, 0x403, 0x000, 0x108, 0x000, 0x000, 0x020,
+    0xa00, 0x000, 0x000, 0x004, 0x000, 0x041, 0x090, 0x000,
+    0x000, 0x242, 0x810, 0x000, 0x108, 0x000, 0x000, 0x020,
+    0x0a1, 0x000, 0x000, 0x004, 0x000, 0x800, 0x600, 0x000,
+    0x108, 0x000, 0x000, 0x004, 0x108, 0x108, 0x108, 0x000,
+    0x000, 0x004, 0x004, 0x004, 0x108, 0x000, 0x000, 0x004,
+    0x000, 0x000, 0x000, 0xe00, 0x000, 0x04c, 0x082, 0x000,
+    0x000, 0x003, 0x140, 0x000, 0x420, 0x000, 0x000, 0x010,
+    0x000, 0x080, 0x018, 0x000, 0x420, 0x000, 0x000, 0x101,
+    0x420, 0x000, 0x000, 0x004, 0x420, 0x420, 0x420, 0x000,
+    0x000, 0x130, 0x082, 0x000, 0x082, 0x000, 0x082, 0x082,
+    0x208, 0x000, 0x000, 0x004, 0x000, 0x800, 0x082, 0x000,
+    0x841, 0x000, 0x000, 0x004, 0x000, 0x200, 0x082, 0x000,
+    0x000, 0x004, 0x004, 0x004, 0x420, 0x000, 0x000, 0x004,
+    0x000, 0x080, 0x140, 0x000, 0x211, 0x000, 0x000, 0x020,
+    0x140, 0x000, 0x140, 0x140, 0x000, 0x800, 0x140, 0x000,
+    0x080, 0x080, 0x000, 0x080, 0x000, 0x080, 0x804, 0x000,
+    0x000, 0x080, 0x140, 0x000, 0x420, 0x000, 0x000, 0x20a,
+    0x404, 0x000, 0x000, 0x009, 0x000, 0x800, 0x082, 0x000,
+    0x000, 0x800, 0x140, 0x000, 0x800, 0x800, 0x000, 0x800,
+    0x000, 0x080, 0x220, 0x000, 0x108, 0x000, 0x000, 0x450,
+    0x012, 0x000, 0x000, 0x004, 0x000, 0x800, 0x001, 0x000,
+    0x000, 0x000, 0x000, 0x020, 0x000, 0x020, 0x020, 0x020,
+    0x000, 0x003, 0x480, 0x000, 0x050, 0x000, 0x000, 0x020,
+    0x000, 0x540, 0x018, 0x000, 0x085, 0x000, 0x000, 0x020,
+    0xa00, 0x000, 0x000, 0x004, 0x000, 0x008, 0x102, 0x000,
+    0x000, 0x888, 0x301, 0x000, 0x050, 0x000, 0x000, 0x020,
+    0x050, 0x000, 0x000, 0x004, 0x050, 0x050, 0x050, 0x000,
+    0x022, 0x000, 0x000, 0x004, 0x000, 0x200, 0xc00, 0x000,
+    0x000, 0x004, 0x004, 0x004, 0x050, 0x000, 0x000, 0x004,
+    0x000, 0x020, 0x020, 0x020, 0x020, 0x020, 0x020, 0x020,
+    0xa00, 0x000, 0x000, 0x020, 0x000, 0x020, 0x020, 0x020,
+    0xa00, 0x000, 0x000, 0x020, 0x000, 0x020, 0x020, 0x020,
+    0xa00, 0xa00, 0xa00, 0x000, 0xa00, 0x000, 0x000, 0x020,
+    0x404, 0x000, 0x000, 0x020, 0x000, 0x020, 0x020, 0x020,
+    0x000, 0x100, 0x00a, 0x000, 0x050, 0x000, 0x000, 0x020,
+    0x000, 0x011, 0x0c0, 0x000, 0x108, 0x000, 0x000, 0x020,
+    0xa00, 0x000, 0x000, 0x004, 0x000, 0x482, 0x001, 0x000,
+    0x000, 0x003, 0x018, 0x000, 0x900, 0x000, 0x000, 0x020,
+    0x003, 0x003, 0x000, 0x003, 0x000, 0x003, 0x204, 0x000,
+    0x018, 0x000, 0x018, 0x018, 0x000, 0x200, 0x018, 0x000,
+    0x000, 0x003, 0x018, 0x000, 0x420, 0x000, 0x000, 0x8c0,
+    0x404, 0x000, 0x000, 0x040, 0x000, 0x200, 0x082, 0x000,
+    0x000, 0x003, 0x820, 0x000, 0x050, 0x000, 0x000, 0x508,
+    0x000, 0x200, 0x018, 0x000, 0x200, 0x200, 0x000, 0x200,
+    0x180, 0x000, 0x000, 0x004, 0x000, 0x200, 0x001, 0x000,
+    0x404, 0x000, 0x000, 0x020, 0x000, 0x020, 0x020, 0x020,
+    0x000, 0x003, 0x140, 0x000, 0x088, 0x000, 0x000, 0x020,
+    0x000, 0x080, 0x018, 0x000, 0x042, 0x000, 0x000, 0x020,
+    0xa00, 0x000, 0x000, 0x400, 0x000, 0x114, 0x001, 0x000,
+    0x404, 0x404, 0x404, 0x000, 0x404, 0x000, 0x000, 0x020,
+    0x404, 0x000, 0x000, 0x290, 0x000, 0x800, 0x001, 0x000,
+    0x404, 0x000, 0x000, 0x902, 0x000, 0x200, 0x001, 0x000,
+    0x000, 0x068, 0x001, 0x000, 0x001, 0x000, 0x001, 0x001,
+    0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x000, 0x884,
+    0x000, 0x000, 0x000, 0x201, 0x000, 0x008, 0x120, 0x000,
+    0x000, 0x000, 0x000, 0x430, 0x000, 0x008, 0x240, 0x000,
+    0x000, 0x008, 0x802, 0x000, 0x008, 0x008, 0x000, 0x008,
+    0x000, 0x000, 0x000, 0x040, 0x000, 0x401, 0x120, 0x000,
+    0x000, 0x092, 0x120, 0x000, 0x120, 0x000, 0x120, 0x120,
+    0x000, 0xb00, 0x089, 0x000, 0x014, 0x000, 0x000, 0x002,
+    0x440, 0x000, 0x000, 0x004, 0x000, 0x008, 0x120, 0x000,
+    0x000, 0x000, 0x000, 0x201, 0x000, 0x150, 0x408, 0x000,
+    0x000, 0x201, 0x201, 0x201, 0x006, 0x000, 0x000, 0x201,
+    0x000, 0x080, 0x104, 0x000, 0x821, 0x000, 0x000, 0x002,
+    0x440, 0x000, 0x000, 0x201, 0x000, 0x008, 0x090, 0x000,
+    0x000, 0x02c, 0x810, 0x000, 0x280, 0x000, 0x000, 0x002,
+    0x440, 0x000, 0x000, 0x201, 0x000, 0x800, 0x120, 0x000,
+    0x440, 0x000, 0x000, 0x002, 0x000, 0x002, 0x002, 0x002,
+    0x440, 0x440, 0x440, 0x000, 0x440, 0x000, 0x000, 0x002,
+    0x000, 0x000, 0x000, 0x040, 0x000, 0x222, 0x408, 0x000,
+    0x000, 0x504, 0x802, 0x000, 0x0c1, 0x000, 0x000, 0x010,
+    0x000, 0x080, 0x802, 0x000, 0x014, 0x000, 0x000, 0x101,
+    0x802, 0x000, 0x802, 0x802, 0x000, 0x008, 0x802, 0x000,
+    0x000, 0x040, 0x040, 0x040, 0x014, 0x000, 0x000, 0x040,
+    0x208, 0x000, 0x000, 0x040, 0x000, 0x800, 0x120, 0x000,
+    0x014, 0x000, 0x000, 0x040, 0x014, 0x014, 0x014, 0x000,
+    0x000, 0x021, 0x802, 0x000, 0x014, 0x000, 0x000, 0x680,
+    0x000, 0x080, 0x408, 0x000, 0x408, 0x000, 0x408, 0x408,
+    0x030, 0x000, 0x000, 0x201, 0x000, 0x800, 0x408, 0x000,
+    0x080, 0x080, 0x000, 0x080, 0x000, 0x080, 0x408, 0x000,
+    0x000, 0x080, 0x802, 0x000, 0x300, 0x000, 0x000, 0x064,
+    0x103, 0x000, 0x000, 0x040, 0x000, 0x800, 0x408, 0x000,
+    0x000, 0x800, 0x084, 0x000, 0x800, 0x800, 0x000, 0x800,
+    0x000, 0x080, 0x220, 0x000, 0x014, 0x000, 0x000, 0x002,
+    0x440, 0x000, 0x000, 0x118, 0x000, 0x800, 0x001, 0x000,
+    0x000, 0x000, 0x000, 0x040, 0x000, 0x008, 0x013, 0x000,
+    0x000, 0x008, 0x480, 0x000, 0x008, 0x008, 0x000, 0x008,
+    0x000, 0x008, 0x104, 0x000, 0x008, 0x008, 0x000, 0x008,
+    0x008, 0x008, 0x000, 0x008, 0x008, 0x008, 0x008, 0x008,
+    0x000, 0x040, 0x040, 0x040, 0x280, 0x000, 0x000, 0x040,
+    0x805, 0x000, 0x000, 0x040, 0x000, 0x008, 0x120, 0x000,
+    0x022, 0x000, 0x000, 0x040, 0x000, 0x008, 0xc00, 0x000,
+    0x000, 0x008, 0x210, 0x000, 0x008, 0x008, 0x000, 0x008,
+    0x000, 0xc02, 0x104, 0x000, 0x280, 0x000, 0x000, 0x020,
+    0x030, 0x000, 0x000, 0x201, 0x000, 0x008, 0x840, 0x000,
+    0x104, 0x000, 0x104, 0x104, 0x000, 0x008, 0x104, 0x000,
+    0x000, 0x008, 0x104, 0x000, 0x008, 0x008, 0x000, 0x008,
+    0x280, 0x000, 0x000, 0x040, 0x280, 0x280, 0x280, 0x000,
+    0x000, 0x100, 0x00a, 0x000, 0x280, 0x000, 0x000, 0x414,
+    0x000, 0x011, 0x104, 0x000, 0x280, 0x000, 0x000, 0x002,
+    0x440, 0x000, 0x000, 0x8a0, 0x000, 0x008, 0x001, 0x000,
+    0x000, 0x040, 0x040, 0x040, 0x900, 0x000, 0x000, 0x040,
+    0x030, 0x000, 0x000, 0x040, 0x000, 0x008, 0x204, 0x000,
+    0x601, 0x000, 0x000, 0x040, 0x000, 0x008, 0x0a0, 0x000,
+    0x000, 0x008, 0x802, 0x000, 0x008, 0x008, 0x000, 0x008,
+    0x040, 0x040, 0x040, 0x040, 0x000, 0x040, 0x040, 0x040,
+    0x000, 0x040, 0x040, 0x040, 0x402, 0x000, 0x000, 0x040,
+    0x000, 0x040, 0x040, 0x040, 0x014, 0x000, 0x000, 0x040,
+    0x180, 0x000, 0x000, 0x040, 0x000, 0x008, 0x001, 0x000,
+    0x030, 0x000, 0x000, 0x040, 0x000, 0x005, 0x408, 0x000,
+    0x030, 0x030, 0x030, 0x000, 0x030, 0x000, 0x000, 0x182,
+    0x000, 0x080, 0x104, 0x000, 0x042, 0x000, 0x000, 0xa10,
+    0x030, 0x000, 0x000, 0x400, 0x000, 0x008, 0x001, 0x000,
+    0x000, 0x040, 0x040, 0x040, 0x280, 0x000, 0x000, 0x040,
+    0x030, 0x000, 0x000, 0x040, 0x000, 0x800, 0x001, 0x000,
+    0x808, 0x000, 0x000, 0x040, 0x000, 0x520, 0x001, 0x000,
+    0x000, 0x206, 0x001, 0x000, 0x001, 0x000, 0x001, 0x001,
+    0x000, 0x000, 0x000, 0x10a, 0x000, 0x401, 0x240, 0x000,
+    0x000, 0x860, 0x480, 0x000, 0x006, 0x000, 0x000, 0x010,
+    0x000, 0x080, 0x240, 0x000, 0x240, 0x000, 0x240, 0x240,
+    0x111, 0x000, 0x000, 0x004, 0x000, 0x008, 0x240, 0x000,
+    0x000, 0x401, 0x810, 0x000, 0x401, 0x401, 0x000, 0x401,
+    0x208, 0x000, 0x000, 0x004, 0x000, 0x401, 0x120, 0x000,
+    0x022, 0x000, 0x000, 0x004, 0x000, 0x401, 0x240, 0x000,
+    0x000, 0x004, 0x004, 0x004, 0x880, 0x000, 0x000, 0x004,
+    0x000, 0x080, 0x810, 0x000, 0x006, 0x000, 0x000, 0x020,
+    0x006, 0x000, 0x000, 0x201, 0x006, 0x006, 0x006, 0x000,
+    0x080, 0x080, 0x000, 0x080, 0x000, 0x080, 0x240, 0x000,
+    0x000, 0x080, 0x028, 0x000, 0x006, 0x000, 0x000, 0xd00,
+    0x810, 0x000, 0x810, 0x810, 0x000, 0x401, 0x810, 0x000,
+    0x000, 0x100, 0x810, 0x000, 0x006, 0x000, 0x000, 0x0c8,
+    0x000, 0x080, 0x810, 0x000, 0x108, 0x000, 0x000, 0x002,
+    0x440, 0x000, 0x000, 0x004, 0x000, 0x230, 0x001, 0x000,
+    0x000, 0x080, 0x025, 0x000, 0x900, 0x000, 0x000, 0x010,
+    0x208, 0x000, 0x000, 0x010, 0x000, 0x010, 0x010, 0x010,
+    0x080, 0x080, 0x000, 0x080, 0x000, 0x080, 0x240, 0x000,
+    0x000, 0x080, 0x802, 0x000, 0x420, 0x000, 0x000, 0x010,
+    0x208, 0x000, 0x000, 0x040, 0x000, 0x401, 0x082, 0x000,
+    0x208, 0x208, 0x208, 0x000, 0x208, 0x000, 0x000, 0x010,
+    0x000, 0x080, 0x500, 0x000, 0x014, 0x000, 0x000, 0x828,
+    0x208, 0x000, 0x000, 0x004, 0x000, 0x142, 0x001, 0x000,
+    0x080, 0x080, 0x000, 0x080, 0x000, 0x080, 0x408, 0x000,
+    0x000, 0x080, 0x140, 0x000, 0x006, 0x000, 0x000, 0x010,
+    0x080, 0x080, 0x080, 0x080, 0x080, 0x080, 0x000, 0x080,
+    0x080, 0x080, 0x000, 0x080, 0x000, 0x080, 0x001, 0x000,
+    0x000, 0x080, 0x810, 0x000, 0x060, 0x000, 0x000, 0x304,
+    0x208, 0x000, 0x000, 0x422, 0x000, 0x800, 0x001, 0x000,
+    0x080, 0x080, 0x000, 0x080, 0x000, 0x080, 0x001, 0x000,
+    0x000, 0x080, 0x001, 0x000, 0x001, 0x000, 0x001, 0x001,
+    0x000, 0x214, 0x480, 0x000, 0x900, 0x000, 0x000, 0x020,
+    0x480, 0x000, 0x480, 0x480, 0x000, 0x008, 0x480, 0x000,
+    0x022, 0x000, 0x000, 0x801, 0x000, 0x008, 0x240, 0x000,
+    0x000, 0x008, 0x480, 0x000, 0x008, 0x008, 0x000, 0x008,
+    0x022, 0x000, 0x000, 0x040, 0x000, 0x401, 0x00c, 0x000,
+    0x000, 0x100, 0x480, 0x000, 0x050, 0x000, 0x000, 0xa02,
+    0x022, 0x022, 0x022, 0x000, 0x022, 0x000, 0x000, 0x190,
+    0x022, 0x000, 0x000, 0x004, 0x000, 0x008, 0x001, 0x000,
+    0x049, 0x000, 0x000, 0x020, 0x000, 0x020, 0x020, 0x020,
+    0x000, 0x100, 0x480, 0x000, 0x006, 0x000, 0x000, 0x020,
+    0x000, 0x080, 0x104, 0x000, 0x410, 0x000, 0x000, 0x020,
+    0xa00, 0x000, 0x000, 0x052, 0x000, 0x008, 0x001, 0x000,
+    0x000, 0x100, 0x810, 0x000, 0x280, 0x000, 0x000, 0x020,
+    0x100, 0x100, 0x000, 0x100, 0x000, 0x100, 0x001, 0x000,
+    0x022, 0x000, 0x000, 0x608, 0x000, 0x844, 0x001, 0x000,
+    0x000, 0x100, 0x001, 0x000, 0x001, 0x000, 0x001, 0x001,
+    0x900, 0x000, 0x000, 0x040, 0x900, 0x900, 0x900, 0x000,
+    0x000, 0x003, 0x480, 0x000, 0x900, 0x000, 0x000, 0x010,
+    0x000, 0x080, 0x018, 0x000, 0x900, 0x000, 0x000, 0x406,
+    0x044, 0x000, 0x000, 0x320, 0x000, 0x008, 0x001, 0x000,
+    0x000, 0x040, 0x040, 0x040, 0x900, 0x000, 0x000, 0x040,
+    0x208, 0x000, 0x000, 0x040, 0x000, 0x0a4, 0x001, 0x000,
+    0x022, 0x000, 0x000, 0x040, 0x000, 0x200, 0x001, 0x000,
+    0x000, 0xc10, 0x001, 0x000, 0x001, 0x000, 0x001, 0x001,
+    0x000, 0x080, 0x202, 0x000, 0x900, 0x000, 0x000, 0x020,
+    0x030, 0x000, 0x000, 0x80c, 0x000, 0x640, 0x001, 0x000,
+    0x080, 0x080, 0x000, 0x080, 0x000, 0x080, 0x001, 0x000,
+    0x000, 0x080, 0x001, 0x000, 0x001, 0x000, 0x001, 0x001,
+    0x404, 0x000, 0x000, 0x040, 0x000, 0x01a, 0x001, 0x000,
+    0x000, 0x100, 0x001, 0x000, 0x001, 0x000, 0x001, 0x001,
+    0x000, 0x080, 0x001, 0x000, 0x001, 0x000, 0x001, 0x001,
+    0x001, 0x000, 0x001, 0x001, 0x001, 0x001, 0x001, 0x001};
@@ -33,12 +33,21 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 
 #include "liquid.internal.h"
 
+#if HAVE_SSE41 && HAVE_SMMINTRIN_H
+#include <smmintrin.h>
+#define FEC_HAMMING128_USE_SSE41 1
+#else
+#define FEC_HAMMING128_USE_SSE41 0
+#endif
+
 #define DEBUG_FEC_HAMMING128        0   // debugging flag
 #define FEC_HAMMING128_ENC_GENTAB   1   // use look-up table for encoding?
+#define FEC_HAMMING128_DEC_GENTAB   1   // use look-up table for decoding?
 
 // parity bit coverage mask for encoder (collapsed version of figure
 // above, stripping out parity bits P1, P2, P4, P8 and only including
@@ -140,6 +149,60 @@ unsigned int fec_hamming128_decode_symbol(unsigned int _sym_enc)
     return sym_dec;
 }
 
+#if FEC_HAMMING128_USE_SSE41
+// soft decoding of one symbol using nearest neighbors (same result as
+// fecsoft_hamming128_decode_n3); the hard-decision estimate and its 17
+// neighbors each occupy one 16-bit lane across three registers, and
+// soft bit b contributes b ^ 0x00ff = 255-b to lanes whose codeword
+// has that bit set, and b otherwise; reads sixteen soft bits, the last
+// four of which are ignored
+static unsigned int hamming128_decode_soft_n3_sse41(unsigned char * _soft_bits)
+{
+    __m128i x = _mm_loadu_si128((__m128i*)_soft_bits);
+
+    // hard decision: reverse order so soft bit i lands in bit 11-i
+    __m128i rev = _mm_shuffle_epi8(x, _mm_set_epi8(-1,-1,-1,-1,0,1,2,3,4,5,6,7,8,9,10,11));
+    unsigned int c = _mm_movemask_epi8(rev);
+    unsigned int s_hat = hamming128_dec_gentab[c];
+
+    // candidate codewords: estimate followed by its nearest neighbors
+    unsigned char *      n = fecsoft_hamming128_n3[s_hat];
+    unsigned short int * e = hamming128_enc_gentab;
+    __m128i c0 = _mm_setr_epi16(e[s_hat],e[n[ 0]],e[n[ 1]],e[n[ 2]],e[n[ 3]],e[n[ 4]],e[n[ 5]],e[n[ 6]]);
+    __m128i c1 = _mm_setr_epi16(e[n[ 7]],e[n[ 8]],e[n[ 9]],e[n[10]],e[n[11]],e[n[12]],e[n[13]],e[n[14]]);
+    __m128i c2 = _mm_setr_epi16(e[n[15]],e[n[16]],0,0,0,0,0,0);
+
+    // accumulate distance metric for each candidate
+    __m128i r0 = _mm_cvtepu8_epi16(x);
+    __m128i r1 = _mm_cvtepu8_epi16(_mm_srli_si128(x,8));
+    __m128i d0 = _mm_setzero_si128();
+    __m128i d1 = _mm_setzero_si128();
+    __m128i d2 = _mm_setzero_si128();
+    unsigned int i;
+    for (i=0; i<12; i++) {
+        // broadcast soft bit i to all lanes
+        __m128i ri = _mm_shuffle_epi8(i < 8 ? r0 : r1, _mm_set1_epi16(0x0100 + 0x0202*(i%8)));
+        __m128i b  = _mm_set1_epi16(0x0800 >> i);
+        d0 = _mm_add_epi16(d0, _mm_xor_si128(ri, _mm_srli_epi16(_mm_cmpeq_epi16(_mm_and_si128(c0,b),b),8)));
+        d1 = _mm_add_epi16(d1, _mm_xor_si128(ri, _mm_srli_epi16(_mm_cmpeq_epi16(_mm_and_si128(c1,b),b),8)));
+        d2 = _mm_add_epi16(d2, _mm_xor_si128(ri, _mm_srli_epi16(_mm_cmpeq_epi16(_mm_and_si128(c2,b),b),8)));
+    }
+    // exclude unused lanes
+    d2 = _mm_or_si128(d2, _mm_setr_epi16(0,0,-1,-1,-1,-1,-1,-1));
+
+    // find minimum in candidate order; earliest candidate wins ties
+    unsigned int v0 = _mm_cvtsi128_si32(_mm_minpos_epu16(d0));
+    unsigned int v1 = _mm_cvtsi128_si32(_mm_minpos_epu16(d1));
+    unsigned int v2 = _mm_cvtsi128_si32(_mm_minpos_epu16(d2));
+    unsigned int dmin  = v0 & 0xffff;
+    unsigned int index = (v0 >> 16) & 7;
+    if ((v1 & 0xffff) < dmin) { dmin = v1 & 0xffff; index =  8 + ((v1 >> 16) & 7); }
+    if ((v2 & 0xffff) < dmin) { dmin = v2 & 0xffff; index = 16 + ((v2 >> 16) & 7); }
+
+    return index == 0 ? s_hat : n[index-1];
+}
+#endif
+
 // create Hamming(12,8) codec object
 fec fec_hamming128_create(void * _opts)
 {
@@ -257,8 +320,13 @@ int fec_hamming128_decode(fec             _q,
         m1 = ((r1 << 8) & 0x0f00) | ((r2     ) & 0x00ff);
 
         // decode each symbol into an 8-bit byte
+#if FEC_HAMMING128_DEC_GENTAB
+        _msg_dec[i+0] = hamming128_dec_gentab[m0];
+        _msg_dec[i+1] = hamming128_dec_gentab[m1];
+#else
         _msg_dec[i+0] = fec_hamming128_decode_symbol(m0);
         _msg_dec[i+1] = fec_hamming128_decode_symbol(m1);
+#endif
 
         j += 3;
     }
@@ -274,7 +342,11 @@ int fec_hamming128_decode(fec             _q,
         m0 = ((r0 << 4) & 0x0ff0) | ((r1 >> 4) & 0x000f);
 
         // decode symbol into an 8-bit byte
+#if FEC_HAMMING128_DEC_GENTAB
+        _msg_dec[i++] = hamming128_dec_gentab[m0];
+#else
         _msg_dec[i++] = fec_hamming128_decode_symbol(m0);
+#endif
 
         j += 2;
     }
@@ -312,6 +384,16 @@ int fec_hamming128_decode_soft(fec             _q,
         // use true ML soft decoding: about 1.45 dB improvement in Eb/N_0 for a BER of 10^-5
         // with a decoding complexity of 1.43M cycles/trial (64-byte block)
         s = fecsoft_hamming128_decode(&_msg_enc[k]);
+#elif FEC_HAMMING128_USE_SSE41
+        // n-3 nearest neighbors, computing all distances in parallel
+        if (k + 16 <= 8*enc_msg_len) {
+            s = hamming128_decode_soft_n3_sse41(&_msg_enc[k]);
+        } else {
+            // copy last symbol to avoid reading past end of input
+            unsigned char buf[16] = {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0};
+            memmove(buf, &_msg_enc[k], 12*sizeof(unsigned char));
+            s = hamming128_decode_soft_n3_sse41(buf);
+        }
 #else
         // use n-3 nearest neighbors: about 0.54 dB improvement in Eb/N_0 for a BER of 10^-5
         // with a decoding complexity of 124k cycles/trial (64-byte block)
@@ -401,7 +483,11 @@ unsigned int fecsoft_hamming128_decode_n3(unsigned char * _soft_bits)
     c |= (_soft_bits[11] > 127) ? 0x0001 : 0;
 
     // decode symbol
+#if FEC_HAMMING128_DEC_GENTAB
+    s_hat = hamming128_dec_gentab[c];
+#else
     s_hat = fec_hamming128_decode_symbol(c);
+#endif
 
     // re-encode and compute distance
 #if FEC_HAMMING128_ENC_GENTAB
@@ -427,12 +513,14 @@ unsigned int fecsoft_hamming128_decode_n3(unsigned char * _soft_bits)
 
     dmin = d;
 
-    // search over 17 nearest neighbors
+    // search over 17 nearest neighbors of hard-decoded symbol (retain
+    // its row; s_hat is updated as better candidates are found)
+    unsigned char * n3 = fecsoft_hamming128_n3[s_hat];
     unsigned int s;
     unsigned int i;
     for (i=0; i<17; i++) {
         // use look-up table for nearest neighbors
-        s = fecsoft_hamming128_n3[s_hat][i];
+        s = n3[i];
 
         // encode symbol
 #if FEC_HAMMING128_ENC_GENTAB
@@ -30,6 +30,12 @@
 //
 // (31,26) Hamming code
 //
+// These symbol routines back no fec scheme and so have no block path;
+// unlike the other block codes they are left without look-up tables.
+// Each parity and syndrome bit is already a single masked popcount over
+// the whole symbol (liquid_bdotprod_uint32), so per-byte tables would only
+// save a few operations per symbol.
+//
 // parity bit coverage mask for encoder (collapsed version of figure
 // above, stripping out parity bits P1, P2, P4, P8, P16 and only including
 // data bits 1:26)
@@ -26,10 +26,18 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 
 #include "liquid.internal.h"
 
+#if HAVE_SSE41 && HAVE_SMMINTRIN_H
+#include <smmintrin.h>
+#define FEC_HAMMING74_USE_SSE41 1
+#else
+#define FEC_HAMMING74_USE_SSE41 0
+#endif
+
 // encoder look-up table
 unsigned char hamming74_enc_gentab[16] = {
     0x00, 0x69, 0x2a, 0x43, 0x4c, 0x25, 0x66, 0x0f,
@@ -54,6 +62,50 @@ unsigned char hamming74_dec_gentab[128] = {
     0x08, 0x08, 0x08, 0x0b, 0x08, 0x0d, 0x06, 0x0f,
     0x08, 0x01, 0x0a, 0x0f, 0x0c, 0x0f, 0x0f, 0x0f};
 
+#if FEC_HAMMING74_USE_SSE41
+// Soft decoding compares the received soft bits against all 16
+// codewords at once: each codeword occupies one 16-bit lane across two
+// registers, and soft bit b contributes b ^ 0x00ff = 255-b to lanes
+// whose codeword has that bit set, and b otherwise.
+
+// compute per-bit lane masks for all codewords [size: 14 x 1]
+static void hamming74_soft_mask_sse41(__m128i * _mask)
+{
+    __m128i c0 = _mm_cvtepu8_epi16(_mm_loadl_epi64((__m128i*)&hamming74_enc_gentab[0]));
+    __m128i c1 = _mm_cvtepu8_epi16(_mm_loadl_epi64((__m128i*)&hamming74_enc_gentab[8]));
+    unsigned int i;
+    for (i=0; i<7; i++) {
+        __m128i b = _mm_set1_epi16(0x40 >> i);
+        _mask[2*i+0] = _mm_srli_epi16(_mm_cmpeq_epi16(_mm_and_si128(c0,b),b), 8);
+        _mask[2*i+1] = _mm_srli_epi16(_mm_cmpeq_epi16(_mm_and_si128(c1,b),b), 8);
+    }
+}
+
+// soft decoding of one symbol (same result as fecsoft_hamming74_decode);
+// reads eight soft bits, the last of which is ignored
+static unsigned char hamming74_decode_soft_sse41(unsigned char * _soft_bits,
+                                                 __m128i *       _mask)
+{
+    __m128i r = _mm_cvtepu8_epi16(_mm_loadl_epi64((__m128i*)_soft_bits));
+
+    // accumulate distance metric for each codeword
+    __m128i d0 = _mm_setzero_si128();
+    __m128i d1 = _mm_setzero_si128();
+    unsigned int i;
+    for (i=0; i<7; i++) {
+        // broadcast soft bit i to all lanes
+        __m128i ri = _mm_shuffle_epi8(r, _mm_set1_epi16(0x0100 + 0x0202*i));
+        d0 = _mm_add_epi16(d0, _mm_xor_si128(ri, _mask[2*i+0]));
+        d1 = _mm_add_epi16(d1, _mm_xor_si128(ri, _mask[2*i+1]));
+    }
+
+    // find minimum; lowest index wins ties
+    unsigned int v0 = _mm_cvtsi128_si32(_mm_minpos_epu16(d0));
+    unsigned int v1 = _mm_cvtsi128_si32(_mm_minpos_epu16(d1));
+    return (v1 & 0xffff) < (v0 & 0xffff) ? 8 + ((v1 >> 16) & 7) : (v0 >> 16) & 7;
+}
+#endif
+
 // create Hamming(7,4) codec object
 fec fec_hamming74_create(void * _opts)
 {
@@ -98,7 +150,26 @@ int fec_hamming74_encode(fec             _q,
     unsigned char s0, s1;   // decoded symbols
     unsigned char m0, m1;   // encoded symbols
 
-    for (i=0; i<_dec_msg_len; i++) {
+    // four input bytes (eight 7-bit symbols) fill exactly seven output
+    // bytes; assemble these in a 64-bit word rather than packing each
+    // symbol into the output array separately
+    unsigned int n;
+    unsigned int j=0;       // output byte counter
+    for (i=0; i+4<=_dec_msg_len; i+=4) {
+        uint64_t w = 0;
+        for (n=0; n<4; n++) {
+            w = (w << 14) |
+                (hamming74_enc_gentab[(_msg_dec[i+n] >> 4) & 0x0f] << 7) |
+                (hamming74_enc_gentab[(_msg_dec[i+n]     ) & 0x0f]     );
+        }
+        for (n=0; n<7; n++)
+            _msg_enc[j+n] = (w >> (48-8*n)) & 0xff;
+        j += 7;
+    }
+    k = 8*j;
+
+    // encode remaining bytes one symbol at a time
+    for ( ; i<_dec_msg_len; i++) {
         // strip two 4-bit symbols from input byte
         s0 = (_msg_dec[i] >> 4) & 0x0f;
         s1 = (_msg_dec[i] >> 0) & 0x0f;
@@ -140,8 +211,24 @@ int fec_hamming74_decode(fec             _q,
     unsigned char r0, r1;   // received 7-bit symbols
     unsigned char s0, s1;   // decoded 4-bit symbols
 
-    //unsigned char num_errors=0;
-    for (i=0; i<_dec_msg_len; i++) {
+    // decode groups of eight symbols from seven input bytes
+    unsigned int n;
+    unsigned int j=0;       // input byte counter
+    for (i=0; i+4<=_dec_msg_len; i+=4) {
+        uint64_t w = 0;
+        for (n=0; n<7; n++)
+            w = (w << 8) | _msg_enc[j+n];
+        for (n=0; n<4; n++) {
+            s0 = hamming74_dec_gentab[(w >> (49-14*n)) & 0x7f];
+            s1 = hamming74_dec_gentab[(w >> (42-14*n)) & 0x7f];
+            _msg_dec[i+n] = (s0 << 4) | s1;
+        }
+        j += 7;
+    }
+    k = 8*j;
+
+    // decode remaining bytes one symbol at a time
+    for ( ; i<_dec_msg_len; i++) {
         // strip two 7-bit symbols from 
         liquid_unpack_array(_msg_enc, enc_msg_len, k, 7, &r0);
         k += 7;
@@ -181,10 +268,28 @@ int fec_hamming74_decode_soft(fec             _q,
     unsigned char s0;
     unsigned char s1;
 
+#if FEC_HAMMING74_USE_SSE41
+    // compute bit masks of all 16 codewords once for entire block
+    __m128i mask[14];
+    hamming74_soft_mask_sse41(mask);
+#endif
+
     //unsigned char num_errors=0;
     for (i=0; i<_dec_msg_len; i++) {
+#if FEC_HAMMING74_USE_SSE41
+        s0 = hamming74_decode_soft_sse41(&_msg_enc[k  ], mask);
+        if (i < _dec_msg_len-1) {
+            s1 = hamming74_decode_soft_sse41(&_msg_enc[k+7], mask);
+        } else {
+            // copy last symbol to avoid reading past end of input
+            unsigned char buf[8] = {0,0,0,0,0,0,0,0};
+            memmove(buf, &_msg_enc[k+7], 7*sizeof(unsigned char));
+            s1 = hamming74_decode_soft_sse41(buf, mask);
+        }
+#else
         s0 = fecsoft_hamming74_decode(&_msg_enc[k  ]);
         s1 = fecsoft_hamming74_decode(&_msg_enc[k+7]);
+#endif
         k += 14;
 
         // pack two 4-bit symbols into one 8-bit byte
@@ -192,7 +297,7 @@ int fec_hamming74_decode_soft(fec             _q,
 
         //printf("  %3u : 0x%.2x > 0x%.2x,  0x%.2x > 0x%.2x (k=%u)\n", i, r0, s0, r1, s1, k);
     }
-    assert(k == 8*enc_msg_len);
+    assert(k <= 8*enc_msg_len);  // last byte is padded when 14*_dec_msg_len is not a multiple of 8
     return LIQUID_OK;
 }
 
@@ -30,6 +30,13 @@
 
 #include "liquid.internal.h"
 
+#if HAVE_SSE41 && HAVE_SMMINTRIN_H
+#include <smmintrin.h>
+#define FEC_HAMMING84_USE_SSE41 1
+#else
+#define FEC_HAMMING84_USE_SSE41 0
+#endif
+
 // encoder look-up table
 unsigned char hamming84_enc_gentab[16] = {
     0x00, 0xd2, 0x55, 0x87, 0x99, 0x4b, 0xcc, 0x1e,
@@ -70,6 +77,49 @@ unsigned char hamming84_dec_gentab[256] = {
     0x08, 0x08, 0x01, 0x01, 0x0a, 0x0a, 0x0f, 0x0f,
     0x0c, 0x0c, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f};
 
+#if FEC_HAMMING84_USE_SSE41
+// Soft decoding compares the received soft bits against all 16
+// codewords at once: each codeword occupies one 16-bit lane across two
+// registers, and soft bit b contributes b ^ 0x00ff = 255-b to lanes
+// whose codeword has that bit set, and b otherwise.
+
+// compute per-bit lane masks for all codewords [size: 16 x 1]
+static void hamming84_soft_mask_sse41(__m128i * _mask)
+{
+    __m128i c0 = _mm_cvtepu8_epi16(_mm_loadl_epi64((__m128i*)&hamming84_enc_gentab[0]));
+    __m128i c1 = _mm_cvtepu8_epi16(_mm_loadl_epi64((__m128i*)&hamming84_enc_gentab[8]));
+    unsigned int i;
+    for (i=0; i<8; i++) {
+        __m128i b = _mm_set1_epi16(0x80 >> i);
+        _mask[2*i+0] = _mm_srli_epi16(_mm_cmpeq_epi16(_mm_and_si128(c0,b),b), 8);
+        _mask[2*i+1] = _mm_srli_epi16(_mm_cmpeq_epi16(_mm_and_si128(c1,b),b), 8);
+    }
+}
+
+// soft decoding of one symbol (same result as fecsoft_hamming84_decode)
+static unsigned char hamming84_decode_soft_sse41(unsigned char * _soft_bits,
+                                                 __m128i *       _mask)
+{
+    __m128i r = _mm_cvtepu8_epi16(_mm_loadl_epi64((__m128i*)_soft_bits));
+
+    // accumulate distance metric for each codeword
+    __m128i d0 = _mm_setzero_si128();
+    __m128i d1 = _mm_setzero_si128();
+    unsigned int i;
+    for (i=0; i<8; i++) {
+        // broadcast soft bit i to all lanes
+        __m128i ri = _mm_shuffle_epi8(r, _mm_set1_epi16(0x0100 + 0x0202*i));
+        d0 = _mm_add_epi16(d0, _mm_xor_si128(ri, _mask[2*i+0]));
+        d1 = _mm_add_epi16(d1, _mm_xor_si128(ri, _mask[2*i+1]));
+    }
+
+    // find minimum; lowest index wins ties
+    unsigned int v0 = _mm_cvtsi128_si32(_mm_minpos_epu16(d0));
+    unsigned int v1 = _mm_cvtsi128_si32(_mm_minpos_epu16(d1));
+    return (v1 & 0xffff) < (v0 & 0xffff) ? 8 + ((v1 >> 16) & 7) : (v0 >> 16) & 7;
+}
+#endif
+
 // create Hamming(8,4) codec object
 fec fec_hamming84_create(void * _opts)
 {
@@ -169,10 +219,21 @@ int fec_hamming84_decode_soft(fec             _q,
     unsigned char s0;
     unsigned char s1;
 
+#if FEC_HAMMING84_USE_SSE41
+    // compute bit masks of all 16 codewords once for entire block
+    __m128i mask[16];
+    hamming84_soft_mask_sse41(mask);
+#endif
+
     //unsigned char num_errors=0;
     for (i=0; i<_dec_msg_len; i++) {
+#if FEC_HAMMING84_USE_SSE41
+        s0 = hamming84_decode_soft_sse41(&_msg_enc[k  ], mask);
+        s1 = hamming84_decode_soft_sse41(&_msg_enc[k+8], mask);
+#else
         s0 = fecsoft_hamming84_decode(&_msg_enc[k  ]);
         s1 = fecsoft_hamming84_decode(&_msg_enc[k+8]);
+#endif
         k += 16;
 
         // pack two 4-bit symbols into one 8-bit byte
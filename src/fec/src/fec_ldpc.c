@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2007 - 2022 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Low-density parity-check codes (rate 1/2, quasi-cyclic)
+//
+// Messages are split into blocks of k bits; the last block is padded
+// with zeros which are known to the decoder and not transmitted. Each
+// block is sent as its message bits followed by its n-k parity bits.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "liquid.internal.h"
+
+// log-likelihood ratio of hard-decision bits
+#define FEC_LDPC_LLR_HARD   (4.0f)
+
+// log-likelihood ratio of known (padded) bits
+#define FEC_LDPC_LLR_KNOWN  (1000.0f)
+
+// get circulant size for scheme
+static unsigned int fec_ldpc_get_z(fec_scheme _scheme)
+{
+    switch (_scheme) {
+    case LIQUID_FEC_LDPC_R12_N648:  return 27;
+    case LIQUID_FEC_LDPC_R12_N1296: return 54;
+    case LIQUID_FEC_LDPC_R12_N1944: return 81;
+    default:;
+    }
+    return 0;
+}
+
+// compute encoded message length for LDPC codes
+//  _dec_msg_len    :   decoded message length (bytes)
+//  _n              :   codeword length (bits)
+//  _k              :   message length per codeword (bits)
+unsigned int fec_ldpc_get_enc_msg_len(unsigned int _dec_msg_len,
+                                      unsigned int _n,
+                                      unsigned int _k)
+{
+    unsigned int num_bits   = 8*_dec_msg_len;
+    unsigned int num_blocks = (num_bits + _k - 1) / _k;
+    num_bits += num_blocks*(_n - _k);
+    return (num_bits + 7) / 8;
+}
+
+// create LDPC codec object
+fec fec_ldpc_create(fec_scheme _scheme)
+{
+    unsigned int z = fec_ldpc_get_z(_scheme);
+    if (z == 0)
+        return liquid_error_config("fec_ldpc_create(), invalid type");
+
+    fec q = (fec) malloc(sizeof(struct fec_s));
+
+    q->scheme = _scheme;
+    q->rate = fec_get_rate(q->scheme);
+
+    q->encode_func      = &fec_ldpc_encode;
+    q->decode_func      = &fec_ldpc_decode_hard;
+    q->decode_soft_func = &fec_ldpc_decode_soft;
+
+    // create code and buffers
+    q->ldpc = ldpc_create_r12(z);
+    unsigned int n = ldpc_get_n(q->ldpc);
+    q->ldpc_msg = (unsigned char*) malloc(n*sizeof(unsigned char));
+    q->ldpc_cw  = (unsigned char*) malloc(n*sizeof(unsigned char));
+    q->ldpc_llr = (float*)         malloc(n*sizeof(float));
+    return q;
+}
+
+// destroy LDPC codec object
+int fec_ldpc_destroy(fec _q)
+{
+    ldpc_destroy(_q->ldpc);
+    free(_q->ldpc_msg);
+    free(_q->ldpc_cw);
+    free(_q->ldpc_llr);
+    free(_q);
+    return LIQUID_OK;
+}
+
+// encode block of data using LDPC encoder
+//  _q              :   encoder/decoder object
+//  _dec_msg_len    :   decoded message length (number of bytes)
+//  _msg_dec        :   decoded message [size: 1 x _dec_msg_len]
+//  _msg_enc        :   encoded message [size: 1 x enc_msg_len]
+int fec_ldpc_encode(fec             _q,
+                    unsigned int    _dec_msg_len,
+                    unsigned char * _msg_dec,
+                    unsigned char * _msg_enc)
+{
+    unsigned int n = ldpc_get_n(_q->ldpc);
+    unsigned int k = ldpc_get_k(_q->ldpc);
+    unsigned int num_bits = 8*_dec_msg_len;
+    unsigned int enc_msg_len = fec_ldpc_get_enc_msg_len(_dec_msg_len, n, k);
+    memset(_msg_enc, 0x00, enc_msg_len);
+
+    unsigned int i;
+    unsigned int n0 = 0;    // input bit index
+    unsigned int n1 = 0;    // output bit index
+    while (n0 < num_bits) {
+        // message bits, padded with zeros
+        unsigned int num_msg = num_bits - n0 < k ? num_bits - n0 : k;
+        for (i=0; i<k; i++)
+            _q->ldpc_msg[i] = i < num_msg ? (_msg_dec[(n0+i)/8] >> (7-(n0+i)%8)) & 1 : 0;
+        ldpc_encode(_q->ldpc, _q->ldpc_msg, _q->ldpc_cw);
+
+        // write message bits (excluding padding) and parity bits
+        for (i=0; i<n; i++) {
+            if (i >= num_msg && i < k)
+                continue;
+            _msg_enc[n1/8] |= _q->ldpc_cw[i] << (7-n1%8);
+            n1++;
+        }
+        n0 += num_msg;
+    }
+    return LIQUID_OK;
+}
+
+// decode one block from log-likelihood ratios with padding applied
+static int fec_ldpc_decode_block(fec             _q,
+                                 unsigned int    _num_msg,
+                                 unsigned int    _n0,
+                                 unsigned char * _msg_dec)
+{
+    unsigned int i;
+    ldpc_decode(_q->ldpc, _q->ldpc_llr, _q->ldpc_cw);
+    for (i=0; i<_num_msg; i++)
+        _msg_dec[(_n0+i)/8] |= _q->ldpc_cw[i] << (7-(_n0+i)%8);
+    return LIQUID_OK;
+}
+
+// decode block of data using LDPC decoder (hard decision)
+//  _q              :   encoder/decoder object
+//  _dec_msg_len    :   decoded message length (number of bytes)
+//  _msg_enc        :   encoded message [size: 1 x enc_msg_len]
+//  _msg_dec        :   decoded message [size: 1 x _dec_msg_len]
+int fec_ldpc_decode_hard(fec             _q,
+                         unsigned int    _dec_msg_len,
+                         unsigned char * _msg_enc,
+                         unsigned char * _msg_dec)
+{
+    unsigned int n = ldpc_get_n(_q->ldpc);
+    unsigned int k = ldpc_get_k(_q->ldpc);
+    unsigned int num_bits = 8*_dec_msg_len;
+    memset(_msg_dec, 0x00, _dec_msg_len);
+
+    unsigned int i;
+    unsigned int n0 = 0;    // output bit index
+    unsigned int n1 = 0;    // input bit index
+    while (n0 < num_bits) {
+        unsigned int num_msg = num_bits - n0 < k ? num_bits - n0 : k;
+        for (i=0; i<n; i++) {
+            if (i >= num_msg && i < k) {
+                _q->ldpc_llr[i] = FEC_LDPC_LLR_KNOWN;
+                continue;
+            }
+            unsigned int bit = (_msg_enc[n1/8] >> (7-n1%8)) & 1;
+            _q->ldpc_llr[i] = bit ? -FEC_LDPC_LLR_HARD : FEC_LDPC_LLR_HARD;
+            n1++;
+        }
+        fec_ldpc_decode_block(_q, num_msg, n0, _msg_dec);
+        n0 += num_msg;
+    }
+    return LIQUID_OK;
+}
+
+// decode block of data using LDPC decoder (soft decision)
+//  _q              :   encoder/decoder object
+//  _dec_msg_len    :   decoded message length (number of bytes)
+//  _msg_enc        :   encoded message (soft bits) [size: 1 x 8*enc_msg_len]
+//  _msg_dec        :   decoded message [size: 1 x _dec_msg_len]
+int fec_ldpc_decode_soft(fec             _q,
+                         unsigned int    _dec_msg_len,
+                         unsigned char * _msg_enc,
+                         unsigned char * _msg_dec)
+{
+    unsigned int n = ldpc_get_n(_q->ldpc);
+    unsigned int k = ldpc_get_k(_q->ldpc);
+    unsigned int num_bits = 8*_dec_msg_len;
+    memset(_msg_dec, 0x00, _dec_msg_len);
+
+    unsigned int i;
+    unsigned int n0 = 0;    // output bit index
+    unsigned int n1 = 0;    // input soft bit index
+    while (n0 < num_bits) {
+        unsigned int num_msg = num_bits - n0 < k ? num_bits - n0 : k;
+        for (i=0; i<n; i++) {
+            if (i >= num_msg && i < k) {
+                _q->ldpc_llr[i] = FEC_LDPC_LLR_KNOWN;
+                continue;
+            }
+            // map soft bit [0,255] to log-likelihood ratio
+            _q->ldpc_llr[i] = (127.5f - (float)_msg_enc[n1++]) / 16.0f;
+        }
+        fec_ldpc_decode_block(_q, num_msg, n0, _msg_dec);
+        n0 += num_msg;
+    }
+    return LIQUID_OK;
+}
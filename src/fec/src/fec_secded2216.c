@@ -64,41 +64,18 @@ unsigned char secded2216_syndrome_w1[22] = {
 // compute parity on 16-bit input
 unsigned char fec_secded2216_compute_parity(unsigned char * _m)
 {
-    // compute encoded/transmitted message: v = m*G
-    unsigned char parity = 0x00;
-
-    // TODO : unwrap this loop
-    unsigned int i;
-    for (i=0; i<6; i++) {
-        parity <<= 1;
-
-        unsigned int p = liquid_c_ones[ secded2216_P[2*i+0] & _m[0] ] +
-                         liquid_c_ones[ secded2216_P[2*i+1] & _m[1] ];
-
-        parity |= p & 0x01;
-    }
-
-    return parity;
+    // compute encoded/transmitted message: v = m*G; the product is
+    // linear so the parity is the XOR of the contribution of each
+    // input byte (see secded2216_enc_gentab)
+    return secded2216_enc_gentab[0][_m[0]] ^
+           secded2216_enc_gentab[1][_m[1]];
 }
 
 // compute syndrome on 22-bit input
 unsigned char fec_secded2216_compute_syndrome(unsigned char * _v)
 {
-    // TODO : unwrap this loop
-    unsigned int i;
-    unsigned char syndrome = 0x00;
-    for (i=0; i<6; i++) {
-        syndrome <<= 1;
-
-        unsigned int p =
-            ( (_v[0] & (1<<(6-i-1))) ? 1 : 0 )+
-            liquid_c_ones[ secded2216_P[2*i+0] & _v[1] ] +
-            liquid_c_ones[ secded2216_P[2*i+1] & _v[2] ];
-
-        syndrome |= p & 0x01;
-    }
-
-    return syndrome;
+    // received parity plus parity re-computed on received data
+    return (_v[0] & 0x3f) ^ fec_secded2216_compute_parity(&_v[1]);
 }
 
 // encode symbol
@@ -167,32 +144,22 @@ int fec_secded2216_estimate_ehat(unsigned char * _sym_enc,
     // compute syndrome vector, s = r*H^T = ( H*r^T )^T
     unsigned char s = fec_secded2216_compute_syndrome(_sym_enc);
 
-    // compute weight of s
-    unsigned int ws = liquid_c_ones[s];
-    
-    if (ws == 0) {
+    // look up error location from syndrome (table holds one-based
+    // index of syndrome in secded2216_syndrome_w1)
+    unsigned int t = secded2216_syn_gentab[s];
+
+    if (t == 0) {
         // no errors detected
         return 0;
-    } else {
-        // estimate error location; search for syndrome with error
-        // vector of weight one
-
-        unsigned int n;
-        // estimate error location
-        for (n=0; n<22; n++) {
-            if (s == secded2216_syndrome_w1[n]) {
-                // single error detected at location 'n'
-                div_t d = div(n,8);
-                _e_hat[3-d.quot-1] = 1 << d.rem;
-
-                return 1;
-            }
-        }
-
+    } else if (t == 0xff) {
+        // no syndrome match; multiple errors detected
+        return 2;
     }
 
-    // no syndrome match; multiple errors detected
-    return 2;
+    // single error detected at location 'n'
+    unsigned int n = t - 1;
+    _e_hat[3-n/8-1] = 1 << (n%8);
+    return 1;
 }
 
 // create SEC-DED (22,16) codec object
@@ -238,15 +205,17 @@ int fec_secded2216_encode(fec             _q,
 
     // for now simply encode as 2/3-rate codec (eat
     // 2 bits of parity)
-    // TODO : make more efficient
-
     for (i=0; i<_dec_msg_len-r; i+=2) {
+        unsigned char m0 = _msg_dec[i+0];
+        unsigned char m1 = _msg_dec[i+1];
+
         // compute parity (6 bits) on two input bytes (16 bits)
-        _msg_enc[j+0] = fec_secded2216_compute_parity(&_msg_dec[i]);
+        _msg_enc[j+0] = secded2216_enc_gentab[0][m0] ^
+                        secded2216_enc_gentab[1][m1];
 
         // copy remaining two input bytes (16 bits)
-        _msg_enc[j+1] = _msg_dec[i+0];
-        _msg_enc[j+2] = _msg_dec[i+1];
+        _msg_enc[j+1] = m0;
+        _msg_enc[j+2] = m1;
 
         // increment output counter
         j += 3;
@@ -298,8 +267,20 @@ int fec_secded2216_decode(fec             _q,
     unsigned int r = _dec_msg_len % 2;
 
     for (i=0; i<_dec_msg_len-r; i+=2) {
-        // decode straight to output
-        fec_secded2216_decode_symbol(&_msg_enc[j], &_msg_dec[i]);
+        // copy data bytes straight to output
+        _msg_dec[i+0] = _msg_enc[j+1];
+        _msg_dec[i+1] = _msg_enc[j+2];
+
+        // compute syndrome and look up error location
+        unsigned char s = (_msg_enc[j] & 0x3f) ^
+                          secded2216_enc_gentab[0][_msg_enc[j+1]] ^
+                          secded2216_enc_gentab[1][_msg_enc[j+2]];
+
+        // correct single error in data bits (zero and multiple-error
+        // entries wrap around and are ignored, as are parity errors)
+        unsigned int n = (unsigned int)secded2216_syn_gentab[s] - 1;
+        if (n < 16)
+            _msg_dec[i + 1 - n/8] ^= 1 << (n%8);
 
         j += 3;
     }
@@ -71,45 +71,20 @@ unsigned char secded3932_syndrome_w1[39] = {
 // compute parity on 32-bit input
 unsigned char fec_secded3932_compute_parity(unsigned char * _m)
 {
-    // compute encoded/transmitted message: v = m*G
-    unsigned char parity = 0x00;
-
-    // TODO : unwrap this loop
-    unsigned int i;
-    for (i=0; i<7; i++) {
-        parity <<= 1;
-
-        unsigned int p = liquid_c_ones[ secded3932_P[4*i+0] & _m[0] ] +
-                         liquid_c_ones[ secded3932_P[4*i+1] & _m[1] ] +
-                         liquid_c_ones[ secded3932_P[4*i+2] & _m[2] ] +
-                         liquid_c_ones[ secded3932_P[4*i+3] & _m[3] ];
-
-        parity |= p & 0x01;
-    }
-
-    return parity;
+    // compute encoded/transmitted message: v = m*G; the product is
+    // linear so the parity is the XOR of the contribution of each
+    // input byte (see secded3932_enc_gentab)
+    return secded3932_enc_gentab[0][_m[0]] ^
+           secded3932_enc_gentab[1][_m[1]] ^
+           secded3932_enc_gentab[2][_m[2]] ^
+           secded3932_enc_gentab[3][_m[3]];
 }
 
 // compute syndrome on 39-bit input
 unsigned char fec_secded3932_compute_syndrome(unsigned char * _v)
 {
-    // TODO : unwrap this loop
-    unsigned int i;
-    unsigned char syndrome = 0x00;
-    for (i=0; i<7; i++) {
-        syndrome <<= 1;
-
-        unsigned int p =
-            ( (_v[0] & (1<<(7-i-1))) ? 1 : 0 )+
-            liquid_c_ones[ secded3932_P[4*i+0] & _v[1] ] +
-            liquid_c_ones[ secded3932_P[4*i+1] & _v[2] ] +
-            liquid_c_ones[ secded3932_P[4*i+2] & _v[3] ] +
-            liquid_c_ones[ secded3932_P[4*i+3] & _v[4] ];
-
-        syndrome |= p & 0x01;
-    }
-
-    return syndrome;
+    // received parity plus parity re-computed on received data
+    return (_v[0] & 0x7f) ^ fec_secded3932_compute_parity(&_v[1]);
 }
 
 // encode symbol
@@ -183,32 +158,22 @@ int fec_secded3932_estimate_ehat(unsigned char * _sym_enc,
     // compute syndrome vector, s = r*H^T = ( H*r^T )^T
     unsigned char s = fec_secded3932_compute_syndrome(_sym_enc);
 
-    // compute weight of s
-    unsigned int ws = liquid_c_ones[s];
-    
-    if (ws == 0) {
+    // look up error location from syndrome (table holds one-based
+    // index of syndrome in secded3932_syndrome_w1)
+    unsigned int t = secded3932_syn_gentab[s];
+
+    if (t == 0) {
         // no errors detected
         return 0;
-    } else {
-        // estimate error location; search for syndrome with error
-        // vector of weight one
-
-        unsigned int n;
-        // estimate error location
-        for (n=0; n<39; n++) {
-            if (s == secded3932_syndrome_w1[n]) {
-                // single error detected at location 'n'
-                div_t d = div(n,8);
-                _e_hat[5-d.quot-1] = 1 << d.rem;
-
-                return 1;
-            }
-        }
-
+    } else if (t == 0xff) {
+        // no syndrome match; multiple errors detected
+        return 2;
     }
 
-    // no syndrome match; multiple errors detected
-    return 2;
+    // single error detected at location 'n'
+    unsigned int n = t - 1;
+    _e_hat[5-n/8-1] = 1 << (n%8);
+    return 1;
 }
 
 // create SEC-DED (39,32) codec object
@@ -254,17 +219,23 @@ int fec_secded3932_encode(fec             _q,
 
     // for now simply encode as 4/5-rate codec (eat
     // last parity bit)
-    // TODO : make more efficient
-
     for (i=0; i<_dec_msg_len-r; i+=4) {
-        // compute parity (7 bits) on two input bytes (32 bits)
-        _msg_enc[j+0] = fec_secded3932_compute_parity(&_msg_dec[i]);
-
-        // copy remaining two input bytes (32 bits)
-        _msg_enc[j+1] = _msg_dec[i+0];
-        _msg_enc[j+2] = _msg_dec[i+1];
-        _msg_enc[j+3] = _msg_dec[i+2];
-        _msg_enc[j+4] = _msg_dec[i+3];
+        unsigned char m0 = _msg_dec[i+0];
+        unsigned char m1 = _msg_dec[i+1];
+        unsigned char m2 = _msg_dec[i+2];
+        unsigned char m3 = _msg_dec[i+3];
+
+        // compute parity (7 bits) on four input bytes (32 bits)
+        _msg_enc[j+0] = secded3932_enc_gentab[0][m0] ^
+                        secded3932_enc_gentab[1][m1] ^
+                        secded3932_enc_gentab[2][m2] ^
+                        secded3932_enc_gentab[3][m3];
+
+        // copy remaining four input bytes (32 bits)
+        _msg_enc[j+1] = m0;
+        _msg_enc[j+2] = m1;
+        _msg_enc[j+3] = m2;
+        _msg_enc[j+4] = m3;
 
         // increment output counter
         j += 5;
@@ -320,8 +291,24 @@ int fec_secded3932_decode(fec             _q,
     unsigned int r = _dec_msg_len % 4;
 
     for (i=0; i<_dec_msg_len-r; i+=4) {
-        // decode straight to output
-        fec_secded3932_decode_symbol(&_msg_enc[j], &_msg_dec[i]);
+        // copy data bytes straight to output
+        _msg_dec[i+0] = _msg_enc[j+1];
+        _msg_dec[i+1] = _msg_enc[j+2];
+        _msg_dec[i+2] = _msg_enc[j+3];
+        _msg_dec[i+3] = _msg_enc[j+4];
+
+        // compute syndrome and look up error location
+        unsigned char s = (_msg_enc[j] & 0x7f) ^
+                          secded3932_enc_gentab[0][_msg_enc[j+1]] ^
+                          secded3932_enc_gentab[1][_msg_enc[j+2]] ^
+                          secded3932_enc_gentab[2][_msg_enc[j+3]] ^
+                          secded3932_enc_gentab[3][_msg_enc[j+4]];
+
+        // correct single error in data bits (zero and multiple-error
+        // entries wrap around and are ignored, as are parity errors)
+        unsigned int n = (unsigned int)secded3932_syn_gentab[s] - 1;
+        if (n < 32)
+            _msg_dec[i + 3 - n/8] ^= 1 << (n%8);
 
         j += 5;
     }
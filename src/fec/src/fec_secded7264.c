@@ -72,53 +72,24 @@ unsigned char secded7264_syndrome_w1[72] = {
 // compute parity byte on 64-byte input
 unsigned char fec_secded7264_compute_parity(unsigned char * _v)
 {
-    // compute parity byte on message
-    unsigned int i;
-    unsigned char parity = 0x00;
-    for (i=0; i<8; i++) {
-        parity <<= 1;
-
-        unsigned int p = liquid_c_ones[ secded7264_P[8*i+0] & _v[0] ] +
-                         liquid_c_ones[ secded7264_P[8*i+1] & _v[1] ] +
-                         liquid_c_ones[ secded7264_P[8*i+2] & _v[2] ] +
-                         liquid_c_ones[ secded7264_P[8*i+3] & _v[3] ] +
-                         liquid_c_ones[ secded7264_P[8*i+4] & _v[4] ] +
-                         liquid_c_ones[ secded7264_P[8*i+5] & _v[5] ] +
-                         liquid_c_ones[ secded7264_P[8*i+6] & _v[6] ] +
-                         liquid_c_ones[ secded7264_P[8*i+7] & _v[7] ];
-
-        parity |= p & 0x01;
-    }
-
-    // return parity byte
-    return parity;
+    // compute parity byte on message; the product is linear so the
+    // parity is the XOR of the contribution of each input byte (see
+    // secded7264_enc_gentab)
+    return secded7264_enc_gentab[0][_v[0]] ^
+           secded7264_enc_gentab[1][_v[1]] ^
+           secded7264_enc_gentab[2][_v[2]] ^
+           secded7264_enc_gentab[3][_v[3]] ^
+           secded7264_enc_gentab[4][_v[4]] ^
+           secded7264_enc_gentab[5][_v[5]] ^
+           secded7264_enc_gentab[6][_v[6]] ^
+           secded7264_enc_gentab[7][_v[7]];
 }
 
 // compute syndrome on 72-bit input
 unsigned char fec_secded7264_compute_syndrome(unsigned char * _v)
 {
-    // TODO : unwrap this loop
-    unsigned int i;
-    unsigned char syndrome = 0x00;
-    for (i=0; i<8; i++) {
-        syndrome <<= 1;
-
-        // compute parity bit
-        unsigned int p =
-            ( (_v[0] & (1<<(8-i-1))) ? 1 : 0 ) +
-            liquid_c_ones[ secded7264_P[8*i+0] & _v[1] ] +
-            liquid_c_ones[ secded7264_P[8*i+1] & _v[2] ] +
-            liquid_c_ones[ secded7264_P[8*i+2] & _v[3] ] +
-            liquid_c_ones[ secded7264_P[8*i+3] & _v[4] ] +
-            liquid_c_ones[ secded7264_P[8*i+4] & _v[5] ] +
-            liquid_c_ones[ secded7264_P[8*i+5] & _v[6] ] +
-            liquid_c_ones[ secded7264_P[8*i+6] & _v[7] ] +
-            liquid_c_ones[ secded7264_P[8*i+7] & _v[8] ];
-
-        syndrome |= p & 0x01;
-    }
-
-    return syndrome;
+    // received parity plus parity re-computed on received data
+    return _v[0] ^ fec_secded7264_compute_parity(&_v[1]);
 }
 
 int fec_secded7264_encode_symbol(unsigned char * _sym_dec,
@@ -186,32 +157,22 @@ int fec_secded7264_estimate_ehat(unsigned char * _sym_enc,
     // compute syndrome vector, s = r*H^T = ( H*r^T )^T
     unsigned char s = fec_secded7264_compute_syndrome(_sym_enc);
 
-    // compute weight of s
-    unsigned int ws = liquid_c_ones[s];
-    
-    if (ws == 0) {
+    // look up error location from syndrome (table holds one-based
+    // index of syndrome in secded7264_syndrome_w1)
+    unsigned int t = secded7264_syn_gentab[s];
+
+    if (t == 0) {
         // no errors detected
         return 0;
-    } else {
-        // estimate error location; search for syndrome with error
-        // vector of weight one
-
-        unsigned int n;
-        // estimate error location
-        for (n=0; n<72; n++) {
-            if (s == secded7264_syndrome_w1[n]) {
-                // single error detected at location 'n'
-                div_t d = div(n,8);
-                _e_hat[9-d.quot-1] = 1 << d.rem;
-
-                return 1;
-            }
-        }
-
+    } else if (t == 0xff) {
+        // no syndrome match; multiple errors detected
+        return 2;
     }
 
-    // no syndrome match; multiple errors detected
-    return 2;
+    // single error detected at location 'n'
+    unsigned int n = t - 1;
+    _e_hat[9-n/8-1] = 1 << (n%8);
+    return 1;
 }
 
 // create SEC-DED (72,64) codec object
@@ -256,10 +217,19 @@ int fec_secded7264_encode(fec             _q,
     // determine remainder of input length / 8
     unsigned int r = _dec_msg_len % 8;
 
-    // TODO : devise more efficient way of doing this
     for (i=0; i<_dec_msg_len-r; i+=8) {
-        // encode directly to output
-        fec_secded7264_encode_symbol(&_msg_dec[i], &_msg_enc[j]);
+        // compute parity byte on eight input bytes (64 bits)
+        _msg_enc[j] = secded7264_enc_gentab[0][_msg_dec[i+0]] ^
+                      secded7264_enc_gentab[1][_msg_dec[i+1]] ^
+                      secded7264_enc_gentab[2][_msg_dec[i+2]] ^
+                      secded7264_enc_gentab[3][_msg_dec[i+3]] ^
+                      secded7264_enc_gentab[4][_msg_dec[i+4]] ^
+                      secded7264_enc_gentab[5][_msg_dec[i+5]] ^
+                      secded7264_enc_gentab[6][_msg_dec[i+6]] ^
+                      secded7264_enc_gentab[7][_msg_dec[i+7]];
+
+        // copy input bytes
+        memmove(&_msg_enc[j+1], &_msg_dec[i], 8*sizeof(unsigned char));
 
         j += 9;
     }
@@ -310,8 +280,26 @@ int fec_secded7264_decode(fec             _q,
     unsigned int r = _dec_msg_len % 8;
 
     for (i=0; i<_dec_msg_len-r; i+=8) {
-        // decode nine input bytes
-        fec_secded7264_decode_symbol(&_msg_enc[j], &_msg_dec[i]);
+        // compute syndrome on nine input bytes
+        unsigned char * v = &_msg_enc[j];
+        unsigned char s = v[0] ^
+                          secded7264_enc_gentab[0][v[1]] ^
+                          secded7264_enc_gentab[1][v[2]] ^
+                          secded7264_enc_gentab[2][v[3]] ^
+                          secded7264_enc_gentab[3][v[4]] ^
+                          secded7264_enc_gentab[4][v[5]] ^
+                          secded7264_enc_gentab[5][v[6]] ^
+                          secded7264_enc_gentab[6][v[7]] ^
+                          secded7264_enc_gentab[7][v[8]];
+
+        // copy data bytes straight to output
+        memmove(&_msg_dec[i], &v[1], 8*sizeof(unsigned char));
+
+        // correct single error in data bits (zero and multiple-error
+        // entries wrap around and are ignored, as are parity errors)
+        unsigned int n = (unsigned int)secded7264_syn_gentab[s] - 1;
+        if (n < 64)
+            _msg_dec[i + 7 - n/8] ^= 1 << (n%8);
 
         j += 9;
     }
@@ -25,10 +25,19 @@
 //
 // Create and initialize interleaver objects
 //
+// The interleaver is a series of up to four passes, each swapping pairs
+// of bytes (or bits within bytes selected by a mask) over a block
+// structure. Because masked swaps exchange bits at the same position
+// within each byte, the composed permutation moves every bit position
+// k in [0,8) by a byte-level permutation. These are computed once when
+// the depth is set; bit positions sharing a permutation form a group so
+// that encoding and decoding are a single gather per group.
+//
 
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <stdint.h>
 #include <math.h>
 
 #include "liquid.internal.h"
@@ -37,32 +46,28 @@
 // internal methods
 //
 
-// permute one iteration
-void interleaver_permute(unsigned char * _x,
-                         unsigned int    _n,
-                         unsigned int    _M,
-                         unsigned int    _N);
-
-// permute one iteration (soft bit input)
-void interleaver_permute_soft(unsigned char * _x,
-                              unsigned int    _n,
-                              unsigned int    _M,
-                              unsigned int    _N);
-
-// permute one iteration with mask
-void interleaver_permute_mask(unsigned char * _x,
-                              unsigned int    _n,
-                              unsigned int    _M,
-                              unsigned int    _N,
-                              unsigned char   _mask);
-
-// permute one iteration (soft bit input) with mask
-void interleaver_permute_mask_soft(unsigned char * _x,
-                                   unsigned int    _n,
-                                   unsigned int    _M,
-                                   unsigned int    _N,
-                                   unsigned char   _mask);
-
+// compute permutation tables for current depth
+void interleaver_compute_tables(interleaver _q);
+
+// permute one iteration of index tables, swapping entries of bit
+// positions selected by mask
+void interleaver_permute_mask(unsigned int * _p,
+                              unsigned int   _n,
+                              unsigned int   _M,
+                              unsigned int   _N,
+                              unsigned char  _mask);
+
+// apply permutation groups to hard bytes
+void interleaver_gather(interleaver     _q,
+                        unsigned int *  _perm,
+                        unsigned char * _x,
+                        unsigned char * _y);
+
+// apply permutation groups to soft bits
+void interleaver_gather_soft(interleaver     _q,
+                             unsigned int *  _perm,
+                             unsigned char * _x,
+                             unsigned char * _y);
 
 // structured interleaver object
 struct interleaver_s {
@@ -73,6 +78,16 @@ struct interleaver_s {
 
     // interleaving depth (number of permutations)
     unsigned int depth;
+
+    // composed permutation: groups of bit positions sharing a byte-level
+    // permutation; output byte i takes bits selected by mask[g] from
+    // input byte perm[i*num_groups+g]
+    unsigned int    num_groups;     // number of distinct permutations
+    unsigned char   mask[8];        // bit mask of each group
+    uint64_t        mask_soft[8];   // soft-bit byte mask of each group
+    unsigned int *  perm;           // encoder table [size: 8n x 1]
+    unsigned int *  iperm;          // decoder table [size: 8n x 1]
+    unsigned char * buf;            // copy of input when operating in place
 };
 
 // create interleaver of length _n input/output bytes
@@ -90,6 +105,11 @@ interleaver interleaver_create(unsigned int _n)
     q->N = q->n / q->M;
     while (q->n >= (q->M*q->N)) q->N++;  // ensures M*N >= n
 
+    // allocate and compute permutation tables
+    q->perm  = (unsigned int*) malloc((8*q->n+1)*sizeof(unsigned int));
+    q->iperm = (unsigned int*) malloc((8*q->n+1)*sizeof(unsigned int));
+    q->buf   = (unsigned char*)malloc((8*q->n+1)*sizeof(unsigned char));
+    interleaver_compute_tables(q);
     return q;
 }
 
@@ -97,6 +117,9 @@ interleaver interleaver_create(unsigned int _n)
 void interleaver_destroy(interleaver _q)
 {
     // free main object memory
+    free(_q->perm);
+    free(_q->iperm);
+    free(_q->buf);
     free(_q);
 }
 
@@ -107,6 +130,7 @@ void interleaver_print(interleaver _q)
     printf("    M       :   %u\n", _q->M);
     printf("    N       :   %u\n", _q->N);
     printf("    depth   :   %u\n", _q->depth);
+    printf("    groups  :   %u\n", _q->num_groups);
 }
 
 // set depth (number of internal iterations)
@@ -114,6 +138,7 @@ void interleaver_set_depth(interleaver  _q,
                            unsigned int _depth)
 {
     _q->depth = _depth;
+    interleaver_compute_tables(_q);
 }
 
 // execute forward interleaver (encoder)
@@ -124,13 +149,10 @@ void interleaver_encode(interleaver _q,
                         unsigned char * _msg_dec,
                         unsigned char * _msg_enc)
 {
-    // copy data to output
-    memmove(_msg_enc, _msg_dec, _q->n);
-
-    if (_q->depth > 0) interleaver_permute(_msg_enc, _q->n, _q->M, _q->N);
-    if (_q->depth > 1) interleaver_permute_mask(_msg_enc, _q->n, _q->M, _q->N+2, 0x0f);
-    if (_q->depth > 2) interleaver_permute_mask(_msg_enc, _q->n, _q->M, _q->N+4, 0x55);
-    if (_q->depth > 3) interleaver_permute_mask(_msg_enc, _q->n, _q->M, _q->N+8, 0x33);
+    if (_q->depth == 0)
+        memmove(_msg_enc, _msg_dec, _q->n);
+    else
+        interleaver_gather(_q, _q->perm, _msg_dec, _msg_enc);
 }
 
 // execute forward interleaver (encoder) on soft bits
@@ -141,13 +163,10 @@ void interleaver_encode_soft(interleaver _q,
                              unsigned char * _msg_dec,
                              unsigned char * _msg_enc)
 {
-    // copy data to output
-    memmove(_msg_enc, _msg_dec, 8*_q->n);
-
-    if (_q->depth > 0) interleaver_permute_soft(_msg_enc, _q->n, _q->M, _q->N);
-    if (_q->depth > 1) interleaver_permute_mask_soft(_msg_enc, _q->n, _q->M, _q->N+2, 0x0f);
-    if (_q->depth > 2) interleaver_permute_mask_soft(_msg_enc, _q->n, _q->M, _q->N+4, 0x55);
-    if (_q->depth > 3) interleaver_permute_mask_soft(_msg_enc, _q->n, _q->M, _q->N+8, 0x33);
+    if (_q->depth == 0)
+        memmove(_msg_enc, _msg_dec, 8*_q->n);
+    else
+        interleaver_gather_soft(_q, _q->perm, _msg_dec, _msg_enc);
 }
 
 // execute reverse interleaver (decoder)
@@ -158,13 +177,10 @@ void interleaver_decode(interleaver _q,
                         unsigned char * _msg_enc,
                         unsigned char * _msg_dec)
 {
-    // copy data to output
-    memmove(_msg_dec, _msg_enc, _q->n);
-
-    if (_q->depth > 3) interleaver_permute_mask(_msg_dec, _q->n, _q->M, _q->N+8, 0x33);
-    if (_q->depth > 2) interleaver_permute_mask(_msg_dec, _q->n, _q->M, _q->N+4, 0x55);
-    if (_q->depth > 1) interleaver_permute_mask(_msg_dec, _q->n, _q->M, _q->N+2, 0x0f);
-    if (_q->depth > 0) interleaver_permute(_msg_dec, _q->n, _q->M, _q->N);
+    if (_q->depth == 0)
+        memmove(_msg_dec, _msg_enc, _q->n);
+    else
+        interleaver_gather(_q, _q->iperm, _msg_enc, _msg_dec);
 }
 
 // execute reverse interleaver (decoder) on soft bits
@@ -175,120 +191,77 @@ void interleaver_decode_soft(interleaver _q,
                              unsigned char * _msg_enc,
                              unsigned char * _msg_dec)
 {
-    // copy data to output
-    memmove(_msg_dec, _msg_enc, 8*_q->n);
-
-    if (_q->depth > 3) interleaver_permute_mask_soft(_msg_dec, _q->n, _q->M, _q->N+8, 0x33);
-    if (_q->depth > 2) interleaver_permute_mask_soft(_msg_dec, _q->n, _q->M, _q->N+4, 0x55);
-    if (_q->depth > 1) interleaver_permute_mask_soft(_msg_dec, _q->n, _q->M, _q->N+2, 0x0f);
-    if (_q->depth > 0) interleaver_permute_soft(_msg_dec, _q->n, _q->M, _q->N);
+    if (_q->depth == 0)
+        memmove(_msg_dec, _msg_enc, 8*_q->n);
+    else
+        interleaver_gather_soft(_q, _q->iperm, _msg_enc, _msg_dec);
 }
 
 // 
-// internal permutation methods
+// internal methods
 //
 
-// permute one iteration
-void interleaver_permute(unsigned char * _x,
-                         unsigned int    _n,
-                         unsigned int    _M,
-                         unsigned int    _N)
+// compute permutation tables for current depth
+void interleaver_compute_tables(interleaver _q)
 {
-    unsigned int i;
-    unsigned int j;
-    unsigned int m=0;
-    unsigned int n=_n/3;
-    unsigned int n2=_n/2;
-    unsigned char tmp;
-    for (i=0; i<n2; i++) {
-        //j = m*N + n; // input
-        do {
-            j = m*_N + n; // output
-            m++;
-            if (m == _M) {
-                n = (n+1) % (_N);
-                m=0;
-            }
-        } while (j>=n2);
-
-        // swap indices
-        tmp = _x[2*j+1];
-        _x[2*j+1] = _x[2*i+0];
-        _x[2*i+0] = tmp;
+    unsigned int n = _q->n;
+    unsigned int i, k, g;
+
+    // track source byte of each bit position through all passes
+    unsigned int * p = (unsigned int*) malloc((8*n+1)*sizeof(unsigned int));
+    for (k=0; k<8; k++) {
+        for (i=0; i<n; i++)
+            p[k*n+i] = i;
     }
-}
-
-// permute one iteration (soft bit input)
-void interleaver_permute_soft(unsigned char * _x,
-                              unsigned int    _n,
-                              unsigned int    _M,
-                              unsigned int    _N)
-{
-    unsigned int i;
-    unsigned int j;
-    unsigned int m=0;
-    unsigned int n=_n/3;
-    unsigned int n2=_n/2;
-    unsigned char tmp[8];
-    for (i=0; i<n2; i++) {
-        //j = m*N + n; // input
-        do {
-            j = m*_N + n; // output
-            m++;
-            if (m == _M) {
-                n = (n+1) % (_N);
-                m=0;
-            }
-        } while (j>=n2);
-    
-        // swap soft bits at indices
-        memmove( tmp,            &_x[8*(2*j+1)], 8);
-        memmove( &_x[8*(2*j+1)], &_x[8*(2*i+0)], 8);
-        memmove( &_x[8*(2*i+0)], tmp,            8);
+    if (_q->depth > 0) interleaver_permute_mask(p, n, _q->M, _q->N,   0xff);
+    if (_q->depth > 1) interleaver_permute_mask(p, n, _q->M, _q->N+2, 0x0f);
+    if (_q->depth > 2) interleaver_permute_mask(p, n, _q->M, _q->N+4, 0x55);
+    if (_q->depth > 3) interleaver_permute_mask(p, n, _q->M, _q->N+8, 0x33);
+
+    // group bit positions with identical permutations (group-major in
+    // decoder table for now)
+    unsigned int * t = _q->iperm;
+    _q->num_groups = 0;
+    for (k=0; k<8; k++) {
+        for (g=0; g<_q->num_groups; g++) {
+            if (memcmp(&p[k*n], &t[g*n], n*sizeof(unsigned int)) == 0)
+                break;
+        }
+        if (g == _q->num_groups) {
+            memmove(&t[g*n], &p[k*n], n*sizeof(unsigned int));
+            _q->mask[g]      = 0;
+            _q->mask_soft[g] = 0;
+            _q->num_groups++;
+        }
+        // soft bit k is the k-th byte in memory
+        _q->mask[g] |= 0x80 >> k;
+        unsigned char bytes[8] = {0,0,0,0,0,0,0,0};
+        bytes[k] = 0xff;
+        uint64_t v;
+        memmove(&v, bytes, 8);
+        _q->mask_soft[g] |= v;
     }
-    //printf("\n");
-}
-
 
-// permute one iteration with mask
-void interleaver_permute_mask(unsigned char * _x,
-                              unsigned int    _n,
-                              unsigned int    _M,
-                              unsigned int    _N,
-                              unsigned char   _mask)
-{
-    unsigned int i;
-    unsigned int j;
-    unsigned int m=0;
-    unsigned int n=_n/3;
-    unsigned int n2=_n/2;
-    unsigned char tmp0;
-    unsigned char tmp1;
-    for (i=0; i<n2; i++) {
-        //j = m*N + n; // input
-        do {
-            j = m*_N + n; // output
-            m++;
-            if (m == _M) {
-                n = (n+1) % (_N);
-                m=0;
-            }
-        } while (j>=n2);
-
-        // swap indices, applying mask
-        tmp0 = (_x[2*i+0] & (~_mask)) | (_x[2*j+1] & ( _mask));
-        tmp1 = (_x[2*i+0] & ( _mask)) | (_x[2*j+1] & (~_mask));
-        _x[2*i+0] = tmp0;
-        _x[2*j+1] = tmp1;
+    // interleave groups so each output byte reads its sources from
+    // consecutive entries: perm[i*G+g], and invert for decoder
+    unsigned int G = _q->num_groups;
+    for (g=0; g<G; g++) {
+        for (i=0; i<n; i++) {
+            _q->perm[i*G + g] = t[g*n + i];
+            p[t[g*n + i]*G + g] = i;
+        }
     }
+    memmove(_q->iperm, p, G*n*sizeof(unsigned int));
+    free(p);
 }
 
-// permute one iteration (soft bit input)
-void interleaver_permute_mask_soft(unsigned char * _x,
-                                   unsigned int    _n,
-                                   unsigned int    _M,
-                                   unsigned int    _N,
-                                   unsigned char   _mask)
+// permute one iteration of index tables, swapping entries of bit
+// positions selected by mask
+void interleaver_permute_mask(unsigned int * _p,
+                              unsigned int   _n,
+                              unsigned int   _M,
+                              unsigned int   _N,
+                              unsigned char  _mask)
 {
     unsigned int i;
     unsigned int j;
@@ -296,7 +269,7 @@ void interleaver_permute_mask_soft(unsigned char * _x,
     unsigned int m=0;
     unsigned int n=_n/3;
     unsigned int n2=_n/2;
-    unsigned char tmp;
+    unsigned int tmp;
     for (i=0; i<n2; i++) {
         //j = m*N + n; // input
         do {
@@ -308,15 +281,83 @@ void interleaver_permute_mask_soft(unsigned char * _x,
             }
         } while (j>=n2);
 
-        // swap bits matching the mask
+        // swap indices of bits matching the mask
         for (k=0; k<8; k++) {
             if ( (_mask >> (8-k-1)) & 0x01 ) {
-                tmp = _x[8*(2*j+1)+k];
-                _x[8*(2*j+1)+k] = _x[8*(2*i+0)+k];
-                _x[8*(2*i+0)+k] = tmp;
+                tmp = _p[k*_n + 2*j+1];
+                _p[k*_n + 2*j+1] = _p[k*_n + 2*i+0];
+                _p[k*_n + 2*i+0] = tmp;
             }
         }
     }
-    //printf("\n");
 }
 
+// apply permutation groups to hard bytes
+void interleaver_gather(interleaver     _q,
+                        unsigned int *  _perm,
+                        unsigned char * _x,
+                        unsigned char * _y)
+{
+    unsigned int n = _q->n;
+    unsigned int G = _q->num_groups;
+    unsigned int i, g;
+    if (_x == _y) {
+        memmove(_q->buf, _x, n);
+        _x = _q->buf;
+    }
+    if (G == 1) {
+        for (i=0; i<n; i++)
+            _y[i] = _x[_perm[i]];
+        return;
+    }
+    if (G == 8) {
+        // every bit position moves independently (full depth); masks
+        // are single bits in order
+        for (i=0; i<n; i++) {
+            unsigned int * p = &_perm[8*i];
+            _y[i] = (_x[p[0]] & 0x80) | (_x[p[1]] & 0x40) |
+                    (_x[p[2]] & 0x20) | (_x[p[3]] & 0x10) |
+                    (_x[p[4]] & 0x08) | (_x[p[5]] & 0x04) |
+                    (_x[p[6]] & 0x02) | (_x[p[7]] & 0x01);
+        }
+        return;
+    }
+    for (i=0; i<n; i++) {
+        unsigned int * p = &_perm[i*G];
+        unsigned char  v = 0;
+        for (g=0; g<G; g++)
+            v |= _x[p[g]] & _q->mask[g];
+        _y[i] = v;
+    }
+}
+
+// apply permutation groups to soft bits, moving eight soft bits (one
+// byte) at a time as a 64-bit word
+void interleaver_gather_soft(interleaver     _q,
+                             unsigned int *  _perm,
+                             unsigned char * _x,
+                             unsigned char * _y)
+{
+    unsigned int n = _q->n;
+    unsigned int G = _q->num_groups;
+    unsigned int i, g;
+    uint64_t v, w;
+    if (_x == _y) {
+        memmove(_q->buf, _x, 8*n);
+        _x = _q->buf;
+    }
+    if (G == 1) {
+        for (i=0; i<n; i++)
+            memmove(&_y[8*i], &_x[8*_perm[i]], 8);
+        return;
+    }
+    for (i=0; i<n; i++) {
+        unsigned int * p = &_perm[i*G];
+        w = 0;
+        for (g=0; g<G; g++) {
+            memmove(&v, &_x[8*p[g]], 8);
+            w |= v & _q->mask_soft[g];
+        }
+        memmove(&_y[8*i], &w, 8);
+    }
+}
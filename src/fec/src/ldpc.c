@@ -0,0 +1,706 @@
+/*
+ * Copyright (c) 2007 - 2022 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// ldpc.c
+//
+// Low-density parity-check codes with a layered min-sum decoder. The
+// parity-check matrix is held as compressed sparse rows, each row forming
+// one layer. Quasi-cyclic codes are described by a base matrix of
+// circulant shifts; for these each layer spans z rows which are decoded
+// in parallel with 16-bit fixed-point messages (eight lanes at a time
+// with SSE2), and systematic encoding uses the dual-diagonal parity
+// structure.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "liquid.internal.h"
+
+#if HAVE_SSE2 && HAVE_EMMINTRIN_H
+#include <emmintrin.h>  // SSE2
+#define LDPC_USE_SSE2 1
+#else
+#define LDPC_USE_SSE2 0
+#endif
+
+#define DEBUG_LDPC 0
+
+// fixed-point scale of log-likelihood ratios (fractional bits)
+#define LDPC_LLR_SCALE      (8.0f)
+
+// limit of input log-likelihood ratios in fixed point
+#define LDPC_LLR_MAX        (8191)
+
+// lanes per vector
+#define LDPC_LANES          (8)
+
+// rate-1/2 base matrices [12 x 24] from IEEE 802.11n-2009 (annex R) for
+// circulant sizes 27, 54 and 81 (codeword lengths 648, 1296 and 1944),
+// each with a dual-diagonal parity section
+static const signed char ldpc_base_r12_z27[12*24] = {
+     0, -1, -1, -1,  0,  0, -1, -1,  0, -1, -1,  0,  1,  0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    22,  0, -1, -1, 17, -1,  0,  0, 12, -1, -1, -1, -1,  0,  0, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+     6, -1,  0, -1, 10, -1, -1, -1, 24, -1,  0, -1, -1, -1,  0,  0, -1, -1, -1, -1, -1, -1, -1, -1,
+     2, -1, -1,  0, 20, -1, -1, -1, 25,  0, -1, -1, -1, -1, -1,  0,  0, -1, -1, -1, -1, -1, -1, -1,
+    23, -1, -1, -1,  3, -1, -1, -1,  0, -1,  9, 11, -1, -1, -1, -1,  0,  0, -1, -1, -1, -1, -1, -1,
+    24, -1, 23,  1, 17, -1,  3, -1, 10, -1, -1, -1, -1, -1, -1, -1, -1,  0,  0, -1, -1, -1, -1, -1,
+    25, -1, -1, -1,  8, -1, -1, -1,  7, 18, -1, -1,  0, -1, -1, -1, -1, -1,  0,  0, -1, -1, -1, -1,
+    13, 24, -1, -1,  0, -1,  8, -1,  6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  0,  0, -1, -1, -1,
+     7, 20, -1, 16, 22, 10, -1, -1, 23, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  0,  0, -1, -1,
+    11, -1, -1, -1, 19, -1, -1, -1, 13, -1,  3, 17, -1, -1, -1, -1, -1, -1, -1, -1, -1,  0,  0, -1,
+    25, -1,  8, -1, 23, 18, -1, 14,  9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  0,  0,
+     3, -1, -1, -1, 16, -1, -1,  2, 25,  5, -1, -1,  1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  0,
+};
+
+static const signed char ldpc_base_r12_z54[12*24] = {
+    40, -1, -1, -1, 22, -1, 49, 23, 43, -1, -1, -1,  1,  0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    50,  1, -1, -1, 48, 35, -1, -1, 13, -1, 30, -1, -1,  0,  0, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    39, 50, -1, -1,  4, -1,  2, -1, -1, -1, -1, 49, -1, -1,  0,  0, -1, -1, -1, -1, -1, -1, -1, -1,
+    33, -1, -1, 38, 37, -1, -1,  4,  1, -1, -1, -1, -1, -1, -1,  0,  0, -1, -1, -1, -1, -1, -1, -1,
+    45, -1, -1, -1,  0, 22, -1, -1, 20, 42, -1, -1, -1, -1, -1, -1,  0,  0, -1, -1, -1, -1, -1, -1,
+    51, -1, -1, 48, 35, -1, -1, -1, 44, -1, 18, -1, -1, -1, -1, -1, -1,  0,  0, -1, -1, -1, -1, -1,
+    47, 11, -1, -1, -1, 17, -1, -1, 51, -1, -1, -1,  0, -1, -1, -1, -1, -1,  0,  0, -1, -1, -1, -1,
+     5, -1, 25, -1,  6, -1, 45, -1, 13, 40, -1, -1, -1, -1, -1, -1, -1, -1, -1,  0,  0, -1, -1, -1,
+    33, -1, -1, 34, 24, -1, -1, -1, 23, -1, -1, 46, -1, -1, -1, -1, -1, -1, -1, -1,  0,  0, -1, -1,
+     1, -1, 27, -1,  1, -1, -1, -1, 38, -1, 44, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  0,  0, -1,
+    -1, 18, -1, -1, 23, -1, -1,  8,  0, 35, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  0,  0,
+    49, -1, 17, -1, 30, -1, -1, -1, 34, -1, -1, 19,  1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  0,
+};
+
+static const signed char ldpc_base_r12_z81[12*24] = {
+    57, -1, -1, -1, 50, -1, 11, -1, 50, -1, 79, -1,  1,  0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+     3, -1, 28, -1,  0, -1, -1, -1, 55,  7, -1, -1, -1,  0,  0, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    30, -1, -1, -1, 24, 37, -1, -1, 56, 14, -1, -1, -1, -1,  0,  0, -1, -1, -1, -1, -1, -1, -1, -1,
+    62, 53, -1, -1, 53, -1, -1,  3, 35, -1, -1, -1, -1, -1, -1,  0,  0, -1, -1, -1, -1, -1, -1, -1,
+    40, -1, -1, 20, 66, -1, -1, 22, 28, -1, -1, -1, -1, -1, -1, -1,  0,  0, -1, -1, -1, -1, -1, -1,
+     0, -1, -1, -1,  8, -1, 42, -1, 50, -1, -1,  8, -1, -1, -1, -1, -1,  0,  0, -1, -1, -1, -1, -1,
+    69, 79, 79, -1, -1, -1, 56, -1, 52, -1, -1, -1,  0, -1, -1, -1, -1, -1,  0,  0, -1, -1, -1, -1,
+    65, -1, -1, -1, 38, 57, -1, -1, 72, -1, 27, -1, -1, -1, -1, -1, -1, -1, -1,  0,  0, -1, -1, -1,
+    64, -1, -1, -1, 14, 52, -1, -1, 30, -1, -1, 32, -1, -1, -1, -1, -1, -1, -1, -1,  0,  0, -1, -1,
+    -1, 45, -1, 70,  0, -1, -1, -1, 77,  9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  0,  0, -1,
+     2, 56, -1, 57, 35, -1, -1, -1, -1, -1, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  0,  0,
+    24, -1, 61, -1, 60, -1, -1, 27, 51, -1, -1, 16,  1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  0,
+};
+
+struct ldpc_s {
+    unsigned int n;                 // codeword length [bits]
+    unsigned int m;                 // number of parity checks
+    unsigned int k;                 // message length [bits], 0 if unknown
+    unsigned int max_iterations;    // maximum number of decoder iterations
+    unsigned int num_iterations;    // iterations used by last decode
+    float        alpha;             // min-sum normalization factor
+    float        beta;              // min-sum offset
+
+    // parity-check matrix, compressed sparse rows
+    unsigned int   num_edges;       // number of non-zero elements
+    unsigned int * row_ptr;         // start of each row [size: m+1 x 1]
+    unsigned int * col_idx;         // column of each element [size: num_edges x 1]
+    unsigned int   max_row_weight;  // maximum number of elements in a row
+
+    // floating-point decoder state (generic codes)
+    float * Lf;                     // posterior LLRs [size: n x 1]
+    float * Rf;                     // check messages [size: num_edges x 1]
+    float * Qf;                     // row scratch [size: max_row_weight x 1]
+
+    // quasi-cyclic structure (base == NULL for generic codes)
+    int *          base;            // circulant shifts, -1 for zero [size: mb x nb]
+    unsigned int   mb;              // base matrix rows
+    unsigned int   nb;              // base matrix columns
+    unsigned int   z;               // circulant size
+    unsigned int   zp;              // lanes per circulant, z rounded up
+    unsigned int   num_blocks;      // number of non-zero circulants
+    unsigned int * layer_ptr;       // start of each layer [size: mb+1 x 1]
+    unsigned int * block_col;       // base column of each circulant
+    unsigned int * block_shift;     // shift of each circulant
+    unsigned int   max_layer_weight;// maximum number of circulants in a layer
+    int            encodable;       // dual-diagonal parity section?
+    unsigned int   x_row;           // row of zero shift in first parity column
+
+    // fixed-point decoder state (quasi-cyclic codes)
+    int16_t * L;                    // posterior LLRs [size: nb*z x 1]
+    int16_t * R;                    // check messages [size: num_blocks*zp x 1]
+    int16_t * Q;                    // layer scratch [size: max_layer_weight*zp x 1]
+    uint16_t  alpha_q;              // 1-alpha in Q16
+    int16_t   beta_q;               // offset in fixed point
+};
+
+// allocate common arrays once row_ptr and col_idx are set
+static int ldpc_init_rows(ldpc _q);
+
+// decode generic code with floating-point messages
+static int ldpc_decode_float(ldpc _q, float * _llr, unsigned char * _c_hat);
+
+// decode quasi-cyclic code with fixed-point messages
+static int ldpc_decode_qc(ldpc _q, float * _llr, unsigned char * _c_hat);
+
+// create decoder from sparse binary parity-check matrix
+//  _H      :   parity-check matrix [size: m x n]
+ldpc ldpc_create(smatrixb _H)
+{
+    unsigned int m, n;
+    smatrixb_size(_H, &m, &n);
+    if (m == 0 || n == 0)
+        return liquid_error_config("ldpc_create(), matrix dimensions cannot be zero");
+    if (m >= n)
+        return liquid_error_config("ldpc_create(), matrix must have more columns than rows");
+
+    ldpc q = (ldpc) liquid_malloc(sizeof(struct ldpc_s));
+    memset(q, 0, sizeof(struct ldpc_s));
+    q->m = m;
+    q->n = n;
+
+    // compress rows
+    unsigned int i, num;
+    unsigned int idx[n];
+    q->row_ptr = (unsigned int*) liquid_malloc((m+1)*sizeof(unsigned int));
+    q->row_ptr[0] = 0;
+    for (i=0; i<m; i++) {
+        smatrixb_get_row(_H, i, idx, &num);
+        q->row_ptr[i+1] = q->row_ptr[i] + num;
+    }
+    q->num_edges = q->row_ptr[m];
+    q->col_idx = (unsigned int*) liquid_malloc(q->num_edges*sizeof(unsigned int));
+    for (i=0; i<m; i++)
+        smatrixb_get_row(_H, i, q->col_idx + q->row_ptr[i], &num);
+
+    ldpc_init_rows(q);
+    return q;
+}
+
+// create quasi-cyclic code from base matrix of circulant shifts
+//  _base   :   shift of each circulant, or -1 for zero [size: _mb x _nb]
+//  _mb     :   number of base matrix rows
+//  _nb     :   number of base matrix columns, _nb > _mb
+//  _z      :   circulant size
+ldpc ldpc_create_qc(int *        _base,
+                    unsigned int _mb,
+                    unsigned int _nb,
+                    unsigned int _z)
+{
+    if (_mb == 0 || _nb <= _mb)
+        return liquid_error_config("ldpc_create_qc(), base matrix must have more columns than rows");
+    if (_z == 0)
+        return liquid_error_config("ldpc_create_qc(), circulant size must be greater than zero");
+    unsigned int i, j, t;
+    for (i=0; i<_mb*_nb; i++) {
+        if (_base[i] >= (int)_z || _base[i] < -1)
+            return liquid_error_config("ldpc_create_qc(), shift out of range [-1,%u)", _z);
+    }
+
+    ldpc q = (ldpc) liquid_malloc(sizeof(struct ldpc_s));
+    memset(q, 0, sizeof(struct ldpc_s));
+    q->mb = _mb;
+    q->nb = _nb;
+    q->z  = _z;
+    q->zp = ((_z + LDPC_LANES - 1) / LDPC_LANES) * LDPC_LANES;
+    q->m  = _mb * _z;
+    q->n  = _nb * _z;
+    q->base = (int*) liquid_malloc(_mb*_nb*sizeof(int));
+    memmove(q->base, _base, _mb*_nb*sizeof(int));
+
+    // list circulants of each layer
+    for (i=0; i<_mb*_nb; i++)
+        q->num_blocks += _base[i] >= 0 ? 1 : 0;
+    q->layer_ptr   = (unsigned int*) liquid_malloc((_mb+1)*sizeof(unsigned int));
+    q->block_col   = (unsigned int*) liquid_malloc(q->num_blocks*sizeof(unsigned int));
+    q->block_shift = (unsigned int*) liquid_malloc(q->num_blocks*sizeof(unsigned int));
+    unsigned int e = 0;
+    for (i=0; i<_mb; i++) {
+        q->layer_ptr[i] = e;
+        for (j=0; j<_nb; j++) {
+            if (_base[i*_nb+j] < 0)
+                continue;
+            q->block_col[e]   = j;
+            q->block_shift[e] = _base[i*_nb+j];
+            e++;
+        }
+        if (e - q->layer_ptr[i] > q->max_layer_weight)
+            q->max_layer_weight = e - q->layer_ptr[i];
+    }
+    q->layer_ptr[_mb] = e;
+
+    // expand into compressed rows: row i*z+t connects to column j*z+(t+s)%z
+    q->num_edges = q->num_blocks * _z;
+    q->row_ptr = (unsigned int*) liquid_malloc((q->m+1)*sizeof(unsigned int));
+    q->col_idx = (unsigned int*) liquid_malloc(q->num_edges*sizeof(unsigned int));
+    unsigned int r = 0;
+    unsigned int c = 0;
+    for (i=0; i<_mb; i++) {
+        for (t=0; t<_z; t++) {
+            q->row_ptr[r++] = c;
+            for (e=q->layer_ptr[i]; e<q->layer_ptr[i+1]; e++)
+                q->col_idx[c++] = q->block_col[e]*_z + (t + q->block_shift[e]) % _z;
+        }
+    }
+    q->row_ptr[r] = c;
+    ldpc_init_rows(q);
+
+    // check for dual-diagonal parity section: first parity column has
+    // shifts {a,0,a} in rows {0,x,mb-1}, remaining columns are identity
+    // blocks in rows {j-1,j}
+    unsigned int kb = _nb - _mb;
+    q->encodable = _mb >= 3;
+    for (i=0; i<_mb && q->encodable; i++) {
+        int s = _base[i*_nb + kb];
+        if (i == 0 || i == _mb-1) {
+            if (s != _base[kb])
+                q->encodable = 0;
+        } else if (s == 0) {
+            if (q->x_row != 0)
+                q->encodable = 0;
+            q->x_row = i;
+        } else if (s != -1) {
+            q->encodable = 0;
+        }
+        for (j=1; j<_mb; j++) {
+            s = _base[i*_nb + kb + j];
+            if ( (i+1 == j || i == j) ? s != 0 : s != -1 )
+                q->encodable = 0;
+        }
+    }
+    if (q->x_row == 0 || _base[kb] < 0)
+        q->encodable = 0;
+    q->k = q->encodable ? kb*_z : 0;
+
+    // fixed-point decoder state
+    q->L = (int16_t*) liquid_malloc(q->n*sizeof(int16_t));
+    q->R = (int16_t*) liquid_malloc(q->num_blocks*q->zp*sizeof(int16_t));
+    // (scratch holds at least two blocks for parity check)
+    unsigned int num_scratch = q->max_layer_weight < 2 ? 2 : q->max_layer_weight;
+    q->Q = (int16_t*) liquid_malloc(num_scratch*q->zp*sizeof(int16_t));
+    memset(q->Q, 0, num_scratch*q->zp*sizeof(int16_t));
+    ldpc_set_min_sum(q, q->alpha, q->beta);
+    return q;
+}
+
+// create rate-1/2 quasi-cyclic code from built-in base matrix [12 x 24],
+// yielding codeword length n=24*_z; _z=27,54,81 give the IEEE 802.11n
+// codes of length 648, 1296, 1944, while other sizes scale the shifts
+// of the _z=27 matrix
+//  _z      :   circulant size
+ldpc ldpc_create_r12(unsigned int _z)
+{
+    if (_z < 2)
+        return liquid_error_config("ldpc_create_r12(), circulant size must be at least 2");
+
+    // select base matrix, scaling shifts for non-standard circulant sizes
+    const signed char * b = ldpc_base_r12_z27;
+    unsigned int z0 = 27;
+    switch (_z) {
+    case 54: b = ldpc_base_r12_z54; z0 = _z; break;
+    case 81: b = ldpc_base_r12_z81; z0 = _z; break;
+    default:;
+    }
+    int base[12*24];
+    unsigned int i;
+    for (i=0; i<12*24; i++)
+        base[i] = b[i] < 0 ? -1 : (b[i] * (int)_z) / (int)z0;
+    return ldpc_create_qc(base, 12, 24, _z);
+}
+
+// destroy object, freeing all internal memory
+int ldpc_destroy(ldpc _q)
+{
+    liquid_free(_q->row_ptr);
+    liquid_free(_q->col_idx);
+    liquid_free(_q->Lf);
+    liquid_free(_q->Rf);
+    liquid_free(_q->Qf);
+    liquid_free(_q->base);
+    liquid_free(_q->layer_ptr);
+    liquid_free(_q->block_col);
+    liquid_free(_q->block_shift);
+    liquid_free(_q->L);
+    liquid_free(_q->R);
+    liquid_free(_q->Q);
+    liquid_free(_q);
+    return LIQUID_OK;
+}
+
+// print object properties
+int ldpc_print(ldpc _q)
+{
+    printf("<ldpc, n=%u, m=%u, k=%u, edges=%u", _q->n, _q->m, _q->k, _q->num_edges);
+    if (_q->base != NULL)
+        printf(", base=%ux%u, z=%u, simd=%s", _q->mb, _q->nb, _q->z, LDPC_USE_SSE2 ? "sse2" : "none");
+    printf(", alpha=%g, beta=%g, iterations=%u>\n", _q->alpha, _q->beta, _q->max_iterations);
+    return LIQUID_OK;
+}
+
+// get codeword length [bits]
+unsigned int ldpc_get_n(ldpc _q)
+{
+    return _q->n;
+}
+
+// get message length [bits]; zero if encoding is not supported
+unsigned int ldpc_get_k(ldpc _q)
+{
+    return _q->k;
+}
+
+// set maximum number of decoder iterations
+int ldpc_set_max_iterations(ldpc         _q,
+                            unsigned int _n)
+{
+    if (_n == 0)
+        return liquid_error(LIQUID_EICONFIG,"ldpc_set_max_iterations(), number of iterations must be greater than zero");
+    _q->max_iterations = _n;
+    return LIQUID_OK;
+}
+
+// get number of iterations used by the last call to decode()
+unsigned int ldpc_get_num_iterations(ldpc _q)
+{
+    return _q->num_iterations;
+}
+
+// set min-sum correction: check messages are scaled by _alpha and then
+// reduced in magnitude by _beta
+//  _q      :   decoder object
+//  _alpha  :   normalization factor, 0.5 < _alpha <= 1
+//  _beta   :   offset, _beta >= 0
+int ldpc_set_min_sum(ldpc  _q,
+                     float _alpha,
+                     float _beta)
+{
+    if (_alpha <= 0.5f || _alpha > 1.0f)
+        return liquid_error(LIQUID_EICONFIG,"ldpc_set_min_sum(), normalization factor must be in (0.5,1]");
+    if (_beta < 0.0f)
+        return liquid_error(LIQUID_EICONFIG,"ldpc_set_min_sum(), offset cannot be negative");
+    _q->alpha   = _alpha;
+    _q->beta    = _beta;
+    _q->alpha_q = (uint16_t) lroundf((1.0f - _alpha)*65536.0f);
+    _q->beta_q  = (int16_t) lroundf(_beta*LDPC_LLR_SCALE < 32767.0f ? _beta*LDPC_LLR_SCALE : 32767.0f);
+    return LIQUID_OK;
+}
+
+// encode message (systematic): codeword is message followed by parity
+//  _q      :   code object
+//  _msg    :   message bits [size: k x 1]
+//  _c      :   codeword bits [size: n x 1]
+int ldpc_encode(ldpc            _q,
+                unsigned char * _msg,
+                unsigned char * _c)
+{
+    if (!_q->encodable)
+        return liquid_error(LIQUID_EUMODE,"ldpc_encode(), code does not have dual-diagonal parity structure");
+
+    unsigned int z  = _q->z;
+    unsigned int mb = _q->mb;
+    unsigned int kb = _q->nb - mb;
+    unsigned int i, t, e;
+    unsigned char lambda[mb*z];
+    unsigned char * p = _c + _q->k;
+
+    // message bits
+    for (i=0; i<_q->k; i++)
+        _c[i] = _msg[i] & 1;
+
+    // parity contribution of message in each layer
+    memset(lambda, 0, mb*z);
+    for (i=0; i<mb; i++) {
+        for (e=_q->layer_ptr[i]; e<_q->layer_ptr[i+1]; e++) {
+            unsigned int j = _q->block_col[e];
+            unsigned int s = _q->block_shift[e];
+            if (j >= kb)
+                break;
+            for (t=0; t<z; t++)
+                lambda[i*z + t] ^= _c[j*z + (t+s)%z];
+        }
+    }
+
+    // first parity block is sum of all layers (other parity blocks and
+    // the two equal shifts of the first cancel)
+    memset(p, 0, z);
+    for (i=0; i<mb; i++) {
+        for (t=0; t<z; t++)
+            p[t] ^= lambda[i*z + t];
+    }
+
+    // remaining parity blocks by back-substitution along dual diagonal
+    unsigned int a = _q->base[kb];
+    for (t=0; t<z; t++)
+        p[z + t] = lambda[t] ^ p[(t+a)%z];
+    for (i=1; i<mb-1; i++) {
+        for (t=0; t<z; t++) {
+            p[(i+1)*z + t] = lambda[i*z + t] ^ p[i*z + t] ^ (i == _q->x_row ? p[t] : 0);
+        }
+    }
+    return LIQUID_OK;
+}
+
+// check parity of codeword; returns 1 if all checks pass, 0 otherwise
+//  _q      :   code object
+//  _c      :   codeword bits [size: n x 1]
+int ldpc_check(ldpc            _q,
+               unsigned char * _c)
+{
+    unsigned int i, e;
+    for (i=0; i<_q->m; i++) {
+        unsigned char parity = 0;
+        for (e=_q->row_ptr[i]; e<_q->row_ptr[i+1]; e++)
+            parity ^= _c[_q->col_idx[e]];
+        if (parity & 1)
+            return 0;
+    }
+    return 1;
+}
+
+// decode codeword from log-likelihood ratios (positive for bit 0);
+// returns 1 if all parity checks pass, 0 otherwise
+//  _q      :   code object
+//  _llr    :   log-likelihood ratios [size: n x 1]
+//  _c_hat  :   estimated codeword bits [size: n x 1]
+int ldpc_decode(ldpc            _q,
+                float *         _llr,
+                unsigned char * _c_hat)
+{
+    return _q->base == NULL ? ldpc_decode_float(_q, _llr, _c_hat) :
+                              ldpc_decode_qc   (_q, _llr, _c_hat);
+}
+
+//
+// internal methods
+//
+
+// allocate common arrays once row_ptr and col_idx are set
+static int ldpc_init_rows(ldpc _q)
+{
+    unsigned int i;
+    for (i=0; i<_q->m; i++) {
+        unsigned int w = _q->row_ptr[i+1] - _q->row_ptr[i];
+        if (w > _q->max_row_weight)
+            _q->max_row_weight = w;
+    }
+    _q->Lf = (float*) liquid_malloc(_q->n*sizeof(float));
+    _q->Rf = (float*) liquid_malloc(_q->num_edges*sizeof(float));
+    _q->Qf = (float*) liquid_malloc((_q->max_row_weight+1)*sizeof(float));
+    _q->max_iterations = 50;
+    _q->alpha = 0.75f;
+    _q->beta  = 0.0f;
+    return LIQUID_OK;
+}
+
+// decode generic code with floating-point messages, one row per layer
+static int ldpc_decode_float(ldpc            _q,
+                             float *         _llr,
+                             unsigned char * _c_hat)
+{
+    unsigned int i, e, it;
+    memmove(_q->Lf, _llr, _q->n*sizeof(float));
+    memset(_q->Rf, 0, _q->num_edges*sizeof(float));
+    int parity_pass = 0;
+    for (it=0; it<_q->max_iterations && !parity_pass; it++) {
+        for (i=0; i<_q->m; i++) {
+            unsigned int e0 = _q->row_ptr[i];
+            unsigned int e1 = _q->row_ptr[i+1];
+            float min1 = INFINITY, min2 = INFINITY;
+            unsigned int idx = 0;
+            int sgn = 0;
+            for (e=e0; e<e1; e++) {
+                float v = _q->Lf[_q->col_idx[e]] - _q->Rf[e];
+                float a = fabsf(v);
+                _q->Qf[e-e0] = v;
+                sgn ^= v < 0;
+                if (a < min1) {
+                    min2 = min1;
+                    min1 = a;
+                    idx  = e;
+                } else if (a < min2) {
+                    min2 = a;
+                }
+            }
+            min1 = fmaxf(_q->alpha*min1 - _q->beta, 0.0f);
+            min2 = fmaxf(_q->alpha*min2 - _q->beta, 0.0f);
+            for (e=e0; e<e1; e++) {
+                float v = _q->Qf[e-e0];
+                float r = e == idx ? min2 : min1;
+                _q->Rf[e] = (sgn ^ (v < 0)) ? -r : r;
+                _q->Lf[_q->col_idx[e]] = v + _q->Rf[e];
+            }
+        }
+        for (i=0; i<_q->n; i++)
+            _c_hat[i] = _q->Lf[i] < 0.0f ? 1 : 0;
+        parity_pass = ldpc_check(_q, _c_hat);
+    }
+    _q->num_iterations = it;
+    return parity_pass;
+}
+
+// saturate to 16-bit range
+static inline int16_t ldpc_sat16(int _x)
+{
+    return _x > 32767 ? 32767 : (_x < -32767 ? -32767 : (int16_t)_x);
+}
+
+// process one layer: compute new check messages and posteriors for each
+// lane from the gathered posteriors in Q [size: _d*zp x 1], updating R
+static void ldpc_layer(ldpc      _q,
+                       int16_t * _R,
+                       unsigned int _d)
+{
+    unsigned int zp = _q->zp;
+    unsigned int e, v;
+    int16_t * Q = _q->Q;
+#if LDPC_USE_SSE2
+    const __m128i zero  = _mm_setzero_si128();
+    const __m128i big   = _mm_set1_epi16(32767);
+    const __m128i alpha = _mm_set1_epi16((short)_q->alpha_q);
+    const __m128i beta  = _mm_set1_epi16(_q->beta_q);
+    for (v=0; v<zp; v+=LDPC_LANES) {
+        __m128i min1 = big, min2 = big, idx = zero, sgn = zero;
+        for (e=0; e<_d; e++) {
+            __m128i q = _mm_subs_epi16(_mm_load_si128((__m128i*)&Q[e*zp+v]),
+                                       _mm_load_si128((__m128i*)&_R[e*zp+v]));
+            _mm_store_si128((__m128i*)&Q[e*zp+v], q);
+            __m128i a  = _mm_max_epi16(q, _mm_subs_epi16(zero, q));
+            __m128i lt = _mm_cmplt_epi16(a, min1);
+            min2 = _mm_min_epi16(min2, _mm_max_epi16(a, min1));
+            min1 = _mm_min_epi16(min1, a);
+            idx  = _mm_or_si128(_mm_andnot_si128(lt, idx), _mm_and_si128(lt, _mm_set1_epi16(e)));
+            sgn  = _mm_xor_si128(sgn, q);
+        }
+        // normalize and offset: m*alpha - beta = m - m*(1-alpha) - beta
+        min1 = _mm_max_epi16(_mm_subs_epi16(_mm_sub_epi16(min1, _mm_mulhi_epu16(min1, alpha)), beta), zero);
+        min2 = _mm_max_epi16(_mm_subs_epi16(_mm_sub_epi16(min2, _mm_mulhi_epu16(min2, alpha)), beta), zero);
+        for (e=0; e<_d; e++) {
+            __m128i q   = _mm_load_si128((__m128i*)&Q[e*zp+v]);
+            __m128i eq  = _mm_cmpeq_epi16(idx, _mm_set1_epi16(e));
+            __m128i mag = _mm_or_si128(_mm_andnot_si128(eq, min1), _mm_and_si128(eq, min2));
+            __m128i neg = _mm_srai_epi16(_mm_xor_si128(sgn, q), 15);
+            __m128i r   = _mm_sub_epi16(_mm_xor_si128(mag, neg), neg);
+            _mm_store_si128((__m128i*)&_R[e*zp+v], r);
+            _mm_store_si128((__m128i*)&Q[e*zp+v], _mm_adds_epi16(q, r));
+        }
+    }
+#else
+    for (v=0; v<zp; v++) {
+        int min1 = 32767, min2 = 32767, sgn = 0;
+        unsigned int idx = 0;
+        for (e=0; e<_d; e++) {
+            int q = ldpc_sat16(Q[e*zp+v] - _R[e*zp+v]);
+            int a = q < 0 ? -q : q;
+            Q[e*zp+v] = q;
+            sgn ^= q < 0;
+            if (a < min1) {
+                min2 = min1;
+                min1 = a;
+                idx  = e;
+            } else if (a < min2) {
+                min2 = a;
+            }
+        }
+        min1 = min1 - ((min1 * _q->alpha_q) >> 16) - _q->beta_q;
+        min2 = min2 - ((min2 * _q->alpha_q) >> 16) - _q->beta_q;
+        min1 = min1 < 0 ? 0 : min1;
+        min2 = min2 < 0 ? 0 : min2;
+        for (e=0; e<_d; e++) {
+            int q = Q[e*zp+v];
+            int r = e == idx ? min2 : min1;
+            r = (sgn ^ (q < 0)) ? -r : r;
+            _R[e*zp+v] = r;
+            Q[e*zp+v]  = ldpc_sat16(q + r);
+        }
+    }
+#endif
+}
+
+// gather posteriors of circulant into lanes: lane t takes column (t+s)%z
+static inline void ldpc_gather(ldpc _q, int16_t * _dst, unsigned int _col, unsigned int _s)
+{
+    int16_t * L = _q->L + _col*_q->z;
+    memmove(_dst,                L + _s, (_q->z - _s)*sizeof(int16_t));
+    memmove(_dst + _q->z - _s,   L,       _s         *sizeof(int16_t));
+}
+
+// scatter lanes of circulant back to posteriors
+static inline void ldpc_scatter(ldpc _q, int16_t * _src, unsigned int _col, unsigned int _s)
+{
+    int16_t * L = _q->L + _col*_q->z;
+    memmove(L + _s, _src,                (_q->z - _s)*sizeof(int16_t));
+    memmove(L,      _src + _q->z - _s,    _s         *sizeof(int16_t));
+}
+
+// check all parity constraints against signs of posteriors
+static int ldpc_check_qc(ldpc _q)
+{
+    unsigned int i, e, t;
+    unsigned int z = _q->z;
+    int16_t * acc = _q->Q;  // first lane block of scratch
+    int16_t * tmp = _q->Q + _q->zp;
+    for (i=0; i<_q->mb; i++) {
+        memset(acc, 0, z*sizeof(int16_t));
+        for (e=_q->layer_ptr[i]; e<_q->layer_ptr[i+1]; e++) {
+            ldpc_gather(_q, tmp, _q->block_col[e], _q->block_shift[e]);
+            for (t=0; t<z; t++)
+                acc[t] ^= tmp[t];
+        }
+        for (t=0; t<z; t++) {
+            if (acc[t] < 0)
+                return 0;
+        }
+    }
+    return 1;
+}
+
+// decode quasi-cyclic code with fixed-point messages
+static int ldpc_decode_qc(ldpc            _q,
+                          float *         _llr,
+                          unsigned char * _c_hat)
+{
+    unsigned int i, e, it;
+    unsigned int zp = _q->zp;
+
+    // quantize input
+    for (i=0; i<_q->n; i++) {
+        float v = _llr[i] * LDPC_LLR_SCALE;
+        v = v >  LDPC_LLR_MAX ?  LDPC_LLR_MAX : v;
+        v = v < -LDPC_LLR_MAX ? -LDPC_LLR_MAX : v;
+        _q->L[i] = (int16_t) lroundf(v);
+    }
+    memset(_q->R, 0, _q->num_blocks*zp*sizeof(int16_t));
+
+    int parity_pass = 0;
+    for (it=0; it<_q->max_iterations && !parity_pass; it++) {
+        for (i=0; i<_q->mb; i++) {
+            unsigned int e0 = _q->layer_ptr[i];
+            unsigned int d  = _q->layer_ptr[i+1] - e0;
+            for (e=0; e<d; e++)
+                ldpc_gather(_q, _q->Q + e*zp, _q->block_col[e0+e], _q->block_shift[e0+e]);
+            ldpc_layer(_q, _q->R + e0*zp, d);
+            for (e=0; e<d; e++)
+                ldpc_scatter(_q, _q->Q + e*zp, _q->block_col[e0+e], _q->block_shift[e0+e]);
+        }
+        parity_pass = ldpc_check_qc(_q);
+    }
+    _q->num_iterations = it;
+
+    for (i=0; i<_q->n; i++)
+        _c_hat[i] = _q->L[i] < 0 ? 1 : 0;
+    return parity_pass;
+}
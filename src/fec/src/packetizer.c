@@ -33,6 +33,24 @@
 // reallocate memory for buffers
 void packetizer_realloc_buffers(packetizer _p, unsigned int _len);
 
+// compile execution plan, eliding pass-through stages
+void packetizer_compile(packetizer _p);
+
+// encode/decode single packet using compiled plan
+void packetizer_encode_packet(packetizer            _p,
+                              const unsigned char * _msg,
+                              unsigned char *       _pkt);
+int  packetizer_decode_packet(packetizer            _p,
+                              const unsigned char * _pkt,
+                              unsigned char *       _msg);
+int  packetizer_decode_soft_packet(packetizer            _p,
+                                   const unsigned char * _pkt,
+                                   unsigned char *       _msg);
+
+// strip whitening and crc from buffer[0], copy to output and validate
+int packetizer_decode_finish(packetizer      _p,
+                             unsigned char * _msg);
+
 // computes the number of encoded bytes after packetizing
 //
 //  _n      :   number of uncoded input bytes
@@ -103,9 +121,8 @@ packetizer packetizer_create(unsigned int _n,
     p->crc_length   = crc_get_length(p->check);
 
     // allocate memory for buffers (scale by 8 for soft decoding)
-    p->buffer_len = p->packet_len;
-    p->buffer_0 = (unsigned char*) malloc(8*p->buffer_len);
-    p->buffer_1 = (unsigned char*) malloc(8*p->buffer_len);
+    p->arena = NULL;
+    packetizer_realloc_buffers(p, p->packet_len);
 
     // create plan
     p->plan_len = 2;
@@ -136,6 +153,10 @@ packetizer packetizer_create(unsigned int _n,
         n0 = p->plan[i].enc_msg_len;
     }
 
+    // compile execution plan
+    p->exec = (unsigned int*) malloc((p->plan_len)*sizeof(unsigned int));
+    packetizer_compile(p);
+
     return p;
 }
 
@@ -189,10 +210,10 @@ void packetizer_destroy(packetizer _p)
 
     // free plan
     free(_p->plan);
+    free(_p->exec);
 
     // free buffers
-    free(_p->buffer_0);
-    free(_p->buffer_1);
+    free(_p->arena);
 
     // free packetizer object
     free(_p);
@@ -251,145 +272,275 @@ fec_scheme packetizer_get_fec1(packetizer _p)
 void packetizer_encode(packetizer            _p,
                        const unsigned char * _msg,
                        unsigned char *       _pkt)
+{
+    packetizer_encode_packet(_p, _msg, _pkt);
+}
+
+// Execute the packetizer to decode an input message, return validity
+// check of resulting data
+//
+//  _p      :   packetizer object
+//  _pkt    :   input message (coded bytes)
+//  _msg    :   decoded output message
+int packetizer_decode(packetizer            _p,
+                      const unsigned char * _pkt,
+                      unsigned char *       _msg)
+{
+    return packetizer_decode_packet(_p, _pkt, _msg);
+}
+
+// Execute the packetizer to decode an input message, return validity
+// check of resulting data
+//
+//  _p      :   packetizer object
+//  _pkt    :   input message (coded soft bits)
+//  _msg    :   decoded output message
+int packetizer_decode_soft(packetizer            _p,
+                           const unsigned char * _pkt,
+                           unsigned char *       _msg)
+{
+    return packetizer_decode_soft_packet(_p, _pkt, _msg);
+}
+
+// Execute the packetizer on a batch of independent input messages
+//
+//  _p      :   packetizer object
+//  _num    :   number of messages in batch
+//  _msg    :   input messages (uncoded bytes) [size: _num*dec_msg_len x 1]
+//  _pkt    :   encoded output messages [size: _num*enc_msg_len x 1]
+void packetizer_encode_batch(packetizer            _p,
+                             unsigned int          _num,
+                             const unsigned char * _msg,
+                             unsigned char *       _pkt)
 {
     unsigned int i;
+    for (i=0; i<_num; i++) {
+        packetizer_encode_packet(_p,
+                                 _msg == NULL ? NULL : _msg + i*_p->msg_len,
+                                 _pkt + i*_p->packet_len);
+    }
+}
+
+// Execute the packetizer to decode a batch of independent input
+// messages, returning the number of messages which pass the check
+//
+//  _p      :   packetizer object
+//  _num    :   number of messages in batch
+//  _pkt    :   input messages (coded bytes) [size: _num*enc_msg_len x 1]
+//  _msg    :   decoded output messages [size: _num*dec_msg_len x 1]
+//  _valid  :   validity check of each message (ignored if NULL) [size: _num x 1]
+unsigned int packetizer_decode_batch(packetizer            _p,
+                                     unsigned int          _num,
+                                     const unsigned char * _pkt,
+                                     unsigned char *       _msg,
+                                     int *                 _valid)
+{
+    unsigned int i;
+    unsigned int num_valid = 0;
+    for (i=0; i<_num; i++) {
+        int valid = packetizer_decode_packet(_p,
+                                             _pkt + i*_p->packet_len,
+                                             _msg + i*_p->msg_len);
+        num_valid += valid ? 1 : 0;
+        if (_valid != NULL)
+            _valid[i] = valid;
+    }
+    return num_valid;
+}
+
+// Execute the packetizer to decode a batch of independent input
+// messages, returning the number of messages which pass the check
+//
+//  _p      :   packetizer object
+//  _num    :   number of messages in batch
+//  _pkt    :   input messages (coded soft bits) [size: 8*_num*enc_msg_len x 1]
+//  _msg    :   decoded output messages [size: _num*dec_msg_len x 1]
+//  _valid  :   validity check of each message (ignored if NULL) [size: _num x 1]
+unsigned int packetizer_decode_soft_batch(packetizer            _p,
+                                          unsigned int          _num,
+                                          const unsigned char * _pkt,
+                                          unsigned char *       _msg,
+                                          int *                 _valid)
+{
+    unsigned int i;
+    unsigned int num_valid = 0;
+    for (i=0; i<_num; i++) {
+        int valid = packetizer_decode_soft_packet(_p,
+                                                  _pkt + 8*i*_p->packet_len,
+                                                  _msg + i*_p->msg_len);
+        num_valid += valid ? 1 : 0;
+        if (_valid != NULL)
+            _valid[i] = valid;
+    }
+    return num_valid;
+}
+
+void packetizer_set_scheme(packetizer _p, int _fec0, int _fec1)
+{
+    //
+}
+
+// 
+// internal methods
+//
+
+// reallocate memory for buffers; both buffers share a single arena
+// with buffer[1] scaled by 8 to hold soft bits
+void packetizer_realloc_buffers(packetizer _p, unsigned int _len)
+{
+    _p->buffer_len = _len;
+    _p->arena    = (unsigned char*) realloc(_p->arena, 9*_p->buffer_len);
+    _p->buffer_0 = _p->arena;
+    _p->buffer_1 = _p->arena + _p->buffer_len;
+}
+
+// compile execution plan, eliding pass-through stages
+void packetizer_compile(packetizer _p)
+{
+    // stages without error correction have their interleaver depth set
+    // to zero and so only copy data; skip them entirely
+    unsigned int i;
+    _p->exec_len = 0;
+    for (i=0; i<_p->plan_len; i++) {
+        if (_p->plan[i].fs != LIQUID_FEC_NONE)
+            _p->exec[_p->exec_len++] = i;
+    }
+}
+
+// encode single packet using compiled plan
+void packetizer_encode_packet(packetizer            _p,
+                              const unsigned char * _msg,
+                              unsigned char *       _pkt)
+{
+    unsigned int i;
+
+    // with no active stages the whitened message is the packet itself,
+    // so build it directly in the output buffer
+    unsigned char * x = _p->exec_len == 0 ? _pkt : _p->buffer_0;
 
-    // copy input message to internal buffer[0] (or initialize to zeros)
+    // copy input message to working buffer (or initialize to zeros)
     if (_msg != NULL) {
         // copy user-defined input
-        memmove(_p->buffer_0, _msg, _p->msg_len);
+        memmove(x, _msg, _p->msg_len);
     } else {
         // initialize with zeros
-        memset(_p->buffer_0, 0x00, _p->msg_len);
+        memset(x, 0x00, _p->msg_len);
     }
 
     // compute crc, append to buffer
-    unsigned int key = crc_generate_key(_p->check, _p->buffer_0, _p->msg_len);
+    unsigned int key = crc_generate_key(_p->check, x, _p->msg_len);
     for (i=0; i<_p->crc_length; i++) {
         // append byte to buffer
-        _p->buffer_0[_p->msg_len+_p->crc_length-i-1] = key & 0xff;
+        x[_p->msg_len+_p->crc_length-i-1] = key & 0xff;
 
         // shift key by 8 bits
         key >>= 8;
     }
 
     // whiten input sequence
-    scramble_data(_p->buffer_0, _p->msg_len + _p->crc_length);
+    scramble_data(x, _p->msg_len + _p->crc_length);
+
+    // execute active fec/interleaver stages; the last interleaver writes
+    // directly to the output
+    for (i=0; i<_p->exec_len; i++) {
+        struct fecintlv_plan * s = &_p->plan[_p->exec[i]];
+        unsigned char * y = (i == _p->exec_len-1) ? _pkt : _p->buffer_0;
 
-    // execute fec/interleaver plans
-    for (i=0; i<_p->plan_len; i++) {
         // run the encoder: buffer[0] > buffer[1]
-        fec_encode(_p->plan[i].f,
-                   _p->plan[i].dec_msg_len,
-                   _p->buffer_0,
-                   _p->buffer_1);
-
-        // run the interleaver: buffer[1] > buffer[0]
-        interleaver_encode(_p->plan[i].q,
-                           _p->buffer_1,
-                           _p->buffer_0);
-    }
+        fec_encode(s->f, s->dec_msg_len, x, _p->buffer_1);
 
-    // copy result to output
-    memmove(_pkt, _p->buffer_0, _p->packet_len);
+        // run the interleaver: buffer[1] > buffer[0] (or output)
+        interleaver_encode(s->q, _p->buffer_1, y);
+        x = y;
+    }
 }
 
-// Execute the packetizer to decode an input message, return validity
-// check of resulting data
-//
-//  _p      :   packetizer object
-//  _pkt    :   input message (coded bytes)
-//  _msg    :   decoded output message
-int packetizer_decode(packetizer            _p,
-                      const unsigned char * _pkt,
-                      unsigned char *       _msg)
+// decode single packet using compiled plan
+int packetizer_decode_packet(packetizer            _p,
+                             const unsigned char * _pkt,
+                             unsigned char *       _msg)
 {
-    // copy coded message to internal buffer[0]
-    memmove(_p->buffer_0, _pkt, _p->packet_len);
-
-    // execute fec/interleaver plans
-    unsigned int i;
-    for (i=_p->plan_len; i>0; i--) {
-        // run the de-interleaver: buffer[0] > buffer[1]
-        interleaver_decode(_p->plan[i-1].q,
-                           _p->buffer_0,
-                           _p->buffer_1);
-
-        // run the decoder: buffer[1] > buffer[0]
-        fec_decode(_p->plan[i-1].f,
-                   _p->plan[i-1].dec_msg_len,
-                   _p->buffer_1,
-                   _p->buffer_0);
+    if (_p->exec_len == 0) {
+        // nothing to decode; copy coded message to internal buffer[0]
+        memmove(_p->buffer_0, _pkt, _p->packet_len);
     }
 
-    // remove sequence whitening
-    unscramble_data(_p->buffer_0, _p->msg_len + _p->crc_length);
+    // execute active fec/interleaver stages in reverse order; the first
+    // de-interleaver reads directly from the input
+    unsigned char * x = (unsigned char*)_pkt;
+    unsigned int i;
+    for (i=_p->exec_len; i>0; i--) {
+        struct fecintlv_plan * s = &_p->plan[_p->exec[i-1]];
 
-    // strip crc, validate message
-    unsigned int key = 0;
-    for (i=0; i<_p->crc_length; i++) {
-        key <<= 8;
+        // run the de-interleaver: input (or buffer[0]) > buffer[1]
+        interleaver_decode(s->q, x, _p->buffer_1);
 
-        key |= _p->buffer_0[_p->msg_len+i];
+        // run the decoder: buffer[1] > buffer[0]
+        fec_decode(s->f, s->dec_msg_len, _p->buffer_1, _p->buffer_0);
+        x = _p->buffer_0;
     }
 
-    // copy result to output
-    memmove(_msg, _p->buffer_0, _p->msg_len);
-
-    // return crc validity
-    return crc_validate_message(_p->check,
-                                _p->buffer_0,
-                                _p->msg_len,
-                                key);
+    return packetizer_decode_finish(_p, _msg);
 }
 
-// Execute the packetizer to decode an input message, return validity
-// check of resulting data
-//
-//  _p      :   packetizer object
-//  _pkt    :   input message (coded soft bits)
-//  _msg    :   decoded output message
-int packetizer_decode_soft(packetizer            _p,
-                           const unsigned char * _pkt,
-                           unsigned char *       _msg)
+// decode single packet of soft bits using compiled plan
+int packetizer_decode_soft_packet(packetizer            _p,
+                                  const unsigned char * _pkt,
+                                  unsigned char *       _msg)
 {
-    // copy coded message to internal buffer[0]
-    memmove(_p->buffer_0, _pkt, 8*_p->packet_len);
+    unsigned char * x = (unsigned char*)_pkt;
+    unsigned int i;
+    unsigned int n = _p->exec_len;
+    struct fecintlv_plan * s = &_p->plan[_p->plan_len-1];
 
-    // 
+    //
     // decode outer level using soft decoding
     //
+    if (s->fs != LIQUID_FEC_NONE) {
+        // run the de-interleaver: input > buffer[1]
+        interleaver_decode_soft(s->q, x, _p->buffer_1);
 
-    // run the de-interleaver: buffer[0] > buffer[1]
-    interleaver_decode_soft(_p->plan[1].q,
-                            _p->buffer_0,
-                            _p->buffer_1);
-
-    // run the decoder: buffer[1] > buffer[0]
-    fec_decode_soft(_p->plan[1].f,
-                    _p->plan[1].dec_msg_len,
-                    _p->buffer_1,
-                    _p->buffer_0);
+        // run the decoder: buffer[1] > buffer[0]
+        fec_decode_soft(s->f, s->dec_msg_len, _p->buffer_1, _p->buffer_0);
+        n--;
+    } else {
+        // pass-through: slice soft bits directly into buffer[0]
+        for (i=0; i<s->enc_msg_len; i++) {
+            _p->buffer_0[i] = ((x[8*i+0] >> 0) & 0x80) |
+                              ((x[8*i+1] >> 1) & 0x40) |
+                              ((x[8*i+2] >> 2) & 0x20) |
+                              ((x[8*i+3] >> 3) & 0x10) |
+                              ((x[8*i+4] >> 4) & 0x08) |
+                              ((x[8*i+5] >> 5) & 0x04) |
+                              ((x[8*i+6] >> 6) & 0x02) |
+                              ((x[8*i+7] >> 7) & 0x01);
+        }
+    }
 
-    // 
-    // decode inner level using hard decoding
     //
+    // decode remaining inner levels using hard decoding
+    //
+    for (i=n; i>0; i--) {
+        s = &_p->plan[_p->exec[i-1]];
 
-    // run the de-interleaver: buffer[0] > buffer[1]
-    interleaver_decode(_p->plan[0].q,
-                       _p->buffer_0,
-                       _p->buffer_1);
+        // run the de-interleaver: buffer[0] > buffer[1]
+        interleaver_decode(s->q, _p->buffer_0, _p->buffer_1);
 
-    // run the decoder: buffer[1] > buffer[0]
-    fec_decode(_p->plan[0].f,
-               _p->plan[0].dec_msg_len,
-               _p->buffer_1,
-               _p->buffer_0);
+        // run the decoder: buffer[1] > buffer[0]
+        fec_decode(s->f, s->dec_msg_len, _p->buffer_1, _p->buffer_0);
+    }
 
+    return packetizer_decode_finish(_p, _msg);
+}
+
+// strip whitening and crc from buffer[0], copy to output and validate
+int packetizer_decode_finish(packetizer      _p,
+                             unsigned char * _msg)
+{
     // remove sequence whitening
     unscramble_data(_p->buffer_0, _p->msg_len + _p->crc_length);
 
-    // strip crc, validate message
+    // strip crc
     unsigned int key = 0;
     unsigned int i;
     for (i=0; i<_p->crc_length; i++) {
@@ -408,19 +559,3 @@ int packetizer_decode_soft(packetizer            _p,
                                 key);
 }
 
-void packetizer_set_scheme(packetizer _p, int _fec0, int _fec1)
-{
-    //
-}
-
-// 
-// internal methods
-//
-
-void packetizer_realloc_buffers(packetizer _p, unsigned int _len)
-{
-    _p->buffer_len = _len;
-    _p->buffer_0 = (unsigned char*) realloc(_p->buffer_0, _p->buffer_len);
-    _p->buffer_1 = (unsigned char*) realloc(_p->buffer_1, _p->buffer_len);
-}
-
@@ -105,6 +105,11 @@ void autotest_fec_secded2216() { fec_test_codec(LIQUID_FEC_SECDED2216, 64, NULL)
 void autotest_fec_secded3932() { fec_test_codec(LIQUID_FEC_SECDED3932, 64, NULL); }
 void autotest_fec_secded7264() { fec_test_codec(LIQUID_FEC_SECDED7264, 64, NULL); }
 
+// low-density parity-check codes
+void autotest_fec_ldpc648()    { fec_test_codec(LIQUID_FEC_LDPC_R12_N648,  64, NULL); }
+void autotest_fec_ldpc1296()   { fec_test_codec(LIQUID_FEC_LDPC_R12_N1296, 64, NULL); }
+void autotest_fec_ldpc1944()   { fec_test_codec(LIQUID_FEC_LDPC_R12_N1944,300, NULL); }
+
 // convolutional codes
 void autotest_fec_v27()     { fec_test_codec(LIQUID_FEC_CONV_V27,      64, NULL); }
 void autotest_fec_v29()     { fec_test_codec(LIQUID_FEC_CONV_V29,      64, NULL); }
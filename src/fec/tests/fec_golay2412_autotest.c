@@ -105,3 +105,62 @@ void autotest_golay2412_codec()
     }
 }
 
+
+//
+// AUTOTEST: Golay(24,12) block decoding matches symbol-wise decoding
+//           for random received data (any number of errors)
+//
+void autotest_golay2412_block()
+{
+    unsigned int n = 3;     // two 24-bit symbols
+    unsigned char msg_enc[6];
+    unsigned char msg_dec[3];
+
+    fec q = fec_create(LIQUID_FEC_GOLAY2412,NULL);
+    unsigned int i, t;
+    for (t=0; t<200; t++) {
+        for (i=0; i<6; i++)
+            msg_enc[i] = rand() & 0xff;
+        fec_decode(q, n, msg_enc, msg_dec);
+
+        unsigned int v0 = (msg_enc[0] << 16) | (msg_enc[1] << 8) | msg_enc[2];
+        unsigned int v1 = (msg_enc[3] << 16) | (msg_enc[4] << 8) | msg_enc[5];
+        unsigned int m0 = fec_golay2412_decode_symbol(v0);
+        unsigned int m1 = fec_golay2412_decode_symbol(v1);
+        CONTEND_EQUALITY(msg_dec[0],  (m0 >> 4) & 0xff);
+        CONTEND_EQUALITY(msg_dec[1], ((m0 << 4) & 0xf0) | ((m1 >> 8) & 0x0f));
+        CONTEND_EQUALITY(msg_dec[2],   m1       & 0xff);
+    }
+    fec_destroy(q);
+}
+
+//
+// AUTOTEST: Golay(24,12) soft decoding corrects four errors on the
+//           least reliable bits (beyond hard-decision capability)
+//
+void autotest_golay2412_codec_soft()
+{
+    unsigned int num_trials=50; // number of symbol trials
+    unsigned char soft[24];     // soft bits
+    unsigned int i, t;
+
+    for (t=0; t<num_trials; t++) {
+        // generate and encode symbol
+        unsigned int sym_org = rand() % (1<<12);
+        unsigned int sym_enc = fec_golay2412_encode_symbol(sym_org);
+
+        // strong soft bits with four weak errors
+        unsigned int e = golay2412_generate_error_vector(4);
+        for (i=0; i<24; i++) {
+            unsigned int bit = (sym_enc >> (23-i)) & 1;
+            if ((e >> (23-i)) & 1)
+                soft[i] = bit ? 120 : 135;
+            else
+                soft[i] = bit ? 240 : 15;
+        }
+
+        // decode
+        unsigned int sym_dec = fecsoft_golay2412_decode(soft);
+        CONTEND_EQUALITY(sym_org, sym_dec);
+    }
+}
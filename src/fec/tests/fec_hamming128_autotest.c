@@ -103,3 +103,40 @@ void autotest_hamming128_codec_soft()
     }
 }
 
+
+//
+// AUTOTEST: Hamming (12,8) block decoding matches symbol-wise decoding
+//           (hard and soft) for random received data
+//
+void autotest_hamming128_block()
+{
+    unsigned int n = 23;
+    fec_scheme fs = LIQUID_FEC_HAMMING128;
+    unsigned int n_enc = fec_get_enc_msg_length(fs,n);
+    unsigned char msg_enc[n_enc];
+    unsigned char msg_soft[8*n_enc];
+    unsigned char msg_dec[n];
+
+    fec q = fec_create(fs,NULL);
+    unsigned int i, t;
+    for (t=0; t<20; t++) {
+        // hard decoding of random 12-bit symbols
+        for (i=0; i<n_enc; i++)
+            msg_enc[i] = rand() & 0xff;
+        fec_decode(q, n, msg_enc, msg_dec);
+        for (i=0; i<n; i++) {
+            unsigned int b = 12*i;
+            unsigned int r = ((msg_enc[b/8] << 8) | (b/8+1 < n_enc ? msg_enc[b/8+1] : 0));
+            r = (r >> (4 - b%8)) & 0x0fff;
+            CONTEND_EQUALITY(msg_dec[i], fec_hamming128_decode_symbol(r));
+        }
+
+        // soft decoding of random soft bits
+        for (i=0; i<8*n_enc; i++)
+            msg_soft[i] = rand() & 0xff;
+        fec_decode_soft(q, n, msg_soft, msg_dec);
+        for (i=0; i<n; i++)
+            CONTEND_EQUALITY(msg_dec[i], fecsoft_hamming128_decode_n3(&msg_soft[12*i]));
+    }
+    fec_destroy(q);
+}
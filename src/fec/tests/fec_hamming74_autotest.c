@@ -20,6 +20,9 @@
  * THE SOFTWARE.
  */
 
+#include <stdlib.h>
+#include <string.h>
+
 #include "autotest/autotest.h"
 #include "liquid.internal.h"
 
@@ -99,3 +102,73 @@ void autotest_hamming74_codec_soft()
     }
 }
 
+
+//
+// AUTOTEST: Hamming (7,4) block encoder/decoder against symbol-wise
+//           packing, for lengths that exercise the remainder path
+//
+void autotest_hamming74_block()
+{
+    fec_scheme fs = LIQUID_FEC_HAMMING74;
+    fec q = fec_create(fs,NULL);
+
+    unsigned int n, i;
+    for (n=1; n<=11; n++) {
+        unsigned int n_enc = fec_get_enc_msg_length(fs,n);
+        unsigned char msg[n];
+        unsigned char msg_enc[n_enc];
+        unsigned char msg_ref[n_enc];
+        unsigned char msg_dec[n];
+        for (i=0; i<n; i++)
+            msg[i] = rand() & 0xff;
+
+        // reference: pack 7-bit symbols one at a time
+        memset(msg_ref, 0x00, n_enc);
+        for (i=0; i<n; i++) {
+            liquid_pack_array(msg_ref, n_enc, 14*i,   7, hamming74_enc_gentab[msg[i] >> 4  ]);
+            liquid_pack_array(msg_ref, n_enc, 14*i+7, 7, hamming74_enc_gentab[msg[i] & 0x0f]);
+        }
+
+        // encode and compare
+        memset(msg_enc, 0x00, n_enc);
+        fec_encode(q, n, msg, msg_enc);
+        CONTEND_SAME_DATA(msg_enc, msg_ref, n_enc);
+
+        // corrupt one bit of every 7-bit symbol and decode
+        for (i=0; i<2*n; i++) {
+            unsigned int k = 7*i + (rand() % 7);
+            msg_enc[k/8] ^= 0x80 >> (k%8);
+        }
+        fec_decode(q, n, msg_enc, msg_dec);
+        CONTEND_SAME_DATA(msg, msg_dec, n);
+    }
+    fec_destroy(q);
+}
+
+//
+// AUTOTEST: Hamming (7,4) block soft decoding matches symbol-wise
+//           soft decoding for random soft bits
+//
+void autotest_hamming74_decode_soft_block()
+{
+    unsigned int n = 23;
+    fec_scheme fs = LIQUID_FEC_HAMMING74;
+    unsigned int n_enc = fec_get_enc_msg_length(fs,n);
+    unsigned char msg_soft[8*n_enc];
+    unsigned char msg_dec[n];
+
+    fec q = fec_create(fs,NULL);
+    unsigned int i, t;
+    for (t=0; t<20; t++) {
+        for (i=0; i<8*n_enc; i++)
+            msg_soft[i] = rand() & 0xff;
+        fec_decode_soft(q, n, msg_soft, msg_dec);
+
+        for (i=0; i<n; i++) {
+            unsigned char s0 = fecsoft_hamming74_decode(&msg_soft[14*i  ]);
+            unsigned char s1 = fecsoft_hamming74_decode(&msg_soft[14*i+7]);
+            CONTEND_EQUALITY(msg_dec[i], (s0 << 4) | s1);
+        }
+    }
+    fec_destroy(q);
+}
@@ -20,6 +20,8 @@
  * THE SOFTWARE.
  */
 
+#include <stdlib.h>
+
 #include "autotest/autotest.h"
 #include "liquid.internal.h"
 
@@ -99,3 +101,31 @@ void autotest_hamming84_codec_soft()
     }
 }
 
+
+//
+// AUTOTEST: Hamming (8,4) block soft decoding matches symbol-wise
+//           soft decoding for random soft bits
+//
+void autotest_hamming84_decode_soft_block()
+{
+    unsigned int n = 23;
+    fec_scheme fs = LIQUID_FEC_HAMMING84;
+    unsigned int n_enc = fec_get_enc_msg_length(fs,n);
+    unsigned char msg_soft[8*n_enc];
+    unsigned char msg_dec[n];
+
+    fec q = fec_create(fs,NULL);
+    unsigned int i, t;
+    for (t=0; t<20; t++) {
+        for (i=0; i<8*n_enc; i++)
+            msg_soft[i] = rand() & 0xff;
+        fec_decode_soft(q, n, msg_soft, msg_dec);
+
+        for (i=0; i<n; i++) {
+            unsigned char s0 = fecsoft_hamming84_decode(&msg_soft[16*i  ]);
+            unsigned char s1 = fecsoft_hamming84_decode(&msg_soft[16*i+8]);
+            CONTEND_EQUALITY(msg_dec[i], (s0 << 4) | s1);
+        }
+    }
+    fec_destroy(q);
+}
@@ -177,3 +177,35 @@ void autotest_secded7264_codec_e2()
     }
 }
 
+
+//
+// AUTOTEST: SEC-DED block decoder corrects a single error in each
+//           full symbol
+//
+void autotest_secded7264_block_e1()
+{
+    unsigned int n = 5*8 + 1;  // includes partial symbol
+    fec_scheme fs = LIQUID_FEC_SECDED7264;
+    unsigned int n_enc = fec_get_enc_msg_length(fs,n);
+    unsigned char msg[n];
+    unsigned char msg_enc[n_enc];
+    unsigned char msg_dec[n];
+
+    fec q = fec_create(fs,NULL);
+    unsigned int i, t;
+    for (t=0; t<20; t++) {
+        for (i=0; i<n; i++)
+            msg[i] = rand() & 0xff;
+        fec_encode(q, n, msg, msg_enc);
+
+        // flip one random bit in each of the five full symbols
+        for (i=0; i<5; i++) {
+            unsigned int k = rand() % (8*9);
+            msg_enc[9*i + k/8] ^= 1 << (k%8);
+        }
+
+        fec_decode(q, n, msg_enc, msg_dec);
+        CONTEND_SAME_DATA(msg, msg_dec, n);
+    }
+    fec_destroy(q);
+}
@@ -113,6 +113,14 @@ void autotest_fecsoft_h74()    { fec_test_soft_codec(LIQUID_FEC_HAMMING74,   64,
 void autotest_fecsoft_h84()    { fec_test_soft_codec(LIQUID_FEC_HAMMING84,   64, NULL); }
 void autotest_fecsoft_h128()   { fec_test_soft_codec(LIQUID_FEC_HAMMING128,  64, NULL); }
 
+// Golay block codes
+void autotest_fecsoft_g2412()  { fec_test_soft_codec(LIQUID_FEC_GOLAY2412,   64, NULL); }
+
+// low-density parity-check codes
+void autotest_fecsoft_ldpc648() { fec_test_soft_codec(LIQUID_FEC_LDPC_R12_N648,  64, NULL); }
+void autotest_fecsoft_ldpc1296(){ fec_test_soft_codec(LIQUID_FEC_LDPC_R12_N1296, 64, NULL); }
+void autotest_fecsoft_ldpc1944(){ fec_test_soft_codec(LIQUID_FEC_LDPC_R12_N1944,300, NULL); }
+
 // convolutional codes
 void autotest_fecsoft_v27()    { fec_test_soft_codec(LIQUID_FEC_CONV_V27,    64, NULL); }
 void autotest_fecsoft_v29()    { fec_test_soft_codec(LIQUID_FEC_CONV_V29,    64, NULL); }
@@ -21,6 +21,7 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 
 #include "autotest/autotest.h"
 #include "liquid.h"
@@ -85,3 +86,188 @@ void autotest_interleaver_soft_16()     { interleaver_test_soft(16  ); }
 void autotest_interleaver_soft_64()     { interleaver_test_soft(64  ); }
 void autotest_interleaver_soft_256()    { interleaver_test_soft(256 ); }
 
+
+// 
+// AUTOTESTS: hard and soft interleavers agree at each depth, in place
+//
+void interleaver_test_depth(unsigned int _n, unsigned int _depth)
+{
+    unsigned int i, k;
+    unsigned char x[_n];
+    unsigned char y[_n];
+    unsigned char z[_n];
+    unsigned char s[8*_n];
+
+    for (i=0; i<_n; i++)
+        x[i] = rand() & 0xFF;
+
+    interleaver q = interleaver_create(_n);
+    interleaver_set_depth(q, _depth);
+
+    // encode hard bits
+    interleaver_encode(q,x,y);
+
+    // encode soft bits in place; must match hard output
+    for (i=0; i<_n; i++) {
+        for (k=0; k<8; k++)
+            s[8*i+k] = ((x[i] >> (7-k)) & 1) ? LIQUID_SOFTBIT_1 : LIQUID_SOFTBIT_0;
+    }
+    interleaver_encode_soft(q,s,s);
+    for (i=0; i<_n; i++) {
+        z[i] = 0;
+        for (k=0; k<8; k++)
+            z[i] |= (s[8*i+k] > LIQUID_SOFTBIT_ERASURE ? 1 : 0) << (7-k);
+    }
+    CONTEND_SAME_DATA(y, z, _n);
+
+    // decode in place
+    interleaver_decode(q,y,y);
+    CONTEND_SAME_DATA(x, y, _n);
+
+    interleaver_destroy(q);
+}
+
+void autotest_interleaver_depth_0()     { interleaver_test_depth(100, 0); }
+void autotest_interleaver_depth_1()     { interleaver_test_depth(100, 1); }
+void autotest_interleaver_depth_2()     { interleaver_test_depth(100, 2); }
+void autotest_interleaver_depth_3()     { interleaver_test_depth(100, 3); }
+void autotest_interleaver_depth_4()     { interleaver_test_depth(100, 4); }
+
+
+//
+// AUTOTESTS: output matches the original bit-wise permutation for a
+// fixed input, out of place, in place, and with soft bits
+//
+void interleaver_test_golden(unsigned int    _n,
+                             unsigned int    _depth,
+                             unsigned char * _y)
+{
+    unsigned int i, k;
+    unsigned char x[_n];
+    unsigned char y[_n];
+    unsigned char s[8*_n];
+    for (i=0; i<_n; i++)
+        x[i] = (unsigned char)(73*i + 29);
+
+    interleaver q = interleaver_create(_n);
+    interleaver_set_depth(q, _depth);
+
+    // out of place
+    interleaver_encode(q,x,y);
+    CONTEND_SAME_DATA(y, _y, _n);
+
+    // in place
+    memmove(y, x, _n);
+    interleaver_encode(q,y,y);
+    CONTEND_SAME_DATA(y, _y, _n);
+
+    // soft bits
+    for (i=0; i<_n; i++) {
+        for (k=0; k<8; k++)
+            s[8*i+k] = ((x[i] >> (7-k)) & 1) ? LIQUID_SOFTBIT_1 : LIQUID_SOFTBIT_0;
+    }
+    interleaver_encode_soft(q,s,s);
+    for (i=0; i<_n; i++) {
+        y[i] = 0;
+        for (k=0; k<8; k++)
+            y[i] |= (s[8*i+k] > LIQUID_SOFTBIT_ERASURE ? 1 : 0) << (7-k);
+    }
+    CONTEND_SAME_DATA(y, _y, _n);
+
+    // decode in place
+    memmove(y, _y, _n);
+    interleaver_decode(q,y,y);
+    CONTEND_SAME_DATA(y, x, _n);
+
+    interleaver_destroy(q);
+}
+
+void autotest_interleaver_golden_n16_d0()
+{
+    unsigned char y[16] = {
+        0x1d, 0x66, 0xaf, 0xf8, 0x41, 0x8a, 0xd3, 0x1c, 0x65, 0xae, 0xf7, 0x40,
+        0x89, 0xd2, 0x1b, 0x64};
+    interleaver_test_golden(16, 0, y);
+}
+
+void autotest_interleaver_golden_n16_d1()
+{
+    unsigned char y[16] = {
+        0x40, 0xf7, 0x8a, 0x1b, 0xd2, 0xaf, 0x1c, 0xd3, 0x64, 0x89, 0x66, 0x1d,
+        0xae, 0x41, 0xf8, 0x65};
+    interleaver_test_golden(16, 1, y);
+}
+
+void autotest_interleaver_golden_n16_d2()
+{
+    unsigned char y[16] = {
+        0x4d, 0xfa, 0x87, 0x1c, 0xd1, 0xa6, 0x1b, 0xde, 0x65, 0x88, 0x6f, 0x10,
+        0xa3, 0x42, 0xf9, 0x64};
+    interleaver_test_golden(16, 2, y);
+}
+
+void autotest_interleaver_golden_n16_d3()
+{
+    unsigned char y[16] = {
+        0x18, 0xbb, 0xc2, 0x4d, 0xc4, 0xe7, 0x5a, 0x8b, 0x34, 0xd9, 0x2e, 0x45,
+        0xf6, 0x07, 0xa8, 0x71};
+    interleaver_test_golden(16, 3, y);
+}
+
+void autotest_interleaver_golden_n16_d4()
+{
+    unsigned char y[16] = {
+        0x09, 0x9a, 0xc3, 0x7c, 0xf5, 0xe6, 0x7b, 0xba, 0x05, 0xe8, 0x2f, 0x54,
+        0xc7, 0x06, 0x99, 0x40};
+    interleaver_test_golden(16, 4, y);
+}
+
+void autotest_interleaver_golden_n37_d0()
+{
+    unsigned char y[37] = {
+        0x1d, 0x66, 0xaf, 0xf8, 0x41, 0x8a, 0xd3, 0x1c, 0x65, 0xae, 0xf7, 0x40,
+        0x89, 0xd2, 0x1b, 0x64, 0xad, 0xf6, 0x3f, 0x88, 0xd1, 0x1a, 0x63, 0xac,
+        0xf5, 0x3e, 0x87, 0xd0, 0x19, 0x62, 0xab, 0xf4, 0x3d, 0x86, 0xcf, 0x18,
+        0x61};
+    interleaver_test_golden(37, 0, y);
+}
+
+void autotest_interleaver_golden_n37_d1()
+{
+    unsigned char y[37] = {
+        0x3e, 0x3d, 0xf8, 0xaf, 0x64, 0x65, 0xd0, 0x1b, 0x8a, 0xd1, 0xf6, 0x87,
+        0x62, 0xcf, 0x1c, 0x41, 0x88, 0xf7, 0xf4, 0xad, 0xae, 0x63, 0x1a, 0x19,
+        0x86, 0x1d, 0x40, 0xd3, 0xac, 0x89, 0x18, 0x3f, 0x66, 0xf5, 0xd2, 0xab,
+        0x61};
+    interleaver_test_golden(37, 1, y);
+}
+
+void autotest_interleaver_golden_n37_d2()
+{
+    unsigned char y[37] = {
+        0x3d, 0x3c, 0xf7, 0xae, 0x63, 0x60, 0xdf, 0x18, 0x89, 0xd2, 0xf1, 0x88,
+        0x6f, 0xc0, 0x1d, 0x46, 0x87, 0xf8, 0xf5, 0xaa, 0xaf, 0x6c, 0x1d, 0x16,
+        0x8b, 0x1e, 0x45, 0xd4, 0xa3, 0x8a, 0x1b, 0x32, 0x69, 0xf4, 0xd1, 0xa6,
+        0x61};
+    interleaver_test_golden(37, 2, y);
+}
+
+void autotest_interleaver_golden_n37_d3()
+{
+    unsigned char y[37] = {
+        0x3c, 0x6d, 0xb2, 0xbb, 0x76, 0x71, 0xda, 0x5d, 0x88, 0xd7, 0xa0, 0xd9,
+        0x3a, 0x95, 0x48, 0x57, 0xd6, 0xbd, 0xe4, 0xab, 0xae, 0x29, 0x58, 0x43,
+        0x8a, 0x1f, 0x14, 0xc1, 0xe6, 0x8b, 0x0e, 0x67, 0x3c, 0xa5, 0xc0, 0xa7,
+        0x61};
+    interleaver_test_golden(37, 3, y);
+}
+
+void autotest_interleaver_golden_n37_d4()
+{
+    unsigned char y[37] = {
+        0x1f, 0x7e, 0x81, 0x88, 0x65, 0x72, 0xcb, 0x5e, 0xbb, 0xe6, 0xa3, 0xd8,
+        0x39, 0x86, 0x69, 0x54, 0xd5, 0xae, 0xe7, 0x8a, 0x9f, 0x38, 0x59, 0x40,
+        0x99, 0x3c, 0x17, 0xf2, 0xf5, 0x9a, 0x2f, 0x64, 0x2d, 0x84, 0xc3, 0xa4,
+        0x61};
+    interleaver_test_golden(37, 4, y);
+}
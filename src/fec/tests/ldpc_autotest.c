@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) 2007 - 2022 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "autotest/autotest.h"
+#include "liquid.internal.h"
+
+// encode random message and check parity and systematic bits
+void testbench_ldpc_encode(unsigned int _z)
+{
+    ldpc q = ldpc_create_r12(_z);
+    unsigned int n = ldpc_get_n(q);
+    unsigned int k = ldpc_get_k(q);
+    CONTEND_EQUALITY(n, 24*_z);
+    CONTEND_EQUALITY(k, 12*_z);
+
+    unsigned int i;
+    unsigned char msg[k];
+    unsigned char c[n];
+    for (i=0; i<k; i++)
+        msg[i] = rand() & 1;
+    ldpc_encode(q, msg, c);
+    CONTEND_SAME_DATA(msg, c, k);
+    CONTEND_EQUALITY(ldpc_check(q, c), 1);
+
+    // single bit error must violate parity
+    for (i=0; i<n; i+=_z+1) {
+        c[i] ^= 1;
+        CONTEND_EQUALITY(ldpc_check(q, c), 0);
+        c[i] ^= 1;
+    }
+    ldpc_destroy(q);
+}
+void autotest_ldpc_encode_n648()  { testbench_ldpc_encode(27); }
+void autotest_ldpc_encode_n1296() { testbench_ldpc_encode(54); }
+void autotest_ldpc_encode_n1944() { testbench_ldpc_encode(81); }
+
+// check codewords against the first and last layers of the IEEE 802.11n
+// base matrices, expanding row r*z+t to columns c*z+(t+s)%z
+void testbench_ldpc_standard(unsigned int _z, const int * _layers)
+{
+    ldpc q = ldpc_create_r12(_z);
+    unsigned int n = ldpc_get_n(q);
+    unsigned int k = ldpc_get_k(q);
+    unsigned int i, l, c, t;
+    unsigned char msg[k];
+    unsigned char cw[n];
+    for (i=0; i<k; i++)
+        msg[i] = rand() & 1;
+    ldpc_encode(q, msg, cw);
+
+    unsigned int num_errors = 0;
+    for (l=0; l<2; l++) {
+        for (t=0; t<_z; t++) {
+            unsigned char p = 0;
+            for (c=0; c<24; c++) {
+                int s = _layers[24*l + c];
+                if (s >= 0)
+                    p ^= cw[c*_z + (t + s) % _z];
+            }
+            num_errors += p;
+        }
+    }
+    CONTEND_EQUALITY(num_errors, 0);
+    ldpc_destroy(q);
+}
+void autotest_ldpc_standard_n648()
+{
+    int layers[2*24] = {
+         0, -1, -1, -1,  0,  0, -1, -1,  0, -1, -1,  0,  1,  0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+         3, -1, -1, -1, 16, -1, -1,  2, 25,  5, -1, -1,  1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  0};
+    testbench_ldpc_standard(27, layers);
+}
+void autotest_ldpc_standard_n1296()
+{
+    int layers[2*24] = {
+        40, -1, -1, -1, 22, -1, 49, 23, 43, -1, -1, -1,  1,  0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        49, -1, 17, -1, 30, -1, -1, -1, 34, -1, -1, 19,  1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  0};
+    testbench_ldpc_standard(54, layers);
+}
+void autotest_ldpc_standard_n1944()
+{
+    int layers[2*24] = {
+        57, -1, -1, -1, 50, -1, 11, -1, 50, -1, 79, -1,  1,  0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        24, -1, 61, -1, 60, -1, -1, 27, 51, -1, -1, 16,  1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  0};
+    testbench_ldpc_standard(81, layers);
+}
+
+// decode codeword through additive white Gaussian noise channel
+//  _q      :   code object
+//  _sigma  :   noise standard deviation (unit-energy BPSK)
+void testbench_ldpc_decode(ldpc _q, float _sigma)
+{
+    unsigned int n = ldpc_get_n(_q);
+    unsigned int k = ldpc_get_k(_q);
+    unsigned int i;
+    unsigned char msg[k];
+    unsigned char c[n];
+    unsigned char c_hat[n];
+    float llr[n];
+    for (i=0; i<k; i++)
+        msg[i] = rand() & 1;
+    ldpc_encode(_q, msg, c);
+
+    unsigned int num_errors = 0;
+    for (i=0; i<n; i++) {
+        float y = (c[i] ? -1.0f : 1.0f) + _sigma*randnf();
+        llr[i] = 2.0f*y/(_sigma*_sigma);
+        num_errors += (llr[i] < 0) != c[i];
+    }
+    if (liquid_autotest_verbose)
+        printf("  n=%u, sigma=%.2f, channel errors: %u\n", n, _sigma, num_errors);
+    CONTEND_GREATER_THAN(num_errors, 0);
+
+    CONTEND_EQUALITY(ldpc_decode(_q, llr, c_hat), 1);
+    CONTEND_SAME_DATA(c, c_hat, n);
+    CONTEND_LESS_THAN(ldpc_get_num_iterations(_q), 51);
+}
+void autotest_ldpc_decode_n648()
+{
+    ldpc q = ldpc_create_r12(27);
+    testbench_ldpc_decode(q, 0.6f);
+    ldpc_destroy(q);
+}
+void autotest_ldpc_decode_n1944()
+{
+    ldpc q = ldpc_create_r12(81);
+    testbench_ldpc_decode(q, 0.6f);
+    ldpc_destroy(q);
+}
+void autotest_ldpc_decode_offset()
+{
+    ldpc q = ldpc_create_r12(54);
+    ldpc_set_min_sum(q, 1.0f, 0.5f);
+    testbench_ldpc_decode(q, 0.6f);
+    ldpc_destroy(q);
+}
+
+// non-standard circulant size which is not a multiple of vector lanes
+void autotest_ldpc_decode_z13()
+{
+    ldpc q = ldpc_create_r12(13);
+    testbench_ldpc_decode(q, 0.5f);
+    ldpc_destroy(q);
+}
+
+// generic decoder from sparse parity-check matrix, compared against
+// quasi-cyclic decoder of the same code
+void autotest_ldpc_decode_generic()
+{
+    // small base matrix with dual-diagonal parity section
+    int base[3*6] = {
+        1,  0,  2,  1,  0, -1,
+        2,  3,  0,  0,  0,  0,
+        0,  1,  3,  1, -1,  0};
+    unsigned int mb = 3, nb = 6, z = 16;
+    unsigned int m = mb*z, n = nb*z;
+    ldpc qc = ldpc_create_qc(base, mb, nb, z);
+    CONTEND_EQUALITY(ldpc_get_n(qc), n);
+    CONTEND_EQUALITY(ldpc_get_k(qc), n-m);
+
+    // expand parity-check matrix: row r*z+t has column c*z+(t+s)%z
+    smatrixb H = smatrixb_create(m, n);
+    unsigned int r, c, t;
+    for (r=0; r<mb; r++) {
+        for (c=0; c<nb; c++) {
+            if (base[r*nb+c] < 0)
+                continue;
+            for (t=0; t<z; t++)
+                smatrixb_set(H, r*z+t, c*z + (t+base[r*nb+c])%z, 1);
+        }
+    }
+    ldpc q = ldpc_create(H);
+    CONTEND_EQUALITY(ldpc_get_n(q), n);
+    CONTEND_EQUALITY(ldpc_get_k(q), 0);
+
+    // encode random message and check with both objects
+    unsigned int i;
+    unsigned char msg[n-m];
+    unsigned char cw[n];
+    for (i=0; i<n-m; i++)
+        msg[i] = rand() & 1;
+    ldpc_encode(qc, msg, cw);
+    CONTEND_EQUALITY(ldpc_check(qc, cw), 1);
+    CONTEND_EQUALITY(ldpc_check(q,  cw), 1);
+
+    // flip a few bits
+    float llr[n];
+    unsigned char c_hat[n];
+    for (i=0; i<n; i++)
+        llr[i] = cw[i] ? -2.0f : 2.0f;
+    llr[ 3] = -0.5f*llr[ 3];
+    llr[40] = -0.5f*llr[40];
+    CONTEND_EQUALITY(ldpc_decode(q, llr, c_hat), 1);
+    CONTEND_SAME_DATA(cw, c_hat, n);
+    CONTEND_EQUALITY(ldpc_decode(qc, llr, c_hat), 1);
+    CONTEND_SAME_DATA(cw, c_hat, n);
+
+    // same through sum-product interface
+    memset(c_hat, 0, n);
+    CONTEND_EQUALITY(fec_sumproduct(m, n, H, llr, c_hat, 20), 1);
+    CONTEND_SAME_DATA(cw, c_hat, n);
+
+    smatrixb_destroy(H);
+    ldpc_destroy(q);
+    ldpc_destroy(qc);
+}
+
+void autotest_ldpc_config()
+{
+#if LIQUID_STRICT_EXIT
+    AUTOTEST_WARN("skipping ldpc config test with strict exit enabled\n");
+    return;
+#endif
+#if !LIQUID_SUPPRESS_ERROR_OUTPUT
+    fprintf(stderr,"warning: ignore potential errors here; checking for invalid configurations\n");
+#endif
+    // check invalid configurations
+    int base[6] = {0, 1, -1, 0, 0, 2};
+    CONTEND_ISNULL(ldpc_create_r12(0));
+    CONTEND_ISNULL(ldpc_create_qc(base, 2, 2, 4));
+    CONTEND_ISNULL(ldpc_create_qc(base, 2, 3, 0));
+    CONTEND_ISNULL(ldpc_create_qc(base, 2, 3, 2));
+    smatrixb H = smatrixb_create(4, 4);
+    CONTEND_ISNULL(ldpc_create(H));
+    smatrixb_destroy(H);
+
+    // small code without dual-diagonal structure cannot be encoded
+    ldpc q = ldpc_create_qc(base, 2, 3, 4);
+    CONTEND_EQUALITY(ldpc_get_n(q), 12);
+    CONTEND_EQUALITY(ldpc_get_k(q),  0);
+    unsigned char c[12];
+    CONTEND_INEQUALITY(LIQUID_OK, ldpc_encode(q, c, c));
+    CONTEND_INEQUALITY(LIQUID_OK, ldpc_set_max_iterations(q, 0));
+    CONTEND_INEQUALITY(LIQUID_OK, ldpc_set_min_sum(q, 0.5f, 0.0f));
+    CONTEND_INEQUALITY(LIQUID_OK, ldpc_set_min_sum(q, 1.1f, 0.0f));
+    CONTEND_INEQUALITY(LIQUID_OK, ldpc_set_min_sum(q, 0.8f,-1.0f));
+    CONTEND_EQUALITY  (LIQUID_OK, ldpc_set_min_sum(q, 0.8f, 0.1f));
+    CONTEND_EQUALITY  (LIQUID_OK, ldpc_print(q));
+    ldpc_destroy(q);
+}
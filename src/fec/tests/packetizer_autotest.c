@@ -20,6 +20,8 @@
  * THE SOFTWARE.
  */
 
+#include <string.h>
+
 #include "autotest/autotest.h"
 #include "liquid.h"
 
@@ -64,4 +66,70 @@ void packetizer_test_codec(unsigned int _n,
 void autotest_packetizer_n16_0_0()  { packetizer_test_codec(16, LIQUID_CRC_32, LIQUID_FEC_NONE, LIQUID_FEC_NONE);       }
 void autotest_packetizer_n16_0_1()  { packetizer_test_codec(16, LIQUID_CRC_32, LIQUID_FEC_NONE, LIQUID_FEC_REP3);       }
 void autotest_packetizer_n16_0_2()  { packetizer_test_codec(16, LIQUID_CRC_32, LIQUID_FEC_NONE, LIQUID_FEC_HAMMING74);  }
+void autotest_packetizer_n16_0_3()  { packetizer_test_codec(16, LIQUID_CRC_32, LIQUID_FEC_NONE, LIQUID_FEC_LDPC_R12_N648);  }
+void autotest_packetizer_n200_1_3() { packetizer_test_codec(200,LIQUID_CRC_32, LIQUID_FEC_HAMMING74, LIQUID_FEC_LDPC_R12_N1944); }
+
+
+// Help function to keep code base small; encodes/decodes a batch of
+// packets and compares against the single-packet methods
+void packetizer_test_batch(unsigned int _n,
+                           unsigned int _num,
+                           crc_scheme   _crc,
+                           fec_scheme   _fec0,
+                           fec_scheme   _fec1)
+{
+    unsigned int pkt_len = packetizer_compute_enc_msg_len(_n,_crc,_fec0,_fec1);
+    unsigned char msg_tx [_num*_n];
+    unsigned char msg_rx [_num*_n];
+    unsigned char packets[_num*pkt_len];
+    unsigned char packet [pkt_len];
+    unsigned char soft   [8*_num*pkt_len];
+    int           valid  [_num];
+
+    // create object
+    packetizer p = packetizer_create(_n,_crc,_fec0,_fec1);
+
+    // initialize data
+    unsigned int i, j;
+    for (i=0; i<_num*_n; i++)
+        msg_tx[i] = (7*i + 3) & 0xff;
+
+    // encode batch and compare to single-packet encoder
+    packetizer_encode_batch(p, _num, msg_tx, packets);
+    for (i=0; i<_num; i++) {
+        packetizer_encode(p, msg_tx + i*_n, packet);
+        CONTEND_SAME_DATA(packets + i*pkt_len, packet, pkt_len);
+    }
+
+    // corrupt first packet beyond repair
+    for (i=0; i<pkt_len; i++)
+        packets[i] ^= 0xff;
+
+    // decode batch
+    unsigned int num_valid = packetizer_decode_batch(p, _num, packets, msg_rx, valid);
+    CONTEND_EQUALITY(num_valid, _num-1);
+    CONTEND_EQUALITY(valid[0], 0);
+    for (i=1; i<_num; i++) {
+        CONTEND_EQUALITY(valid[i], 1);
+        CONTEND_SAME_DATA(msg_tx + i*_n, msg_rx + i*_n, _n);
+    }
+
+    // convert to soft bits and decode batch
+    for (i=0; i<_num*pkt_len; i++) {
+        for (j=0; j<8; j++)
+            soft[8*i+j] = ((packets[i] >> (7-j)) & 1) ? 255 : 0;
+    }
+    memset(msg_rx, 0x00, _num*_n);
+    num_valid = packetizer_decode_soft_batch(p, _num, soft, msg_rx, NULL);
+    CONTEND_EQUALITY(num_valid, _num-1);
+    for (i=1; i<_num; i++)
+        CONTEND_SAME_DATA(msg_tx + i*_n, msg_rx + i*_n, _n);
+
+    // clean up objects
+    packetizer_destroy(p);
+}
 
+void autotest_packetizer_batch_0_0() { packetizer_test_batch(16, 5, LIQUID_CRC_32, LIQUID_FEC_NONE,      LIQUID_FEC_NONE);      }
+void autotest_packetizer_batch_1_0() { packetizer_test_batch(16, 5, LIQUID_CRC_32, LIQUID_FEC_HAMMING74, LIQUID_FEC_NONE);      }
+void autotest_packetizer_batch_0_1() { packetizer_test_batch(16, 5, LIQUID_CRC_32, LIQUID_FEC_NONE,      LIQUID_FEC_GOLAY2412); }
+void autotest_packetizer_batch_1_1() { packetizer_test_batch(37, 4, LIQUID_CRC_16, LIQUID_FEC_HAMMING128,LIQUID_FEC_REP3);      }
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2007 - 2022 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+
+#include "liquid.h"
+
+// Helper function to keep code base small
+//  _nfft   : transform size (window length _nfft, 50% overlap)
+//  _block  : write blocks of samples (1) or push one at a time (0)
+void spgramcf_bench(struct rusage *     _start,
+                    struct rusage *     _finish,
+                    unsigned long int * _num_iterations,
+                    unsigned int        _nfft,
+                    int                 _block)
+{
+    // normalize number of iterations
+    unsigned int buf_len = 16*_nfft;
+    *_num_iterations /= buf_len/4;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // create object and input buffer
+    spgramcf q = spgramcf_create(_nfft, LIQUID_WINDOW_HANN, _nfft, _nfft/2);
+    float complex * x = (float complex*) malloc(buf_len*sizeof(float complex));
+    unsigned long int i;
+    for (i=0; i<buf_len; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    // start trials
+    unsigned int j;
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        if (_block) {
+            spgramcf_write(q, x, buf_len);
+        } else {
+            for (j=0; j<buf_len; j++)
+                spgramcf_push(q, x[j]);
+        }
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= buf_len;
+
+    spgramcf_destroy(q);
+    free(x);
+}
+
+#define SPGRAMCF_BENCHMARK_API(NFFT,BLOCK)  \
+(   struct rusage *     _start,             \
+    struct rusage *     _finish,            \
+    unsigned long int * _num_iterations)    \
+{ spgramcf_bench(_start, _finish, _num_iterations, NFFT, BLOCK); }
+
+void benchmark_spgramcf_push_256    SPGRAMCF_BENCHMARK_API( 256, 0)
+void benchmark_spgramcf_write_256   SPGRAMCF_BENCHMARK_API( 256, 1)
+void benchmark_spgramcf_push_2048   SPGRAMCF_BENCHMARK_API(2048, 0)
+void benchmark_spgramcf_write_2048  SPGRAMCF_BENCHMARK_API(2048, 1)
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2007 - 2022 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+
+#include "liquid.h"
+
+// Helper function to keep code base small
+//  _M              : number of coarse channels
+//  _num_regions    : number of regions of interest
+void spzoomcf_bench(struct rusage *     _start,
+                    struct rusage *     _finish,
+                    unsigned long int * _num_iterations,
+                    unsigned int        _M,
+                    unsigned int        _num_regions)
+{
+    // normalize number of iterations
+    unsigned int buf_len = 4096;
+    *_num_iterations /= 400;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // create object with regions spread across band
+    spzoomcf q = spzoomcf_create_default(_M);
+    unsigned long int i;
+    for (i=0; i<_num_regions; i++)
+        spzoomcf_add_region(q, -0.45f + 0.9f*(float)i/(float)_num_regions, 1024);
+
+    float complex * x = (float complex*) malloc(buf_len*sizeof(float complex));
+    for (i=0; i<buf_len; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++)
+        spzoomcf_write(q, x, buf_len);
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= buf_len;
+
+    spzoomcf_destroy(q);
+    free(x);
+}
+
+#define SPZOOMCF_BENCHMARK_API(M,NUM_REGIONS)   \
+(   struct rusage *     _start,                 \
+    struct rusage *     _finish,                \
+    unsigned long int * _num_iterations)        \
+{ spzoomcf_bench(_start, _finish, _num_iterations, M, NUM_REGIONS); }
+
+void benchmark_spzoomcf_M64_R1      SPZOOMCF_BENCHMARK_API(  64,  1)
+void benchmark_spzoomcf_M64_R8      SPZOOMCF_BENCHMARK_API(  64,  8)
+void benchmark_spzoomcf_M1024_R1    SPZOOMCF_BENCHMARK_API(1024,  1)
+void benchmark_spzoomcf_M1024_R8    SPZOOMCF_BENCHMARK_API(1024,  8)
+void benchmark_spzoomcf_M1024_R32   SPZOOMCF_BENCHMARK_API(1024, 32)
@@ -33,9 +33,28 @@
 #include <complex.h>
 #include "liquid.internal.h"
 
+#if LIQUID_THREADS_ENABLED
+#  include <pthread.h>
+#endif
+
 #define min(a,b) ((a)<(b)?(a):(b))
 #define max(a,b) ((a)>(b)?(a):(b))
 
+// minimum number of frames transformed per batch in block mode
+#define SPGRAM_BATCH_LEN    (8)
+
+// maximum number of worker threads
+#define SPGRAM_MAX_THREADS  (64)
+
+// worker thread for block transforms
+struct SPGRAM(_worker_s) {
+    SPGRAM()        q;              // parent object
+    unsigned int    id;             // worker index (main thread is 0)
+#if LIQUID_THREADS_ENABLED
+    pthread_t       thread;         // worker thread
+#endif
+};
+
 struct SPGRAM(_s) {
     // options
     unsigned int    nfft;           // FFT length
@@ -63,6 +82,27 @@ struct SPGRAM(_s) {
     // parameters for display purposes only
     float           frequency;      // center frequency [Hz]
     float           sample_rate;    // sample rate [Hz]
+
+    // block processing: frames are windowed straight from the caller's
+    // buffer and transformed in batches (allocated on first use)
+    unsigned int    batch_size;     // maximum number of frames per batch
+    unsigned int    batch_len;      // number of frames in current batch
+    TI **           batch_src;      // start of each frame in input buffer
+    TC **           batch_time;     // FFT input for each frame
+    TC **           batch_freq;     // FFT output for each frame
+    FFT_PLAN *      batch_fft;      // FFT plan for each frame
+
+    // worker threads sharing the transforms of each batch
+    unsigned int    num_threads;    // number of worker threads
+    struct SPGRAM(_worker_s) * workers;
+#if LIQUID_THREADS_ENABLED
+    pthread_mutex_t lock;           // batch hand-off lock
+    pthread_cond_t  cv_start;       // signaled when batch is ready
+    pthread_cond_t  cv_done;        // signaled when worker finishes batch
+    unsigned int    generation;     // batch counter
+    unsigned int    num_busy;       // number of workers processing batch
+    int             shutdown;       // workers should exit
+#endif
 };
 
 //
@@ -73,6 +113,23 @@ struct SPGRAM(_s) {
 // from current buffer contents
 int SPGRAM(_step)(SPGRAM() _q);
 
+// accumulate squared magnitude of transform output into psd
+int SPGRAM(_accumulate)(SPGRAM() _q, TC * _X);
+
+// block processing: allocate/free batch buffers
+int SPGRAM(_batch_create)(SPGRAM() _q);
+int SPGRAM(_batch_destroy)(SPGRAM() _q);
+
+// block processing: transform all frames in current batch
+int SPGRAM(_batch_execute)(SPGRAM() _q);
+
+// block processing: transform every n-th frame of current batch
+int SPGRAM(_batch_transform)(SPGRAM() _q, unsigned int _first, unsigned int _step);
+
+// start/stop worker threads
+int SPGRAM(_threads_start)(SPGRAM() _q);
+int SPGRAM(_threads_stop) (SPGRAM() _q);
+
 // create spgram object
 //  _nfft       : FFT size
 //  _wtype      : window type, e.g. LIQUID_WINDOW_HAMMING
@@ -106,6 +163,16 @@ SPGRAM() SPGRAM(_create)(unsigned int _nfft,
     q->frequency  =  0;
     q->sample_rate= -1;
 
+    // block processing is set up on first use
+    q->batch_size  = 0;
+    q->batch_len   = 0;
+    q->batch_src   = NULL;
+    q->batch_time  = NULL;
+    q->batch_freq  = NULL;
+    q->batch_fft   = NULL;
+    q->num_threads = 0;
+    q->workers     = NULL;
+
     // set object for full accumulation
     SPGRAM(_set_alpha)(q, -1.0f);
 
@@ -175,6 +242,10 @@ int SPGRAM(_destroy)(SPGRAM() _q)
     if (_q == NULL)
         return liquid_error(LIQUID_EIOBJ,"spgram%s_destroy(), invalid null pointer passed",EXTENSION);
 
+    // stop threads and free block processing buffers
+    SPGRAM(_threads_stop)(_q);
+    SPGRAM(_batch_destroy)(_q);
+
     // free allocated memory
     free(_q->buf_time);
     free(_q->buf_freq);
@@ -226,8 +297,8 @@ int SPGRAM(_reset)(SPGRAM() _q)
 // prints the spgram object's parameters
 int SPGRAM(_print)(SPGRAM() _q)
 {
-    printf("spgram%s: nfft=%u, window=%u, delay=%u\n",
-            EXTENSION, _q->nfft, _q->window_len, _q->delay);
+    printf("spgram%s: nfft=%u, window=%u, delay=%u, threads=%u\n",
+            EXTENSION, _q->nfft, _q->window_len, _q->delay, _q->num_threads);
     return LIQUID_OK;
 }
 
@@ -274,6 +345,27 @@ int SPGRAM(_set_rate)(SPGRAM() _q,
     return LIQUID_OK;
 }
 
+// set number of worker threads for block transforms
+int SPGRAM(_set_num_threads)(SPGRAM()     _q,
+                             unsigned int _num_threads)
+{
+    // validate input
+    if (_num_threads > SPGRAM_MAX_THREADS)
+        return liquid_error(LIQUID_EICONFIG,"spgram%s_set_num_threads(), number of threads cannot exceed %u", EXTENSION, SPGRAM_MAX_THREADS);
+
+    // stop existing workers and release batch buffers (re-sized on next use)
+    SPGRAM(_threads_stop)(_q);
+    SPGRAM(_batch_destroy)(_q);
+    _q->num_threads = _num_threads;
+    return LIQUID_OK;
+}
+
+// get number of worker threads for block transforms
+unsigned int SPGRAM(_get_num_threads)(SPGRAM() _q)
+{
+    return _q->num_threads;
+}
+
 // get FFT size
 unsigned int SPGRAM(_get_nfft)(SPGRAM() _q)
 {
@@ -360,15 +452,45 @@ int SPGRAM(_write)(SPGRAM()     _q,
                    TI *         _x,
                    unsigned int _n)
 {
-#if 0
-    // write a block of samples to the internal window
-    WINDOW(_write)(_q->buffer, _x, _n);
-#else
-    // TODO: be smarter about how to write and execute samples
+    // Frames which start before this buffer need the internal buffer, so
+    // push samples individually up to the end of the last such frame;
+    // every frame after that lies entirely within the input buffer and
+    // is windowed directly from it. The result is identical to pushing
+    // each sample.
     unsigned int i;
-    for (i=0; i<_n; i++)
+    unsigned int num_head = 0;
+    unsigned int e = _q->sample_timer;  // end of next frame (exclusive)
+    while (e < _q->window_len && e <= _n) {
+        num_head = e;
+        e += _q->delay;
+    }
+    for (i=0; i<num_head; i++)
         SPGRAM(_push)(_q, _x[i]);
-#endif
+
+    // transform remaining frames in batches
+    if (e <= _n) {
+        // set up block processing on first use
+        if (_q->batch_time == NULL && SPGRAM(_batch_create)(_q) != LIQUID_OK)
+            return liquid_error(LIQUID_EINT,"spgram%s_write(), could not create batch buffers", EXTENSION);
+
+        while (e <= _n) {
+            _q->batch_src[_q->batch_len++] = _x + e - _q->window_len;
+            if (_q->batch_len == _q->batch_size)
+                SPGRAM(_batch_execute)(_q);
+            e += _q->delay;
+        }
+        SPGRAM(_batch_execute)(_q);
+    }
+
+    // update counters and timer (samples remaining to next transform)
+    unsigned int num_body = _n - num_head;
+    _q->num_samples       += num_body;
+    _q->num_samples_total += num_body;
+    _q->sample_timer = e - _n;
+
+    // retain most recent samples in internal buffer
+    unsigned int num_keep = min(num_body, _q->window_len);
+    WINDOW(_write)(_q->buffer, _x + _n - num_keep, num_keep);
     return LIQUID_OK;
 }
 
@@ -380,7 +502,6 @@ int SPGRAM(_step)(SPGRAM() _q)
     unsigned int i;
 
     // read buffer, copy to FFT input (applying window)
-    // TODO: use SIMD extensions to speed this up
     TI * rc;
     WINDOW(_read)(_q->buffer, &rc);
     for (i=0; i<_q->window_len; i++)
@@ -390,13 +511,24 @@ int SPGRAM(_step)(SPGRAM() _q)
     FFT_EXECUTE(_q->fft);
 
     // accumulate output
-    // TODO: vectorize this operation
-    for (i=0; i<_q->nfft; i++) {
-        T v = crealf( _q->buf_freq[i] * conjf(_q->buf_freq[i]) );
-        if (_q->num_transforms == 0)
-            _q->psd[i] = v;
-        else
-            _q->psd[i] = _q->gamma*_q->psd[i] + _q->alpha*v;
+    return SPGRAM(_accumulate)(_q, _q->buf_freq);
+}
+
+// accumulate squared magnitude of transform output into psd
+//  _q      :   spgram object
+//  _X      :   transform output [size: _nfft x 1]
+int SPGRAM(_accumulate)(SPGRAM() _q,
+                        TC *     _X)
+{
+    // operate on real/imaginary components directly so loops vectorize
+    unsigned int i;
+    T * X = (T*) _X;
+    if (_q->num_transforms == 0) {
+        for (i=0; i<_q->nfft; i++)
+            _q->psd[i] = X[2*i]*X[2*i] + X[2*i+1]*X[2*i+1];
+    } else {
+        for (i=0; i<_q->nfft; i++)
+            _q->psd[i] = _q->gamma*_q->psd[i] + _q->alpha*(X[2*i]*X[2*i] + X[2*i+1]*X[2*i+1]);
     }
 
     _q->num_transforms++;
@@ -523,3 +655,190 @@ int SPGRAM(_estimate_psd)(unsigned int _nfft,
     SPGRAM(_destroy)(q);
     return LIQUID_OK;
 }
+
+//
+// block processing
+//
+
+// allocate batch buffers and start worker threads
+int SPGRAM(_batch_create)(SPGRAM() _q)
+{
+    unsigned int i;
+    _q->batch_size = max(SPGRAM_BATCH_LEN, 2*(_q->num_threads+1));
+    _q->batch_len  = 0;
+    _q->batch_src  = (TI **)     malloc(_q->batch_size*sizeof(TI*));
+    _q->batch_time = (TC **)     malloc(_q->batch_size*sizeof(TC*));
+    _q->batch_freq = (TC **)     malloc(_q->batch_size*sizeof(TC*));
+    _q->batch_fft  = (FFT_PLAN*) malloc(_q->batch_size*sizeof(FFT_PLAN));
+    for (i=0; i<_q->batch_size; i++) {
+        // samples beyond the window length remain zero
+        _q->batch_time[i] = (TC*) calloc(_q->nfft, sizeof(TC));
+        _q->batch_freq[i] = (TC*) malloc(_q->nfft*sizeof(TC));
+        _q->batch_fft[i]  = FFT_CREATE_PLAN(_q->nfft, _q->batch_time[i], _q->batch_freq[i],
+                                            FFT_DIR_FORWARD, FFT_METHOD);
+    }
+    return SPGRAM(_threads_start)(_q);
+}
+
+// stop worker threads and free batch buffers
+int SPGRAM(_batch_destroy)(SPGRAM() _q)
+{
+    if (_q->batch_time == NULL)
+        return LIQUID_OK;
+
+    SPGRAM(_threads_stop)(_q);
+    unsigned int i;
+    for (i=0; i<_q->batch_size; i++) {
+        FFT_DESTROY_PLAN(_q->batch_fft[i]);
+        free(_q->batch_time[i]);
+        free(_q->batch_freq[i]);
+    }
+    free(_q->batch_src);
+    free(_q->batch_time);
+    free(_q->batch_freq);
+    free(_q->batch_fft);
+    _q->batch_src  = NULL;
+    _q->batch_time = NULL;
+    _q->batch_freq = NULL;
+    _q->batch_fft  = NULL;
+    _q->batch_size = 0;
+    return LIQUID_OK;
+}
+
+// window and transform every _step-th frame of current batch starting at _first
+int SPGRAM(_batch_transform)(SPGRAM()     _q,
+                             unsigned int _first,
+                             unsigned int _step)
+{
+    unsigned int i, j;
+    for (j=_first; j<_q->batch_len; j+=_step) {
+        TI * x = _q->batch_src[j];
+        TC * y = _q->batch_time[j];
+        for (i=0; i<_q->window_len; i++)
+            y[i] = x[i] * _q->w[i];
+        FFT_EXECUTE(_q->batch_fft[j]);
+    }
+    return LIQUID_OK;
+}
+
+// transform all frames in current batch, then accumulate in order
+int SPGRAM(_batch_execute)(SPGRAM() _q)
+{
+    if (_q->batch_len == 0)
+        return LIQUID_OK;
+
+#if LIQUID_THREADS_ENABLED
+    if (_q->num_threads > 0) {
+        // wake workers and process share on this thread
+        pthread_mutex_lock(&_q->lock);
+        _q->num_busy = _q->num_threads;
+        _q->generation++;
+        pthread_cond_broadcast(&_q->cv_start);
+        pthread_mutex_unlock(&_q->lock);
+
+        SPGRAM(_batch_transform)(_q, 0, _q->num_threads+1);
+
+        // wait for workers to finish
+        pthread_mutex_lock(&_q->lock);
+        while (_q->num_busy > 0)
+            pthread_cond_wait(&_q->cv_done, &_q->lock);
+        pthread_mutex_unlock(&_q->lock);
+    } else
+#endif
+    {
+        SPGRAM(_batch_transform)(_q, 0, 1);
+    }
+
+    // accumulation depends on order of transforms
+    unsigned int j;
+    for (j=0; j<_q->batch_len; j++)
+        SPGRAM(_accumulate)(_q, _q->batch_freq[j]);
+    _q->batch_len = 0;
+    return LIQUID_OK;
+}
+
+#if LIQUID_THREADS_ENABLED
+// worker thread: transform share of each batch
+static void * SPGRAM(_worker)(void * _arg)
+{
+    struct SPGRAM(_worker_s) * w = (struct SPGRAM(_worker_s) *) _arg;
+    SPGRAM() q = w->q;
+    unsigned int generation = 0;
+    while (1) {
+        // wait for next batch
+        pthread_mutex_lock(&q->lock);
+        while (!q->shutdown && q->generation == generation)
+            pthread_cond_wait(&q->cv_start, &q->lock);
+        if (q->shutdown) {
+            pthread_mutex_unlock(&q->lock);
+            break;
+        }
+        generation = q->generation;
+        pthread_mutex_unlock(&q->lock);
+
+        SPGRAM(_batch_transform)(q, w->id, q->num_threads+1);
+
+        // signal completion
+        pthread_mutex_lock(&q->lock);
+        if (--q->num_busy == 0)
+            pthread_cond_signal(&q->cv_done);
+        pthread_mutex_unlock(&q->lock);
+    }
+    return NULL;
+}
+#endif
+
+// start worker threads
+int SPGRAM(_threads_start)(SPGRAM() _q)
+{
+#if LIQUID_THREADS_ENABLED
+    if (_q->num_threads == 0 || _q->workers != NULL)
+        return LIQUID_OK;
+
+    pthread_mutex_init(&_q->lock, NULL);
+    pthread_cond_init (&_q->cv_start, NULL);
+    pthread_cond_init (&_q->cv_done,  NULL);
+    _q->generation = 0;
+    _q->num_busy   = 0;
+    _q->shutdown   = 0;
+    _q->workers = (struct SPGRAM(_worker_s) *) malloc(_q->num_threads*sizeof(struct SPGRAM(_worker_s)));
+    unsigned int i;
+    for (i=0; i<_q->num_threads; i++) {
+        _q->workers[i].q  = _q;
+        _q->workers[i].id = i+1;
+        if (pthread_create(&_q->workers[i].thread, NULL, SPGRAM(_worker), &_q->workers[i]) != 0) {
+            // stop threads already created and run transforms on calling thread
+            _q->num_threads = i;
+            SPGRAM(_threads_stop)(_q);
+            _q->num_threads = 0;
+            return liquid_error(LIQUID_EINT,"spgram%s_threads_start(), could not create thread", EXTENSION);
+        }
+    }
+#endif
+    return LIQUID_OK;
+}
+
+// stop worker threads
+int SPGRAM(_threads_stop)(SPGRAM() _q)
+{
+#if LIQUID_THREADS_ENABLED
+    if (_q->workers == NULL)
+        return LIQUID_OK;
+
+    pthread_mutex_lock(&_q->lock);
+    _q->shutdown = 1;
+    pthread_cond_broadcast(&_q->cv_start);
+    pthread_mutex_unlock(&_q->lock);
+
+    unsigned int i;
+    for (i=0; i<_q->num_threads; i++)
+        pthread_join(_q->workers[i].thread, NULL);
+    free(_q->workers);
+    _q->workers = NULL;
+
+    pthread_mutex_destroy(&_q->lock);
+    pthread_cond_destroy (&_q->cv_start);
+    pthread_cond_destroy (&_q->cv_done);
+#endif
+    return LIQUID_OK;
+}
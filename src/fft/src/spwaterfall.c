@@ -33,6 +33,25 @@
 #include <complex.h>
 #include "liquid.internal.h"
 
+#if defined HAVE_SYS_MMAN_H && defined HAVE_FCNTL_H && defined HAVE_UNISTD_H
+#  include <sys/mman.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#  define SPWATERFALL_STREAM_ENABLED 1
+#endif
+
+// order stream stores as seen by readers in other processes
+#if defined HAVE_STDATOMIC_H
+#  include <stdatomic.h>
+#  define SPWATERFALL_STREAM_FENCE() atomic_thread_fence(memory_order_seq_cst)
+#else
+#  define SPWATERFALL_STREAM_FENCE() __sync_synchronize()
+#endif
+
+// stream file identifier and row record alignment [bytes]
+#define SPWATERFALL_STREAM_MAGIC    "LQSPWF1"
+#define SPWATERFALL_STREAM_ALIGN    (64)
+
 struct SPWATERFALL(_s) {
     // options
     unsigned int    nfft;           // FFT length
@@ -50,6 +69,13 @@ struct SPWATERFALL(_s) {
     unsigned int    width;          // image width [pixels]
     unsigned int    height;         // image height [pixels]
     char *          commands;       // commands to execute directly before 'plot'
+
+    // memory-mapped stream output
+    unsigned char * stream;         // mapped stream file (NULL if not open)
+    size_t          stream_len;     // length of mapped file [bytes]
+    uint64_t        stream_seq;     // number of rows written to stream
+    float           stream_db_min;  // quantization range, lower [dB]
+    float           stream_db_max;  // quantization range, upper [dB]
 };
 
 //
@@ -62,6 +88,9 @@ int SPWATERFALL(_step)(SPWATERFALL() _q);
 // consolidate buffer by taking log-average of two separate spectral estimates in time
 int SPWATERFALL(_consolidate_buffer)(SPWATERFALL() _q);
 
+// append row to stream output
+int SPWATERFALL(_stream_append)(SPWATERFALL() _q, const T * _psd);
+
 // export files
 int SPWATERFALL(_export_bin)(SPWATERFALL() _q, const char * _base);
 int SPWATERFALL(_export_gnu)(SPWATERFALL() _q, const char * _base);
@@ -102,6 +131,11 @@ SPWATERFALL() SPWATERFALL(_create)(unsigned int _nfft,
     q->width        = 800;
     q->height       = 800;
     q->commands     = NULL;
+    q->stream       = NULL;
+    q->stream_len   = 0;
+    q->stream_seq   = 0;
+    q->stream_db_min= -100.0f;
+    q->stream_db_max=   20.0f;
 
     // create buffer to hold aggregated power spectral density
     // NOTE: the buffer is two-dimensional time/frequency grid that is two times
@@ -135,6 +169,9 @@ SPWATERFALL() SPWATERFALL(_create_default)(unsigned int _nfft,
 // destroy spwaterfall object
 int SPWATERFALL(_destroy)(SPWATERFALL() _q)
 {
+    // close stream output
+    SPWATERFALL(_stream_close)(_q);
+
     // free allocated memory
     free(_q->psd);
     free(_q->commands);
@@ -292,13 +329,138 @@ int SPWATERFALL(_write)(SPWATERFALL() _q,
                         TI *          _x,
                         unsigned int  _n)
 {
-    // TODO: be smarter about how to write and execute samples
-    unsigned int i;
-    for (i=0; i<_n; i++)
-        SPWATERFALL(_push)(_q, _x[i]);
+    // write to periodogram in chunks which end exactly on the transform
+    // completing each row so that rows are extracted at the same points as
+    // when pushing samples individually; note that the periodogram is
+    // defined in this same translation unit
+    SPGRAM() p = _q->periodogram;
+    while (_n > 0) {
+        // number of samples until periodogram completes current row
+        unsigned long long int num_transforms = p->num_transforms < _q->rollover ?
+            _q->rollover - p->num_transforms : 1;
+        unsigned long long int num_samples = p->sample_timer + (num_transforms-1)*p->delay;
+        unsigned int n = num_samples < _n ? (unsigned int)num_samples : _n;
+
+        if (SPGRAM(_write)(p, _x, n))
+            return liquid_error(LIQUID_EINT,"spwaterfall%s_write(), could not write to internal spgram object",EXTENSION);
+        if (SPWATERFALL(_step)(_q))
+            return liquid_error(LIQUID_EINT,"spwaterfall%s_write(), could not step internal state",EXTENSION);
+        _x += n;
+        _n -= n;
+    }
+    return LIQUID_OK;
+}
+
+// set number of worker threads for block transforms
+int SPWATERFALL(_set_num_threads)(SPWATERFALL() _q,
+                                  unsigned int  _num_threads)
+{
+    return SPGRAM(_set_num_threads)(_q->periodogram, _num_threads);
+}
+
+// get number of worker threads for block transforms
+unsigned int SPWATERFALL(_get_num_threads)(SPWATERFALL() _q)
+{
+    return SPGRAM(_get_num_threads)(_q->periodogram);
+}
+
+// set dB range for quantized stream output
+//  _q      : spwaterfall object
+//  _db_min : value at bottom of range [dB]
+//  _db_max : value at top of range [dB]
+int SPWATERFALL(_set_stream_range)(SPWATERFALL() _q,
+                                   float         _db_min,
+                                   float         _db_max)
+{
+    if (_q->stream != NULL)
+        return liquid_error(LIQUID_EIMODE,"spwaterfall%s_set_stream_range(), cannot change range while stream is open",EXTENSION);
+    if (!(_db_max > _db_min))
+        return liquid_error(LIQUID_EICONFIG,"spwaterfall%s_set_stream_range(), upper limit must exceed lower limit",EXTENSION);
+
+    _q->stream_db_min = _db_min;
+    _q->stream_db_max = _db_max;
     return LIQUID_OK;
 }
 
+// open memory-mapped ring buffer stream output
+//  _q        : spwaterfall object
+//  _filename : stream file name
+//  _num_rows : number of row records in ring
+//  _format   : row format
+int SPWATERFALL(_stream_open)(SPWATERFALL() _q,
+                              const char *  _filename,
+                              unsigned int  _num_rows,
+                              int           _format)
+{
+    // validate input
+    if (_num_rows == 0)
+        return liquid_error(LIQUID_EICONFIG,"spwaterfall%s_stream_open(), number of rows must be greater than zero",EXTENSION);
+    if (_format != LIQUID_SPWATERFALL_STREAM_FLOAT && _format != LIQUID_SPWATERFALL_STREAM_UINT8)
+        return liquid_error(LIQUID_EICONFIG,"spwaterfall%s_stream_open(), invalid stream format",EXTENSION);
+#if SPWATERFALL_STREAM_ENABLED
+    SPWATERFALL(_stream_close)(_q);
+
+    // compute layout, aligning records to avoid sharing cache lines
+    size_t a          = SPWATERFALL_STREAM_ALIGN;
+    size_t value_len  = _format == LIQUID_SPWATERFALL_STREAM_FLOAT ? sizeof(float) : sizeof(uint8_t);
+    size_t header_len = (sizeof(struct liquid_spwaterfall_stream_header_s) + a - 1) / a * a;
+    size_t row_stride = (sizeof(struct liquid_spwaterfall_stream_row_s) + _q->nfft*value_len + a - 1) / a * a;
+    size_t len        = header_len + (size_t)_num_rows * row_stride;
+
+    // create file of appropriate length (zero-filled) and map it
+    int fd = open(_filename, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return liquid_error(LIQUID_EIO,"spwaterfall%s_stream_open(), could not open '%s' for writing",EXTENSION,_filename);
+    if (ftruncate(fd, (off_t)len) != 0) {
+        close(fd);
+        return liquid_error(LIQUID_EIO,"spwaterfall%s_stream_open(), could not resize '%s'",EXTENSION,_filename);
+    }
+    void * p = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED)
+        return liquid_error(LIQUID_EIO,"spwaterfall%s_stream_open(), could not map '%s'",EXTENSION,_filename);
+
+    // write header, setting identifier last so that readers never see
+    // a partially-written header
+    struct liquid_spwaterfall_stream_header_s * h = (struct liquid_spwaterfall_stream_header_s *) p;
+    h->header_len   = (uint32_t)header_len;
+    h->nfft         = _q->nfft;
+    h->num_rows     = _num_rows;
+    h->row_stride   = (uint32_t)row_stride;
+    h->format       = (uint32_t)_format;
+    h->db_min       = _q->stream_db_min;
+    h->db_step      = (_q->stream_db_max - _q->stream_db_min) / 255.0f;
+    h->num_written  = 0;
+    SPWATERFALL_STREAM_FENCE();
+    memmove(h->magic, SPWATERFALL_STREAM_MAGIC, sizeof(h->magic));
+
+    _q->stream      = (unsigned char *) p;
+    _q->stream_len  = len;
+    _q->stream_seq  = 0;
+    return LIQUID_OK;
+#else
+    return liquid_error(LIQUID_EUMODE,"spwaterfall%s_stream_open(), memory-mapped files not supported on this platform",EXTENSION);
+#endif
+}
+
+// close stream output
+int SPWATERFALL(_stream_close)(SPWATERFALL() _q)
+{
+#if SPWATERFALL_STREAM_ENABLED
+    if (_q->stream != NULL)
+        munmap(_q->stream, _q->stream_len);
+#endif
+    _q->stream     = NULL;
+    _q->stream_len = 0;
+    return LIQUID_OK;
+}
+
+// get number of rows written to stream
+uint64_t SPWATERFALL(_get_stream_num_rows)(SPWATERFALL() _q)
+{
+    return _q->stream_seq;
+}
+
 // export output files
 //  _q    : spwaterfall object
 //  _base : base filename
@@ -323,6 +485,10 @@ int SPWATERFALL(_step)(SPWATERFALL() _q)
         // proper location in internal buffer
         SPGRAM(_get_psd)(_q->periodogram, _q->psd + _q->nfft*_q->index_time);
 
+        // append row to stream output before the periodogram is cleared
+        if (_q->stream != NULL)
+            SPWATERFALL(_stream_append)(_q, _q->psd + _q->nfft*_q->index_time);
+
         // soft reset of internal state, counters
         SPGRAM(_clear)(_q->periodogram);
 
@@ -336,6 +502,51 @@ int SPWATERFALL(_step)(SPWATERFALL() _q)
     return LIQUID_OK;
 }
 
+// append row to stream output using a sequence lock on the row record
+//  _q   : spwaterfall object
+//  _psd : spectral estimate [dB], [size: nfft x 1]
+int SPWATERFALL(_stream_append)(SPWATERFALL() _q,
+                                const T *     _psd)
+{
+    volatile struct liquid_spwaterfall_stream_header_s * h =
+        (volatile struct liquid_spwaterfall_stream_header_s *) _q->stream;
+    uint64_t seq = _q->stream_seq + 1;
+    unsigned char * r = _q->stream + h->header_len + ((seq-1) % h->num_rows) * h->row_stride;
+    volatile struct liquid_spwaterfall_stream_row_s * row =
+        (volatile struct liquid_spwaterfall_stream_row_s *) r;
+
+    // invalidate record while it is being written
+    row->seq = 0;
+    SPWATERFALL_STREAM_FENCE();
+
+    // write values
+    row->num_samples    = SPGRAM(_get_num_samples_total)(_q->periodogram);
+    row->num_transforms = (uint32_t) SPGRAM(_get_num_transforms)(_q->periodogram);
+    unsigned char * v = r + sizeof(struct liquid_spwaterfall_stream_row_s);
+    unsigned int i;
+    if (h->format == LIQUID_SPWATERFALL_STREAM_FLOAT) {
+        float * y = (float *) v;
+        for (i=0; i<_q->nfft; i++)
+            y[i] = (float)_psd[i];
+    } else {
+        float g = 1.0f / h->db_step;
+        float b = h->db_min;
+        uint8_t * y = (uint8_t *) v;
+        for (i=0; i<_q->nfft; i++) {
+            float u = (_psd[i] - b)*g + 0.5f;
+            y[i] = u <= 0.0f ? 0 : (u >= 255.0f ? 255 : (uint8_t)u);
+        }
+    }
+
+    // publish record, then advance stream counter
+    SPWATERFALL_STREAM_FENCE();
+    row->seq = seq;
+    SPWATERFALL_STREAM_FENCE();
+    h->num_written = seq;
+    _q->stream_seq = seq;
+    return LIQUID_OK;
+}
+
 // consolidate buffer by taking log-average of two separate spectral estimates in time
 //  _q : spwaterfall object
 int SPWATERFALL(_consolidate_buffer)(SPWATERFALL() _q)
@@ -0,0 +1,336 @@
+/*
+ * Copyright (c) 2007 - 2022 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// spzoomcf : zoom spectrum analyzer (coarse channelizer with fine
+//            spectral periodograms over regions of interest)
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "liquid.internal.h"
+
+// number of channel samples buffered in each region before mixing and
+// writing to its periodogram as a block
+#define SPZOOMCF_BLOCK_LEN  (256)
+
+// region of interest
+struct spzoomcf_region_s {
+    float           fc;             // center frequency (relative to input rate)
+    unsigned int    nfft;           // transform size
+    unsigned int    channel;        // coarse channel index
+    nco_crcf        mixer;          // mix region center to baseband
+    spgramcf        periodogram;    // fine spectral periodogram
+    float complex   buf[SPZOOMCF_BLOCK_LEN];
+    unsigned int    buf_len;        // number of samples in buffer
+};
+
+struct spzoomcf_s {
+    unsigned int        M;              // number of coarse channels
+    unsigned int        m;              // prototype filter semi-length
+    float               As;             // prototype filter stop-band attenuation
+    firpfbch2_crcf      channelizer;    // coarse analysis channelizer
+
+    float complex *     buf_in;         // channelizer input  [size: M/2 x 1]
+    float complex *     buf_out;        // channelizer output [size: M x 1]
+    unsigned int        buf_in_len;     // number of samples in input buffer
+    uint64_t            num_samples;    // total number of input samples
+
+    unsigned int                num_regions;
+    struct spzoomcf_region_s ** regions;
+};
+
+// flush buffered channel samples of a region to its periodogram
+int spzoomcf_region_flush(struct spzoomcf_region_s * _r);
+
+// create zoom spectrum analyzer
+//  _M      : number of coarse channels
+//  _m      : channelizer prototype filter semi-length
+//  _As     : channelizer prototype filter stop-band attenuation [dB]
+spzoomcf spzoomcf_create(unsigned int _M,
+                         unsigned int _m,
+                         float        _As)
+{
+    // validate input
+    if (_M < 2 || _M % 2)
+        return liquid_error_config("spzoomcf_create(), number of channels must be at least 2 and even");
+    if (_m < 1)
+        return liquid_error_config("spzoomcf_create(), filter semi-length must be at least 1");
+    if (_As <= 0.0f)
+        return liquid_error_config("spzoomcf_create(), stop-band attenuation must be greater than zero");
+
+    // allocate memory for main object
+    spzoomcf q = (spzoomcf) malloc(sizeof(struct spzoomcf_s));
+    q->M  = _M;
+    q->m  = _m;
+    q->As = _As;
+
+    // create channelizer and buffers
+    q->channelizer = firpfbch2_crcf_create_kaiser(LIQUID_ANALYZER, q->M, q->m, q->As);
+    q->buf_in      = (float complex*) malloc((q->M/2)*sizeof(float complex));
+    q->buf_out     = (float complex*) malloc((q->M  )*sizeof(float complex));
+
+    // no regions of interest to start
+    q->num_regions = 0;
+    q->regions     = NULL;
+
+    // reset and return object
+    spzoomcf_reset(q);
+    return q;
+}
+
+// create zoom spectrum analyzer with default filter
+spzoomcf spzoomcf_create_default(unsigned int _M)
+{
+    return spzoomcf_create(_M, 8, 80.0f);
+}
+
+// destroy zoom spectrum analyzer, freeing all internal memory
+int spzoomcf_destroy(spzoomcf _q)
+{
+    unsigned int i;
+    for (i=0; i<_q->num_regions; i++) {
+        nco_crcf_destroy(_q->regions[i]->mixer);
+        spgramcf_destroy(_q->regions[i]->periodogram);
+        free(_q->regions[i]);
+    }
+    free(_q->regions);
+    firpfbch2_crcf_destroy(_q->channelizer);
+    free(_q->buf_in);
+    free(_q->buf_out);
+    free(_q);
+    return LIQUID_OK;
+}
+
+// print zoom spectrum analyzer object internals
+int spzoomcf_print(spzoomcf _q)
+{
+    printf("<liquid.spzoomcf, channels=%u, m=%u, As=%g, regions=%u>\n",
+            _q->M, _q->m, _q->As, _q->num_regions);
+    unsigned int i;
+    for (i=0; i<_q->num_regions; i++) {
+        printf("  region %3u : fc=%12.8f, nfft=%6u, channel=%6u, rbw=%12.4e\n",
+                i, _q->regions[i]->fc, _q->regions[i]->nfft, _q->regions[i]->channel,
+                spzoomcf_get_region_rbw(_q,i));
+    }
+    return LIQUID_OK;
+}
+
+// clear the spectral estimates of all regions
+int spzoomcf_clear(spzoomcf _q)
+{
+    unsigned int i;
+    for (i=0; i<_q->num_regions; i++) {
+        // flush rather than discard buffered samples to keep the
+        // periodogram input continuous
+        spzoomcf_region_flush(_q->regions[i]);
+        spgramcf_clear(_q->regions[i]->periodogram);
+    }
+    return LIQUID_OK;
+}
+
+// reset the object and all regions to their initial states
+int spzoomcf_reset(spzoomcf _q)
+{
+    firpfbch2_crcf_reset(_q->channelizer);
+    _q->buf_in_len  = 0;
+    _q->num_samples = 0;
+
+    unsigned int i;
+    for (i=0; i<_q->num_regions; i++) {
+        _q->regions[i]->buf_len = 0;
+        nco_crcf_set_phase(_q->regions[i]->mixer, 0.0f);
+        spgramcf_reset(_q->regions[i]->periodogram);
+    }
+    return LIQUID_OK;
+}
+
+// get number of coarse channels
+unsigned int spzoomcf_get_num_channels(spzoomcf _q)
+{
+    return _q->M;
+}
+
+// get number of regions of interest
+unsigned int spzoomcf_get_num_regions(spzoomcf _q)
+{
+    return _q->num_regions;
+}
+
+// get total number of input samples written to the object
+uint64_t spzoomcf_get_num_samples_total(spzoomcf _q)
+{
+    return _q->num_samples;
+}
+
+// add region of interest
+//  _q      : zoom spectrum analyzer
+//  _fc     : region center frequency
+//  _nfft   : region transform size
+int spzoomcf_add_region(spzoomcf     _q,
+                        float        _fc,
+                        unsigned int _nfft)
+{
+    // validate input
+    if (_fc < -0.5f || _fc >= 0.5f)
+        return liquid_error(LIQUID_EICONFIG,"spzoomcf_add_region(), center frequency must be in [-0.5,0.5)");
+    if (_nfft < 2)
+        return liquid_error(LIQUID_EICONFIG,"spzoomcf_add_region(), transform size must be at least 2");
+
+    // create region
+    struct spzoomcf_region_s * r = (struct spzoomcf_region_s *) malloc(sizeof(struct spzoomcf_region_s));
+    r->fc      = _fc;
+    r->nfft    = _nfft;
+    r->buf_len = 0;
+
+    // select nearest coarse channel; channel k is centered at k/M and its
+    // output rate is 2/M, so the residual offset is scaled by M/2
+    int k = (int)roundf(_fc * (float)_q->M);
+    float offset = _fc - (float)k / (float)_q->M;
+    r->channel = (unsigned int)((k + (int)_q->M) % (int)_q->M);
+
+    // mixer using polynomial oscillator to keep spurs below estimate floor
+    r->mixer = nco_crcf_create(LIQUID_NCO);
+    nco_crcf_set_mix_method(r->mixer, LIQUID_NCO_MIX_POLY);
+    nco_crcf_set_frequency(r->mixer, M_PI * offset * (float)_q->M);
+
+    // fine spectral periodogram; full-length Blackman-Harris window keeps
+    // leakage well below the channelizer stop-band
+    r->periodogram = spgramcf_create(_nfft, LIQUID_WINDOW_BLACKMANHARRIS, _nfft, _nfft/4 > 0 ? _nfft/4 : 1);
+
+    // append to list
+    _q->regions = (struct spzoomcf_region_s **) realloc(_q->regions,
+                    (_q->num_regions+1)*sizeof(struct spzoomcf_region_s *));
+    _q->regions[_q->num_regions++] = r;
+    return LIQUID_OK;
+}
+
+// get region center frequency
+float spzoomcf_get_region_freq(spzoomcf     _q,
+                               unsigned int _id)
+{
+    if (_id >= _q->num_regions) {
+        liquid_error(LIQUID_EIRANGE,"spzoomcf_get_region_freq(), region index (%u) out of range", _id);
+        return 0.0f;
+    }
+    return _q->regions[_id]->fc;
+}
+
+// get region transform size
+unsigned int spzoomcf_get_region_nfft(spzoomcf     _q,
+                                      unsigned int _id)
+{
+    if (_id >= _q->num_regions) {
+        liquid_error(LIQUID_EIRANGE,"spzoomcf_get_region_nfft(), region index (%u) out of range", _id);
+        return 0;
+    }
+    return _q->regions[_id]->nfft;
+}
+
+// get region resolution bandwidth, relative to input rate
+float spzoomcf_get_region_rbw(spzoomcf     _q,
+                              unsigned int _id)
+{
+    if (_id >= _q->num_regions) {
+        liquid_error(LIQUID_EIRANGE,"spzoomcf_get_region_rbw(), region index (%u) out of range", _id);
+        return 0.0f;
+    }
+    return 2.0f / ((float)_q->M * (float)_q->regions[_id]->nfft);
+}
+
+// get number of transforms accumulated in region spectral estimate
+unsigned long long int spzoomcf_get_region_num_transforms(spzoomcf     _q,
+                                                          unsigned int _id)
+{
+    if (_id >= _q->num_regions) {
+        liquid_error(LIQUID_EIRANGE,"spzoomcf_get_region_num_transforms(), region index (%u) out of range", _id);
+        return 0;
+    }
+    spzoomcf_region_flush(_q->regions[_id]);
+    return spgramcf_get_num_transforms(_q->regions[_id]->periodogram);
+}
+
+// set forgetting factor for region spectral estimate
+int spzoomcf_set_region_alpha(spzoomcf     _q,
+                              unsigned int _id,
+                              float        _alpha)
+{
+    if (_id >= _q->num_regions)
+        return liquid_error(LIQUID_EIRANGE,"spzoomcf_set_region_alpha(), region index (%u) out of range", _id);
+    if (spgramcf_set_alpha(_q->regions[_id]->periodogram, _alpha) != LIQUID_OK)
+        return liquid_error(LIQUID_EICONFIG,"spzoomcf_set_region_alpha(), invalid forgetting factor");
+    return LIQUID_OK;
+}
+
+// get region power spectral density (fft-shifted, dB)
+int spzoomcf_get_psd(spzoomcf     _q,
+                     unsigned int _id,
+                     float *      _psd)
+{
+    if (_id >= _q->num_regions)
+        return liquid_error(LIQUID_EIRANGE,"spzoomcf_get_psd(), region index (%u) out of range", _id);
+    spzoomcf_region_flush(_q->regions[_id]);
+    return spgramcf_get_psd(_q->regions[_id]->periodogram, _psd);
+}
+
+// write block of samples to zoom spectrum analyzer
+//  _q      : zoom spectrum analyzer
+//  _x      : input buffer [size: _n x 1]
+//  _n      : input buffer length
+int spzoomcf_write(spzoomcf        _q,
+                   float complex * _x,
+                   unsigned int    _n)
+{
+    unsigned int M2 = _q->M / 2;
+    unsigned int i, j;
+    for (i=0; i<_n; i++) {
+        _q->buf_in[_q->buf_in_len++] = _x[i];
+        if (_q->buf_in_len < M2)
+            continue;
+
+        // run channelizer and distribute selected channel outputs
+        firpfbch2_crcf_execute(_q->channelizer, _q->buf_in, _q->buf_out);
+        _q->buf_in_len = 0;
+        for (j=0; j<_q->num_regions; j++) {
+            struct spzoomcf_region_s * r = _q->regions[j];
+            r->buf[r->buf_len++] = _q->buf_out[r->channel];
+            if (r->buf_len == SPZOOMCF_BLOCK_LEN)
+                spzoomcf_region_flush(r);
+        }
+    }
+    _q->num_samples += _n;
+    return LIQUID_OK;
+}
+
+// flush buffered channel samples of a region to its periodogram
+int spzoomcf_region_flush(struct spzoomcf_region_s * _r)
+{
+    if (_r->buf_len == 0)
+        return LIQUID_OK;
+    nco_crcf_mix_block_down(_r->mixer, _r->buf, _r->buf, _r->buf_len);
+    spgramcf_write(_r->periodogram, _r->buf, _r->buf_len);
+    _r->buf_len = 0;
+    return LIQUID_OK;
+}
@@ -163,6 +163,56 @@ void autotest_spgramcf_signal_03() { testbench_spgramcf_signal(400,LIQUID_WINDOW
 void autotest_spgramcf_signal_04() { testbench_spgramcf_signal(640,LIQUID_WINDOW_HAMMING,-0.5f, 0.0f); }
 void autotest_spgramcf_signal_05() { testbench_spgramcf_signal(640,LIQUID_WINDOW_HAMMING, 0.1f,-3.0f); }
 
+// block writes (optionally threaded) must match pushing samples one at a time
+void testbench_spgramcf_block(unsigned int _nfft,
+                              unsigned int _wlen,
+                              unsigned int _delay,
+                              float        _alpha,
+                              unsigned int _num_threads)
+{
+    unsigned int num_samples = 20*_nfft + 17;
+    float complex x[num_samples];
+    unsigned int i;
+    for (i=0; i<num_samples; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    // create two identical objects
+    spgramcf q0 = spgramcf_create(_nfft, LIQUID_WINDOW_HANN, _wlen, _delay);
+    spgramcf q1 = spgramcf_create(_nfft, LIQUID_WINDOW_HANN, _wlen, _delay);
+    spgramcf_set_alpha(q0, _alpha);
+    spgramcf_set_alpha(q1, _alpha);
+    CONTEND_EQUALITY(spgramcf_set_num_threads(q1, _num_threads), LIQUID_OK);
+    CONTEND_EQUALITY(spgramcf_get_num_threads(q1), _num_threads);
+
+    // push samples individually to one, write irregular blocks to other
+    for (i=0; i<num_samples; i++)
+        spgramcf_push(q0, x[i]);
+    unsigned int n = 0, block_len = 0;
+    while (n < num_samples) {
+        block_len = (block_len * 7 + 3) % (3*_nfft);
+        unsigned int k = num_samples - n < block_len ? num_samples - n : block_len;
+        spgramcf_write(q1, x + n, k);
+        n += k;
+    }
+
+    // compare counters and output
+    CONTEND_EQUALITY(spgramcf_get_num_samples   (q0), spgramcf_get_num_samples   (q1));
+    CONTEND_EQUALITY(spgramcf_get_num_transforms(q0), spgramcf_get_num_transforms(q1));
+    float psd0[_nfft], psd1[_nfft];
+    spgramcf_get_psd(q0, psd0);
+    spgramcf_get_psd(q1, psd1);
+    CONTEND_SAME_DATA(psd0, psd1, _nfft*sizeof(float));
+
+    // destroy objects
+    spgramcf_destroy(q0);
+    spgramcf_destroy(q1);
+}
+
+void autotest_spgramcf_block_0() { testbench_spgramcf_block(256, 200,  50, -1.0f, 0); }
+void autotest_spgramcf_block_1() { testbench_spgramcf_block(256, 256, 300,  0.1f, 0); }
+void autotest_spgramcf_block_2() { testbench_spgramcf_block(400, 300, 150,  0.1f, 3); }
+void autotest_spgramcf_block_3() { testbench_spgramcf_block(128,  64,  13, -1.0f, 2); }
+
 void autotest_spgramcf_counters()
 {
     // create spectral periodogram with specific parameters
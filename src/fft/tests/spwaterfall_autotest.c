@@ -151,6 +151,124 @@ void autotest_spwaterfall_operation()
     spwaterfallcf_destroy(q);
 }
 
+// block writes must produce the same waterfall as pushing samples one at a time
+void autotest_spwaterfallcf_block()
+{
+    unsigned int nfft        = 200;
+    unsigned int num_samples = 60000;
+    float complex * x = (float complex*) malloc(num_samples*sizeof(float complex));
+    unsigned int i;
+    for (i=0; i<num_samples; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    spwaterfallcf q0 = spwaterfallcf_create(nfft, LIQUID_WINDOW_HAMMING, 160, 40, 16);
+    spwaterfallcf q1 = spwaterfallcf_create(nfft, LIQUID_WINDOW_HAMMING, 160, 40, 16);
+    spwaterfallcf_set_num_threads(q1, 2);
+    for (i=0; i<num_samples; i++)
+        spwaterfallcf_push(q0, x[i]);
+    for (i=0; i<num_samples; i+=1000)
+        spwaterfallcf_write(q1, x + i, 1000);
+
+    CONTEND_EQUALITY(spwaterfallcf_get_num_samples_total(q0), num_samples);
+    CONTEND_EQUALITY(spwaterfallcf_get_num_samples_total(q1), num_samples);
+    CONTEND_EQUALITY(spwaterfallcf_get_num_time(q0), spwaterfallcf_get_num_time(q1));
+    CONTEND_SAME_DATA(spwaterfallcf_get_psd(q0), spwaterfallcf_get_psd(q1),
+                      nfft*spwaterfallcf_get_num_time(q0)*sizeof(float));
+
+    spwaterfallcf_destroy(q0);
+    spwaterfallcf_destroy(q1);
+    free(x);
+}
+
+// test memory-mapped stream output against internal buffer
+void testbench_spwaterfallcf_stream(int _format)
+{
+    unsigned int nfft     = 64;
+    unsigned int num_rows = 16;     // rows in stream ring
+    unsigned int num_time = 50;     // rows to generate (no consolidation)
+    const char * filename = "autotest_spwaterfall.stream";
+    spwaterfallcf q = spwaterfallcf_create(nfft, LIQUID_WINDOW_HANN, nfft, nfft/2, 40);
+    CONTEND_EQUALITY(spwaterfallcf_set_stream_range(q, -40.0f, 20.0f), LIQUID_OK);
+    if (spwaterfallcf_stream_open(q, filename, num_rows, _format) != LIQUID_OK) {
+        AUTOTEST_WARN("could not open stream file; skipping test");
+        spwaterfallcf_destroy(q);
+        return;
+    }
+    unsigned int i;
+    for (i=0; i<num_time*nfft/2; i++)
+        spwaterfallcf_push(q, randnf() + _Complex_I*randnf());
+    CONTEND_EQUALITY(spwaterfallcf_get_num_time(q), num_time);
+    CONTEND_EQUALITY(spwaterfallcf_get_stream_num_rows(q), num_time);
+    CONTEND_EQUALITY(spwaterfallcf_stream_close(q), LIQUID_OK);
+
+    // read file contents
+    FILE * fid = fopen(filename, "rb");
+    CONTEND_EXPRESSION(fid != NULL);
+    if (fid == NULL) { spwaterfallcf_destroy(q); return; }
+    fseek(fid, 0, SEEK_END);
+    long int len = ftell(fid);
+    fseek(fid, 0, SEEK_SET);
+    unsigned char * buf = (unsigned char*) malloc(len);
+    CONTEND_EQUALITY(fread(buf, 1, len, fid), len);
+    fclose(fid);
+
+    // validate header
+    struct liquid_spwaterfall_stream_header_s * h = (struct liquid_spwaterfall_stream_header_s*) buf;
+    CONTEND_SAME_DATA(h->magic, "LQSPWF1", 8);
+    CONTEND_EQUALITY(h->nfft,        nfft);
+    CONTEND_EQUALITY(h->num_rows,    num_rows);
+    CONTEND_EQUALITY(h->format,      _format);
+    CONTEND_EQUALITY(h->num_written, num_time);
+    CONTEND_EQUALITY(len, h->header_len + num_rows*h->row_stride);
+
+    // compare most recent rows with those in internal buffer
+    const float * psd = spwaterfallcf_get_psd(q);
+    uint64_t n;
+    for (n=num_time-num_rows+1; n<=num_time; n++) {
+        unsigned char * r = buf + h->header_len + ((n-1) % num_rows)*h->row_stride;
+        struct liquid_spwaterfall_stream_row_s * row = (struct liquid_spwaterfall_stream_row_s*) r;
+        CONTEND_EQUALITY(row->seq,            n);
+        CONTEND_EQUALITY(row->num_transforms, 1);
+        CONTEND_EQUALITY(row->num_samples,    n*nfft/2);
+        const float * ref = psd + (n-1)*nfft;
+        if (_format == LIQUID_SPWATERFALL_STREAM_FLOAT) {
+            CONTEND_SAME_DATA(r + sizeof(*row), ref, nfft*sizeof(float));
+        } else {
+            uint8_t * v = r + sizeof(*row);
+            for (i=0; i<nfft; i++) {
+                float vq = h->db_min + h->db_step*v[i];
+                float vr = ref[i] < -40.0f ? -40.0f : (ref[i] > 20.0f ? 20.0f : ref[i]);
+                CONTEND_DELTA(vq, vr, 0.5f*h->db_step + 1e-4f);
+            }
+        }
+    }
+
+    free(buf);
+    spwaterfallcf_destroy(q);
+}
+
+void autotest_spwaterfallcf_stream_float() { testbench_spwaterfallcf_stream(LIQUID_SPWATERFALL_STREAM_FLOAT); }
+void autotest_spwaterfallcf_stream_uint8() { testbench_spwaterfallcf_stream(LIQUID_SPWATERFALL_STREAM_UINT8); }
+
+void autotest_spwaterfallcf_stream_config()
+{
+#if LIQUID_STRICT_EXIT
+    AUTOTEST_WARN("skipping spwaterfallcf stream config test with strict exit enabled\n");
+    return;
+#endif
+#if !LIQUID_SUPPRESS_ERROR_OUTPUT
+    fprintf(stderr,"warning: ignore potential errors here; checking for invalid configurations\n");
+#endif
+    spwaterfallcf q = spwaterfallcf_create_default(64, 40);
+    CONTEND_INEQUALITY(spwaterfallcf_set_stream_range(q, 0.0f, 0.0f), LIQUID_OK);
+    CONTEND_INEQUALITY(spwaterfallcf_stream_open(q, "autotest_spwaterfall.stream", 0, LIQUID_SPWATERFALL_STREAM_FLOAT), LIQUID_OK);
+    CONTEND_INEQUALITY(spwaterfallcf_stream_open(q, "autotest_spwaterfall.stream", 4, -1), LIQUID_OK);
+    if (spwaterfallcf_stream_open(q, "autotest_spwaterfall.stream", 4, LIQUID_SPWATERFALL_STREAM_UINT8) == LIQUID_OK)
+        CONTEND_INEQUALITY(spwaterfallcf_set_stream_range(q, -10.0f, 10.0f), LIQUID_OK);
+    CONTEND_EQUALITY(spwaterfallcf_get_stream_num_rows(q), 0);
+    spwaterfallcf_destroy(q);
+}
+
 // test file export
 void autotest_spwaterfall_gnuplot()
 {
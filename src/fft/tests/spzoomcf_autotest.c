@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2007 - 2021 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "autotest/autotest.h"
+#include "liquid.internal.h"
+
+// place tone a number of bins away from region center and verify the
+// peak lands in the expected bin of the region spectrum
+void testbench_spzoomcf_tone(unsigned int _M,
+                             float        _fc,
+                             unsigned int _nfft,
+                             int          _bin)
+{
+    spzoomcf q = spzoomcf_create_default(_M);
+    CONTEND_EQUALITY(spzoomcf_add_region(q, _fc, _nfft), LIQUID_OK);
+    float rbw = spzoomcf_get_region_rbw(q, 0);
+    CONTEND_DELTA(rbw, 2.0f/(float)(_M*_nfft), 1e-9f);
+    if (liquid_autotest_verbose)
+        spzoomcf_print(q);
+
+    // generate tone with low noise floor
+    float        f0          = _fc + (float)_bin * rbw;
+    unsigned int buf_len     = 1000;
+    unsigned int num_samples = 40*_nfft*_M/8;
+    float complex buf[buf_len];
+    unsigned int i, n = 0;
+    while (n < num_samples) {
+        for (i=0; i<buf_len; i++, n++)
+            buf[i] = cexpf(_Complex_I*2*M_PI*fmod((double)f0*n, 1.0)) + 1e-4f*(randnf() + _Complex_I*randnf());
+        spzoomcf_write(q, buf, buf_len);
+
+        // discard estimates containing start-up transients
+        if (n == 10*buf_len)
+            spzoomcf_clear(q);
+    }
+    CONTEND_EQUALITY(spzoomcf_get_num_samples_total(q), n);
+    CONTEND_GREATER_THAN(spzoomcf_get_region_num_transforms(q, 0), 10);
+
+    // find peak and median level
+    float psd[_nfft];
+    spzoomcf_get_psd(q, 0, psd);
+    unsigned int imax = 0;
+    for (i=0; i<_nfft; i++)
+        imax = psd[i] > psd[imax] ? i : imax;
+    float psd_sorted[_nfft];
+    memmove(psd_sorted, psd, sizeof(psd));
+    unsigned int j;
+    for (i=0; i<_nfft; i++) {
+        for (j=i+1; j<_nfft; j++) {
+            if (psd_sorted[j] < psd_sorted[i]) {
+                float t = psd_sorted[i];
+                psd_sorted[i] = psd_sorted[j];
+                psd_sorted[j] = t;
+            }
+        }
+    }
+    if (liquid_autotest_verbose)
+        printf("  peak at %u (expected %d), peak: %.1f dB, median: %.1f dB\n",
+                imax, (int)_nfft/2 + _bin, psd[imax], psd_sorted[_nfft/2]);
+    CONTEND_EQUALITY(imax, _nfft/2 + _bin);
+    CONTEND_GREATER_THAN(psd[imax] - psd_sorted[_nfft/2], 80.0f);
+    spzoomcf_destroy(q);
+}
+
+void autotest_spzoomcf_tone_center()  { testbench_spzoomcf_tone( 64,  0.0000f, 256,   0); }
+void autotest_spzoomcf_tone_even()    { testbench_spzoomcf_tone( 64,  0.1234f, 256,  17); }
+void autotest_spzoomcf_tone_odd()     { testbench_spzoomcf_tone( 64, -0.2071f, 512, -40); }
+void autotest_spzoomcf_tone_edge()    { testbench_spzoomcf_tone(128,  0.4950f, 128,  -5); }
+
+// regions share a single pass over the input and are independent
+void autotest_spzoomcf_regions()
+{
+    spzoomcf q = spzoomcf_create(32, 6, 70.0f);
+    CONTEND_EQUALITY(spzoomcf_add_region(q,  0.20f, 128), LIQUID_OK);
+    CONTEND_EQUALITY(spzoomcf_add_region(q, -0.31f, 512), LIQUID_OK);
+    CONTEND_EQUALITY(spzoomcf_get_num_regions(q), 2);
+    CONTEND_EQUALITY(spzoomcf_get_region_nfft(q, 1), 512);
+    CONTEND_DELTA   (spzoomcf_get_region_freq(q, 1), -0.31f, 1e-6f);
+
+    // single tone in second region; first region sees only noise
+    unsigned int i;
+    float complex buf[500];
+    for (i=0; i<200*500; i++) {
+        buf[i % 500] = cexpf(_Complex_I*2*M_PI*(-0.31f)*i) + 1e-3f*(randnf() + _Complex_I*randnf());
+        if ((i % 500) == 499)
+            spzoomcf_write(q, buf, 500);
+    }
+    float psd0[128], psd1[512];
+    spzoomcf_get_psd(q, 0, psd0);
+    spzoomcf_get_psd(q, 1, psd1);
+    for (i=0; i<128; i++)
+        CONTEND_LESS_THAN(psd0[i], -30.0f);
+    CONTEND_GREATER_THAN(psd1[256], 20.0f);
+
+    // clearing removes estimates from all regions
+    spzoomcf_clear(q);
+    CONTEND_EQUALITY(spzoomcf_get_region_num_transforms(q, 0), 0);
+    CONTEND_EQUALITY(spzoomcf_get_region_num_transforms(q, 1), 0);
+    spzoomcf_reset(q);
+    CONTEND_EQUALITY(spzoomcf_get_num_samples_total(q), 0);
+    spzoomcf_destroy(q);
+}
+
+void autotest_spzoomcf_config()
+{
+#if LIQUID_STRICT_EXIT
+    AUTOTEST_WARN("skipping spzoomcf config test with strict exit enabled\n");
+    return;
+#endif
+#if !LIQUID_SUPPRESS_ERROR_OUTPUT
+    fprintf(stderr,"warning: ignore potential errors here; checking for invalid configurations\n");
+#endif
+    CONTEND_ISNULL(spzoomcf_create( 0, 4, 60.0f));
+    CONTEND_ISNULL(spzoomcf_create(17, 4, 60.0f));
+    CONTEND_ISNULL(spzoomcf_create(16, 0, 60.0f));
+    CONTEND_ISNULL(spzoomcf_create(16, 4,  0.0f));
+
+    spzoomcf q = spzoomcf_create_default(16);
+    CONTEND_INEQUALITY(spzoomcf_add_region(q, 0.5f, 64), LIQUID_OK);
+    CONTEND_INEQUALITY(spzoomcf_add_region(q, 0.1f,  1), LIQUID_OK);
+    CONTEND_EQUALITY  (spzoomcf_get_num_regions(q), 0);
+    CONTEND_INEQUALITY(spzoomcf_set_region_alpha(q, 0, 0.1f), LIQUID_OK);
+    CONTEND_EQUALITY  (spzoomcf_add_region(q, 0.1f, 64), LIQUID_OK);
+    CONTEND_EQUALITY  (spzoomcf_set_region_alpha(q, 0, 0.1f), LIQUID_OK);
+    CONTEND_INEQUALITY(spzoomcf_set_region_alpha(q, 0, 2.0f), LIQUID_OK);
+    float psd[64];
+    CONTEND_INEQUALITY(spzoomcf_get_psd(q, 1, psd), LIQUID_OK);
+    CONTEND_EQUALITY  (spzoomcf_get_region_nfft(q, 1), 0);
+    CONTEND_EQUALITY  (spzoomcf_print(q), LIQUID_OK);
+    spzoomcf_destroy(q);
+}
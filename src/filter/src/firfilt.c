@@ -68,9 +68,9 @@ FIRFILT() FIRFILT(_create)(TC * _h,
         return liquid_error_config("firfilt_%s_create(), filter length must be greater than zero", EXTENSION_FULL);
 
     // create filter object and initialize
-    FIRFILT() q = (FIRFILT()) malloc(sizeof(struct FIRFILT(_s)));
+    FIRFILT() q = (FIRFILT()) liquid_malloc(sizeof(struct FIRFILT(_s)));
     q->h_len = _n;
-    q->h = (TC *) malloc((q->h_len)*sizeof(TC));
+    q->h = (TC *) liquid_malloc((q->h_len)*sizeof(TC));
 
 #if LIQUID_FIRFILT_USE_WINDOW
     // create window (internal buffer)
@@ -79,7 +79,7 @@ FIRFILT() FIRFILT(_create)(TC * _h,
     // initialize array for buffering
     q->w_len   = 1<<liquid_msb_index(q->h_len); // effectively 2^{floor(log2(len))+1}
     q->w_mask  = q->w_len - 1;
-    q->w       = (TI *) malloc((q->w_len + q->h_len + 1)*sizeof(TI));
+    q->w       = (TI *) liquid_malloc((q->w_len + q->h_len + 1)*sizeof(TI));
     q->w_index = 0;
 #endif
 
@@ -287,20 +287,20 @@ FIRFILT() FIRFILT(_recreate)(FIRFILT() _q,
     if (_n != _q->h_len) {
         // reallocate memory
         _q->h_len = _n;
-        _q->h = (TC*) realloc(_q->h, (_q->h_len)*sizeof(TC));
+        _q->h = (TC*) liquid_realloc(_q->h, (_q->h_len)*sizeof(TC));
 
 #if LIQUID_FIRFILT_USE_WINDOW
         // recreate window object, preserving internal state
         _q->w = WINDOW(_recreate)(_q->w, _q->h_len);
 #else
         // free old array
-        free(_q->w);
+        liquid_free(_q->w);
 
         // initialize array for buffering
         _q->w_len   = 1<<liquid_msb_index(_q->h_len);   // effectively 2^{floor(log2(len))+1}
         _q->w_mask  = _q->w_len - 1;
         // FIXME: valgrind is complaining about an uninitialized variable in the following malloc line
-        _q->w       = (TI *) malloc((_q->w_len + _q->h_len + 1)*sizeof(TI));
+        _q->w       = (TI *) liquid_malloc((_q->w_len + _q->h_len + 1)*sizeof(TI));
         _q->w_index = 0;
 #endif
     }
@@ -321,11 +321,11 @@ void FIRFILT(_destroy)(FIRFILT() _q)
 #if LIQUID_FIRFILT_USE_WINDOW
     WINDOW(_destroy)(_q->w);
 #else
-    free(_q->w);
+    liquid_free(_q->w);
 #endif
     DOTPROD(_destroy)(_q->dp);
-    free(_q->h);
-    free(_q);
+    liquid_free(_q->h);
+    liquid_free(_q);
 }
 
 // reset internal state of filter object
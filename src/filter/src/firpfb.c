@@ -53,14 +53,14 @@ FIRPFB() FIRPFB(_create)(unsigned int _M,
         return liquid_error_config("firpfb_%s_create(), filter length must be greater than zero",EXTENSION_FULL);
 
     // create main filter object
-    FIRPFB() q = (FIRPFB()) malloc(sizeof(struct FIRPFB(_s)));
+    FIRPFB() q = (FIRPFB()) liquid_malloc(sizeof(struct FIRPFB(_s)));
 
     // set user-defined parameters
     q->num_filters = _M;
     q->h_len       = _h_len;
 
     // each filter is realized as a dotprod object
-    q->dp = (DOTPROD()*) malloc((q->num_filters)*sizeof(DOTPROD()));
+    q->dp = (DOTPROD()*) liquid_malloc((q->num_filters)*sizeof(DOTPROD()));
 
     // generate bank of sub-samped filters
     // length of each sub-sampled filter
@@ -264,9 +264,9 @@ void FIRPFB(_destroy)(FIRPFB() _q)
     unsigned int i;
     for (i=0; i<_q->num_filters; i++)
         DOTPROD(_destroy)(_q->dp[i]);
-    free(_q->dp);
+    liquid_free(_q->dp);
     WINDOW(_destroy)(_q->w);
-    free(_q);
+    liquid_free(_q);
 }
 
 // print firpfb object's parameters
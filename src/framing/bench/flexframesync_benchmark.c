@@ -20,37 +20,73 @@
  * THE SOFTWARE.
  */
 
+// RUSAGE_THREAD is a GNU extension
+#ifndef _GNU_SOURCE
+#  define _GNU_SOURCE
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/resource.h>
 #include <assert.h>
 #include "liquid.h"
 
+// measure time spent on the sample-processing thread only, so that
+// asynchronous decoding is credited for moving work off that thread;
+// without per-thread usage the asynchronous cases cannot be timed
+#ifdef RUSAGE_THREAD
+#  define FLEXFRAMESYNC_BENCH_RUSAGE        RUSAGE_THREAD
+#  define FLEXFRAMESYNC_BENCH_THREAD_TIMING 1
+#else
+#  define FLEXFRAMESYNC_BENCH_RUSAGE        RUSAGE_SELF
+#  define FLEXFRAMESYNC_BENCH_THREAD_TIMING 0
+#endif
+
 // Helper function to keep code base small
-void benchmark_flexframesync(
-    struct rusage *_start,
-    struct rusage *_finish,
-    unsigned long int *_num_iterations)
+//  _fec0           :   payload inner FEC scheme
+//  _payload_len    :   payload length (bytes)
+//  _queue_len      :   asynchronous decoder queue length (0: decode inline)
+//  _num_workers    :   number of asynchronous decoder threads
+void flexframesync_bench(struct rusage *     _start,
+                         struct rusage *     _finish,
+                         unsigned long int * _num_iterations,
+                         int                 _fec0,
+                         unsigned int        _payload_len,
+                         unsigned int        _queue_len,
+                         unsigned int        _num_workers)
 {
-    *_num_iterations /= 128;
     unsigned long int i;
 
+    // process time would include the decoder threads; report and skip
+    if (!FLEXFRAMESYNC_BENCH_THREAD_TIMING && _num_workers > 0) {
+        static int reported = 0;
+        if (!reported)
+            fprintf(stderr,"error: flexframesync_bench(), per-thread CPU time unavailable; skipping asynchronous benchmark\n");
+        reported = 1;
+        memset(_start,  0, sizeof(struct rusage));
+        memset(_finish, 0, sizeof(struct rusage));
+        *_num_iterations = 0;
+        return;
+    }
+
     // create flexframegen object
     flexframegenprops_s fgprops;
     flexframegenprops_init_default(&fgprops);
     fgprops.check      = LIQUID_CRC_32;
-    fgprops.fec0       = LIQUID_FEC_NONE;
+    fgprops.fec0       = _fec0;
     fgprops.fec1       = LIQUID_FEC_NONE;
     fgprops.mod_scheme = LIQUID_MODEM_QPSK;
     flexframegen fg = flexframegen_create(&fgprops);
 
     // generate the frame
-    unsigned int payload_len = 8;
     unsigned char header[14];
-    unsigned char payload[payload_len];
-    flexframegen_assemble(fg, header, payload, payload_len);
+    unsigned char payload[_payload_len];
+    for (i=0; i<_payload_len; i++)
+        payload[i] = rand() & 0xff;
+    flexframegen_assemble(fg, header, payload, _payload_len);
     unsigned int frame_len = flexframegen_getframelen(fg);
-    float complex frame[frame_len];
+    float complex * frame = (float complex*) malloc(frame_len*sizeof(float complex));
     flexframegen_write_samples(fg, frame, frame_len);
 
     // add some noise
@@ -59,19 +95,44 @@ void benchmark_flexframesync(
 
     // create flexframesync object
     flexframesync fs = flexframesync_create(NULL, NULL);
+    flexframesync_decode_payload_soft(fs, 1);
+    flexframesync_set_async_decode(fs, _queue_len, _num_workers);
+
+    // scale trials by frame length; results are reported in samples/s
+    unsigned long int num_frames = *_num_iterations / frame_len;
+    num_frames = num_frames < 4 ? 4 : num_frames;
 
     // start trials
-    getrusage(RUSAGE_SELF, _start);
-    for (i=0; i<(*_num_iterations); i++) {
+    getrusage(FLEXFRAMESYNC_BENCH_RUSAGE, _start);
+    for (i=0; i<num_frames; i++) {
         flexframesync_execute(fs, frame, frame_len);
     }
-    getrusage(RUSAGE_SELF, _finish);
+    getrusage(FLEXFRAMESYNC_BENCH_RUSAGE, _finish);
+    *_num_iterations = num_frames * frame_len;
 
-    // print frame data statistics
-    //flexframesync_print(fs);
+    // wait for outstanding frames outside of timing window
+    flexframesync_async_flush(fs);
+    framedatastats_s stats = flexframesync_get_framedatastats(fs);
+    if (stats.num_payloads_valid != num_frames)
+        fprintf(stderr,"warning: flexframesync_bench(), only %u/%lu frames valid\n", stats.num_payloads_valid, num_frames);
 
     // destroy objects
+    free(frame);
     flexframegen_destroy(fg);
     flexframesync_destroy(fs);
 }
 
+#define FLEXFRAMESYNC_BENCHMARK_API(FEC, LEN, QUEUE, WORKERS)       \
+(   struct rusage *_start,                                          \
+    struct rusage *_finish,                                         \
+    unsigned long int *_num_iterations)                             \
+{ flexframesync_bench(_start, _finish, _num_iterations, FEC, LEN, QUEUE, WORKERS); }
+
+// uncoded, short payload (inline decoding)
+void benchmark_flexframesync FLEXFRAMESYNC_BENCHMARK_API(LIQUID_FEC_NONE, 8, 0, 0)
+
+// long coded payloads, decoded inline and asynchronously
+void benchmark_flexframesync_g2412_inline  FLEXFRAMESYNC_BENCHMARK_API(LIQUID_FEC_GOLAY2412, 1024, 0, 0)
+void benchmark_flexframesync_g2412_async   FLEXFRAMESYNC_BENCHMARK_API(LIQUID_FEC_GOLAY2412, 1024, 8, 2)
+void benchmark_flexframesync_s7264_inline  FLEXFRAMESYNC_BENCHMARK_API(LIQUID_FEC_SECDED7264, 1024, 0, 0)
+void benchmark_flexframesync_s7264_async   FLEXFRAMESYNC_BENCHMARK_API(LIQUID_FEC_SECDED7264, 1024, 8, 2)
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2007 - 2022 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include "liquid.h"
+
+// Helper function to keep code base small
+//  _M              :   number of subcarriers
+//  _cp_len         :   cyclic prefix length
+//  _payload_len    :   payload length (bytes)
+//  _buf_len        :   output buffer length for each write
+void ofdmflexframegen_bench(struct rusage *     _start,
+                            struct rusage *     _finish,
+                            unsigned long int * _num_iterations,
+                            unsigned int        _M,
+                            unsigned int        _cp_len,
+                            unsigned int        _payload_len,
+                            unsigned int        _buf_len)
+{
+    unsigned long int i;
+
+    // create frame generator
+    ofdmflexframegenprops_s fgprops;
+    ofdmflexframegenprops_init_default(&fgprops);
+    fgprops.check      = LIQUID_CRC_32;
+    fgprops.fec0       = LIQUID_FEC_NONE;
+    fgprops.fec1       = LIQUID_FEC_NONE;
+    fgprops.mod_scheme = LIQUID_MODEM_QPSK;
+    ofdmflexframegen fg = ofdmflexframegen_create(_M, _cp_len, _cp_len/4, NULL, &fgprops);
+
+    unsigned char header[8] = {0};
+    unsigned char payload[_payload_len];
+    for (i=0; i<_payload_len; i++)
+        payload[i] = rand() & 0xff;
+    float complex * buf = (float complex*) malloc(_buf_len*sizeof(float complex));
+
+    // scale trials by frame length; results are reported in samples/s
+    ofdmflexframegen_assemble(fg, header, payload, _payload_len);
+    unsigned int frame_len = ofdmflexframegen_getframelen(fg)*(_M + _cp_len);
+    unsigned long int num_frames = *_num_iterations / frame_len;
+    num_frames = num_frames < 4 ? 4 : num_frames;
+    unsigned long int num_samples = 0;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<num_frames; i++) {
+        ofdmflexframegen_assemble(fg, header, payload, _payload_len);
+        int frame_complete = 0;
+        while (!frame_complete) {
+            frame_complete = ofdmflexframegen_write(fg, buf, _buf_len);
+            num_samples += _buf_len;
+        }
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations = num_samples;
+
+    // destroy objects
+    free(buf);
+    ofdmflexframegen_destroy(fg);
+}
+
+#define OFDMFLEXFRAMEGEN_BENCHMARK_API(M, CP_LEN, LEN, BUF_LEN)     \
+(   struct rusage *_start,                                          \
+    struct rusage *_finish,                                         \
+    unsigned long int *_num_iterations)                             \
+{ ofdmflexframegen_bench(_start, _finish, _num_iterations, M, CP_LEN, LEN, BUF_LEN); }
+
+// increasing number of subcarriers, small and large output buffers
+void benchmark_ofdmflexframegen_n64_b256      OFDMFLEXFRAMEGEN_BENCHMARK_API(  64,   8,  400,   256)
+void benchmark_ofdmflexframegen_n64_b4096     OFDMFLEXFRAMEGEN_BENCHMARK_API(  64,   8,  400,  4096)
+void benchmark_ofdmflexframegen_n256_b4096    OFDMFLEXFRAMEGEN_BENCHMARK_API( 256,  32, 1600,  4096)
+void benchmark_ofdmflexframegen_n1024_b16384  OFDMFLEXFRAMEGEN_BENCHMARK_API(1024, 128, 6400, 16384)
+void benchmark_ofdmflexframegen_n2048_b16384  OFDMFLEXFRAMEGEN_BENCHMARK_API(2048, 256,12800, 16384)
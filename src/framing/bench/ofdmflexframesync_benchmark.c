@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2007 - 2022 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <assert.h>
+#include "liquid.h"
+
+// Helper function to keep code base small
+//  _M              :   number of subcarriers
+//  _cp_len         :   cyclic prefix length
+//  _payload_len    :   payload length (bytes)
+//  _soft           :   soft payload demodulation?
+void ofdmflexframesync_bench(struct rusage *     _start,
+                             struct rusage *     _finish,
+                             unsigned long int * _num_iterations,
+                             unsigned int        _M,
+                             unsigned int        _cp_len,
+                             unsigned int        _payload_len,
+                             int                 _soft)
+{
+    unsigned long int i;
+
+    // create frame generator
+    ofdmflexframegenprops_s fgprops;
+    ofdmflexframegenprops_init_default(&fgprops);
+    fgprops.check      = LIQUID_CRC_32;
+    fgprops.fec0       = LIQUID_FEC_NONE;
+    fgprops.fec1       = LIQUID_FEC_NONE;
+    fgprops.mod_scheme = LIQUID_MODEM_QPSK;
+    ofdmflexframegen fg = ofdmflexframegen_create(_M, _cp_len, 0, NULL, &fgprops);
+
+    // generate the frame, followed by a few symbols of silence
+    unsigned char header[8] = {0};
+    unsigned char payload[_payload_len];
+    for (i=0; i<_payload_len; i++)
+        payload[i] = rand() & 0xff;
+    ofdmflexframegen_assemble(fg, header, payload, _payload_len);
+    unsigned int frame_len = (ofdmflexframegen_getframelen(fg) + 4)*(_M + _cp_len);
+    float complex * frame = (float complex*) malloc(frame_len*sizeof(float complex));
+    ofdmflexframegen_write(fg, frame, frame_len);
+
+    // add some noise
+    for (i=0; i<frame_len; i++)
+        frame[i] += 0.02f*(randnf() + _Complex_I*randnf());
+
+    // create frame synchronizer
+    ofdmflexframesync fs = ofdmflexframesync_create(_M, _cp_len, 0, NULL, NULL, NULL);
+    ofdmflexframesync_decode_payload_soft(fs, _soft);
+
+    // scale trials by frame length; results are reported in samples/s
+    unsigned long int num_frames = *_num_iterations / frame_len;
+    num_frames = num_frames < 4 ? 4 : num_frames;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<num_frames; i++) {
+        ofdmflexframesync_execute(fs, frame, frame_len);
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations = num_frames * frame_len;
+
+    framedatastats_s stats = ofdmflexframesync_get_framedatastats(fs);
+    if (stats.num_payloads_valid != num_frames)
+        fprintf(stderr,"warning: ofdmflexframesync_bench(), only %u/%lu frames valid\n", stats.num_payloads_valid, num_frames);
+
+    // destroy objects
+    free(frame);
+    ofdmflexframegen_destroy(fg);
+    ofdmflexframesync_destroy(fs);
+}
+
+#define OFDMFLEXFRAMESYNC_BENCHMARK_API(M, CP_LEN, LEN, SOFT)       \
+(   struct rusage *_start,                                          \
+    struct rusage *_finish,                                         \
+    unsigned long int *_num_iterations)                             \
+{ ofdmflexframesync_bench(_start, _finish, _num_iterations, M, CP_LEN, LEN, SOFT); }
+
+// hard/soft payload demodulation for increasing number of subcarriers
+void benchmark_ofdmflexframesync_n64      OFDMFLEXFRAMESYNC_BENCHMARK_API(  64,   8,  400, 0)
+void benchmark_ofdmflexframesync_n64_soft OFDMFLEXFRAMESYNC_BENCHMARK_API(  64,   8,  400, 1)
+void benchmark_ofdmflexframesync_n256     OFDMFLEXFRAMESYNC_BENCHMARK_API( 256,  32, 1600, 0)
+void benchmark_ofdmflexframesync_n1024    OFDMFLEXFRAMESYNC_BENCHMARK_API(1024, 128, 6400, 0)
+void benchmark_ofdmflexframesync_n1024_soft OFDMFLEXFRAMESYNC_BENCHMARK_API(1024, 128, 6400, 1)
+void benchmark_ofdmflexframesync_n2048_soft OFDMFLEXFRAMESYNC_BENCHMARK_API(2048, 256, 12800, 1)
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2007 - 2022 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+
+#include "liquid.internal.h"
+
+// Helper function to keep code base small
+//  _n      : number of samples per call
+//  _block  : run block method (1) or one sample at a time (0)
+void symtrack_cccf_bench(struct rusage *     _start,
+                         struct rusage *     _finish,
+                         unsigned long int * _num_iterations,
+                         unsigned int        _n,
+                         int                 _block)
+{
+    // adjust number of iterations
+    *_num_iterations /= 4*_n;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // generate input signal
+    float complex x[_n];
+    float complex y[2*_n];
+    symstreamcf gen = symstreamcf_create_linear(LIQUID_FIRFILT_ARKAISER,2,7,0.3f,LIQUID_MODEM_QPSK);
+    symstreamcf_write_samples(gen, x, _n);
+    symstreamcf_destroy(gen);
+
+    // create synchronizer
+    symtrack_cccf q = symtrack_cccf_create_default();
+    symtrack_cccf_set_bandwidth(q, 0.1f);
+
+    // start trials
+    unsigned long int i;
+    unsigned int j, nw, num_symbols = 0;
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        if (_block) {
+            symtrack_cccf_execute_block(q, x, _n, y, &nw);
+            num_symbols += nw;
+        } else {
+            for (j=0; j<_n; j++) {
+                symtrack_cccf_execute(q, x[j], y, &nw);
+                num_symbols += nw;
+            }
+        }
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= _n;
+
+    // clean up allocated objects
+    symtrack_cccf_destroy(q);
+}
+
+#define SYMTRACK_CCCF_BENCHMARK_API(N,B)    \
+(   struct rusage *     _start,             \
+    struct rusage *     _finish,            \
+    unsigned long int * _num_iterations)    \
+{ symtrack_cccf_bench(_start, _finish, _num_iterations, N, B); }
+
+void benchmark_symtrack_cccf_sample_1024    SYMTRACK_CCCF_BENCHMARK_API(1024, 0);
+void benchmark_symtrack_cccf_block_64       SYMTRACK_CCCF_BENCHMARK_API(  64, 1);
+void benchmark_symtrack_cccf_block_1024     SYMTRACK_CCCF_BENCHMARK_API(1024, 1);
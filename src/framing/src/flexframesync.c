@@ -42,32 +42,105 @@
 
 #define FLEXFRAMESYNC_ENABLE_EQ     0
 
+// maximum number of concurrent demodulators
+#define FLEXFRAMESYNC_MAX_DEMODS    (64)
+
+// demodulator context: per-frame receiver state, allocated from the pool
+// held by the main object so that several frames can be received at once
+struct flexframesync_demod_s {
+    // synchronizer objects
+    float           tau_hat;            // fractional timing offset estimate
+    float           dphi_hat;           // carrier frequency offset estimate
+    float           phi_hat;            // carrier phase offset estimate
+    float           gamma_hat;          // channel gain estimate
+    nco_crcf        mixer;              // carrier frequency recovery (coarse)
+    nco_crcf        pll;                // carrier frequency recovery (fine)
+
+    // timing recovery objects, states
+    firpfb_crcf     mf;                 // matched filter decimator
+    int             mf_counter;         // matched filter output timer
+    unsigned int    pfb_index;          // filterbank index
+#if FLEXFRAMESYNC_ENABLE_EQ
+    eqlms_cccf      equalizer;          // equalizer (trained on p/n sequence)
+#endif
+
+    // preamble
+    float complex * preamble_rx;        // received p/n symbols
+
+    // header
+    float complex * header_sym;         // header symbols with pilots (received)
+    unsigned char * header_dec;         // header bytes (decoded)
+    int             header_valid;       // header CRC flag
+
+    // payload
+    modemcf         payload_demod;      // payload demod (for phase recovery only)
+    float complex * payload_sym;        // payload symbols (received)
+    unsigned int    payload_sym_len;    // payload symbols (length)
+    qpacketmodem    payload_decoder;    // payload demodulator/decoder
+    unsigned char * payload_dec;        // payload data (bytes)
+    unsigned int    payload_dec_len;    // payload data (length)
+    int             payload_valid;      // payload CRC flag
+    unsigned char * payload_enc;        // demodulated payload (asynchronous decoding)
+
+    framesyncstats_s framesyncstats;    // frame statistic object (synchronizer)
+
+    // status variables
+    unsigned int    preamble_counter;   // counter: num of p/n syms received
+    unsigned int    symbol_counter;     // counter: num of symbols received
+    enum {
+        FLEXFRAMESYNC_STATE_DETECTFRAME=0,  // idle: waiting for detector
+        FLEXFRAMESYNC_STATE_RXPREAMBLE,     // receive p/n sequence
+        FLEXFRAMESYNC_STATE_RXHEADER,       // receive header data
+        FLEXFRAMESYNC_STATE_RXPAYLOAD,      // receive payload data
+    }               state;                  // receiver state
+};
+
+typedef struct flexframesync_demod_s * flexframesync_demod;
+
 // push samples through detection stage
 int flexframesync_execute_seekpn(flexframesync _q,
                                  float complex _x);
 
+// create/destroy/reset demodulator context
+int flexframesync_demod_init   (flexframesync _q, flexframesync_demod _d);
+int flexframesync_demod_free   (flexframesync _q, flexframesync_demod _d);
+int flexframesync_demod_reset  (flexframesync _q, flexframesync_demod _d);
+
+// push sample through demodulator context
+int flexframesync_demod_execute(flexframesync       _q,
+                                flexframesync_demod _d,
+                                float complex       _x);
+
 // step receiver mixer, matched filter, decimator
-//  _q      :   frame synchronizer
+//  _d      :   demodulator context
 //  _x      :   input sample
 //  _y      :   output symbol
-int flexframesync_step(flexframesync   _q,
-                       float complex   _x,
-                       float complex * _y);
+int flexframesync_step(flexframesync_demod _d,
+                       float complex       _x,
+                       float complex *     _y);
 
 // push samples through synchronizer, saving received p/n symbols
-int flexframesync_execute_rxpreamble(flexframesync _q,
-                                     float complex _x);
+int flexframesync_execute_rxpreamble(flexframesync       _q,
+                                     flexframesync_demod _d,
+                                     float complex       _x);
 
 // decode header and reconfigure payload
-int flexframesync_decode_header(flexframesync _q);
+int flexframesync_decode_header(flexframesync       _q,
+                                flexframesync_demod _d);
 
 // receive header symbols
-int flexframesync_execute_rxheader(flexframesync _q,
-                                   float complex _x);
+int flexframesync_execute_rxheader(flexframesync       _q,
+                                   flexframesync_demod _d,
+                                   float complex       _x);
 
 // receive payload symbols
-int flexframesync_execute_rxpayload(flexframesync _q,
-                                    float complex _x);
+int flexframesync_execute_rxpayload(flexframesync       _q,
+                                    flexframesync_demod _d,
+                                    float complex       _x);
+
+// demodulate payload symbols and push onto asynchronous decoder queue
+int flexframesync_push_payload(flexframesync       _q,
+                               flexframesync_demod _d);
 
 static flexframegenprops_s flexframesyncprops_header_default = {
    FLEXFRAME_H_CRC,
@@ -81,36 +154,20 @@ struct flexframesync_s {
     // callback
     framesync_callback  callback;       // user-defined callback function
     void *              userdata;       // user-defined data structure
-    framesyncstats_s    framesyncstats; // frame statistic object (synchronizer)
     framedatastats_s    framedatastats; // frame statistic object (packet statistics)
     
     // synchronizer objects
     unsigned int    m;                  // filter delay (symbols)
     float           beta;               // filter excess bandwidth factor
     qdetector_cccf  detector;           // pre-demod detector
-    float           tau_hat;            // fractional timing offset estimate
-    float           dphi_hat;           // carrier frequency offset estimate
-    float           phi_hat;            // carrier phase offset estimate
-    float           gamma_hat;          // channel gain estimate
-    nco_crcf        mixer;              // carrier frequency recovery (coarse)
-    nco_crcf        pll;                // carrier frequency recovery (fine)
-
-    // timing recovery objects, states
-    firpfb_crcf     mf;                 // matched filter decimator
+    int             detector_idle;      // detector stalled (all demods busy)
     unsigned int    npfb;               // number of filters in symsync
-    int             mf_counter;         // matched filter output timer
-    unsigned int    pfb_index;          // filterbank index
-#if FLEXFRAMESYNC_ENABLE_EQ
-    eqlms_cccf      equalizer;          // equalizer (trained on p/n sequence)
-#endif
 
     // preamble
     float complex * preamble_pn;        // known 64-symbol p/n sequence
-    float complex * preamble_rx;        // received p/n symbols
     
-    // header
+    // header (decoding objects are shared among demodulators)
     int             header_soft;        // header performs soft demod
-    float complex * header_sym;         // header symbols with pilots (received)
     unsigned int    header_sym_len;     // header symbols with pilots (length)
     qpilotsync      header_pilotsync;   // header demodulator/decoder
     float complex * header_mod;         // header symbols (received)
@@ -118,35 +175,20 @@ struct flexframesync_s {
     qpacketmodem    header_decoder;     // header demodulator/decoder
     unsigned int    header_user_len;    // length of user-defined array
     unsigned int    header_dec_len;     // length of header (decoded)
-    unsigned char * header_dec;         // header bytes (decoded)
-    int             header_valid;       // header CRC flag
 
     flexframegenprops_s header_props;   // header properties
 
     // payload
     int             payload_soft;       // payload performs soft demod
-    modemcf         payload_demod;      // payload demod (for phase recovery only)
-    float complex * payload_sym;        // payload symbols (received)
-    unsigned int    payload_sym_len;    // payload symbols (length)
-    qpacketmodem    payload_decoder;    // payload demodulator/decoder
-    unsigned char * payload_dec;        // payload data (bytes)
-    unsigned int    payload_dec_len;    // payload data (length)
-    int             payload_valid;      // payload CRC flag
-    
-    // status variables
-    unsigned int    preamble_counter;   // counter: num of p/n syms received
-    unsigned int    symbol_counter;     // counter: num of symbols received
-    enum {
-        FLEXFRAMESYNC_STATE_DETECTFRAME=0,  // detect frame (seek p/n sequence)
-        FLEXFRAMESYNC_STATE_RXPREAMBLE,     // receive p/n sequence
-        FLEXFRAMESYNC_STATE_RXHEADER,       // receive header data
-        FLEXFRAMESYNC_STATE_RXPAYLOAD,      // receive payload data
-    }               state;                  // receiver state
+    framedecq       decq;               // asynchronous payload decoder (NULL: decode inline)
+
+    // pool of demodulators
+    struct flexframesync_demod_s * demod;   // demodulator contexts
+    unsigned int    num_demods;             // number of demodulator contexts
 
 #if DEBUG_FLEXFRAMESYNC
     int         debug_enabled;          // debugging enabled?
     int         debug_objects_created;  // debugging objects created?
-    int         debug_qdetector_flush;  // debug: flag to set if we are flushing detector
     windowcf    debug_x;                // debug: raw input samples
 #endif
 };
@@ -167,7 +209,6 @@ flexframesync flexframesync_create(framesync_callback _callback,
 
     // generate p/n sequence
     q->preamble_pn = (float complex*) malloc(64*sizeof(float complex));
-    q->preamble_rx = (float complex*) malloc(64*sizeof(float complex));
     msequence ms = msequence_create(7, 0x0089, 1);
     for (i=0; i<64; i++) {
         q->preamble_pn[i] = (msequence_advance(ms) ? M_SQRT1_2 : -M_SQRT1_2);
@@ -180,51 +221,26 @@ flexframesync flexframesync_create(framesync_callback _callback,
     q->detector = qdetector_cccf_create_linear(q->preamble_pn, 64, LIQUID_FIRFILT_ARKAISER, k, q->m, q->beta);
     qdetector_cccf_set_threshold(q->detector, 0.5f);
 
-    // create symbol timing recovery filters
-    q->npfb = 32;   // number of filters in the bank
-    q->mf   = firpfb_crcf_create_rnyquist(LIQUID_FIRFILT_ARKAISER, q->npfb,k,q->m,q->beta);
+    // number of filters in symbol timing recovery filterbank
+    q->npfb = 32;
 
-#if FLEXFRAMESYNC_ENABLE_EQ
-    // create equalizer
-    unsigned int p = 3;
-    q->equalizer = eqlms_cccf_create_lowpass(2*k*p+1, 0.4f);
-    eqlms_cccf_set_bw(q->equalizer, 0.05f);
-#endif
-
-    // create down-coverters for carrier phase tracking
-    q->mixer = nco_crcf_create(LIQUID_NCO);
-    q->pll   = nco_crcf_create(LIQUID_NCO);
-    nco_crcf_pll_set_bandwidth(q->pll, 1e-4f); // very low bandwidth
-    
     // header demodulator/decoder
-    q->header_sym = NULL;
     q->header_mod = NULL;
-    q->header_dec = NULL;
     q->header_pilotsync = NULL;
     q->header_decoder = NULL;
     q->header_user_len = FLEXFRAME_H_USER_DEFAULT;
     q->header_soft = 0;
-    flexframesync_set_header_props(q, NULL);
+    q->payload_soft = 0;
+    q->decq = NULL;
 
-    // payload demodulator for phase recovery
-    q->payload_demod = modemcf_create(LIQUID_MODEM_QPSK);
+    // create single demodulator (default, frames are received serially)
+    q->detector_idle = 0;
+    q->num_demods = 1;
+    q->demod = (struct flexframesync_demod_s*) malloc(q->num_demods*sizeof(struct flexframesync_demod_s));
+    flexframesync_demod_init(q, &q->demod[0]);
 
-    // create payload demodulator/decoder object
-    q->payload_dec_len = 64;
-    int check      = LIQUID_CRC_24;
-    int fec0       = LIQUID_FEC_NONE;
-    int fec1       = LIQUID_FEC_GOLAY2412;
-    int mod_scheme = LIQUID_MODEM_BPSK;
-    q->payload_decoder = qpacketmodem_create();
-    qpacketmodem_configure(q->payload_decoder, q->payload_dec_len, check, fec0, fec1, mod_scheme);
-    //qpacketmodem_print(q->payload_decoder);
-    //assert( qpacketmodem_get_frame_len(q->payload_decoder)==600 );
-    q->payload_sym_len = qpacketmodem_get_frame_len(q->payload_decoder);
-
-    // allocate memory for payload symbols and recovered data bytes
-    q->payload_sym = (float complex*) malloc(q->payload_sym_len*sizeof(float complex));
-    q->payload_dec = (unsigned char*) malloc(q->payload_dec_len*sizeof(unsigned char));
-    q->payload_soft = 0;
+    // configure header (allocates per-demodulator header buffers)
+    flexframesync_set_header_props(q, NULL);
 
     // reset global data counters
     flexframesync_reset_framedatastats(q);
@@ -233,7 +249,6 @@ flexframesync flexframesync_create(framesync_callback _callback,
     // set debugging flags, objects to NULL
     q->debug_enabled         = 0;
     q->debug_objects_created = 0;
-    q->debug_qdetector_flush = 0;
     q->debug_x               = NULL;
 #endif
 
@@ -251,27 +266,24 @@ int flexframesync_destroy(flexframesync _q)
         windowcf_destroy(_q->debug_x);
 #endif
 
+    // destroy asynchronous decoder, discarding undelivered frames
+    if (_q->decq != NULL)
+        framedecq_destroy(_q->decq);
+
+    // destroy demodulator contexts
+    unsigned int i;
+    for (i=0; i<_q->num_demods; i++)
+        flexframesync_demod_free(_q, &_q->demod[i]);
+    free(_q->demod);
+
     // free allocated arrays
     free(_q->preamble_pn);
-    free(_q->preamble_rx);
-    free(_q->header_sym);
     free(_q->header_mod);
-    free(_q->header_dec);
-    free(_q->payload_sym);
-    free(_q->payload_dec);
 
     // destroy synchronization objects
     qpilotsync_destroy    (_q->header_pilotsync); // header demodulator/decoder
     qpacketmodem_destroy  (_q->header_decoder);   // header demodulator/decoder
-    modemcf_destroy         (_q->payload_demod);    // payload demodulator (for PLL)
-    qpacketmodem_destroy  (_q->payload_decoder);  // payload demodulator/decoder
     qdetector_cccf_destroy(_q->detector);         // frame detector
-    firpfb_crcf_destroy   (_q->mf);               // matched filter
-    nco_crcf_destroy      (_q->mixer);            // oscillator (coarse)
-    nco_crcf_destroy      (_q->pll);              // oscillator (fine)
-#if FLEXFRAMESYNC_ENABLE_EQ
-    eqlms_cccf_destroy    (_q->equalizer);        // LMS equalizer
-#endif
 
     // free main object memory
     free(_q);
@@ -282,6 +294,7 @@ int flexframesync_destroy(flexframesync _q)
 int flexframesync_print(flexframesync _q)
 {
     printf("flexframesync:\n");
+    printf("  demodulators      :   %u\n", _q->num_demods);
     return framedatastats_print(&_q->framedatastats);
 }
 
@@ -290,27 +303,83 @@ int flexframesync_reset(flexframesync _q)
 {
     // reset binary pre-demod synchronizer
     qdetector_cccf_reset(_q->detector);
+    _q->detector_idle = 0;
 
-    // reset carrier recovery objects
-    nco_crcf_reset(_q->mixer);
-    nco_crcf_reset(_q->pll);
-
-    // reset symbol timing recovery state
-    firpfb_crcf_reset(_q->mf);
-        
-    // reset state
-    _q->state           = FLEXFRAMESYNC_STATE_DETECTFRAME;
-    _q->preamble_counter= 0;
-    _q->symbol_counter  = 0;
-    
-    // reset frame statistics
-    _q->framesyncstats.evm = 0.0f;
+    // reset all demodulators
+    unsigned int i;
+    for (i=0; i<_q->num_demods; i++)
+        flexframesync_demod_reset(_q, &_q->demod[i]);
     return LIQUID_OK;
 }
 
 int flexframesync_is_frame_open(flexframesync _q)
 {
-    return (_q->state == FLEXFRAMESYNC_STATE_DETECTFRAME) ? 0 : 1;
+    return flexframesync_get_num_frames_open(_q) > 0 ? 1 : 0;
+}
+
+// get number of frames currently being demodulated
+unsigned int flexframesync_get_num_frames_open(flexframesync _q)
+{
+    unsigned int i, n = 0;
+    for (i=0; i<_q->num_demods; i++)
+        n += _q->demod[i].state == FLEXFRAMESYNC_STATE_DETECTFRAME ? 0 : 1;
+    return n;
+}
+
+// set number of demodulators available for receiving frames concurrently;
+// resets the synchronizer, dropping any frames currently being received
+int flexframesync_set_num_demods(flexframesync _q,
+                                 unsigned int  _n)
+{
+    if (_n == 0 || _n > FLEXFRAMESYNC_MAX_DEMODS)
+        return liquid_error(LIQUID_EICONFIG,"flexframesync_set_num_demods(), number of demodulators (%u) must be in [1,%u]", _n, FLEXFRAMESYNC_MAX_DEMODS);
+
+    unsigned int i;
+    for (i=_n; i<_q->num_demods; i++)
+        flexframesync_demod_free(_q, &_q->demod[i]);
+
+    _q->demod = (struct flexframesync_demod_s*) realloc(_q->demod, _n*sizeof(struct flexframesync_demod_s));
+    if (_q->demod == NULL)
+        return liquid_error(LIQUID_EIMEM,"flexframesync_set_num_demods(), could not allocate demodulators");
+
+    for (i=_q->num_demods; i<_n; i++)
+        flexframesync_demod_init(_q, &_q->demod[i]);
+    _q->num_demods = _n;
+
+    return flexframesync_reset(_q);
+}
+
+// get number of demodulators
+unsigned int flexframesync_get_num_demods(flexframesync _q)
+{
+    return _q->num_demods;
+}
+
+// enable asynchronous payload decoding
+int flexframesync_set_async_decode(flexframesync _q,
+                                   unsigned int  _queue_len,
+                                   unsigned int  _num_workers)
+{
+    // deliver outstanding frames and remove existing decoder
+    if (_q->decq != NULL) {
+        framedecq_flush(_q->decq);
+        framedecq_destroy(_q->decq);
+        _q->decq = NULL;
+    }
+
+    // queue length of zero disables asynchronous decoding
+    if (_queue_len == 0)
+        return LIQUID_OK;
+
+    _q->decq = framedecq_create(_queue_len, _num_workers,
+                                _q->callback, _q->userdata, &_q->framedatastats);
+    return _q->decq == NULL ? LIQUID_EICONFIG : LIQUID_OK;
+}
+
+// wait for asynchronously decoded payloads and deliver them
+int flexframesync_async_flush(flexframesync _q)
+{
+    return _q->decq == NULL ? LIQUID_OK : framedecq_flush(_q->decq);
 }
 
 int flexframesync_set_header_len(flexframesync _q,
@@ -318,7 +387,6 @@ int flexframesync_set_header_len(flexframesync _q,
 {
     _q->header_user_len = _len;
     _q->header_dec_len = FLEXFRAME_H_DEC + _q->header_user_len;
-    _q->header_dec     = (unsigned char *) realloc(_q->header_dec, _q->header_dec_len*sizeof(unsigned char));
     if (_q->header_decoder) {
         qpacketmodem_destroy(_q->header_decoder);
     }
@@ -338,7 +406,14 @@ int flexframesync_set_header_len(flexframesync _q,
     }
     _q->header_pilotsync = qpilotsync_create(_q->header_mod_len, 16);
     _q->header_sym_len   = qpilotsync_get_frame_len(_q->header_pilotsync);
-    _q->header_sym       = (float complex*) realloc(_q->header_sym, _q->header_sym_len*sizeof(float complex));
+
+    // re-allocate header buffers for each demodulator
+    unsigned int i;
+    for (i=0; i<_q->num_demods; i++) {
+        flexframesync_demod d = &_q->demod[i];
+        d->header_dec = (unsigned char *) realloc(d->header_dec, _q->header_dec_len*sizeof(unsigned char));
+        d->header_sym = (float complex*)  realloc(d->header_sym, _q->header_sym_len*sizeof(float complex));
+    }
     return LIQUID_OK;
 }
 
@@ -385,35 +460,30 @@ int flexframesync_execute(flexframesync   _q,
                           float complex * _x,
                           unsigned int    _n)
 {
-    unsigned int i;
+    unsigned int i, j;
     for (i=0; i<_n; i++) {
 #if DEBUG_FLEXFRAMESYNC
         // write samples to debug buffer
-        // NOTE: the debug_qdetector_flush prevents samples from being written twice
-        if (_q->debug_enabled && !_q->debug_qdetector_flush)
+        if (_q->debug_enabled)
             windowcf_push(_q->debug_x, _x[i]);
 #endif
-        switch (_q->state) {
-        case FLEXFRAMESYNC_STATE_DETECTFRAME:
-            // detect frame (look for p/n sequence)
-            flexframesync_execute_seekpn(_q, _x[i]);
-            break;
-        case FLEXFRAMESYNC_STATE_RXPREAMBLE:
-            // receive p/n sequence symbols
-            flexframesync_execute_rxpreamble(_q, _x[i]);
-            break;
-        case FLEXFRAMESYNC_STATE_RXHEADER:
-            // receive header symbols
-            flexframesync_execute_rxheader(_q, _x[i]);
-            break;
-        case FLEXFRAMESYNC_STATE_RXPAYLOAD:
-            // receive payload symbols
-            flexframesync_execute_rxpayload(_q, _x[i]);
-            break;
-        default:
-            return liquid_error(LIQUID_EINT,"flexframesync_exeucte(), unknown/unsupported internal state");
+        // push sample through demodulators holding a frame
+        for (j=0; j<_q->num_demods; j++) {
+            if (_q->demod[j].state != FLEXFRAMESYNC_STATE_DETECTFRAME)
+                flexframesync_demod_execute(_q, &_q->demod[j], _x[i]);
         }
+
+        // the detector only runs while a demodulator is available to
+        // accept a new frame, checked after the demodulators above so
+        // that one releasing its frame on this sample frees it up for
+        // the detector immediately
+        if (flexframesync_get_num_frames_open(_q) < _q->num_demods)
+            flexframesync_execute_seekpn(_q, _x[i]);
     }
+
+    // deliver frames that have finished decoding asynchronously
+    if (_q->decq != NULL)
+        framedecq_deliver(_q->decq);
     return LIQUID_OK;
 }
 
@@ -421,10 +491,135 @@ int flexframesync_execute(flexframesync   _q,
 // internal methods
 //
 
+// initialize demodulator context, allocating internal objects
+int flexframesync_demod_init(flexframesync       _q,
+                             flexframesync_demod _d)
+{
+    // create symbol timing recovery filters
+    unsigned int k = 2; // samples/symbol
+    _d->mf = firpfb_crcf_create_rnyquist(LIQUID_FIRFILT_ARKAISER, _q->npfb, k, _q->m, _q->beta);
+
+#if FLEXFRAMESYNC_ENABLE_EQ
+    // create equalizer
+    unsigned int p = 3;
+    _d->equalizer = eqlms_cccf_create_lowpass(2*k*p+1, 0.4f);
+    eqlms_cccf_set_bw(_d->equalizer, 0.05f);
+#endif
+
+    // create down-coverters for carrier phase tracking
+    _d->mixer = nco_crcf_create(LIQUID_NCO);
+    _d->pll   = nco_crcf_create(LIQUID_NCO);
+    nco_crcf_pll_set_bandwidth(_d->pll, 1e-4f); // very low bandwidth
+
+    // preamble and header buffers (header sized by flexframesync_set_header_len)
+    _d->preamble_rx = (float complex*) malloc(64*sizeof(float complex));
+    _d->header_sym  = NULL;
+    _d->header_dec  = NULL;
+    if (_q->header_decoder != NULL) {
+        _d->header_sym = (float complex*) malloc(_q->header_sym_len*sizeof(float complex));
+        _d->header_dec = (unsigned char*) malloc(_q->header_dec_len*sizeof(unsigned char));
+    }
+
+    // payload demodulator for phase recovery
+    _d->payload_demod = modemcf_create(LIQUID_MODEM_QPSK);
+
+    // create payload demodulator/decoder object
+    _d->payload_dec_len = 64;
+    int check      = LIQUID_CRC_24;
+    int fec0       = LIQUID_FEC_NONE;
+    int fec1       = LIQUID_FEC_GOLAY2412;
+    int mod_scheme = LIQUID_MODEM_BPSK;
+    _d->payload_decoder = qpacketmodem_create();
+    qpacketmodem_configure(_d->payload_decoder, _d->payload_dec_len, check, fec0, fec1, mod_scheme);
+    _d->payload_sym_len = qpacketmodem_get_frame_len(_d->payload_decoder);
+
+    // allocate memory for payload symbols and recovered data bytes
+    _d->payload_sym = (float complex*) malloc(_d->payload_sym_len*sizeof(float complex));
+    _d->payload_dec = (unsigned char*) malloc(_d->payload_dec_len*sizeof(unsigned char));
+    _d->payload_enc = (unsigned char*) malloc(_d->payload_sym_len*sizeof(unsigned char));
+
+    return flexframesync_demod_reset(_q, _d);
+}
+
+// free internal memory of demodulator context
+int flexframesync_demod_free(flexframesync       _q,
+                             flexframesync_demod _d)
+{
+    // free allocated arrays
+    free(_d->preamble_rx);
+    free(_d->header_sym);
+    free(_d->header_dec);
+    free(_d->payload_sym);
+    free(_d->payload_dec);
+    free(_d->payload_enc);
+
+    // destroy synchronization objects
+    modemcf_destroy       (_d->payload_demod);    // payload demodulator (for PLL)
+    qpacketmodem_destroy  (_d->payload_decoder);  // payload demodulator/decoder
+    firpfb_crcf_destroy   (_d->mf);               // matched filter
+    nco_crcf_destroy      (_d->mixer);            // oscillator (coarse)
+    nco_crcf_destroy      (_d->pll);              // oscillator (fine)
+#if FLEXFRAMESYNC_ENABLE_EQ
+    eqlms_cccf_destroy    (_d->equalizer);        // LMS equalizer
+#endif
+    return LIQUID_OK;
+}
+
+// reset demodulator context, returning it to the pool
+int flexframesync_demod_reset(flexframesync       _q,
+                              flexframesync_demod _d)
+{
+    // reset carrier recovery objects
+    nco_crcf_reset(_d->mixer);
+    nco_crcf_reset(_d->pll);
+
+    // reset symbol timing recovery state
+    firpfb_crcf_reset(_d->mf);
+        
+    // reset state
+    _d->state           = FLEXFRAMESYNC_STATE_DETECTFRAME;
+    _d->preamble_counter= 0;
+    _d->symbol_counter  = 0;
+    
+    // reset frame statistics
+    _d->framesyncstats.evm = 0.0f;
+
+    // if every demodulator was busy the detector has been stalled and its
+    // buffer holds stale samples; restart it now that one is available
+    if (_q->detector_idle) {
+        qdetector_cccf_reset(_q->detector);
+        _q->detector_idle = 0;
+    }
+    return LIQUID_OK;
+}
+
+// push sample through demodulator context
+int flexframesync_demod_execute(flexframesync       _q,
+                                flexframesync_demod _d,
+                                float complex       _x)
+{
+    switch (_d->state) {
+    case FLEXFRAMESYNC_STATE_DETECTFRAME:
+        // demodulator is idle
+        break;
+    case FLEXFRAMESYNC_STATE_RXPREAMBLE:
+        // receive p/n sequence symbols
+        return flexframesync_execute_rxpreamble(_q, _d, _x);
+    case FLEXFRAMESYNC_STATE_RXHEADER:
+        // receive header symbols
+        return flexframesync_execute_rxheader(_q, _d, _x);
+    case FLEXFRAMESYNC_STATE_RXPAYLOAD:
+        // receive payload symbols
+        return flexframesync_execute_rxpayload(_q, _d, _x);
+    default:
+        return liquid_error(LIQUID_EINT,"flexframesync_demod_execute(), unknown/unsupported internal state");
+    }
+    return LIQUID_OK;
+}
+
 // execute synchronizer, seeking p/n sequence
 //  _q      :   frame synchronizer object
 //  _x      :   input sample
-//  _sym    :   demodulated symbol
 int flexframesync_execute_seekpn(flexframesync _q,
                                   float complex _x)
 {
@@ -435,87 +630,105 @@ int flexframesync_execute_seekpn(flexframesync _q,
     if (v == NULL)
         return LIQUID_OK;
 
+    // with a pool of demodulators the detector keeps running while frames
+    // are held and observes their payloads and trailing edges, where the
+    // search metric alone is unreliable; verify the candidate against the
+    // level of the aligned samples before handing it to a demodulator
+    float threshold = qdetector_cccf_get_threshold(_q->detector);
+    if (_q->num_demods > 1 && qdetector_cccf_get_rxy_aligned(_q->detector) < threshold)
+        return LIQUID_OK;
+
+    // acquire available demodulator from pool
+    unsigned int i;
+    flexframesync_demod d = NULL;
+    for (i=0; i<_q->num_demods; i++) {
+        if (_q->demod[i].state == FLEXFRAMESYNC_STATE_DETECTFRAME) {
+            d = &_q->demod[i];
+            break;
+        }
+    }
+    if (d == NULL)
+        return liquid_error(LIQUID_EINT,"flexframesync_execute_seekpn(), no demodulator available");
+
     // get estimates
-    _q->tau_hat   = qdetector_cccf_get_tau  (_q->detector);
-    _q->gamma_hat = qdetector_cccf_get_gamma(_q->detector);
-    _q->dphi_hat  = qdetector_cccf_get_dphi (_q->detector);
-    _q->phi_hat   = qdetector_cccf_get_phi  (_q->detector);
+    d->tau_hat   = qdetector_cccf_get_tau  (_q->detector);
+    d->gamma_hat = qdetector_cccf_get_gamma(_q->detector);
+    d->dphi_hat  = qdetector_cccf_get_dphi (_q->detector);
+    d->phi_hat   = qdetector_cccf_get_phi  (_q->detector);
 
 #if DEBUG_FLEXFRAMESYNC_PRINT
     printf("***** frame detected! tau-hat:%8.4f, dphi-hat:%8.4f, gamma:%8.2f dB\n",
-            _q->tau_hat, _q->dphi_hat, 20*log10f(_q->gamma_hat));
+            d->tau_hat, d->dphi_hat, 20*log10f(d->gamma_hat));
 #endif
 
     // set appropriate filterbank index
-    if (_q->tau_hat > 0) {
-        _q->pfb_index = (unsigned int)(      _q->tau_hat  * _q->npfb) % _q->npfb;
-        _q->mf_counter = 0;
+    if (d->tau_hat > 0) {
+        d->pfb_index = (unsigned int)(      d->tau_hat  * _q->npfb) % _q->npfb;
+        d->mf_counter = 0;
     } else {
-        _q->pfb_index = (unsigned int)((1.0f+_q->tau_hat) * _q->npfb) % _q->npfb;
-        _q->mf_counter = 1;
+        d->pfb_index = (unsigned int)((1.0f+d->tau_hat) * _q->npfb) % _q->npfb;
+        d->mf_counter = 1;
     }
     
     // output filter scale (gain estimate, scaled by 1/2 for k=2 samples/symbol)
-    firpfb_crcf_set_scale(_q->mf, 0.5f / _q->gamma_hat);
+    firpfb_crcf_set_scale(d->mf, 0.5f / d->gamma_hat);
 
     // set frequency/phase of mixer
-    nco_crcf_set_frequency(_q->mixer, _q->dphi_hat);
-    nco_crcf_set_phase    (_q->mixer, _q->phi_hat );
+    nco_crcf_set_frequency(d->mixer, d->dphi_hat);
+    nco_crcf_set_phase    (d->mixer, d->phi_hat );
 
     // update state
-    _q->state = FLEXFRAMESYNC_STATE_RXPREAMBLE;
+    d->state = FLEXFRAMESYNC_STATE_RXPREAMBLE;
 
-#if DEBUG_FLEXFRAMESYNC
-    // the debug_qdetector_flush prevents samples from being written twice
-    _q->debug_qdetector_flush = 1;
-#endif
-    // run buffered samples through synchronizer
+    // stall detector if no more demodulators are available
+    _q->detector_idle = flexframesync_get_num_frames_open(_q) == _q->num_demods;
+
+    // run buffered samples through this demodulator only; other
+    // demodulators (and the detector) have already observed them
     unsigned int buf_len = qdetector_cccf_get_buf_len(_q->detector);
-    flexframesync_execute(_q, v, buf_len);
-#if DEBUG_FLEXFRAMESYNC
-    _q->debug_qdetector_flush = 0;
-#endif
+    for (i=0; i<buf_len && d->state != FLEXFRAMESYNC_STATE_DETECTFRAME; i++)
+        flexframesync_demod_execute(_q, d, v[i]);
     return LIQUID_OK;
 }
 
 // step receiver mixer, matched filter, decimator
-//  _q      :   frame synchronizer
+//  _d      :   demodulator context
 //  _x      :   input sample
 //  _y      :   output symbol
-int flexframesync_step(flexframesync   _q,
-                       float complex   _x,
-                       float complex * _y)
+int flexframesync_step(flexframesync_demod _d,
+                       float complex       _x,
+                       float complex *     _y)
 {
     // mix sample down
     float complex v;
-    nco_crcf_mix_down(_q->mixer, _x, &v);
-    nco_crcf_step    (_q->mixer);
+    nco_crcf_mix_down(_d->mixer, _x, &v);
+    nco_crcf_step    (_d->mixer);
     
     // push sample into filterbank
-    firpfb_crcf_push   (_q->mf, v);
-    firpfb_crcf_execute(_q->mf, _q->pfb_index, &v);
+    firpfb_crcf_push   (_d->mf, v);
+    firpfb_crcf_execute(_d->mf, _d->pfb_index, &v);
 
 #if FLEXFRAMESYNC_ENABLE_EQ
     // push sample through equalizer
-    eqlms_cccf_push(_q->equalizer, v);
+    eqlms_cccf_push(_d->equalizer, v);
 #endif
 
     // increment counter to determine if sample is available
-    _q->mf_counter++;
-    int sample_available = (_q->mf_counter >= 1) ? 1 : 0;
+    _d->mf_counter++;
+    int sample_available = (_d->mf_counter >= 1) ? 1 : 0;
     
     // set output sample if available
     if (sample_available) {
 #if FLEXFRAMESYNC_ENABLE_EQ
         // compute equalizer output
-        eqlms_cccf_execute(_q->equalizer, &v);
+        eqlms_cccf_execute(_d->equalizer, &v);
 #endif
 
         // set output
         *_y = v;
 
         // decrement counter by k=2 samples/symbol
-        _q->mf_counter -= 2;
+        _d->mf_counter -= 2;
     }
 
     // return flag
@@ -523,15 +736,16 @@ int flexframesync_step(flexframesync   _q,
 }
 
 // execute synchronizer, receiving p/n sequence
-//  _q     :   frame synchronizer object
+//  _q      :   frame synchronizer object
+//  _d      :   demodulator context
 //  _x      :   input sample
-//  _sym    :   demodulated symbol
-int flexframesync_execute_rxpreamble(flexframesync _q,
-                                     float complex _x)
+int flexframesync_execute_rxpreamble(flexframesync       _q,
+                                     flexframesync_demod _d,
+                                     float complex       _x)
 {
     // step synchronizer
     float complex mf_out = 0.0f;
-    int sample_available = flexframesync_step(_q, _x, &mf_out);
+    int sample_available = flexframesync_step(_d, _x, &mf_out);
 
     // compute output if timeout
     if (sample_available) {
@@ -542,54 +756,55 @@ int flexframesync_execute_rxpreamble(flexframesync _q,
 #else
         unsigned int delay = 2*_q->m;     // delay from matched filter
 #endif
-        if (_q->preamble_counter >= delay) {
-            unsigned int index = _q->preamble_counter-delay;
+        if (_d->preamble_counter >= delay) {
+            unsigned int index = _d->preamble_counter-delay;
 
-            _q->preamble_rx[index] = mf_out;
+            _d->preamble_rx[index] = mf_out;
         
 #if FLEXFRAMESYNC_ENABLE_EQ
             // train equalizer
-            eqlms_cccf_step(_q->equalizer, _q->preamble_pn[index], mf_out);
+            eqlms_cccf_step(_d->equalizer, _q->preamble_pn[index], mf_out);
 #endif
         }
 
         // update p/n counter
-        _q->preamble_counter++;
+        _d->preamble_counter++;
 
         // update state
-        if (_q->preamble_counter == 64 + delay)
-            _q->state = FLEXFRAMESYNC_STATE_RXHEADER;
+        if (_d->preamble_counter == 64 + delay)
+            _d->state = FLEXFRAMESYNC_STATE_RXHEADER;
     }
     return LIQUID_OK;
 }
 
 // execute synchronizer, receiving header
 //  _q      :   frame synchronizer object
+//  _d      :   demodulator context
 //  _x      :   input sample
-//  _sym    :   demodulated symbol
-int flexframesync_execute_rxheader(flexframesync _q,
-                                   float complex _x)
+int flexframesync_execute_rxheader(flexframesync       _q,
+                                   flexframesync_demod _d,
+                                   float complex       _x)
 {
     // step synchronizer
     float complex mf_out = 0.0f;
-    int sample_available = flexframesync_step(_q, _x, &mf_out);
+    int sample_available = flexframesync_step(_d, _x, &mf_out);
 
     // compute output if timeout
     if (sample_available) {
         // save payload symbols (modem input/output)
-        _q->header_sym[_q->symbol_counter] = mf_out;
+        _d->header_sym[_d->symbol_counter] = mf_out;
 
         // increment counter
-        _q->symbol_counter++;
+        _d->symbol_counter++;
 
-        if (_q->symbol_counter == _q->header_sym_len) {
+        if (_d->symbol_counter == _q->header_sym_len) {
             // decode header
-            flexframesync_decode_header(_q);
+            flexframesync_decode_header(_q, _d);
 
-            if (_q->header_valid) {
+            if (_d->header_valid) {
                 // continue on to decoding payload
-                _q->symbol_counter = 0;
-                _q->state = FLEXFRAMESYNC_STATE_RXPAYLOAD;
+                _d->symbol_counter = 0;
+                _d->state = FLEXFRAMESYNC_STATE_RXPAYLOAD;
                 return LIQUID_OK;
             }
 
@@ -599,134 +814,136 @@ int flexframesync_execute_rxheader(flexframesync _q,
             // header invalid: invoke callback
             if (_q->callback != NULL) {
                 // set framestats internals
-                _q->framesyncstats.evm           = 0.0f; //20*log10f(sqrtf(_q->framesyncstats.evm / 600));
-                _q->framesyncstats.rssi          = 20*log10f(_q->gamma_hat);
-                _q->framesyncstats.cfo           = nco_crcf_get_frequency(_q->mixer);
-                _q->framesyncstats.framesyms     = NULL;
-                _q->framesyncstats.num_framesyms = 0;
-                _q->framesyncstats.mod_scheme    = LIQUID_MODEM_UNKNOWN;
-                _q->framesyncstats.mod_bps       = 0;
-                _q->framesyncstats.check         = LIQUID_CRC_UNKNOWN;
-                _q->framesyncstats.fec0          = LIQUID_FEC_UNKNOWN;
-                _q->framesyncstats.fec1          = LIQUID_FEC_UNKNOWN;
+                _d->framesyncstats.evm           = 0.0f; //20*log10f(sqrtf(_d->framesyncstats.evm / 600));
+                _d->framesyncstats.rssi          = 20*log10f(_d->gamma_hat);
+                _d->framesyncstats.cfo           = nco_crcf_get_frequency(_d->mixer);
+                _d->framesyncstats.framesyms     = NULL;
+                _d->framesyncstats.num_framesyms = 0;
+                _d->framesyncstats.mod_scheme    = LIQUID_MODEM_UNKNOWN;
+                _d->framesyncstats.mod_bps       = 0;
+                _d->framesyncstats.check         = LIQUID_CRC_UNKNOWN;
+                _d->framesyncstats.fec0          = LIQUID_FEC_UNKNOWN;
+                _d->framesyncstats.fec1          = LIQUID_FEC_UNKNOWN;
 
                 // invoke callback method
-                _q->callback(_q->header_dec,
-                             _q->header_valid,
+                _q->callback(_d->header_dec,
+                             _d->header_valid,
                              NULL,  // payload
                              0,     // payload length
                              0,     // payload valid,
-                             _q->framesyncstats,
+                             _d->framesyncstats,
                              _q->userdata);
             }
 
-            // reset frame synchronizer
-            return flexframesync_reset(_q);
+            // release demodulator
+            return flexframesync_demod_reset(_q, _d);
         }
     }
     return LIQUID_OK;
 }
 
 // decode header
-int flexframesync_decode_header(flexframesync _q)
+int flexframesync_decode_header(flexframesync       _q,
+                                flexframesync_demod _d)
 {
     // recover data symbols from pilots
-    qpilotsync_execute(_q->header_pilotsync, _q->header_sym, _q->header_mod);
+    qpilotsync_execute(_q->header_pilotsync, _d->header_sym, _q->header_mod);
 
     // decode payload
     if (_q->header_soft) {
-        _q->header_valid = qpacketmodem_decode_soft(_q->header_decoder,
+        _d->header_valid = qpacketmodem_decode_soft(_q->header_decoder,
                                                     _q->header_mod,
-                                                    _q->header_dec);
+                                                    _d->header_dec);
     } else {
-        _q->header_valid = qpacketmodem_decode(_q->header_decoder,
+        _d->header_valid = qpacketmodem_decode(_q->header_decoder,
                                                _q->header_mod,
-                                               _q->header_dec);
+                                               _d->header_dec);
     }
 
-    if (!_q->header_valid)
+    if (!_d->header_valid)
         return LIQUID_OK;
 
     // set fine carrier frequency and phase
     float dphi_hat = qpilotsync_get_dphi(_q->header_pilotsync);
     float  phi_hat = qpilotsync_get_phi (_q->header_pilotsync);
     //printf("residual offset: dphi=%12.8f, phi=%12.8f\n", dphi_hat, phi_hat);
-    nco_crcf_set_frequency(_q->pll, dphi_hat);
-    nco_crcf_set_phase    (_q->pll, phi_hat + dphi_hat * _q->header_sym_len);
+    nco_crcf_set_frequency(_d->pll, dphi_hat);
+    nco_crcf_set_phase    (_d->pll, phi_hat + dphi_hat * _q->header_sym_len);
 
     // first several bytes of header are user-defined
     unsigned int n = _q->header_user_len;
 
     // first byte is for expansion/version validation
-    unsigned int protocol = _q->header_dec[n+0];
+    unsigned int protocol = _d->header_dec[n+0];
     if (protocol != FLEXFRAME_PROTOCOL) {
-        _q->header_valid = 0;
+        _d->header_valid = 0;
         return liquid_error(LIQUID_EICONFIG,"flexframesync_decode_header(), invalid framing protocol %u (expected %u)", protocol, FLEXFRAME_PROTOCOL);
     }
 
     // strip off payload length
-    unsigned int payload_dec_len = (_q->header_dec[n+1] << 8) | (_q->header_dec[n+2]);
-    _q->payload_dec_len = payload_dec_len;
+    unsigned int payload_dec_len = (_d->header_dec[n+1] << 8) | (_d->header_dec[n+2]);
+    _d->payload_dec_len = payload_dec_len;
 
     // strip off modulation scheme/depth
-    unsigned int mod_scheme = _q->header_dec[n+3];
+    unsigned int mod_scheme = _d->header_dec[n+3];
 
     // strip off CRC, forward error-correction schemes
     //  CRC     : most-significant 3 bits of [n+4]
     //  fec0    : least-significant 5 bits of [n+4]
     //  fec1    : least-significant 5 bits of [n+5]
-    unsigned int check = (_q->header_dec[n+4] >> 5 ) & 0x07;
-    unsigned int fec0  = (_q->header_dec[n+4]      ) & 0x1f;
-    unsigned int fec1  = (_q->header_dec[n+5]      ) & 0x1f;
+    unsigned int check = (_d->header_dec[n+4] >> 5 ) & 0x07;
+    unsigned int fec0  = (_d->header_dec[n+4]      ) & 0x1f;
+    unsigned int fec1  = (_d->header_dec[n+5]      ) & 0x1f;
 
     // validate properties
     if (mod_scheme == 0 || mod_scheme >= LIQUID_MODEM_NUM_SCHEMES) {
-        _q->header_valid = 0;
+        _d->header_valid = 0;
         return liquid_error(LIQUID_EICONFIG,"flexframesync_decode_header(), invalid modulation scheme");
     } else if (check == LIQUID_CRC_UNKNOWN || check >= LIQUID_CRC_NUM_SCHEMES) {
-        _q->header_valid = 0;
+        _d->header_valid = 0;
         return liquid_error(LIQUID_EICONFIG,"flexframesync_decode_header(), decoded CRC exceeds available");
     } else if (fec0 == LIQUID_FEC_UNKNOWN || fec0 >= LIQUID_FEC_NUM_SCHEMES) {
-        _q->header_valid = 0;
+        _d->header_valid = 0;
         return liquid_error(LIQUID_EICONFIG,"flexframesync_decode_header(), decoded FEC (inner) exceeds available");
     } else if (fec1 == LIQUID_FEC_UNKNOWN || fec1 >= LIQUID_FEC_NUM_SCHEMES) {
-        _q->header_valid = 0;
+        _d->header_valid = 0;
         return liquid_error(LIQUID_EICONFIG,"flexframesync_decode_header(), decoded FEC (outer) exceeds available");
     }
 
     // re-create payload demodulator for phase-locked loop
-    _q->payload_demod = modemcf_recreate(_q->payload_demod, mod_scheme);
+    _d->payload_demod = modemcf_recreate(_d->payload_demod, mod_scheme);
 
     // reconfigure payload demodulator/decoder
-    qpacketmodem_configure(_q->payload_decoder,
+    qpacketmodem_configure(_d->payload_decoder,
                            payload_dec_len, check, fec0, fec1, mod_scheme);
 
     // set length appropriately
-    _q->payload_sym_len = qpacketmodem_get_frame_len(_q->payload_decoder);
+    _d->payload_sym_len = qpacketmodem_get_frame_len(_d->payload_decoder);
 
     // re-allocate buffers accordingly
-    _q->payload_sym = (float complex*) realloc(_q->payload_sym, (_q->payload_sym_len)*sizeof(float complex));
-    _q->payload_dec = (unsigned char*) realloc(_q->payload_dec, (_q->payload_dec_len)*sizeof(unsigned char));
+    _d->payload_sym = (float complex*) realloc(_d->payload_sym, (_d->payload_sym_len)*sizeof(float complex));
+    _d->payload_dec = (unsigned char*) realloc(_d->payload_dec, (_d->payload_dec_len)*sizeof(unsigned char));
+    _d->payload_enc = (unsigned char*) realloc(_d->payload_enc, (_d->payload_sym_len)*modulation_types[mod_scheme].bps*sizeof(unsigned char));
 
-    if (_q->payload_sym == NULL || _q->payload_dec == NULL) {
-        _q->header_valid = 0;
+    if (_d->payload_sym == NULL || _d->payload_dec == NULL || _d->payload_enc == NULL) {
+        _d->header_valid = 0;
         return liquid_error(LIQUID_EIMEM,"flexframesync_decode_header(), could not re-allocate payload arrays");
     }
 
 #if DEBUG_FLEXFRAMESYNC_PRINT
     // print results
     printf("flexframesync_decode_header():\n");
-    printf("    header crc      : %s\n", _q->header_valid ? "pass" : "FAIL");
+    printf("    header crc      : %s\n", _d->header_valid ? "pass" : "FAIL");
     printf("    check           : %s\n", crc_scheme_str[check][1]);
     printf("    fec (inner)     : %s\n", fec_scheme_str[fec0][1]);
     printf("    fec (outer)     : %s\n", fec_scheme_str[fec1][1]);
     printf("    mod scheme      : %s\n", modulation_types[mod_scheme].name);
-    printf("    payload sym len : %u\n", _q->payload_sym_len);
-    printf("    payload dec len : %u\n", _q->payload_dec_len);
+    printf("    payload sym len : %u\n", _d->payload_sym_len);
+    printf("    payload dec len : %u\n", _d->payload_dec_len);
     printf("    user data       :");
     unsigned int i;
     for (i=0; i<_q->header_user_len; i++)
-        printf(" %.2x", _q->header_dec[i]);
+        printf(" %.2x", _d->header_dec[i]);
     printf("\n");
 #endif
     return LIQUID_OK;
@@ -735,85 +952,127 @@ int flexframesync_decode_header(flexframesync _q)
 
 // execute synchronizer, receiving payload
 //  _q      :   frame synchronizer object
+//  _d      :   demodulator context
 //  _x      :   input sample
-//  _sym    :   demodulated symbol
-int flexframesync_execute_rxpayload(flexframesync _q,
-                                    float complex _x)
+int flexframesync_execute_rxpayload(flexframesync       _q,
+                                    flexframesync_demod _d,
+                                    float complex       _x)
 {
     // step synchronizer
     float complex mf_out = 0.0f;
-    int sample_available = flexframesync_step(_q, _x, &mf_out);
+    int sample_available = flexframesync_step(_d, _x, &mf_out);
 
     // compute output if timeout
     if (sample_available) {
         // TODO: clean this up
         // mix down with fine-tuned oscillator
-        nco_crcf_mix_down(_q->pll, mf_out, &mf_out);
+        nco_crcf_mix_down(_d->pll, mf_out, &mf_out);
         // track phase, accumulate error-vector magnitude
         unsigned int sym;
-        modemcf_demodulate(_q->payload_demod, mf_out, &sym);
-        float phase_error = modemcf_get_demodulator_phase_error(_q->payload_demod);
-        float evm         = modemcf_get_demodulator_evm        (_q->payload_demod);
-        nco_crcf_pll_step(_q->pll, phase_error);
-        nco_crcf_step(_q->pll);
-        _q->framesyncstats.evm += evm*evm;
+        modemcf_demodulate(_d->payload_demod, mf_out, &sym);
+        float phase_error = modemcf_get_demodulator_phase_error(_d->payload_demod);
+        float evm         = modemcf_get_demodulator_evm        (_d->payload_demod);
+        nco_crcf_pll_step(_d->pll, phase_error);
+        nco_crcf_step(_d->pll);
+        _d->framesyncstats.evm += evm*evm;
 
         // save payload symbols (modem input/output)
-        _q->payload_sym[_q->symbol_counter] = mf_out;
+        _d->payload_sym[_d->symbol_counter] = mf_out;
 
         // increment counter
-        _q->symbol_counter++;
+        _d->symbol_counter++;
+
+        if (_d->symbol_counter == _d->payload_sym_len) {
+            // update statistics
+            _q->framedatastats.num_frames_detected++;
+            _q->framedatastats.num_headers_valid++;
+
+            // set framestats internals
+            int ms = qpacketmodem_get_modscheme(_d->payload_decoder);
+            _d->framesyncstats.evm           = 10*log10f(_d->framesyncstats.evm / (float)_d->payload_sym_len);
+            _d->framesyncstats.rssi          = 20*log10f(_d->gamma_hat);
+            _d->framesyncstats.cfo           = nco_crcf_get_frequency(_d->mixer);
+            _d->framesyncstats.framesyms     = _d->payload_sym;
+            _d->framesyncstats.num_framesyms = _d->payload_sym_len;
+            _d->framesyncstats.mod_scheme    = ms;
+            _d->framesyncstats.mod_bps       = modulation_types[ms].bps;
+            _d->framesyncstats.check         = qpacketmodem_get_crc(_d->payload_decoder);
+            _d->framesyncstats.fec0          = qpacketmodem_get_fec0(_d->payload_decoder);
+            _d->framesyncstats.fec1          = qpacketmodem_get_fec1(_d->payload_decoder);
+
+            if (_q->decq != NULL) {
+                // hand payload off to asynchronous decoder; the frame is
+                // delivered through the callback once it has been decoded
+                flexframesync_push_payload(_q, _d);
+                return flexframesync_demod_reset(_q, _d);
+            }
 
-        if (_q->symbol_counter == _q->payload_sym_len) {
             // decode payload
             if (_q->payload_soft) {
-                _q->payload_valid = qpacketmodem_decode_soft(_q->payload_decoder,
-                                                             _q->payload_sym,
-                                                             _q->payload_dec);
+                _d->payload_valid = qpacketmodem_decode_soft(_d->payload_decoder,
+                                                             _d->payload_sym,
+                                                             _d->payload_dec);
             } else {
-                _q->payload_valid = qpacketmodem_decode(_q->payload_decoder,
-                                                        _q->payload_sym,
-                                                        _q->payload_dec);
+                _d->payload_valid = qpacketmodem_decode(_d->payload_decoder,
+                                                        _d->payload_sym,
+                                                        _d->payload_dec);
             }
 
             // update statistics
-            _q->framedatastats.num_frames_detected++;
-            _q->framedatastats.num_headers_valid++;
-            _q->framedatastats.num_payloads_valid += _q->payload_valid;
-            _q->framedatastats.num_bytes_received += _q->payload_dec_len;
+            _q->framedatastats.num_payloads_valid += _d->payload_valid;
+            _q->framedatastats.num_bytes_received += _d->payload_dec_len;
 
             // invoke callback
             if (_q->callback != NULL) {
-                // set framestats internals
-                int ms = qpacketmodem_get_modscheme(_q->payload_decoder);
-                _q->framesyncstats.evm           = 10*log10f(_q->framesyncstats.evm / (float)_q->payload_sym_len);
-                _q->framesyncstats.rssi          = 20*log10f(_q->gamma_hat);
-                _q->framesyncstats.cfo           = nco_crcf_get_frequency(_q->mixer);
-                _q->framesyncstats.framesyms     = _q->payload_sym;
-                _q->framesyncstats.num_framesyms = _q->payload_sym_len;
-                _q->framesyncstats.mod_scheme    = ms;
-                _q->framesyncstats.mod_bps       = modulation_types[ms].bps;
-                _q->framesyncstats.check         = qpacketmodem_get_crc(_q->payload_decoder);
-                _q->framesyncstats.fec0          = qpacketmodem_get_fec0(_q->payload_decoder);
-                _q->framesyncstats.fec1          = qpacketmodem_get_fec1(_q->payload_decoder);
-
-                // invoke callback method
-                _q->callback(_q->header_dec,
-                             _q->header_valid,
-                             _q->payload_dec,
-                             _q->payload_dec_len,
-                             _q->payload_valid,
-                             _q->framesyncstats,
+                _q->callback(_d->header_dec,
+                             _d->header_valid,
+                             _d->payload_dec,
+                             _d->payload_dec_len,
+                             _d->payload_valid,
+                             _d->framesyncstats,
                              _q->userdata);
             }
 
-            // reset frame synchronizer
-            return flexframesync_reset(_q);
+            // release demodulator
+            return flexframesync_demod_reset(_q, _d);
         }
     }
     return LIQUID_OK;
 }
 
+// demodulate payload symbols and push onto asynchronous decoder queue
+int flexframesync_push_payload(flexframesync       _q,
+                               flexframesync_demod _d)
+{
+    int          check   = qpacketmodem_get_crc (_d->payload_decoder);
+    int          fec0    = qpacketmodem_get_fec0(_d->payload_decoder);
+    int          fec1    = qpacketmodem_get_fec1(_d->payload_decoder);
+    unsigned int bps     = modulation_types[qpacketmodem_get_modscheme(_d->payload_decoder)].bps;
+    unsigned int enc_len = packetizer_compute_enc_msg_len(_d->payload_dec_len, check, fec0, fec1);
+
+    // demodulate into soft bits or packed bytes (as required by packetizer)
+    unsigned int i;
+    unsigned int sym;
+    for (i=0; i<_d->payload_sym_len; i++) {
+        if (_q->payload_soft) {
+            modemcf_demodulate_soft(_d->payload_demod, _d->payload_sym[i], &sym, _d->payload_enc + i*bps);
+        } else {
+            modemcf_demodulate(_d->payload_demod, _d->payload_sym[i], &sym);
+            liquid_pack_array(_d->payload_enc, enc_len, i*bps, bps, sym);
+        }
+    }
+
+    return framedecq_push(_q->decq,
+                          _d->header_dec,
+                          _q->header_dec_len,
+                          _d->header_valid,
+                          _d->payload_enc,
+                          _q->payload_soft,
+                          _d->payload_dec_len,
+                          check, fec0, fec1,
+                          _d->framesyncstats);
+}
+
 // reset frame data statistics
 int flexframesync_reset_framedatastats(flexframesync _q)
 {
@@ -898,9 +1157,10 @@ int flexframesync_debug_print(flexframesync _q,
     for (i=0; i<64; i++)
         fprintf(fid,"preamble_pn(%4u) = %12.4e + 1i*%12.4e;\n", i+1, crealf(rc[i]), cimagf(rc[i]));
 
-    // write p/n symbols
+    // write p/n symbols (first demodulator)
+    flexframesync_demod d = &_q->demod[0];
     fprintf(fid,"preamble_rx = zeros(1,64);\n");
-    rc = _q->preamble_rx;
+    rc = d->preamble_rx;
     for (i=0; i<64; i++)
         fprintf(fid,"preamble_rx(%4u) = %12.4e + 1i*%12.4e;\n", i+1, crealf(rc[i]), cimagf(rc[i]));
 
@@ -911,9 +1171,9 @@ int flexframesync_debug_print(flexframesync _q,
         fprintf(fid,"header_mod(%4u) = %12.4e + j*%12.4e;\n", i+1, crealf(rc[i]), cimagf(rc[i]));
 
     // write raw payload symbols
-    fprintf(fid,"payload_sym = zeros(1,%u);\n", _q->payload_sym_len);
-    rc = _q->payload_sym;
-    for (i=0; i<_q->payload_sym_len; i++)
+    fprintf(fid,"payload_sym = zeros(1,%u);\n", d->payload_sym_len);
+    rc = d->payload_sym;
+    for (i=0; i<d->payload_sym_len; i++)
         fprintf(fid,"payload_sym(%4u) = %12.4e + j*%12.4e;\n", i+1, crealf(rc[i]), cimagf(rc[i]));
 
     fprintf(fid,"subplot(3,2,[3 5]);\n");
@@ -0,0 +1,420 @@
+/*
+ * Copyright (c) 2007 - 2022 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// framedecq.c
+//
+// Payload decoder queue: moves packetizer decoding of received frames off
+// the sample-processing path onto a pool of worker threads.
+//
+// Jobs live in a ring whose slots are handed between the producer (frame
+// synchronizer) and workers through atomic sequence counters: the producer
+// fills slot 'head' and advances it, workers claim slots by advancing
+// 'claim', and the producer delivers slot 'tail' once its state is DONE.
+// The mutex and condition variables are only used to put idle threads to
+// sleep; they never guard the slots themselves.
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <complex.h>
+
+#include "liquid.internal.h"
+
+#if LIQUID_THREADS_ENABLED
+#  include <pthread.h>
+#  include <stdatomic.h>
+typedef atomic_uint framedecq_counter;
+#  define FRAMEDECQ_LOAD(x)     atomic_load_explicit(&(x), memory_order_acquire)
+#  define FRAMEDECQ_STORE(x,v)  atomic_store_explicit(&(x), (v), memory_order_release)
+#else
+typedef unsigned int framedecq_counter;
+#  define FRAMEDECQ_LOAD(x)     (x)
+#  define FRAMEDECQ_STORE(x,v)  ((x) = (v))
+#endif
+
+// job states
+#define FRAMEDECQ_JOB_FREE      (0)
+#define FRAMEDECQ_JOB_QUEUED    (1)
+#define FRAMEDECQ_JOB_DONE      (2)
+
+// single payload decoding job
+struct framedecq_job_s {
+    framedecq_counter   state;          // job state (free, queued, done)
+
+    // header
+    unsigned char *     header;         // decoded header
+    unsigned int        header_len;     // decoded header length
+    int                 header_valid;   // header valid flag
+
+    // payload
+    unsigned char *     payload_enc;    // encoded payload (bytes or soft bits)
+    unsigned int        enc_len;        // encoded payload length
+    int                 soft;           // soft-decision decoding flag
+    unsigned int        payload_len;    // decoded payload length
+    crc_scheme          check;          // payload validity check
+    fec_scheme          fec0;           // payload inner FEC scheme
+    fec_scheme          fec1;           // payload outer FEC scheme
+    unsigned char *     payload_dec;    // decoded payload
+    int                 payload_valid;  // payload valid flag
+
+    // statistics
+    framesyncstats_s    stats;          // frame statistics
+    float complex *     framesyms;      // copy of frame symbols
+    unsigned int        framesyms_cap;  // allocated length of frame symbols
+
+    unsigned int        header_cap;     // allocated length of header
+    unsigned int        enc_cap;        // allocated length of encoded payload
+    unsigned int        dec_cap;        // allocated length of decoded payload
+};
+
+// decoder worker
+struct framedecq_worker_s {
+    framedecq           q;              // parent queue
+    packetizer          p;              // payload decoder
+#if LIQUID_THREADS_ENABLED
+    pthread_t           thread;         // worker thread
+#endif
+};
+
+struct framedecq_s {
+    struct framedecq_job_s * jobs;      // job ring
+    unsigned int        ring_len;       // ring length (power of 2)
+    unsigned int        queue_len;      // maximum number of outstanding jobs
+    framedecq_counter   head;           // next job to fill (producer)
+    framedecq_counter   claim;          // next job to decode (workers)
+    unsigned int        tail;           // next job to deliver (producer)
+
+    framesync_callback  callback;       // user-defined callback
+    void *              userdata;       // user-defined data
+    framedatastats_s *  stats;          // frame data statistics (optional)
+
+    // decoders
+    unsigned int        num_workers;    // number of worker threads
+    struct framedecq_worker_s * workers;// worker objects
+    packetizer          p;              // decoder for synchronous operation
+#if LIQUID_THREADS_ENABLED
+    pthread_mutex_t     lock;           // sleep/wake-up lock
+    pthread_cond_t      cv_job;         // signaled when a job is queued
+    pthread_cond_t      cv_done;        // signaled when a job is complete
+    int                 shutdown;       // workers should exit
+#endif
+};
+
+// decode a single job using the given packetizer
+static packetizer framedecq_decode(packetizer               _p,
+                                   struct framedecq_job_s * _job)
+{
+    _p = packetizer_recreate(_p, _job->payload_len, _job->check, _job->fec0, _job->fec1);
+    if (_job->soft)
+        _job->payload_valid = packetizer_decode_soft(_p, _job->payload_enc, _job->payload_dec);
+    else
+        _job->payload_valid = packetizer_decode(_p, _job->payload_enc, _job->payload_dec);
+    return _p;
+}
+
+#if LIQUID_THREADS_ENABLED
+// worker thread: claim queued jobs in order and decode them
+static void * framedecq_worker(void * _arg)
+{
+    struct framedecq_worker_s * w = (struct framedecq_worker_s *) _arg;
+    framedecq q = w->q;
+    while (1) {
+        unsigned int c = FRAMEDECQ_LOAD(q->claim);
+        if (c == FRAMEDECQ_LOAD(q->head)) {
+            // nothing to do; sleep until a job is queued
+            pthread_mutex_lock(&q->lock);
+            while (!q->shutdown && FRAMEDECQ_LOAD(q->claim) == FRAMEDECQ_LOAD(q->head))
+                pthread_cond_wait(&q->cv_job, &q->lock);
+            int shutdown = q->shutdown;
+            pthread_mutex_unlock(&q->lock);
+            if (shutdown)
+                break;
+            continue;
+        }
+
+        // try to claim job
+        if (!atomic_compare_exchange_weak(&q->claim, &c, c+1))
+            continue;
+
+        // decode and publish result
+        struct framedecq_job_s * job = &q->jobs[c & (q->ring_len-1)];
+        w->p = framedecq_decode(w->p, job);
+        FRAMEDECQ_STORE(job->state, FRAMEDECQ_JOB_DONE);
+
+        // wake producer if it is waiting on this job
+        pthread_mutex_lock(&q->lock);
+        pthread_cond_broadcast(&q->cv_done);
+        pthread_mutex_unlock(&q->lock);
+    }
+    return NULL;
+}
+#endif
+
+// create payload decoder queue
+framedecq framedecq_create(unsigned int       _queue_len,
+                           unsigned int       _num_workers,
+                           framesync_callback _callback,
+                           void *             _userdata,
+                           framedatastats_s * _stats)
+{
+    if (_queue_len == 0)
+        return liquid_error_config("framedecq_create(), queue length must be greater than zero");
+#if !LIQUID_THREADS_ENABLED
+    // decode synchronously without thread support
+    _num_workers = 0;
+#endif
+
+    framedecq q = (framedecq) malloc(sizeof(struct framedecq_s));
+    q->queue_len   = _queue_len;
+    q->num_workers = _num_workers;
+    q->callback    = _callback;
+    q->userdata    = _userdata;
+    q->stats       = _stats;
+
+    // allocate job ring (rounded up to power of 2 for index masking)
+    q->ring_len = 1;
+    while (q->ring_len < q->queue_len)
+        q->ring_len <<= 1;
+    q->jobs = (struct framedecq_job_s *) calloc(q->ring_len, sizeof(struct framedecq_job_s));
+    unsigned int i;
+    for (i=0; i<q->ring_len; i++)
+        FRAMEDECQ_STORE(q->jobs[i].state, FRAMEDECQ_JOB_FREE);
+    FRAMEDECQ_STORE(q->head,  0);
+    FRAMEDECQ_STORE(q->claim, 0);
+    q->tail = 0;
+
+    // synchronous decoder
+    q->p = packetizer_create(1, LIQUID_CRC_NONE, LIQUID_FEC_NONE, LIQUID_FEC_NONE);
+
+    // start workers
+    q->workers = NULL;
+#if LIQUID_THREADS_ENABLED
+    q->shutdown = 0;
+    pthread_mutex_init(&q->lock,    NULL);
+    pthread_cond_init (&q->cv_job,  NULL);
+    pthread_cond_init (&q->cv_done, NULL);
+    if (q->num_workers > 0)
+        q->workers = (struct framedecq_worker_s *) malloc(q->num_workers*sizeof(struct framedecq_worker_s));
+    for (i=0; i<q->num_workers; i++) {
+        q->workers[i].q = q;
+        q->workers[i].p = packetizer_create(1, LIQUID_CRC_NONE, LIQUID_FEC_NONE, LIQUID_FEC_NONE);
+        if (pthread_create(&q->workers[i].thread, NULL, framedecq_worker, &q->workers[i]) != 0) {
+            packetizer_destroy(q->workers[i].p);
+            q->num_workers = i;
+            liquid_error(LIQUID_EINT,"framedecq_create(), could not start worker thread (running %u)", i);
+            break;
+        }
+    }
+#endif
+    return q;
+}
+
+// destroy queue, discarding any payloads that have not been delivered
+int framedecq_destroy(framedecq _q)
+{
+    unsigned int i;
+#if LIQUID_THREADS_ENABLED
+    // stop workers
+    pthread_mutex_lock(&_q->lock);
+    _q->shutdown = 1;
+    pthread_cond_broadcast(&_q->cv_job);
+    pthread_mutex_unlock(&_q->lock);
+    for (i=0; i<_q->num_workers; i++) {
+        pthread_join(_q->workers[i].thread, NULL);
+        packetizer_destroy(_q->workers[i].p);
+    }
+    pthread_cond_destroy (&_q->cv_done);
+    pthread_cond_destroy (&_q->cv_job);
+    pthread_mutex_destroy(&_q->lock);
+#endif
+    free(_q->workers);
+
+    // free jobs
+    for (i=0; i<_q->ring_len; i++) {
+        free(_q->jobs[i].header);
+        free(_q->jobs[i].payload_enc);
+        free(_q->jobs[i].payload_dec);
+        free(_q->jobs[i].framesyms);
+    }
+    free(_q->jobs);
+    packetizer_destroy(_q->p);
+    free(_q);
+    return LIQUID_OK;
+}
+
+// get number of payloads pushed but not yet delivered
+unsigned int framedecq_get_num_pending(framedecq _q)
+{
+    return FRAMEDECQ_LOAD(_q->head) - _q->tail;
+}
+
+// wait for job at tail of queue to complete
+static int framedecq_wait(framedecq _q)
+{
+    struct framedecq_job_s * job = &_q->jobs[_q->tail & (_q->ring_len-1)];
+#if LIQUID_THREADS_ENABLED
+    if (FRAMEDECQ_LOAD(job->state) != FRAMEDECQ_JOB_DONE) {
+        pthread_mutex_lock(&_q->lock);
+        while (FRAMEDECQ_LOAD(job->state) != FRAMEDECQ_JOB_DONE)
+            pthread_cond_wait(&_q->cv_done, &_q->lock);
+        pthread_mutex_unlock(&_q->lock);
+    }
+#endif
+    return FRAMEDECQ_LOAD(job->state) == FRAMEDECQ_JOB_DONE ? LIQUID_OK : LIQUID_EINT;
+}
+
+// push encoded payload onto queue
+int framedecq_push(framedecq        _q,
+                   unsigned char *  _header,
+                   unsigned int     _header_len,
+                   int              _header_valid,
+                   unsigned char *  _payload_enc,
+                   int              _soft,
+                   unsigned int     _payload_len,
+                   crc_scheme       _check,
+                   fec_scheme       _fec0,
+                   fec_scheme       _fec1,
+                   framesyncstats_s _stats)
+{
+    // deliver anything that is ready, then wait for space if necessary
+    framedecq_deliver(_q);
+    while (framedecq_get_num_pending(_q) >= _q->queue_len) {
+        if (framedecq_wait(_q) != LIQUID_OK)
+            return liquid_error(LIQUID_EINT,"framedecq_push(), queue stalled");
+        framedecq_deliver(_q);
+    }
+
+    // slot is free and owned by the producer
+    unsigned int head = FRAMEDECQ_LOAD(_q->head);
+    struct framedecq_job_s * job = &_q->jobs[head & (_q->ring_len-1)];
+
+    // copy header
+    if (job->header_cap < _header_len) {
+        job->header     = (unsigned char*) realloc(job->header, _header_len*sizeof(unsigned char));
+        job->header_cap = _header_len;
+    }
+    if (_header_len > 0)
+        memmove(job->header, _header, _header_len*sizeof(unsigned char));
+    job->header_len   = _header_len;
+    job->header_valid = _header_valid;
+
+    // copy encoded payload
+    unsigned int enc_len = packetizer_compute_enc_msg_len(_payload_len, _check, _fec0, _fec1);
+    if (_soft)
+        enc_len *= 8;
+    if (job->enc_cap < enc_len) {
+        job->payload_enc = (unsigned char*) realloc(job->payload_enc, enc_len*sizeof(unsigned char));
+        job->enc_cap     = enc_len;
+    }
+    memmove(job->payload_enc, _payload_enc, enc_len*sizeof(unsigned char));
+    if (job->dec_cap < _payload_len || job->payload_dec == NULL) {
+        job->payload_dec = (unsigned char*) realloc(job->payload_dec, (_payload_len ? _payload_len : 1)*sizeof(unsigned char));
+        job->dec_cap     = _payload_len;
+    }
+    job->enc_len     = enc_len;
+    job->soft        = _soft;
+    job->payload_len = _payload_len;
+    job->check       = _check;
+    job->fec0        = _fec0;
+    job->fec1        = _fec1;
+
+    // copy statistics and frame symbols
+    job->stats = _stats;
+    if (_stats.framesyms != NULL && _stats.num_framesyms > 0) {
+        if (job->framesyms_cap < _stats.num_framesyms) {
+            job->framesyms     = (float complex*) realloc(job->framesyms, _stats.num_framesyms*sizeof(float complex));
+            job->framesyms_cap = _stats.num_framesyms;
+        }
+        memmove(job->framesyms, _stats.framesyms, _stats.num_framesyms*sizeof(float complex));
+        job->stats.framesyms = job->framesyms;
+    } else {
+        job->stats.framesyms     = NULL;
+        job->stats.num_framesyms = 0;
+    }
+
+    if (_q->num_workers == 0) {
+        // decode synchronously and deliver immediately
+        _q->p = framedecq_decode(_q->p, job);
+        FRAMEDECQ_STORE(job->state, FRAMEDECQ_JOB_DONE);
+        FRAMEDECQ_STORE(_q->head, head+1);
+        framedecq_deliver(_q);
+        return LIQUID_OK;
+    }
+
+#if LIQUID_THREADS_ENABLED
+    // publish job and wake a worker
+    FRAMEDECQ_STORE(job->state, FRAMEDECQ_JOB_QUEUED);
+    FRAMEDECQ_STORE(_q->head, head+1);
+    pthread_mutex_lock(&_q->lock);
+    pthread_cond_signal(&_q->cv_job);
+    pthread_mutex_unlock(&_q->lock);
+#endif
+    return LIQUID_OK;
+}
+
+// invoke callback for decoded payloads at the head of the queue
+unsigned int framedecq_deliver(framedecq _q)
+{
+    unsigned int num_delivered = 0;
+    while (_q->tail != FRAMEDECQ_LOAD(_q->head)) {
+        struct framedecq_job_s * job = &_q->jobs[_q->tail & (_q->ring_len-1)];
+        if (FRAMEDECQ_LOAD(job->state) != FRAMEDECQ_JOB_DONE)
+            break;
+
+        // update statistics
+        if (_q->stats != NULL) {
+            _q->stats->num_payloads_valid += job->payload_valid;
+            _q->stats->num_bytes_received += job->payload_len;
+        }
+
+        // invoke callback
+        if (_q->callback != NULL) {
+            _q->callback(job->header,
+                         job->header_valid,
+                         job->payload_dec,
+                         job->payload_len,
+                         job->payload_valid,
+                         job->stats,
+                         _q->userdata);
+        }
+
+        // release slot
+        FRAMEDECQ_STORE(job->state, FRAMEDECQ_JOB_FREE);
+        _q->tail++;
+        num_delivered++;
+    }
+    return num_delivered;
+}
+
+// wait for all outstanding payloads to be decoded and delivered
+int framedecq_flush(framedecq _q)
+{
+    while (framedecq_get_num_pending(_q) > 0) {
+        if (framedecq_wait(_q) != LIQUID_OK)
+            return liquid_error(LIQUID_EINT,"framedecq_flush(), queue stalled");
+        framedecq_deliver(_q);
+    }
+    return LIQUID_OK;
+}
+
@@ -42,73 +42,106 @@
 
 #define FRAMESYNC64_ENABLE_EQ       0
 
+// maximum number of concurrent demodulators
+#define FRAMESYNC64_MAX_DEMODS      (64)
+
+// demodulator context: per-frame receiver state, allocated from the pool
+// held by the main object so that several frames can be received at once
+struct framesync64_demod_s {
+    // synchronizer objects
+    float               tau_hat;    // fractional timing offset estimate
+    float               dphi_hat;   // carrier frequency offset estimate
+    float               phi_hat;    // carrier phase offset estimate
+    float               gamma_hat;  // channel gain estimate
+    nco_crcf            mixer;      // coarse carrier frequency recovery
+
+    // timing recovery objects, states
+    firpfb_crcf         mf;         // matched filter decimator
+    int                 mf_counter; // matched filter output timer
+    unsigned int        pfb_index;  // filterbank index
+#if FRAMESYNC64_ENABLE_EQ
+    eqlms_cccf          equalizer;  // equalizer (trained on p/n sequence)
+#endif
+
+    // preamble
+    float complex preamble_rx[64];  // received p/n symbols
+
+    // payload
+    float complex payload_rx [630]; // received payload symbols with pilots
+    float complex payload_sym[600]; // received payload symbols
+    unsigned char payload_dec[ 72]; // decoded payload bytes
+    int           payload_valid;    // did payload pass crc?
+
+    framesyncstats_s framesyncstats; // frame statistic object (synchronizer)
+
+    // status variables
+    enum {
+        FRAMESYNC64_STATE_DETECTFRAME=0,    // idle: waiting for detector
+        FRAMESYNC64_STATE_RXPREAMBLE,       // receive p/n sequence
+        FRAMESYNC64_STATE_RXPAYLOAD,        // receive payload data
+    }            state;
+    unsigned int preamble_counter;  // counter: num of p/n syms received
+    unsigned int payload_counter;   // counter: num of payload syms received
+};
+
+typedef struct framesync64_demod_s * framesync64_demod;
+
 // push samples through detection stage
 int framesync64_execute_seekpn(framesync64   _q,
                                float complex _x);
 
+// create/destroy/reset demodulator context
+int framesync64_demod_init (framesync64 _q, framesync64_demod _d);
+int framesync64_demod_free (framesync64 _q, framesync64_demod _d);
+int framesync64_demod_reset(framesync64 _q, framesync64_demod _d);
+
+// push sample through demodulator context
+int framesync64_demod_execute(framesync64       _q,
+                              framesync64_demod _d,
+                              float complex     _x);
+
 // step receiver mixer, matched filter, decimator
-//  _q      :   frame synchronizer
+//  _d      :   demodulator context
 //  _x      :   input sample
 //  _y      :   output symbol
-int framesync64_step(framesync64     _q,
-                     float complex   _x,
-                     float complex * _y);
+int framesync64_step(framesync64_demod _d,
+                     float complex     _x,
+                     float complex *   _y);
 
 // push samples through synchronizer, saving received p/n symbols
-int framesync64_execute_rxpreamble(framesync64   _q,
-                                   float complex _x);
+int framesync64_execute_rxpreamble(framesync64       _q,
+                                   framesync64_demod _d,
+                                   float complex     _x);
 
 // receive payload symbols
-int framesync64_execute_rxpayload(framesync64   _q,
-                                  float complex _x);
+int framesync64_execute_rxpayload(framesync64       _q,
+                                  framesync64_demod _d,
+                                  float complex     _x);
 
 // framesync64 object structure
 struct framesync64_s {
     // callback
     framesync_callback  callback;   // user-defined callback function
     void *              userdata;   // user-defined data structure
-    framesyncstats_s    framesyncstats; // frame statistic object (synchronizer)
     framedatastats_s    framedatastats; // frame statistic object (packet statistics)
     
     // synchronizer objects
     unsigned int        m;          // filter delay (symbols)
     float               beta;       // filter excess bandwidth factor
     qdetector_cccf      detector;   // pre-demod detector
-    float               tau_hat;    // fractional timing offset estimate
-    float               dphi_hat;   // carrier frequency offset estimate
-    float               phi_hat;    // carrier phase offset estimate
-    float               gamma_hat;  // channel gain estimate
-    nco_crcf            mixer;      // coarse carrier frequency recovery
-
-    // timing recovery objects, states
-    firpfb_crcf         mf;         // matched filter decimator
+    int                 detector_idle; // detector stalled (all demods busy)
     unsigned int        npfb;       // number of filters in symsync
-    int                 mf_counter; // matched filter output timer
-    unsigned int        pfb_index;  // filterbank index
-#if FRAMESYNC64_ENABLE_EQ
-    eqlms_cccf          equalizer;  // equalizer (trained on p/n sequence)
-#endif
 
     // preamble
     float complex preamble_pn[64];  // known 64-symbol p/n sequence
-    float complex preamble_rx[64];  // received p/n symbols
     
-    // payload decoder
-    float complex payload_rx [630]; // received payload symbols with pilots
-    float complex payload_sym[600]; // received payload symbols
-    unsigned char payload_dec[ 72]; // decoded payload bytes
+    // payload decoder (shared among demodulators)
     qpacketmodem  dec;              // packet demodulator/decoder
     qpilotsync    pilotsync;        // pilot extraction, carrier recovery
-    int           payload_valid;    // did payload pass crc?
-    
-    // status variables
-    enum {
-        FRAMESYNC64_STATE_DETECTFRAME=0,    // detect frame (seek p/n sequence)
-        FRAMESYNC64_STATE_RXPREAMBLE,       // receive p/n sequence
-        FRAMESYNC64_STATE_RXPAYLOAD,        // receive payload data
-    }            state;
-    unsigned int preamble_counter;  // counter: num of p/n syms received
-    unsigned int payload_counter;   // counter: num of payload syms received
+
+    // pool of demodulators
+    struct framesync64_demod_s * demod; // demodulator contexts
+    unsigned int        num_demods; // number of demodulator contexts
 
 #if DEBUG_FRAMESYNC64
     int debug_enabled;              // debugging enabled?
@@ -144,20 +177,9 @@ framesync64 framesync64_create(framesync_callback _callback,
     q->detector = qdetector_cccf_create_linear(q->preamble_pn, 64, LIQUID_FIRFILT_ARKAISER, k, q->m, q->beta);
     qdetector_cccf_set_threshold(q->detector, 0.5f);
 
-    // create symbol timing recovery filters
-    q->npfb = 32;   // number of filters in the bank
-    q->mf   = firpfb_crcf_create_rnyquist(LIQUID_FIRFILT_ARKAISER, q->npfb,k,q->m,q->beta);
-
-#if FRAMESYNC64_ENABLE_EQ
-    // create equalizer
-    unsigned int p = 3;
-    q->equalizer = eqlms_cccf_create_lowpass(2*k*p+1, 0.4f);
-    eqlms_cccf_set_bw(q->equalizer, 0.05f);
-#endif
+    // number of filters in symbol timing recovery filterbank
+    q->npfb = 32;
 
-    // create down-coverters for carrier phase tracking
-    q->mixer = nco_crcf_create(LIQUID_NCO);
-    
     // create payload demodulator/decoder object
     int check      = LIQUID_CRC_24;
     int fec0       = LIQUID_FEC_NONE;
@@ -172,6 +194,12 @@ framesync64 framesync64_create(framesync_callback _callback,
     q->pilotsync   = qpilotsync_create(600, 21);
     assert( qpilotsync_get_frame_len(q->pilotsync)==630);
  
+    // create pool with a single demodulator (frames received serially)
+    q->detector_idle = 0;
+    q->num_demods = 1;
+    q->demod = (struct framesync64_demod_s*) malloc(q->num_demods*sizeof(struct framesync64_demod_s));
+    framesync64_demod_init(q, &q->demod[0]);
+
     // reset global data counters
     framesync64_reset_framedatastats(q);
 
@@ -197,15 +225,16 @@ int framesync64_destroy(framesync64 _q)
     }
 #endif
 
+    // destroy demodulator contexts
+    unsigned int i;
+    for (i=0; i<_q->num_demods; i++)
+        framesync64_demod_free(_q, &_q->demod[i]);
+    free(_q->demod);
+
     // destroy synchronization objects
     qdetector_cccf_destroy(_q->detector);   // frame detector
-    firpfb_crcf_destroy   (_q->mf);         // matched filter
-    nco_crcf_destroy      (_q->mixer);      // coarse NCO
     qpacketmodem_destroy  (_q->dec);        // payload demodulator
     qpilotsync_destroy    (_q->pilotsync);  // pilot synchronizer
-#if FRAMESYNC64_ENABLE_EQ
-    eqlms_cccf_destroy    (_q->equalizer);  // LMS equalizer
-#endif
 
     // free main object memory
     free(_q);
@@ -216,6 +245,7 @@ int framesync64_destroy(framesync64 _q)
 int framesync64_print(framesync64 _q)
 {
     printf("framesync64:\n");
+    printf("  demodulators      :   %u\n", _q->num_demods);
     return framedatastats_print(&_q->framedatastats);
 }
 
@@ -224,23 +254,53 @@ int framesync64_reset(framesync64 _q)
 {
     // reset binary pre-demod synchronizer
     qdetector_cccf_reset(_q->detector);
+    _q->detector_idle = 0;
 
-    // reset carrier recovery objects
-    nco_crcf_reset(_q->mixer);
-
-    // reset symbol timing recovery state
-    firpfb_crcf_reset(_q->mf);
-        
-    // reset state
-    _q->state           = FRAMESYNC64_STATE_DETECTFRAME;
-    _q->preamble_counter= 0;
-    _q->payload_counter = 0;
-    
-    // reset frame statistics
-    _q->framesyncstats.evm = 0.0f;
+    // reset all demodulators
+    unsigned int i;
+    for (i=0; i<_q->num_demods; i++)
+        framesync64_demod_reset(_q, &_q->demod[i]);
     return LIQUID_OK;
 }
 
+// get number of frames currently being demodulated
+unsigned int framesync64_get_num_frames_open(framesync64 _q)
+{
+    unsigned int i, n = 0;
+    for (i=0; i<_q->num_demods; i++)
+        n += _q->demod[i].state == FRAMESYNC64_STATE_DETECTFRAME ? 0 : 1;
+    return n;
+}
+
+// set number of demodulators available for receiving frames concurrently;
+// resets the synchronizer, dropping any frames currently being received
+int framesync64_set_num_demods(framesync64  _q,
+                               unsigned int _n)
+{
+    if (_n == 0 || _n > FRAMESYNC64_MAX_DEMODS)
+        return liquid_error(LIQUID_EICONFIG,"framesync64_set_num_demods(), number of demodulators (%u) must be in [1,%u]", _n, FRAMESYNC64_MAX_DEMODS);
+
+    unsigned int i;
+    for (i=_n; i<_q->num_demods; i++)
+        framesync64_demod_free(_q, &_q->demod[i]);
+
+    _q->demod = (struct framesync64_demod_s*) realloc(_q->demod, _n*sizeof(struct framesync64_demod_s));
+    if (_q->demod == NULL)
+        return liquid_error(LIQUID_EIMEM,"framesync64_set_num_demods(), could not allocate demodulators");
+
+    for (i=_q->num_demods; i<_n; i++)
+        framesync64_demod_init(_q, &_q->demod[i]);
+    _q->num_demods = _n;
+
+    return framesync64_reset(_q);
+}
+
+// get number of demodulators
+unsigned int framesync64_get_num_demods(framesync64 _q)
+{
+    return _q->num_demods;
+}
+
 // execute frame synchronizer
 //  _q     :   frame synchronizer object
 //  _x      :   input sample array [size: _n x 1]
@@ -249,28 +309,21 @@ int framesync64_execute(framesync64     _q,
                         float complex * _x,
                         unsigned int    _n)
 {
-    unsigned int i;
+    unsigned int i, j;
     for (i=0; i<_n; i++) {
 #if DEBUG_FRAMESYNC64
         if (_q->debug_enabled)
             windowcf_push(_q->debug_x, _x[i]);
 #endif
-        switch (_q->state) {
-        case FRAMESYNC64_STATE_DETECTFRAME:
-            // detect frame (look for p/n sequence)
-            framesync64_execute_seekpn(_q, _x[i]);
-            break;
-        case FRAMESYNC64_STATE_RXPREAMBLE:
-            // receive p/n sequence symbols
-            framesync64_execute_rxpreamble(_q, _x[i]);
-            break;
-        case FRAMESYNC64_STATE_RXPAYLOAD:
-            // receive payload symbols
-            framesync64_execute_rxpayload(_q, _x[i]);
-            break;
-        default:
-            return liquid_error(LIQUID_EINT,"framesync64_exeucte(), unknown/unsupported state");
+        // push sample through demodulators holding a frame
+        for (j=0; j<_q->num_demods; j++) {
+            if (_q->demod[j].state != FRAMESYNC64_STATE_DETECTFRAME)
+                framesync64_demod_execute(_q, &_q->demod[j], _x[i]);
         }
+
+        // detect frame (look for p/n sequence) while a demodulator is free
+        if (framesync64_get_num_frames_open(_q) < _q->num_demods)
+            framesync64_execute_seekpn(_q, _x[i]);
     }
     return LIQUID_OK;
 }
@@ -279,10 +332,89 @@ int framesync64_execute(framesync64     _q,
 // internal methods
 //
 
+// initialize demodulator context, allocating internal objects
+int framesync64_demod_init(framesync64       _q,
+                           framesync64_demod _d)
+{
+    // create symbol timing recovery filters
+    unsigned int k = 2; // samples/symbol
+    _d->mf = firpfb_crcf_create_rnyquist(LIQUID_FIRFILT_ARKAISER, _q->npfb, k, _q->m, _q->beta);
+
+#if FRAMESYNC64_ENABLE_EQ
+    // create equalizer
+    unsigned int p = 3;
+    _d->equalizer = eqlms_cccf_create_lowpass(2*k*p+1, 0.4f);
+    eqlms_cccf_set_bw(_d->equalizer, 0.05f);
+#endif
+
+    // create down-coverters for carrier phase tracking
+    _d->mixer = nco_crcf_create(LIQUID_NCO);
+    return framesync64_demod_reset(_q, _d);
+}
+
+// free internal memory of demodulator context
+int framesync64_demod_free(framesync64       _q,
+                           framesync64_demod _d)
+{
+    firpfb_crcf_destroy   (_d->mf);         // matched filter
+    nco_crcf_destroy      (_d->mixer);      // coarse NCO
+#if FRAMESYNC64_ENABLE_EQ
+    eqlms_cccf_destroy    (_d->equalizer);  // LMS equalizer
+#endif
+    return LIQUID_OK;
+}
+
+// reset demodulator context, returning it to the pool
+int framesync64_demod_reset(framesync64       _q,
+                            framesync64_demod _d)
+{
+    // reset carrier recovery objects
+    nco_crcf_reset(_d->mixer);
+
+    // reset symbol timing recovery state
+    firpfb_crcf_reset(_d->mf);
+        
+    // reset state
+    _d->state           = FRAMESYNC64_STATE_DETECTFRAME;
+    _d->preamble_counter= 0;
+    _d->payload_counter = 0;
+    
+    // reset frame statistics
+    _d->framesyncstats.evm = 0.0f;
+
+    // if every demodulator was busy the detector has been stalled and its
+    // buffer holds stale samples; restart it now that one is available
+    if (_q->detector_idle) {
+        qdetector_cccf_reset(_q->detector);
+        _q->detector_idle = 0;
+    }
+    return LIQUID_OK;
+}
+
+// push sample through demodulator context
+int framesync64_demod_execute(framesync64       _q,
+                              framesync64_demod _d,
+                              float complex     _x)
+{
+    switch (_d->state) {
+    case FRAMESYNC64_STATE_DETECTFRAME:
+        // demodulator is idle
+        break;
+    case FRAMESYNC64_STATE_RXPREAMBLE:
+        // receive p/n sequence symbols
+        return framesync64_execute_rxpreamble(_q, _d, _x);
+    case FRAMESYNC64_STATE_RXPAYLOAD:
+        // receive payload symbols
+        return framesync64_execute_rxpayload(_q, _d, _x);
+    default:
+        return liquid_error(LIQUID_EINT,"framesync64_demod_execute(), unknown/unsupported state");
+    }
+    return LIQUID_OK;
+}
+
 // execute synchronizer, seeking p/n sequence
 //  _q     :   frame synchronizer object
 //  _x      :   input sample
-//  _sym    :   demodulated symbol
 int framesync64_execute_seekpn(framesync64   _q,
                                 float complex _x)
 {
@@ -290,82 +422,106 @@ int framesync64_execute_seekpn(framesync64   _q,
     float complex * v = qdetector_cccf_execute(_q->detector, _x);
 
     // check if frame has been detected
-    if (v != NULL) {
-        // get estimates
-        _q->tau_hat   = qdetector_cccf_get_tau  (_q->detector);
-        _q->gamma_hat = qdetector_cccf_get_gamma(_q->detector);
-        _q->dphi_hat  = qdetector_cccf_get_dphi (_q->detector);
-        _q->phi_hat   = qdetector_cccf_get_phi  (_q->detector);
+    if (v == NULL)
+        return LIQUID_OK;
 
-#if DEBUG_FRAMESYNC64_PRINT
-        printf("***** frame detected! tau-hat:%8.4f, dphi-hat:%8.4f, gamma:%8.2f dB\n",
-                _q->tau_hat, _q->dphi_hat, 20*log10f(_q->gamma_hat));
-#endif
+    // reject detections triggered by the trailing edge of a held frame
+    // (see flexframesync_execute_seekpn)
+    float threshold = qdetector_cccf_get_threshold(_q->detector);
+    if (_q->num_demods > 1 && qdetector_cccf_get_rxy_aligned(_q->detector) < threshold)
+        return LIQUID_OK;
 
-        // set appropriate filterbank index
-        if (_q->tau_hat > 0) {
-            _q->pfb_index = (unsigned int)(      _q->tau_hat  * _q->npfb) % _q->npfb;
-            _q->mf_counter = 0;
-        } else {
-            _q->pfb_index = (unsigned int)((1.0f+_q->tau_hat) * _q->npfb) % _q->npfb;
-            _q->mf_counter = 1;
+    // acquire available demodulator from pool
+    unsigned int i;
+    framesync64_demod d = NULL;
+    for (i=0; i<_q->num_demods; i++) {
+        if (_q->demod[i].state == FRAMESYNC64_STATE_DETECTFRAME) {
+            d = &_q->demod[i];
+            break;
         }
-        
-        // output filter scale
-        firpfb_crcf_set_scale(_q->mf, 0.5f / _q->gamma_hat);
+    }
+    if (d == NULL)
+        return liquid_error(LIQUID_EINT,"framesync64_execute_seekpn(), no demodulator available");
 
-        // set frequency/phase of mixer
-        nco_crcf_set_frequency(_q->mixer, _q->dphi_hat);
-        nco_crcf_set_phase    (_q->mixer, _q->phi_hat );
+    // get estimates
+    d->tau_hat   = qdetector_cccf_get_tau  (_q->detector);
+    d->gamma_hat = qdetector_cccf_get_gamma(_q->detector);
+    d->dphi_hat  = qdetector_cccf_get_dphi (_q->detector);
+    d->phi_hat   = qdetector_cccf_get_phi  (_q->detector);
 
-        // update state
-        _q->state = FRAMESYNC64_STATE_RXPREAMBLE;
+#if DEBUG_FRAMESYNC64_PRINT
+    printf("***** frame detected! tau-hat:%8.4f, dphi-hat:%8.4f, gamma:%8.2f dB\n",
+            d->tau_hat, d->dphi_hat, 20*log10f(d->gamma_hat));
+#endif
 
-        // run buffered samples through synchronizer
-        unsigned int buf_len = qdetector_cccf_get_buf_len(_q->detector);
-        framesync64_execute(_q, v, buf_len);
+    // set appropriate filterbank index
+    if (d->tau_hat > 0) {
+        d->pfb_index = (unsigned int)(      d->tau_hat  * _q->npfb) % _q->npfb;
+        d->mf_counter = 0;
+    } else {
+        d->pfb_index = (unsigned int)((1.0f+d->tau_hat) * _q->npfb) % _q->npfb;
+        d->mf_counter = 1;
     }
+    
+    // output filter scale
+    firpfb_crcf_set_scale(d->mf, 0.5f / d->gamma_hat);
+
+    // set frequency/phase of mixer
+    nco_crcf_set_frequency(d->mixer, d->dphi_hat);
+    nco_crcf_set_phase    (d->mixer, d->phi_hat );
+
+    // update state
+    d->state = FRAMESYNC64_STATE_RXPREAMBLE;
+
+    // stall detector if no more demodulators are available
+    _q->detector_idle = framesync64_get_num_frames_open(_q) == _q->num_demods;
+
+    // run buffered samples through this demodulator only; other
+    // demodulators (and the detector) have already observed them
+    unsigned int buf_len = qdetector_cccf_get_buf_len(_q->detector);
+    for (i=0; i<buf_len && d->state != FRAMESYNC64_STATE_DETECTFRAME; i++)
+        framesync64_demod_execute(_q, d, v[i]);
     return LIQUID_OK;
 }
 
 // step receiver mixer, matched filter, decimator
-//  _q      :   frame synchronizer
+//  _d      :   demodulator context
 //  _x      :   input sample
 //  _y      :   output symbol
-int framesync64_step(framesync64     _q,
-                     float complex   _x,
-                     float complex * _y)
+int framesync64_step(framesync64_demod _d,
+                     float complex     _x,
+                     float complex *   _y)
 {
     // mix sample down
     float complex v;
-    nco_crcf_mix_down(_q->mixer, _x, &v);
-    nco_crcf_step    (_q->mixer);
+    nco_crcf_mix_down(_d->mixer, _x, &v);
+    nco_crcf_step    (_d->mixer);
     
     // push sample into filterbank
-    firpfb_crcf_push   (_q->mf, v);
-    firpfb_crcf_execute(_q->mf, _q->pfb_index, &v);
+    firpfb_crcf_push   (_d->mf, v);
+    firpfb_crcf_execute(_d->mf, _d->pfb_index, &v);
 
 #if FRAMESYNC64_ENABLE_EQ
     // push sample through equalizer
-    eqlms_cccf_push(_q->equalizer, v);
+    eqlms_cccf_push(_d->equalizer, v);
 #endif
 
     // increment counter to determine if sample is available
-    _q->mf_counter++;
-    int sample_available = (_q->mf_counter >= 1) ? 1 : 0;
+    _d->mf_counter++;
+    int sample_available = (_d->mf_counter >= 1) ? 1 : 0;
     
     // set output sample if available
     if (sample_available) {
 #if FRAMESYNC64_ENABLE_EQ
         // compute equalizer output
-        eqlms_cccf_execute(_q->equalizer, &v);
+        eqlms_cccf_execute(_d->equalizer, &v);
 #endif
 
         // set output
         *_y = v;
 
         // decrement counter by k=2 samples/symbol
-        _q->mf_counter -= 2;
+        _d->mf_counter -= 2;
     }
 
     // return flag
@@ -373,15 +529,16 @@ int framesync64_step(framesync64     _q,
 }
 
 // execute synchronizer, receiving p/n sequence
-//  _q     :   frame synchronizer object
+//  _q      :   frame synchronizer object
+//  _d      :   demodulator context
 //  _x      :   input sample
-//  _sym    :   demodulated symbol
-int framesync64_execute_rxpreamble(framesync64   _q,
-                                    float complex _x)
+int framesync64_execute_rxpreamble(framesync64       _q,
+                                   framesync64_demod _d,
+                                   float complex     _x)
 {
     // step synchronizer
     float complex mf_out = 0.0f;
-    int sample_available = framesync64_step(_q, _x, &mf_out);
+    int sample_available = framesync64_step(_d, _x, &mf_out);
 
     // compute output if timeout
     if (sample_available) {
@@ -392,87 +549,88 @@ int framesync64_execute_rxpreamble(framesync64   _q,
 #else
         unsigned int delay = 2*_q->m;     // delay from matched filter
 #endif
-        if (_q->preamble_counter >= delay) {
-            unsigned int index = _q->preamble_counter-delay;
+        if (_d->preamble_counter >= delay) {
+            unsigned int index = _d->preamble_counter-delay;
 
-            _q->preamble_rx[index] = mf_out;
+            _d->preamble_rx[index] = mf_out;
         
 #if FRAMESYNC64_ENABLE_EQ
             // train equalizer
-            eqlms_cccf_step(_q->equalizer, _q->preamble_pn[index], mf_out);
+            eqlms_cccf_step(_d->equalizer, _q->preamble_pn[index], mf_out);
 #endif
         }
 
         // update p/n counter
-        _q->preamble_counter++;
+        _d->preamble_counter++;
 
         // update state
-        if (_q->preamble_counter == 64 + delay)
-            _q->state = FRAMESYNC64_STATE_RXPAYLOAD;
+        if (_d->preamble_counter == 64 + delay)
+            _d->state = FRAMESYNC64_STATE_RXPAYLOAD;
     }
     return LIQUID_OK;
 }
 
 // execute synchronizer, receiving payload
 //  _q      :   frame synchronizer object
+//  _d      :   demodulator context
 //  _x      :   input sample
-//  _sym    :   demodulated symbol
-int framesync64_execute_rxpayload(framesync64   _q,
-                                  float complex _x)
+int framesync64_execute_rxpayload(framesync64       _q,
+                                  framesync64_demod _d,
+                                  float complex     _x)
 {
     // step synchronizer
     float complex mf_out = 0.0f;
-    int sample_available = framesync64_step(_q, _x, &mf_out);
+    int sample_available = framesync64_step(_d, _x, &mf_out);
 
     // compute output if timeout
     if (sample_available) {
         // save payload symbols (modem input/output)
-        _q->payload_rx[_q->payload_counter] = mf_out;
+        _d->payload_rx[_d->payload_counter] = mf_out;
 
         // increment counter
-        _q->payload_counter++;
+        _d->payload_counter++;
 
-        if (_q->payload_counter == 630) {
+        if (_d->payload_counter == 630) {
             // recover data symbols from pilots
-            qpilotsync_execute(_q->pilotsync, _q->payload_rx, _q->payload_sym);
+            qpilotsync_execute(_q->pilotsync, _d->payload_rx, _d->payload_sym);
 
             // decode payload
-            _q->payload_valid = qpacketmodem_decode(_q->dec,
-                                                    _q->payload_sym,
-                                                    _q->payload_dec);
+            _d->payload_valid = qpacketmodem_decode(_q->dec,
+                                                    _d->payload_sym,
+                                                    _d->payload_dec);
 
             // update statistics
             _q->framedatastats.num_frames_detected++;
-            _q->framedatastats.num_headers_valid  += _q->payload_valid;
-            _q->framedatastats.num_payloads_valid += _q->payload_valid;
-            _q->framedatastats.num_bytes_received += _q->payload_valid ? 64 : 0;
+            _q->framedatastats.num_headers_valid  += _d->payload_valid;
+            _q->framedatastats.num_payloads_valid += _d->payload_valid;
+            _q->framedatastats.num_bytes_received += _d->payload_valid ? 64 : 0;
 
             // invoke callback
             if (_q->callback != NULL) {
                 // set framesyncstats internals
-                _q->framesyncstats.evm           = qpilotsync_get_evm(_q->pilotsync);
-                _q->framesyncstats.rssi          = 20*log10f(_q->gamma_hat);
-                _q->framesyncstats.cfo           = nco_crcf_get_frequency(_q->mixer);
-                _q->framesyncstats.framesyms     = _q->payload_sym;
-                _q->framesyncstats.num_framesyms = 600;
-                _q->framesyncstats.mod_scheme    = LIQUID_MODEM_QPSK;
-                _q->framesyncstats.mod_bps       = 2;
-                _q->framesyncstats.check         = LIQUID_CRC_24;
-                _q->framesyncstats.fec0          = LIQUID_FEC_NONE;
-                _q->framesyncstats.fec1          = LIQUID_FEC_GOLAY2412;
+                _d->framesyncstats.evm           = qpilotsync_get_evm(_q->pilotsync);
+                _d->framesyncstats.rssi          = 20*log10f(_d->gamma_hat);
+                _d->framesyncstats.cfo           = nco_crcf_get_frequency(_d->mixer);
+                _d->framesyncstats.framesyms     = _d->payload_sym;
+                _d->framesyncstats.num_framesyms = 600;
+                _d->framesyncstats.mod_scheme    = LIQUID_MODEM_QPSK;
+                _d->framesyncstats.mod_bps       = 2;
+                _d->framesyncstats.check         = LIQUID_CRC_24;
+                _d->framesyncstats.fec0          = LIQUID_FEC_NONE;
+                _d->framesyncstats.fec1          = LIQUID_FEC_GOLAY2412;
 
                 // invoke callback method
-                _q->callback(&_q->payload_dec[0],   // header is first 8 bytes
-                             _q->payload_valid,
-                             &_q->payload_dec[8],   // payload is last 64 bytes
+                _q->callback(&_d->payload_dec[0],   // header is first 8 bytes
+                             _d->payload_valid,
+                             &_d->payload_dec[8],   // payload is last 64 bytes
                              64,
-                             _q->payload_valid,
-                             _q->framesyncstats,
+                             _d->payload_valid,
+                             _d->framesyncstats,
                              _q->userdata);
             }
 
-            // reset frame synchronizer
-            return framesync64_reset(_q);
+            // return demodulator to pool
+            return framesync64_demod_reset(_q, _d);
         }
     }
     return LIQUID_OK;
@@ -543,22 +701,22 @@ int framesync64_debug_print(framesync64  _q,
     for (i=0; i<64; i++)
         fprintf(fid,"preamble_pn(%4u) = %12.4e + 1i*%12.4e;\n", i+1, crealf(rc[i]), cimagf(rc[i]));
 
-    // write p/n symbols
+    // write p/n symbols (first demodulator)
     fprintf(fid,"preamble_rx = zeros(1,64);\n");
-    rc = _q->preamble_rx;
+    rc = _q->demod[0].preamble_rx;
     for (i=0; i<64; i++)
         fprintf(fid,"preamble_rx(%4u) = %12.4e + 1i*%12.4e;\n", i+1, crealf(rc[i]), cimagf(rc[i]));
 
     // write raw payload symbols
     unsigned int payload_sym_len = 600;
     fprintf(fid,"payload_rx = zeros(1,%u);\n", payload_sym_len);
-    rc = _q->payload_rx;
+    rc = _q->demod[0].payload_rx;
     for (i=0; i<payload_sym_len; i++)
         fprintf(fid,"payload_rx(%4u) = %12.4e + j*%12.4e;\n", i+1, crealf(rc[i]), cimagf(rc[i]));
 
     // write payload symbols
     fprintf(fid,"payload_syms = zeros(1,%u);\n", payload_sym_len);
-    rc = _q->payload_sym;
+    rc = _q->demod[0].payload_sym;
     for (i=0; i<payload_sym_len; i++)
         fprintf(fid,"payload_syms(%4u) = %12.4e + j*%12.4e;\n", i+1, crealf(rc[i]), cimagf(rc[i]));
 
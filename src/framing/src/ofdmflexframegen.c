@@ -55,6 +55,15 @@ int ofdmflexframegen_gen_payload(ofdmflexframegen _q); // generate payload symbo
 int ofdmflexframegen_gen_tail   (ofdmflexframegen _q); // generate tail symbol
 int ofdmflexframegen_gen_zeros  (ofdmflexframegen _q); // generate zeros
 
+// generate up to _n payload symbols directly into output buffer _y,
+// returning the number of symbols written
+unsigned int ofdmflexframegen_gen_payload_block(ofdmflexframegen _q,
+                                                float complex *  _y,
+                                                unsigned int     _n);
+
+// maximum number of payload symbols generated per block
+#define OFDMFLEXFRAMEGEN_BLOCK_LEN  (8)
+
 // default ofdmflexframegen properties
 static ofdmflexframegenprops_s ofdmflexframegenprops_default = {
     LIQUID_CRC_32,      // check
@@ -82,6 +91,7 @@ struct ofdmflexframegen_s {
     unsigned int cp_len;    // cyclic prefix length
     unsigned int taper_len; // taper length
     unsigned char * p;      // subcarrier allocation (null, pilot, data)
+    unsigned int * data_idx;// data subcarrier indices, ascending
 
     // constants
     unsigned int M_null;    // number of null subcarriers
@@ -92,7 +102,7 @@ struct ofdmflexframegen_s {
     unsigned int frame_len; // frame length (M + cp_len)
 
     // buffers
-    float complex * X;          // frequency-domain buffer
+    float complex * X;          // frequency-domain buffer [size: M x OFDMFLEXFRAMEGEN_BLOCK_LEN]
     float complex * buf_tx;     // transmit buffer
     unsigned int    buf_index;  // buffer index
 
@@ -169,7 +179,7 @@ ofdmflexframegen ofdmflexframegen_create(unsigned int              _M,
 
     // allocate memory for transform buffers
     q->frame_len = q->M + q->cp_len;    // frame length
-    q->X         = (float complex*) malloc((q->M        )*sizeof(float complex));
+    q->X         = (float complex*) malloc((q->M*OFDMFLEXFRAMEGEN_BLOCK_LEN)*sizeof(float complex));
     q->buf_tx    = (float complex*) malloc((q->frame_len)*sizeof(float complex));
     q->buf_index = q->frame_len;
 
@@ -186,6 +196,14 @@ ofdmflexframegen ofdmflexframegen_create(unsigned int              _M,
     // validate and count subcarrier allocation
     ofdmframe_validate_sctype(q->p, q->M, &q->M_null, &q->M_pilot, &q->M_data);
 
+    // data subcarrier index list
+    q->data_idx = (unsigned int*) malloc((q->M_data)*sizeof(unsigned int));
+    unsigned int i, n=0;
+    for (i=0; i<q->M; i++) {
+        if (q->p[i] == OFDMFRAME_SCTYPE_DATA)
+            q->data_idx[n++] = i;
+    }
+
     // create internal OFDM frame generator object
     q->fg = ofdmframegen_create(q->M, q->cp_len, q->taper_len, q->p);
 
@@ -238,6 +256,7 @@ int ofdmflexframegen_destroy(ofdmflexframegen _q)
     free(_q->X);                        // frequency-domain buffer
     free(_q->buf_tx);                   // transmit buffer
     free(_q->p);                        // subcarrier allocation
+    free(_q->data_idx);                 // data subcarrier indices
     free(_q->header);                   // decoded header
     free(_q->header_enc);               // encoded header
     free(_q->header_mod);               // modulated header
@@ -472,15 +491,28 @@ int ofdmflexframegen_write(ofdmflexframegen _q,
                            float complex *  _buf,
                            unsigned int     _buf_len)
 {
-    unsigned int i;
-    for (i=0; i<_buf_len; i++) {
+    unsigned int i = 0;
+    while (i < _buf_len) {
         if (_q->buf_index >= _q->frame_len) {
+            // generate whole payload symbols directly into output buffer
+            unsigned int num_symbols = (_buf_len - i) / _q->frame_len;
+            if (_q->state == OFDMFLEXFRAMEGEN_STATE_PAYLOAD && num_symbols > 0) {
+                num_symbols = ofdmflexframegen_gen_payload_block(_q, &_buf[i], num_symbols);
+                i += num_symbols * _q->frame_len;
+                continue;
+            }
+
             ofdmflexframegen_gen_symbol(_q);
             _q->buf_index = 0;
         }
 
-        // TODO: write samples appropriately
-        _buf[i] = _q->buf_tx[_q->buf_index++];
+        // copy as much of the buffered symbol as fits
+        unsigned int n = _q->frame_len - _q->buf_index;
+        if (n > _buf_len - i)
+            n = _buf_len - i;
+        memmove(&_buf[i], &_q->buf_tx[_q->buf_index], n*sizeof(float complex));
+        _q->buf_index += n;
+        i += n;
     }
     return _q->frame_complete;
 }
@@ -587,9 +619,6 @@ int ofdmflexframegen_modulate_header(ofdmflexframegen _q)
 // generate transmit samples (fill internal buffer)
 int ofdmflexframegen_gen_symbol(ofdmflexframegen _q)
 {
-    // increment symbol counter
-    _q->symbol_number++;
-
     switch (_q->state) {
     case OFDMFLEXFRAMEGEN_STATE_S0a:     return ofdmflexframegen_gen_S0a    (_q);
     case OFDMFLEXFRAMEGEN_STATE_S0b:     return ofdmflexframegen_gen_S0b    (_q);
@@ -655,6 +684,8 @@ int ofdmflexframegen_gen_header(ofdmflexframegen _q)
 #if DEBUG_OFDMFLEXFRAMEGEN
     printf("writing header symbol\n");
 #endif
+    // increment symbol counter
+    _q->symbol_number++;
 
     // load data onto data subcarriers
     unsigned int i;
@@ -695,43 +726,50 @@ int ofdmflexframegen_gen_header(ofdmflexframegen _q)
 
 // write payload symbol
 int ofdmflexframegen_gen_payload(ofdmflexframegen _q)
+{
+    ofdmflexframegen_gen_payload_block(_q, _q->buf_tx, 1);
+    return LIQUID_OK;
+}
+
+// write block of payload symbols
+unsigned int ofdmflexframegen_gen_payload_block(ofdmflexframegen _q,
+                                                float complex *  _y,
+                                                unsigned int     _n)
 {
 #if DEBUG_OFDMFLEXFRAMEGEN
-    printf("writing payload symbol\n");
+    printf("writing payload symbols\n");
 #endif
+    // limit to remaining payload symbols and internal buffer size
+    unsigned int num_symbols = _q->num_symbols_payload - _q->symbol_number;
+    if (num_symbols > _n)                         num_symbols = _n;
+    if (num_symbols > OFDMFLEXFRAMEGEN_BLOCK_LEN) num_symbols = OFDMFLEXFRAMEGEN_BLOCK_LEN;
 
-    // load data onto data subcarriers
+    // load data onto data subcarriers (ofdmframegen handles nulls and pilots)
     unsigned int i;
-    int sctype;
-    for (i=0; i<_q->M; i++) {
-        //
-        sctype = _q->p[i];
-
-        // 
-        if (sctype == OFDMFRAME_SCTYPE_DATA) {
-            // load...
+    unsigned int n;
+    for (n=0; n<num_symbols; n++) {
+        float complex * X = &_q->X[n*_q->M];
+        for (i=0; i<_q->M_data; i++) {
+            unsigned int sym;
             if (_q->payload_symbol_index < _q->payload_mod_len) {
                 // modulate payload symbol onto data subcarrier
-                modemcf_modulate(_q->mod_payload, _q->payload_mod[_q->payload_symbol_index++], &_q->X[i]);
+                sym = _q->payload_mod[_q->payload_symbol_index++];
             } else {
-                //printf("  random payload symbol\n");
                 // load random symbol
-                unsigned int sym = modemcf_gen_rand_sym(_q->mod_payload);
-                modemcf_modulate(_q->mod_payload, sym, &_q->X[i]);
+                sym = modemcf_gen_rand_sym(_q->mod_payload);
             }
-        } else {
-            // ignore subcarrier (ofdmframegen handles nulls and pilots)
-            _q->X[i] = 0.0f;
+            modemcf_modulate(_q->mod_payload, sym, &X[_q->data_idx[i]]);
         }
     }
 
-    // write symbol
-    ofdmframegen_writesymbol(_q->fg, _q->X, _q->buf_tx);
+    // write symbols
+    ofdmframegen_write_block(_q->fg, _q->X, num_symbols, _y);
+    _q->symbol_number += num_symbols;
 
     // check to see if this is the last symbol in the payload
     if (_q->symbol_number == _q->num_symbols_payload)
         _q->state = OFDMFLEXFRAMEGEN_STATE_TAIL;
-    return LIQUID_OK;
+    return num_symbols;
 }
 
 // generate buffer of zeros
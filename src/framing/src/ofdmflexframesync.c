@@ -71,6 +71,7 @@ struct ofdmflexframesync_s {
     unsigned int cp_len;    // cyclic prefix length
     unsigned int taper_len; // taper length
     unsigned char * p;      // subcarrier allocation (null, pilot, data)
+    unsigned int * data_idx;// data subcarrier indices, ascending
 
     // constants
     unsigned int M_null;    // number of null subcarriers
@@ -112,6 +113,7 @@ struct ofdmflexframesync_s {
     unsigned int payload_mod_len;       // number of payload modem symbols
     int payload_valid;                  // valid payload flag
     float complex * payload_syms;       // received payload symbols
+    framedecq decq;                     // asynchronous payload decoder (NULL: decode inline)
 
     // callback
     framesync_callback callback;        // user-defined callback function
@@ -122,6 +124,7 @@ struct ofdmflexframesync_s {
 
     // internal synchronizer objects
     ofdmframesync fs;                   // internal OFDM frame synchronizer
+    liquid_ofdmchtrack_method chtrack_method; // per-subcarrier channel tracking method
 
     // counters/states
     unsigned int symbol_counter;        // received symbol number
@@ -178,8 +181,17 @@ ofdmflexframesync ofdmflexframesync_create(unsigned int       _M,
     // validate and count subcarrier allocation
     ofdmframe_validate_sctype(q->p, q->M, &q->M_null, &q->M_pilot, &q->M_data);
 
+    // data subcarrier index list
+    q->data_idx = (unsigned int*) malloc((q->M_data)*sizeof(unsigned int));
+    unsigned int i, n=0;
+    for (i=0; i<q->M; i++) {
+        if (q->p[i] == OFDMFRAME_SCTYPE_DATA)
+            q->data_idx[n++] = i;
+    }
+
     // create internal framing object
     q->fs = ofdmframesync_create(_M, _cp_len, _taper_len, _p, ofdmflexframesync_internal_callback, (void*)q);
+    q->chtrack_method = LIQUID_OFDMCHTRACK_NONE;
 
     // create header objects
     q->header = NULL;
@@ -209,6 +221,7 @@ ofdmflexframesync ofdmflexframesync_create(unsigned int       _M,
     q->payload_dec = (unsigned char*) malloc(q->payload_len*sizeof(unsigned char));
     q->payload_syms = (float complex *) malloc(q->payload_len*sizeof(float complex));
     q->payload_mod_len = 0;
+    q->decq = NULL;
 
     // reset state
     ofdmflexframesync_reset_framedatastats(q);
@@ -220,6 +233,10 @@ ofdmflexframesync ofdmflexframesync_create(unsigned int       _M,
 
 int ofdmflexframesync_destroy(ofdmflexframesync _q)
 {
+    // destroy asynchronous decoder, discarding undelivered frames
+    if (_q->decq != NULL)
+        framedecq_destroy(_q->decq);
+
     // destroy internal objects
     ofdmframesync_destroy(_q->fs);
     packetizer_destroy(_q->p_header);
@@ -229,6 +246,7 @@ int ofdmflexframesync_destroy(ofdmflexframesync _q)
 
     // free internal buffers/arrays
     free(_q->p);
+    free(_q->data_idx);
     free(_q->payload_enc);
     free(_q->payload_dec);
     free(_q->payload_syms);
@@ -341,6 +359,10 @@ int ofdmflexframesync_reset(ofdmflexframesync _q)
     // reset global data counters
     framesyncstats_init_default(&_q->framesyncstats);
 
+    // decision-directed channel tracking starts on the header
+    if (_q->chtrack_method == LIQUID_OFDMCHTRACK_DD)
+        ofdmframesync_set_chtrack_scheme(_q->fs, _q->header_props.mod_scheme);
+
     // reset internal OFDM frame synchronizer object
     return ofdmframesync_reset(_q->fs);
 }
@@ -356,7 +378,39 @@ int ofdmflexframesync_execute(ofdmflexframesync _q,
                               unsigned int      _n)
 {
     // push samples through ofdmframesync object
-    return ofdmframesync_execute(_q->fs, _x, _n);
+    int rc = ofdmframesync_execute(_q->fs, _x, _n);
+
+    // deliver frames that have finished decoding asynchronously
+    if (_q->decq != NULL)
+        framedecq_deliver(_q->decq);
+    return rc;
+}
+
+// enable asynchronous payload decoding
+int ofdmflexframesync_set_async_decode(ofdmflexframesync _q,
+                                       unsigned int      _queue_len,
+                                       unsigned int      _num_workers)
+{
+    // deliver outstanding frames and remove existing decoder
+    if (_q->decq != NULL) {
+        framedecq_flush(_q->decq);
+        framedecq_destroy(_q->decq);
+        _q->decq = NULL;
+    }
+
+    // queue length of zero disables asynchronous decoding
+    if (_queue_len == 0)
+        return LIQUID_OK;
+
+    _q->decq = framedecq_create(_queue_len, _num_workers,
+                                _q->callback, _q->userdata, &_q->framedatastats);
+    return _q->decq == NULL ? LIQUID_EICONFIG : LIQUID_OK;
+}
+
+// wait for asynchronously decoded payloads and deliver them
+int ofdmflexframesync_async_flush(ofdmflexframesync _q)
+{
+    return _q->decq == NULL ? LIQUID_OK : framedecq_flush(_q->decq);
 }
 
 // 
@@ -397,6 +451,28 @@ int ofdmflexframesync_set_cfo(ofdmflexframesync _q, float _cfo)
     return ofdmframesync_set_cfo(_q->fs, _cfo);
 }
 
+// set per-subcarrier channel tracking method
+int ofdmflexframesync_set_chtrack_method(ofdmflexframesync         _q,
+                                         liquid_ofdmchtrack_method _method)
+{
+    if (ofdmframesync_set_chtrack_method(_q->fs, _method) != LIQUID_OK)
+        return liquid_error(LIQUID_EICONFIG,"ofdmflexframesync_set_chtrack_method(), invalid method");
+    _q->chtrack_method = _method;
+
+    // decisions are only needed by the decision-directed method
+    modulation_scheme ms = LIQUID_MODEM_UNKNOWN;
+    if (_method == LIQUID_OFDMCHTRACK_DD)
+        ms = _q->state == OFDMFLEXFRAMESYNC_STATE_PAYLOAD ? _q->ms_payload : _q->header_props.mod_scheme;
+    return ofdmframesync_set_chtrack_scheme(_q->fs, ms);
+}
+
+// set per-subcarrier channel tracking loop bandwidth
+int ofdmflexframesync_set_chtrack_bandwidth(ofdmflexframesync _q,
+                                            float             _bw)
+{
+    return ofdmframesync_set_chtrack_bandwidth(_q->fs, _bw);
+}
+
 // 
 // debugging methods
 //
@@ -465,77 +541,75 @@ int ofdmflexframesync_rxheader(ofdmflexframesync _q,
     printf("  ofdmflexframesync extracting header...\n");
 #endif
 
-    // demodulate header symbols
+    // demodulate header symbols on data subcarriers
     unsigned int i;
-    int sctype;
-    for (i=0; i<_q->M; i++) {
-        // subcarrier type (PILOT/NULL/DATA)
-        sctype = _q->p[i];
-
-        // ignore pilot and null subcarriers
-        if (sctype == OFDMFRAME_SCTYPE_DATA) {
-            // unload header symbols
-            // demodulate header symbol
-            unsigned int sym;
-            if (_q->header_soft) {
-                unsigned int bps = modulation_types[_q->header_props.mod_scheme].bps;
-                modemcf_demodulate_soft(_q->mod_header, _X[i], &sym, &_q->header_mod[bps*_q->header_symbol_index]);
+    for (i=0; i<_q->M_data; i++) {
+        float complex x = _X[_q->data_idx[i]];
+
+        // demodulate header symbol
+        unsigned int sym;
+        if (_q->header_soft) {
+            unsigned int bps = modulation_types[_q->header_props.mod_scheme].bps;
+            modemcf_demodulate_soft(_q->mod_header, x, &sym, &_q->header_mod[bps*_q->header_symbol_index]);
+        } else {
+            modemcf_demodulate(_q->mod_header, x, &sym);
+            _q->header_mod[_q->header_symbol_index] = sym;
+        }
+        _q->header_symbol_index++;
+        //printf("  extracting symbol %3u / %3u (x = %8.5f + j%8.5f)\n", _q->header_symbol_index, _q->header_sym_len, crealf(x), cimagf(x));
+
+        // get demodulator error vector magnitude
+        float evm = modemcf_get_demodulator_evm(_q->mod_header);
+        _q->evm_hat += evm*evm;
+
+        // header extracted
+        if (_q->header_symbol_index == _q->header_sym_len) {
+            // decode header
+            ofdmflexframesync_decode_header(_q);
+        
+            // update statistics
+            _q->framesyncstats.evm = 10*log10f( _q->evm_hat/_q->header_sym_len );
+            _q->framedatastats.num_frames_detected++;
+
+            // invoke callback if header is invalid
+            if (_q->header_valid) {
+                _q->state = OFDMFLEXFRAMESYNC_STATE_PAYLOAD;
+                _q->framedatastats.num_headers_valid++;
+
+                // decision-directed channel tracking switches to payload
+                if (_q->chtrack_method == LIQUID_OFDMCHTRACK_DD)
+                    ofdmframesync_set_chtrack_scheme(_q->fs, _q->ms_payload);
             } else {
-                modemcf_demodulate(_q->mod_header, _X[i], &sym);
-                _q->header_mod[_q->header_symbol_index] = sym;
-            }
-            _q->header_symbol_index++;
-            //printf("  extracting symbol %3u / %3u (x = %8.5f + j%8.5f)\n", _q->header_symbol_index, _q->header_sym_len, crealf(_X[i]), cimagf(_X[i]));
-
-            // get demodulator error vector magnitude
-            float evm = modemcf_get_demodulator_evm(_q->mod_header);
-            _q->evm_hat += evm*evm;
-
-            // header extracted
-            if (_q->header_symbol_index == _q->header_sym_len) {
-                // decode header
-                ofdmflexframesync_decode_header(_q);
-            
-                // update statistics
-                _q->framesyncstats.evm = 10*log10f( _q->evm_hat/_q->header_sym_len );
-                _q->framedatastats.num_frames_detected++;
-
-                // invoke callback if header is invalid
-                if (_q->header_valid) {
-                    _q->state = OFDMFLEXFRAMESYNC_STATE_PAYLOAD;
-                    _q->framedatastats.num_headers_valid++;
-                } else {
-                    //printf("**** header invalid!\n");
-                    // set framesyncstats internals
-                    _q->framesyncstats.rssi          = ofdmframesync_get_rssi(_q->fs);
-                    _q->framesyncstats.cfo           = ofdmframesync_get_cfo(_q->fs);
-                    _q->framesyncstats.framesyms     = NULL;
-                    _q->framesyncstats.num_framesyms = 0;
-                    _q->framesyncstats.mod_scheme    = LIQUID_MODEM_UNKNOWN;
-                    _q->framesyncstats.mod_bps       = 0;
-                    _q->framesyncstats.check         = LIQUID_CRC_UNKNOWN;
-                    _q->framesyncstats.fec0          = LIQUID_FEC_UNKNOWN;
-                    _q->framesyncstats.fec1          = LIQUID_FEC_UNKNOWN;
-
-                    // ignore callback if set to NULL
-                    if (_q->callback == NULL) {
-                        ofdmflexframesync_reset(_q);
-                        break;
-                    }
-
-                    // invoke callback method
-                    _q->callback(_q->header,
-                                 _q->header_valid,
-                                 NULL,
-                                 0,
-                                 0,
-                                 _q->framesyncstats,
-                                 _q->userdata);
+                //printf("**** header invalid!\n");
+                // set framesyncstats internals
+                _q->framesyncstats.rssi          = ofdmframesync_get_rssi(_q->fs);
+                _q->framesyncstats.cfo           = ofdmframesync_get_cfo(_q->fs);
+                _q->framesyncstats.framesyms     = NULL;
+                _q->framesyncstats.num_framesyms = 0;
+                _q->framesyncstats.mod_scheme    = LIQUID_MODEM_UNKNOWN;
+                _q->framesyncstats.mod_bps       = 0;
+                _q->framesyncstats.check         = LIQUID_CRC_UNKNOWN;
+                _q->framesyncstats.fec0          = LIQUID_FEC_UNKNOWN;
+                _q->framesyncstats.fec1          = LIQUID_FEC_UNKNOWN;
 
+                // ignore callback if set to NULL
+                if (_q->callback == NULL) {
                     ofdmflexframesync_reset(_q);
+                    break;
                 }
-                break;
+
+                // invoke callback method
+                _q->callback(_q->header,
+                             _q->header_valid,
+                             NULL,
+                             0,
+                             0,
+                             _q->framesyncstats,
+                             _q->userdata);
+
+                ofdmflexframesync_reset(_q);
             }
+            break;
         }
     }
     return LIQUID_OK;
@@ -688,88 +762,101 @@ int ofdmflexframesync_decode_header(ofdmflexframesync _q)
 int ofdmflexframesync_rxpayload(ofdmflexframesync _q,
                                 float complex * _X)
 {
-    // demodulate paylod symbols
+    // number of payload symbols carried by this OFDM symbol
+    unsigned int n = _q->payload_mod_len - _q->payload_symbol_index;
+    if (n > _q->M_data)
+        n = _q->M_data;
+
+    // gather data subcarriers into received payload symbols
+    float complex * syms = &_q->payload_syms[_q->payload_symbol_index];
     unsigned int i;
-    int sctype;
-    for (i=0; i<_q->M; i++) {
-        // subcarrier type (PILOT/NULL/DATA)
-        sctype = _q->p[i];
-
-        // ignore pilot and null subcarriers
-        if (sctype == OFDMFRAME_SCTYPE_DATA) {
-            // unload payload symbols
+    for (i=0; i<n; i++)
+        syms[i] = _X[_q->data_idx[i]];
+
+    // demodulate payload symbols
+    if (_q->payload_soft) {
+        modemcf_demodulate_soft_block(_q->mod_payload, syms, n,
+                &_q->payload_enc[_q->bps_payload*_q->payload_symbol_index]);
+    } else {
+        for (i=0; i<n; i++) {
             unsigned int sym;
-            // store received symbol
-            _q->payload_syms[_q->payload_symbol_index] = _X[i];
+            modemcf_demodulate(_q->mod_payload, syms[i], &sym);
 
-            if (_q->payload_soft) {
-                modemcf_demodulate_soft(_q->mod_payload, _X[i], &sym, &_q->payload_enc[_q->bps_payload*_q->payload_symbol_index]);
-            } else {
-                modemcf_demodulate(_q->mod_payload, _X[i], &sym);
+            // pack decoded symbol into array
+            liquid_pack_array(_q->payload_enc,
+                              _q->payload_enc_len,
+                              _q->payload_buffer_index,
+                              _q->bps_payload,
+                              sym);
 
-                // pack decoded symbol into array
-                liquid_pack_array(_q->payload_enc,
-                                  _q->payload_enc_len,
-                                  _q->payload_buffer_index,
-                                  _q->bps_payload,
-                                  sym);
+            // increment...
+            _q->payload_buffer_index += _q->bps_payload;
+        }
+    }
 
-                // increment...
-                _q->payload_buffer_index += _q->bps_payload;
-            }
+    // increment symbol counter
+    _q->payload_symbol_index += n;
+    if (_q->payload_symbol_index < _q->payload_mod_len)
+        return LIQUID_OK;
 
-            // increment symbol counter
-            _q->payload_symbol_index++;
+    if (_q->decq != NULL) {
+        // hand payload off to asynchronous decoder; the frame
+        // is delivered through the callback once decoded
+        _q->framesyncstats.rssi          = ofdmframesync_get_rssi(_q->fs);
+        _q->framesyncstats.cfo           = ofdmframesync_get_cfo(_q->fs);
+        _q->framesyncstats.framesyms     = _q->payload_syms;
+        _q->framesyncstats.num_framesyms = _q->payload_mod_len;
+        _q->framesyncstats.mod_scheme    = _q->ms_payload;
+        _q->framesyncstats.mod_bps       = _q->bps_payload;
+        _q->framesyncstats.check         = _q->check;
+        _q->framesyncstats.fec0          = _q->fec0;
+        _q->framesyncstats.fec1          = _q->fec1;
+        framedecq_push(_q->decq, _q->header, _q->header_dec_len, _q->header_valid,
+                       _q->payload_enc, _q->payload_soft, _q->payload_len,
+                       _q->check, _q->fec0, _q->fec1, _q->framesyncstats);
+        return ofdmflexframesync_reset(_q);
+    }
 
-            if (_q->payload_symbol_index == _q->payload_mod_len) {
-                // payload extracted
-                if (_q->payload_soft) {
-                    _q->payload_valid = packetizer_decode_soft(_q->p_payload, _q->payload_enc, _q->payload_dec);
-                } else {
-                    // decode payload
-                    _q->payload_valid = packetizer_decode(_q->p_payload, _q->payload_enc, _q->payload_dec);
-                }
+    // payload extracted
+    if (_q->payload_soft) {
+        _q->payload_valid = packetizer_decode_soft(_q->p_payload, _q->payload_enc, _q->payload_dec);
+    } else {
+        // decode payload
+        _q->payload_valid = packetizer_decode(_q->p_payload, _q->payload_enc, _q->payload_dec);
+    }
 #if DEBUG_OFDMFLEXFRAMESYNC
-                printf("****** payload extracted [%s]\n", _q->payload_valid ? "valid" : "INVALID!");
+    printf("****** payload extracted [%s]\n", _q->payload_valid ? "valid" : "INVALID!");
 #endif
-                // update statistics
-                _q->framedatastats.num_payloads_valid += _q->payload_valid;
-                _q->framedatastats.num_bytes_received += _q->payload_len;
-
-                // set framesyncstats internals
-                _q->framesyncstats.rssi          = ofdmframesync_get_rssi(_q->fs);
-                _q->framesyncstats.cfo           = ofdmframesync_get_cfo(_q->fs);
-                _q->framesyncstats.framesyms     = _q->payload_syms;
-                _q->framesyncstats.num_framesyms = _q->payload_mod_len;
-                _q->framesyncstats.mod_scheme    = _q->ms_payload;
-                _q->framesyncstats.mod_bps       = _q->bps_payload;
-                _q->framesyncstats.check         = _q->check;
-                _q->framesyncstats.fec0          = _q->fec0;
-                _q->framesyncstats.fec1          = _q->fec1;
-
-                // ignore callback if set to NULL
-                if (_q->callback == NULL) {
-                    ofdmflexframesync_reset(_q);
-                    break;
-                }
-
-                // invoke callback method
-                _q->callback(_q->header,
-                             _q->header_valid,
-                             _q->payload_dec,
-                             _q->payload_len,
-                             _q->payload_valid,
-                             _q->framesyncstats,
-                             _q->userdata);
-
-
-                // reset object
-                ofdmflexframesync_reset(_q);
-                break;
-            }
-        }
-    }
-    return LIQUID_OK;
+    // update statistics
+    _q->framedatastats.num_payloads_valid += _q->payload_valid;
+    _q->framedatastats.num_bytes_received += _q->payload_len;
+
+    // set framesyncstats internals
+    _q->framesyncstats.rssi          = ofdmframesync_get_rssi(_q->fs);
+    _q->framesyncstats.cfo           = ofdmframesync_get_cfo(_q->fs);
+    _q->framesyncstats.framesyms     = _q->payload_syms;
+    _q->framesyncstats.num_framesyms = _q->payload_mod_len;
+    _q->framesyncstats.mod_scheme    = _q->ms_payload;
+    _q->framesyncstats.mod_bps       = _q->bps_payload;
+    _q->framesyncstats.check         = _q->check;
+    _q->framesyncstats.fec0          = _q->fec0;
+    _q->framesyncstats.fec1          = _q->fec1;
+
+    // ignore callback if set to NULL
+    if (_q->callback == NULL)
+        return ofdmflexframesync_reset(_q);
+
+    // invoke callback method
+    _q->callback(_q->header,
+                 _q->header_valid,
+                 _q->payload_dec,
+                 _q->payload_len,
+                 _q->payload_valid,
+                 _q->framesyncstats,
+                 _q->userdata);
+
+    // reset object
+    return ofdmflexframesync_reset(_q);
 }
 
 
@@ -413,6 +413,17 @@ float qdetector_cccf_get_phi(qdetector_cccf _q)
     return _q->phi_hat;
 }
 
+// correlation of the detected sequence normalized by the level of the
+// aligned samples rather than that of the whole search buffer
+float qdetector_cccf_get_rxy_aligned(qdetector_cccf _q)
+{
+    // aligned samples are saved in buf_time_1 when a frame is detected
+    float x2_sum = liquid_sumsqcf(_q->buf_time_1, _q->s_len);
+    if (x2_sum == 0.0f)
+        return 0.0f;
+    return _q->gamma_hat * sqrtf(_q->s2_sum / x2_sum);
+}
+
 
 //
 // internal methods
@@ -34,10 +34,21 @@
 #define DEBUG_SYMTRACK_FILENAME  "symtrack_internal_debug.m"
 #define DEBUG_BUFFER_LEN        (1024)
 
+// number of input samples processed by each stage of the block pipeline
+#define SYMTRACK_BLOCK_LEN      (128)
+
 //
 // forward declaration of internal methods
 //
 
+// run carrier recovery, equalization and demodulation on block of
+// samples at the output of the symbol synchronizer (2 samples/symbol)
+int SYMTRACK(_execute_tracking)(SYMTRACK()     _q,
+                                TO *           _x,
+                                unsigned int   _nx,
+                                TO *           _y,
+                                unsigned int * _ny);
+
 // internal structure
 struct SYMTRACK(_s) {
     // parameters
@@ -51,11 +62,12 @@ struct SYMTRACK(_s) {
     // automatic gain control
     AGC()           agc;                // agc object
     float           agc_bandwidth;      // agc bandwidth
+    TO              agc_buf[SYMTRACK_BLOCK_LEN];    // agc output block
 
     // symbol timing recovery
     SYMSYNC()       symsync;            // symbol timing recovery object
     float           symsync_bandwidth;  // symsync loop bandwidth
-    TO              symsync_buf[8];     // symsync output buffer
+    TO              symsync_buf[8*SYMTRACK_BLOCK_LEN]; // symsync output buffer
     unsigned int    symsync_index;      // symsync output sample index
 
     // equalizer/decimator
@@ -328,8 +340,6 @@ int SYMTRACK(_execute)(SYMTRACK()     _q,
                        unsigned int * _ny)
 {
     TO v;   // output sample
-    unsigned int i;
-    unsigned int num_outputs = 0;
 
     // run sample through automatic gain control
     AGC(_execute)(_q->agc, _x, &v);
@@ -338,11 +348,82 @@ int SYMTRACK(_execute)(SYMTRACK()     _q,
     unsigned int nw = 0;
     SYMSYNC(_execute)(_q->symsync, &v, 1, _q->symsync_buf, &nw);
 
-    // process each output sample
-    for (i=0; i<nw; i++) {
+    // carrier recovery, equalization, and demodulation
+    return SYMTRACK(_execute_tracking)(_q, _q->symsync_buf, nw, _y, _ny);
+}
+
+// execute synchronizer on input data array
+//  _q      : synchronizer object
+//  _x      : input data array
+//  _nx     : number of input samples
+//  _y      : output data array
+//  _ny     : number of samples written to output buffer
+int SYMTRACK(_execute_block)(SYMTRACK()     _q,
+                             TI *           _x,
+                             unsigned int   _nx,
+                             TO *           _y,
+                             unsigned int * _ny)
+{
+    // Neither the gain control nor the timing recovery loops depend on
+    // anything downstream, so each stage can be run over an entire block
+    // of samples before the next one starts, keeping the stage's state
+    // (and the symsync filterbank coefficients) hot in cache. The result
+    // is identical to calling SYMTRACK(_execute) on each sample.
+    unsigned int i;
+    unsigned int num_written = 0;
+    for (i=0; i<_nx; i+=SYMTRACK_BLOCK_LEN) {
+        unsigned int n = _nx - i < SYMTRACK_BLOCK_LEN ? _nx - i : SYMTRACK_BLOCK_LEN;
+
+        // automatic gain control
+        AGC(_execute_block)(_q->agc, &_x[i], n, _q->agc_buf);
+
+        // symbol synchronizer
+        unsigned int nw = 0;
+        SYMSYNC(_execute)(_q->symsync, _q->agc_buf, n, _q->symsync_buf, &nw);
+
+        // carrier recovery, equalization, and demodulation
+        unsigned int num_outputs = 0;
+        int rc = SYMTRACK(_execute_tracking)(_q, _q->symsync_buf, nw,
+                                             &_y[num_written], &num_outputs);
+        num_written += num_outputs;
+        if (rc != LIQUID_OK) {
+            *_ny = num_written;
+            return rc;
+        }
+    }
+
+    //
+    *_ny = num_written;
+    return LIQUID_OK;
+}
+
+//
+// internal methods
+//
+
+// run carrier recovery, equalization and demodulation on block of
+// samples at the output of the symbol synchronizer (2 samples/symbol)
+//  _q      : synchronizer object
+//  _x      : symbol synchronizer output array, [size: _nx x 1]
+//  _nx     : number of input samples
+//  _y      : output data array, [size: _nx/2+1 x 1]
+//  _ny     : number of samples written to output buffer
+int SYMTRACK(_execute_tracking)(SYMTRACK()     _q,
+                                TO *           _x,
+                                unsigned int   _nx,
+                                TO *           _y,
+                                unsigned int * _ny)
+{
+    TO v;   // output sample
+    unsigned int i;
+    unsigned int num_outputs = 0;
+
+    // process each output sample; these stages are all coupled through
+    // the phase-locked loop and equalizer updates and cannot be split
+    for (i=0; i<_nx; i++) {
         // update phase-locked loop
         NCO(_step)(_q->nco);
-        nco_crcf_mix_down(_q->nco, _q->symsync_buf[i], &v);
+        nco_crcf_mix_down(_q->nco, _x[i], &v);
 
         // equalizer/decimator
         EQLMS(_push)(_q->eq, v);
@@ -376,6 +457,7 @@ int SYMTRACK(_execute)(SYMTRACK()     _q,
             case SYMTRACK_EQ_CM: d_prime = d_hat/cabsf(d_hat); break;
             case SYMTRACK_EQ_DD: MODEM(_get_demodulator_sample)(_q->demod, &d_prime); break;
             default:
+                *_ny = num_outputs;
                 return liquid_error(LIQUID_EINT,"symtrack_%s_execute(), invalid equalizer strategy", EXTENSION_FULL);
             }
             EQLMS(_step)(_q->eq, d_prime, d_hat);
@@ -386,40 +468,10 @@ int SYMTRACK(_execute)(SYMTRACK()     _q,
     }
 
 #if DEBUG_SYMTRACK
-    printf("symsync wrote %u samples, %u outputs\n", nw, num_outputs);
+    printf("symsync wrote %u samples, %u outputs\n", _nx, num_outputs);
 #endif
 
     //
     *_ny = num_outputs;
     return LIQUID_OK;
 }
-
-// execute synchronizer on input data array
-//  _q      : synchronizer object
-//  _x      : input data array
-//  _nx     : number of input samples
-//  _y      : output data array
-//  _ny     : number of samples written to output buffer
-int SYMTRACK(_execute_block)(SYMTRACK()     _q,
-                             TI *           _x,
-                             unsigned int   _nx,
-                             TO *           _y,
-                             unsigned int * _ny)
-{
-    //
-    unsigned int i;
-    unsigned int num_written = 0;
-
-    //
-    for (i=0; i<_nx; i++) {
-        unsigned int nw = 0;
-        SYMTRACK(_execute)(_q, _x[i], &_y[num_written], &nw);
-
-        num_written += nw;
-    }
-
-    //
-    *_ny = num_written;
-    return LIQUID_OK;
-}
-
@@ -89,3 +89,236 @@ void autotest_flexframesync()
     flexframesync_destroy(fs);
 }
 
+
+// 
+// AUTOTEST : recover frame immediately following a truncated burst; the
+//            first demodulator is occupied by the truncated frame while a
+//            second one receives the complete frame
+//
+void autotest_flexframesync_multi()
+{
+    unsigned int i, t;
+    unsigned int payload_len = 200; // payload length (bytes)
+    unsigned int trunc_len   = 800; // length of truncated burst (samples)
+    unsigned int num_trials  = 16;  // number of random payloads to test
+
+    // create flexframegen object
+    flexframegenprops_s fgprops;
+    flexframegenprops_init_default(&fgprops);
+    fgprops.mod_scheme  = LIQUID_MODEM_QPSK;
+    fgprops.check       = LIQUID_CRC_32;
+    fgprops.fec0        = LIQUID_FEC_NONE;
+    fgprops.fec1        = LIQUID_FEC_NONE;
+    flexframegen fg = flexframegen_create(&fgprops);
+
+    // create flexframesync object with pool of two demodulators
+    flexframesync fs = flexframesync_create(NULL,NULL);
+    CONTEND_EQUALITY( flexframesync_get_num_demods(fs), 1 );
+    CONTEND_EQUALITY( flexframesync_set_num_demods(fs, 2), LIQUID_OK );
+    CONTEND_EQUALITY( flexframesync_get_num_demods(fs), 2 );
+
+    unsigned char payload[payload_len];
+    for (t=0; t<num_trials; t++) {
+        // initialize payload
+        for (i=0; i<payload_len; i++)
+            payload[i] = rand() & 0xff;
+        flexframegen_reset(fg);
+        flexframegen_assemble(fg, NULL, payload, payload_len);
+        unsigned int frame_len = flexframegen_getframelen(fg);
+
+        // generate truncated burst followed by complete frame
+        unsigned int buf_len = trunc_len + frame_len + 400;
+        float complex buf[buf_len];
+        for (i=0; i<buf_len; i++)
+            buf[i] = 0.0f;
+        flexframegen_write_samples(fg, buf, trunc_len);
+        flexframegen_reset(fg);
+        flexframegen_assemble(fg, NULL, payload, payload_len);
+        flexframegen_write_samples(fg, buf + trunc_len, frame_len);
+
+        // run through frame synchronizer
+        flexframesync_reset(fs);
+        flexframesync_reset_framedatastats(fs);
+        flexframesync_execute(fs, buf, buf_len);
+
+        // both bursts should be detected and the second recovered
+        framedatastats_s stats = flexframesync_get_framedatastats(fs);
+        if (liquid_autotest_verbose)
+            flexframesync_print(fs);
+        CONTEND_EQUALITY( stats.num_frames_detected, 2 );
+        CONTEND_EQUALITY( stats.num_payloads_valid,  1 );
+        CONTEND_EQUALITY( stats.num_bytes_received,  2*payload_len );
+        CONTEND_EQUALITY( flexframesync_is_frame_open(fs), 0 );
+    }
+
+    // destroy objects
+    flexframegen_destroy(fg);
+    flexframesync_destroy(fs);
+}
+
+// 
+// AUTOTEST : a strong frame starts in the middle of a weaker one; the
+//            second demodulator captures it while the first is still
+//            receiving the (now corrupted) payload of the weaker frame
+//
+void autotest_flexframesync_multi_overlap()
+{
+    unsigned int i, t;
+    unsigned int payload_len = 200;     // payload length (bytes)
+    float        gain        = 10.0f;   // gain of second frame relative to first
+    unsigned int num_trials  = 16;      // number of random payloads to test
+
+    // create flexframegen object
+    flexframegenprops_s fgprops;
+    flexframegenprops_init_default(&fgprops);
+    fgprops.mod_scheme  = LIQUID_MODEM_QPSK;
+    fgprops.check       = LIQUID_CRC_32;
+    fgprops.fec0        = LIQUID_FEC_NONE;
+    fgprops.fec1        = LIQUID_FEC_NONE;
+    flexframegen fg = flexframegen_create(&fgprops);
+
+    // create flexframesync object with pool of two demodulators
+    flexframesync fs = flexframesync_create(NULL,NULL);
+    CONTEND_EQUALITY( flexframesync_set_num_demods(fs, 2), LIQUID_OK );
+
+    unsigned char payload[payload_len];
+    for (t=0; t<num_trials; t++) {
+        // generate first frame
+        for (i=0; i<payload_len; i++)
+            payload[i] = rand() & 0xff;
+        flexframegen_reset(fg);
+        flexframegen_assemble(fg, NULL, payload, payload_len);
+        unsigned int frame_len = flexframegen_getframelen(fg);
+        unsigned int offset    = frame_len / 2;
+        unsigned int buf_len   = offset + frame_len + 400;
+        float complex buf[buf_len];
+        float complex frame[frame_len];
+        for (i=0; i<buf_len; i++)
+            buf[i] = 0.0f;
+        flexframegen_write_samples(fg, buf, frame_len);
+
+        // generate second frame with a new payload, starting half way
+        // through the first one
+        for (i=0; i<payload_len; i++)
+            payload[i] = rand() & 0xff;
+        flexframegen_reset(fg);
+        flexframegen_assemble(fg, NULL, payload, payload_len);
+        flexframegen_write_samples(fg, frame, frame_len);
+        for (i=0; i<frame_len; i++)
+            buf[offset + i] += gain * frame[i];
+
+        // run through frame synchronizer
+        flexframesync_reset(fs);
+        flexframesync_reset_framedatastats(fs);
+        flexframesync_execute(fs, buf, buf_len);
+
+        // both frames should be detected and the second recovered
+        framedatastats_s stats = flexframesync_get_framedatastats(fs);
+        if (liquid_autotest_verbose)
+            flexframesync_print(fs);
+        CONTEND_EQUALITY( stats.num_frames_detected, 2 );
+        CONTEND_EQUALITY( stats.num_headers_valid,   2 );
+        CONTEND_EQUALITY( stats.num_payloads_valid,  1 );
+        CONTEND_EQUALITY( flexframesync_is_frame_open(fs), 0 );
+    }
+
+    // destroy objects
+    flexframegen_destroy(fg);
+    flexframesync_destroy(fs);
+}
+
+void autotest_flexframesync_multi_invalid_config()
+{
+#if LIQUID_STRICT_EXIT
+    AUTOTEST_WARN("skipping flexframesync config test with strict exit enabled");
+    return;
+#endif
+#if !LIQUID_SUPPRESS_ERROR_OUTPUT
+    fprintf(stderr,"warning: ignore potential errors here; checking for invalid configurations\n");
+#endif
+    flexframesync fs = flexframesync_create(NULL,NULL);
+    CONTEND_INEQUALITY( flexframesync_set_num_demods(fs,  0), LIQUID_OK );
+    CONTEND_INEQUALITY( flexframesync_set_num_demods(fs, 65), LIQUID_OK );
+    CONTEND_EQUALITY  ( flexframesync_get_num_demods(fs), 1 );
+    flexframesync_destroy(fs);
+}
+
+// callback for asynchronous decoding test: check frames arrive in order
+static int autotest_flexframesync_async_callback(unsigned char *  _header,
+                                                 int              _header_valid,
+                                                 unsigned char *  _payload,
+                                                 unsigned int     _payload_len,
+                                                 int              _payload_valid,
+                                                 framesyncstats_s _stats,
+                                                 void *           _userdata)
+{
+    unsigned int * num_frames = (unsigned int*) _userdata;
+    CONTEND_EQUALITY( _header_valid,      1 );
+    CONTEND_EQUALITY( _payload_valid,     1 );
+    if (!_header_valid || !_payload_valid)
+        return 0;
+    CONTEND_EQUALITY( _header[0],         *num_frames );
+    CONTEND_EQUALITY( _payload[0],        *num_frames );
+    CONTEND_EQUALITY( _stats.num_framesyms > 0, 1 );
+    (*num_frames)++;
+    return 0;
+}
+
+// 
+// AUTOTEST : decode payloads asynchronously, delivering frames in order
+//
+void autotest_flexframesync_async()
+{
+    unsigned int i;
+    unsigned int num_frames  = 8;
+    unsigned int payload_len = 120;
+
+    // create flexframegen object with forward error correction
+    flexframegenprops_s fgprops;
+    flexframegenprops_init_default(&fgprops);
+    fgprops.mod_scheme  = LIQUID_MODEM_QPSK;
+    fgprops.check       = LIQUID_CRC_32;
+    fgprops.fec0        = LIQUID_FEC_HAMMING128;
+    fgprops.fec1        = LIQUID_FEC_NONE;
+    flexframegen fg = flexframegen_create(&fgprops);
+
+    // create flexframesync object with asynchronous decoder
+    unsigned int num_received = 0;
+    flexframesync fs = flexframesync_create(autotest_flexframesync_async_callback, &num_received);
+    flexframesync_decode_payload_soft(fs, 1);
+    CONTEND_EQUALITY( flexframesync_set_async_decode(fs, 4, 2), LIQUID_OK );
+
+    unsigned char header[14];
+    unsigned char payload[payload_len];
+    float complex buf[64];
+    unsigned int n;
+    for (n=0; n<num_frames; n++) {
+        // tag header and payload with frame number
+        for (i=0; i<14; i++)
+            header[i] = n;
+        for (i=0; i<payload_len; i++)
+            payload[i] = i==0 ? n : rand() & 0xff;
+        flexframegen_assemble(fg, header, payload, payload_len);
+
+        // generate the frame and run through synchronizer
+        int frame_complete = 0;
+        while (!frame_complete) {
+            frame_complete = flexframegen_write_samples(fg, buf, 64);
+            flexframesync_execute(fs, buf, 64);
+        }
+    }
+
+    // wait for outstanding payloads to be decoded
+    flexframesync_async_flush(fs);
+
+    // check statistics
+    framedatastats_s stats = flexframesync_get_framedatastats(fs);
+    CONTEND_EQUALITY( num_received,              num_frames );
+    CONTEND_EQUALITY( stats.num_frames_detected, num_frames );
+    CONTEND_EQUALITY( stats.num_payloads_valid,  num_frames );
+    CONTEND_EQUALITY( stats.num_bytes_received,  num_frames*payload_len );
+
+    // destroy objects
+    flexframegen_destroy(fg);
+    flexframesync_destroy(fs);
+}
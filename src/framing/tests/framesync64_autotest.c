@@ -84,3 +84,70 @@ void autotest_framesync64()
     framesync64_destroy(fs);
 }
 
+
+// 
+// AUTOTEST : a strong frame starts in the middle of a weaker one; with a
+//            pool of two demodulators the second frame is captured while
+//            the first is still being received
+//
+void autotest_framesync64_multi()
+{
+    unsigned int i, t;
+    unsigned int num_trials = 16;       // number of random frames to test
+    unsigned int offset     = LIQUID_FRAME64_LEN / 2;
+    float        gain       = 10.0f;    // gain of second frame relative to first
+
+    // create objects
+    framegen64  fg = framegen64_create();
+    framesync64 fs = framesync64_create(NULL, NULL);
+    CONTEND_EQUALITY( framesync64_get_num_demods(fs), 1 );
+    CONTEND_EQUALITY( framesync64_set_num_demods(fs, 2), LIQUID_OK );
+    CONTEND_EQUALITY( framesync64_get_num_demods(fs), 2 );
+
+    unsigned int  buf_len = offset + LIQUID_FRAME64_LEN + 400;
+    float complex buf[buf_len];
+    float complex frame[LIQUID_FRAME64_LEN];
+    for (t=0; t<num_trials; t++) {
+        // generate both frames with random header and payload
+        for (i=0; i<buf_len; i++)
+            buf[i] = 0.0f;
+        framegen64_execute(fg, NULL, NULL, buf);
+        framegen64_execute(fg, NULL, NULL, frame);
+        for (i=0; i<LIQUID_FRAME64_LEN; i++)
+            buf[offset + i] += gain * frame[i];
+
+        // run through frame synchronizer
+        framesync64_reset(fs);
+        framesync64_reset_framedatastats(fs);
+        framesync64_execute(fs, buf, buf_len);
+
+        // both frames should be detected and the second recovered
+        framedatastats_s stats = framesync64_get_framedatastats(fs);
+        if (liquid_autotest_verbose)
+            framesync64_print(fs);
+        CONTEND_EQUALITY( stats.num_frames_detected, 2 );
+        CONTEND_EQUALITY( stats.num_payloads_valid,  1 );
+        CONTEND_EQUALITY( stats.num_bytes_received, 64 );
+        CONTEND_EQUALITY( framesync64_get_num_frames_open(fs), 0 );
+    }
+
+    // destroy objects
+    framegen64_destroy(fg);
+    framesync64_destroy(fs);
+}
+
+void autotest_framesync64_multi_invalid_config()
+{
+#if LIQUID_STRICT_EXIT
+    AUTOTEST_WARN("skipping framesync64 config test with strict exit enabled");
+    return;
+#endif
+#if !LIQUID_SUPPRESS_ERROR_OUTPUT
+    fprintf(stderr,"warning: ignore potential errors here; checking for invalid configurations\n");
+#endif
+    framesync64 fs = framesync64_create(NULL,NULL);
+    CONTEND_INEQUALITY( framesync64_set_num_demods(fs,  0), LIQUID_OK );
+    CONTEND_INEQUALITY( framesync64_set_num_demods(fs, 65), LIQUID_OK );
+    CONTEND_EQUALITY  ( framesync64_get_num_demods(fs), 1 );
+    framesync64_destroy(fs);
+}
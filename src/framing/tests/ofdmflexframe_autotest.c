@@ -23,6 +23,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
 #include "autotest/autotest.h"
 #include "liquid.h"
 
@@ -90,3 +91,167 @@ void autotest_ofdmflexframe_07() { testbench_ofdmflexframe(1200, 40, 20,    1, L
 void autotest_ofdmflexframe_08() { testbench_ofdmflexframe(1200,  0,  0,  800, LIQUID_MODEM_QPSK); }
 void autotest_ofdmflexframe_09() { testbench_ofdmflexframe(1200, 40, 20, 8217, LIQUID_MODEM_QPSK); }
 
+
+// AUTOTEST : recovery of long frames through a time-varying channel whose
+// second path rotates over the frame, with per-subcarrier channel tracking
+void testbench_ofdmflexframe_chtrack(liquid_ofdmchtrack_method _method,
+                                     float                     _a,
+                                     float                     _fd)
+{
+    unsigned int M           = 64;
+    unsigned int cp_len      = 16;
+    unsigned int taper_len   = 4;
+    unsigned int payload_len = 2000;
+    unsigned int num_frames  = 4;
+
+    ofdmflexframegenprops_s fgprops;
+    ofdmflexframegenprops_init_default(&fgprops);
+    fgprops.check        = LIQUID_CRC_32;
+    fgprops.fec0         = LIQUID_FEC_NONE;
+    fgprops.fec1         = LIQUID_FEC_NONE;
+    fgprops.mod_scheme   = LIQUID_MODEM_QAM16;
+    ofdmflexframegen  fg = ofdmflexframegen_create( M, cp_len, taper_len, NULL, &fgprops);
+    ofdmflexframesync fs = ofdmflexframesync_create(M, cp_len, taper_len, NULL, NULL, NULL);
+    CONTEND_EQUALITY( ofdmflexframesync_set_chtrack_method(fs, _method), LIQUID_OK );
+
+    unsigned char header[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+    unsigned char payload[payload_len];
+
+    unsigned int  buf_len = 1024;
+    float complex buf[buf_len];
+    float complex x_prev = 0.0f;
+    unsigned int i, n, t = 0;
+    for (n=0; n<num_frames; n++) {
+        for (i=0; i<payload_len; i++)
+            payload[i] = rand() & 0xff;
+        ofdmflexframegen_assemble(fg, header, payload, payload_len);
+        float theta = 2*M_PI*randf();
+        int frame_complete = 0;
+        while (!frame_complete) {
+            frame_complete = ofdmflexframegen_write(fg, buf, buf_len);
+
+            // two-path channel, second path delayed by one sample
+            for (i=0; i<buf_len; i++) {
+                float complex x = buf[i];
+                buf[i] = x + _a*x_prev*cexpf(_Complex_I*(theta + 2*M_PI*_fd*(float)t++));
+                buf[i] += 0.01f*(randnf() + _Complex_I*randnf());
+                x_prev = x;
+            }
+            ofdmflexframesync_execute(fs, buf, buf_len);
+        }
+    }
+
+    framedatastats_s stats = ofdmflexframesync_get_framedatastats(fs);
+    CONTEND_EQUALITY( stats.num_frames_detected, num_frames );
+    CONTEND_EQUALITY( stats.num_headers_valid,   num_frames );
+    CONTEND_EQUALITY( stats.num_payloads_valid,  num_frames );
+
+    ofdmflexframegen_destroy(fg);
+    ofdmflexframesync_destroy(fs);
+}
+
+void autotest_ofdmflexframe_chtrack_pilot() { testbench_ofdmflexframe_chtrack(LIQUID_OFDMCHTRACK_PILOT, 0.2f, 2e-5f); }
+void autotest_ofdmflexframe_chtrack_dd()    { testbench_ofdmflexframe_chtrack(LIQUID_OFDMCHTRACK_DD,    0.3f, 3e-5f); }
+
+// AUTOTEST : asynchronous payload decoding of several frames
+void autotest_ofdmflexframe_async()
+{
+    unsigned int M           = 64;
+    unsigned int cp_len      = 8;
+    unsigned int taper_len   = 4;
+    unsigned int payload_len = 400;
+    unsigned int num_frames  = 4;
+
+    // create frame generator/synchronizer
+    ofdmflexframegenprops_s fgprops;
+    ofdmflexframegenprops_init_default(&fgprops);
+    fgprops.check        = LIQUID_CRC_32;
+    fgprops.fec0         = LIQUID_FEC_GOLAY2412;
+    fgprops.fec1         = LIQUID_FEC_NONE;
+    fgprops.mod_scheme   = LIQUID_MODEM_QPSK;
+    ofdmflexframegen  fg = ofdmflexframegen_create( M, cp_len, taper_len, NULL, &fgprops);
+    ofdmflexframesync fs = ofdmflexframesync_create(M, cp_len, taper_len, NULL, NULL, NULL);
+    ofdmflexframesync_decode_payload_soft(fs, 1);
+    CONTEND_EQUALITY( ofdmflexframesync_set_async_decode(fs, 2, 2), LIQUID_OK );
+
+    unsigned char header[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+    unsigned char payload[payload_len];
+    memset(payload, 0x00, payload_len);
+
+    unsigned int  buf_len = 1024;
+    float complex buf[buf_len];
+    unsigned int n;
+    for (n=0; n<num_frames; n++) {
+        ofdmflexframegen_assemble(fg, header, payload, payload_len);
+        int frame_complete = 0;
+        while (!frame_complete) {
+            frame_complete = ofdmflexframegen_write(fg, buf, buf_len);
+            ofdmflexframesync_execute(fs, buf, buf_len);
+        }
+    }
+    ofdmflexframesync_async_flush(fs);
+
+    // verify frame data statistics
+    framedatastats_s stats = ofdmflexframesync_get_framedatastats(fs);
+    CONTEND_EQUALITY( stats.num_frames_detected, num_frames );
+    CONTEND_EQUALITY( stats.num_headers_valid,   num_frames );
+    CONTEND_EQUALITY( stats.num_payloads_valid,  num_frames );
+    CONTEND_EQUALITY( stats.num_bytes_received,  num_frames*payload_len );
+
+    // destroy objects
+    ofdmflexframegen_destroy(fg);
+    ofdmflexframesync_destroy(fs);
+}
+
+// AUTOTEST : frame samples must not depend on the size of the write buffer
+void autotest_ofdmflexframe_write_chunked()
+{
+    unsigned int M           = 64;
+    unsigned int cp_len      = 16;
+    unsigned int taper_len   = 4;
+    unsigned int payload_len = 800;
+
+    ofdmflexframegenprops_s fgprops;
+    ofdmflexframegenprops_init_default(&fgprops);
+    fgprops.check        = LIQUID_CRC_32;
+    fgprops.fec0         = LIQUID_FEC_NONE;
+    fgprops.fec1         = LIQUID_FEC_NONE;
+    fgprops.mod_scheme   = LIQUID_MODEM_QAM16;
+    ofdmflexframegen fg = ofdmflexframegen_create(M, cp_len, taper_len, NULL, &fgprops);
+
+    unsigned char header[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+    unsigned char payload[payload_len];
+    unsigned int i;
+    for (i=0; i<payload_len; i++)
+        payload[i] = rand() & 0xff;
+
+    // write frame with one large buffer
+    unsigned int  num_samples = 16384;
+    float complex buf_0[num_samples];
+    float complex buf_1[num_samples];
+    memset(buf_0, 0x00, sizeof(buf_0));
+    memset(buf_1, 0x00, sizeof(buf_1));
+    srand(1);
+    ofdmflexframegen_assemble(fg, header, payload, payload_len);
+    unsigned int frame_len = ofdmflexframegen_getframelen(fg)*(M+cp_len) + taper_len;
+    CONTEND_LESS_THAN( frame_len, num_samples );
+    CONTEND_EQUALITY( ofdmflexframegen_write(fg, buf_0, num_samples), 1 );
+
+    // write same frame in small, irregular chunks
+    srand(1);
+    ofdmflexframegen_assemble(fg, header, payload, payload_len);
+    unsigned int n = 0;
+    unsigned int chunk = 1;
+    int frame_complete = 0;
+    while (!frame_complete && n < num_samples) {
+        unsigned int num = chunk < num_samples - n ? chunk : num_samples - n;
+        frame_complete = ofdmflexframegen_write(fg, buf_1 + n, num);
+        n += num;
+        chunk = (chunk * 7 + 3) % 97 + 1;
+    }
+    CONTEND_EQUALITY( frame_complete, 1 );
+
+    CONTEND_SAME_DATA( buf_0, buf_1, frame_len*sizeof(float complex) );
+
+    ofdmflexframegen_destroy(fg);
+}
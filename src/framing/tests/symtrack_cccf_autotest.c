@@ -107,6 +107,62 @@ void testbench_symtrack_cccf(unsigned int _k, unsigned int _m, float _beta, int
 void autotest_symtrack_cccf_00() { testbench_symtrack_cccf( 2, 7,0.20f,LIQUID_MODEM_BPSK); }
 void autotest_symtrack_cccf_01() { testbench_symtrack_cccf( 2, 7,0.20f,LIQUID_MODEM_QPSK); }
 
+// block execution must produce exactly the same output as running the
+// synchronizer one sample at a time
+void autotest_symtrack_cccf_block()
+{
+    unsigned int k      = 2;        // samples/symbol
+    unsigned int num_samples = 3000; // number of input samples (not a block multiple)
+
+    // generate input signal with impairments
+    float complex x[num_samples];
+    symstreamcf gen = symstreamcf_create_linear(LIQUID_FIRFILT_ARKAISER,k,7,0.3f,LIQUID_MODEM_QPSK);
+    symstreamcf_write_samples(gen, x, num_samples);
+    channel_cccf channel = channel_cccf_create();
+    channel_cccf_add_awgn          (channel, -30.0f, 20.0f);
+    channel_cccf_add_carrier_offset(channel, 0.01f, 0.7f);
+    channel_cccf_execute_block(channel, x, num_samples, x);
+
+    // create two identical synchronizers
+    symtrack_cccf q0 = symtrack_cccf_create_default();
+    symtrack_cccf q1 = symtrack_cccf_create_default();
+    symtrack_cccf_set_bandwidth(q0, 0.1f);
+    symtrack_cccf_set_bandwidth(q1, 0.1f);
+
+    // run one sample at a time
+    float complex y0[2*num_samples];
+    unsigned int  n0 = 0;
+    unsigned int i;
+    for (i=0; i<num_samples; i++) {
+        unsigned int nw;
+        symtrack_cccf_execute(q0, x[i], &y0[n0], &nw);
+        n0 += nw;
+    }
+
+    // run in blocks of irregular size
+    float complex y1[2*num_samples];
+    unsigned int  n1 = 0;
+    unsigned int  block_len = 1000;
+    for (i=0; i<num_samples; i+=block_len) {
+        unsigned int nw;
+        block_len = block_len == 1000 ? 37 : 1000;
+        unsigned int n = num_samples - i < block_len ? num_samples - i : block_len;
+        symtrack_cccf_execute_block(q1, &x[i], n, &y1[n1], &nw);
+        n1 += nw;
+    }
+
+    // compare outputs
+    CONTEND_EQUALITY(n0, n1);
+    CONTEND_GREATER_THAN(n0, num_samples/k - 10);
+    CONTEND_SAME_DATA(y0, y1, n0*sizeof(float complex));
+
+    // destroy objects
+    symstreamcf_destroy  (gen);
+    channel_cccf_destroy (channel);
+    symtrack_cccf_destroy(q0);
+    symtrack_cccf_destroy(q1);
+}
+
 // invalid configuration tests
 void autotest_symtrack_cccf_config_invalid()
 {
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2007 - 2022 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+
+#include "liquid.h"
+
+// Helper function to keep code base small; multiplies an _m x _n
+// sparse binary matrix with _w non-zero entries per row by a bit-packed
+// vector, in list (_compress=0) or compressed (_compress=1) form
+void smatrixb_vmul_packed_bench(struct rusage *     _start,
+                                struct rusage *     _finish,
+                                unsigned long int * _num_iterations,
+                                unsigned int        _m,
+                                unsigned int        _n,
+                                unsigned int        _w,
+                                int                 _compress)
+{
+    // normalize number of iterations
+    *_num_iterations = *_num_iterations * 20 / (_m * _w);
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    unsigned long int i;
+
+    // generate random parity-check-like matrix
+    smatrixb a = smatrixb_create(_m, _n);
+    for (i=0; i<_m*_w; i++)
+        smatrixb_set(a, i / _w, rand() % _n, 1);
+    if (_compress)
+        smatrixb_compress(a);
+
+    // generate packed input vector
+    unsigned char * x = (unsigned char*) malloc((_n+7)/8);
+    unsigned char * y = (unsigned char*) malloc((_m+7)/8);
+    for (i=0; i<(_n+7)/8; i++)
+        x[i] = rand() & 0xff;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        smatrixb_vmul_packed(a,x,y);
+        smatrixb_vmul_packed(a,x,y);
+        smatrixb_vmul_packed(a,x,y);
+        smatrixb_vmul_packed(a,x,y);
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= 4;
+
+    // free memory
+    smatrixb_destroy(a);
+    free(x);
+    free(y);
+}
+
+#define SMATRIXB_VMUL_PACKED_BENCHMARK_API(M,N,W,C) \
+(   struct rusage *_start,                          \
+    struct rusage *_finish,                         \
+    unsigned long int *_num_iterations)             \
+{ smatrixb_vmul_packed_bench(_start, _finish, _num_iterations, M, N, W, C); }
+
+void benchmark_smatrixb_vmul_packed_n1024              SMATRIXB_VMUL_PACKED_BENCHMARK_API( 512, 1024,  8, 0)
+void benchmark_smatrixb_vmul_packed_compressed_n1024   SMATRIXB_VMUL_PACKED_BENCHMARK_API( 512, 1024,  8, 1)
+void benchmark_smatrixb_vmul_packed_n4096              SMATRIXB_VMUL_PACKED_BENCHMARK_API(2048, 4096,  8, 0)
+void benchmark_smatrixb_vmul_packed_compressed_n4096   SMATRIXB_VMUL_PACKED_BENCHMARK_API(2048, 4096,  8, 1)
+void benchmark_smatrixb_vmul_packed_dense_n1024        SMATRIXB_VMUL_PACKED_BENCHMARK_API( 512, 1024, 128, 0)
+void benchmark_smatrixb_vmul_packed_compressed_dense_n1024 SMATRIXB_VMUL_PACKED_BENCHMARK_API( 512, 1024, 128, 1)
+
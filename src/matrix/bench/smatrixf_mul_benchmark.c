@@ -29,7 +29,8 @@
 void smatrixf_mul_bench(struct rusage *     _start,
                         struct rusage *     _finish,
                         unsigned long int * _num_iterations,
-                        unsigned int        _n)
+                        unsigned int        _n,
+                        int                 _compress)
 {
     // normalize number of iterations
     // time ~ _n ^ 3
@@ -62,6 +63,12 @@ void smatrixf_mul_bench(struct rusage *     _start,
         smatrixf_set(b, row, col, value);
     }
 
+    // optionally compress inputs
+    if (_compress) {
+        smatrixf_compress(a);
+        smatrixf_compress(b);
+    }
+
     // initialize c with first multiplication
     smatrixf_mul(a,b,c);
 
@@ -82,15 +89,87 @@ void smatrixf_mul_bench(struct rusage *     _start,
     smatrixf_destroy(c);
 }
 
-#define SMATRIXF_MUL_BENCHMARK_API(M)   \
+// Helper function for sparse matrix-vector products; _k > 1 runs the
+// block product on _k vectors at once
+void smatrixf_vmul_bench(struct rusage *     _start,
+                         struct rusage *     _finish,
+                         unsigned long int * _num_iterations,
+                         unsigned int        _n,
+                         unsigned int        _k,
+                         int                 _compress)
+{
+    // approximately 32 non-zero entries per row
+    unsigned int w   = 32;
+    unsigned int nnz = _n * w;
+
+    // normalize number of iterations
+    *_num_iterations = *_num_iterations * 50 / (nnz * _k);
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    unsigned long int i;
+
+    // generate random matrix
+    smatrixf a = smatrixf_create(_n, _n);
+    for (i=0; i<nnz; i++)
+        smatrixf_set(a, i / w, rand() % _n, randnf());
+    if (_compress)
+        smatrixf_compress(a);
+
+    // generate input vector(s)
+    float * x = (float*) malloc(_n*_k*sizeof(float));
+    float * y = (float*) malloc(_n*_k*sizeof(float));
+    for (i=0; i<_n*_k; i++)
+        x[i] = randnf();
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    if (_k == 1) {
+        for (i=0; i<(*_num_iterations); i++) {
+            smatrixf_vmul(a,x,y);
+            smatrixf_vmul(a,x,y);
+            smatrixf_vmul(a,x,y);
+            smatrixf_vmul(a,x,y);
+        }
+    } else {
+        for (i=0; i<(*_num_iterations); i++) {
+            smatrixf_vmul_block(a,x,y,_k);
+            smatrixf_vmul_block(a,x,y,_k);
+            smatrixf_vmul_block(a,x,y,_k);
+            smatrixf_vmul_block(a,x,y,_k);
+        }
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= 4;
+
+    // free memory
+    smatrixf_destroy(a);
+    free(x);
+    free(y);
+}
+
+#define SMATRIXF_MUL_BENCHMARK_API(M,C) \
 (   struct rusage *_start,              \
     struct rusage *_finish,             \
     unsigned long int *_num_iterations) \
-{ smatrixf_mul_bench(_start, _finish, _num_iterations, M); }
+{ smatrixf_mul_bench(_start, _finish, _num_iterations, M, C); }
+
+void benchmark_smatrixf_mul_n32     SMATRIXF_MUL_BENCHMARK_API( 32, 0)
+void benchmark_smatrixf_mul_n64     SMATRIXF_MUL_BENCHMARK_API( 64, 0)
+void benchmark_smatrixf_mul_n128    SMATRIXF_MUL_BENCHMARK_API(128, 0)
+void benchmark_smatrixf_mul_n256    SMATRIXF_MUL_BENCHMARK_API(256, 0)
+void benchmark_smatrixf_mul_n512    SMATRIXF_MUL_BENCHMARK_API(512, 0)
+
+void benchmark_smatrixf_mul_compressed_n128 SMATRIXF_MUL_BENCHMARK_API(128, 1)
+void benchmark_smatrixf_mul_compressed_n512 SMATRIXF_MUL_BENCHMARK_API(512, 1)
 
-void benchmark_smatrixf_mul_n32     SMATRIXF_MUL_BENCHMARK_API( 32)
-void benchmark_smatrixf_mul_n64     SMATRIXF_MUL_BENCHMARK_API( 64)
-void benchmark_smatrixf_mul_n128    SMATRIXF_MUL_BENCHMARK_API(128)
-void benchmark_smatrixf_mul_n256    SMATRIXF_MUL_BENCHMARK_API(256)
-void benchmark_smatrixf_mul_n512    SMATRIXF_MUL_BENCHMARK_API(512)
+#define SMATRIXF_VMUL_BENCHMARK_API(M,K,C)  \
+(   struct rusage *_start,                  \
+    struct rusage *_finish,                 \
+    unsigned long int *_num_iterations)     \
+{ smatrixf_vmul_bench(_start, _finish, _num_iterations, M, K, C); }
 
+void benchmark_smatrixf_vmul_n1024              SMATRIXF_VMUL_BENCHMARK_API(1024, 1, 0)
+void benchmark_smatrixf_vmul_n4096              SMATRIXF_VMUL_BENCHMARK_API(4096, 1, 0)
+void benchmark_smatrixf_vmul_compressed_n1024   SMATRIXF_VMUL_BENCHMARK_API(1024, 1, 1)
+void benchmark_smatrixf_vmul_compressed_n4096   SMATRIXF_VMUL_BENCHMARK_API(4096, 1, 1)
+void benchmark_smatrixf_vmul_block8_n4096       SMATRIXF_VMUL_BENCHMARK_API(4096, 8, 1)
@@ -24,6 +24,13 @@
 // sparse matrices
 //
 
+#if HAVE_SSE2 && HAVE_EMMINTRIN_H
+#include <emmintrin.h>  // SSE2
+#define SMATRIX_USE_SSE2 1
+#else
+#define SMATRIX_USE_SSE2 0
+#endif
+
 // sparse matrix structure
 // example: the following floating-point sparse matrix is represented
 //          with the corresponding values:
@@ -45,6 +52,20 @@
 //  max_num_mlist   :   2
 //  max_num_nlist   :   2
 //
+// Once compressed (see SMATRIX(_compress)) the same matrix is also
+// held in contiguous compressed-row (CSR) and compressed-column (CSC)
+// form and can no longer be modified:
+//
+//  row_ptr         :   { 0, 0, 1, 2, 2, 4, 4 }
+//  col_idx         :   { 1, 4, 1, 3 }
+//  row_val         :   { 2.3, 1.2, 3.4, 4.4 }
+//  col_ptr         :   { 0, 0, 2, 2, 3, 4 }
+//  row_idx         :   { 1, 4, 4, 2 }
+//  col_val         :   { 2.3, 3.4, 4.4, 1.2 }
+//
+// Binary matrices also pack each compressed row into 64-bit words
+// (row_wptr, row_widx, row_word) for the bit-packed product.
+//
 // NOTE: while this particular example does not show a particular
 //       improvement in memory use, such a case can be made for
 //       extremely large matrices which only have a few non-zero
@@ -61,11 +82,53 @@ struct SMATRIX(_s) {
     unsigned int * num_nlist;       // weight of each row, n
     unsigned int max_num_mlist;     // maximum of num_mlist
     unsigned int max_num_nlist;     // maximum of num_nlist
+
+    // compressed (immutable) form
+    int compressed;                 // compressed flag
+    unsigned int nnz;               // number of non-zero values
+    unsigned int * row_ptr;         // offset of each row in col_idx [size: M+1]
+    unsigned short int * col_idx;   // column indices, by row [size: nnz]
+    T * row_val;                    // values, by row [size: nnz]
+    unsigned int * col_ptr;         // offset of each col in row_idx [size: N+1]
+    unsigned short int * row_idx;   // row indices, by column [size: nnz]
+    T * col_val;                    // values, by column [size: nnz]
+#if SMATRIX_BOOL
+    // compressed rows packed into 64-bit words (msb first); only words
+    // holding at least one non-zero entry are kept
+    unsigned int * row_wptr;        // offset of each row in row_word [size: M+1]
+    unsigned int * row_widx;        // word index (column/64) of each packed word
+    uint64_t * row_word;            // packed row bits
+    uint64_t * x_word;              // packed input buffer [size: ceil(N/64)]
+#endif
 };
 
+// non-zero test for compression; binary matrices hold values in GF(2)
+#if SMATRIX_BOOL
+#  define SMATRIX_NONZERO(V) ((V) & 1)
+#else
+#  define SMATRIX_NONZERO(V) ((V) != 0)
+#endif
+
 int SMATRIX(_reset_max_mlist)(SMATRIX() _q);
 int SMATRIX(_reset_max_nlist)(SMATRIX() _q);
 
+// get column indices and values of row _m from either form
+static unsigned int SMATRIX(_row)(SMATRIX()                   _q,
+                                  unsigned int                _m,
+                                  const unsigned short int ** _idx,
+                                  const T **                  _val);
+
+// get row indices and values of column _n from either form
+static unsigned int SMATRIX(_col)(SMATRIX()                   _q,
+                                  unsigned int                _n,
+                                  const unsigned short int ** _idx,
+                                  const T **                  _val);
+
+// validate that matrix may be modified
+#define SMATRIX_VALIDATE_MUTABLE(Q,NAME)                                    \
+    if ((Q)->compressed)                                                    \
+        return liquid_error(LIQUID_EICONFIG,"smatrix%s_%s(), matrix is compressed and cannot be modified",EXTENSION,NAME);
+
 // create _M x _N matrix, initialized with zeros
 SMATRIX() SMATRIX(_create)(unsigned int _M,
                            unsigned int _N)
@@ -107,6 +170,22 @@ SMATRIX() SMATRIX(_create)(unsigned int _M,
     q->max_num_mlist = 0;
     q->max_num_nlist = 0;
 
+    // not yet compressed
+    q->compressed = 0;
+    q->nnz        = 0;
+    q->row_ptr    = NULL;
+    q->col_idx    = NULL;
+    q->row_val    = NULL;
+    q->col_ptr    = NULL;
+    q->row_idx    = NULL;
+    q->col_val    = NULL;
+#if SMATRIX_BOOL
+    q->row_wptr   = NULL;
+    q->row_widx   = NULL;
+    q->row_word   = NULL;
+    q->x_word     = NULL;
+#endif
+
     // return main object
     return q;
 }
@@ -155,6 +234,20 @@ int SMATRIX(_destroy)(SMATRIX() _q)
     free(_q->mvals);
     free(_q->nvals);
 
+    // free compressed form (free(NULL) is a no-op)
+    free(_q->row_ptr);
+    free(_q->col_idx);
+    free(_q->row_val);
+    free(_q->col_ptr);
+    free(_q->row_idx);
+    free(_q->col_val);
+#if SMATRIX_BOOL
+    free(_q->row_wptr);
+    free(_q->row_widx);
+    free(_q->row_word);
+    free(_q->x_word);
+#endif
+
     // free main object memory
     free(_q);
     return LIQUID_OK;
@@ -165,6 +258,8 @@ int SMATRIX(_print)(SMATRIX() _q)
 {
     printf("dims : %u %u\n", _q->M, _q->N);
     printf("max  : %u %u\n", _q->max_num_mlist, _q->max_num_nlist);
+    if (_q->compressed)
+        printf("nnz  : %u (compressed)\n", _q->nnz);
     unsigned int i;
     unsigned int j;
     printf("rows :");
@@ -256,9 +351,10 @@ int SMATRIX(_size)(SMATRIX()      _q,
 // zero all values, retaining memory allocation
 int SMATRIX(_clear)(SMATRIX() _q)
 {
+    SMATRIX_VALIDATE_MUTABLE(_q,"clear");
     unsigned int i;
     unsigned int j;
-    
+
     // clear row entries
     for (i=0; i<_q->M; i++) {
         for (j=0; j<_q->num_mlist[i]; j++) {
@@ -278,6 +374,7 @@ int SMATRIX(_clear)(SMATRIX() _q)
 // zero all values, clearing memory
 int SMATRIX(_reset)(SMATRIX() _q)
 {
+    SMATRIX_VALIDATE_MUTABLE(_q,"reset");
     unsigned int i;
     unsigned int j;
     for (i=0; i<_q->M; i++) _q->num_mlist[i] = 0;
@@ -316,6 +413,7 @@ int SMATRIX(_insert)(SMATRIX()    _q,
     // validate input
     if (_m >= _q->M || _n >= _q->N)
         return liquid_error(LIQUID_EIRANGE,"SMATRIX(_insert)(%u,%u), index exceeds matrix dimension (%u,%u)",_m, _n, _q->M, _q->N);
+    SMATRIX_VALIDATE_MUTABLE(_q,"insert");
 
     // check to see if element is already set
     if (SMATRIX(_isset)(_q,_m,_n)) {
@@ -368,6 +466,7 @@ int SMATRIX(_delete)(SMATRIX()    _q,
     // validate input
     if (_m > _q->M || _n > _q->N)
         return liquid_error(LIQUID_EIRANGE,"SMATRIX(_delete)(%u,%u), index exceeds matrix dimension (%u,%u)",_m, _n, _q->M, _q->N);
+    SMATRIX_VALIDATE_MUTABLE(_q,"delete");
 
     // check to see if element is already not set
     if (!SMATRIX(_isset)(_q,_m,_n))
@@ -381,8 +480,10 @@ int SMATRIX(_delete)(SMATRIX()    _q,
         if (_q->mlist[_m][j] == _n)
             t = j;
     }
-    for (j=t; j<_q->num_mlist[_m]-1; j++)
+    for (j=t; j<_q->num_mlist[_m]-1; j++) {
         _q->mlist[_m][j] = _q->mlist[_m][j+1];
+        _q->mvals[_m][j] = _q->mvals[_m][j+1];
+    }
 
     // remove value from nlist (shift left)
     t = 0;
@@ -390,8 +491,10 @@ int SMATRIX(_delete)(SMATRIX()    _q,
         if (_q->nlist[_n][i] == _m)
             t = i;
     }
-    for (i=t; i<_q->num_nlist[_n]-1; i++)
+    for (i=t; i<_q->num_nlist[_n]-1; i++) {
         _q->nlist[_n][i] = _q->nlist[_n][i+1];
+        _q->nvals[_n][i] = _q->nvals[_n][i+1];
+    }
 
     // reduce sizes
     _q->num_mlist[_m]--;
@@ -400,6 +503,8 @@ int SMATRIX(_delete)(SMATRIX()    _q,
     // reallocate
     _q->mlist[_m] = (unsigned short int*) realloc(_q->mlist[_m], _q->num_mlist[_m]*sizeof(unsigned short int));
     _q->nlist[_n] = (unsigned short int*) realloc(_q->nlist[_n], _q->num_nlist[_n]*sizeof(unsigned short int));
+    _q->mvals[_m] = (T*) realloc(_q->mvals[_m], _q->num_mlist[_m]*sizeof(T));
+    _q->nvals[_n] = (T*) realloc(_q->nvals[_n], _q->num_nlist[_n]*sizeof(T));
 
     // reset maxima
     if (_q->max_num_mlist == _q->num_mlist[_m]+1)
@@ -419,6 +524,7 @@ int SMATRIX(_set)(SMATRIX()    _q,
     // validate input
     if (_m >= _q->M || _n >= _q->N)
         return liquid_error(LIQUID_EIRANGE,"SMATRIX(_set)(%u,%u), index exceeds matrix dimension (%u,%u)",_m, _n, _q->M, _q->N);
+    SMATRIX_VALIDATE_MUTABLE(_q,"set");
 
     // insert new element if not already allocated
     if (!SMATRIX(_isset)(_q,_m,_n))
@@ -459,9 +565,31 @@ T SMATRIX(_get)(SMATRIX()    _q,
     return 0;
 }
 
+// get column indices of the non-zero values in a row
+//  _q      :   sparse matrix object
+//  _m      :   row index
+//  _idx    :   output column indices [size: at most _q->N x 1]
+//  _num    :   number of non-zero values in row
+int SMATRIX(_get_row)(SMATRIX()      _q,
+                      unsigned int   _m,
+                      unsigned int * _idx,
+                      unsigned int * _num)
+{
+    // validate input
+    if (_m >= _q->M)
+        return liquid_error(LIQUID_EIRANGE,"SMATRIX(_get_row)(%u), index exceeds matrix dimension (%u,%u)",_m, _q->M, _q->N);
+
+    unsigned int j;
+    for (j=0; j<_q->num_mlist[_m]; j++)
+        _idx[j] = _q->mlist[_m][j];
+    *_num = _q->num_mlist[_m];
+    return LIQUID_OK;
+}
+
 // initialize to identity matrix
 int SMATRIX(_eye)(SMATRIX() _q)
 {
+    SMATRIX_VALIDATE_MUTABLE(_q,"eye");
     // reset all elements
     SMATRIX(_reset)(_q);
 
@@ -481,6 +609,7 @@ int SMATRIX(_mul)(SMATRIX() _a,
     // validate input
     if (_c->M != _a->M || _c->N != _b->N || _a->N != _b->M)
         return liquid_error(LIQUID_EIRANGE,"SMATRIX(_mul)(), invalid dimensions");
+    SMATRIX_VALIDATE_MUTABLE(_c,"mul");
 
     // clear output matrix (retain memory allocation)
     SMATRIX(_clear)(_c);
@@ -493,8 +622,10 @@ int SMATRIX(_mul)(SMATRIX() _a,
 
     for (r=0; r<_c->M; r++) {
         
-        // find number of non-zero entries in row 'r' of matrix '_a'
-        unsigned int nnz_a_row = _a->num_mlist[r];
+        // find non-zero entries in row 'r' of matrix '_a'
+        const unsigned short int * a_idx;
+        const T *                  a_val;
+        unsigned int nnz_a_row = SMATRIX(_row)(_a, r, &a_idx, &a_val);
 
         // if this number is zero, there will not be any non-zero
         // entries in the corresponding row of the output matrix '_c'
@@ -503,8 +634,10 @@ int SMATRIX(_mul)(SMATRIX() _a,
         
         for (c=0; c<_c->N; c++) {
 
-            // find number of non-zero entries in column 'c' of matrix '_b'
-            unsigned int nnz_b_col = _b->num_nlist[c];
+            // find non-zero entries in column 'c' of matrix '_b'
+            const unsigned short int * b_idx;
+            const T *                  b_val;
+            unsigned int nnz_b_col = SMATRIX(_col)(_b, c, &b_idx, &b_val);
 
             T p = 0;
             int set_value = 0;
@@ -515,11 +648,11 @@ int SMATRIX(_mul)(SMATRIX() _a,
             j=0;    // reset array index for cols of '_b'
             while (i < nnz_a_row && j < nnz_b_col) {
                 // 
-                unsigned int ca = _a->mlist[r][i];
-                unsigned int rb = _b->nlist[c][j];
+                unsigned int ca = a_idx[i];
+                unsigned int rb = b_idx[j];
                 if (ca == rb) {
                     // match found between _a[r,ca] and _b[rb,c]
-                    p += _a->mvals[r][i] * _b->nvals[c][j];
+                    p += a_val[i] * b_val[j];
                     set_value = 1;
                     i++;
                     j++;
@@ -555,29 +688,203 @@ int SMATRIX(_vmul)(SMATRIX() _q,
     unsigned int i;
     unsigned int j;
     
-    // initialize to zero
-    for (i=0; i<_q->M; i++)
-        _y[i] = 0;
-
     for (i=0; i<_q->M; i++) {
 
-        // running total
+        // only compute multiplications on non-zero entries
+        const unsigned short int * idx;
+        const T *                  val;
+        unsigned int n = SMATRIX(_row)(_q, i, &idx, &val);
+
+#if SMATRIX_BOOL
+        // accumulate parity of selected input bits
         T p = 0;
+        for (j=0; j<n; j++)
+            p ^= val[j] & _x[ idx[j] ];
+        _y[i] = p & 1;
+#elif SMATRIX_FLOAT && SMATRIX_USE_SSE2
+        // four products at a time, gathering inputs from column indices
+        __m128 s = _mm_setzero_ps();
+        for (j=0; j+4<=n; j+=4) {
+            __m128 v = _mm_loadu_ps(&val[j]);
+            __m128 x = _mm_set_ps(_x[idx[j+3]], _x[idx[j+2]],
+                                  _x[idx[j+1]], _x[idx[j  ]]);
+            s = _mm_add_ps(s, _mm_mul_ps(v, x));
+        }
+        // add upper and lower halves, then the remaining pair
+        s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+        s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 0x55));
+        T p = _mm_cvtss_f32(s);
+        for ( ; j<n; j++)
+            p += val[j] * _x[ idx[j] ];
+        _y[i] = p;
+#else
+        // running total, split to break dependency chain
+        T p0 = 0;
+        T p1 = 0;
+        for (j=0; j+2<=n; j+=2) {
+            p0 += val[j  ] * _x[ idx[j  ] ];
+            p1 += val[j+1] * _x[ idx[j+1] ];
+        }
+        if (j < n)
+            p0 += val[j] * _x[ idx[j] ];
+        _y[i] = p0 + p1;
+#endif
+    }
+    return LIQUID_OK;
+}
 
-        // only compute multiplications on non-zero entries
-        for (j=0; j<_q->num_mlist[i]; j++)
-            p += _q->mvals[i][j] * _x[ _q->mlist[i][j] ];
+// multiply by block of vectors
+//  _q      :   sparse matrix
+//  _x      :   input vectors, row-major [size: _N x _num]
+//  _y      :   output vectors, row-major [size: _M x _num]
+//  _num    :   number of vectors (columns of _x and _y)
+int SMATRIX(_vmul_block)(SMATRIX()    _q,
+                         T *          _x,
+                         T *          _y,
+                         unsigned int _num)
+{
+    unsigned int i;
+    unsigned int j;
+    unsigned int k;
 
-        // set output value appropriately
+    for (i=0; i<_q->M; i++) {
+        T * y = &_y[i*_num];
+
+        // initialize to zero
+        for (k=0; k<_num; k++)
+            y[k] = 0;
+
+        // accumulate scaled rows of input for non-zero entries
+        const unsigned short int * idx;
+        const T *                  val;
+        unsigned int n = SMATRIX(_row)(_q, i, &idx, &val);
+        for (j=0; j<n; j++) {
+            const T * x = &_x[idx[j]*_num];
+            T v = val[j];
 #if SMATRIX_BOOL
-        _y[i] = p % 2;
+            if ((v & 1) == 0)
+                continue;
+            for (k=0; k<_num; k++)
+                y[k] ^= x[k];
 #else
-        _y[i] = p;
+            k = 0;
+#  if SMATRIX_FLOAT && SMATRIX_USE_SSE2
+            __m128 vv = _mm_set1_ps(v);
+            for ( ; k+4<=_num; k+=4) {
+                __m128 yv = _mm_loadu_ps(&y[k]);
+                yv = _mm_add_ps(yv, _mm_mul_ps(vv, _mm_loadu_ps(&x[k])));
+                _mm_storeu_ps(&y[k], yv);
+            }
+#  endif
+            for ( ; k<_num; k++)
+                y[k] += v * x[k];
 #endif
+        }
+
+#if SMATRIX_BOOL
+        // keep result in GF(2)
+        for (k=0; k<_num; k++)
+            y[k] &= 1;
+#endif
+    }
+    return LIQUID_OK;
+}
+
+// compress matrix into contiguous row/column form; the matrix is
+// immutable afterwards and zero-valued entries are dropped
+int SMATRIX(_compress)(SMATRIX() _q)
+{
+    if (_q->compressed)
+        return LIQUID_OK;
+
+    unsigned int i;
+    unsigned int j;
+
+    // count non-zero values
+    unsigned int nnz = 0;
+    for (i=0; i<_q->M; i++) {
+        for (j=0; j<_q->num_mlist[i]; j++)
+            nnz += SMATRIX_NONZERO(_q->mvals[i][j]) ? 1 : 0;
+    }
+
+    // allocate memory (at least one element so pointers are valid)
+    unsigned int nmax = nnz > 0 ? nnz : 1;
+    _q->row_ptr = (unsigned int*)       malloc((_q->M+1)*sizeof(unsigned int));
+    _q->col_idx = (unsigned short int*) malloc(nmax*sizeof(unsigned short int));
+    _q->row_val = (T*)                  malloc(nmax*sizeof(T));
+    _q->col_ptr = (unsigned int*)       malloc((_q->N+1)*sizeof(unsigned int));
+    _q->row_idx = (unsigned short int*) malloc(nmax*sizeof(unsigned short int));
+    _q->col_val = (T*)                  malloc(nmax*sizeof(T));
+
+    // rows (lists are already sorted by column index)
+    unsigned int k = 0;
+    for (i=0; i<_q->M; i++) {
+        _q->row_ptr[i] = k;
+        for (j=0; j<_q->num_mlist[i]; j++) {
+            if (!SMATRIX_NONZERO(_q->mvals[i][j]))
+                continue;
+            _q->col_idx[k] = _q->mlist[i][j];
+            _q->row_val[k] = _q->mvals[i][j];
+            k++;
+        }
     }
+    _q->row_ptr[_q->M] = k;
+
+    // columns (lists are already sorted by row index)
+    k = 0;
+    for (j=0; j<_q->N; j++) {
+        _q->col_ptr[j] = k;
+        for (i=0; i<_q->num_nlist[j]; i++) {
+            if (!SMATRIX_NONZERO(_q->nvals[j][i]))
+                continue;
+            _q->row_idx[k] = _q->nlist[j][i];
+            _q->col_val[k] = _q->nvals[j][i];
+            k++;
+        }
+    }
+    _q->col_ptr[_q->N] = k;
+
+#if SMATRIX_BOOL
+    // pack rows into 64-bit words; count words with non-zero entries
+    // (column indices within a row are sorted)
+    unsigned int nw = 0;
+    for (i=0; i<_q->M; i++) {
+        for (k=_q->row_ptr[i]; k<_q->row_ptr[i+1]; k++) {
+            if (k == _q->row_ptr[i] || (_q->col_idx[k]>>6) != (_q->col_idx[k-1]>>6))
+                nw++;
+        }
+    }
+    unsigned int wmax = nw > 0 ? nw : 1;
+    _q->row_wptr = (unsigned int*) malloc((_q->M+1)*sizeof(unsigned int));
+    _q->row_widx = (unsigned int*) malloc(wmax*sizeof(unsigned int));
+    _q->row_word = (uint64_t*)     malloc(wmax*sizeof(uint64_t));
+    _q->x_word   = (uint64_t*)     malloc(((_q->N+63)/64)*sizeof(uint64_t));
+    unsigned int w = 0;
+    for (i=0; i<_q->M; i++) {
+        _q->row_wptr[i] = w;
+        for (k=_q->row_ptr[i]; k<_q->row_ptr[i+1]; k++) {
+            unsigned int c = _q->col_idx[k];
+            if (k == _q->row_ptr[i] || (c>>6) != (_q->col_idx[k-1]>>6)) {
+                _q->row_widx[w] = c >> 6;
+                _q->row_word[w] = 0;
+                w++;
+            }
+            _q->row_word[w-1] |= (uint64_t)1 << (63 - (c & 63));
+        }
+    }
+    _q->row_wptr[_q->M] = w;
+#endif
+
+    _q->nnz        = nnz;
+    _q->compressed = 1;
     return LIQUID_OK;
 }
 
+// determine if matrix has been compressed
+int SMATRIX(_is_compressed)(SMATRIX() _q)
+{
+    return _q->compressed;
+}
 
 // 
 // internal methods
@@ -609,3 +916,36 @@ int SMATRIX(_reset_max_nlist)(SMATRIX() _q)
     return LIQUID_OK;
 }
 
+// get column indices and values of row _m from either form
+static unsigned int SMATRIX(_row)(SMATRIX()                   _q,
+                                  unsigned int                _m,
+                                  const unsigned short int ** _idx,
+                                  const T **                  _val)
+{
+    if (_q->compressed) {
+        unsigned int k = _q->row_ptr[_m];
+        *_idx = &_q->col_idx[k];
+        *_val = &_q->row_val[k];
+        return _q->row_ptr[_m+1] - k;
+    }
+    *_idx = _q->mlist[_m];
+    *_val = _q->mvals[_m];
+    return _q->num_mlist[_m];
+}
+
+// get row indices and values of column _n from either form
+static unsigned int SMATRIX(_col)(SMATRIX()                   _q,
+                                  unsigned int                _n,
+                                  const unsigned short int ** _idx,
+                                  const T **                  _val)
+{
+    if (_q->compressed) {
+        unsigned int k = _q->col_ptr[_n];
+        *_idx = &_q->row_idx[k];
+        *_val = &_q->col_val[k];
+        return _q->col_ptr[_n+1] - k;
+    }
+    *_idx = _q->nlist[_n];
+    *_val = _q->nvals[_n];
+    return _q->num_nlist[_n];
+}
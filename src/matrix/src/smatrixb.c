@@ -27,6 +27,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <stdint.h>
 #include "liquid.internal.h"
 
 // name-mangling macro
@@ -78,11 +79,16 @@ int smatrixb_mulf(smatrixb     _A,
     //
     for (i=0; i<_A->M; i++) {
         // find non-zero column entries in this row
+        const unsigned short int * idx;
+        const unsigned char *      val;
+        unsigned int n = smatrixb_row(_A, i, &idx, &val);
         unsigned int p;
-        for (p=0; p<_A->num_mlist[i]; p++) {
+        for (p=0; p<n; p++) {
+            if ((val[p] & 1) == 0)
+                continue;
             for (j=0; j<_ny; j++) {
-                //_y(i,j) += _x( _A->mlist[i][p], j);
-                _y[i*_ny + j] += _x[ _A->mlist[i][p]*_nx + j];
+                //_y(i,j) += _x( idx[p], j);
+                _y[i*_ny + j] += _x[ idx[p]*_nx + j];
             }
         }
     }
@@ -102,13 +108,65 @@ int smatrixb_vmulf(smatrixb _q,
     
     for (i=0; i<_q->M; i++) {
 
-        // reset total
-        _y[i] = 0.0f;
+        // find non-zero column entries in this row
+        const unsigned short int * idx;
+        const unsigned char *      val;
+        unsigned int n = smatrixb_row(_q, i, &idx, &val);
 
         // only accumulate values on non-zero entries
-        for (j=0; j<_q->num_mlist[i]; j++)
-            _y[i] += _x[ _q->mlist[i][j] ];
+        float p = 0.0f;
+        for (j=0; j<n; j++)
+            p += (val[j] & 1) ? _x[ idx[j] ] : 0.0f;
+        _y[i] = p;
     }
     return LIQUID_OK;
 }
 
+// multiply sparse binary matrix by bit-packed vector in GF(2)
+//  _q  :   sparse matrix
+//  _x  :   input vector, packed msb first [size: ceil(_N/8) x 1]
+//  _y  :   output vector, packed msb first [size: ceil(_M/8) x 1]
+int smatrixb_vmul_packed(smatrixb        _q,
+                         unsigned char * _x,
+                         unsigned char * _y)
+{
+    unsigned int i;
+    unsigned int j;
+
+    // clear output, including unused bits in last byte
+    memset(_y, 0x00, (_q->M + 7) / 8);
+
+    if (!_q->compressed) {
+        // list form may hold explicit zeros: accumulate parity of
+        // selected input bits one entry at a time
+        for (i=0; i<_q->M; i++) {
+            const unsigned short int * idx = _q->mlist[i];
+            const unsigned char *      val = _q->mvals[i];
+            unsigned char p = 0;
+            for (j=0; j<_q->num_mlist[i]; j++)
+                p ^= val[j] & (_x[idx[j] >> 3] >> (7 - (idx[j] & 7)));
+            _y[i >> 3] |= (p & 1) << (7 - (i & 7));
+        }
+        return LIQUID_OK;
+    }
+
+    // pack input into 64-bit words, msb first
+    unsigned int nb = (_q->N +  7) /  8;
+    unsigned int nw = (_q->N + 63) / 64;
+    for (i=0; i<nw; i++) {
+        uint64_t v = 0;
+        for (j=8*i; j<8*i+8; j++)
+            v = (v << 8) | (j < nb ? _x[j] : 0);
+        _q->x_word[i] = v;
+    }
+
+    // each output bit is the parity of (row AND x); parity is linear
+    // so the row's words are combined before a single parity count
+    for (i=0; i<_q->M; i++) {
+        uint64_t v = 0;
+        for (j=_q->row_wptr[i]; j<_q->row_wptr[i+1]; j++)
+            v ^= _q->row_word[j] & _q->x_word[_q->row_widx[j]];
+        _y[i >> 3] |= liquid_count_ones_mod2_uint64(v) << (7 - (i & 7));
+    }
+    return LIQUID_OK;
+}
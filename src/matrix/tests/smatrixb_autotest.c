@@ -21,6 +21,7 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 
 #include "autotest/autotest.h"
 #include "liquid.internal.h"
@@ -365,3 +366,76 @@ void autotest_smatrixb_vmulf()
     smatrixb_destroy(A);
 }
 
+
+// test sparse binary matrix multiplication with bit-packed vectors
+void autotest_smatrixb_vmul_packed()
+{
+    // random parity-check-like matrix, checked against unpacked product
+    unsigned int M = 37;
+    unsigned int N = 83;
+    smatrixb A = smatrixb_create(M,N);
+    unsigned int i;
+    unsigned int j;
+    for (i=0; i<M; i++) {
+        for (j=0; j<N; j++) {
+            if (randf() < 0.1f)
+                smatrixb_set(A,i,j,1);
+        }
+    }
+    // explicit zero entry in list form is ignored by the product
+    smatrixb_set(A,M-1,N-1,1);
+    smatrixb_set(A,M-1,N-1,0);
+
+    // generate vectors
+    unsigned char x[N];
+    for (j=0; j<N; j++)
+        x[j] = rand() & 1;
+    // pack input, msb first (bit j in byte j/8)
+    unsigned char x_packed[(N+7)/8];
+    memset(x_packed, 0x00, (N+7)/8);
+    for (j=0; j<N; j++)
+        x_packed[j/8] |= x[j] << (7 - (j%8));
+
+    // compute reference
+    unsigned char y_test[M];
+    smatrixb_vmul(A,x,y_test);
+
+    // list form, then compressed form
+    unsigned int k;
+    for (k=0; k<2; k++) {
+        if (k==1)
+            smatrixb_compress(A);
+
+        unsigned char y_packed[(M+7)/8];
+        smatrixb_vmul_packed(A,x_packed,y_packed);
+        unsigned char y[8*((M+7)/8)];
+        for (i=0; i<8*((M+7)/8); i++)
+            y[i] = (y_packed[i/8] >> (7 - (i%8))) & 1;
+        for (i=0; i<M; i++)
+            CONTEND_EQUALITY( y[i], y_test[i] );
+        // unused bits in last byte are cleared
+        for (i=M; i<8*((M+7)/8); i++)
+            CONTEND_EQUALITY( y[i], 0 );
+
+        // unpacked product is unchanged by compression
+        smatrixb_vmul(A,x,y);
+        for (i=0; i<M; i++)
+            CONTEND_EQUALITY( y[i], y_test[i] );
+    }
+
+    // block product on 3 copies of the input; columns must match
+    unsigned char X[N*3];
+    unsigned char Y[M*3];
+    for (j=0; j<N; j++) {
+        X[3*j+0] = x[j];
+        X[3*j+1] = 1 - x[j];
+        X[3*j+2] = x[j];
+    }
+    smatrixb_vmul_block(A,X,Y,3);
+    for (i=0; i<M; i++) {
+        CONTEND_EQUALITY( Y[3*i+0], y_test[i] );
+        CONTEND_EQUALITY( Y[3*i+2], y_test[i] );
+    }
+
+    smatrixb_destroy(A);
+}
@@ -125,3 +125,124 @@ void autotest_smatrixf_mul()
     smatrixf_destroy(b);
     smatrixf_destroy(c);
 }
+
+// test compressed form against list form on random matrix
+void autotest_smatrixf_compress()
+{
+    float tol = 1e-4f;
+    unsigned int M = 24;
+    unsigned int N = 40;
+    unsigned int K = 7;     // number of vectors for block product
+
+    // create random sparse matrices with about 20% density; 'b' is
+    // compressed, 'a' stays in list form
+    smatrixf a = smatrixf_create(M, N);
+    smatrixf b = smatrixf_create(M, N);
+    unsigned int i;
+    unsigned int j;
+    for (i=0; i<M; i++) {
+        for (j=0; j<N; j++) {
+            if (randf() < 0.2f) {
+                float v = randnf();
+                smatrixf_set(a, i, j, v);
+                smatrixf_set(b, i, j, v);
+            }
+        }
+    }
+    // explicit zero should be dropped without changing results
+    smatrixf_set(a, 3, 5, 0.0f);
+    smatrixf_set(b, 3, 5, 0.0f);
+    CONTEND_EQUALITY( smatrixf_is_compressed(b), 0 );
+    smatrixf_compress(b);
+    CONTEND_EQUALITY( smatrixf_is_compressed(b), 1 );
+
+    // values are still accessible
+    for (i=0; i<M; i++) {
+        for (j=0; j<N; j++)
+            CONTEND_EQUALITY( smatrixf_get(a,i,j), smatrixf_get(b,i,j) );
+    }
+
+    // vector product
+    float x[N*K];
+    for (i=0; i<N*K; i++)
+        x[i] = randnf();
+    float y0[M], y1[M];
+    smatrixf_vmul(a, x, y0);
+    smatrixf_vmul(b, x, y1);
+    for (i=0; i<M; i++)
+        CONTEND_DELTA( y0[i], y1[i], tol );
+
+    // block product: each column must match single vector product
+    float Y0[M*K], Y1[M*K];
+    smatrixf_vmul_block(a, x, Y0, K);
+    smatrixf_vmul_block(b, x, Y1, K);
+    for (j=0; j<K; j++) {
+        float xj[N];
+        for (i=0; i<N; i++)
+            xj[i] = x[i*K + j];
+        smatrixf_vmul(a, xj, y0);
+        for (i=0; i<M; i++) {
+            CONTEND_DELTA( Y0[i*K+j], y0[i], tol );
+            CONTEND_DELTA( Y1[i*K+j], y0[i], tol );
+        }
+    }
+
+    // matrix product with compressed operands: c = a * b^T
+    smatrixf bt = smatrixf_create(N, M);
+    for (i=0; i<M; i++) {
+        for (j=0; j<N; j++) {
+            if (smatrixf_isset(a,i,j))
+                smatrixf_set(bt, j, i, smatrixf_get(a,i,j));
+        }
+    }
+    smatrixf c0 = smatrixf_create(M, M);
+    smatrixf c1 = smatrixf_create(M, M);
+    smatrixf_mul(a, bt, c0);
+    smatrixf_compress(bt);
+    smatrixf_mul(b, bt, c1);
+    for (i=0; i<M; i++) {
+        for (j=0; j<M; j++)
+            CONTEND_DELTA( smatrixf_get(c0,i,j), smatrixf_get(c1,i,j), tol );
+    }
+
+    smatrixf_destroy(a);
+    smatrixf_destroy(b);
+    smatrixf_destroy(bt);
+    smatrixf_destroy(c0);
+    smatrixf_destroy(c1);
+}
+
+// compressed matrix cannot be modified
+void autotest_smatrixf_compress_immutable()
+{
+#if LIQUID_STRICT_EXIT
+    AUTOTEST_WARN("skipping smatrixf_compress_immutable test with strict exit enabled\n");
+    return;
+#endif
+#if !LIQUID_SUPPRESS_ERROR_OUTPUT
+    fprintf(stderr,"warning: ignore potential errors here; checking for invalid configurations\n");
+#endif
+    smatrixf a = smatrixf_create(4, 5);
+    smatrixf_set(a, 0, 4, 4);
+    smatrixf_compress(a);
+    // compressing again has no effect
+    CONTEND_EQUALITY( smatrixf_compress(a), LIQUID_OK );
+
+    CONTEND_INEQUALITY( smatrixf_set   (a, 1, 1, 2), LIQUID_OK );
+    CONTEND_INEQUALITY( smatrixf_insert(a, 1, 1, 2), LIQUID_OK );
+    CONTEND_INEQUALITY( smatrixf_delete(a, 0, 4),    LIQUID_OK );
+    CONTEND_INEQUALITY( smatrixf_clear (a),          LIQUID_OK );
+    CONTEND_INEQUALITY( smatrixf_reset (a),          LIQUID_OK );
+    CONTEND_INEQUALITY( smatrixf_eye   (a),          LIQUID_OK );
+
+    // output of product must be mutable
+    smatrixf b = smatrixf_create(5, 5);
+    CONTEND_INEQUALITY( smatrixf_mul(a, b, a), LIQUID_OK );
+
+    // original value is retained
+    CONTEND_EQUALITY( smatrixf_get(a, 0, 4), 4.0f );
+    CONTEND_EQUALITY( smatrixf_get(a, 1, 1), 0.0f );
+
+    smatrixf_destroy(a);
+    smatrixf_destroy(b);
+}
@@ -121,3 +121,48 @@ void autotest_smatrixi_mul()
     smatrixi_destroy(b);
     smatrixi_destroy(c);
 }
+
+// test compressed sparse integer vector and block multiplication
+void autotest_smatrixi_vmul_compressed()
+{
+    // A = [
+    //  0 0 0 0 4
+    //  0 0 0 0 0
+    //  0 0 0 3 0
+    //  2 0 0 0 1
+    smatrixi A = smatrixi_create(4, 5);
+    smatrixi_set(A, 0,4, 4);
+    smatrixi_set(A, 2,3, 3);
+    smatrixi_set(A, 3,0, 2);
+    smatrixi_set(A, 3,4, 0);
+    smatrixi_set(A, 3,4, 1);
+    smatrixi_compress(A);
+
+    // two input vectors: {7,1,5,2,2} and {1,2,3,4,5} as columns
+    short int x[10] = {7, 1,
+                       1, 2,
+                       5, 3,
+                       2, 4,
+                       2, 5};
+    short int y_test[8] = { 8, 20,
+                            0,  0,
+                            6, 12,
+                           16,  7};
+    short int y[8];
+
+    // vector product on first column
+    short int x0[5] = {7, 1, 5, 2, 2};
+    smatrixi_vmul(A,x0,y);
+    CONTEND_EQUALITY( y[0], y_test[0] );
+    CONTEND_EQUALITY( y[1], y_test[2] );
+    CONTEND_EQUALITY( y[2], y_test[4] );
+    CONTEND_EQUALITY( y[3], y_test[6] );
+
+    // block product
+    smatrixi_vmul_block(A,x,y,2);
+    unsigned int i;
+    for (i=0; i<8; i++)
+        CONTEND_EQUALITY( y[i], y_test[i] );
+
+    smatrixi_destroy(A);
+}
@@ -30,7 +30,14 @@
 (   struct rusage *     _start,             \
     struct rusage *     _finish,            \
     unsigned long int * _num_iterations)    \
-{ fskdem_bench(_start, _finish, _num_iterations, m, k, bandwidth); }
+{ fskdem_bench(_start, _finish, _num_iterations, m, k, bandwidth, -1); }
+
+// force demodulation method: full FFT (0) or tone bank (1)
+#define FSKDEM_BENCH_METHOD_API(m,k,bandwidth,method)   \
+(   struct rusage *     _start,                         \
+    struct rusage *     _finish,                        \
+    unsigned long int * _num_iterations)                \
+{ fskdem_bench(_start, _finish, _num_iterations, m, k, bandwidth, method); }
 
 // Helper function to keep code base small
 void fskdem_bench(struct rusage *     _start,
@@ -38,7 +45,8 @@ void fskdem_bench(struct rusage *     _start,
                   unsigned long int * _num_iterations,
                   unsigned int        _m,
                   unsigned int        _k,
-                  float               _bandwidth)
+                  float               _bandwidth,
+                  int                 _method)
 {
     // normalize number of iterations
     *_num_iterations /= _k;
@@ -47,6 +55,8 @@ void fskdem_bench(struct rusage *     _start,
 
     // initialize demodulator
     fskdem dem = fskdem_create(_m,_k,_bandwidth);
+    if (_method >= 0)
+        fskdem_set_tone_bank(dem, _method);
 
     //unsigned int M = 1 << _m;   // constellation size
     
@@ -101,3 +111,14 @@ void benchmark_fskdem_misc_M256    FSKDEM_BENCH_API( 8,  500, 0.3721451)
 void benchmark_fskdem_misc_M512    FSKDEM_BENCH_API( 9, 1000, 0.3721451)
 void benchmark_fskdem_misc_M1024   FSKDEM_BENCH_API(10, 2000, 0.3721451)
 
+// BENCHMARKS: full FFT versus tone bank
+void benchmark_fskdem_fft_M2_k64      FSKDEM_BENCH_METHOD_API( 1,   64, 0.25f, 0)
+void benchmark_fskdem_bank_M2_k64     FSKDEM_BENCH_METHOD_API( 1,   64, 0.25f, 1)
+void benchmark_fskdem_fft_M4_k256     FSKDEM_BENCH_METHOD_API( 2,  256, 0.25f, 0)
+void benchmark_fskdem_bank_M4_k256    FSKDEM_BENCH_METHOD_API( 2,  256, 0.25f, 1)
+void benchmark_fskdem_fft_M16_k32     FSKDEM_BENCH_METHOD_API( 4,   32, 0.25f, 0)
+void benchmark_fskdem_bank_M16_k32    FSKDEM_BENCH_METHOD_API( 4,   32, 0.25f, 1)
+void benchmark_fskdem_fft_M64_k128    FSKDEM_BENCH_METHOD_API( 6,  128, 0.25f, 0)
+void benchmark_fskdem_bank_M64_k128   FSKDEM_BENCH_METHOD_API( 6,  128, 0.25f, 1)
+void benchmark_fskdem_fft_M8_k20      FSKDEM_BENCH_METHOD_API( 3,   20, 0.3721451, 0)
+void benchmark_fskdem_bank_M8_k20     FSKDEM_BENCH_METHOD_API( 3,   20, 0.3721451, 1)
@@ -33,10 +33,22 @@
 
 #define DEBUG_FSKDEM 0
 
+// use tone bank when M*k <= FSKDEM_BANK_THRESHOLD * K*log2(K); the
+// internal FFT is considerably slower than FFTW so the bank wins over a
+// wider range of parameters
+#if HAVE_FFTW3_H && !defined LIQUID_FFTOVERRIDE
+#  define FSKDEM_BANK_THRESHOLD (2)
+#else
+#  define FSKDEM_BANK_THRESHOLD (8)
+#endif
+
 // 
 // internal methods
 //
 
+// get value of FFT bin for most recent symbol, computing it if necessary
+float complex fskdem_get_bin(fskdem _q, unsigned int _index);
+
 // fskdem
 struct fskdem_s {
     // common
@@ -53,6 +65,13 @@ struct fskdem_s {
     FFT_PLAN        fft;        // FFT object
     unsigned int *  demod_map;  // demodulation map
 
+    // tone bank: compute only the bins needed rather than the full FFT
+    int             use_bank;   // tone bank enabled?
+    dotprod_cccf *  bank;       // one dot product per tone, [size: M x 1]
+    float complex * twiddle;    // exp(-j 2 pi i / K), [size: K x 1]
+    unsigned int *  bin_gen;    // symbol count for which each bin is valid
+    unsigned int    gen;        // symbol count
+
     // state variables
     unsigned int    s_demod;    // demodulated symbol (used for frequency error)
 };
@@ -141,6 +160,24 @@ fskdem fskdem_create(unsigned int _m,
     q->buf_freq = (float complex*) malloc(q->K * sizeof(float complex));
     q->fft = FFT_CREATE_PLAN(q->K, q->buf_time, q->buf_freq, FFT_DIR_FORWARD, 0);
 
+    // create tone bank: a direct transform of each tone's bin costs M*k
+    // multiplies per symbol which is far cheaper than the FFT when only a
+    // few of its bins are needed
+    q->twiddle = (float complex*) malloc(q->K * sizeof(float complex));
+    q->bin_gen = (unsigned int *) malloc(q->K * sizeof(unsigned int));
+    for (i=0; i<q->K; i++)
+        q->twiddle[i] = cexpf(-_Complex_I*2*M_PI*(float)i/(float)(q->K));
+    q->bank = (dotprod_cccf*) malloc(q->M * sizeof(dotprod_cccf));
+    float complex h[q->k];
+    unsigned int n;
+    for (i=0; i<q->M; i++) {
+        for (n=0; n<q->k; n++)
+            h[n] = q->twiddle[(q->demod_map[i]*n) % q->K];
+        q->bank[i] = dotprod_cccf_create(h, q->k);
+    }
+    unsigned int log2K = liquid_nextpow2(q->K);
+    fskdem_set_tone_bank(q, q->M * q->k <= FSKDEM_BANK_THRESHOLD * q->K * log2K);
+
     // reset modem object
     fskdem_reset(q);
 
@@ -157,6 +194,14 @@ int fskdem_destroy(fskdem _q)
     free(_q->buf_freq);
     FFT_DESTROY_PLAN(_q->fft);
 
+    // destroy tone bank
+    unsigned int i;
+    for (i=0; i<_q->M; i++)
+        dotprod_cccf_destroy(_q->bank[i]);
+    free(_q->bank);
+    free(_q->twiddle);
+    free(_q->bin_gen);
+
     // free main object memory
     free(_q);
     return LIQUID_OK;
@@ -169,6 +214,7 @@ int fskdem_print(fskdem _q)
     printf("    bits/symbol     :   %u\n", _q->m);
     printf("    samples/symbol  :   %u\n", _q->k);
     printf("    bandwidth       :   %8.5f\n", _q->bandwidth);
+    printf("    method          :   %s\n", _q->use_bank ? "tone bank" : "fft");
     return LIQUID_OK;
 }
 
@@ -180,10 +226,12 @@ int fskdem_reset(fskdem _q)
     for (i=0; i<_q->K; i++) {
         _q->buf_time[i] = 0.0f;
         _q->buf_freq[i] = 0.0f;
+        _q->bin_gen[i]  = 0;
     }
 
     // clear state variables
     _q->s_demod = 0;
+    _q->gen     = 1;
     return LIQUID_OK;
 }
 
@@ -193,15 +241,27 @@ int fskdem_reset(fskdem _q)
 unsigned int fskdem_demodulate(fskdem          _q,
                                float complex * _y)
 {
+    unsigned int s;
+
     // copy input to internal time buffer
     memmove(_q->buf_time, _y, _q->k*sizeof(float complex));
 
-    // compute transform, storing result in 'buf_freq'
-    FFT_EXECUTE(_q->fft);
+    if (_q->use_bank) {
+        // compute only the bins corresponding to each tone; the remaining
+        // bins are computed on demand
+        _q->gen++;
+        for (s=0; s<_q->M; s++) {
+            unsigned int index = _q->demod_map[s];
+            dotprod_cccf_execute(_q->bank[s], _q->buf_time, &_q->buf_freq[index]);
+            _q->bin_gen[index] = _q->gen;
+        }
+    } else {
+        // compute transform, storing result in 'buf_freq'
+        FFT_EXECUTE(_q->fft);
+    }
 
     // find maximum by looking at particular bins
     float        vmax  = 0;
-    unsigned int s     = 0;
 
     // run search
     for (s=0; s<_q->M; s++) {
@@ -226,9 +286,9 @@ float fskdem_get_frequency_error(fskdem _q)
     //unsigned int index = _q->buf_freq[ _q->s_demod ];
 
     // extract peak value of previous, post FFT index
-    float vm = cabsf(_q->buf_freq[(_q->s_demod+_q->K-1)%_q->K]);  // previous
-    float v0 = cabsf(_q->buf_freq[ _q->s_demod               ]);  // peak
-    float vp = cabsf(_q->buf_freq[(_q->s_demod+      1)%_q->K]);  // post
+    float vm = cabsf(fskdem_get_bin(_q, (_q->s_demod+_q->K-1)%_q->K));  // previous
+    float v0 = cabsf(fskdem_get_bin(_q,  _q->s_demod               ));  // peak
+    float vp = cabsf(fskdem_get_bin(_q, (_q->s_demod+      1)%_q->K));  // post
 
     // compute derivative
     // TODO: compensate for bin spacing
@@ -255,7 +315,7 @@ float fskdem_get_symbol_energy(fskdem       _q,
     unsigned int index = _q->demod_map[_s];
 
     // compute energy around FFT bin
-    float complex v = _q->buf_freq[index];
+    float complex v = fskdem_get_bin(_q, index);
     float energy = crealf(v)*crealf(v) + cimagf(v)*cimagf(v);
     int i;
     for (i=0; i<_range; i++) {
@@ -263,8 +323,8 @@ float fskdem_get_symbol_energy(fskdem       _q,
         unsigned int i0 = (index         + i) % _q->K;
         unsigned int i1 = (index + _q->K - i) % _q->K;
 
-        float complex v0 = _q->buf_freq[i0];
-        float complex v1 = _q->buf_freq[i1];
+        float complex v0 = fskdem_get_bin(_q, i0);
+        float complex v1 = fskdem_get_bin(_q, i1);
 
         energy += crealf(v0)*crealf(v0) + cimagf(v0)*cimagf(v0);
         energy += crealf(v1)*crealf(v1) + cimagf(v1)*cimagf(v1);
@@ -273,3 +333,30 @@ float fskdem_get_symbol_energy(fskdem       _q,
     return energy;
 }
 
+// enable/disable tone bank, computing only the required bins rather than
+// the full FFT; this is chosen automatically when the object is created
+int fskdem_set_tone_bank(fskdem _q,
+                         int    _enable)
+{
+    _q->use_bank = _enable ? 1 : 0;
+    return LIQUID_OK;
+}
+
+// get value of FFT bin for most recent symbol, computing it if necessary
+float complex fskdem_get_bin(fskdem       _q,
+                             unsigned int _index)
+{
+    if (!_q->use_bank || _q->bin_gen[_index] == _q->gen)
+        return _q->buf_freq[_index];
+
+    // compute single bin directly from the time buffer
+    float complex v = 0.0f;
+    unsigned int n, t = 0;
+    for (n=0; n<_q->k; n++) {
+        v += _q->buf_time[n] * _q->twiddle[t];
+        t  = (t + _index) % _q->K;
+    }
+    _q->buf_freq[_index] = v;
+    _q->bin_gen [_index] = _q->gen;
+    return v;
+}
@@ -420,6 +420,26 @@ int MODEM(_demodulate_soft)(MODEM() _q,
     return liquid_unpack_soft_bits(symbol_out, _q->m, _soft_bits);
 }
 
+// soft demodulation of a block of samples
+int MODEM(_demodulate_soft_block)(MODEM()         _q,
+                                  TC *            _x,
+                                  unsigned int    _n,
+                                  unsigned char * _soft_bits)
+{
+    // schemes with a dedicated block method
+    switch (_q->scheme) {
+    case LIQUID_MODEM_QPSK: return MODEM(_demodulate_soft_block_qpsk)(_q,_x,_n,_soft_bits);
+    default:;
+    }
+
+    // demodulate each sample in turn
+    unsigned int i;
+    unsigned int s;
+    for (i=0; i<_n; i++)
+        MODEM(_demodulate_soft)(_q, _x[i], &s, &_soft_bits[i*_q->m]);
+    return LIQUID_OK;
+}
+
 #if DEBUG_DEMODULATE_SOFT
 // print a string of bits to the standard output
 void print_bitstring_demod_soft(unsigned int _x,
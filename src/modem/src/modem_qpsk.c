@@ -110,3 +110,33 @@ int MODEM(_demodulate_soft_qpsk)(MODEM()         _q,
     return LIQUID_OK;
 }
 
+
+// demodulate block of QPSK samples (soft); each bit depends only on one
+// component of the sample, so the loop carries no per-sample state
+int MODEM(_demodulate_soft_block_qpsk)(MODEM()         _q,
+                                       TC *            _x,
+                                       unsigned int    _n,
+                                       unsigned char * _soft_bits)
+{
+    // gamma = 1/(2*sigma^2), approximate for constellation size
+    T gamma = 5.8f;
+
+    // samples as interleaved real/imaginary components
+    T * x = (T*) _x;
+    unsigned int i;
+    for (i=0; i<2*_n; i++) {
+        // first bit from imaginary component, second from real
+        T   LLR      = -2.0f * x[i^1] * gamma;
+        int soft_bit = LLR*16 + 127;
+        if (soft_bit > 255) soft_bit = 255;
+        if (soft_bit <   0) soft_bit = 0;
+        _soft_bits[i] = (unsigned char) ( soft_bit );
+    }
+
+    // re-modulate last symbol and store state
+    if (_n > 0) {
+        unsigned int s;
+        MODEM(_demodulate_qpsk)(_q, _x[_n-1], &s);
+    }
+    return LIQUID_OK;
+}
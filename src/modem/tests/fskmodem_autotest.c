@@ -21,7 +21,7 @@
  */
 
 #include "autotest/autotest.h"
-#include "liquid.h"
+#include "liquid.internal.h"
 
 // Help function to keep code base small
 void fskmodem_test_mod_demod(unsigned int _m,
@@ -83,3 +83,47 @@ void autotest_fskmodem_misc_M256()  { fskmodem_test_mod_demod( 8,  500, 0.372145
 void autotest_fskmodem_misc_M512()  { fskmodem_test_mod_demod( 9, 1000, 0.3721451); }
 void autotest_fskmodem_misc_M1024() { fskmodem_test_mod_demod(10, 2000, 0.3721451); }
 
+
+// tone bank and full FFT must agree on symbols and bin energies
+void fskmodem_test_tone_bank(unsigned int _m,
+                             unsigned int _k,
+                             float        _bandwidth)
+{
+    // create modulator and two demodulators
+    fskmod mod  = fskmod_create(_m,_k,_bandwidth);
+    fskdem dem0 = fskdem_create(_m,_k,_bandwidth);
+    fskdem dem1 = fskdem_create(_m,_k,_bandwidth);
+    fskdem_set_tone_bank(dem0, 0);
+    fskdem_set_tone_bank(dem1, 1);
+
+    unsigned int M = 1 << _m;   // constellation size
+    float complex buf[_k];      // transmit buffer
+    unsigned int i, j;
+    for (i=0; i<M; i++) {
+        // modulate and add noise
+        fskmod_modulate(mod, i, buf);
+        for (j=0; j<_k; j++)
+            buf[j] += 0.1f*randnf()*cexpf(_Complex_I*2*M_PI*randf());
+
+        // demodulate and compare
+        unsigned int s0 = fskdem_demodulate(dem0, buf);
+        unsigned int s1 = fskdem_demodulate(dem1, buf);
+        CONTEND_EQUALITY(s0, i);
+        CONTEND_EQUALITY(s1, i);
+        float e0 = fskdem_get_symbol_energy(dem0, i, 2);
+        float e1 = fskdem_get_symbol_energy(dem1, i, 2);
+        CONTEND_DELTA(e1, e0, 1e-4f*e0);
+        float f0 = fskdem_get_frequency_error(dem0);
+        float f1 = fskdem_get_frequency_error(dem1);
+        CONTEND_DELTA(f1, f0, 1e-3f*(1.0f + fabsf(f0)));
+    }
+
+    // clean it up
+    fskmod_destroy(mod);
+    fskdem_destroy(dem0);
+    fskdem_destroy(dem1);
+}
+
+void autotest_fskmodem_bank_M2()    { fskmodem_test_tone_bank( 1,   64, 0.25f    ); }
+void autotest_fskmodem_bank_M8()    { fskmodem_test_tone_bank( 3,   20, 0.3721451); }
+void autotest_fskmodem_bank_M64()   { fskmodem_test_tone_bank( 6,  128, 0.25f    ); }
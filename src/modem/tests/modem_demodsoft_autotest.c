@@ -129,3 +129,37 @@ void autotest_demodsoft_arb256opt() { modemcf_test_demodsoft(LIQUID_MODEM_ARB256
 void autotest_demodsoft_arb64vt()   { modemcf_test_demodsoft(LIQUID_MODEM_ARB64VT);   }
 void autotest_demodsoft_pi4dqpsk()  { modemcf_test_demodsoft(LIQUID_MODEM_PI4DQPSK);  }
 
+
+// block soft demodulation matches demodulating each sample in turn
+void modemcf_test_demodsoft_block(modulation_scheme _ms)
+{
+    modemcf q0 = modemcf_create(_ms);
+    modemcf q1 = modemcf_create(_ms);
+    unsigned int bps = modemcf_get_bps(q0);
+
+    // random noisy samples, including some well outside the constellation
+    unsigned int i, s, n = 75;
+    float complex x[n];
+    for (i=0; i<n; i++)
+        x[i] = 1.5f*(randnf() + _Complex_I*randnf());
+
+    unsigned char soft0[n*bps];
+    unsigned char soft1[n*bps];
+    for (i=0; i<n; i++)
+        modemcf_demodulate_soft(q0, x[i], &s, &soft0[i*bps]);
+    modemcf_demodulate_soft_block(q1, x, n, soft1);
+    CONTEND_SAME_DATA(soft0, soft1, n*bps);
+
+    // demodulator state follows last sample
+    float complex x0, x1;
+    modemcf_get_demodulator_sample(q0, &x0);
+    modemcf_get_demodulator_sample(q1, &x1);
+    CONTEND_EQUALITY(crealf(x0), crealf(x1));
+    CONTEND_EQUALITY(cimagf(x0), cimagf(x1));
+
+    modemcf_destroy(q0);
+    modemcf_destroy(q1);
+}
+
+void autotest_demodsoft_block_qpsk()  { modemcf_test_demodsoft_block(LIQUID_MODEM_QPSK);  }
+void autotest_demodsoft_block_qam16() { modemcf_test_demodsoft_block(LIQUID_MODEM_QAM16); }
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2007 - 2022 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <complex.h>
+#include <sys/resource.h>
+#include "liquid.h"
+
+#define OFDMFRAMEGEN_BENCH_API(M,CP_LEN,BLOCK)      \
+(   struct rusage *_start,                          \
+    struct rusage *_finish,                         \
+    unsigned long int *_num_iterations)             \
+{ ofdmframegen_bench(_start, _finish, _num_iterations, M, CP_LEN, BLOCK); }
+
+// Helper function to keep code base small
+//  _num_subcarriers    :   number of subcarriers
+//  _cp_len             :   cyclic prefix length
+//  _block              :   write with ofdmframegen_write_block (1) or
+//                          ofdmframegen_writesymbol (0)
+void ofdmframegen_bench(struct rusage *     _start,
+                        struct rusage *     _finish,
+                        unsigned long int * _num_iterations,
+                        unsigned int        _num_subcarriers,
+                        unsigned int        _cp_len,
+                        int                 _block)
+{
+    unsigned int M          = _num_subcarriers;
+    unsigned int cp_len     = _cp_len;
+    unsigned int taper_len  = cp_len / 4;
+    unsigned int num_symbols= 8;
+
+    ofdmframegen fg = ofdmframegen_create(M, cp_len, taper_len, NULL);
+
+    unsigned int i;
+    float complex * X = (float complex*) malloc(num_symbols*M*sizeof(float complex));
+    float complex * y = (float complex*) malloc(num_symbols*(M+cp_len)*sizeof(float complex));
+    for (i=0; i<num_symbols*M; i++)
+        X[i] = (rand() & 1 ? 0.7f : -0.7f) + (rand() & 1 ? 0.7f : -0.7f)*_Complex_I;
+
+    // normalize number of iterations
+    *_num_iterations /= M;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // start trials
+    unsigned int n;
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        if (_block) {
+            ofdmframegen_write_block(fg, X, num_symbols, y);
+        } else {
+            for (n=0; n<num_symbols; n++)
+                ofdmframegen_writesymbol(fg, &X[n*M], &y[n*(M+cp_len)]);
+        }
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= num_symbols;
+
+    // destroy objects
+    ofdmframegen_destroy(fg);
+    free(X);
+    free(y);
+}
+
+//
+void benchmark_ofdmframegen_writesymbol_n64     OFDMFRAMEGEN_BENCH_API(  64,  8, 0)
+void benchmark_ofdmframegen_writesymbol_n256    OFDMFRAMEGEN_BENCH_API( 256, 32, 0)
+void benchmark_ofdmframegen_writesymbol_n1024   OFDMFRAMEGEN_BENCH_API(1024,128, 0)
+void benchmark_ofdmframegen_writesymbol_n2048   OFDMFRAMEGEN_BENCH_API(2048,256, 0)
+
+void benchmark_ofdmframegen_write_block_n64     OFDMFRAMEGEN_BENCH_API(  64,  8, 1)
+void benchmark_ofdmframegen_write_block_n256    OFDMFRAMEGEN_BENCH_API( 256, 32, 1)
+void benchmark_ofdmframegen_write_block_n1024   OFDMFRAMEGEN_BENCH_API(1024,128, 1)
+void benchmark_ofdmframegen_write_block_n2048   OFDMFRAMEGEN_BENCH_API(2048,256, 1)
@@ -0,0 +1,466 @@
+/*
+ * Copyright (c) 2007 - 2022 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// ofdmchtrack.c
+//
+// OFDM per-subcarrier channel tracker
+//
+// Tracks the channel response, initially estimated from the frame
+// preamble, one received symbol at a time. The change in the channel on
+// each pilot subcarrier relative to the preamble estimate is tracked over
+// time by a second-order loop (gain and its drift per symbol), then
+// interpolated across frequency (cubic, over the nearest four pilots)
+// and applied to the preamble estimate of every subcarrier. Tracking the
+// relative change keeps what is interpolated smooth even when the
+// preamble estimate itself is not.
+// Optionally the error against hard decisions on the data subcarriers
+// refines each data subcarrier individually (decision-directed). The
+// equalizer is the inverse of the resulting channel estimate.
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "liquid.internal.h"
+
+#if HAVE_SSE2 && HAVE_EMMINTRIN_H
+#include <emmintrin.h>  // SSE2
+#define OFDMCHTRACK_USE_SSE2 1
+#else
+#define OFDMCHTRACK_USE_SSE2 0
+#endif
+
+// number of pilots used to interpolate each subcarrier
+#define OFDMCHTRACK_INTERP_LEN  (4)
+
+struct ofdmchtrack_s {
+    unsigned int M;         // number of subcarriers
+    unsigned char * p;      // subcarrier allocation (null, pilot, data)
+    unsigned int M_null;    // number of null subcarriers
+    unsigned int M_pilot;   // number of pilot subcarriers
+    unsigned int M_data;    // number of data subcarriers
+
+    // tracking options
+    liquid_ofdmchtrack_method method;
+    float bw;               // loop bandwidth
+    float alpha;            // loop gain, proportional
+    float beta;             // loop gain, integral (drift)
+
+    // subcarrier index lists; pilots in fftshift order
+    unsigned int * pilot_idx;
+    unsigned int * data_idx;
+
+    // interpolation across frequency: pilot change at subcarrier k is
+    //  sum_j w[k*L+j] D[idx[k*L+j]],  L = OFDMCHTRACK_INTERP_LEN
+    // where null subcarriers refer to the zero entry D[M_pilot]
+    unsigned int * idx;
+    float *        w;
+
+    // channel state
+    int initialized;        // reference estimate taken from equalizer?
+    float complex * B;      // per-subcarrier base estimate (preamble, decisions)
+    float complex * H;      // current channel estimate
+    float complex * H_new;  // updated channel estimate (scratch)
+    float complex * D;      // relative change on pilots [size: M_pilot+1]
+    float complex * V;      // drift of D per symbol [size: M_pilot]
+
+    // decision-directed slicer
+    modulation_scheme ms;
+    modemcf           mod;
+};
+
+// create channel tracker
+//  _M      :   number of subcarriers
+//  _p      :   subcarrier allocation (null, pilot, data), [size: _M x 1]
+ofdmchtrack ofdmchtrack_create(unsigned int    _M,
+                               unsigned char * _p)
+{
+    // validate input
+    if (_M < 2)
+        return liquid_error_config("ofdmchtrack_create(), number of subcarriers must be at least 2");
+    if (_M % 2)
+        return liquid_error_config("ofdmchtrack_create(), number of subcarriers must be even");
+
+    ofdmchtrack q = (ofdmchtrack) malloc(sizeof(struct ofdmchtrack_s));
+    q->M = _M;
+
+    // subcarrier allocation
+    q->p = (unsigned char*) malloc((q->M)*sizeof(unsigned char));
+    if (_p == NULL) {
+        ofdmframe_init_default_sctype(q->M, q->p);
+    } else {
+        memmove(q->p, _p, q->M*sizeof(unsigned char));
+    }
+
+    // validate and count subcarrier allocation
+    if (ofdmframe_validate_sctype(q->p, q->M, &q->M_null, &q->M_pilot, &q->M_data)) {
+        free(q->p);
+        free(q);
+        return liquid_error_config("ofdmchtrack_create(), invalid subcarrier allocation");
+    }
+    if (q->M_pilot < 2) {
+        free(q->p);
+        free(q);
+        return liquid_error_config("ofdmchtrack_create(), must have at least two pilot subcarriers");
+    }
+
+    // subcarrier index lists and signed frequency of each pilot, in
+    // ascending order starting from the band edge at -M/2
+    q->pilot_idx = (unsigned int*) malloc((q->M_pilot)*sizeof(unsigned int));
+    q->data_idx  = (unsigned int*) malloc((q->M_data )*sizeof(unsigned int));
+    float f_pilot[q->M_pilot];
+    unsigned int i;
+    unsigned int n_pilot = 0;
+    unsigned int n_data  = 0;
+    for (i=0; i<q->M; i++) {
+        unsigned int k = (i + q->M/2) % q->M;
+        if (q->p[k] == OFDMFRAME_SCTYPE_PILOT) {
+            f_pilot[n_pilot] = (k >= q->M/2) ? (float)k - (float)(q->M) : (float)k;
+            q->pilot_idx[n_pilot++] = k;
+        } else if (q->p[k] == OFDMFRAME_SCTYPE_DATA) {
+            q->data_idx[n_data++] = k;
+        }
+    }
+
+    // Lagrange interpolation over the pilots nearest each subcarrier,
+    // extrapolating from the outermost pilots at the band edges
+    unsigned int L = OFDMCHTRACK_INTERP_LEN;
+    unsigned int n = q->M_pilot < L ? q->M_pilot : L;
+    q->idx = (unsigned int*) malloc(L*(q->M)*sizeof(unsigned int));
+    q->w   = (float*)        malloc(L*(q->M)*sizeof(float));
+    unsigned int j = 0;
+    for (i=0; i<q->M; i++) {
+        unsigned int k = (i + q->M/2) % q->M;
+        float f = (k >= q->M/2) ? (float)k - (float)(q->M) : (float)k;
+        unsigned int m;
+        for (m=0; m<L; m++) {
+            q->idx[k*L+m] = q->M_pilot;
+            q->w  [k*L+m] = 0.0f;
+        }
+        if (q->p[k] == OFDMFRAME_SCTYPE_NULL)
+            continue;
+
+        // advance to pilot pair enclosing this subcarrier and center
+        // the interpolation window on it
+        while (j+1 < q->M_pilot-1 && f_pilot[j+1] <= f)
+            j++;
+        unsigned int j0 = j + 1 < n/2 ? 0 : j + 1 - n/2;
+        if (j0 + n > q->M_pilot)
+            j0 = q->M_pilot - n;
+
+        for (m=0; m<n; m++) {
+            float v = 1.0f;
+            unsigned int l;
+            for (l=0; l<n; l++) {
+                if (l != m)
+                    v *= (f - f_pilot[j0+l]) / (f_pilot[j0+m] - f_pilot[j0+l]);
+            }
+            q->idx[k*L+m] = j0 + m;
+            q->w  [k*L+m] = v;
+        }
+    }
+
+    // channel state
+    q->B     = (float complex*) malloc((q->M)*sizeof(float complex));
+    q->H     = (float complex*) malloc((q->M)*sizeof(float complex));
+    q->H_new = (float complex*) malloc((q->M)*sizeof(float complex));
+    q->D     = (float complex*) malloc((q->M_pilot+1)*sizeof(float complex));
+    q->V     = (float complex*) malloc((q->M_pilot  )*sizeof(float complex));
+
+    // decision-directed slicer is set separately
+    q->ms  = LIQUID_MODEM_UNKNOWN;
+    q->mod = NULL;
+
+    // set default options and reset
+    q->method = LIQUID_OFDMCHTRACK_NONE;
+    ofdmchtrack_set_bandwidth(q, 0.2f);
+    ofdmchtrack_reset(q);
+    return q;
+}
+
+// destroy channel tracker
+int ofdmchtrack_destroy(ofdmchtrack _q)
+{
+    free(_q->p);
+    free(_q->pilot_idx);
+    free(_q->data_idx);
+    free(_q->idx);
+    free(_q->w);
+    free(_q->B);
+    free(_q->H);
+    free(_q->H_new);
+    free(_q->D);
+    free(_q->V);
+    if (_q->mod != NULL)
+        modemcf_destroy(_q->mod);
+    free(_q);
+    return LIQUID_OK;
+}
+
+int ofdmchtrack_print(ofdmchtrack _q)
+{
+    const char * method_str[] = {"none", "pilot", "decision-directed"};
+    printf("ofdmchtrack:\n");
+    printf("    num subcarriers     :   %-u\n", _q->M);
+    printf("      - pilot           :   %-u\n", _q->M_pilot);
+    printf("      - data            :   %-u\n", _q->M_data);
+    printf("    method              :   %s\n", method_str[_q->method]);
+    printf("    bandwidth           :   %-8.4f\n", _q->bw);
+    printf("    decision scheme     :   %s\n", modulation_types[_q->ms].name);
+    return LIQUID_OK;
+}
+
+// reset tracking state; the equalizer passed to the next call to
+// ofdmchtrack_execute() is taken as the reference estimate
+int ofdmchtrack_reset(ofdmchtrack _q)
+{
+    _q->initialized = 0;
+    memset(_q->D, 0x00, (_q->M_pilot+1)*sizeof(float complex));
+    memset(_q->V, 0x00, (_q->M_pilot  )*sizeof(float complex));
+    return LIQUID_OK;
+}
+
+// set tracking method
+int ofdmchtrack_set_method(ofdmchtrack               _q,
+                           liquid_ofdmchtrack_method _method)
+{
+    if (_method != LIQUID_OFDMCHTRACK_NONE  &&
+        _method != LIQUID_OFDMCHTRACK_PILOT &&
+        _method != LIQUID_OFDMCHTRACK_DD)
+        return liquid_error(LIQUID_EICONFIG,"ofdmchtrack_set_method(), invalid method");
+    _q->method = _method;
+    return LIQUID_OK;
+}
+
+// set loop bandwidth, _bw in (0,1]; loop is critically damped with
+// proportional gain _bw and drift gain _bw^2/2
+int ofdmchtrack_set_bandwidth(ofdmchtrack _q,
+                              float       _bw)
+{
+    if (_bw <= 0.0f || _bw > 1.0f)
+        return liquid_error(LIQUID_EICONFIG,"ofdmchtrack_set_bandwidth(), bandwidth must be in (0,1]");
+    _q->bw    = _bw;
+    _q->alpha = _bw;
+    _q->beta  = 0.5f*_bw*_bw;
+    return LIQUID_OK;
+}
+
+// set modulation scheme for decisions on data subcarriers; decisions
+// are disabled with LIQUID_MODEM_UNKNOWN
+int ofdmchtrack_set_scheme(ofdmchtrack       _q,
+                           modulation_scheme _ms)
+{
+    if (_ms >= LIQUID_MODEM_NUM_SCHEMES)
+        return liquid_error(LIQUID_EICONFIG,"ofdmchtrack_set_scheme(), invalid modulation scheme");
+    if (_ms == _q->ms)
+        return LIQUID_OK;
+
+    _q->ms = _ms;
+    if (_ms == LIQUID_MODEM_UNKNOWN) {
+        if (_q->mod != NULL)
+            modemcf_destroy(_q->mod);
+        _q->mod = NULL;
+    } else if (_q->mod == NULL) {
+        _q->mod = modemcf_create(_ms);
+    } else {
+        _q->mod = modemcf_recreate(_q->mod, _ms);
+    }
+    return LIQUID_OK;
+}
+
+// track channel over one received symbol
+//  _q      :   channel tracker
+//  _Y      :   equalized subcarrier values, corrected in place [size: M x 1]
+//  _S      :   known pilot values in fftshift order, [size: M_pilot x 1]
+//  _Wr     :   per-subcarrier equalizer gain that produced _Y, real part
+//              with each value repeated twice, updated in place for the
+//              next symbol [size: 2M x 1]
+//  _Wi     :   equalizer gain, imaginary part, as _Wr [size: 2M x 1]
+int ofdmchtrack_execute(ofdmchtrack     _q,
+                        float complex * _Y,
+                        float complex * _S,
+                        float *         _Wr,
+                        float *         _Wi)
+{
+    if (_q->method == LIQUID_OFDMCHTRACK_NONE)
+        return LIQUID_OK;
+
+    unsigned int i;
+    if (!_q->initialized) {
+        // reference channel estimate is the inverse of the equalizer
+        for (i=0; i<_q->M; i++) {
+            float wr = _Wr[2*i];
+            float wi = _Wi[2*i];
+            float w2 = wr*wr + wi*wi;
+            _q->B[i] = w2 > 0.0f ? (wr - _Complex_I*wi) / w2 : 0.0f;
+        }
+        memmove(_q->H, _q->B, _q->M*sizeof(float complex));
+        _q->initialized = 1;
+    }
+
+    // track relative change of channel on pilots, H = B (1 + D); the
+    // relative error u of the equalized pilot scales H by (1-u)
+    float alpha = _q->alpha;
+    float beta  = _q->beta;
+    for (i=0; i<_q->M_pilot; i++) {
+        unsigned int  k = _q->pilot_idx[i];
+        float complex e = -(1.0f + _q->D[i]) * ofdmchtrack_error(_Y[k], _S[i]);
+        _q->V[i] += beta*e;
+        _q->D[i] += alpha*e + _q->V[i];
+    }
+
+    // interpolate pilot change across frequency onto base estimate
+    unsigned int * idx = _q->idx;
+    float *        w   = _q->w;
+    for (i=0; i<_q->M; i++) {
+        float complex d = w[0]*_q->D[idx[0]] + w[1]*_q->D[idx[1]]
+                        + w[2]*_q->D[idx[2]] + w[3]*_q->D[idx[3]];
+        _q->H_new[i] = _q->B[i] * (1.0f + d);
+        idx += OFDMCHTRACK_INTERP_LEN;
+        w   += OFDMCHTRACK_INTERP_LEN;
+    }
+
+    // update equalizer and current symbol
+    ofdmchtrack_invert(_q->H_new, _q->H, _Wr, _Wi, _Y, _q->M);
+    float complex * H = _q->H;
+    _q->H     = _q->H_new;
+    _q->H_new = H;
+
+    if (_q->method != LIQUID_OFDMCHTRACK_DD || _q->mod == NULL)
+        return LIQUID_OK;
+
+    // refine each data subcarrier against decisions made on the updated
+    // symbol; only the equalizer for the next symbol changes
+    for (i=0; i<_q->M_data; i++) {
+        unsigned int k = _q->data_idx[i];
+        unsigned int sym;
+        float complex d;
+        modemcf_demodulate(_q->mod, _Y[k], &sym);
+        modemcf_get_demodulator_sample(_q->mod, &d);
+        float complex g = 1.0f - alpha*ofdmchtrack_error(_Y[k], d);
+        _q->B[k] *= g;
+        _q->H[k] *= g;
+    }
+    return ofdmchtrack_invert(_q->H, NULL, _Wr, _Wi, NULL, _q->M);
+}
+
+//
+// internal methods
+//
+
+// relative error of received value _y against reference _d
+float complex ofdmchtrack_error(float complex _y,
+                                float complex _d)
+{
+    float dr = crealf(_d), di = cimagf(_d);
+    float d2 = dr*dr + di*di;
+    if (d2 < 1e-6f)
+        return 0.0f;
+
+    // (d - y) conj(d) / |d|^2
+    float er = dr - crealf(_y);
+    float ei = di - cimagf(_y);
+    float ur = (er*dr + ei*di) / d2;
+    float ui = (ei*dr - er*di) / d2;
+
+    // limit magnitude to 1/2
+    float u2 = ur*ur + ui*ui;
+    if (u2 > 0.25f) {
+        float g = 0.5f / sqrtf(u2);
+        ur *= g;
+        ui *= g;
+    }
+    return ur + _Complex_I*ui;
+}
+
+#if OFDMCHTRACK_USE_SSE2
+// multiply pairs of interleaved complex values in _x by (_yr + j _yi), each
+// of which holds its real/imaginary parts repeated twice
+static inline __m128 ofdmchtrack_cmul_sse2(__m128 _x,
+                                           __m128 _yr,
+                                           __m128 _yi)
+{
+    const __m128 sign = _mm_castsi128_ps(_mm_set_epi32(0, 0x80000000, 0, 0x80000000));
+    __m128 xs = _mm_shuffle_ps(_x, _x, _MM_SHUFFLE(2,3,0,1));
+    return _mm_add_ps(_mm_mul_ps(_x, _yr), _mm_xor_ps(_mm_mul_ps(xs, _yi), sign));
+}
+#endif
+
+// set equalizer to inverse of channel estimate; for each subcarrier
+//  W <- 1/_H,  _Y <- _Y W _H_prev
+// where zero channel estimates (null subcarriers) give zero gain
+int ofdmchtrack_invert(float complex * _H,
+                       float complex * _H_prev,
+                       float *         _Wr,
+                       float *         _Wi,
+                       float complex * _Y,
+                       unsigned int    _n)
+{
+    const float * H  = (const float*) _H;
+    const float * H0 = (const float*) _H_prev;
+    float *       Y  = (float*) _Y;
+    unsigned int i = 0;
+#if OFDMCHTRACK_USE_SSE2
+    const __m128 conj = _mm_castsi128_ps(_mm_set_epi32(0x80000000, 0, 0x80000000, 0));
+    const __m128 tiny = _mm_set1_ps(1e-30f);
+    for (; i+2 <= _n; i+=2) {
+        // 1/h = conj(h) / |h|^2, guarding against division by zero
+        __m128 h  = _mm_loadu_ps(&H[2*i]);
+        __m128 h2 = _mm_mul_ps(h, h);
+        h2 = _mm_add_ps(h2, _mm_shuffle_ps(h2, h2, _MM_SHUFFLE(2,3,0,1)));
+        __m128 w  = _mm_div_ps(_mm_xor_ps(h, conj), _mm_max_ps(h2, tiny));
+
+        // split into real/imaginary parts, each repeated twice
+        __m128 wr = _mm_shuffle_ps(w, w, _MM_SHUFFLE(2,2,0,0));
+        __m128 wi = _mm_shuffle_ps(w, w, _MM_SHUFFLE(3,3,1,1));
+        _mm_storeu_ps(&_Wr[2*i], wr);
+        _mm_storeu_ps(&_Wi[2*i], wi);
+        if (Y != NULL) {
+            __m128 g  = ofdmchtrack_cmul_sse2(_mm_loadu_ps(&H0[2*i]), wr, wi);
+            __m128 gr = _mm_shuffle_ps(g, g, _MM_SHUFFLE(2,2,0,0));
+            __m128 gi = _mm_shuffle_ps(g, g, _MM_SHUFFLE(3,3,1,1));
+            _mm_storeu_ps(&Y[2*i], ofdmchtrack_cmul_sse2(_mm_loadu_ps(&Y[2*i]), gr, gi));
+        }
+    }
+#endif
+    for (; i<_n; i++) {
+        unsigned int j = 2*i;
+        float h2 = H[j]*H[j] + H[j+1]*H[j+1];
+        h2 = h2 > 1e-30f ? h2 : 1e-30f;
+        float wr =  H[j+0] / h2;
+        float wi = -H[j+1] / h2;
+        _Wr[j+0] = _Wr[j+1] = wr;
+        _Wi[j+0] = _Wi[j+1] = wi;
+        if (Y != NULL) {
+            float gr = wr*H0[j] - wi*H0[j+1];
+            float gi = wr*H0[j+1] + wi*H0[j];
+            float yr = Y[j]*gr - Y[j+1]*gi;
+            float yi = Y[j]*gi + Y[j+1]*gr;
+            Y[j+0] = yr;
+            Y[j+1] = yi;
+        }
+    }
+    return LIQUID_OK;
+}
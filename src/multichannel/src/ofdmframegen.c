@@ -45,6 +45,11 @@ struct ofdmframegen_s {
     unsigned int cp_len;    // cyclic prefix length
     unsigned char * p;      // subcarrier allocation (null, pilot, data)
 
+    // subcarrier index lists
+    unsigned int * null_idx;    // null subcarriers
+    unsigned int * pilot_idx;   // pilot subcarriers, fftshift order
+    unsigned int * data_idx;    // data subcarriers
+
     // tapering/trasition
     unsigned int taper_len; // number of samples in tapering window/overlap
     float * taper;          // tapering window
@@ -124,6 +129,21 @@ ofdmframegen ofdmframegen_create(unsigned int    _M,
 
     unsigned int i;
 
+    // build subcarrier index lists; pilots are ordered starting at the
+    // mid-point (effective fftshift) to match the pilot sequence
+    q->null_idx  = (unsigned int*) malloc((q->M_null )*sizeof(unsigned int));
+    q->pilot_idx = (unsigned int*) malloc((q->M_pilot)*sizeof(unsigned int));
+    q->data_idx  = (unsigned int*) malloc((q->M_data )*sizeof(unsigned int));
+    unsigned int n_null=0, n_pilot=0, n_data=0;
+    for (i=0; i<q->M; i++) {
+        unsigned int k = (i + q->M/2) % q->M;
+        switch (q->p[k]) {
+        case OFDMFRAME_SCTYPE_NULL:  q->null_idx [n_null++ ] = k; break;
+        case OFDMFRAME_SCTYPE_PILOT: q->pilot_idx[n_pilot++] = k; break;
+        default:                     q->data_idx [n_data++ ] = k;
+        }
+    }
+
     // allocate memory for transform objects
     q->X = (float complex*) malloc((q->M)*sizeof(float complex));
     q->x = (float complex*) malloc((q->M)*sizeof(float complex));
@@ -167,6 +187,9 @@ int ofdmframegen_destroy(ofdmframegen _q)
 {
     // free subcarrier type array memory
     free(_q->p);
+    free(_q->null_idx);
+    free(_q->pilot_idx);
+    free(_q->data_idx);
 
     // free transform array memory
     free(_q->X);
@@ -276,34 +299,39 @@ int ofdmframegen_writesymbol(ofdmframegen    _q,
                              float complex * _x,
                              float complex * _y)
 {
-    // move frequency data to internal buffer
-    unsigned int i;
-    unsigned int k;
-    int sctype;
-    for (i=0; i<_q->M; i++) {
-        // start at mid-point (effective fftshift)
-        k = (i + _q->M/2) % _q->M;
-
-        sctype = _q->p[k];
-        if (sctype==OFDMFRAME_SCTYPE_NULL) {
-            // disabled subcarrier
-            _q->X[k] = 0.0f;
-        } else if (sctype==OFDMFRAME_SCTYPE_PILOT) {
-            // pilot subcarrier
-            _q->X[k] = (msequence_advance(_q->ms_pilot) ? 1.0f : -1.0f) * _q->g_data;
-        } else {
-            // data subcarrier
-            _q->X[k] = _x[k] * _q->g_data;
-        }
+    return ofdmframegen_write_block(_q, _x, 1, _y);
+}
 
-        //printf("X[%3u] = %12.8f + j*%12.8f;\n",i+1,crealf(_q->X[i]),cimagf(_q->X[i]));
+// write block of OFDM symbols
+//  _q              :   framing generator object
+//  _x              :   input symbols, [size: _num_symbols*_M x 1]
+//  _num_symbols    :   number of OFDM symbols
+//  _y              :   output samples, [size: _num_symbols*(_M+cp_len) x 1]
+int ofdmframegen_write_block(ofdmframegen    _q,
+                             float complex * _x,
+                             unsigned int    _num_symbols,
+                             float complex * _y)
+{
+    unsigned int n;
+    unsigned int i;
+    for (n=0; n<_num_symbols; n++) {
+        float complex * x = &_x[n*_q->M];
+
+        // move frequency data to internal buffer
+        for (i=0; i<_q->M_null; i++)
+            _q->X[_q->null_idx[i]] = 0.0f;
+        for (i=0; i<_q->M_pilot; i++)
+            _q->X[_q->pilot_idx[i]] = (msequence_advance(_q->ms_pilot) ? 1.0f : -1.0f) * _q->g_data;
+        for (i=0; i<_q->M_data; i++)
+            _q->X[_q->data_idx[i]] = x[_q->data_idx[i]] * _q->g_data;
+
+        // execute transform
+        FFT_EXECUTE(_q->ifft);
+
+        // copy result to output, adding cyclic prefix and tapering window
+        ofdmframegen_gensymbol(_q, &_y[n*(_q->M + _q->cp_len)]);
     }
-
-    // execute transform
-    FFT_EXECUTE(_q->ifft);
-
-    // copy result to output, adding cyclic prefix and tapering window
-    return ofdmframegen_gensymbol(_q, _y);
+    return LIQUID_OK;
 }
 
 // write tail to output
@@ -342,19 +370,19 @@ int ofdmframegen_writetail(ofdmframegen    _q,
 int ofdmframegen_gensymbol(ofdmframegen    _q,
                            float complex * _buffer)
 {
-    // copy input symbol with cyclic prefix to output symbol
-    memmove( &_buffer[0],          &_q->x[_q->M-_q->cp_len], _q->cp_len*sizeof(float complex));
-    memmove( &_buffer[_q->cp_len], &_q->x[               0], _q->M    * sizeof(float complex));
-    
-    // apply tapering window to over-lapping regions
+    // cyclic prefix, overlapping the tapered post-fix of the previous
+    // symbol with its first 'taper_len' samples
     unsigned int i;
-    for (i=0; i<_q->taper_len; i++) {
-        _buffer[i] *= _q->taper[i];
-        _buffer[i] += _q->postfix[i] * _q->taper[_q->taper_len-i-1];
-    }
+    float complex * prefix = &_q->x[_q->M - _q->cp_len];
+    for (i=0; i<_q->taper_len; i++)
+        _buffer[i] = prefix[i]*_q->taper[i] + _q->postfix[i]*_q->taper[_q->taper_len-i-1];
+    memmove(&_buffer[_q->taper_len], &prefix[_q->taper_len],
+            (_q->cp_len - _q->taper_len)*sizeof(float complex));
+
+    // copy input symbol to output symbol
+    memmove(&_buffer[_q->cp_len], _q->x, _q->M*sizeof(float complex));
 
     // copy post-fix to output (first 'taper_len' samples of input symbol)
     memmove(_q->postfix, _q->x, _q->taper_len*sizeof(float complex));
     return LIQUID_OK;
 }
-
@@ -34,6 +34,16 @@
 
 #include "liquid.internal.h"
 
+#if HAVE_SSE2 && HAVE_EMMINTRIN_H
+#include <emmintrin.h>  // SSE2
+#define OFDMFRAMESYNC_USE_SSE2 1
+#else
+#define OFDMFRAMESYNC_USE_SSE2 0
+#endif
+
+// number of subcarriers sharing one sin/cos evaluation of the pilot phase ramp
+#define OFDMFRAMESYNC_RAMP_LEN          (16)
+
 #define DEBUG_OFDMFRAMESYNC             1
 #define DEBUG_OFDMFRAMESYNC_PRINT       0
 #define DEBUG_OFDMFRAMESYNC_FILENAME    "ofdmframesync_internal_debug.m"
@@ -78,7 +88,19 @@ struct ofdmframesync_s {
     float complex * G1;     // complex subcarrier gain estimate, S1
     float complex * G;      // complex subcarrier gain estimate
     float complex * B;      // subcarrier phase rotation due to backoff
-    float complex * R;      // 
+    float * Rr;             // composite equalizer gain B/G, real part [size: 2M]
+    float * Ri;             // composite equalizer gain B/G, imag part [size: 2M]
+
+    // per-subcarrier channel tracking
+    ofdmchtrack     chtrack;    // channel tracker, updates Rr/Ri
+    float complex * pilot_sym;  // known pilot values for current symbol
+
+    // pilot subcarriers in fftshift order and their (signed) frequency index
+    unsigned int * pilot_idx;
+    float *        pilot_fx;
+
+    // input samples mixed down by the NCO, up to one symbol and backoff
+    float complex * buf_rx;
 
     // receiver state
     enum {
@@ -206,13 +228,18 @@ ofdmframesync ofdmframesync_create(unsigned int           _M,
     q->G0b = (float complex*) malloc((q->M)*sizeof(float complex));
     q->G   = (float complex*) malloc((q->M)*sizeof(float complex));
     q->B   = (float complex*) malloc((q->M)*sizeof(float complex));
-    q->R   = (float complex*) malloc((q->M)*sizeof(float complex));
+    // equalizer gain is split into real/imaginary arrays with each value
+    // repeated twice so that it lines up with interleaved subcarriers
+    q->Rr  = (float*) malloc(2*(q->M)*sizeof(float));
+    q->Ri  = (float*) malloc(2*(q->M)*sizeof(float));
 
 #if 1
     memset(q->G0a, 0x00, q->M*sizeof(float complex));
     memset(q->G0b, 0x00, q->M*sizeof(float complex));
     memset(q->G ,  0x00, q->M*sizeof(float complex));
     memset(q->B,   0x00, q->M*sizeof(float complex));
+    memset(q->Rr,  0x00, 2*q->M*sizeof(float));
+    memset(q->Ri,  0x00, 2*q->M*sizeof(float));
 #endif
 
     // timing backoff
@@ -222,6 +249,26 @@ ofdmframesync ofdmframesync_create(unsigned int           _M,
     for (i=0; i<q->M; i++)
         q->B[i] = liquid_cexpjf(i*phi);
 
+    // pilot index list (effective fftshift, starting at mid-point)
+    q->pilot_idx = (unsigned int*) malloc((q->M_pilot)*sizeof(unsigned int));
+    q->pilot_fx  = (float*)        malloc((q->M_pilot)*sizeof(float));
+    unsigned int n = 0;
+    for (i=0; i<q->M; i++) {
+        unsigned int k = (i + q->M2) % q->M;
+        if (q->p[k] == OFDMFRAME_SCTYPE_PILOT) {
+            q->pilot_idx[n] = k;
+            q->pilot_fx[n]  = (k > q->M2) ? (float)k - (float)(q->M) : (float)k;
+            n++;
+        }
+    }
+
+    // channel tracker (disabled by default)
+    q->chtrack   = ofdmchtrack_create(q->M, q->p);
+    q->pilot_sym = (float complex*) malloc((q->M_pilot)*sizeof(float complex));
+
+    // block receive buffer; never needs to hold more than the symbol timer
+    q->buf_rx = (float complex*) malloc((q->M + q->cp_len + q->backoff)*sizeof(float complex));
+
     // set callback data
     q->callback = _callback;
     q->userdata = _userdata;
@@ -299,7 +346,17 @@ int ofdmframesync_destroy(ofdmframesync _q)
     free(_q->G0b);
     free(_q->G);
     free(_q->B);
-    free(_q->R);
+    free(_q->Rr);
+    free(_q->Ri);
+
+    // free subcarrier index lists and receive buffer
+    free(_q->pilot_idx);
+    free(_q->pilot_fx);
+    free(_q->pilot_sym);
+    free(_q->buf_rx);
+
+    // destroy channel tracker
+    ofdmchtrack_destroy(_q->chtrack);
 
     // destroy synchronizer objects
     nco_crcf_destroy(_q->nco_rx);           // numerically-controlled oscillator
@@ -331,6 +388,7 @@ int ofdmframesync_reset(ofdmframesync _q)
     // reset synchronizer objects
     nco_crcf_reset(_q->nco_rx);
     msequence_reset(_q->ms_pilot);
+    ofdmchtrack_reset(_q->chtrack);
 
     // reset timers
     _q->timer = 0;
@@ -358,10 +416,20 @@ int ofdmframesync_execute(ofdmframesync   _q,
                           float complex * _x,
                           unsigned int    _n)
 {
-    unsigned int i;
+    unsigned int i = 0;
     float complex x;
-    for (i=0; i<_n; i++) {
-        x = _x[i];
+    while (i < _n) {
+        // payload symbols are received a block at a time
+#if DEBUG_OFDMFRAMESYNC
+        if (_q->state == OFDMFRAMESYNC_STATE_RXSYMBOLS && !_q->debug_enabled) {
+#else
+        if (_q->state == OFDMFRAMESYNC_STATE_RXSYMBOLS) {
+#endif
+            i += ofdmframesync_execute_rxblock(_q, &_x[i], _n - i);
+            continue;
+        }
+
+        x = _x[i++];
 
         // correct for carrier frequency offset
         if (_q->state != OFDMFRAMESYNC_STATE_SEEKPLCP) {
@@ -398,7 +466,7 @@ int ofdmframesync_execute(ofdmframesync   _q,
         default:;
         }
 
-    } // for (i=0; i<_n; i++)
+    } // while (i < _n)
     return LIQUID_OK;
 } // ofdmframesync_execute()
 
@@ -421,6 +489,27 @@ int ofdmframesync_set_cfo(ofdmframesync _q, float _cfo)
     return LIQUID_OK;
 }
 
+// set per-subcarrier channel tracking method
+int ofdmframesync_set_chtrack_method(ofdmframesync             _q,
+                                     liquid_ofdmchtrack_method _method)
+{
+    return ofdmchtrack_set_method(_q->chtrack, _method);
+}
+
+// set per-subcarrier channel tracking loop bandwidth
+int ofdmframesync_set_chtrack_bandwidth(ofdmframesync _q,
+                                        float         _bw)
+{
+    return ofdmchtrack_set_bandwidth(_q->chtrack, _bw);
+}
+
+// set modulation scheme for decision-directed channel tracking
+int ofdmframesync_set_chtrack_scheme(ofdmframesync     _q,
+                                     modulation_scheme _ms)
+{
+    return ofdmchtrack_set_scheme(_q->chtrack, _ms);
+}
+
 //
 // internal methods
 //
@@ -696,11 +785,18 @@ int ofdmframesync_execute_S1(ofdmframesync _q)
 #endif
 
 #if 1
-        // compute composite gain
+        // compute composite gain (zero on null subcarriers)
         unsigned int i;
-        for (i=0; i<_q->M; i++)
-            _q->R[i] = _q->B[i] / _q->G[i];
+        for (i=0; i<_q->M; i++) {
+            float complex r = 0.0f;
+            if (_q->p[i] != OFDMFRAME_SCTYPE_NULL)
+                r = _q->B[i] / _q->G[i];
+            _q->Rr[2*i+0] = _q->Rr[2*i+1] = crealf(r);
+            _q->Ri[2*i+0] = _q->Ri[2*i+1] = cimagf(r);
+        }
 #endif
+        // start tracking from preamble estimate
+        ofdmchtrack_reset(_q->chtrack);
         return LIQUID_OK;
     }
 
@@ -756,6 +852,27 @@ int ofdmframesync_execute_rxsymbols(ofdmframesync _q)
     return LIQUID_OK;
 }
 
+// receive payload samples in a block: mix down and buffer samples up to the
+// next symbol boundary, then recover the symbol if the boundary was reached
+unsigned int ofdmframesync_execute_rxblock(ofdmframesync   _q,
+                                           float complex * _x,
+                                           unsigned int    _n)
+{
+    // timer counts down to the next symbol boundary and is always positive
+    // here; buffer is sized to hold the longest timer value
+    unsigned int n = _n < _q->timer ? _n : _q->timer;
+
+    // correct for carrier frequency offset and save to buffer
+    nco_crcf_mix_block_down(_q->nco_rx, _x, _q->buf_rx, n);
+    windowcf_write(_q->input_buffer, _q->buf_rx, n);
+
+    // advance timer, leaving the final step (and symbol recovery) to the
+    // per-sample handler
+    _q->timer -= n - 1;
+    ofdmframesync_execute_rxsymbols(_q);
+    return n;
+}
+
 // compute S0 metrics
 int ofdmframesync_S0_metrics(ofdmframesync _q,
                              float complex * _G,
@@ -993,48 +1110,32 @@ int ofdmframesync_estimate_eqgain_poly(ofdmframesync _q,
 // recover symbol, correcting for gain, pilot phase, etc.
 int ofdmframesync_rxsymbol(ofdmframesync _q)
 {
-    // apply gain
-    unsigned int i;
-    for (i=0; i<_q->M; i++)
-        _q->X[i] *= _q->R[i];
-
     // polynomial curve-fit
-    float x_phase[_q->M_pilot];
     float y_phase[_q->M_pilot];
     float p_phase[2];
 
-    unsigned int n=0;
-    unsigned int k;
-    float complex pilot = 1.0f;
-    for (i=0; i<_q->M; i++) {
-
-        // start at mid-point (effective fftshift)
-        k = (i + _q->M2) % _q->M;
-
-        if (_q->p[k]==OFDMFRAME_SCTYPE_PILOT) {
-            if (n == _q->M_pilot)
-                return liquid_error(LIQUID_EINT,"ofdmframesync_estimate_eqgain_poly(), pilot subcarrier mismatch");
-
-            pilot = (msequence_advance(_q->ms_pilot) ? 1.0f : -1.0f);
-#if 0
-            printf("pilot[%3u] = %12.4e + j*%12.4e (expected %12.4e + j*%12.4e)\n",
-                    k,
-                    crealf(_q->X[k]), cimagf(_q->X[k]),
-                    crealf(pilot),    cimagf(pilot));
-#endif
-            // store resulting...
-            x_phase[n] = (k > _q->M2) ? (float)k - (float)(_q->M) : (float)k;
-            y_phase[n] = cargf(_q->X[k]*conjf(pilot));
-
-            // update counter
-            n++;
-
+    // equalize pilots only to estimate phase
+    unsigned int i;
+    for (i=0; i<_q->M_pilot; i++) {
+        unsigned int k = _q->pilot_idx[i];
+        float xr = crealf(_q->X[k]);
+        float xi = cimagf(_q->X[k]);
+        float gr = _q->Rr[2*k];
+        float gi = _q->Ri[2*k];
+        float yr = xr*gr - xi*gi;
+        float yi = xr*gi + xi*gr;
+
+        // remove pilot polarity
+        if (msequence_advance(_q->ms_pilot)) {
+            _q->pilot_sym[i] =  1.0f;
+        } else {
+            _q->pilot_sym[i] = -1.0f;
+            yr = -yr;
+            yi = -yi;
         }
+        y_phase[i] = atan2f(yi, yr);
     }
 
-    if (n != _q->M_pilot)
-        return liquid_error(LIQUID_EINT,"ofdmframesync_estimate_eqgain_poly(), pilot subcarrier mismatch");
-
     // try to unwrap phase
     for (i=1; i<_q->M_pilot; i++) {
         while ((y_phase[i] - y_phase[i-1]) >  M_PI)
@@ -1044,7 +1145,7 @@ int ofdmframesync_rxsymbol(ofdmframesync _q)
     }
 
     // fit phase to 1st-order polynomial (2 coefficients)
-    polyf_fit(x_phase, y_phase, _q->M_pilot, p_phase, 2);
+    polyf_fit(_q->pilot_fx, y_phase, _q->M_pilot, p_phase, 2);
 
     // filter slope estimate (timing offset)
     float alpha = 0.3f;
@@ -1054,8 +1155,8 @@ int ofdmframesync_rxsymbol(ofdmframesync _q)
 #if DEBUG_OFDMFRAMESYNC
     if (_q->debug_enabled) {
         // save pilots
-        memmove(_q->px, x_phase, _q->M_pilot*sizeof(float));
-        memmove(_q->py, y_phase, _q->M_pilot*sizeof(float));
+        memmove(_q->px, _q->pilot_fx, _q->M_pilot*sizeof(float));
+        memmove(_q->py, y_phase,      _q->M_pilot*sizeof(float));
 
         // NOTE : swapping values for octave
         _q->p_phase[0] = p_phase[1];
@@ -1066,18 +1167,19 @@ int ofdmframesync_rxsymbol(ofdmframesync _q)
     }
 #endif
 
-    // compensate for phase offset
-    // TODO : find more computationally efficient way to do this
-    for (i=0; i<_q->M; i++) {
-        // only apply to data/pilot subcarriers
-        if (_q->p[i] == OFDMFRAME_SCTYPE_NULL) {
-            _q->X[i] = 0.0f;
-        } else {
-            float fx    = (i > _q->M2) ? (float)i - (float)(_q->M) : (float)i;
-            float theta = polyf_val(p_phase, 2, fx);
-            _q->X[i] *= liquid_cexpjf(-theta);
-        }
-    }
+    // apply gain and compensate for phase offset; the ramp is linear in
+    // the signed subcarrier index, so positive frequencies [0,M/2] and
+    // negative frequencies [-M/2+1,-1] are each one contiguous run. Null
+    // subcarriers have zero gain.
+    unsigned int M2 = _q->M2;
+    ofdmframesync_equalize(_q->X, _q->Rr, _q->Ri, M2+1,
+                           p_phase[0], p_phase[1]);
+    ofdmframesync_equalize(&_q->X[M2+1], &_q->Rr[2*(M2+1)], &_q->Ri[2*(M2+1)], M2-1,
+                           p_phase[0] - (float)(M2-1)*p_phase[1], p_phase[1]);
+
+    // track residual per-subcarrier gain, refining this symbol and the
+    // equalizer for the next one
+    ofdmchtrack_execute(_q->chtrack, _q->X, _q->pilot_sym, _q->Rr, _q->Ri);
 
     // adjust NCO frequency based on differential phase
     if (_q->num_symbols > 0) {
@@ -1098,12 +1200,84 @@ int ofdmframesync_rxsymbol(ofdmframesync _q)
 
 #if 0
     for (i=0; i<_q->M_pilot; i++)
-        printf("x_phase(%3u) = %12.8f; y_phase(%3u) = %12.8f;\n", i+1, x_phase[i], i+1, y_phase[i]);
+        printf("x_phase(%3u) = %12.8f; y_phase(%3u) = %12.8f;\n", i+1, _q->pilot_fx[i], i+1, y_phase[i]);
     printf("poly : p0=%12.8f, p1=%12.8f\n", p_phase[0], p_phase[1]);
 #endif
     return LIQUID_OK;
 }
 
+#if OFDMFRAMESYNC_USE_SSE2
+// multiply pairs of interleaved complex values in _x by (_yr + j _yi), each
+// of which holds its real/imaginary parts repeated twice
+static inline __m128 ofdmframesync_cmul_sse2(__m128 _x,
+                                             __m128 _yr,
+                                             __m128 _yi)
+{
+    const __m128 sign = _mm_castsi128_ps(_mm_set_epi32(0, 0x80000000, 0, 0x80000000));
+    __m128 xs = _mm_shuffle_ps(_x, _x, _MM_SHUFFLE(2,3,0,1));
+    return _mm_add_ps(_mm_mul_ps(_x, _yr), _mm_xor_ps(_mm_mul_ps(xs, _yi), sign));
+}
+#endif
+
+// apply equalizer gain and pilot phase ramp to _n subcarriers in place;
+// sin/cos are evaluated once per block of OFDMFRAMESYNC_RAMP_LEN subcarriers
+// and the ramp within each block is the block phasor times a step table
+int ofdmframesync_equalize(float complex * _X,
+                           const float *   _Rr,
+                           const float *   _Ri,
+                           unsigned int    _n,
+                           float           _theta,
+                           float           _dtheta)
+{
+    // phase steps within block, exp(-j k dtheta)
+    float step[2*OFDMFRAMESYNC_RAMP_LEN];
+    unsigned int k;
+    for (k=0; k<OFDMFRAMESYNC_RAMP_LEN; k++) {
+        step[2*k+0] =  cosf((float)k*_dtheta);
+        step[2*k+1] = -sinf((float)k*_dtheta);
+    }
+
+    float * X = (float*) _X;
+    unsigned int i = 0;
+    while (i < _n) {
+        unsigned int len = _n - i < OFDMFRAMESYNC_RAMP_LEN ? _n - i : OFDMFRAMESYNC_RAMP_LEN;
+
+        // block phasor, exp(-j(theta + i dtheta))
+        float phi = _theta + (float)i*_dtheta;
+        float br  =  cosf(phi);
+        float bi  = -sinf(phi);
+
+        k = 0;
+#if OFDMFRAMESYNC_USE_SSE2
+        __m128 vbr = _mm_set1_ps(br);
+        __m128 vbi = _mm_set1_ps(bi);
+        for (; k+2 <= len; k+=2) {
+            // phase ramp for subcarriers (i+k, i+k+1)
+            __m128 w  = ofdmframesync_cmul_sse2(_mm_loadu_ps(&step[2*k]), vbr, vbi);
+            __m128 wr = _mm_shuffle_ps(w, w, _MM_SHUFFLE(2,2,0,0));
+            __m128 wi = _mm_shuffle_ps(w, w, _MM_SHUFFLE(3,3,1,1));
+
+            // apply gain then phase
+            __m128 x = _mm_loadu_ps(&X[2*(i+k)]);
+            x = ofdmframesync_cmul_sse2(x, _mm_loadu_ps(&_Rr[2*(i+k)]), _mm_loadu_ps(&_Ri[2*(i+k)]));
+            x = ofdmframesync_cmul_sse2(x, wr, wi);
+            _mm_storeu_ps(&X[2*(i+k)], x);
+        }
+#endif
+        for (; k<len; k++) {
+            unsigned int j = 2*(i+k);
+            float wr = br*step[2*k+0] - bi*step[2*k+1];
+            float wi = br*step[2*k+1] + bi*step[2*k+0];
+            float yr = X[j]*_Rr[j] - X[j+1]*_Ri[j];
+            float yi = X[j]*_Ri[j] + X[j+1]*_Rr[j];
+            X[j+0] = yr*wr - yi*wi;
+            X[j+1] = yr*wi + yi*wr;
+        }
+        i += len;
+    }
+    return LIQUID_OK;
+}
+
 // enable debugging
 int ofdmframesync_debug_enable(ofdmframesync _q)
 {
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2007 - 2022 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <complex.h>
+#include <math.h>
+
+#include "autotest/autotest.h"
+#include "liquid.internal.h"
+
+// Helper function: track a two-path channel whose second path rotates
+// over time, starting from a perfect estimate of the initial channel;
+// returns error vector magnitude [dB] on data subcarriers over the
+// second half of the symbols; the subcarrier allocation is given by
+// _p, or the default allocation if NULL
+float testbench_ofdmchtrack(liquid_ofdmchtrack_method _method,
+                            unsigned int              _M,
+                            unsigned int              _num_symbols,
+                            const unsigned char *     _p)
+{
+    unsigned int M   = _M;
+    float a          = 0.5f;    // relative gain of second path
+    float tau        = 1.0f;    // delay of second path [samples]
+    float fd         = 0.004f;  // rotation of second path [cycles/symbol]
+    float nstd       = 0.01f;   // noise standard deviation
+
+    unsigned char p[M];
+    if (_p == NULL)
+        ofdmframe_init_default_sctype(M, p);
+    else
+        memmove(p, _p, M*sizeof(unsigned char));
+    ofdmchtrack q = ofdmchtrack_create(M, p);
+    ofdmchtrack_set_method(q, _method);
+    ofdmchtrack_set_scheme(q, LIQUID_MODEM_QPSK);
+
+    unsigned int M_null, M_pilot, M_data;
+    ofdmframe_validate_sctype(p, M, &M_null, &M_pilot, &M_data);
+
+    // equalizer from initial channel, real/imaginary parts each repeated
+    // twice as held by ofdmframesync
+    float Wr[2*M], Wi[2*M];
+    float complex H[M];
+    unsigned int i, n;
+    for (i=0; i<M; i++) {
+        H[i] = 1.0f + a*cexpf(-_Complex_I*2*M_PI*tau*(float)i/(float)M);
+        float complex w = p[i] == OFDMFRAME_SCTYPE_NULL ? 0.0f : 1.0f / H[i];
+        Wr[2*i+0] = Wr[2*i+1] = crealf(w);
+        Wi[2*i+0] = Wi[2*i+1] = cimagf(w);
+    }
+
+    float complex X[M];     // transmitted
+    float complex Y[M];     // received, equalized
+    float complex S[M_pilot];
+    float e2 = 0.0f;
+    unsigned int num_e2 = 0;
+    for (n=0; n<_num_symbols; n++) {
+        unsigned int j = 0;
+        for (i=0; i<M; i++) {
+            unsigned int k = (i + M/2) % M;
+            if (p[k] == OFDMFRAME_SCTYPE_NULL) {
+                X[k] = 0.0f;
+            } else if (p[k] == OFDMFRAME_SCTYPE_PILOT) {
+                X[k] = S[j++] = rand() & 1 ? 1.0f : -1.0f;
+            } else {
+                X[k] = ((rand() & 1 ? 1.0f : -1.0f) + _Complex_I*(rand() & 1 ? 1.0f : -1.0f)) * M_SQRT1_2;
+            }
+        }
+
+        // channel and noise
+        for (i=0; i<M; i++) {
+            H[i] = 1.0f + a*cexpf(_Complex_I*2*M_PI*(fd*n - tau*(float)i/(float)M));
+            float complex w = Wr[2*i] + _Complex_I*Wi[2*i];
+            Y[i] = w*(H[i]*X[i] + nstd*(randnf() + _Complex_I*randnf())*M_SQRT1_2);
+        }
+
+        ofdmchtrack_execute(q, Y, S, Wr, Wi);
+
+        // accumulate error over second half
+        if (n < _num_symbols/2)
+            continue;
+        for (i=0; i<M; i++) {
+            if (p[i] != OFDMFRAME_SCTYPE_DATA)
+                continue;
+            float complex e = Y[i] - X[i];
+            e2 += crealf(e)*crealf(e) + cimagf(e)*cimagf(e);
+            num_e2++;
+        }
+    }
+    ofdmchtrack_destroy(q);
+    return 10*log10f(e2 / (float)num_e2);
+}
+
+void autotest_ofdmchtrack_none()
+{
+    float evm = testbench_ofdmchtrack(LIQUID_OFDMCHTRACK_NONE, 64, 200, NULL);
+    if (liquid_autotest_verbose) printf("ofdmchtrack none  : %8.2f dB\n", evm);
+    CONTEND_GREATER_THAN(evm, -10.0f);
+}
+
+void autotest_ofdmchtrack_pilot()
+{
+    float evm = testbench_ofdmchtrack(LIQUID_OFDMCHTRACK_PILOT, 64, 200, NULL);
+    if (liquid_autotest_verbose) printf("ofdmchtrack pilot : %8.2f dB\n", evm);
+    CONTEND_LESS_THAN(evm, -22.0f);
+}
+
+void autotest_ofdmchtrack_dd()
+{
+    float evm = testbench_ofdmchtrack(LIQUID_OFDMCHTRACK_DD, 64, 200, NULL);
+    if (liquid_autotest_verbose) printf("ofdmchtrack dd    : %8.2f dB\n", evm);
+    CONTEND_LESS_THAN(evm, -32.0f);
+}
+
+void autotest_ofdmchtrack_dd_n1024()
+{
+    float evm = testbench_ofdmchtrack(LIQUID_OFDMCHTRACK_DD, 1024, 100, NULL);
+    if (liquid_autotest_verbose) printf("ofdmchtrack dd    : %8.2f dB\n", evm);
+    CONTEND_LESS_THAN(evm, -32.0f);
+}
+
+// full-band allocation with a pilot on the band edge at subcarrier M/2
+void autotest_ofdmchtrack_pilot_edge()
+{
+    unsigned int M = 64;
+    unsigned char p[M];
+    ofdmframe_init_sctype_range(M, -0.5f, 0.5f, p);
+    CONTEND_EQUALITY(p[M/2], OFDMFRAME_SCTYPE_PILOT);
+
+    // upper band edge is extrapolated from the outermost pilots over
+    // several subcarriers, so allow for a higher error floor
+    float evm = testbench_ofdmchtrack(LIQUID_OFDMCHTRACK_PILOT, M, 200, p);
+    if (liquid_autotest_verbose) printf("ofdmchtrack edge  : %8.2f dB\n", evm);
+    CONTEND_LESS_THAN(evm, -16.0f);
+}
+
+// vectorized equalizer inversion against direct evaluation
+void autotest_ofdmchtrack_invert()
+{
+    unsigned int n = 13;    // odd length to exercise remainder
+    float tol      = 1e-5f;
+
+    float complex H[n], H0[n], Y[n], Y0[n];
+    float Wr[2*n], Wi[2*n];
+    unsigned int i;
+    for (i=0; i<n; i++) {
+        H[i]  = randnf() + _Complex_I*randnf();
+        H0[i] = randnf() + _Complex_I*randnf();
+        Y[i]  = Y0[i] = randnf() + _Complex_I*randnf();
+    }
+    H[3] = 0.0f;    // null subcarrier
+    ofdmchtrack_invert(H, H0, Wr, Wi, Y, n);
+
+    for (i=0; i<n; i++) {
+        float complex w = i==3 ? 0.0f : 1.0f / H[i];
+        float complex y = Y0[i] * w * H0[i];
+        CONTEND_DELTA(Wr[2*i+0], crealf(w), tol);
+        CONTEND_DELTA(Wr[2*i+1], crealf(w), tol);
+        CONTEND_DELTA(Wi[2*i+0], cimagf(w), tol);
+        CONTEND_DELTA(Wi[2*i+1], cimagf(w), tol);
+        CONTEND_DELTA(crealf(Y[i]), crealf(y), tol);
+        CONTEND_DELTA(cimagf(Y[i]), cimagf(y), tol);
+    }
+}
+
+// relative error is limited in magnitude
+void autotest_ofdmchtrack_error()
+{
+    float tol = 1e-6f;
+    float complex u = ofdmchtrack_error(0.9f + 0.1f*_Complex_I, 1.0f);
+    CONTEND_DELTA(crealf(u),  0.1f, tol);
+    CONTEND_DELTA(cimagf(u), -0.1f, tol);
+
+    // far from reference: clipped to 1/2
+    u = ofdmchtrack_error(-3.0f, 1.0f);
+    CONTEND_DELTA(cabsf(u), 0.5f, tol);
+
+    // reference at origin is ignored
+    u = ofdmchtrack_error(1.0f, 0.0f);
+    CONTEND_EQUALITY(u, 0.0f);
+}
+
+void autotest_ofdmchtrack_invalid_config()
+{
+#if LIQUID_STRICT_EXIT
+    AUTOTEST_WARN("skipping ofdmchtrack config test with strict exit enabled");
+    return;
+#endif
+#if !LIQUID_SUPPRESS_ERROR_OUTPUT
+    fprintf(stderr,"warning: ignore potential errors here; checking for invalid configurations\n");
+#endif
+    CONTEND_ISNULL(ofdmchtrack_create( 0, NULL));
+    CONTEND_ISNULL(ofdmchtrack_create(63, NULL));
+
+    ofdmchtrack q = ofdmchtrack_create(64, NULL);
+    CONTEND_EQUALITY(LIQUID_OK, ofdmchtrack_print(q));
+    CONTEND_INEQUALITY(LIQUID_OK, ofdmchtrack_set_bandwidth(q, 0.0f));
+    CONTEND_INEQUALITY(LIQUID_OK, ofdmchtrack_set_bandwidth(q, 1.5f));
+    CONTEND_INEQUALITY(LIQUID_OK, ofdmchtrack_set_method(q, 7));
+    CONTEND_INEQUALITY(LIQUID_OK, ofdmchtrack_set_scheme(q, LIQUID_MODEM_NUM_SCHEMES));
+    CONTEND_EQUALITY  (LIQUID_OK, ofdmchtrack_set_scheme(q, LIQUID_MODEM_QAM16));
+    CONTEND_EQUALITY  (LIQUID_OK, ofdmchtrack_set_scheme(q, LIQUID_MODEM_UNKNOWN));
+    ofdmchtrack_destroy(q);
+}
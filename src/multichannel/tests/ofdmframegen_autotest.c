@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2007 - 2022 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <complex.h>
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// Helper function: compare symbol-by-symbol writes against a single
+// block write; outputs must be identical, including the tapered overlap
+// carried into the tail
+void testbench_ofdmframegen_write_block(unsigned int _M,
+                                        unsigned int _cp_len,
+                                        unsigned int _taper_len,
+                                        unsigned int _num_symbols)
+{
+    unsigned int M = _M;
+    unsigned int L = _M + _cp_len;
+
+    // two identical generators
+    ofdmframegen fg0 = ofdmframegen_create(M, _cp_len, _taper_len, NULL);
+    ofdmframegen fg1 = ofdmframegen_create(M, _cp_len, _taper_len, NULL);
+
+    float complex * X  = (float complex*) malloc(_num_symbols*M*sizeof(float complex));
+    float complex * y0 = (float complex*) malloc(_num_symbols*L*sizeof(float complex));
+    float complex * y1 = (float complex*) malloc(_num_symbols*L*sizeof(float complex));
+    float complex tail0[L];
+    float complex tail1[L];
+
+    unsigned int i;
+    for (i=0; i<_num_symbols*M; i++)
+        X[i] = (rand() & 1 ? 1.0f : -1.0f) + (rand() & 1 ? 1.0f : -1.0f)*_Complex_I;
+
+    // write preamble to both so taper state is carried into data symbols
+    ofdmframegen_write_S0a(fg0, tail0); ofdmframegen_write_S0a(fg1, tail1);
+    ofdmframegen_write_S0b(fg0, tail0); ofdmframegen_write_S0b(fg1, tail1);
+    ofdmframegen_write_S1 (fg0, tail0); ofdmframegen_write_S1 (fg1, tail1);
+
+    // symbol-by-symbol
+    for (i=0; i<_num_symbols; i++)
+        CONTEND_EQUALITY( ofdmframegen_writesymbol(fg0, &X[i*M], &y0[i*L]), LIQUID_OK );
+
+    // block
+    CONTEND_EQUALITY( ofdmframegen_write_block(fg1, X, _num_symbols, y1), LIQUID_OK );
+
+    CONTEND_SAME_DATA( y0, y1, _num_symbols*L*sizeof(float complex) );
+
+    // tail includes overlap from last symbol
+    ofdmframegen_writetail(fg0, tail0);
+    ofdmframegen_writetail(fg1, tail1);
+    CONTEND_SAME_DATA( tail0, tail1, _taper_len*sizeof(float complex) );
+
+    // clean up
+    ofdmframegen_destroy(fg0);
+    ofdmframegen_destroy(fg1);
+    free(X);
+    free(y0);
+    free(y1);
+}
+
+void autotest_ofdmframegen_write_block_n64()     { testbench_ofdmframegen_write_block(  64,  8, 4, 10); }
+void autotest_ofdmframegen_write_block_n256()    { testbench_ofdmframegen_write_block( 256, 32, 8,  5); }
+void autotest_ofdmframegen_write_block_notaper() { testbench_ofdmframegen_write_block( 128, 16, 0,  7); }
+void autotest_ofdmframegen_write_block_nocp()    { testbench_ofdmframegen_write_block(  64,  0, 0,  4); }
+
+// block write with zero symbols is a no-op
+void autotest_ofdmframegen_write_block_empty()
+{
+    ofdmframegen fg = ofdmframegen_create(64, 8, 4, NULL);
+    float complex X[64];
+    float complex y[72];
+    CONTEND_EQUALITY( ofdmframegen_write_block(fg, X, 0, y), LIQUID_OK );
+    ofdmframegen_destroy(fg);
+}
@@ -28,7 +28,7 @@
 #include <assert.h>
 
 #include "autotest/autotest.h"
-#include "liquid.h"
+#include "liquid.internal.h"
 
 
 // internal callback
@@ -142,4 +142,136 @@ void autotest_ofdmframesync_acquire_n64()   { ofdmframesync_acquire_test(64,  8,
 void autotest_ofdmframesync_acquire_n128()  { ofdmframesync_acquire_test(128, 16, 0); }
 void autotest_ofdmframesync_acquire_n256()  { ofdmframesync_acquire_test(256, 32, 0); }
 void autotest_ofdmframesync_acquire_n512()  { ofdmframesync_acquire_test(512, 64, 0); }
+void autotest_ofdmframesync_acquire_n2048() { ofdmframesync_acquire_test(2048,256,0); }
 
+// equalizer gain and phase ramp against direct evaluation
+void autotest_ofdmframesync_equalize()
+{
+    unsigned int n   = 37;      // odd length, spanning several ramp blocks
+    float theta      = 2.7f;    // phase of first subcarrier
+    float dtheta     = -0.093f; // phase step
+    float tol        = 1e-5f;
+
+    float complex X[n], Y[n], R[n];
+    float Rr[2*n], Ri[2*n];
+    unsigned int i;
+    for (i=0; i<n; i++) {
+        X[i] = randnf() + _Complex_I*randnf();
+        R[i] = randnf() + _Complex_I*randnf();
+        Rr[2*i+0] = Rr[2*i+1] = crealf(R[i]);
+        Ri[2*i+0] = Ri[2*i+1] = cimagf(R[i]);
+        Y[i] = X[i];
+    }
+    ofdmframesync_equalize(Y, Rr, Ri, n, theta, dtheta);
+
+    for (i=0; i<n; i++) {
+        float complex y = X[i] * R[i] * cexpf(-_Complex_I*(theta + i*dtheta));
+        CONTEND_DELTA(crealf(Y[i]), crealf(y), tol);
+        CONTEND_DELTA(cimagf(Y[i]), cimagf(y), tol);
+    }
+}
+
+// received symbols recorded by block test callback
+struct ofdmframesync_block_rx {
+    unsigned int    M;              // number of subcarriers
+    unsigned int    num_symbols;    // capacity of X
+    unsigned int    num_received;   // number of times callback was invoked
+    float complex * X;              // received symbols [size: num_symbols x M]
+};
+
+static int ofdmframesync_block_callback(float complex * _X,
+                                        unsigned char * _p,
+                                        unsigned int    _M,
+                                        void *          _userdata)
+{
+    struct ofdmframesync_block_rx * rx = (struct ofdmframesync_block_rx*) _userdata;
+    if (rx->num_received < rx->num_symbols)
+        memmove(&rx->X[rx->num_received*rx->M], _X, _M*sizeof(float complex));
+    rx->num_received++;
+    return 0;
+}
+
+// receiving a frame in one call or in arbitrarily sized pieces through the
+// block receive path recovers the transmitted symbols, and agrees with the
+// per-sample path (used while debugging is enabled)
+void autotest_ofdmframesync_block()
+{
+    unsigned int M           = 128;
+    unsigned int cp_len      = 16;
+    unsigned int num_symbols = 6;
+    unsigned int num_samples = (3 + num_symbols)*(M + cp_len);
+    float        tol         = 1e-2f;   // error tolerance against transmitted
+    float        tol_path    = 1e-4f;   // error tolerance between receive paths
+
+    unsigned char p[M];
+    ofdmframe_init_default_sctype(M, p);
+
+    // generate frame, recording transmitted symbols
+    ofdmframegen fg = ofdmframegen_create(M, cp_len, 0, p);
+    float complex X[num_symbols*M];
+    float complex y[num_samples];
+    unsigned int i, j, n=0;
+    ofdmframegen_write_S0a(fg, &y[n]); n += M + cp_len;
+    ofdmframegen_write_S0b(fg, &y[n]); n += M + cp_len;
+    ofdmframegen_write_S1( fg, &y[n]); n += M + cp_len;
+    for (j=0; j<num_symbols; j++) {
+        for (i=0; i<M; i++)
+            X[j*M+i] = cexpf(_Complex_I*2*M_PI*randf());
+        ofdmframegen_writesymbol(fg, &X[j*M], &y[n]);
+        n += M + cp_len;
+    }
+    for (i=0; i<num_samples; i++)
+        y[i] *= cexpf(_Complex_I*0.003f*i);
+
+    // receivers: per-sample reference, whole frame, pieces of varying length
+    float complex X_rx[3][num_symbols*M];
+    struct ofdmframesync_block_rx rx[3];
+    unsigned int r;
+    for (r=0; r<3; r++) {
+        rx[r].M            = M;
+        rx[r].num_symbols  = num_symbols;
+        rx[r].num_received = 0;
+        rx[r].X            = X_rx[r];
+        memset(X_rx[r], 0x00, sizeof(X_rx[r]));
+
+        ofdmframesync fs = ofdmframesync_create(M,cp_len,0,p,ofdmframesync_block_callback,(void*)&rx[r]);
+        if (r == 0) {
+            // debugging forces the per-sample path
+            if (ofdmframesync_debug_enable(fs) != LIQUID_OK) {
+                AUTOTEST_WARN("ofdmframesync debugging disabled; skipping per-sample reference");
+                rx[r].num_received = num_symbols;
+                memmove(X_rx[r], X, sizeof(X));
+                ofdmframesync_destroy(fs);
+                continue;
+            }
+        }
+        if (r < 2) {
+            ofdmframesync_execute(fs, y, num_samples);
+        } else {
+            for (n=0; n<num_samples; ) {
+                unsigned int k = 1 + (n % 97);
+                k = n + k > num_samples ? num_samples - n : k;
+                ofdmframesync_execute(fs, &y[n], k);
+                n += k;
+            }
+        }
+        ofdmframesync_destroy(fs);
+    }
+
+    // every receiver recovers each symbol once, matching the transmitted
+    // data and the per-sample reference
+    for (r=0; r<3; r++) {
+        CONTEND_EQUALITY(rx[r].num_received, num_symbols);
+        for (j=0; j<num_symbols; j++) {
+            for (i=0; i<M; i++) {
+                if (p[i] != OFDMFRAME_SCTYPE_DATA)
+                    continue;
+                CONTEND_DELTA(cabsf(X_rx[r][j*M+i] - X[j*M+i]), 0.0f, tol);
+                if (r > 0)
+                    CONTEND_DELTA(cabsf(X_rx[r][j*M+i] - X_rx[0][j*M+i]), 0.0f, tol_path);
+            }
+        }
+    }
+
+    ofdmframegen_destroy(fg);
+}
@@ -99,3 +99,40 @@ void benchmark_nco_mix_block_up(struct rusage *_start,
     nco_crcf_destroy(p);
 }
 
+
+// Helper function to benchmark block mixing methods
+void nco_mix_block_bench(struct rusage *     _start,
+                         struct rusage *     _finish,
+                         unsigned long int * _num_iterations,
+                         liquid_ncomix       _method)
+{
+    float complex x[256], y[256];
+    memset(x, 0, 256*sizeof(float complex));
+
+    nco_crcf p = nco_crcf_create(LIQUID_NCO);
+    nco_crcf_set_mix_method(p, _method);
+    nco_crcf_set_phase(p, 0.0f);
+    nco_crcf_set_frequency(p, 0.1f);
+
+    unsigned int i;
+    *_num_iterations /= 16;
+
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        nco_crcf_mix_block_up(p, x, y, 256);
+    }
+    getrusage(RUSAGE_SELF, _finish);
+
+    *_num_iterations *= 256;
+    nco_crcf_destroy(p);
+}
+
+#define NCO_MIX_BLOCK_BENCHMARK_API(METHOD) \
+(   struct rusage *     _start,             \
+    struct rusage *     _finish,            \
+    unsigned long int * _num_iterations)    \
+{ nco_mix_block_bench(_start, _finish, _num_iterations, METHOD); }
+
+void benchmark_nco_mix_block_table  NCO_MIX_BLOCK_BENCHMARK_API(LIQUID_NCO_MIX_TABLE)
+void benchmark_nco_mix_block_poly   NCO_MIX_BLOCK_BENCHMARK_API(LIQUID_NCO_MIX_POLY)
+void benchmark_nco_mix_block_rotate NCO_MIX_BLOCK_BENCHMARK_API(LIQUID_NCO_MIX_ROTATE)
@@ -39,8 +39,9 @@
 struct NCO(_s) {
     liquid_ncotype  type;           // NCO type (e.g. LIQUID_VCO)
     T               sintab[1024];   // sine look-up table
-    uint32_t        theta;          // 32-bit phase     [radians]
-    uint32_t        d_theta;        // 32-bit frequency [radians/sample]
+    uint64_t        theta;          // 64-bit phase     [radians]
+    uint64_t        d_theta;        // 64-bit frequency [radians/sample]
+    liquid_ncomix   mix_method;     // sin/cos method (e.g. LIQUID_NCO_MIX_TABLE)
 
     // phase-locked loop
     T               alpha;          // frequency proportion
@@ -60,16 +61,42 @@ int NCO(_compute_sincos_vco)(NCO() _q);
 int NCO(_pll_reset)(NCO() _q);
 
 // constrain phase (or frequency) and convert to fixed-point
-uint32_t NCO(_constrain)(float _theta);
+uint64_t NCO(_constrain)(float _theta);
 
 // compute index for sine look-up table
 unsigned int NCO(_index)(NCO() _q);
 
+// compute sin(2 pi _p / 2^32) with a polynomial approximation
+T NCO(_sin_poly)(uint32_t _p);
+
+// block mixing kernels; _dir is +1 to mix up and -1 to mix down
+int NCO(_mix_block_table) (NCO() _q, TC * _x, TC * _y, unsigned int _n, int _dir);
+int NCO(_mix_block_poly)  (NCO() _q, TC * _x, TC * _y, unsigned int _n, int _dir);
+int NCO(_mix_block_rotate)(NCO() _q, TC * _x, TC * _y, unsigned int _n, int _dir);
+
+// number of phases computed at a time by polynomial block mixer
+#define NCO_POLY_BLOCK_LEN      (8)
+
+// fold phase _x in turns, [-1/2,1/2), into [-1/4,1/4] using
+// sin(pi - t) = sin(t), without branching
+#define NCO_SIN_FOLD(_x) copysignf(0.25f - fabsf(0.25f - fabsf(_x)), _x)
+
+// odd Taylor series of sin(t), |t| <= pi/2, given t and t^2;
+// truncation error is below 6e-8
+#define NCO_SIN_POLY(_t,_t2) ((_t)*(1.0f + (_t2)*(-1.666666667e-1f +    \
+    (_t2)*(8.333333333e-3f + (_t2)*(-1.984126984e-4f + (_t2)*(          \
+    2.755731922e-6f + (_t2)*(-2.505210839e-8f)))))))
+
+// number of samples between re-computing the phasor from the phase
+// accumulator in the complex-rotation block mixer
+#define NCO_ROTATE_RENORM_LEN   (64)
+
 // create nco/vco object
 NCO() NCO(_create)(liquid_ncotype _type)
 {
     NCO() q = (NCO()) malloc(sizeof(struct NCO(_s)));
     q->type = _type;
+    q->mix_method = LIQUID_NCO_MIX_TABLE;
 
     // initialize sine table
     unsigned int i;
@@ -98,7 +125,7 @@ int NCO(_destroy)(NCO() _q)
 int NCO(_print)(NCO() _q)
 {
     printf("nco [phase: 0x%.8x rad, freq: 0x%.8x rad/sample]\n",
-            _q->theta, _q->d_theta);
+            (uint32_t)(_q->theta >> 32), (uint32_t)(_q->d_theta >> 32));
 #if LIQUID_DEBUG_NCO
     // print entire table
     unsigned int i;
@@ -151,6 +178,28 @@ int NCO(_adjust_phase)(NCO() _q,
     return LIQUID_OK;
 }
 
+// set method used to compute sine and cosine of internal phase
+int NCO(_set_mix_method)(NCO()         _q,
+                         liquid_ncomix _method)
+{
+    switch (_method) {
+    case LIQUID_NCO_MIX_TABLE:
+    case LIQUID_NCO_MIX_POLY:
+    case LIQUID_NCO_MIX_ROTATE:
+        break;
+    default:
+        return liquid_error(LIQUID_EICONFIG,"nco_%s_set_mix_method(), invalid method: %d", EXTENSION, _method);
+    }
+    _q->mix_method = _method;
+    return LIQUID_OK;
+}
+
+// get method used to compute sine and cosine of internal phase
+liquid_ncomix NCO(_get_mix_method)(NCO() _q)
+{
+    return _q->mix_method;
+}
+
 // increment internal phase of nco object
 int NCO(_step)(NCO() _q)
 {
@@ -161,25 +210,31 @@ int NCO(_step)(NCO() _q)
 // get phase [radians]
 T NCO(_get_phase)(NCO() _q)
 {
-    return 2.0f*LIQUID_PI*(float)_q->theta / (float)(1LLU<<32);
+    return 2.0f*LIQUID_PI*(float)((double)_q->theta / 18446744073709551616.0);
 }
 
 // get frequency [radians/sample]
 T NCO(_get_frequency)(NCO() _q)
 {
-    float d_theta = 2.0f*LIQUID_PI*(float)_q->d_theta / (float)(1LLU<<32);
+    float d_theta = 2.0f*LIQUID_PI*(float)((double)_q->d_theta / 18446744073709551616.0);
     return d_theta > LIQUID_PI ? d_theta - 2*LIQUID_PI : d_theta;
 }
 
 // compute sine, cosine internally
 T NCO(_sin)(NCO() _q)
 {
+    if (_q->mix_method != LIQUID_NCO_MIX_TABLE)
+        return NCO(_sin_poly)((uint32_t)(_q->theta >> 32));
+
     unsigned int index = NCO(_index)(_q);
     return _q->sintab[index];
 }
 
 T NCO(_cos)(NCO() _q)
 {
+    if (_q->mix_method != LIQUID_NCO_MIX_TABLE)
+        return NCO(_sin_poly)((uint32_t)(_q->theta >> 32) + 0x40000000);
+
     // add pi/2 phase shift
     unsigned int index = (NCO(_index)(_q) + 256) & 0x3ff;
     return _q->sintab[index];
@@ -190,6 +245,13 @@ int NCO(_sincos)(NCO() _q,
                  T *   _s,
                  T *   _c)
 {
+    if (_q->mix_method != LIQUID_NCO_MIX_TABLE) {
+        uint32_t p = (uint32_t)(_q->theta >> 32);
+        *_s = NCO(_sin_poly)(p);
+        *_c = NCO(_sin_poly)(p + 0x40000000);
+        return LIQUID_OK;
+    }
+
     // add pi/2 phase shift
     unsigned int index = NCO(_index)(_q);
 
@@ -287,7 +349,6 @@ int NCO(_mix_down)(NCO() _q,
 
 // Rotate input vector array up by NCO angle:
 //      y(t) = x(t) exp{+j (f*t + theta)}
-// TODO : implement NCO/VCO-specific versions
 //  _q      :   nco object
 //  _x      :   input array [size: _n x 1]
 //  _y      :   output sample [size: _n x 1]
@@ -297,35 +358,16 @@ int NCO(_mix_block_up)(NCO()        _q,
                        TC *         _y,
                        unsigned int _n)
 {
-    unsigned int i;
-    // FIXME: this method should be more efficient but is causing occasional
-    //        errors so instead favor slower but more reliable algorithm
-#if 0
-    T theta =   _q->theta;
-    T d_theta = _q->d_theta;
-    for (i=0; i<_n; i++) {
-        // multiply _x[i] by [cos(theta) + _Complex_I*sin(theta)]
-        _y[i] = _x[i] * liquid_cexpjf(theta);
-        
-        theta += d_theta;
-    }
-
-    NCO(_set_phase)(_q, theta);
-#else
-    for (i=0; i<_n; i++) {
-        // mix single sample up
-        NCO(_mix_up)(_q, _x[i], &_y[i]);
-
-        // step NCO phase
-        NCO(_step)(_q);
+    switch (_q->mix_method) {
+    case LIQUID_NCO_MIX_POLY:   return NCO(_mix_block_poly)  (_q, _x, _y, _n,  1);
+    case LIQUID_NCO_MIX_ROTATE: return NCO(_mix_block_rotate)(_q, _x, _y, _n,  1);
+    default:;
     }
-#endif
-    return LIQUID_OK;
+    return NCO(_mix_block_table)(_q, _x, _y, _n, 1);
 }
 
 // Rotate input vector array down by NCO angle:
 //      y(t) = x(t) exp{-j (f*t + theta)}
-// TODO : implement NCO/VCO-specific versions
 //  _q      :   nco object
 //  _x      :   input array [size: _n x 1]
 //  _y      :   output sample [size: _n x 1]
@@ -335,30 +377,12 @@ int NCO(_mix_block_down)(NCO()        _q,
                          TC *         _y,
                          unsigned int _n)
 {
-    unsigned int i;
-    // FIXME: this method should be more efficient but is causing occasional
-    //        errors so instead favor slower but more reliable algorithm
-#if 0
-    T theta =   _q->theta;
-    T d_theta = _q->d_theta;
-    for (i=0; i<_n; i++) {
-        // multiply _x[i] by [cos(-theta) + _Complex_I*sin(-theta)]
-        _y[i] = _x[i] * liquid_cexpjf(-theta);
-        
-        theta += d_theta;
-    }
-
-    NCO(_set_phase)(_q, theta);
-#else
-    for (i=0; i<_n; i++) {
-        // mix single sample down
-        NCO(_mix_down)(_q, _x[i], &_y[i]);
-
-        // step NCO phase
-        NCO(_step)(_q);
+    switch (_q->mix_method) {
+    case LIQUID_NCO_MIX_POLY:   return NCO(_mix_block_poly)  (_q, _x, _y, _n, -1);
+    case LIQUID_NCO_MIX_ROTATE: return NCO(_mix_block_rotate)(_q, _x, _y, _n, -1);
+    default:;
     }
-#endif
-    return LIQUID_OK;
+    return NCO(_mix_block_table)(_q, _x, _y, _n, -1);
 }
 
 //
@@ -366,26 +390,156 @@ int NCO(_mix_block_down)(NCO()        _q,
 //
 
 // constrain phase (or frequency) and convert to fixed-point
-uint32_t NCO(_constrain)(float _theta)
+uint64_t NCO(_constrain)(float _theta)
 {
-    // divide value by 2*pi and compute modulo
-    float p = _theta * 0.159154943091895;   // 1/(2 pi) ~ 0.159154943091895
+    // divide magnitude by 2*pi and extract fractional part in [0,1)
+    double p     = fabs((double)_theta) * 0.15915494309189533577;   // 1/(2 pi)
+    double fpart = p - floor(p);
 
-    // extract fractional part of p
-    float fpart = p - ((long)p);    // fpart is in (-1,1)
-
-    // ensure fpart is in [0,1)
-    if (fpart < 0.) fpart += 1.;
-
-    // map to range of precision needed
-    uint32_t retVal = (uint32_t)(fpart * 0xffffffff);
-    return retVal >= UINT_MAX ? UINT_MAX : retVal;
+    // map to 64-bit fixed point, negating (modulo 2^64) for negative values
+    uint64_t retVal = (uint64_t)(fpart * 18446744073709551616.0);   // 2^64
+    return _theta < 0 ? -retVal : retVal;
 }
 
 // compute index for sine look-up table
 unsigned int NCO(_index)(NCO() _q)
 {
-    //return (_q->theta >> 22) & 0x3ff; // round down
-    return ((_q->theta + (1<<21)) >> 22) & 0x3ff; // round appropriately
+    uint32_t theta = (uint32_t)(_q->theta >> 32);
+    //return (theta >> 22) & 0x3ff; // round down
+    return ((theta + (1<<21)) >> 22) & 0x3ff; // round appropriately
+}
+
+// compute sin(2 pi _p / 2^32) with a polynomial approximation
+T NCO(_sin_poly)(uint32_t _p)
+{
+    // phase in turns, [-1/2, 1/2)
+    T x = (T)((int32_t)_p) * 2.3283064365386962890625e-10f; // 2^-32
+
+    // fold into [-1/4,1/4] turns and evaluate polynomial
+    T t = 2.0f*LIQUID_PI*NCO_SIN_FOLD(x);
+    return NCO_SIN_POLY(t, t*t);
+}
+
+// mix block of samples with 1024-point sine look-up table
+int NCO(_mix_block_table)(NCO()        _q,
+                          TC *         _x,
+                          TC *         _y,
+                          unsigned int _n,
+                          int          _dir)
+{
+    T * x = (T*) _x;
+    T * y = (T*) _y;
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        unsigned int index = NCO(_index)(_q);
+        T vsin = _dir * _q->sintab[(index    )        ];
+        T vcos =        _q->sintab[(index+256) & 0x3ff];
+
+        // rotate input
+        T xr = x[2*i+0];
+        T xi = x[2*i+1];
+        y[2*i+0] = xr*vcos - xi*vsin;
+        y[2*i+1] = xr*vsin + xi*vcos;
+
+        // step NCO phase
+        _q->theta += _q->d_theta;
+    }
+    return LIQUID_OK;
+}
+
+// mix block of samples, evaluating sin/cos polynomials for
+// NCO_POLY_BLOCK_LEN phases (theta, theta+dtheta, ...) at a time
+int NCO(_mix_block_poly)(NCO()        _q,
+                         TC *         _x,
+                         TC *         _y,
+                         unsigned int _n,
+                         int          _dir)
+{
+    T * x = (T*) _x;
+    T * y = (T*) _y;
+    uint64_t theta  = _q->theta;
+    uint64_t offset[NCO_POLY_BLOCK_LEN];
+    int32_t  p     [2*NCO_POLY_BLOCK_LEN];  // phases: sine lanes, cosine lanes
+    T        v     [2*NCO_POLY_BLOCK_LEN];  // sin/cos outputs
+    T *      vsin = v;
+    T *      vcos = v + NCO_POLY_BLOCK_LEN;
+    unsigned int i, j;
+
+    // phase offset of each lane
+    for (j=0; j<NCO_POLY_BLOCK_LEN; j++)
+        offset[j] = j * _q->d_theta;
+
+    for (i=0; i<_n; i+=NCO_POLY_BLOCK_LEN) {
+        // compute phase of each lane; cosine is sine shifted by a quarter turn
+        for (j=0; j<NCO_POLY_BLOCK_LEN; j++) {
+            p[j]                    = (int32_t)(uint32_t)((theta + offset[j]) >> 32);
+            p[j+NCO_POLY_BLOCK_LEN] = (int32_t)((uint32_t)p[j] + 0x40000000);
+        }
+
+        // evaluate polynomial for all lanes (fixed length, no dependencies)
+        for (j=0; j<2*NCO_POLY_BLOCK_LEN; j++) {
+            T t = 2.0f*LIQUID_PI*NCO_SIN_FOLD((T)p[j] * 2.3283064365386962890625e-10f);
+            v[j] = NCO_SIN_POLY(t, t*t);
+        }
+        if (_dir < 0) {
+            for (j=0; j<NCO_POLY_BLOCK_LEN; j++)
+                vsin[j] = -vsin[j];
+        }
+
+        // rotate inputs
+        unsigned int n = _n - i < NCO_POLY_BLOCK_LEN ? _n - i : NCO_POLY_BLOCK_LEN;
+        for (j=0; j<n; j++) {
+            T xr = x[2*(i+j)+0];
+            T xi = x[2*(i+j)+1];
+            y[2*(i+j)+0] = xr*vcos[j] - xi*vsin[j];
+            y[2*(i+j)+1] = xr*vsin[j] + xi*vcos[j];
+        }
+        theta += n * _q->d_theta;
+    }
+    _q->theta = theta;
+    return LIQUID_OK;
+}
+
+// mix block of samples by repeatedly rotating a phasor by exp{j dtheta};
+// the phasor is re-computed from the phase accumulator every
+// NCO_ROTATE_RENORM_LEN samples which keeps its magnitude at unity and
+// prevents the phase from drifting away from the accumulator's
+int NCO(_mix_block_rotate)(NCO()        _q,
+                           TC *         _x,
+                           TC *         _y,
+                           unsigned int _n,
+                           int          _dir)
+{
+    T * x = (T*) _x;
+    T * y = (T*) _y;
+
+    // rotation per sample
+    uint32_t dp   = (uint32_t)(_q->d_theta >> 32);
+    T        wsin = _dir * NCO(_sin_poly)(dp);
+    T        wcos =        NCO(_sin_poly)(dp + 0x40000000);
+
+    unsigned int i, j;
+    for (i=0; i<_n; i+=NCO_ROTATE_RENORM_LEN) {
+        // compute phasor from phase accumulator
+        uint32_t p    = (uint32_t)(_q->theta >> 32);
+        T        vsin = _dir * NCO(_sin_poly)(p);
+        T        vcos =        NCO(_sin_poly)(p + 0x40000000);
+
+        unsigned int n = _n - i < NCO_ROTATE_RENORM_LEN ? _n - i : NCO_ROTATE_RENORM_LEN;
+        for (j=i; j<i+n; j++) {
+            // rotate input
+            T xr = x[2*j+0];
+            T xi = x[2*j+1];
+            y[2*j+0] = xr*vcos - xi*vsin;
+            y[2*j+1] = xr*vsin + xi*vcos;
+
+            // advance phasor
+            T t  = vcos*wcos - vsin*wsin;
+            vsin = vcos*wsin + vsin*wcos;
+            vcos = t;
+        }
+        _q->theta += n * _q->d_theta;
+    }
+    return LIQUID_OK;
 }
 
@@ -22,6 +22,8 @@
 
 #include <stdlib.h>
 #include <complex.h>
+#include <math.h>
+#include <stdio.h>
 #include "autotest/autotest.h"
 #include "liquid.h"
 
@@ -89,3 +91,89 @@ void autotest_nco_crcf_mix_vco_7() { testbench_nco_crcf_mix(LIQUID_VCO,  0.000f,
 void autotest_nco_crcf_mix_vco_8() { testbench_nco_crcf_mix(LIQUID_VCO,  0.000f, -0.123f); }
 void autotest_nco_crcf_mix_vco_9() { testbench_nco_crcf_mix(LIQUID_VCO,  0.000f,  1e-5f ); }
 
+
+// test block mixing methods against double-precision reference, checking
+// both that the phase tracks exactly and the worst-case phasor error
+// (which bounds the spurious level of the output)
+void testbench_nco_crcf_mix_method(liquid_ncomix _method,
+                                   float         _frequency,
+                                   float         _tol)
+{
+    unsigned int buf_len = 2500;    // not a multiple of internal block sizes
+    float        phase   = 0.7f;
+
+    // create and initialize object
+    nco_crcf nco = nco_crcf_create(LIQUID_NCO);
+    CONTEND_EQUALITY(nco_crcf_set_mix_method(nco, _method), LIQUID_OK);
+    CONTEND_EQUALITY(nco_crcf_get_mix_method(nco), _method);
+    nco_crcf_set_phase    (nco, phase);
+    nco_crcf_set_frequency(nco, _frequency);
+
+    // mix constant signal up and back down in irregular blocks
+    float complex buf_0[buf_len];
+    float complex buf_1[buf_len];
+    unsigned int i;
+    for (i=0; i<buf_len; i++)
+        buf_0[i] = 1.0f;
+    nco_crcf_mix_block_up(nco, buf_0,      buf_1,      1000);
+    nco_crcf_mix_block_up(nco, buf_0+1000, buf_1+1000,   13);
+    nco_crcf_mix_block_up(nco, buf_0+1013, buf_1+1013, 1487);
+
+    // compare to reference
+    float err_max = 0.0f;
+    for (i=0; i<buf_len; i++) {
+        double theta = (double)phase + (double)_frequency * (double)i;
+        float err = cabsf(buf_1[i] - (float complex)cexp(_Complex_I*theta));
+        err_max = err > err_max ? err : err_max;
+    }
+    if (liquid_autotest_verbose)
+        printf("  method %d, max error: %.3e (%.1f dB)\n", _method, err_max, 20*log10f(err_max));
+    CONTEND_LESS_THAN(err_max, _tol);
+
+    // mixing down should undo mixing up
+    nco_crcf_set_phase(nco, phase);
+    nco_crcf_mix_block_down(nco, buf_1, buf_1, buf_len);
+    for (i=0; i<buf_len; i++)
+        CONTEND_DELTA(cabsf(buf_1[i] - 1.0f), 0.0f, 2*_tol);
+
+    // destroy object
+    nco_crcf_destroy(nco);
+}
+
+void autotest_nco_crcf_mix_table_0()  { testbench_nco_crcf_mix_method(LIQUID_NCO_MIX_TABLE,  0.1234f, 4e-3f); }
+void autotest_nco_crcf_mix_poly_0()   { testbench_nco_crcf_mix_method(LIQUID_NCO_MIX_POLY,   0.1234f, 2e-6f); }
+void autotest_nco_crcf_mix_poly_1()   { testbench_nco_crcf_mix_method(LIQUID_NCO_MIX_POLY,  -2.9000f, 2e-6f); }
+void autotest_nco_crcf_mix_rotate_0() { testbench_nco_crcf_mix_method(LIQUID_NCO_MIX_ROTATE, 0.1234f, 2e-5f); }
+void autotest_nco_crcf_mix_rotate_1() { testbench_nco_crcf_mix_method(LIQUID_NCO_MIX_ROTATE,-2.9000f, 2e-5f); }
+
+// the phase accumulator holds much finer frequencies than 32 bits allow
+void autotest_nco_crcf_frequency_resolution()
+{
+    nco_crcf nco = nco_crcf_create(LIQUID_NCO);
+    float dtheta = 1e-9f;   // below 32-bit resolution (~1.46e-9)
+    nco_crcf_set_frequency(nco, dtheta);
+    CONTEND_DELTA(nco_crcf_get_frequency(nco), dtheta, 1e-15f);
+
+    // advance phase 1e6 steps
+    unsigned int i;
+    for (i=0; i<1000000; i++)
+        nco_crcf_step(nco);
+    CONTEND_DELTA(nco_crcf_get_phase(nco), 1e-3f, 1e-8f);
+    nco_crcf_destroy(nco);
+}
+
+// invalid configuration
+void autotest_nco_crcf_mix_method_invalid()
+{
+#if LIQUID_STRICT_EXIT
+    AUTOTEST_WARN("skipping nco_crcf mix method test with strict exit enabled\n");
+    return;
+#endif
+#if !LIQUID_SUPPRESS_ERROR_OUTPUT
+    fprintf(stderr,"warning: ignore potential errors here; checking for invalid configurations\n");
+#endif
+    nco_crcf nco = nco_crcf_create(LIQUID_VCO);
+    CONTEND_INEQUALITY(nco_crcf_set_mix_method(nco, (liquid_ncomix)99), LIQUID_OK);
+    CONTEND_EQUALITY  (nco_crcf_get_mix_method(nco), LIQUID_NCO_MIX_TABLE);
+    nco_crcf_destroy(nco);
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2007 - 2022 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <sys/resource.h>
+#include "liquid.h"
+
+#define RANDGEN_BENCH_LEN   (1024)
+
+// generate block of uniform random numbers
+void benchmark_randgen_uniform_n1024(struct rusage *     _start,
+                                     struct rusage *     _finish,
+                                     unsigned long int * _num_iterations)
+{
+    *_num_iterations /= 100;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    float x[RANDGEN_BENCH_LEN];
+    randgen q = randgen_create(1, 0);
+    unsigned long int i;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++)
+        randgen_uniform(q, x, RANDGEN_BENCH_LEN);
+    getrusage(RUSAGE_SELF, _finish);
+
+    randgen_destroy(q);
+}
+
+// generate block of Gauss random numbers
+void benchmark_randgen_normal_n1024(struct rusage *     _start,
+                                    struct rusage *     _finish,
+                                    unsigned long int * _num_iterations)
+{
+    *_num_iterations /= 100;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    float x[RANDGEN_BENCH_LEN];
+    randgen q = randgen_create(1, 0);
+    unsigned long int i;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++)
+        randgen_normal(q, x, RANDGEN_BENCH_LEN);
+    getrusage(RUSAGE_SELF, _finish);
+
+    randgen_destroy(q);
+}
+
+// reference: randnf() one sample at a time
+void benchmark_randgen_randnf_n1024(struct rusage *     _start,
+                                    struct rusage *     _finish,
+                                    unsigned long int * _num_iterations)
+{
+    *_num_iterations /= 100;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    float x[RANDGEN_BENCH_LEN];
+    unsigned long int i;
+    unsigned int j;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        for (j=0; j<RANDGEN_BENCH_LEN; j++)
+            x[j] = randnf();
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    (void)x;
+}
+
+// apply AWGN channel to block of samples
+void benchmark_randgen_channel_awgn_n1024(struct rusage *     _start,
+                                          struct rusage *     _finish,
+                                          unsigned long int * _num_iterations)
+{
+    *_num_iterations /= 100;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    float complex x[RANDGEN_BENCH_LEN];
+    unsigned long int i;
+    for (i=0; i<RANDGEN_BENCH_LEN; i++)
+        x[i] = 1.0f;
+    channel_cccf q = channel_cccf_create();
+    channel_cccf_add_awgn(q, -40.0f, 20.0f);
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++)
+        channel_cccf_execute_block(q, x, RANDGEN_BENCH_LEN, x);
+    getrusage(RUSAGE_SELF, _finish);
+
+    channel_cccf_destroy(q);
+}
+
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <stdlib.h>
+#include <sys/resource.h>
+#include "liquid.h"
+
+// Helper function to keep code base small
+void scramble_bench(struct rusage *     _start,
+                    struct rusage *     _finish,
+                    unsigned long int * _num_iterations,
+                    unsigned int        _n,
+                    int                 _soft)
+{
+    // normalize number of iterations
+    *_num_iterations *= 100;
+    *_num_iterations /= _soft ? 8*_n : _n;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    unsigned int len = _soft ? 8*_n : _n;
+    unsigned char x[len];
+    unsigned long int i;
+    for (i=0; i<len; i++)
+        x[i] = rand() & 0xff;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    if (_soft) {
+        for (i=0; i<(*_num_iterations); i++) {
+            unscramble_data_soft(x, _n);
+            unscramble_data_soft(x, _n);
+            unscramble_data_soft(x, _n);
+            unscramble_data_soft(x, _n);
+        }
+    } else {
+        for (i=0; i<(*_num_iterations); i++) {
+            scramble_data(x, _n);
+            scramble_data(x, _n);
+            scramble_data(x, _n);
+            scramble_data(x, _n);
+        }
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= 4;
+}
+
+#define SCRAMBLE_BENCHMARK_API(N,SOFT)      \
+(   struct rusage *_start,                  \
+    struct rusage *_finish,                 \
+    unsigned long int *_num_iterations)     \
+{ scramble_bench(_start, _finish, _num_iterations, N, SOFT); }
+
+// 
+void benchmark_scramble_n256        SCRAMBLE_BENCHMARK_API(256, 0)
+void benchmark_scramble_n1024       SCRAMBLE_BENCHMARK_API(1024,0)
+void benchmark_unscramble_soft_n256 SCRAMBLE_BENCHMARK_API(256, 1)
+void benchmark_unscramble_soft_n1024 SCRAMBLE_BENCHMARK_API(1024,1)
+
@@ -0,0 +1,485 @@
+/*
+ * Copyright (c) 2007 - 2022 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Counter-based random number generator (Philox-4x32-10) with explicit
+// per-stream state, and block generators for common distributions
+//
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "liquid.internal.h"
+
+#if HAVE_SSE41 && HAVE_SMMINTRIN_H
+#include <smmintrin.h>
+#define RANDGEN_USE_SSE41 1
+#else
+#define RANDGEN_USE_SSE41 0
+#endif
+
+// Philox-4x32 multipliers and Weyl key increments
+#define PHILOX_M0   (0xD2511F53)
+#define PHILOX_M1   (0xCD9E8D57)
+#define PHILOX_W0   (0x9E3779B9)
+#define PHILOX_W1   (0xBB67AE85)
+#define PHILOX_R    (10)
+
+// number of 4-word blocks generated per refill
+#define RANDGEN_NUM_BLOCKS  (16)
+#define RANDGEN_BUF_LEN     (4*RANDGEN_NUM_BLOCKS)
+
+// Ziggurat layers for normal generator, right-most layer boundary
+#define RANDGEN_ZIG_N       (128)
+#define RANDGEN_ZIG_R       (3.442619855899)
+
+struct randgen_s {
+    uint32_t key[2];    // key (seed)
+    uint64_t ctr;       // block counter
+    uint32_t stream[2]; // stream identifier (upper counter words)
+
+    // buffered output words
+    uint32_t     buf[RANDGEN_BUF_LEN];
+    unsigned int buf_index;
+
+    // Ziggurat tables for normal generator (24-bit magnitudes)
+    uint32_t kn[RANDGEN_ZIG_N];
+    float    wn[RANDGEN_ZIG_N];
+    float    fn[RANDGEN_ZIG_N];
+};
+
+// compute Philox-4x32-10 blocks for counters _ctr, _ctr+1, ... into buffer
+void randgen_refill(randgen _q);
+
+// compute Ziggurat tables
+void randgen_init_ziggurat(randgen _q);
+
+// get next 32-bit output word
+static inline uint32_t randgen_u32(randgen _q)
+{
+    if (_q->buf_index == RANDGEN_BUF_LEN)
+        randgen_refill(_q);
+    return _q->buf[_q->buf_index++];
+}
+
+// uniform random number in [0,1)
+static inline float randgen_uni(randgen _q)
+{
+    return randgen_u32_to_uni(randgen_u32(_q));
+}
+
+// uniform random number in (0,1)
+static inline float randgen_uni_open(randgen _q)
+{
+    return randgen_u32_to_uni_open(randgen_u32(_q));
+}
+
+// normal random number, N(0,1), slow path of Ziggurat method
+float randgen_rnor_fix(randgen      _q,
+                       uint32_t     _sign,
+                       uint32_t     _mag,
+                       unsigned int _iz);
+
+// normal random number, N(0,1), using Ziggurat method; the low 7 bits of
+// each word select the layer, the remaining bits hold sign and magnitude
+static inline float randgen_rnor(randgen _q)
+{
+    uint32_t     u    = randgen_u32(_q);
+    unsigned int iz   = u & (RANDGEN_ZIG_N-1);
+    uint32_t     sign = u >> 31;
+    uint32_t     mag  = (u >> 7) & 0x00ffffff;
+    if (mag < _q->kn[iz]) {
+        // apply sign without branching: (mag ^ -sign) + sign
+        int32_t v = (int32_t)((mag ^ (0U - sign)) + sign);
+        return (float)v * _q->wn[iz];
+    }
+    return randgen_rnor_fix(_q, sign, mag, iz);
+}
+
+// gamma random number, Gamma(_alpha,1) for _alpha >= 1 (Marsaglia-Tsang)
+float randgen_gamma1(randgen _q,
+                     float   _alpha);
+
+// create counter-based random number generator
+//  _seed   :   generator seed (key)
+//  _stream :   stream identifier
+randgen randgen_create(unsigned long _seed,
+                       unsigned long _stream)
+{
+    randgen q = (randgen) malloc(sizeof(struct randgen_s));
+    randgen_init_ziggurat(q);
+    randgen_set_seed(q, _seed, _stream);
+    return q;
+}
+
+// destroy random number generator object
+int randgen_destroy(randgen _q)
+{
+    free(_q);
+    return LIQUID_OK;
+}
+
+// print random number generator object
+int randgen_print(randgen _q)
+{
+    printf("randgen [philox4x32-%u, key: 0x%.8x%.8x, stream: 0x%.8x%.8x, counter: %llu]\n",
+            PHILOX_R,
+            _q->key[1], _q->key[0],
+            _q->stream[1], _q->stream[0],
+            (unsigned long long)_q->ctr);
+    return LIQUID_OK;
+}
+
+// reset generator to start of its stream
+int randgen_reset(randgen _q)
+{
+    _q->ctr       = 0;
+    _q->buf_index = RANDGEN_BUF_LEN;
+    return LIQUID_OK;
+}
+
+// set generator seed and stream, and reset to start of stream
+int randgen_set_seed(randgen       _q,
+                     unsigned long _seed,
+                     unsigned long _stream)
+{
+    uint64_t seed   = _seed;
+    uint64_t stream = _stream;
+    _q->key[0]    = (uint32_t)(seed);
+    _q->key[1]    = (uint32_t)(seed >> 32);
+    _q->stream[0] = (uint32_t)(stream);
+    _q->stream[1] = (uint32_t)(stream >> 32);
+    return randgen_reset(_q);
+}
+
+// generate uniform random numbers in [0,1)
+int randgen_uniform(randgen      _q,
+                    float *      _x,
+                    unsigned int _n)
+{
+    // convert buffered words directly, one refill at a time
+    unsigned int i = 0, j;
+    while (i < _n) {
+        if (_q->buf_index == RANDGEN_BUF_LEN)
+            randgen_refill(_q);
+        unsigned int m = RANDGEN_BUF_LEN - _q->buf_index;
+        m = (_n - i) < m ? (_n - i) : m;
+        const uint32_t * w = _q->buf + _q->buf_index;
+        for (j=0; j<m; j++)
+            _x[i+j] = randgen_u32_to_uni(w[j]);
+        _q->buf_index += m;
+        i += m;
+    }
+    return LIQUID_OK;
+}
+
+// generate Gauss random numbers, N(0,1)
+int randgen_normal(randgen      _q,
+                   float *      _x,
+                   unsigned int _n)
+{
+    // run fast path of Ziggurat method directly on buffered words; the
+    // slow path (about 1.2% of samples) draws further words itself
+    unsigned int i = 0;
+    while (i < _n) {
+        if (_q->buf_index == RANDGEN_BUF_LEN)
+            randgen_refill(_q);
+        unsigned int m = RANDGEN_BUF_LEN - _q->buf_index;
+        m = (_n - i) < m ? (_n - i) : m;
+        unsigned int stop = i + m;
+        while (i < stop && _q->buf_index < RANDGEN_BUF_LEN) {
+            uint32_t     u    = _q->buf[_q->buf_index++];
+            unsigned int iz   = u & (RANDGEN_ZIG_N-1);
+            uint32_t     sign = u >> 31;
+            uint32_t     mag  = (u >> 7) & 0x00ffffff;
+            if (mag < _q->kn[iz]) {
+                // apply sign without branching: (mag ^ -sign) + sign
+                int32_t v = (int32_t)((mag ^ (0U - sign)) + sign);
+                _x[i++] = (float)v * _q->wn[iz];
+            } else {
+                _x[i++] = randgen_rnor_fix(_q, sign, mag, iz);
+            }
+        }
+    }
+    return LIQUID_OK;
+}
+
+// generate Weibull random numbers
+int randgen_weib(randgen      _q,
+                 float        _alpha,
+                 float        _beta,
+                 float        _gamma,
+                 float *      _x,
+                 unsigned int _n)
+{
+    // validate input
+    if (_alpha <= 0)
+        return liquid_error(LIQUID_EICONFIG,"randgen_weib(), alpha must be greater than zero");
+    if (_beta <= 0)
+        return liquid_error(LIQUID_EICONFIG,"randgen_weib(), beta must be greater than zero");
+
+    float p = 1.0f / _alpha;
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        _x[i] = _gamma + _beta*powf( -logf(randgen_uni_open(_q)), p );
+    return LIQUID_OK;
+}
+
+// generate Nakagami-m random numbers
+int randgen_nakm(randgen      _q,
+                 float        _m,
+                 float        _omega,
+                 float *      _x,
+                 unsigned int _n)
+{
+    // validate input
+    if (_m < 0.5f)
+        return liquid_error(LIQUID_EICONFIG,"randgen_nakm(), m cannot be less than 0.5");
+    if (_omega <= 0.0f)
+        return liquid_error(LIQUID_EICONFIG,"randgen_nakm(), omega must be greater than zero");
+
+    // sqrt(x) ~ Nakagami(m,omega) for x ~ Gamma(m, omega/m); for m < 1
+    // boost shape parameter: Gamma(m) = Gamma(m+1) * u^(1/m)
+    float beta = _omega / _m;
+    unsigned int i;
+    if (_m < 1.0f) {
+        float p = 1.0f / _m;
+        for (i=0; i<_n; i++) {
+            float g = randgen_gamma1(_q, _m + 1.0f);
+            _x[i] = sqrtf(beta * g * powf(randgen_uni_open(_q), p));
+        }
+    } else {
+        for (i=0; i<_n; i++)
+            _x[i] = sqrtf(beta * randgen_gamma1(_q, _m));
+    }
+    return LIQUID_OK;
+}
+
+// generate Rice-K random numbers
+int randgen_ricek(randgen      _q,
+                  float        _K,
+                  float        _omega,
+                  float *      _x,
+                  unsigned int _n)
+{
+    // validate input
+    if (_K < 0.0f)
+        return liquid_error(LIQUID_EICONFIG,"randgen_ricek(), K cannot be negative");
+    if (_omega <= 0.0f)
+        return liquid_error(LIQUID_EICONFIG,"randgen_ricek(), omega must be greater than zero");
+
+    float s   = sqrtf((_omega*_K)/(_K+1));
+    float sig = sqrtf(0.5f*_omega/(_K+1));
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        float xi = randgen_rnor(_q)*sig + s;
+        float xq = randgen_rnor(_q)*sig;
+        _x[i] = sqrtf(xi*xi + xq*xq);
+    }
+    return LIQUID_OK;
+}
+
+//
+// internal methods
+//
+
+// compute single Philox-4x32-10 block
+//  _ctr    :   counter [size: 4 x 1]
+//  _key    :   key [size: 2 x 1]
+//  _y      :   output words [size: 4 x 1]
+void randgen_philox4x32(const uint32_t * _ctr,
+                        const uint32_t * _key,
+                        uint32_t *       _y)
+{
+    uint32_t c0 = _ctr[0], c1 = _ctr[1], c2 = _ctr[2], c3 = _ctr[3];
+    uint32_t k0 = _key[0], k1 = _key[1];
+    unsigned int r;
+    for (r=0; r<PHILOX_R; r++) {
+        uint64_t p0 = (uint64_t)PHILOX_M0 * c0;
+        uint64_t p1 = (uint64_t)PHILOX_M1 * c2;
+        c0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+        c1 = (uint32_t)(p1);
+        c2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+        c3 = (uint32_t)(p0);
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+    _y[0] = c0;
+    _y[1] = c1;
+    _y[2] = c2;
+    _y[3] = c3;
+}
+
+// compute Philox-4x32-10 blocks for counters _ctr, _ctr+1, ... into buffer
+void randgen_refill(randgen _q)
+{
+    unsigned int i;
+#if RANDGEN_USE_SSE41
+    // four independent blocks per vector and all vectors interleaved
+    // within each round; the 32x32 -> 64-bit products of even and odd
+    // lanes are computed separately and re-interleaved
+    const __m128i m0 = _mm_set1_epi32(PHILOX_M0);
+    const __m128i m1 = _mm_set1_epi32(PHILOX_M1);
+    __m128i c0[RANDGEN_NUM_BLOCKS/4];
+    __m128i c1[RANDGEN_NUM_BLOCKS/4];
+    __m128i c2[RANDGEN_NUM_BLOCKS/4];
+    __m128i c3[RANDGEN_NUM_BLOCKS/4];
+    for (i=0; i<RANDGEN_NUM_BLOCKS/4; i++) {
+        uint64_t n = _q->ctr + 4*i;
+        c0[i] = _mm_setr_epi32((uint32_t)(n  ), (uint32_t)(n+1), (uint32_t)(n+2), (uint32_t)(n+3));
+        c1[i] = _mm_setr_epi32((uint32_t)((n  )>>32), (uint32_t)((n+1)>>32),
+                               (uint32_t)((n+2)>>32), (uint32_t)((n+3)>>32));
+        c2[i] = _mm_set1_epi32(_q->stream[0]);
+        c3[i] = _mm_set1_epi32(_q->stream[1]);
+    }
+    __m128i k0 = _mm_set1_epi32(_q->key[0]);
+    __m128i k1 = _mm_set1_epi32(_q->key[1]);
+    unsigned int r;
+    for (r=0; r<PHILOX_R; r++) {
+        for (i=0; i<RANDGEN_NUM_BLOCKS/4; i++) {
+            __m128i pe0 = _mm_mul_epu32(c0[i], m0);
+            __m128i po0 = _mm_mul_epu32(_mm_srli_epi64(c0[i],32), m0);
+            __m128i pe1 = _mm_mul_epu32(c2[i], m1);
+            __m128i po1 = _mm_mul_epu32(_mm_srli_epi64(c2[i],32), m1);
+            __m128i lo0 = _mm_blend_epi16(pe0, _mm_slli_epi64(po0,32), 0xcc);
+            __m128i hi0 = _mm_blend_epi16(_mm_srli_epi64(pe0,32), po0, 0xcc);
+            __m128i lo1 = _mm_blend_epi16(pe1, _mm_slli_epi64(po1,32), 0xcc);
+            __m128i hi1 = _mm_blend_epi16(_mm_srli_epi64(pe1,32), po1, 0xcc);
+            c0[i] = _mm_xor_si128(_mm_xor_si128(hi1, c1[i]), k0);
+            c1[i] = lo1;
+            c2[i] = _mm_xor_si128(_mm_xor_si128(hi0, c3[i]), k1);
+            c3[i] = lo0;
+        }
+        k0 = _mm_add_epi32(k0, _mm_set1_epi32(PHILOX_W0));
+        k1 = _mm_add_epi32(k1, _mm_set1_epi32(PHILOX_W1));
+    }
+
+    // transpose to block order
+    for (i=0; i<RANDGEN_NUM_BLOCKS/4; i++) {
+        __m128i t0 = _mm_unpacklo_epi32(c0[i], c1[i]);
+        __m128i t1 = _mm_unpacklo_epi32(c2[i], c3[i]);
+        __m128i t2 = _mm_unpackhi_epi32(c0[i], c1[i]);
+        __m128i t3 = _mm_unpackhi_epi32(c2[i], c3[i]);
+        _mm_storeu_si128((__m128i*)&_q->buf[16*i+ 0], _mm_unpacklo_epi64(t0, t1));
+        _mm_storeu_si128((__m128i*)&_q->buf[16*i+ 4], _mm_unpackhi_epi64(t0, t1));
+        _mm_storeu_si128((__m128i*)&_q->buf[16*i+ 8], _mm_unpacklo_epi64(t2, t3));
+        _mm_storeu_si128((__m128i*)&_q->buf[16*i+12], _mm_unpackhi_epi64(t2, t3));
+    }
+#else
+    for (i=0; i<RANDGEN_NUM_BLOCKS; i++) {
+        uint64_t n = _q->ctr + i;
+        uint32_t ctr[4] = {(uint32_t)n, (uint32_t)(n >> 32), _q->stream[0], _q->stream[1]};
+        randgen_philox4x32(ctr, _q->key, &_q->buf[4*i]);
+    }
+#endif
+    _q->ctr      += RANDGEN_NUM_BLOCKS;
+    _q->buf_index = 0;
+}
+
+// compute Ziggurat tables (Marsaglia & Tsang, 2000) scaled for 24-bit
+// magnitudes
+void randgen_init_ziggurat(randgen _q)
+{
+    const double m1 = 16777216.0;
+    double dn = RANDGEN_ZIG_R;
+    double tn = dn;
+    double vn = 9.91256303526217e-3;
+    double q  = vn / exp(-0.5*dn*dn);
+
+    _q->kn[0] = (uint32_t)((dn/q)*m1);
+    _q->kn[1] = 0;
+    _q->wn[0] = (float)(q/m1);
+    _q->wn[RANDGEN_ZIG_N-1] = (float)(dn/m1);
+    _q->fn[0] = 1.0f;
+    _q->fn[RANDGEN_ZIG_N-1] = (float)exp(-0.5*dn*dn);
+
+    unsigned int i;
+    for (i=RANDGEN_ZIG_N-2; i>=1; i--) {
+        dn = sqrt(-2.0*log(vn/dn + exp(-0.5*dn*dn)));
+        _q->kn[i+1] = (uint32_t)((dn/tn)*m1);
+        tn = dn;
+        _q->fn[i] = (float)exp(-0.5*dn*dn);
+        _q->wn[i] = (float)(dn/m1);
+    }
+}
+
+// normal random number, N(0,1), slow path of Ziggurat method
+float randgen_rnor_fix(randgen      _q,
+                       uint32_t     _sign,
+                       uint32_t     _mag,
+                       unsigned int _iz)
+{
+    const float r = (float)RANDGEN_ZIG_R;
+    while (1) {
+        float x = (float)_mag * _q->wn[_iz];
+        if (_iz == 0) {
+            // sample from the tail
+            float y;
+            do {
+                x = -logf(randgen_uni_open(_q)) / r;
+                y = -logf(randgen_uni_open(_q));
+            } while (y+y < x*x);
+            return _sign ? -(r + x) : r + x;
+        }
+
+        // wedge: accept if under the density
+        if (_q->fn[_iz] + randgen_uni(_q)*(_q->fn[_iz-1] - _q->fn[_iz]) < expf(-0.5f*x*x))
+            return _sign ? -x : x;
+
+        // draw a new sample
+        uint32_t u = randgen_u32(_q);
+        _iz   = u & (RANDGEN_ZIG_N-1);
+        _sign = u >> 31;
+        _mag  = (u >> 7) & 0x00ffffff;
+        if (_mag < _q->kn[_iz]) {
+            x = (float)_mag * _q->wn[_iz];
+            return _sign ? -x : x;
+        }
+    }
+    return 0.0f;
+}
+
+// gamma random number, Gamma(_alpha,1) for _alpha >= 1 (Marsaglia-Tsang)
+float randgen_gamma1(randgen _q,
+                     float   _alpha)
+{
+    float d = _alpha - 1.0f/3.0f;
+    float c = 1.0f / sqrtf(9.0f*d);
+    while (1) {
+        float x, v;
+        do {
+            x = randgen_rnor(_q);
+            v = 1.0f + c*x;
+        } while (v <= 0.0f);
+        v = v*v*v;
+        float u  = randgen_uni_open(_q);
+        float x2 = x*x;
+        if (u < 1.0f - 0.0331f*x2*x2)
+            return d*v;
+        if (logf(u) < 0.5f*x2 + d*(1.0f - v + logf(v)))
+            return d*v;
+    }
+    return 0.0f;
+}
+
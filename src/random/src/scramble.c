@@ -26,30 +26,48 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
 #include "liquid.internal.h"
 
+// soft-bit scrambling masks: bit set in byte mask inverts soft bit
+#define SCRAMBLE_SOFT_MASK(M)                               \
+    ((M) & 0x80 ? 0xff : 0x00), ((M) & 0x40 ? 0xff : 0x00), \
+    ((M) & 0x20 ? 0xff : 0x00), ((M) & 0x10 ? 0xff : 0x00), \
+    ((M) & 0x08 ? 0xff : 0x00), ((M) & 0x04 ? 0xff : 0x00), \
+    ((M) & 0x02 ? 0xff : 0x00), ((M) & 0x01 ? 0xff : 0x00)
+
+// byte masks repeated to fill 8 bytes
+static const unsigned char scramble_mask[8] = {
+    LIQUID_SCRAMBLE_MASK0, LIQUID_SCRAMBLE_MASK1,
+    LIQUID_SCRAMBLE_MASK2, LIQUID_SCRAMBLE_MASK3,
+    LIQUID_SCRAMBLE_MASK0, LIQUID_SCRAMBLE_MASK1,
+    LIQUID_SCRAMBLE_MASK2, LIQUID_SCRAMBLE_MASK3};
+
+// soft-bit masks for one period of 4 bytes (32 soft bits)
+static const unsigned char scramble_soft_mask[32] = {
+    SCRAMBLE_SOFT_MASK(LIQUID_SCRAMBLE_MASK0),
+    SCRAMBLE_SOFT_MASK(LIQUID_SCRAMBLE_MASK1),
+    SCRAMBLE_SOFT_MASK(LIQUID_SCRAMBLE_MASK2),
+    SCRAMBLE_SOFT_MASK(LIQUID_SCRAMBLE_MASK3)};
+
 void scramble_data(unsigned char * _x,
                    unsigned int _n)
 {
-    // t = 4*(floor(_n/4))
-    unsigned int t = (_n>>2)<<2;
-
-    // apply static masks
+    // apply static masks 8 bytes at a time
+    uint64_t mask, v;
+    memcpy(&mask, scramble_mask, 8);
     unsigned int i;
-    for (i=0; i<t; i+=4) {
-        _x[i  ] ^= LIQUID_SCRAMBLE_MASK0;
-        _x[i+1] ^= LIQUID_SCRAMBLE_MASK1;
-        _x[i+2] ^= LIQUID_SCRAMBLE_MASK2;
-        _x[i+3] ^= LIQUID_SCRAMBLE_MASK3;
+    for (i=0; i+8<=_n; i+=8) {
+        memcpy(&v, _x+i, 8);
+        v ^= mask;
+        memcpy(_x+i, &v, 8);
     }
 
-    // clean up remainder of elements
-    if ( (i+0) < _n ) _x[i+0] ^= LIQUID_SCRAMBLE_MASK0;
-    if ( (i+1) < _n ) _x[i+1] ^= LIQUID_SCRAMBLE_MASK1;
-    if ( (i+2) < _n ) _x[i+2] ^= LIQUID_SCRAMBLE_MASK2;
-    if ( (i+3) < _n ) _x[i+3] ^= LIQUID_SCRAMBLE_MASK3;
+    // clean up remainder of elements (period of 4 divides 8)
+    for ( ; i<_n; i++)
+        _x[i] ^= scramble_mask[i & 0x03];
 }
 
 void unscramble_data(unsigned char * _x,
@@ -65,36 +83,21 @@ void unscramble_data(unsigned char * _x,
 void unscramble_data_soft(unsigned char * _x,
                           unsigned int _n)
 {
-    // bit mask
-    unsigned char mask = 0x00;
-
-    // apply static masks
-    unsigned int i;
-    for (i=0; i<_n; i++) {
-        switch ( i % 4 ) {
-        case 0: mask = LIQUID_SCRAMBLE_MASK0; break;
-        case 1: mask = LIQUID_SCRAMBLE_MASK1; break;
-        case 2: mask = LIQUID_SCRAMBLE_MASK2; break;
-        case 3: mask = LIQUID_SCRAMBLE_MASK3; break;
-        default:;
-        }
-
-#if 0
-        unsigned int j;
-        for (j=0; j<8; j++) {
-            if ( (mask >> (8-j-1)) & 0x01 )
-                _x[8*i+j] = 255 - _x[8*i+j];
+    // inverting a soft bit (255 - x) is equivalent to x ^ 0xff, so
+    // apply expanded masks over each period of 32 soft bits
+    uint64_t mask[4], v;
+    memcpy(mask, scramble_soft_mask, 32);
+    unsigned int i, j;
+    unsigned int n = 8*_n;
+    for (i=0; i+32<=n; i+=32) {
+        for (j=0; j<4; j++) {
+            memcpy(&v, _x+i+8*j, 8);
+            v ^= mask[j];
+            memcpy(_x+i+8*j, &v, 8);
         }
-#else
-        if ( mask & 0x80 ) _x[8*i+0] = 255 - _x[8*i+0];
-        if ( mask & 0x40 ) _x[8*i+1] = 255 - _x[8*i+1];
-        if ( mask & 0x20 ) _x[8*i+2] = 255 - _x[8*i+2];
-        if ( mask & 0x10 ) _x[8*i+3] = 255 - _x[8*i+3];
-        if ( mask & 0x08 ) _x[8*i+4] = 255 - _x[8*i+4];
-        if ( mask & 0x04 ) _x[8*i+5] = 255 - _x[8*i+5];
-        if ( mask & 0x02 ) _x[8*i+6] = 255 - _x[8*i+6];
-        if ( mask & 0x01 ) _x[8*i+7] = 255 - _x[8*i+7];
-#endif
     }
-}
 
+    // clean up remainder of elements
+    for ( ; i<n; i++)
+        _x[i] ^= scramble_soft_mask[i & 0x1f];
+}
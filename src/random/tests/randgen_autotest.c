@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2007 - 2022 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <math.h>
+
+#include "autotest/autotest.h"
+#include "liquid.internal.h"
+
+// known-answer tests for Philox-4x32-10 block function
+void autotest_randgen_philox_kat()
+{
+    uint32_t y[4];
+
+    uint32_t ctr0[4] = {0,0,0,0};
+    uint32_t key0[2] = {0,0};
+    uint32_t ans0[4] = {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8};
+    randgen_philox4x32(ctr0, key0, y);
+    CONTEND_SAME_DATA(y, ans0, sizeof(ans0));
+
+    uint32_t ctr1[4] = {0xffffffff,0xffffffff,0xffffffff,0xffffffff};
+    uint32_t key1[2] = {0xffffffff,0xffffffff};
+    uint32_t ans1[4] = {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd};
+    randgen_philox4x32(ctr1, key1, y);
+    CONTEND_SAME_DATA(y, ans1, sizeof(ans1));
+}
+
+// sequences are reproducible and streams are independent
+void autotest_randgen_streams()
+{
+    unsigned int n = 200;
+    float x0[n], x1[n], x2[n];
+
+    randgen q0 = randgen_create(1234, 0);
+    randgen q1 = randgen_create(1234, 0);
+    randgen q2 = randgen_create(1234, 1);
+
+    // same seed and stream, regardless of how blocks are split
+    randgen_uniform(q0, x0, n);
+    randgen_uniform(q1, x1, 37);
+    randgen_uniform(q1, x1+37, n-37);
+    CONTEND_SAME_DATA(x0, x1, n*sizeof(float));
+
+    // different stream
+    randgen_uniform(q2, x2, n);
+    unsigned int i, num_equal = 0;
+    for (i=0; i<n; i++)
+        num_equal += x0[i] == x2[i] ? 1 : 0;
+    CONTEND_LESS_THAN(num_equal, 2);
+
+    // reset to start of stream
+    randgen_reset(q1);
+    randgen_uniform(q1, x1, n);
+    CONTEND_SAME_DATA(x0, x1, n*sizeof(float));
+
+    randgen_destroy(q0);
+    randgen_destroy(q1);
+    randgen_destroy(q2);
+}
+
+// helper function to compute first and second moments
+void randgen_test_moments(float * _x, unsigned int _n, float * _m1, float * _m2)
+{
+    unsigned int i;
+    double m1 = 0, m2 = 0;
+    for (i=0; i<_n; i++) {
+        m1 += _x[i];
+        m2 += _x[i]*_x[i];
+    }
+    *_m1 = m1 / (double)_n;
+    *_m2 = m2 / (double)_n;
+}
+
+void autotest_randgen_uniform()
+{
+    unsigned int n = 100000;
+    float * x = (float*) malloc(n*sizeof(float));
+    randgen q = randgen_create(7, 0);
+    randgen_uniform(q, x, n);
+
+    unsigned int i;
+    for (i=0; i<n; i++) {
+        CONTEND_GREATER_THAN(x[i], -1e-12f);
+        CONTEND_LESS_THAN   (x[i],  1.0f);
+    }
+
+    float m1, m2;
+    randgen_test_moments(x, n, &m1, &m2);
+    CONTEND_DELTA(m1,      0.5f,       0.01f);
+    CONTEND_DELTA(m2-m1*m1, 1.0f/12.0f, 0.01f);
+
+    randgen_destroy(q);
+    free(x);
+}
+
+// word-to-float mappings at edge values stay inside their intervals
+void autotest_randgen_uniform_edges()
+{
+    uint32_t u[] = {0x00000000, 0x000001ff, 0x00000200, 0x7fffffff,
+                    0x80000000, 0xfffffe00, 0xffffffff};
+    unsigned int i;
+    for (i=0; i<sizeof(u)/sizeof(uint32_t); i++) {
+        float v = randgen_u32_to_uni(u[i]);
+        float w = randgen_u32_to_uni_open(u[i]);
+        CONTEND_GREATER_THAN(v, -1e-12f);
+        CONTEND_LESS_THAN   (v,  1.0f);
+        CONTEND_GREATER_THAN(w,  0.0f);
+        CONTEND_LESS_THAN   (w,  1.0f);
+
+        // open interval is symmetric about 1/2
+        CONTEND_EQUALITY(w + randgen_u32_to_uni_open(~u[i]), 1.0f);
+    }
+    CONTEND_EQUALITY(randgen_u32_to_uni     (0x00000000), 0.0f);
+    CONTEND_EQUALITY(randgen_u32_to_uni     (0xffffffff), 1.0f - 1.0f/16777216.0f);
+    CONTEND_EQUALITY(randgen_u32_to_uni_open(0x00000000), 0.5f/8388608.0f);
+    CONTEND_EQUALITY(randgen_u32_to_uni_open(0xffffffff), 1.0f - 0.5f/8388608.0f);
+    CONTEND_EQUALITY(randgen_u32_to_uni_open(0x80000000), 0.5f + 0.5f/8388608.0f);
+}
+
+void autotest_randgen_normal()
+{
+    unsigned int n = 200000;
+    float * x = (float*) malloc(n*sizeof(float));
+    randgen q = randgen_create(11, 3);
+    randgen_normal(q, x, n);
+
+    float m1, m2;
+    randgen_test_moments(x, n, &m1, &m2);
+    CONTEND_DELTA(m1, 0.0f, 0.01f);
+    CONTEND_DELTA(m2, 1.0f, 0.02f);
+
+    // compare empirical distribution to Gauss cdf, including tails
+    float t[7] = {-3.5f, -2.0f, -1.0f, 0.0f, 0.5f, 2.0f, 3.5f};
+    unsigned int i, j;
+    for (j=0; j<7; j++) {
+        unsigned int c = 0;
+        for (i=0; i<n; i++)
+            c += x[i] < t[j] ? 1 : 0;
+        CONTEND_DELTA((float)c/(float)n, randnf_cdf(t[j],0.0f,1.0f), 0.005f);
+    }
+
+    randgen_destroy(q);
+    free(x);
+}
+
+void autotest_randgen_distributions()
+{
+    unsigned int n = 100000;
+    float * x = (float*) malloc(n*sizeof(float));
+    randgen q = randgen_create(5, 0);
+    float m1, m2;
+
+    // Weibull: E{x} = gamma + beta Gamma(1 + 1/alpha)
+    float alpha = 2.0f, beta = 1.5f, gamma = 0.5f;
+    randgen_weib(q, alpha, beta, gamma, x, n);
+    randgen_test_moments(x, n, &m1, &m2);
+    CONTEND_DELTA(m1, gamma + beta*liquid_gammaf(1.0f + 1.0f/alpha), 0.02f);
+
+    // Nakagami-m: E{x^2} = omega, for m both below and above 1
+    randgen_nakm(q, 0.75f, 2.0f, x, n);
+    randgen_test_moments(x, n, &m1, &m2);
+    CONTEND_DELTA(m2, 2.0f, 0.04f);
+    randgen_nakm(q, 3.0f, 2.0f, x, n);
+    randgen_test_moments(x, n, &m1, &m2);
+    CONTEND_DELTA(m2, 2.0f, 0.04f);
+
+    // Rice-K: E{x^2} = omega
+    randgen_ricek(q, 4.0f, 1.5f, x, n);
+    randgen_test_moments(x, n, &m1, &m2);
+    CONTEND_DELTA(m2, 1.5f, 0.03f);
+
+    randgen_destroy(q);
+    free(x);
+}
+
+// block generator output matches Philox-4x32-10 block function
+void autotest_randgen_blocks()
+{
+    unsigned int n = 4*100;
+    float x[n];
+    randgen q = randgen_create(0x0123456789abcdefULL, 0x55aa);
+    randgen_uniform(q, x, n);
+
+    uint32_t key[2] = {0x89abcdef, 0x01234567};
+    uint32_t y[4];
+    unsigned int i, j;
+    for (i=0; i<n/4; i++) {
+        uint32_t ctr[4] = {i, 0, 0x55aa, 0};
+        randgen_philox4x32(ctr, key, y);
+        for (j=0; j<4; j++)
+            CONTEND_EQUALITY(x[4*i+j], (float)(y[j] >> 8) / 16777216.0f);
+    }
+    randgen_destroy(q);
+}
@@ -34,6 +34,17 @@
 #define LIQUID_MIN_MSEQUENCE_M  2
 #define LIQUID_MAX_MSEQUENCE_M  15
 
+// compute word-parallel lookup tables from generator polynomial
+void msequence_compute_tables(msequence _ms);
+
+// compute next 32 output bits from shift register state _v
+#define MSEQUENCE_WORD(_ms,_v) \
+    ((_ms)->tab[(_v) & 0xff] ^ (_ms)->tab[256 + (((_v) >> 8) & 0xff)])
+
+// apply state transition matrix (stored by columns) to state _v
+unsigned int msequence_matrix_apply(unsigned int * _M,
+                                    unsigned int   _v);
+
 // msequence structure
 //  Note that 'g' is stored as the default polynomial shifted to the
 //  right by one bit; this bit is implied and not actually used in
@@ -92,6 +103,9 @@ msequence msequence_create(unsigned int _m,
     ms->v = ms->a;      // shift register
     ms->b = 0;          // return bit
 
+    // compute word-parallel lookup tables
+    msequence_compute_tables(ms);
+
     return ms;
 }
 
@@ -126,6 +140,9 @@ msequence msequence_create_default(unsigned int _m)
     // copy default sequence
     memmove(ms, &msequence_default[_m], sizeof(struct msequence_s));
 
+    // compute word-parallel lookup tables
+    msequence_compute_tables(ms);
+
     // return
     return ms;
 }
@@ -133,6 +150,7 @@ msequence msequence_create_default(unsigned int _m)
 // destroy an msequence object, freeing all internal memory
 int msequence_destroy(msequence _ms)
 {
+    free(_ms->tab);
     free(_ms);
     return LIQUID_OK;
 }
@@ -161,9 +179,18 @@ int msequence_print(msequence _m)
 // advance msequence on shift register, returning output bit
 unsigned int msequence_advance(msequence _ms)
 {
-    // compute return bit as binary dot product between the
-    // internal shift register and the generator polynomial
-    _ms->b = liquid_bdotprod( _ms->v, _ms->g );
+    // refill buffer with the next 32 output bits; each output bit is
+    // the binary dot product between the internal shift register and
+    // the generator polynomial at that step
+    if (_ms->nw == 0) {
+        _ms->w  = MSEQUENCE_WORD(_ms, _ms->v);
+        _ms->nw = 32;
+    }
+
+    // pop bit from buffer
+    _ms->b = (_ms->w >> 31) & 0x01;
+    _ms->w <<= 1;
+    _ms->nw--;
 
     _ms->v <<= 1;       // shift internal register
     _ms->v |= _ms->b;   // push bit onto register
@@ -172,6 +199,46 @@ unsigned int msequence_advance(msequence _ms)
     return _ms->b;      // return result
 }
 
+// advance msequence _n steps without computing intermediate outputs,
+// allowing independent generators to start the same sequence at
+// different offsets
+//  _ms     :   m-sequence object
+//  _n      :   number of steps to advance
+int msequence_advance_n(msequence     _ms,
+                        unsigned long _n)
+{
+    if (_n == 0)
+        return LIQUID_OK;
+
+    // single-step state transition matrix, stored by columns: column i
+    // is the state after one step from state (1 << i)
+    unsigned int M[16];
+    unsigned int T[16];
+    unsigned int i;
+    for (i=0; i<16; i++) {
+        unsigned int v = 1U << i;
+        M[i] = ((v << 1) | liquid_bdotprod(v, _ms->g)) & _ms->n;
+    }
+
+    // square-and-multiply: apply M^(2^k) for every bit k set in _n
+    unsigned int v = _ms->v & 0xffff;
+    while (1) {
+        if (_n & 1)
+            v = msequence_matrix_apply(M, v);
+        _n >>= 1;
+        if (_n == 0)
+            break;
+        for (i=0; i<16; i++)
+            T[i] = msequence_matrix_apply(M, M[i]);
+        memmove(M, T, sizeof(M));
+    }
+
+    // the last output bit is the last bit pushed onto the register
+    _ms->v  = v;
+    _ms->b  = v & 0x01;
+    _ms->nw = 0;
+    return LIQUID_OK;
+}
 
 // generate pseudo-random symbol from shift register
 //  _ms     :   m-sequence object
@@ -181,17 +248,35 @@ unsigned int msequence_generate_symbol(msequence    _ms,
 {
     unsigned int i;
     unsigned int s = 0;
-    for (i=0; i<_bps; i++) {
-        s <<= 1;
-        s |= msequence_advance(_ms);
+    if (_bps == 0 || _bps > 32) {
+        for (i=0; i<_bps; i++) {
+            s <<= 1;
+            s |= msequence_advance(_ms);
+        }
+        return s;
     }
+
+    // compute all output bits at once from current state (or buffer)
+    if (_ms->nw >= _bps) {
+        s = _ms->w >> (32 - _bps);
+        _ms->w  = _bps < 32 ? _ms->w << _bps : 0;
+        _ms->nw -= _bps;
+    } else {
+        s = MSEQUENCE_WORD(_ms, _ms->v) >> (32 - _bps);
+        _ms->nw = 0;
+    }
+
+    // register now holds the last m output bits
+    _ms->v = (_bps < 32 ? (_ms->v << _bps) | s : s) & _ms->n;
+    _ms->b = s & 0x01;
     return s;
 }
 
 // reset msequence shift register to original state, typically '1'
 int msequence_reset(msequence _ms)
 {
-    _ms->v = _ms->a;
+    _ms->v  = _ms->a;
+    _ms->nw = 0;
     return LIQUID_OK;
 }
 
@@ -229,7 +314,59 @@ int msequence_set_state(msequence    _ms,
     // set internal state
     // NOTE: if state is set to zero, this will lock the sequence generator,
     //       but let the user set this value if they wish
-    _ms->v = _a;
+    _ms->v  = _a;
+    _ms->nw = 0;
     return LIQUID_OK;
 }
 
+//
+// internal methods
+//
+
+// compute word-parallel lookup tables from generator polynomial
+void msequence_compute_tables(msequence _ms)
+{
+    _ms->tab = (uint32_t*) malloc(2*256*sizeof(uint32_t));
+    _ms->w   = 0;
+    _ms->nw  = 0;
+
+    // output bits for 32 steps from each single-bit state
+    uint32_t basis[16];
+    unsigned int i, j;
+    for (i=0; i<16; i++) {
+        unsigned int v = 1U << i;
+        uint32_t     w = 0;
+        for (j=0; j<32; j++) {
+            unsigned int b = liquid_bdotprod(v, _ms->g);
+            v = ((v << 1) | b) & _ms->n;
+            w = (w << 1) | b;
+        }
+        basis[i] = w;
+    }
+
+    // output is linear in state: combine basis words for each byte value
+    uint32_t * t0 = _ms->tab;
+    uint32_t * t1 = _ms->tab + 256;
+    t0[0] = 0;
+    t1[0] = 0;
+    for (i=0; i<8; i++) {
+        for (j=0; j<(1U<<i); j++) {
+            t0[j | (1U<<i)] = t0[j] ^ basis[i];
+            t1[j | (1U<<i)] = t1[j] ^ basis[i+8];
+        }
+    }
+}
+
+// apply state transition matrix (stored by columns) to state _v
+unsigned int msequence_matrix_apply(unsigned int * _M,
+                                    unsigned int   _v)
+{
+    unsigned int i;
+    unsigned int y = 0;
+    for (i=0; _v; i++, _v >>= 1) {
+        if (_v & 1)
+            y ^= _M[i];
+    }
+    return y;
+}
+
@@ -92,3 +92,79 @@ void autotest_msequence_m10()   {   msequence_test_autocorrelation(10); }   // n
 void autotest_msequence_m11()   {   msequence_test_autocorrelation(11); }   // n = 2047
 void autotest_msequence_m12()   {   msequence_test_autocorrelation(12); }   // n = 4095
 
+
+// reference linear feedback shift register, one bit at a time
+unsigned int msequence_test_lfsr_ref(unsigned int * _v,
+                                     unsigned int   _g,
+                                     unsigned int   _m)
+{
+    unsigned int t = *_v & (_g >> 1);
+    unsigned int b = 0;
+    while (t) {
+        b ^= t & 1;
+        t >>= 1;
+    }
+    *_v = ((*_v << 1) | b) & ((1U << _m) - 1);
+    return b;
+}
+
+// helper function to test word-parallel symbol generation against
+// reference bit-wise shift register
+void msequence_test_generate(unsigned int _m,
+                             unsigned int _g)
+{
+    msequence ms = msequence_create(_m, _g, 1);
+    unsigned int v = msequence_get_state(ms);
+
+    unsigned int i, j;
+    for (i=0; i<400; i++) {
+        // vary symbol size, interleaving single-bit advances
+        unsigned int bps = (7*i) % 34;
+        unsigned int s_ref = 0;
+        unsigned int s;
+        if (i % 5 == 0) {
+            s     = msequence_advance(ms);
+            s_ref = msequence_test_lfsr_ref(&v, _g, _m);
+        } else {
+            s = msequence_generate_symbol(ms, bps);
+            for (j=0; j<bps; j++)
+                s_ref = (s_ref << 1) | msequence_test_lfsr_ref(&v, _g, _m);
+        }
+        CONTEND_EQUALITY(s, s_ref);
+        CONTEND_EQUALITY(msequence_get_state(ms), v);
+    }
+    msequence_destroy(ms);
+}
+
+void autotest_msequence_generate_m5()  { msequence_test_generate( 5, 0x0025); }
+void autotest_msequence_generate_m7()  { msequence_test_generate( 7, 0x0089); }
+void autotest_msequence_generate_m12() { msequence_test_generate(12, 0x1053); }
+void autotest_msequence_generate_m15() { msequence_test_generate(15, 0x8003); }
+
+// helper function to test jump-ahead against stepping one bit at a time
+void msequence_test_advance_n(unsigned int  _m,
+                              unsigned long _n)
+{
+    msequence ms0 = msequence_create_default(_m);
+    msequence ms1 = msequence_create_default(_m);
+
+    // advance first generator one bit at a time, second all at once
+    unsigned long i;
+    for (i=0; i<_n; i++)
+        msequence_advance(ms0);
+    msequence_advance_n(ms1, _n);
+    CONTEND_EQUALITY(msequence_get_state(ms0), msequence_get_state(ms1));
+
+    // ensure subsequent output is identical
+    for (i=0; i<100; i++)
+        CONTEND_EQUALITY(msequence_generate_symbol(ms0,7), msequence_generate_symbol(ms1,7));
+
+    msequence_destroy(ms0);
+    msequence_destroy(ms1);
+}
+
+void autotest_msequence_advance_n_m4_n0()      { msequence_test_advance_n( 4,      0); }
+void autotest_msequence_advance_n_m4_n37()     { msequence_test_advance_n( 4,     37); }
+void autotest_msequence_advance_n_m8_n255()    { msequence_test_advance_n( 8,    255); }
+void autotest_msequence_advance_n_m8_n1000()   { msequence_test_advance_n( 8,   1000); }
+void autotest_msequence_advance_n_m15_n99991() { msequence_test_advance_n(15,  99991); }
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2007 - 2018 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <sys/resource.h>
+#include "liquid.h"
+
+#define ARENA_BENCH_API(N,ARENA)        \
+(   struct rusage *_start,              \
+    struct rusage *_finish,             \
+    unsigned long int *_num_iterations) \
+{ arena_bench(_start, _finish, _num_iterations, N, ARENA); }
+
+// Helper function to keep code base small: create and destroy a bank of
+// filters, each with a window, with or without an arena
+//  _n      :   filter length
+//  _arena  :   allocate from arena?
+void arena_bench(struct rusage *     _start,
+                 struct rusage *     _finish,
+                 unsigned long int * _num_iterations,
+                 unsigned int        _n,
+                 int                 _arena)
+{
+    unsigned int num_filters = 64;
+    *_num_iterations /= 16;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    float h[_n];
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        h[i] = 1.0f / (float)(i+1);
+    firfilt_crcf f[num_filters];
+    windowcf     w[num_filters];
+    liquid_arena q = liquid_arena_create(0);
+
+    unsigned long int t;
+    getrusage(RUSAGE_SELF, _start);
+    for (t=0; t<*_num_iterations; t++) {
+        if (_arena) liquid_arena_begin(q);
+        for (i=0; i<num_filters; i++) {
+            f[i] = firfilt_crcf_create(h, _n);
+            w[i] = windowcf_create(_n);
+        }
+        if (_arena) {
+            liquid_arena_end(q);
+            liquid_arena_reset(q);
+        } else {
+            for (i=0; i<num_filters; i++) {
+                firfilt_crcf_destroy(f[i]);
+                windowcf_destroy(w[i]);
+            }
+        }
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= num_filters;
+
+    liquid_arena_destroy(q);
+}
+
+// 
+void benchmark_arena_heap_n16       ARENA_BENCH_API(  16, 0)
+void benchmark_arena_heap_n256      ARENA_BENCH_API( 256, 0)
+void benchmark_arena_alloc_n16      ARENA_BENCH_API(  16, 1)
+void benchmark_arena_alloc_n256     ARENA_BENCH_API( 256, 1)
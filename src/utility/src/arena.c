@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2007 - 2022 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// arena.c
+//
+// Aligned arena allocator. Objects created between liquid_arena_begin()
+// and liquid_arena_end() draw their internal memory from the arena: each
+// allocation is aligned to LIQUID_ARENA_ALIGN bytes and placed directly
+// after the previous one, and the whole set is released at once when the
+// arena is destroyed.
+//
+// Internally the library allocates through liquid_malloc() and friends,
+// which prefix every block with a small header recording its origin so
+// that liquid_free() can tell heap blocks from arena blocks (the latter
+// are not freed individually).
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "liquid.internal.h"
+
+// alignment of all blocks [bytes]
+#define LIQUID_ARENA_ALIGN      (64)
+
+// default chunk size [bytes]
+#define LIQUID_ARENA_CHUNK_SIZE (1<<16)
+
+// round up to multiple of alignment
+#define LIQUID_ARENA_ROUND(n)   (((n) + LIQUID_ARENA_ALIGN - 1) & ~(size_t)(LIQUID_ARENA_ALIGN - 1))
+
+// header stored immediately before each block
+struct liquid_block_header_s {
+    void * base;    // address returned by malloc(), or NULL for arena blocks
+    size_t size;    // requested size [bytes]
+};
+#define LIQUID_BLOCK_HEADER(p)  (((struct liquid_block_header_s*)(p)) - 1)
+
+// contiguous chunk of arena memory
+struct liquid_arena_chunk_s {
+    struct liquid_arena_chunk_s * next; // previously filled chunk
+    unsigned char * data;               // aligned start of memory
+    size_t          capacity;           // length of data [bytes]
+    size_t          used;               // bytes used in data
+};
+
+struct liquid_arena_s {
+    struct liquid_arena_chunk_s * chunk;    // current chunk (head of list)
+    size_t          chunk_size;             // nominal chunk size [bytes]
+    size_t          num_bytes;              // bytes used including padding
+    size_t          num_bytes_reserved;     // total size of all chunks
+    unsigned int    num_allocations;        // number of blocks allocated
+    unsigned int    num_chunks;             // number of chunks
+};
+
+// arena from which library objects currently allocate, per thread
+#if defined __GNUC__
+static __thread liquid_arena liquid_arena_active = NULL;
+#elif defined __STDC_VERSION__ && __STDC_VERSION__ >= 201112L
+static _Thread_local liquid_arena liquid_arena_active = NULL;
+#else
+static liquid_arena liquid_arena_active = NULL;
+#endif
+
+// add new chunk to arena with at least _n bytes available
+static int liquid_arena_add_chunk(liquid_arena _q,
+                                  size_t       _n)
+{
+    size_t capacity = LIQUID_ARENA_ROUND(_n > _q->chunk_size ? _n : _q->chunk_size);
+    size_t header   = LIQUID_ARENA_ROUND(sizeof(struct liquid_arena_chunk_s));
+    struct liquid_arena_chunk_s * c =
+        (struct liquid_arena_chunk_s*) malloc(header + capacity + LIQUID_ARENA_ALIGN);
+    if (c == NULL)
+        return liquid_error(LIQUID_EIMEM,"liquid_arena_add_chunk(), could not allocate %lu bytes", (unsigned long)capacity);
+
+    uintptr_t p = (uintptr_t)c + header;
+    c->data     = (unsigned char*) LIQUID_ARENA_ROUND(p);
+    c->capacity = capacity;
+    c->used     = 0;
+    c->next     = _q->chunk;
+    _q->chunk   = c;
+    _q->num_bytes_reserved += capacity;
+    _q->num_chunks++;
+    return LIQUID_OK;
+}
+
+// create arena
+//  _num_bytes  :   initial capacity (also size of additional chunks) [bytes]
+liquid_arena liquid_arena_create(unsigned int _num_bytes)
+{
+    liquid_arena q = (liquid_arena) malloc(sizeof(struct liquid_arena_s));
+    q->chunk      = NULL;
+    q->chunk_size = _num_bytes > 0 ? _num_bytes : LIQUID_ARENA_CHUNK_SIZE;
+    q->num_bytes          = 0;
+    q->num_bytes_reserved = 0;
+    q->num_allocations    = 0;
+    q->num_chunks         = 0;
+    if (liquid_arena_add_chunk(q, q->chunk_size) != LIQUID_OK) {
+        free(q);
+        return liquid_error_config("liquid_arena_create(), could not allocate initial chunk");
+    }
+    return q;
+}
+
+// destroy arena, freeing all memory allocated from it
+int liquid_arena_destroy(liquid_arena _q)
+{
+    if (liquid_arena_active == _q)
+        liquid_arena_active = NULL;
+    while (_q->chunk != NULL) {
+        struct liquid_arena_chunk_s * c = _q->chunk;
+        _q->chunk = c->next;
+        free(c);
+    }
+    free(_q);
+    return LIQUID_OK;
+}
+
+// print arena usage
+int liquid_arena_print(liquid_arena _q)
+{
+    printf("<liquid_arena, allocations=%u, used=%lu, reserved=%lu, chunks=%u>\n",
+            _q->num_allocations,
+            (unsigned long)_q->num_bytes,
+            (unsigned long)_q->num_bytes_reserved,
+            _q->num_chunks);
+    return LIQUID_OK;
+}
+
+// release all allocations, keeping only the most recent chunk; objects
+// created from the arena must no longer be used
+int liquid_arena_reset(liquid_arena _q)
+{
+    struct liquid_arena_chunk_s * c = _q->chunk->next;
+    while (c != NULL) {
+        struct liquid_arena_chunk_s * next = c->next;
+        _q->num_bytes_reserved -= c->capacity;
+        free(c);
+        c = next;
+    }
+    _q->chunk->next = NULL;
+    _q->chunk->used = 0;
+    _q->num_bytes       = 0;
+    _q->num_allocations = 0;
+    _q->num_chunks      = 1;
+    return LIQUID_OK;
+}
+
+// allocate block of memory from arena, aligned to 64 bytes
+//  _q          :   arena object
+//  _num_bytes  :   size of block [bytes]
+void * liquid_arena_alloc(liquid_arena _q,
+                          unsigned int _num_bytes)
+{
+    // reserve space for header ahead of aligned block
+    size_t offset = LIQUID_ARENA_ROUND(_q->chunk->used + sizeof(struct liquid_block_header_s));
+    if (offset + _num_bytes > _q->chunk->capacity) {
+        if (liquid_arena_add_chunk(_q, LIQUID_ARENA_ALIGN + _num_bytes) != LIQUID_OK)
+            return NULL;
+        offset = LIQUID_ARENA_ALIGN;
+    }
+    struct liquid_arena_chunk_s * c = _q->chunk;
+    unsigned char * p = c->data + offset;
+    LIQUID_BLOCK_HEADER(p)->base = NULL;
+    LIQUID_BLOCK_HEADER(p)->size = _num_bytes;
+
+    _q->num_bytes += offset + _num_bytes - c->used;
+    _q->num_allocations++;
+    c->used = offset + _num_bytes;
+    return p;
+}
+
+// get number of bytes allocated, including alignment padding
+unsigned int liquid_arena_get_num_bytes(liquid_arena _q)
+{
+    return (unsigned int) _q->num_bytes;
+}
+
+// get total number of bytes reserved by the arena
+unsigned int liquid_arena_get_capacity(liquid_arena _q)
+{
+    return (unsigned int) _q->num_bytes_reserved;
+}
+
+// get number of blocks allocated
+unsigned int liquid_arena_get_num_allocations(liquid_arena _q)
+{
+    return _q->num_allocations;
+}
+
+// start allocating objects created on this thread from arena
+int liquid_arena_begin(liquid_arena _q)
+{
+    if (liquid_arena_active != NULL)
+        return liquid_error(LIQUID_EIMODE,"liquid_arena_begin(), another arena is already active on this thread");
+    liquid_arena_active = _q;
+    return LIQUID_OK;
+}
+
+// stop allocating objects from arena
+int liquid_arena_end(liquid_arena _q)
+{
+    if (liquid_arena_active != _q)
+        return liquid_error(LIQUID_EIMODE,"liquid_arena_end(), arena is not active on this thread");
+    liquid_arena_active = NULL;
+    return LIQUID_OK;
+}
+
+//
+// internal allocation methods
+//
+
+// non-zero if an arena is active on the calling thread
+int liquid_arena_is_active(void)
+{
+    return liquid_arena_active != NULL;
+}
+
+// allocate block of memory aligned to 64 bytes, from active arena if set
+void * liquid_malloc(size_t _n)
+{
+    if (liquid_arena_active != NULL)
+        return liquid_arena_alloc(liquid_arena_active, (unsigned int)_n);
+
+    // over-allocate from heap, leaving room for header before aligned block
+    void * base = malloc(_n + sizeof(struct liquid_block_header_s) + LIQUID_ARENA_ALIGN);
+    if (base == NULL)
+        return NULL;
+    unsigned char * p = (unsigned char*) LIQUID_ARENA_ROUND((uintptr_t)base + sizeof(struct liquid_block_header_s));
+    LIQUID_BLOCK_HEADER(p)->base = base;
+    LIQUID_BLOCK_HEADER(p)->size = _n;
+    return p;
+}
+
+// allocate zero-initialized block of memory aligned to 64 bytes
+void * liquid_calloc(size_t _num,
+                     size_t _size)
+{
+    void * p = liquid_malloc(_num*_size);
+    if (p != NULL)
+        memset(p, 0, _num*_size);
+    return p;
+}
+
+// resize block of memory allocated with liquid_malloc(), preserving
+// contents up to the smaller of the two sizes
+void * liquid_realloc(void * _p,
+                      size_t _n)
+{
+    if (_p == NULL)
+        return liquid_malloc(_n);
+    size_t n0 = LIQUID_BLOCK_HEADER(_p)->size;
+    if (_n <= n0 && LIQUID_BLOCK_HEADER(_p)->base == NULL) {
+        // arena block is large enough already
+        return _p;
+    }
+    void * p = liquid_malloc(_n);
+    if (p == NULL)
+        return NULL;
+    memmove(p, _p, n0 < _n ? n0 : _n);
+    liquid_free(_p);
+    return p;
+}
+
+// free block of memory allocated with liquid_malloc(); blocks drawn from
+// an arena are released with the arena itself
+void liquid_free(void * _p)
+{
+    if (_p != NULL && LIQUID_BLOCK_HEADER(_p)->base != NULL)
+        free(LIQUID_BLOCK_HEADER(_p)->base);
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "autotest/autotest.h"
+#include "liquid.internal.h"
+
+// allocate blocks directly from arena
+void autotest_arena_alloc()
+{
+    liquid_arena q = liquid_arena_create(1024);
+    unsigned int i, j;
+    unsigned char * p[40];
+    for (i=0; i<40; i++) {
+        // sizes span several chunks, including one larger than a chunk
+        unsigned int n = i == 20 ? 5000 : 3 + 17*i;
+        p[i] = (unsigned char*) liquid_arena_alloc(q, n);
+        CONTEND_EQUALITY((uintptr_t)p[i] % 64, 0);
+        memset(p[i], i, n);
+    }
+    CONTEND_EQUALITY(liquid_arena_get_num_allocations(q), 40);
+    CONTEND_GREATER_THAN(liquid_arena_get_capacity(q), liquid_arena_get_num_bytes(q)-1);
+
+    // ensure blocks do not overlap
+    unsigned int num_errors = 0;
+    for (i=0; i<40; i++) {
+        unsigned int n = i == 20 ? 5000 : 3 + 17*i;
+        for (j=0; j<n; j++)
+            num_errors += p[i][j] != (unsigned char)i;
+    }
+    CONTEND_EQUALITY(num_errors, 0);
+
+    // reset releases everything
+    liquid_arena_reset(q);
+    CONTEND_EQUALITY(liquid_arena_get_num_allocations(q), 0);
+    CONTEND_EQUALITY(liquid_arena_get_num_bytes(q),       0);
+    if (liquid_autotest_verbose)
+        liquid_arena_print(q);
+    liquid_arena_destroy(q);
+}
+
+// create filters from arena and compare against heap-allocated filters
+void autotest_arena_firfilt()
+{
+    unsigned int num_filters = 8;
+    unsigned int h_len = 37;
+    float h[h_len];
+    unsigned int i, j;
+    for (i=0; i<h_len; i++)
+        h[i] = cosf(0.3f*i) * expf(-0.05f*i);
+
+    firfilt_crcf f0 = firfilt_crcf_create(h, h_len);
+    firfilt_crcf f[num_filters];
+    liquid_arena q = liquid_arena_create(0);
+    CONTEND_EQUALITY(liquid_arena_begin(q), LIQUID_OK);
+    for (i=0; i<num_filters; i++)
+        f[i] = firfilt_crcf_create(h, h_len);
+    CONTEND_EQUALITY(liquid_arena_end(q), LIQUID_OK);
+    CONTEND_GREATER_THAN(liquid_arena_get_num_allocations(q), 4*num_filters-1);
+
+    // run filters and check against reference
+    float complex x, y0, y;
+    for (j=0; j<200; j++) {
+        x = cexpf(_Complex_I*0.1f*j*j);
+        firfilt_crcf_push(f0, x);
+        firfilt_crcf_execute(f0, &y0);
+        for (i=0; i<num_filters; i++) {
+            firfilt_crcf_push(f[i], x);
+            firfilt_crcf_execute(f[i], &y);
+            CONTEND_EQUALITY(y, y0);
+        }
+    }
+
+    // recreate one filter outside of arena, destroy another individually,
+    // then free remaining filters all at once
+    f[0] = firfilt_crcf_recreate(f[0], h, h_len-5);
+    firfilt_crcf_destroy(f[0]);
+    firfilt_crcf_destroy(f[1]);
+    liquid_arena_destroy(q);
+    firfilt_crcf_destroy(f0);
+}
+
+// filters long enough that their window would otherwise use a mirrored
+// mapping outside of the arena
+void autotest_arena_firfilt_large()
+{
+    unsigned int num_filters = 2;
+    unsigned int h_len = 1024;
+    float h[h_len];
+    unsigned int i, j;
+    for (i=0; i<h_len; i++)
+        h[i] = cosf(0.01f*i) * expf(-0.005f*i);
+
+    firfilt_crcf f0 = firfilt_crcf_create(h, h_len);
+    firfilt_crcf f[num_filters];
+    liquid_arena q = liquid_arena_create(0);
+    CONTEND_EQUALITY(liquid_arena_begin(q), LIQUID_OK);
+    for (i=0; i<num_filters; i++)
+        f[i] = firfilt_crcf_create(h, h_len);
+    CONTEND_EQUALITY(liquid_arena_end(q), LIQUID_OK);
+
+    // each filter holds its coefficients and its full window in the arena
+    unsigned int min_bytes = num_filters*h_len*(sizeof(float) + 2*sizeof(float complex));
+    CONTEND_GREATER_THAN(liquid_arena_get_num_bytes(q), min_bytes-1);
+
+    // run filters through several wraps of the window and check against reference
+    float complex x, y0, y;
+    for (j=0; j<3*h_len; j++) {
+        x = cexpf(_Complex_I*0.001f*j*j);
+        firfilt_crcf_push(f0, x);
+        firfilt_crcf_execute(f0, &y0);
+        for (i=0; i<num_filters; i++) {
+            firfilt_crcf_push(f[i], x);
+            firfilt_crcf_execute(f[i], &y);
+            CONTEND_EQUALITY(y, y0);
+        }
+    }
+
+    liquid_arena_destroy(q);
+    firfilt_crcf_destroy(f0);
+}
+
+void autotest_arena_config()
+{
+#if LIQUID_STRICT_EXIT
+    AUTOTEST_WARN("skipping arena config test with strict exit enabled\n");
+    return;
+#endif
+#if !LIQUID_SUPPRESS_ERROR_OUTPUT
+    fprintf(stderr,"warning: ignore potential errors here; checking for invalid configurations\n");
+#endif
+    liquid_arena q0 = liquid_arena_create(0);
+    liquid_arena q1 = liquid_arena_create(0);
+    CONTEND_INEQUALITY(liquid_arena_end  (q0), LIQUID_OK); // not active
+    CONTEND_EQUALITY  (liquid_arena_begin(q0), LIQUID_OK);
+    CONTEND_INEQUALITY(liquid_arena_begin(q1), LIQUID_OK); // another arena active
+    CONTEND_INEQUALITY(liquid_arena_end  (q1), LIQUID_OK); // not active
+    CONTEND_EQUALITY  (liquid_arena_end  (q0), LIQUID_OK);
+    liquid_arena_destroy(q0);
+    liquid_arena_destroy(q1);
+}